@@ -738,6 +738,145 @@ void TraceLineThroughGrid(float2    f2Start,
 }
 
 
+/// The number of lines that TraceLinesThroughGrid steps through the grid simultaneously
+static constexpr Uint32 TraceLinesPacketSize = 8;
+
+/// Traces a batch of 2D lines through the square cell grid and enumerates all cells every line touches.
+
+/// \tparam TCallback - Type of the callback function.
+/// \param pStarts    - Array of line start points.
+/// \param pEnds      - Array of line end points.
+/// \param NumLines   - Number of lines in pStarts and pEnds arrays.
+/// \param i2GridSize - Grid dimensions.
+/// \param Callback   - Callback function that will be called with the arguments of type Uint32 (line index
+///                     in the batch) and int2 (cell position) for every cell visited by every line.
+///                     The function should return true to continue tracing the line and false to stop it.
+///                     Returning false only terminates the current line, other lines continue to be traced.
+///
+/// \remarks For every line, the function enumerates exactly the same cells in exactly the same order
+///          as TraceLineThroughGrid. However, the lines are processed in packets of TraceLinesPacketSize
+///          lines that are stepped through the grid simultaneously, so that cells of different lines
+///          in the same packet are interleaved.
+///
+///          The stepping is performed over structure-of-arrays lane data with a mask of active lines
+///          that allows the compiler to vectorize the inner loop.
+///
+///          Lines are processed independently. To trace lines in multiple threads, split the arrays
+///          into ranges and call the function for every range. The callback must be thread-safe in this case.
+template <typename TCallback>
+void TraceLinesThroughGrid(const float2* pStarts,
+                           const float2* pEnds,
+                           Uint32        NumLines,
+                           int2          i2GridSize,
+                           TCallback     Callback)
+{
+    VERIFY_EXPR(i2GridSize.x > 0 && i2GridSize.y > 0);
+    VERIFY_EXPR(NumLines == 0 || (pStarts != nullptr && pEnds != nullptr));
+    const auto f2GridSize = i2GridSize.Recast<float>();
+
+    constexpr Uint32 N = TraceLinesPacketSize;
+    for (Uint32 FirstLine = 0; FirstLine < NumLines; FirstLine += N)
+    {
+        const Uint32 PacketSize = std::min(N, NumLines - FirstLine);
+
+        // clang-format off
+        float DirX[N] = {}, DirY[N] = {};
+        float Tx  [N] = {}, Ty  [N] = {};
+        int   PosX[N] = {}, PosY[N] = {};
+        int   EndX[N] = {}, EndY[N] = {};
+        int   Dh  [N] = {}, Dv  [N] = {};
+        int   Active[N] = {};
+        // clang-format on
+
+        int NumActive = 0;
+        for (Uint32 l = 0; l < PacketSize; ++l)
+        {
+            auto f2Start = pStarts[FirstLine + l];
+            auto f2End   = pEnds[FirstLine + l];
+
+            if (f2Start == f2End)
+            {
+                if (f2Start.x >= 0 && f2Start.x < f2GridSize.x &&
+                    f2Start.y >= 0 && f2Start.y < f2GridSize.y)
+                {
+                    // Zero direction with the start cell equal to the end cell
+                    // makes the lane visit exactly one cell.
+                    PosX[l] = EndX[l] = static_cast<int>(f2Start.x);
+                    PosY[l] = EndY[l] = static_cast<int>(f2Start.y);
+                    Dh[l] = Dv[l] = 1;
+                    Active[l]     = 1;
+                    ++NumActive;
+                }
+                continue;
+            }
+
+            float2 f2Direction = f2End - f2Start;
+
+            float EnterDist, ExitDist;
+            if (!IntersectRayBox2D(f2Start, f2Direction, float2{0, 0}, f2GridSize, EnterDist, ExitDist))
+                continue;
+
+            // Exactly the same setup as in TraceLineThroughGrid
+            f2End   = f2Start + f2Direction * std::min(ExitDist, 1.f);
+            f2Start = f2Start + f2Direction * std::max(EnterDist, 0.f);
+            f2Start = clamp(f2Start, float2{0, 0}, f2GridSize);
+            f2End   = clamp(f2End, float2{0, 0}, f2GridSize);
+
+            Dh[l]         = f2Direction.x > 0 ? 1 : -1;
+            Dv[l]         = f2Direction.y > 0 ? 1 : -1;
+            const float p = f2Direction.y * f2Start.x - f2Direction.x * f2Start.y;
+            Tx[l]         = p - f2Direction.y * static_cast<float>(Dh[l]);
+            Ty[l]         = p + f2Direction.x * static_cast<float>(Dv[l]);
+            DirX[l]       = f2Direction.x;
+            DirY[l]       = f2Direction.y;
+
+            EndX[l] = static_cast<int>(f2End.x);
+            EndY[l] = static_cast<int>(f2End.y);
+            PosX[l] = static_cast<int>(f2Start.x);
+            PosY[l] = static_cast<int>(f2Start.y);
+            VERIFY_EXPR(EndX[l] >= 0 && EndY[l] >= 0 && EndX[l] <= i2GridSize.x && EndY[l] <= i2GridSize.y);
+            VERIFY_EXPR(PosX[l] >= 0 && PosY[l] >= 0 && PosX[l] <= i2GridSize.x && PosY[l] <= i2GridSize.y);
+
+            Active[l] = ((EndX[l] - PosX[l]) * Dh[l] >= 0 && (EndY[l] - PosY[l]) * Dv[l] >= 0) ? 1 : 0;
+            NumActive += Active[l];
+        }
+
+        while (NumActive > 0)
+        {
+            // Invoke the callback for all active lanes
+            for (Uint32 l = 0; l < PacketSize; ++l)
+            {
+                if (Active[l] != 0 && PosX[l] < i2GridSize.x && PosY[l] < i2GridSize.y)
+                {
+                    if (!Callback(FirstLine + l, int2{PosX[l], PosY[l]}))
+                        Active[l] = 0;
+                }
+            }
+
+            // Step all lanes to the next cell. This loop has no branches and no calls
+            // and is vectorized by the compiler.
+            NumActive = 0;
+            for (Uint32 l = 0; l < N; ++l)
+            {
+                const float t = DirX[l] * (static_cast<float>(PosY[l]) + 0.5f) - DirY[l] * (static_cast<float>(PosX[l]) + 0.5f);
+
+                const int AtEnd = (PosX[l] == EndX[l] && PosY[l] == EndY[l]) ? 1 : 0;
+                const int StepX = std::abs(t + Tx[l]) < std::abs(t + Ty[l]) ? 1 : 0;
+
+                PosX[l] += Dh[l] * StepX * (1 - AtEnd);
+                PosY[l] += Dv[l] * (1 - StepX) * (1 - AtEnd);
+
+                // Same as the loop condition in TraceLineThroughGrid
+                const int InRange = ((EndX[l] - PosX[l]) * Dh[l] >= 0 && (EndY[l] - PosY[l]) * Dv[l] >= 0) ? 1 : 0;
+
+                Active[l] &= (1 - AtEnd) & InRange;
+                NumActive += Active[l];
+            }
+        }
+    }
+}
+
+
 /// Tests if a point is inside triangle.
 
 /// \tparam T                - Vector component type
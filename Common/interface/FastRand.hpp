@@ -27,7 +27,11 @@
 
 #pragma once
 
+#include <cstddef>
+
+#include "../../Primitives/interface/BasicTypes.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "BasicMath.hpp"
 
 namespace Diligent
 {
@@ -108,4 +112,154 @@ private:
     const int Range;
 };
 
+/// Fast random number generator that produces numbers in blocks.
+
+/// The generator runs NumLanes independent xoshiro128** generators side by side
+/// (see Blackman D., Vigna S., "Scrambled Linear Pseudorandom Number Generators", 2018).
+/// Every block contains one value from every lane. Lane states are stored as structure
+/// of arrays, which allows the compiler to vectorize the generation loop.
+///
+/// The generated sequence only depends on the seed and the stream index and does not
+/// depend on how the values are requested (e.g. filling 100 values at once produces the
+/// same numbers as filling 10 values 10 times).
+///
+/// Different streams initialized with the same seed are independent, so the stream
+/// index can be used to give every thread its own reproducible sequence.
+///
+/// \note You should probably not use it for your production-grade encryption.
+class FastRandStream
+{
+public:
+    static constexpr Uint32 NumLanes = 8;
+
+    explicit FastRandStream(Uint64 Seed, Uint64 StreamIdx = 0) noexcept
+    {
+        // Every lane takes two consecutive 64-bit values from the SplitMix64 sequence.
+        // SplitMix64 output function is a bijection, so different (stream, lane) pairs
+        // always receive different states.
+        Uint64 SplitMixState = Seed + StreamIdx * (NumLanes * 2) * 0x9E3779B97F4A7C15ull;
+        for (Uint32 l = 0; l < NumLanes; ++l)
+        {
+            const Uint64 s0 = SplitMix64(SplitMixState);
+            const Uint64 s1 = SplitMix64(SplitMixState);
+
+            m_State[0][l] = static_cast<Uint32>(s0);
+            m_State[1][l] = static_cast<Uint32>(s0 >> 32u);
+            m_State[2][l] = static_cast<Uint32>(s1);
+            m_State[3][l] = static_cast<Uint32>(s1 >> 32u);
+            if ((m_State[0][l] | m_State[1][l] | m_State[2][l] | m_State[3][l]) == 0)
+                m_State[0][l] = 1; // All-zero state is not allowed
+        }
+    }
+
+    /// Returns the next random 32-bit value
+    Uint32 operator()()
+    {
+        if (m_BufferPos == NumLanes)
+        {
+            NextBlock(m_Buffer);
+            m_BufferPos = 0;
+        }
+        return m_Buffer[m_BufferPos++];
+    }
+
+    /// Fills the array with random 32-bit values
+    void Fill(Uint32* pDst, size_t Count)
+    {
+        VERIFY_EXPR(Count == 0 || pDst != nullptr);
+        size_t i = 0;
+        // Consume the values left in the buffer
+        for (; i < Count && m_BufferPos < NumLanes; ++i)
+            pDst[i] = m_Buffer[m_BufferPos++];
+
+        // Write full blocks directly to the destination
+        for (; i + NumLanes <= Count; i += NumLanes)
+            NextBlock(pDst + i);
+
+        for (; i < Count; ++i)
+            pDst[i] = (*this)();
+    }
+
+    /// Fills the array with random floats in [Min, Max] range.
+    /// For the default [0, 1] range, 1 is never produced.
+    void Fill(float* pDst, size_t Count, float Min = 0.f, float Max = 1.f)
+    {
+        VERIFY_EXPR(Count == 0 || pDst != nullptr);
+        VERIFY_EXPR(Max >= Min);
+
+        // Use the top 24 bits that can be exactly represented by a float
+        const float Scale = (Max - Min) / 16777216.f;
+
+        size_t i = 0;
+        for (; i < Count && m_BufferPos < NumLanes; ++i)
+            pDst[i] = Min + static_cast<float>((*this)() >> 8u) * Scale;
+
+        Uint32 Block[NumLanes];
+        for (; i + NumLanes <= Count; i += NumLanes)
+        {
+            NextBlock(Block);
+            for (Uint32 l = 0; l < NumLanes; ++l)
+                pDst[i + l] = Min + static_cast<float>(Block[l] >> 8u) * Scale;
+        }
+
+        for (; i < Count; ++i)
+            pDst[i] = Min + static_cast<float>((*this)() >> 8u) * Scale;
+    }
+
+    /// Fills the array with random float2 vectors, all components are in [Min, Max] range
+    void Fill(float2* pDst, size_t Count, float Min = 0.f, float Max = 1.f)
+    {
+        static_assert(sizeof(float2) == sizeof(float) * 2, "Unexpected float2 size");
+        Fill(&pDst->x, Count * 2, Min, Max);
+    }
+
+    /// Fills the array with random float3 vectors, all components are in [Min, Max] range
+    void Fill(float3* pDst, size_t Count, float Min = 0.f, float Max = 1.f)
+    {
+        static_assert(sizeof(float3) == sizeof(float) * 3, "Unexpected float3 size");
+        Fill(&pDst->x, Count * 3, Min, Max);
+    }
+
+private:
+    static Uint64 SplitMix64(Uint64& State)
+    {
+        Uint64 z = (State += 0x9E3779B97F4A7C15ull);
+        z        = (z ^ (z >> 30u)) * 0xBF58476D1CE4E5B9ull;
+        z        = (z ^ (z >> 27u)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31u);
+    }
+
+    static Uint32 RotL(Uint32 x, Uint32 k)
+    {
+        return (x << k) | (x >> (32u - k));
+    }
+
+    void NextBlock(Uint32* pDst)
+    {
+        auto& s0 = m_State[0];
+        auto& s1 = m_State[1];
+        auto& s2 = m_State[2];
+        auto& s3 = m_State[3];
+        for (Uint32 l = 0; l < NumLanes; ++l)
+        {
+            pDst[l] = RotL(s1[l] * 5u, 7u) * 9u;
+
+            const Uint32 t = s1[l] << 9u;
+
+            s2[l] ^= s0[l];
+            s3[l] ^= s1[l];
+            s1[l] ^= s2[l];
+            s0[l] ^= s3[l];
+
+            s2[l] ^= t;
+
+            s3[l] = RotL(s3[l], 11u);
+        }
+    }
+
+    Uint32 m_State[4][NumLanes] = {};
+    Uint32 m_Buffer[NumLanes]   = {};
+    Uint32 m_BufferPos          = NumLanes;
+};
+
 } // namespace Diligent
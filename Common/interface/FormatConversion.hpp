@@ -0,0 +1,300 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Conversion routines between 32-bit floating-point values and packed representations
+/// (half-precision floats, normalized integers, octahedral normals and RGB10A2).
+///
+/// Scalar functions are defined inline. Array converters process Count elements at once and
+/// use hardware conversion instructions when they are enabled for the target (F16C on x86).
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "BasicMath.hpp"
+
+namespace Diligent
+{
+
+/// Converts a 32-bit float to a 16-bit half-precision float (IEEE 754 binary16).
+
+/// The value is rounded to the nearest representable half with ties to even.
+/// Values that are too large are converted to infinity, NaNs are converted to a quiet NaN.
+/// The result matches the format of VT_FLOAT16 and COMPONENT_TYPE_FLOAT texture components
+/// of size 2 (e.g. TEX_FORMAT_RGBA16_FLOAT).
+inline Uint16 FloatToHalf(float f)
+{
+    // https://gist.github.com/rygorous/2156668
+    static constexpr Uint32 F32Infinity  = 255u << 23;
+    static constexpr Uint32 F16Max       = (127u + 16u) << 23;
+    static constexpr Uint32 DenormMagicU = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    Uint32 u;
+    memcpy(&u, &f, sizeof(u));
+
+    const Uint32 Sign = u & 0x80000000u;
+    u ^= Sign;
+
+    Uint32 h;
+    if (u >= F16Max)
+    {
+        // Inf or NaN (all exponent bits set)
+        h = (u > F32Infinity) ? 0x7E00u : 0x7C00u;
+    }
+    else if (u < (113u << 23))
+    {
+        // The result is a subnormal or zero. Use the FPU to perform the rounding.
+        float DenormMagic;
+        memcpy(&DenormMagic, &DenormMagicU, sizeof(DenormMagic));
+
+        float uf;
+        memcpy(&uf, &u, sizeof(uf));
+        uf += DenormMagic;
+        memcpy(&u, &uf, sizeof(u));
+        h = u - DenormMagicU;
+    }
+    else
+    {
+        const Uint32 MantOdd = (u >> 13) & 1u;
+        // Update the exponent and round
+        u += ((15u - 127u) << 23) + 0xFFFu;
+        u += MantOdd;
+        h = u >> 13;
+    }
+
+    return static_cast<Uint16>(h | (Sign >> 16));
+}
+
+/// Converts a 16-bit half-precision float to a 32-bit float. The conversion is exact.
+inline float HalfToFloat(Uint16 h)
+{
+    // https://gist.github.com/rygorous/2144712
+    static constexpr Uint32 ShiftedExp = 0x7C00u << 13;
+    static constexpr Uint32 MagicU     = 113u << 23;
+
+    Uint32 u = (Uint32{h} & 0x7FFFu) << 13;
+
+    const Uint32 Exp = ShiftedExp & u;
+    // Exponent adjust
+    u += (127u - 15u) << 23;
+
+    if (Exp == ShiftedExp)
+    {
+        // Inf or NaN: extra exponent adjust
+        u += (128u - 16u) << 23;
+    }
+    else if (Exp == 0)
+    {
+        // Zero or subnormal: extra exponent adjust and renormalize
+        u += 1u << 23;
+
+        float Magic;
+        memcpy(&Magic, &MagicU, sizeof(Magic));
+        float uf;
+        memcpy(&uf, &u, sizeof(uf));
+        uf -= Magic;
+        memcpy(&u, &uf, sizeof(u));
+    }
+
+    u |= (Uint32{h} & 0x8000u) << 16;
+
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+
+/// Converts a float in [0, 1] range to an unsigned normalized integer (Uint8 or Uint16).
+
+/// The value is clamped to [0, 1] and rounded to the nearest integer, which
+/// matches the COMPONENT_TYPE_UNORM texture component conversion rules.
+template <typename DstType>
+DstType FloatToUNorm(float f)
+{
+    static_assert(std::is_integral<DstType>::value && std::is_unsigned<DstType>::value, "Destination type must be an unsigned integer");
+    constexpr float MaxVal = static_cast<float>(std::numeric_limits<DstType>::max());
+    // Note that NaN is converted to 0
+    f = (f > 0.f) ? (f < 1.f ? f : 1.f) : 0.f;
+    return static_cast<DstType>(f * MaxVal + 0.5f);
+}
+
+/// Converts an unsigned normalized integer (Uint8 or Uint16) to a float in [0, 1] range.
+template <typename SrcType>
+float UNormToFloat(SrcType u)
+{
+    static_assert(std::is_integral<SrcType>::value && std::is_unsigned<SrcType>::value, "Source type must be an unsigned integer");
+    constexpr float MaxVal = static_cast<float>(std::numeric_limits<SrcType>::max());
+    return static_cast<float>(u) / MaxVal;
+}
+
+/// Converts a float in [-1, 1] range to a signed normalized integer (Int8 or Int16).
+
+/// The value is clamped to [-1, 1] and rounded to the nearest integer, which
+/// matches the COMPONENT_TYPE_SNORM texture component conversion rules.
+/// The minimum integer value (e.g. -128 for Int8) is never produced.
+template <typename DstType>
+DstType FloatToSNorm(float f)
+{
+    static_assert(std::is_integral<DstType>::value && std::is_signed<DstType>::value, "Destination type must be a signed integer");
+    constexpr float MaxVal = static_cast<float>(std::numeric_limits<DstType>::max());
+    // Note that NaN is converted to 0
+    f = (f > -1.f) ? (f < 1.f ? f : 1.f) : (f <= -1.f ? -1.f : 0.f);
+    f *= MaxVal;
+    return static_cast<DstType>(f >= 0.f ? f + 0.5f : f - 0.5f);
+}
+
+/// Converts a signed normalized integer (Int8 or Int16) to a float in [-1, 1] range.
+
+/// Both the minimum and the minimum plus one integer values are converted to -1.
+template <typename SrcType>
+float SNormToFloat(SrcType s)
+{
+    static_assert(std::is_integral<SrcType>::value && std::is_signed<SrcType>::value, "Source type must be a signed integer");
+    constexpr float MaxVal = static_cast<float>(std::numeric_limits<SrcType>::max());
+    const float     f      = static_cast<float>(s) / MaxVal;
+    return f > -1.f ? f : -1.f;
+}
+
+
+/// Packs a float4 color into the RGB10A2 unorm format.
+
+/// The layout matches TEX_FORMAT_RGB10A2_UNORM: red occupies bits 0-9, green occupies bits 10-19,
+/// blue occupies bits 20-29, and alpha occupies bits 30-31.
+inline Uint32 PackRGB10A2(const float4& Color)
+{
+    auto Quantize = [](float f, float MaxVal) //
+    {
+        f = (f > 0.f) ? (f < 1.f ? f : 1.f) : 0.f;
+        return static_cast<Uint32>(f * MaxVal + 0.5f);
+    };
+    return (Quantize(Color.r, 1023.f) << 0u) |
+        (Quantize(Color.g, 1023.f) << 10u) |
+        (Quantize(Color.b, 1023.f) << 20u) |
+        (Quantize(Color.a, 3.f) << 30u);
+}
+
+/// Unpacks a float4 color from the RGB10A2 unorm format, see PackRGB10A2().
+inline float4 UnpackRGB10A2(Uint32 Packed)
+{
+    return float4 //
+        {
+            static_cast<float>((Packed >> 0u) & 0x3FFu) / 1023.f,
+            static_cast<float>((Packed >> 10u) & 0x3FFu) / 1023.f,
+            static_cast<float>((Packed >> 20u) & 0x3FFu) / 1023.f,
+            static_cast<float>((Packed >> 30u) & 0x3u) / 3.f //
+        };
+}
+
+
+/// Encodes a unit vector using the octahedral mapping and returns the coordinates in [-1, 1] range.
+
+/// See Cigolle Z. et al., "A Survey of Efficient Representations for Independent Unit Vectors", 2014.
+/// The input vector does not need to be normalized, but must not be zero.
+inline float2 EncodeOctahedralNormal(const float3& Normal)
+{
+    auto SignNotZero = [](float f) { return f >= 0.f ? 1.f : -1.f; };
+
+    const float L1Norm = std::abs(Normal.x) + std::abs(Normal.y) + std::abs(Normal.z);
+    VERIFY(L1Norm > 0, "Zero vector can't be encoded");
+
+    float2 Oct{Normal.x / L1Norm, Normal.y / L1Norm};
+    if (Normal.z < 0)
+    {
+        // Reflect the folds of the lower hemisphere over the diagonals
+        Oct = float2 //
+            {
+                (1.f - std::abs(Oct.y)) * SignNotZero(Oct.x),
+                (1.f - std::abs(Oct.x)) * SignNotZero(Oct.y) //
+            };
+    }
+    return Oct;
+}
+
+/// Decodes a normalized vector from the octahedral coordinates, see EncodeOctahedralNormal().
+inline float3 DecodeOctahedralNormal(const float2& Oct)
+{
+    float3 Normal{Oct.x, Oct.y, 1.f - std::abs(Oct.x) - std::abs(Oct.y)};
+    if (Normal.z < 0)
+    {
+        auto SignNotZero = [](float f) { return f >= 0.f ? 1.f : -1.f; };
+
+        Normal.x = (1.f - std::abs(Oct.y)) * SignNotZero(Oct.x);
+        Normal.y = (1.f - std::abs(Oct.x)) * SignNotZero(Oct.y);
+    }
+    return normalize(Normal);
+}
+
+/// Packs a normal into two 16-bit snorm octahedral coordinates.
+
+/// The layout matches TEX_FORMAT_RG16_SNORM: x coordinate occupies bits 0-15,
+/// y coordinate occupies bits 16-31.
+inline Uint32 PackOctahedralNormal(const float3& Normal)
+{
+    const auto Oct = EncodeOctahedralNormal(Normal);
+    return Uint32{static_cast<Uint16>(FloatToSNorm<Int16>(Oct.x))} |
+        (Uint32{static_cast<Uint16>(FloatToSNorm<Int16>(Oct.y))} << 16u);
+}
+
+/// Unpacks a normal from two 16-bit snorm octahedral coordinates, see PackOctahedralNormal().
+inline float3 UnpackOctahedralNormal(Uint32 Packed)
+{
+    const float2 Oct //
+        {
+            SNormToFloat(static_cast<Int16>(Packed & 0xFFFFu)),
+            SNormToFloat(static_cast<Int16>(Packed >> 16u)) //
+        };
+    return DecodeOctahedralNormal(Oct);
+}
+
+
+// Array converters. Source and destination arrays must not overlap.
+
+void ConvertFloatToHalf(const float* pSrc, Uint16* pDst, size_t Count);
+void ConvertHalfToFloat(const Uint16* pSrc, float* pDst, size_t Count);
+
+void ConvertFloatToUNorm8(const float* pSrc, Uint8* pDst, size_t Count);
+void ConvertFloatToUNorm16(const float* pSrc, Uint16* pDst, size_t Count);
+void ConvertFloatToSNorm8(const float* pSrc, Int8* pDst, size_t Count);
+void ConvertFloatToSNorm16(const float* pSrc, Int16* pDst, size_t Count);
+
+void ConvertUNorm8ToFloat(const Uint8* pSrc, float* pDst, size_t Count);
+void ConvertUNorm16ToFloat(const Uint16* pSrc, float* pDst, size_t Count);
+void ConvertSNorm8ToFloat(const Int8* pSrc, float* pDst, size_t Count);
+void ConvertSNorm16ToFloat(const Int16* pSrc, float* pDst, size_t Count);
+
+void PackOctahedralNormals(const float3* pSrc, Uint32* pDst, size_t Count);
+void UnpackOctahedralNormals(const Uint32* pSrc, float3* pDst, size_t Count);
+
+void PackRGB10A2(const float4* pSrc, Uint32* pDst, size_t Count);
+void UnpackRGB10A2(const Uint32* pSrc, float4* pDst, size_t Count);
+
+} // namespace Diligent
@@ -31,6 +31,7 @@
 #include <memory>
 #include <cstring>
 
+#include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/Errors.hpp"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 
@@ -61,6 +62,25 @@ std::size_t ComputeHash(const ArgsType&... Args)
     return Seed;
 }
 
+/// Computes the hash of a raw memory block
+inline std::size_t ComputeHashRaw(const void* pData, size_t Size)
+{
+    std::size_t Seed   = 0;
+    const auto* pBytes = static_cast<const Uint8*>(pData);
+
+    size_t Offset = 0;
+    for (; Offset + sizeof(Uint64) <= Size; Offset += sizeof(Uint64))
+    {
+        Uint64 Word;
+        memcpy(&Word, pBytes + Offset, sizeof(Word));
+        HashCombine(Seed, Word);
+    }
+    for (; Offset < Size; ++Offset)
+        HashCombine(Seed, pBytes[Offset]);
+
+    return Seed;
+}
+
 template <typename CharType>
 struct CStringHash
 {
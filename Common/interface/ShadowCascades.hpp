@@ -0,0 +1,164 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Cascaded shadow map setup and culling utilities
+
+#include <vector>
+
+#include "AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+/// Shadow cascade parameters computed by ComputeShadowCascades().
+struct ShadowCascade
+{
+    /// Camera view-space depth where the cascade starts
+    float NearZ = 0;
+
+    /// Camera view-space depth where the cascade ends
+    float FarZ = 0;
+
+    /// World space to light view space transform (rotation only)
+    float4x4 LightView;
+
+    /// Light-space orthographic projection of the cascade
+    float4x4 Proj;
+
+    /// LightView * Proj
+    float4x4 ViewProj;
+
+    /// View frustum of the cascade extracted from ViewProj.
+    /// The plane normals are not normalized.
+    ViewFrustum Frustum;
+
+    /// World-space center of the cascade bounding sphere
+    float3 Center;
+
+    /// Radius of the cascade bounding sphere
+    float Radius = 0;
+
+    /// World-space size of one shadow map texel
+    float TexelSize = 0;
+};
+
+/// Shadow cascade setup attributes, see ComputeShadowCascades().
+struct ShadowCascadeAttribs
+{
+    /// Camera view matrix
+    float4x4 CameraView;
+
+    /// Camera perspective projection matrix
+    float4x4 CameraProj;
+
+    /// World-space direction in which the light travels
+    float3 LightDir = float3{0, -1, 0};
+
+    /// Number of cascades
+    Uint32 NumCascades = 4;
+
+    /// Shadow map resolution
+    Uint32 Resolution = 2048;
+
+    /// Cascade partitioning factor that blends between uniform (0) and
+    /// logarithmic (1) split schemes
+    float PartitioningFactor = 0.95f;
+
+    /// Maximum distance from the camera covered by the shadow cascades.
+    /// If zero, the camera far plane is used.
+    float MaxShadowDistance = 0;
+
+    /// Distance by which every cascade is extended towards the light to capture
+    /// shadow casters located outside of the camera frustum
+    float CasterExtension = 0;
+
+    /// Whether to snap cascade projections to shadow map texels to eliminate
+    /// shadow edge shimmering when the camera moves
+    bool SnapToTexels = true;
+
+    /// Whether the projection matrices are OpenGL-style
+    bool IsGL = false;
+};
+
+
+/// Computes cascade split distances using the practical split scheme
+/// (see Zhang F. et al., "Parallel-Split Shadow Maps for Large-scale Virtual Environments", 2006).
+
+/// \param [in]  NearZ              - Near distance of the first cascade.
+/// \param [in]  FarZ               - Far distance of the last cascade.
+/// \param [in]  NumCascades        - Number of cascades.
+/// \param [in]  PartitioningFactor - Factor that blends between uniform (0) and logarithmic (1) split schemes.
+/// \param [out] pSplits            - Array of NumCascades + 1 split distances. The first element is
+///                                   NearZ, the last element is FarZ.
+void ComputeCascadeSplits(float  NearZ,
+                          float  FarZ,
+                          Uint32 NumCascades,
+                          float  PartitioningFactor,
+                          float* pSplits);
+
+
+/// Computes the split distances, stable orthographic projections and culling frustums
+/// for all shadow cascades.
+
+/// \param [in]  Attribs   - Cascade setup attributes.
+/// \param [out] pCascades - Array of Attribs.NumCascades cascades.
+///
+/// \remarks Every cascade is fitted to the minimum bounding sphere of the corresponding camera
+///          frustum slice. The sphere size does not depend on the camera orientation, so
+///          the shadow map texel size remains constant when the camera rotates. When
+///          Attribs.SnapToTexels is true, the projection is additionally snapped to the texel grid
+///          so that the texels do not move when the camera moves.
+void ComputeShadowCascades(const ShadowCascadeAttribs& Attribs,
+                           ShadowCascade*              pCascades);
+
+
+/// Culls an array of bounding boxes against all shadow cascades in a single pass over the boxes.
+
+/// \param [in]  pCascades     - Array of NumCascades shadow cascades.
+/// \param [in]  NumCascades   - Number of cascades.
+/// \param [in]  pBoxes        - Array of NumBoxes world-space bounding boxes.
+/// \param [in]  NumBoxes      - Number of boxes.
+/// \param [out] pVisibleLists - Array of NumCascades lists. The indices of the boxes
+///                              that are visible in cascade i are appended to pVisibleLists[i]
+///                              in increasing order.
+/// \param [in]  PlaneFlags    - Frustum planes to test the boxes against. By default, the
+///                              near plane is not tested so that all shadow casters located
+///                              between the light and the cascade are retained.
+///
+/// \remarks A box is visible in a cascade if GetBoxVisibility(Cascade.Frustum, Box, PlaneFlags)
+///          returns anything other than BoxVisibility::Invisible.
+void CullBoxesAgainstShadowCascades(const ShadowCascade* pCascades,
+                                    Uint32               NumCascades,
+                                    const BoundBox*      pBoxes,
+                                    Uint32               NumBoxes,
+                                    std::vector<Uint32>* pVisibleLists,
+                                    FRUSTUM_PLANE_FLAGS  PlaneFlags = FRUSTUM_PLANE_FLAG_OPEN_NEAR);
+
+} // namespace Diligent
@@ -0,0 +1,162 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Spatial hash grid that indexes axis-aligned bounding boxes
+
+#include <vector>
+#include <unordered_map>
+
+#include "AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+/// Loose spatial hash grid that indexes axis-aligned bounding boxes.
+
+/// Every object is assigned to the grid cell that contains the center of its bounding box.
+/// Only non-empty cells are allocated, and they are looked up through a hash map, so
+/// the world size is not limited. Every cell keeps the loose bounds that enclose the boxes
+/// of all objects it contains, and the object boxes are stored contiguously in the cell,
+/// so that queries reject whole cells first and then scan the boxes sequentially.
+///
+/// The grid tracks the largest object half-size, so a query only looks up the cells whose
+/// centers are within that distance from the query bounds. When this range contains more
+/// cells than there are non-empty cells in the grid, or the query is not bounded (e.g.
+/// a frustum with a disabled plane), all non-empty cells are scanned instead.
+///
+/// Objects can be inserted, moved and removed incrementally. Moving an object within
+/// the same cell only updates its box.
+///
+/// \remarks All query methods are const and do not modify the grid, so any number of threads
+///          may run queries simultaneously. Insert(), Move() and Remove() must not be called
+///          while queries are in progress.
+class SpatialHashGrid
+{
+public:
+    using ObjectId = Uint32;
+
+    /// \param [in] CellSize - Grid cell size. For best performance, it should be
+    ///                        comparable to the typical object size.
+    explicit SpatialHashGrid(float CellSize);
+
+    // clang-format off
+    SpatialHashGrid           (const SpatialHashGrid&)  = delete;
+    SpatialHashGrid& operator=(const SpatialHashGrid&)  = delete;
+    SpatialHashGrid           (SpatialHashGrid&&)       = default;
+    SpatialHashGrid& operator=(SpatialHashGrid&&)       = default;
+    // clang-format on
+
+    /// Inserts a new object and returns its identifier
+    ObjectId Insert(const BoundBox& Box);
+
+    /// Updates the bounding box of an existing object
+    void Move(ObjectId Id, const BoundBox& Box);
+
+    /// Removes the object from the grid. The identifier may be reused by subsequent insertions.
+    void Remove(ObjectId Id);
+
+    /// Returns the bounding box of the object
+    const BoundBox& GetBox(ObjectId Id) const;
+
+    /// Returns the number of objects in the grid
+    Uint32 GetNumObjects() const { return m_NumObjects; }
+
+    /// Returns the number of allocated non-empty cells
+    Uint32 GetNumCells() const { return static_cast<Uint32>(m_CellMap.size()); }
+
+    /// Appends identifiers of all objects whose boxes are not invisible in the frustum,
+    /// as defined by GetBoxVisibility(), to the Objects array.
+    void QueryFrustum(const ViewFrustum&    Frustum,
+                      std::vector<ObjectId>& Objects,
+                      FRUSTUM_PLANE_FLAGS    PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) const;
+
+    /// Performs frustum queries for multiple frustums with a single traversal of the grid.
+    /// Results for frustum i are appended to pObjectLists[i].
+    void QueryFrustums(const ViewFrustum*     pFrustums,
+                       Uint32                 NumFrustums,
+                       std::vector<ObjectId>* pObjectLists,
+                       FRUSTUM_PLANE_FLAGS    PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) const;
+
+    /// Appends identifiers of all objects whose boxes overlap the sphere to the Objects array
+    void QuerySphere(const float3&          Center,
+                     float                  Radius,
+                     std::vector<ObjectId>& Objects) const;
+
+    /// Appends identifiers of all objects whose boxes overlap the box to the Objects array
+    void QueryBox(const BoundBox&        Box,
+                  std::vector<ObjectId>& Objects) const;
+
+private:
+    struct Cell
+    {
+        Uint64 Key = 0;
+
+        // Loose bounds that enclose all boxes in the cell. The bounds only grow
+        // while the cell is not empty.
+        BoundBox Bounds;
+
+        std::vector<BoundBox> Boxes;
+        std::vector<ObjectId> Ids;
+    };
+
+    struct ObjectInfo
+    {
+        Uint32 CellIdx = ~0u;
+        Uint32 Slot    = ~0u;
+    };
+
+    Uint64 GetCellKey(const BoundBox& Box) const;
+    Uint32 GetCell(Uint64 Key);
+    void   AddToCell(Uint32 CellIdx, ObjectId Id, const BoundBox& Box);
+    void   RemoveFromCell(ObjectId Id);
+
+    // Calls Handler for every non-empty cell that may contain objects overlapping the query bounds
+    template <typename THandler>
+    void ForEachCell(const BoundBox& QueryBounds, THandler Handler) const;
+
+    template <typename TCellTest, typename TBoxTest>
+    void Query(const BoundBox& QueryBounds, std::vector<ObjectId>& Objects, TCellTest CellTest, TBoxTest BoxTest) const;
+
+    float m_InvCellSize;
+
+    // The largest half-size of all objects that have been added to the grid. It never
+    // shrinks, which only makes queries visit more cells than necessary.
+    float3 m_MaxHalfSize;
+
+    std::vector<Cell>                  m_Cells;
+    std::vector<Uint32>                m_FreeCells;
+    std::unordered_map<Uint64, Uint32> m_CellMap;
+
+    std::vector<ObjectInfo> m_Objects;
+    std::vector<ObjectId>   m_FreeIds;
+    Uint32                  m_NumObjects = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <system_error>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace ThreadingTools
+{
+
+/// A fixed-size pool of worker threads that execute tasks in the order they were enqueued.
+class ThreadPool
+{
+public:
+    using TaskType = std::function<void()>;
+
+    explicit ThreadPool(Diligent::Uint32 NumThreads) :
+        m_pState{std::make_shared<State>()}
+    {
+        m_Threads.reserve(NumThreads);
+        for (Diligent::Uint32 i = 0; i < NumThreads; ++i)
+        {
+            try
+            {
+                m_Threads.emplace_back(WorkerThreadProc, m_pState);
+            }
+            catch (const std::system_error& err)
+            {
+                LOG_WARNING_MESSAGE("Failed to start worker thread: ", err.what(), ". The pool will use ", m_Threads.size(), " thread(s).");
+                break;
+            }
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_pState->Mtx};
+            m_pState->Stop = true;
+        }
+        m_pState->CondVar.notify_all();
+
+        for (auto& Thread : m_Threads)
+        {
+            // The pool may be destroyed by one of its own tasks, e.g. when the task releases the
+            // last reference to the object that owns the pool. The worker keeps the shared state
+            // alive and exits as soon as the task returns.
+            if (Thread.get_id() == std::this_thread::get_id())
+                Thread.detach();
+            else
+                Thread.join();
+        }
+    }
+
+    // clang-format off
+    ThreadPool           (const ThreadPool&)  = delete;
+    ThreadPool           (      ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&)  = delete;
+    ThreadPool& operator=(      ThreadPool&&) = delete;
+    // clang-format on
+
+    /// Adds the task to the queue. If the pool failed to start any threads,
+    /// the task is executed by the calling thread.
+    void EnqueueTask(TaskType Task)
+    {
+        VERIFY_EXPR(Task);
+        if (m_Threads.empty())
+        {
+            Task();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> Lock{m_pState->Mtx};
+            VERIFY(!m_pState->Stop, "Enqueueing a task into the pool that is being destroyed");
+            m_pState->Tasks.emplace_back(std::move(Task));
+        }
+        m_pState->CondVar.notify_one();
+    }
+
+    Diligent::Uint32 GetNumThreads() const
+    {
+        return static_cast<Diligent::Uint32>(m_Threads.size());
+    }
+
+private:
+    struct State
+    {
+        std::mutex              Mtx;
+        std::condition_variable CondVar;
+        std::deque<TaskType>    Tasks;
+        bool                    Stop = false;
+    };
+
+    static void WorkerThreadProc(std::shared_ptr<State> pState)
+    {
+        while (true)
+        {
+            TaskType Task;
+            {
+                std::unique_lock<std::mutex> Lock{pState->Mtx};
+                pState->CondVar.wait(Lock, [&] { return pState->Stop || !pState->Tasks.empty(); });
+                // Tasks that are still in the queue are completed before the thread exits
+                if (pState->Tasks.empty())
+                    return;
+
+                Task = std::move(pState->Tasks.front());
+                pState->Tasks.pop_front();
+            }
+
+            Task();
+        }
+    }
+
+    std::shared_ptr<State>   m_pState;
+    std::vector<std::thread> m_Threads;
+};
+
+} // namespace ThreadingTools
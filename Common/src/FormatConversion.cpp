@@ -0,0 +1,184 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "FormatConversion.hpp"
+
+#if defined(__F16C__) || defined(__AVX2__)
+// F16C instructions are available on all CPUs that support AVX2, but MSVC does not
+// define a separate macro for them.
+#    define DILIGENT_USE_F16C 1
+#    include <immintrin.h>
+#else
+#    define DILIGENT_USE_F16C 0
+#endif
+
+namespace Diligent
+{
+
+void ConvertFloatToHalf(const float* pSrc, Uint16* pDst, size_t Count)
+{
+    VERIFY_EXPR(Count == 0 || (pSrc != nullptr && pDst != nullptr));
+    size_t i = 0;
+#if DILIGENT_USE_F16C
+    for (; i + 8 <= Count; i += 8)
+    {
+        const __m256 f = _mm256_loadu_ps(pSrc + i);
+        __m128i      h = _mm256_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT);
+
+        // The instruction keeps NaN payloads, while FloatToHalf() returns the canonical NaN,
+        // so replace all bits except for the sign in NaN elements.
+        const __m256i NaNMask32 = _mm256_castps_si256(_mm256_cmp_ps(f, f, _CMP_UNORD_Q));
+        const __m128i NaNMask   = _mm_packs_epi32(_mm256_castsi256_si128(NaNMask32), _mm256_extractf128_si256(NaNMask32, 1));
+        h                       = _mm_andnot_si128(_mm_and_si128(NaNMask, _mm_set1_epi16(0x7FFF)), h);
+        h                       = _mm_or_si128(h, _mm_and_si128(NaNMask, _mm_set1_epi16(0x7E00)));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), h);
+    }
+#endif
+    for (; i < Count; ++i)
+        pDst[i] = FloatToHalf(pSrc[i]);
+}
+
+void ConvertHalfToFloat(const Uint16* pSrc, float* pDst, size_t Count)
+{
+    VERIFY_EXPR(Count == 0 || (pSrc != nullptr && pDst != nullptr));
+    size_t i = 0;
+#if DILIGENT_USE_F16C
+    for (; i + 8 <= Count; i += 8)
+    {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+        _mm256_storeu_ps(pDst + i, _mm256_cvtph_ps(h));
+    }
+#endif
+    for (; i < Count; ++i)
+        pDst[i] = HalfToFloat(pSrc[i]);
+}
+
+// The loops below contain no branches and are vectorized by the compiler.
+
+template <typename DstType>
+static void ConvertFloatToUNormImpl(const float* pSrc, DstType* pDst, size_t Count)
+{
+    VERIFY_EXPR(Count == 0 || (pSrc != nullptr && pDst != nullptr));
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = FloatToUNorm<DstType>(pSrc[i]);
+}
+
+template <typename DstType>
+static void ConvertFloatToSNormImpl(const float* pSrc, DstType* pDst, size_t Count)
+{
+    VERIFY_EXPR(Count == 0 || (pSrc != nullptr && pDst != nullptr));
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = FloatToSNorm<DstType>(pSrc[i]);
+}
+
+template <typename SrcType>
+static void ConvertUNormToFloatImpl(const SrcType* pSrc, float* pDst, size_t Count)
+{
+    VERIFY_EXPR(Count == 0 || (pSrc != nullptr && pDst != nullptr));
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = UNormToFloat(pSrc[i]);
+}
+
+template <typename SrcType>
+static void ConvertSNormToFloatImpl(const SrcType* pSrc, float* pDst, size_t Count)
+{
+    VERIFY_EXPR(Count == 0 || (pSrc != nullptr && pDst != nullptr));
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = SNormToFloat(pSrc[i]);
+}
+
+void ConvertFloatToUNorm8(const float* pSrc, Uint8* pDst, size_t Count)
+{
+    ConvertFloatToUNormImpl(pSrc, pDst, Count);
+}
+
+void ConvertFloatToUNorm16(const float* pSrc, Uint16* pDst, size_t Count)
+{
+    ConvertFloatToUNormImpl(pSrc, pDst, Count);
+}
+
+void ConvertFloatToSNorm8(const float* pSrc, Int8* pDst, size_t Count)
+{
+    ConvertFloatToSNormImpl(pSrc, pDst, Count);
+}
+
+void ConvertFloatToSNorm16(const float* pSrc, Int16* pDst, size_t Count)
+{
+    ConvertFloatToSNormImpl(pSrc, pDst, Count);
+}
+
+void ConvertUNorm8ToFloat(const Uint8* pSrc, float* pDst, size_t Count)
+{
+    ConvertUNormToFloatImpl(pSrc, pDst, Count);
+}
+
+void ConvertUNorm16ToFloat(const Uint16* pSrc, float* pDst, size_t Count)
+{
+    ConvertUNormToFloatImpl(pSrc, pDst, Count);
+}
+
+void ConvertSNorm8ToFloat(const Int8* pSrc, float* pDst, size_t Count)
+{
+    ConvertSNormToFloatImpl(pSrc, pDst, Count);
+}
+
+void ConvertSNorm16ToFloat(const Int16* pSrc, float* pDst, size_t Count)
+{
+    ConvertSNormToFloatImpl(pSrc, pDst, Count);
+}
+
+void PackOctahedralNormals(const float3* pSrc, Uint32* pDst, size_t Count)
+{
+    VERIFY_EXPR(Count == 0 || (pSrc != nullptr && pDst != nullptr));
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = PackOctahedralNormal(pSrc[i]);
+}
+
+void UnpackOctahedralNormals(const Uint32* pSrc, float3* pDst, size_t Count)
+{
+    VERIFY_EXPR(Count == 0 || (pSrc != nullptr && pDst != nullptr));
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = UnpackOctahedralNormal(pSrc[i]);
+}
+
+void PackRGB10A2(const float4* pSrc, Uint32* pDst, size_t Count)
+{
+    VERIFY_EXPR(Count == 0 || (pSrc != nullptr && pDst != nullptr));
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = PackRGB10A2(pSrc[i]);
+}
+
+void UnpackRGB10A2(const Uint32* pSrc, float4* pDst, size_t Count)
+{
+    VERIFY_EXPR(Count == 0 || (pSrc != nullptr && pDst != nullptr));
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = UnpackRGB10A2(pSrc[i]);
+}
+
+} // namespace Diligent
@@ -0,0 +1,188 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "ShadowCascades.hpp"
+
+namespace Diligent
+{
+
+void ComputeCascadeSplits(float  NearZ,
+                          float  FarZ,
+                          Uint32 NumCascades,
+                          float  PartitioningFactor,
+                          float* pSplits)
+{
+    VERIFY_EXPR(pSplits != nullptr && NumCascades > 0);
+    VERIFY_EXPR(NearZ > 0 && FarZ >= NearZ);
+    VERIFY_EXPR(PartitioningFactor >= 0 && PartitioningFactor <= 1);
+
+    pSplits[0] = NearZ;
+    for (Uint32 i = 1; i < NumCascades; ++i)
+    {
+        const float Ratio        = static_cast<float>(i) / static_cast<float>(NumCascades);
+        const float LogSplit     = NearZ * std::pow(FarZ / NearZ, Ratio);
+        const float UniformSplit = NearZ + (FarZ - NearZ) * Ratio;
+        pSplits[i]               = UniformSplit + (LogSplit - UniformSplit) * PartitioningFactor;
+    }
+    pSplits[NumCascades] = FarZ;
+}
+
+void ComputeShadowCascades(const ShadowCascadeAttribs& Attribs,
+                           ShadowCascade*              pCascades)
+{
+    VERIFY_EXPR(pCascades != nullptr && Attribs.NumCascades > 0);
+    VERIFY_EXPR(Attribs.Resolution > 0);
+
+    float CameraNearZ = 0, CameraFarZ = 0;
+    Attribs.CameraProj.GetNearFarClipPlanes(CameraNearZ, CameraFarZ, Attribs.IsGL);
+    if (Attribs.MaxShadowDistance > 0)
+        CameraFarZ = std::min(CameraFarZ, Attribs.MaxShadowDistance);
+
+    std::vector<float> Splits(Attribs.NumCascades + 1);
+    ComputeCascadeSplits(CameraNearZ, CameraFarZ, Attribs.NumCascades, Attribs.PartitioningFactor, Splits.data());
+
+    // Light space basis. The basis only depends on the light direction, which
+    // keeps the shadow map texel grid fixed in world space.
+    const float3 LightSpaceZ = normalize(Attribs.LightDir);
+    const float3 Up          = std::abs(LightSpaceZ.y) < 0.99f ? float3{0, 1, 0} : float3{1, 0, 0};
+    const float3 LightSpaceX = normalize(cross(Up, LightSpaceZ));
+    const float3 LightSpaceY = cross(LightSpaceZ, LightSpaceX);
+    const auto   LightView   = float4x4::ViewFromBasis(LightSpaceX, LightSpaceY, LightSpaceZ);
+
+    const auto CameraViewToWorld = Attribs.CameraView.Inverse();
+
+    for (Uint32 i = 0; i < Attribs.NumCascades; ++i)
+    {
+        auto& Cascade = pCascades[i];
+
+        Cascade.NearZ     = Splits[i];
+        Cascade.FarZ      = Splits[i + 1];
+        Cascade.LightView = LightView;
+
+        // The bounding sphere only depends on the projection parameters and the split
+        // distances, but not on the camera position or orientation.
+        float3 ViewSpaceCenter;
+        GetFrustumMinimumBoundingSphere(Attribs.CameraProj._11, Attribs.CameraProj._22, Cascade.NearZ, Cascade.FarZ, ViewSpaceCenter, Cascade.Radius);
+        Cascade.Center = ViewSpaceCenter * CameraViewToWorld;
+
+        Cascade.TexelSize = 2.f * Cascade.Radius / static_cast<float>(Attribs.Resolution);
+
+        float3 LightSpaceCenter = Cascade.Center * LightView;
+        if (Attribs.SnapToTexels)
+        {
+            LightSpaceCenter.x = FastFloor(LightSpaceCenter.x / Cascade.TexelSize) * Cascade.TexelSize;
+            LightSpaceCenter.y = FastFloor(LightSpaceCenter.y / Cascade.TexelSize) * Cascade.TexelSize;
+        }
+
+        Cascade.Proj = float4x4::OrthoOffCenter(
+            LightSpaceCenter.x - Cascade.Radius,
+            LightSpaceCenter.x + Cascade.Radius,
+            LightSpaceCenter.y - Cascade.Radius,
+            LightSpaceCenter.y + Cascade.Radius,
+            LightSpaceCenter.z - Cascade.Radius - Attribs.CasterExtension,
+            LightSpaceCenter.z + Cascade.Radius,
+            Attribs.IsGL);
+
+        Cascade.ViewProj = Cascade.LightView * Cascade.Proj;
+        ExtractViewFrustumPlanesFromMatrix(Cascade.ViewProj, Cascade.Frustum, Attribs.IsGL);
+    }
+}
+
+void CullBoxesAgainstShadowCascades(const ShadowCascade* pCascades,
+                                    Uint32               NumCascades,
+                                    const BoundBox*      pBoxes,
+                                    Uint32               NumBoxes,
+                                    std::vector<Uint32>* pVisibleLists,
+                                    FRUSTUM_PLANE_FLAGS  PlaneFlags)
+{
+    VERIFY_EXPR(NumCascades == 0 || (pCascades != nullptr && pVisibleLists != nullptr));
+    VERIFY_EXPR(NumBoxes == 0 || pBoxes != nullptr);
+
+    // Gather the planes of all cascades into structure-of-arrays layout so that
+    // every box is tested against all planes by a single vectorizable loop.
+    const size_t       NumPlanes = size_t{NumCascades} * ViewFrustum::NUM_PLANES;
+    std::vector<float> PlaneData(NumPlanes * 4);
+
+    float* Nx = &PlaneData[NumPlanes * 0];
+    float* Ny = &PlaneData[NumPlanes * 1];
+    float* Nz = &PlaneData[NumPlanes * 2];
+    float* D  = &PlaneData[NumPlanes * 3];
+    for (Uint32 c = 0; c < NumCascades; ++c)
+    {
+        for (Uint32 p = 0; p < ViewFrustum::NUM_PLANES; ++p)
+        {
+            const auto PlaneIdx = c * ViewFrustum::NUM_PLANES + p;
+            if ((PlaneFlags & (1 << p)) != 0)
+            {
+                const auto& Plane = pCascades[c].Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(p));
+
+                Nx[PlaneIdx] = Plane.Normal.x;
+                Ny[PlaneIdx] = Plane.Normal.y;
+                Nz[PlaneIdx] = Plane.Normal.z;
+                D[PlaneIdx]  = Plane.Distance;
+            }
+            else
+            {
+                // Disabled planes never reject a box
+                Nx[PlaneIdx] = 0;
+                Ny[PlaneIdx] = 0;
+                Nz[PlaneIdx] = 0;
+                D[PlaneIdx]  = 1;
+            }
+        }
+    }
+
+    std::vector<int> Outside(NumPlanes);
+    for (Uint32 b = 0; b < NumBoxes; ++b)
+    {
+        const auto& Box = pBoxes[b];
+        for (size_t p = 0; p < NumPlanes; ++p)
+        {
+            // Same computations as in GetBoxVisibilityAgainstPlane()
+            const float MaxX = Nx[p] > 0 ? Box.Max.x : Box.Min.x;
+            const float MaxY = Ny[p] > 0 ? Box.Max.y : Box.Min.y;
+            const float MaxZ = Nz[p] > 0 ? Box.Max.z : Box.Min.z;
+            const float DMax = MaxX * Nx[p] + MaxY * Ny[p] + MaxZ * Nz[p] + D[p];
+            Outside[p]       = DMax < 0 ? 1 : 0;
+        }
+
+        for (Uint32 c = 0; c < NumCascades; ++c)
+        {
+            const int* CascadeOutside = &Outside[size_t{c} * ViewFrustum::NUM_PLANES];
+
+            int IsOutside = 0;
+            for (Uint32 p = 0; p < ViewFrustum::NUM_PLANES; ++p)
+                IsOutside |= CascadeOutside[p];
+
+            if (IsOutside == 0)
+                pVisibleLists[c].push_back(b);
+        }
+    }
+}
+
+} // namespace Diligent
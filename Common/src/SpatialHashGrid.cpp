@@ -0,0 +1,413 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "SpatialHashGrid.hpp"
+
+namespace Diligent
+{
+
+SpatialHashGrid::SpatialHashGrid(float CellSize) :
+    m_InvCellSize{1.f / CellSize}
+{
+    VERIFY(CellSize > 0, "Cell size must be positive");
+}
+
+namespace
+{
+
+// Cell coordinates are packed into the key as 21-bit signed values
+constexpr Int64  MaxCellCoord = (1 << 20) - 1;
+constexpr Uint64 CellKeyMask  = (Uint64{1} << 21) - 1;
+
+Int64 GetCellCoord(float GridCoord)
+{
+    // Clamp as float to also handle huge and infinite query bounds
+    const auto MaxCoord = static_cast<float>(MaxCellCoord);
+    return static_cast<Int64>(clamp(std::floor(GridCoord), -MaxCoord, MaxCoord));
+}
+
+Uint64 PackCellKey(Int64 x, Int64 y, Int64 z)
+{
+    return (static_cast<Uint64>(x) & CellKeyMask) |
+        ((static_cast<Uint64>(y) & CellKeyMask) << 21) |
+        ((static_cast<Uint64>(z) & CellKeyMask) << 42);
+}
+
+const BoundBox UnboundedBox{float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}, float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}};
+
+// Returns the bounding box of the frustum corners, or the unbounded box if the frustum is not closed
+BoundBox GetFrustumBounds(const ViewFrustum& Frustum, FRUSTUM_PLANE_FLAGS PlaneFlags)
+{
+    if ((PlaneFlags & FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) != FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+        return UnboundedBox;
+
+    BoundBox Bounds{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+    for (Uint32 Corner = 0; Corner < 8; ++Corner)
+    {
+        // Every corner is the intersection of three planes: dot(Normal, P) + Distance = 0
+        const auto& P0 = (Corner & 0x01) ? Frustum.RightPlane : Frustum.LeftPlane;
+        const auto& P1 = (Corner & 0x02) ? Frustum.TopPlane : Frustum.BottomPlane;
+        const auto& P2 = (Corner & 0x04) ? Frustum.FarPlane : Frustum.NearPlane;
+
+        const float3 N12 = cross(P1.Normal, P2.Normal);
+        const float  Det = dot(P0.Normal, N12);
+        if (std::abs(Det) < 1e-20f)
+            return UnboundedBox;
+
+        const float3 Point = -(N12 * P0.Distance + cross(P2.Normal, P0.Normal) * P1.Distance + cross(P0.Normal, P1.Normal) * P2.Distance) / Det;
+        if (!std::isfinite(Point.x) || !std::isfinite(Point.y) || !std::isfinite(Point.z))
+            return UnboundedBox;
+
+        Bounds.Min = std::min(Bounds.Min, Point);
+        Bounds.Max = std::max(Bounds.Max, Point);
+    }
+
+    return Bounds;
+}
+
+} // namespace
+
+Uint64 SpatialHashGrid::GetCellKey(const BoundBox& Box) const
+{
+    const float3 Center = (Box.Min + Box.Max) * 0.5f;
+    const float3 Coords = Center * m_InvCellSize;
+    return PackCellKey(GetCellCoord(Coords.x), GetCellCoord(Coords.y), GetCellCoord(Coords.z));
+}
+
+Uint32 SpatialHashGrid::GetCell(Uint64 Key)
+{
+    auto it = m_CellMap.find(Key);
+    if (it != m_CellMap.end())
+        return it->second;
+
+    Uint32 CellIdx = 0;
+    if (!m_FreeCells.empty())
+    {
+        CellIdx = m_FreeCells.back();
+        m_FreeCells.pop_back();
+    }
+    else
+    {
+        CellIdx = static_cast<Uint32>(m_Cells.size());
+        m_Cells.emplace_back();
+    }
+
+    auto& NewCell = m_Cells[CellIdx];
+    VERIFY_EXPR(NewCell.Ids.empty());
+    NewCell.Key    = Key;
+    NewCell.Bounds = BoundBox{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+    m_CellMap.emplace(Key, CellIdx);
+
+    return CellIdx;
+}
+
+void SpatialHashGrid::AddToCell(Uint32 CellIdx, ObjectId Id, const BoundBox& Box)
+{
+    auto& DstCell = m_Cells[CellIdx];
+
+    auto& ObjInfo   = m_Objects[Id];
+    ObjInfo.CellIdx = CellIdx;
+    ObjInfo.Slot    = static_cast<Uint32>(DstCell.Ids.size());
+
+    DstCell.Ids.push_back(Id);
+    DstCell.Boxes.push_back(Box);
+    DstCell.Bounds.Min = std::min(DstCell.Bounds.Min, Box.Min);
+    DstCell.Bounds.Max = std::max(DstCell.Bounds.Max, Box.Max);
+
+    m_MaxHalfSize = std::max(m_MaxHalfSize, (Box.Max - Box.Min) * 0.5f);
+}
+
+void SpatialHashGrid::RemoveFromCell(ObjectId Id)
+{
+    auto& ObjInfo = m_Objects[Id];
+    auto& SrcCell = m_Cells[ObjInfo.CellIdx];
+    VERIFY_EXPR(SrcCell.Ids[ObjInfo.Slot] == Id);
+
+    // Move the last object in the cell to the freed slot
+    const auto LastId = SrcCell.Ids.back();
+    if (LastId != Id)
+    {
+        SrcCell.Ids[ObjInfo.Slot]   = LastId;
+        SrcCell.Boxes[ObjInfo.Slot] = SrcCell.Boxes.back();
+        m_Objects[LastId].Slot      = ObjInfo.Slot;
+    }
+    SrcCell.Ids.pop_back();
+    SrcCell.Boxes.pop_back();
+
+    if (SrcCell.Ids.empty())
+    {
+        m_CellMap.erase(SrcCell.Key);
+        m_FreeCells.push_back(ObjInfo.CellIdx);
+    }
+
+    ObjInfo = ObjectInfo{};
+}
+
+SpatialHashGrid::ObjectId SpatialHashGrid::Insert(const BoundBox& Box)
+{
+    VERIFY(Box.Max.x >= Box.Min.x && Box.Max.y >= Box.Min.y && Box.Max.z >= Box.Min.z, "Invalid bounding box");
+
+    ObjectId Id = 0;
+    if (!m_FreeIds.empty())
+    {
+        Id = m_FreeIds.back();
+        m_FreeIds.pop_back();
+    }
+    else
+    {
+        Id = static_cast<ObjectId>(m_Objects.size());
+        m_Objects.emplace_back();
+    }
+
+    AddToCell(GetCell(GetCellKey(Box)), Id, Box);
+    ++m_NumObjects;
+
+    return Id;
+}
+
+void SpatialHashGrid::Move(ObjectId Id, const BoundBox& Box)
+{
+    VERIFY(Id < m_Objects.size() && m_Objects[Id].CellIdx != ~0u, "Invalid object id");
+    VERIFY(Box.Max.x >= Box.Min.x && Box.Max.y >= Box.Min.y && Box.Max.z >= Box.Min.z, "Invalid bounding box");
+
+    const auto& ObjInfo  = m_Objects[Id];
+    const auto  Key      = GetCellKey(Box);
+    auto&       CurrCell = m_Cells[ObjInfo.CellIdx];
+    if (CurrCell.Key == Key)
+    {
+        CurrCell.Boxes[ObjInfo.Slot] = Box;
+        CurrCell.Bounds.Min          = std::min(CurrCell.Bounds.Min, Box.Min);
+        CurrCell.Bounds.Max          = std::max(CurrCell.Bounds.Max, Box.Max);
+
+        m_MaxHalfSize = std::max(m_MaxHalfSize, (Box.Max - Box.Min) * 0.5f);
+    }
+    else
+    {
+        RemoveFromCell(Id);
+        AddToCell(GetCell(Key), Id, Box);
+    }
+}
+
+void SpatialHashGrid::Remove(ObjectId Id)
+{
+    VERIFY(Id < m_Objects.size() && m_Objects[Id].CellIdx != ~0u, "Invalid object id");
+    RemoveFromCell(Id);
+    m_FreeIds.push_back(Id);
+    VERIFY_EXPR(m_NumObjects > 0);
+    --m_NumObjects;
+}
+
+const BoundBox& SpatialHashGrid::GetBox(ObjectId Id) const
+{
+    VERIFY(Id < m_Objects.size() && m_Objects[Id].CellIdx != ~0u, "Invalid object id");
+    const auto& ObjInfo = m_Objects[Id];
+    return m_Cells[ObjInfo.CellIdx].Boxes[ObjInfo.Slot];
+}
+
+template <typename THandler>
+void SpatialHashGrid::ForEachCell(const BoundBox& QueryBounds, THandler Handler) const
+{
+    // An object overlaps the query bounds only if its center is within its half-size from
+    // the bounds. The margin accounts for the rounding of the object center computation.
+    const float3 Margin = m_MaxHalfSize + (abs(QueryBounds.Min) + abs(QueryBounds.Max)) * 1e-6f;
+
+    const float3 MinCoords = (QueryBounds.Min - Margin) * m_InvCellSize;
+    const float3 MaxCoords = (QueryBounds.Max + Margin) * m_InvCellSize;
+
+    const Int64 MinX = GetCellCoord(MinCoords.x), MaxX = GetCellCoord(MaxCoords.x);
+    const Int64 MinY = GetCellCoord(MinCoords.y), MaxY = GetCellCoord(MaxCoords.y);
+    const Int64 MinZ = GetCellCoord(MinCoords.z), MaxZ = GetCellCoord(MaxCoords.z);
+
+    const double NumRangeCells = static_cast<double>(MaxX - MinX + 1) * static_cast<double>(MaxY - MinY + 1) * static_cast<double>(MaxZ - MinZ + 1);
+    if (NumRangeCells <= static_cast<double>(m_CellMap.size()))
+    {
+        for (Int64 z = MinZ; z <= MaxZ; ++z)
+        {
+            for (Int64 y = MinY; y <= MaxY; ++y)
+            {
+                for (Int64 x = MinX; x <= MaxX; ++x)
+                {
+                    auto it = m_CellMap.find(PackCellKey(x, y, z));
+                    if (it != m_CellMap.end())
+                        Handler(m_Cells[it->second]);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (const auto& CurrCell : m_Cells)
+        {
+            if (!CurrCell.Ids.empty())
+                Handler(CurrCell);
+        }
+    }
+}
+
+// CellTest returns BoxVisibility for the cell bounds, BoxTest returns true if the box passes the test.
+template <typename TCellTest, typename TBoxTest>
+void SpatialHashGrid::Query(const BoundBox& QueryBounds, std::vector<ObjectId>& Objects, TCellTest CellTest, TBoxTest BoxTest) const
+{
+    ForEachCell(QueryBounds, [&](const Cell& CurrCell) {
+        const auto CellVisibility = CellTest(CurrCell.Bounds);
+        if (CellVisibility == BoxVisibility::Invisible)
+            return;
+
+        if (CellVisibility == BoxVisibility::FullyVisible)
+        {
+            Objects.insert(Objects.end(), CurrCell.Ids.begin(), CurrCell.Ids.end());
+        }
+        else
+        {
+            const auto NumBoxes = CurrCell.Boxes.size();
+            for (size_t i = 0; i < NumBoxes; ++i)
+            {
+                if (BoxTest(CurrCell.Boxes[i]))
+                    Objects.push_back(CurrCell.Ids[i]);
+            }
+        }
+    });
+}
+
+void SpatialHashGrid::QueryFrustum(const ViewFrustum&     Frustum,
+                                   std::vector<ObjectId>& Objects,
+                                   FRUSTUM_PLANE_FLAGS    PlaneFlags) const
+{
+    Query(
+        GetFrustumBounds(Frustum, PlaneFlags),
+        Objects,
+        [&](const BoundBox& Bounds) {
+            return GetBoxVisibility(Frustum, Bounds, PlaneFlags);
+        },
+        [&](const BoundBox& Box) {
+            return GetBoxVisibility(Frustum, Box, PlaneFlags) != BoxVisibility::Invisible;
+        });
+}
+
+void SpatialHashGrid::QueryFrustums(const ViewFrustum*     pFrustums,
+                                    Uint32                 NumFrustums,
+                                    std::vector<ObjectId>* pObjectLists,
+                                    FRUSTUM_PLANE_FLAGS    PlaneFlags) const
+{
+    VERIFY_EXPR(NumFrustums == 0 || (pFrustums != nullptr && pObjectLists != nullptr));
+
+    BoundBox QueryBounds{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+    for (Uint32 f = 0; f < NumFrustums; ++f)
+    {
+        const auto FrustumBounds = GetFrustumBounds(pFrustums[f], PlaneFlags);
+
+        QueryBounds.Min = std::min(QueryBounds.Min, FrustumBounds.Min);
+        QueryBounds.Max = std::max(QueryBounds.Max, FrustumBounds.Max);
+    }
+
+    std::vector<BoxVisibility> CellVisibility(NumFrustums);
+    ForEachCell(QueryBounds, [&](const Cell& CurrCell) {
+        for (Uint32 f = 0; f < NumFrustums; ++f)
+            CellVisibility[f] = GetBoxVisibility(pFrustums[f], CurrCell.Bounds, PlaneFlags);
+
+        for (Uint32 f = 0; f < NumFrustums; ++f)
+        {
+            if (CellVisibility[f] == BoxVisibility::FullyVisible)
+                pObjectLists[f].insert(pObjectLists[f].end(), CurrCell.Ids.begin(), CurrCell.Ids.end());
+        }
+
+        // Test every box in the cell against all frustums that intersect the cell
+        const auto NumBoxes = CurrCell.Boxes.size();
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            const auto& Box = CurrCell.Boxes[i];
+            for (Uint32 f = 0; f < NumFrustums; ++f)
+            {
+                if (CellVisibility[f] == BoxVisibility::Intersecting &&
+                    GetBoxVisibility(pFrustums[f], Box, PlaneFlags) != BoxVisibility::Invisible)
+                {
+                    pObjectLists[f].push_back(CurrCell.Ids[i]);
+                }
+            }
+        }
+    });
+}
+
+void SpatialHashGrid::QuerySphere(const float3&          Center,
+                                  float                  Radius,
+                                  std::vector<ObjectId>& Objects) const
+{
+    VERIFY_EXPR(Radius >= 0);
+    const float RadiusSq = Radius * Radius;
+
+    auto GetDistSq = [&](const BoundBox& Box) {
+        const float3 d = std::max(std::max(Box.Min - Center, Center - Box.Max), float3{0, 0, 0});
+        return dot(d, d);
+    };
+    auto GetMaxDistSq = [&](const BoundBox& Box) {
+        const float3 d = std::max(abs(Box.Min - Center), abs(Box.Max - Center));
+        return dot(d, d);
+    };
+
+    const BoundBox SphereBounds{Center - float3{Radius, Radius, Radius}, Center + float3{Radius, Radius, Radius}};
+    Query(
+        SphereBounds,
+        Objects,
+        [&](const BoundBox& Bounds) {
+            if (GetDistSq(Bounds) > RadiusSq)
+                return BoxVisibility::Invisible;
+            return GetMaxDistSq(Bounds) <= RadiusSq ? BoxVisibility::FullyVisible : BoxVisibility::Intersecting;
+        },
+        [&](const BoundBox& Box) {
+            return GetDistSq(Box) <= RadiusSq;
+        });
+}
+
+void SpatialHashGrid::QueryBox(const BoundBox&        Box,
+                               std::vector<ObjectId>& Objects) const
+{
+    auto Overlap = [&](const BoundBox& B) {
+        // clang-format off
+        return B.Min.x <= Box.Max.x && B.Max.x >= Box.Min.x &&
+               B.Min.y <= Box.Max.y && B.Max.y >= Box.Min.y &&
+               B.Min.z <= Box.Max.z && B.Max.z >= Box.Min.z;
+        // clang-format on
+    };
+
+    Query(
+        Box,
+        Objects,
+        [&](const BoundBox& Bounds) {
+            if (!Overlap(Bounds))
+                return BoxVisibility::Invisible;
+            // clang-format off
+            const bool Inside = Bounds.Min.x >= Box.Min.x && Bounds.Max.x <= Box.Max.x &&
+                                Bounds.Min.y >= Box.Min.y && Bounds.Max.y <= Box.Max.y &&
+                                Bounds.Min.z >= Box.Min.z && Bounds.Max.z <= Box.Max.z;
+            // clang-format on
+            return Inside ? BoxVisibility::FullyVisible : BoxVisibility::Intersecting;
+        },
+        Overlap);
+}
+
+} // namespace Diligent
@@ -0,0 +1,246 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the Diligent::BindlessResourceTableBase template class
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "BindlessResourceTable.h"
+#include "Shader.h"
+#include "DeviceObjectBase.hpp"
+#include "GraphicsTypes.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Validates bindless resource table description and throws an exception in case of an error.
+void ValidateBindlessResourceTableDesc(const BindlessResourceTableDesc& Desc, const DeviceCaps& deviceCaps) noexcept(false);
+
+/// Returns the size of the descriptor array of the given type in the bindless resource table.
+Uint32 GetBindlessTableArraySize(const BindlessResourceTableDesc& Desc, BINDLESS_RESOURCE_TYPE Type);
+
+/// Returns the bindless resource type of the object, or BINDLESS_RESOURCE_TYPE_COUNT
+/// if the object can't be placed into a bindless resource table.
+BINDLESS_RESOURCE_TYPE GetBindlessResourceType(IDeviceObject* pObject);
+
+/// Returns the bindless resource type that unbounded shader resource arrays of the given
+/// type are bound to, or BINDLESS_RESOURCE_TYPE_COUNT if such arrays are not supported.
+BINDLESS_RESOURCE_TYPE GetBindlessResourceType(SHADER_RESOURCE_TYPE ResourceType);
+
+/// Returns the type of the bindless table array that the unbounded shader resource array is bound to.
+/// Throws an exception if the pipeline has no table, or the table can't hold resources of this type.
+BINDLESS_RESOURCE_TYPE GetUnboundedArrayBindlessType(const IBindlessResourceTable* pTable,
+                                                     SHADER_RESOURCE_TYPE          ResourceType,
+                                                     const Char*                   ResourceName,
+                                                     const Char*                   ShaderName,
+                                                     const Char*                   PSOName) noexcept(false);
+
+/// Returns the literal name of the bindless resource type, e.g. "texture SRV".
+const Char* GetBindlessResourceTypeString(BINDLESS_RESOURCE_TYPE Type);
+
+
+/// Allocates bindless resource handles of every type.
+
+/// Released handles are first marked as pending and are returned to the free list by Recycle()
+/// once the GPU is done with them. The allocator is shared between the table and the stale
+/// handle wrappers in device release queues that may outlive the table.
+class BindlessHandleAllocator
+{
+public:
+    /// Returns the most recently recycled handle or the next unused one,
+    /// or INVALID_BINDLESS_HANDLE if all ArraySize handles are in use.
+    Uint32 Allocate(BINDLESS_RESOURCE_TYPE Type, Uint32 ArraySize);
+
+    /// Marks the handle as released, but not yet available for reuse.
+    void MarkPending(BINDLESS_RESOURCE_TYPE Type);
+
+    /// Makes the pending handle available for reuse.
+    void Recycle(BINDLESS_RESOURCE_TYPE Type, Uint32 Handle);
+
+    Uint32 GetNumPending(BINDLESS_RESOURCE_TYPE Type) const;
+
+private:
+    mutable std::mutex m_Mtx;
+
+    std::array<std::vector<Uint32>, BINDLESS_RESOURCE_TYPE_COUNT> m_FreeHandles;
+    std::array<Uint32, BINDLESS_RESOURCE_TYPE_COUNT>              m_NextHandle = {};
+    std::array<Uint32, BINDLESS_RESOURCE_TYPE_COUNT>              m_NumPending = {};
+};
+
+
+/// Template class implementing base functionality of the bindless resource table object
+
+/// \tparam BaseInterface        - Base interface that this class will inheret
+///                                (Diligent::IBindlessResourceTable).
+/// \tparam RenderDeviceImplType - Type of the render device implementation
+template <class BaseInterface, class RenderDeviceImplType>
+class BindlessResourceTableBase : public DeviceObjectBase<BaseInterface, RenderDeviceImplType, BindlessResourceTableDesc>
+{
+public:
+    using TDeviceObjectBase = DeviceObjectBase<BaseInterface, RenderDeviceImplType, BindlessResourceTableDesc>;
+
+    /// \param pRefCounters - Reference counters object that controls the lifetime of this bindless resource table.
+    /// \param pDevice      - Pointer to the device.
+    /// \param Desc         - Bindless resource table description.
+    BindlessResourceTableBase(IReferenceCounters*              pRefCounters,
+                              RenderDeviceImplType*            pDevice,
+                              const BindlessResourceTableDesc& Desc) :
+        TDeviceObjectBase{pRefCounters, pDevice, Desc},
+        m_pHandleAllocator{std::make_shared<BindlessHandleAllocator>()}
+    {
+        ValidateBindlessResourceTableDesc(this->m_Desc, pDevice->GetDeviceCaps());
+
+        Uint64 DeviceQueuesMask = pDevice->GetCommandQueueMask();
+        DEV_CHECK_ERR((this->m_Desc.CommandQueueMask & DeviceQueuesMask) != 0,
+                      "No bits in the command queue mask (0x", std::hex, this->m_Desc.CommandQueueMask,
+                      ") correspond to one of ", pDevice->GetCommandQueueCount(), " available device command queues.");
+        this->m_Desc.CommandQueueMask &= DeviceQueuesMask;
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_BindlessResourceTable, TDeviceObjectBase)
+
+    virtual Uint32 DILIGENT_CALL_TYPE AllocateHandle(IDeviceObject* pObject) override final
+    {
+        DEV_CHECK_ERR(pObject != nullptr, "Object must not be null");
+        if (pObject == nullptr)
+            return INVALID_BINDLESS_HANDLE;
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Handles.find(pObject);
+        if (it != m_Handles.end())
+        {
+            ++it->second.NumRefs;
+            return it->second.Handle;
+        }
+
+        const auto Type = GetBindlessResourceType(pObject);
+        if (Type == BINDLESS_RESOURCE_TYPE_COUNT)
+        {
+            LOG_ERROR_MESSAGE("Object '", pObject->GetDesc().Name, "' can't be placed into bindless resource table '", this->m_Desc.Name,
+                              "'. Only texture views, views of non-dynamic structured or raw buffers, and samplers are allowed.");
+            return INVALID_BINDLESS_HANDLE;
+        }
+
+        const auto Handle = m_pHandleAllocator->Allocate(Type, GetBindlessTableArraySize(this->m_Desc, Type));
+        if (Handle == INVALID_BINDLESS_HANDLE)
+        {
+            LOG_ERROR_MESSAGE("Failed to allocate a handle for object '", pObject->GetDesc().Name, "': ", GetBindlessResourceTypeString(Type),
+                              " array of bindless resource table '", this->m_Desc.Name, "' is full.");
+            return INVALID_BINDLESS_HANDLE;
+        }
+
+        WriteDescriptor(Type, Handle, pObject);
+
+        HandleInfo Info;
+        Info.pObject = pObject;
+        Info.Type    = Type;
+        Info.Handle  = Handle;
+        m_Handles.emplace(pObject, std::move(Info));
+        ++m_NumAllocated[Type];
+
+        return Handle;
+    }
+
+    virtual void DILIGENT_CALL_TYPE ReleaseHandle(IDeviceObject* pObject) override final
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Handles.find(pObject);
+        DEV_CHECK_ERR(it != m_Handles.end(), "Object '", (pObject != nullptr ? pObject->GetDesc().Name : "<null>"), "' is not in bindless resource table '", this->m_Desc.Name, "'");
+        if (it == m_Handles.end())
+            return;
+
+        VERIFY_EXPR(it->second.NumRefs > 0);
+        if (--it->second.NumRefs > 0)
+            return;
+
+        const auto Type   = it->second.Type;
+        const auto Handle = it->second.Handle;
+        m_Handles.erase(it);
+        --m_NumAllocated[Type];
+
+        m_pHandleAllocator->MarkPending(Type);
+        RecycleHandle(Type, Handle);
+    }
+
+    virtual Uint32 DILIGENT_CALL_TYPE GetHandle(IDeviceObject* pObject) const override final
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Handles.find(pObject);
+        return it != m_Handles.end() ? it->second.Handle : INVALID_BINDLESS_HANDLE;
+    }
+
+    virtual void DILIGENT_CALL_TYPE GetStats(BindlessResourceTableStats& Stats) const override final
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        for (Uint32 t = 0; t < BINDLESS_RESOURCE_TYPE_COUNT; ++t)
+        {
+            const auto Type              = static_cast<BINDLESS_RESOURCE_TYPE>(t);
+            Stats.NumAllocatedHandles[t] = m_NumAllocated[Type];
+            Stats.NumPendingHandles[t]   = m_pHandleAllocator->GetNumPending(Type);
+        }
+    }
+
+protected:
+    /// Writes the descriptor of the object into the array of the given type at index Handle.
+    /// Called with the table mutex locked.
+    virtual void WriteDescriptor(BINDLESS_RESOURCE_TYPE Type, Uint32 Handle, IDeviceObject* pObject) = 0;
+
+    /// Returns the released handle to the handle allocator (see BindlessHandleAllocator::Recycle()).
+    /// Backends that execute commands asynchronously must defer this until the GPU is done with the handle.
+    virtual void RecycleHandle(BINDLESS_RESOURCE_TYPE Type, Uint32 Handle) = 0;
+
+    std::shared_ptr<BindlessHandleAllocator> m_pHandleAllocator;
+
+private:
+    struct HandleInfo
+    {
+        RefCntAutoPtr<IDeviceObject> pObject; ///< Strong reference that keeps the object alive while it is in the table
+
+        BINDLESS_RESOURCE_TYPE Type    = BINDLESS_RESOURCE_TYPE_COUNT;
+        Uint32                 Handle  = INVALID_BINDLESS_HANDLE;
+        Uint32                 NumRefs = 1;
+    };
+
+    mutable std::mutex m_Mtx;
+
+    std::unordered_map<IDeviceObject*, HandleInfo> m_Handles;
+
+    std::array<Uint32, BINDLESS_RESOURCE_TYPE_COUNT> m_NumAllocated = {};
+};
+
+} // namespace Diligent
@@ -51,6 +51,11 @@ bool VerifyDrawIndexedAttribs        (const DrawIndexedAttribs&         Attribs)
 bool VerifyDrawIndirectAttribs       (const DrawIndirectAttribs&        Attribs, const IBuffer* pAttribsBuffer);
 bool VerifyDrawIndexedIndirectAttribs(const DrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer);
 
+bool VerifyMultiDrawAttribs               (const MultiDrawAttribs&                Attribs);
+bool VerifyMultiDrawIndexedAttribs        (const MultiDrawIndexedAttribs&         Attribs);
+bool VerifyMultiDrawIndirectAttribs       (const MultiDrawIndirectAttribs&        Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuffer);
+bool VerifyMultiDrawIndexedIndirectAttribs(const MultiDrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuffer);
+
 bool VerifyDispatchComputeAttribs        (const DispatchComputeAttribs&         Attribs);
 bool VerifyDispatchComputeIndirectAttribs(const DispatchComputeIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer);
 // clang-format on
@@ -101,17 +106,18 @@ template <typename BaseInterface, typename ImplementationTraits>
 class DeviceContextBase : public ObjectBase<BaseInterface>
 {
 public:
-    using TObjectBase           = ObjectBase<BaseInterface>;
-    using DeviceImplType        = typename ImplementationTraits::DeviceType;
-    using BufferImplType        = typename ImplementationTraits::BufferType;
-    using TextureImplType       = typename ImplementationTraits::TextureType;
-    using PipelineStateImplType = typename ImplementationTraits::PipelineStateType;
-    using TextureViewImplType   = typename TextureImplType::ViewImplType;
-    using QueryImplType         = typename ImplementationTraits::QueryType;
-    using FramebufferImplType   = typename ImplementationTraits::FramebufferType;
-    using RenderPassImplType    = typename ImplementationTraits::RenderPassType;
-    using BottomLevelASType     = typename ImplementationTraits::BottomLevelASType;
-    using TopLevelASType        = typename ImplementationTraits::TopLevelASType;
+    using TObjectBase                   = ObjectBase<BaseInterface>;
+    using DeviceImplType                = typename ImplementationTraits::DeviceType;
+    using BufferImplType                = typename ImplementationTraits::BufferType;
+    using TextureImplType               = typename ImplementationTraits::TextureType;
+    using PipelineStateImplType         = typename ImplementationTraits::PipelineStateType;
+    using ShaderResourceBindingImplType = typename ImplementationTraits::ShaderResourceBindingType;
+    using TextureViewImplType           = typename TextureImplType::ViewImplType;
+    using QueryImplType                 = typename ImplementationTraits::QueryType;
+    using FramebufferImplType           = typename ImplementationTraits::FramebufferType;
+    using RenderPassImplType            = typename ImplementationTraits::RenderPassType;
+    using BottomLevelASType             = typename ImplementationTraits::BottomLevelASType;
+    using TopLevelASType                = typename ImplementationTraits::TopLevelASType;
 
     /// \param pRefCounters  - Reference counters object that controls the lifetime of this device context.
     /// \param pRenderDevice - Render device.
@@ -132,17 +138,21 @@ public:
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DeviceContext, TObjectBase)
 
     /// Base implementation of IDeviceContext::SetVertexBuffers(); validates parameters and
-    /// caches references to the buffers.
-    inline virtual void DILIGENT_CALL_TYPE SetVertexBuffers(Uint32                         StartSlot,
-                                                            Uint32                         NumBuffersSet,
-                                                            IBuffer**                      ppBuffers,
-                                                            Uint32*                        pOffsets,
-                                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
-                                                            SET_VERTEX_BUFFERS_FLAGS       Flags) override = 0;
+    /// caches references to the buffers. Returns false if the call does not change the
+    /// bound vertex buffers and should be ignored.
+    inline bool SetVertexBuffers(Uint32                         StartSlot,
+                                 Uint32                         NumBuffersSet,
+                                 IBuffer**                      ppBuffers,
+                                 Uint32*                        pOffsets,
+                                 RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                 SET_VERTEX_BUFFERS_FLAGS       Flags,
+                                 int                            Dummy);
 
     inline virtual void DILIGENT_CALL_TYPE InvalidateState() override = 0;
 
     /// Base implementation of IDeviceContext::CommitShaderResources(); validates parameters.
+    /// Returns false if the shader resource binding must not be committed, either because
+    /// the parameters are invalid or because the same binding is already committed.
     inline bool CommitShaderResources(IShaderResourceBinding*        pShaderResourceBinding,
                                       RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                       int);
@@ -152,11 +162,13 @@ public:
                                                           Uint32                         ByteOffset,
                                                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override = 0;
 
-    /// Caches the viewports
-    inline void SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32& RTWidth, Uint32& RTHeight);
+    /// Caches the viewports. Returns true if the viewports are different from the cached
+    /// values and false otherwise.
+    inline bool SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32& RTWidth, Uint32& RTHeight);
 
-    /// Caches the scissor rects
-    inline void SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32& RTWidth, Uint32& RTHeight);
+    /// Caches the scissor rects. Returns true if the rects are different from the cached
+    /// values and false otherwise.
+    inline bool SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32& RTWidth, Uint32& RTHeight);
 
     virtual void DILIGENT_CALL_TYPE BeginRenderPass(const BeginRenderPassAttribs& Attribs) override = 0;
 
@@ -226,6 +238,11 @@ public:
         return m_FrameNumber;
     }
 
+    virtual void DILIGENT_CALL_TYPE GetRedundantStateStats(RedundantStateStats& Stats) const override final
+    {
+        Stats = m_RedundantStateStats;
+    }
+
     /// Returns currently bound pipeline state and blend factors
     inline void GetPipelineState(IPipelineState** ppPSO, float* BlendFactors, Uint32& StencilRef);
 
@@ -263,6 +280,14 @@ protected:
     /// Clears all cached resources
     inline void ClearStateCache();
 
+    /// Forgets the last committed shader resource binding so that the next
+    /// CommitShaderResources() call is never filtered out. Backends must call this
+    /// method when they reset or modify the committed resource bindings.
+    void InvalidateCommittedShaderResources()
+    {
+        m_pCommittedSRB.Release();
+    }
+
     /// Checks if the texture is currently bound as a render target.
     bool CheckIfBoundAsRenderTarget(TextureImplType* pTexture);
 
@@ -294,6 +319,11 @@ protected:
     bool DvpVerifyDrawIndexedIndirectArguments(const DrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer) const;
     bool DvpVerifyDrawMeshIndirectArguments   (const DrawMeshIndirectAttribs&    Attribs, const IBuffer* pAttribsBuffer) const;
 
+    bool DvpVerifyMultiDrawArguments               (const MultiDrawAttribs&                Attribs) const;
+    bool DvpVerifyMultiDrawIndexedArguments        (const MultiDrawIndexedAttribs&         Attribs) const;
+    bool DvpVerifyMultiDrawIndirectArguments       (const MultiDrawIndirectAttribs&        Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuffer) const;
+    bool DvpVerifyMultiDrawIndexedIndirectArguments(const MultiDrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuffer) const;
+
     bool DvpVerifyDispatchArguments        (const DispatchComputeAttribs& Attribs) const;
     bool DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer) const;
 
@@ -311,6 +341,11 @@ protected:
     bool DvpVerifyDrawIndexedIndirectArguments(const DrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const {return true;}
     bool DvpVerifyDrawMeshIndirectArguments   (const DrawMeshIndirectAttribs&    Attribs, const IBuffer* pAttribsBuffer)const {return true;}
 
+    bool DvpVerifyMultiDrawArguments               (const MultiDrawAttribs&                Attribs)const {return true;}
+    bool DvpVerifyMultiDrawIndexedArguments        (const MultiDrawIndexedAttribs&         Attribs)const {return true;}
+    bool DvpVerifyMultiDrawIndirectArguments       (const MultiDrawIndirectAttribs&        Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuffer)const {return true;}
+    bool DvpVerifyMultiDrawIndexedIndirectArguments(const MultiDrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuffer)const {return true;}
+
     bool DvpVerifyDispatchArguments        (const DispatchComputeAttribs& Attribs)const {return true;}
     bool DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const {return true;}
 
@@ -369,6 +404,22 @@ protected:
     /// Number of current scissor rects
     Uint32 m_NumScissorRects = 0;
 
+    /// Render target size that was used to set the current viewports and scissor rects
+    Uint32 m_ViewportsRTWidth     = 0;
+    Uint32 m_ViewportsRTHeight    = 0;
+    Uint32 m_ScissorRectsRTWidth  = 0;
+    Uint32 m_ScissorRectsRTHeight = 0;
+
+    /// Strong reference to the last committed shader resource binding that may be
+    /// re-committed without any backend work, see CommitShaderResources().
+    RefCntAutoPtr<IShaderResourceBinding> m_pCommittedSRB;
+
+    /// Resources version of m_pCommittedSRB at the time it was committed
+    Uint32 m_CommittedSRBVersion = 0;
+
+    /// Redundant state change statistics
+    RedundantStateStats m_RedundantStateStats;
+
     /// Vector of strong references to the bound render targets.
     /// Use final texture view implementation type to avoid virtual calls to AddRef()/Release()
     RefCntAutoPtr<TextureViewImplType> m_pBoundRenderTargets[MAX_RENDER_TARGETS];
@@ -416,19 +467,20 @@ protected:
 
 
 template <typename BaseInterface, typename ImplementationTraits>
-inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetVertexBuffers(
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::SetVertexBuffers(
     Uint32                         StartSlot,
     Uint32                         NumBuffersSet,
     IBuffer**                      ppBuffers,
     Uint32*                        pOffsets,
     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
-    SET_VERTEX_BUFFERS_FLAGS       Flags)
+    SET_VERTEX_BUFFERS_FLAGS       Flags,
+    int)
 {
 #ifdef DILIGENT_DEVELOPMENT
     if (StartSlot >= MAX_BUFFER_SLOTS)
     {
         LOG_ERROR_MESSAGE("Start vertex buffer slot ", StartSlot, " is out of allowed range [0, ", MAX_BUFFER_SLOTS - 1, "].");
-        return;
+        return false;
     }
 
     if (StartSlot + NumBuffersSet > MAX_BUFFER_SLOTS)
@@ -442,6 +494,34 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetVertexBuf
            "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
 #endif
 
+    {
+        // Check if the call changes the bound vertex buffers. The slots that are not being set must
+        // be empty if the reset flag is specified. In transition mode, the buffers must also be
+        // in vertex buffer state as otherwise the backend has to transition them.
+        bool IsRedundant = true;
+        if (Flags & SET_VERTEX_BUFFERS_FLAG_RESET)
+        {
+            for (Uint32 s = 0; s < StartSlot && IsRedundant; ++s)
+                IsRedundant = m_VertexStreams[s].pBuffer == nullptr;
+            IsRedundant = IsRedundant && m_NumVertexStreams <= StartSlot + NumBuffersSet;
+        }
+        for (Uint32 Buff = 0; Buff < NumBuffersSet && IsRedundant; ++Buff)
+        {
+            const auto& CurrStream = m_VertexStreams[StartSlot + Buff];
+            auto*       pBuffer    = ppBuffers ? ppBuffers[Buff] : nullptr;
+            IsRedundant =
+                CurrStream.pBuffer.RawPtr() == pBuffer &&
+                CurrStream.Offset == (pOffsets ? pOffsets[Buff] : 0) &&
+                (StateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION || pBuffer == nullptr ||
+                 (CurrStream.pBuffer->IsInKnownState() && CurrStream.pBuffer->CheckState(RESOURCE_STATE_VERTEX_BUFFER)));
+        }
+        if (IsRedundant)
+        {
+            ++m_RedundantStateStats.NumVertexBuffersCalls;
+            return false;
+        }
+    }
+
     if (Flags & SET_VERTEX_BUFFERS_FLAG_RESET)
     {
         // Reset only these buffer slots that are not being set.
@@ -474,6 +554,8 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetVertexBuf
     // Remove null buffers from the end of the array
     while (m_NumVertexStreams > 0 && !m_VertexStreams[m_NumVertexStreams - 1].pBuffer)
         m_VertexStreams[m_NumVertexStreams--] = VertexStreamInfo<BufferImplType>{};
+
+    return true;
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
@@ -481,6 +563,8 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetPipelineS
     PipelineStateImplType* pPipelineState,
     int /*Dummy*/)
 {
+    if (m_pPipelineState.RawPtr() != pPipelineState)
+        InvalidateCommittedShaderResources();
     m_pPipelineState = pPipelineState;
 }
 
@@ -511,6 +595,35 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::CommitShader
     }
 #endif
 
+    // Resources do not need to be re-committed if the same binding has been committed with the
+    // same pipeline and none of its resources have been modified since then. The binding is only
+    // remembered when it has no dynamic variables that may change between the commits and transition
+    // mode is not used as resource states may change.
+    if (StateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION && pShaderResourceBinding != nullptr)
+    {
+        const auto* pSRBImpl = ValidatedCast<ShaderResourceBindingImplType>(pShaderResourceBinding);
+        const auto  Version  = pSRBImpl->GetResourcesVersion();
+        if (m_pCommittedSRB.RawPtr() == pShaderResourceBinding && m_CommittedSRBVersion == Version && m_pPipelineState)
+        {
+            ++m_RedundantStateStats.NumCommitShaderResourcesCalls;
+            return false;
+        }
+
+        if (!pSRBImpl->HasDynamicVariables())
+        {
+            m_pCommittedSRB       = pShaderResourceBinding;
+            m_CommittedSRBVersion = Version;
+        }
+        else
+        {
+            m_pCommittedSRB.Release();
+        }
+    }
+    else
+    {
+        m_pCommittedSRB.Release();
+    }
+
     return true;
 }
 
@@ -577,6 +690,8 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::SetBlendFact
             FactorsDiffer = true;
         m_BlendFactors[f] = BlendFactors[f];
     }
+    if (!FactorsDiffer)
+        ++m_RedundantStateStats.NumBlendFactorsCalls;
     return FactorsDiffer;
 }
 
@@ -588,11 +703,12 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::SetStencilRe
         m_StencilRef = StencilRef;
         return true;
     }
+    ++m_RedundantStateStats.NumStencilRefCalls;
     return false;
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
-inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetViewports(
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::SetViewports(
     Uint32          NumViewports,
     const Viewport* pViewports,
     Uint32&         RTWidth,
@@ -605,15 +721,41 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetViewports
     }
 
     DEV_CHECK_ERR(NumViewports < MAX_VIEWPORTS, "Number of viewports (", NumViewports, ") exceeds the limit (", MAX_VIEWPORTS, ")");
-    m_NumViewports = std::min(MAX_VIEWPORTS, NumViewports);
+    NumViewports = std::min(MAX_VIEWPORTS, NumViewports);
 
     Viewport DefaultVP(0, 0, static_cast<float>(RTWidth), static_cast<float>(RTHeight));
     // If no viewports are specified, use default viewport
-    if (m_NumViewports == 1 && pViewports == nullptr)
+    if (NumViewports == 1 && pViewports == nullptr)
     {
         pViewports = &DefaultVP;
     }
 
+    // Viewports in OpenGL are set relative to the render target height, so
+    // the render target size must be the same for the call to be redundant
+    bool ViewportsDiffer = NumViewports != m_NumViewports || RTWidth != m_ViewportsRTWidth || RTHeight != m_ViewportsRTHeight;
+    for (Uint32 vp = 0; vp < NumViewports && !ViewportsDiffer; ++vp)
+    {
+        const auto& NewVP = pViewports[vp];
+        const auto& OldVP = m_Viewports[vp];
+        // clang-format off
+        ViewportsDiffer =
+            NewVP.TopLeftX != OldVP.TopLeftX ||
+            NewVP.TopLeftY != OldVP.TopLeftY ||
+            NewVP.Width    != OldVP.Width    ||
+            NewVP.Height   != OldVP.Height   ||
+            NewVP.MinDepth != OldVP.MinDepth ||
+            NewVP.MaxDepth != OldVP.MaxDepth;
+        // clang-format on
+    }
+    if (!ViewportsDiffer)
+    {
+        ++m_RedundantStateStats.NumViewportsCalls;
+        return false;
+    }
+
+    m_NumViewports      = NumViewports;
+    m_ViewportsRTWidth  = RTWidth;
+    m_ViewportsRTHeight = RTHeight;
     for (Uint32 vp = 0; vp < m_NumViewports; ++vp)
     {
         m_Viewports[vp] = pViewports[vp];
@@ -621,6 +763,8 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetViewports
         DEV_CHECK_ERR(m_Viewports[vp].Height >= 0, "Incorrect viewport height (", m_Viewports[vp].Height, ")");
         DEV_CHECK_ERR(m_Viewports[vp].MaxDepth >= m_Viewports[vp].MinDepth, "Incorrect viewport depth range [", m_Viewports[vp].MinDepth, ", ", m_Viewports[vp].MaxDepth, "]");
     }
+
+    return true;
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
@@ -635,7 +779,7 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::GetViewports
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
-inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetScissorRects(
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::SetScissorRects(
     Uint32      NumRects,
     const Rect* pRects,
     Uint32&     RTWidth,
@@ -648,14 +792,38 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetScissorRe
     }
 
     DEV_CHECK_ERR(NumRects < MAX_VIEWPORTS, "Number of scissor rects (", NumRects, ") exceeds the limit (", MAX_VIEWPORTS, ")");
-    m_NumScissorRects = std::min(MAX_VIEWPORTS, NumRects);
+    NumRects = std::min(MAX_VIEWPORTS, NumRects);
 
+    bool RectsDiffer = NumRects != m_NumScissorRects || RTWidth != m_ScissorRectsRTWidth || RTHeight != m_ScissorRectsRTHeight;
+    for (Uint32 sr = 0; sr < NumRects && !RectsDiffer; ++sr)
+    {
+        const auto& NewRect = pRects[sr];
+        const auto& OldRect = m_ScissorRects[sr];
+        // clang-format off
+        RectsDiffer =
+            NewRect.left   != OldRect.left  ||
+            NewRect.top    != OldRect.top   ||
+            NewRect.right  != OldRect.right ||
+            NewRect.bottom != OldRect.bottom;
+        // clang-format on
+    }
+    if (!RectsDiffer)
+    {
+        ++m_RedundantStateStats.NumScissorRectsCalls;
+        return false;
+    }
+
+    m_NumScissorRects      = NumRects;
+    m_ScissorRectsRTWidth  = RTWidth;
+    m_ScissorRectsRTHeight = RTHeight;
     for (Uint32 sr = 0; sr < m_NumScissorRects; ++sr)
     {
         m_ScissorRects[sr] = pRects[sr];
         DEV_CHECK_ERR(m_ScissorRects[sr].left <= m_ScissorRects[sr].right, "Incorrect horizontal bounds for a scissor rect [", m_ScissorRects[sr].left, ", ", m_ScissorRects[sr].right, ")");
         DEV_CHECK_ERR(m_ScissorRects[sr].top <= m_ScissorRects[sr].bottom, "Incorrect vertical bounds for a scissor rect [", m_ScissorRects[sr].top, ", ", m_ScissorRects[sr].bottom, ")");
     }
+
+    return true;
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
@@ -888,6 +1056,7 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::ClearStateCa
     m_NumVertexStreams = 0;
 
     m_pPipelineState.Release();
+    m_pCommittedSRB.Release();
 
     m_pIndexBuffer.Release();
     m_IndexDataStartOffset = 0;
@@ -899,11 +1068,15 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::ClearStateCa
 
     for (Uint32 vp = 0; vp < m_NumViewports; ++vp)
         m_Viewports[vp] = Viewport();
-    m_NumViewports = 0;
+    m_NumViewports      = 0;
+    m_ViewportsRTWidth  = 0;
+    m_ViewportsRTHeight = 0;
 
     for (Uint32 sr = 0; sr < m_NumScissorRects; ++sr)
         m_ScissorRects[sr] = Rect();
-    m_NumScissorRects = 0;
+    m_NumScissorRects      = 0;
+    m_ScissorRectsRTWidth  = 0;
+    m_ScissorRectsRTHeight = 0;
 
     ResetRenderTargets();
 
@@ -1855,6 +2028,142 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyDra
     return VerifyDrawMeshIndirectAttribs(Attribs, pAttribsBuffer);
 }
 
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyMultiDrawArguments(const MultiDrawAttribs& Attribs) const
+{
+    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return true;
+
+    if (!m_pPipelineState)
+    {
+        LOG_ERROR_MESSAGE("MultiDraw command arguments are invalid: no pipeline state is bound.");
+        return false;
+    }
+
+    if (m_pPipelineState->GetDesc().PipelineType != PIPELINE_TYPE_GRAPHICS)
+    {
+        LOG_ERROR_MESSAGE("MultiDraw command arguments are invalid: pipeline state '",
+                          m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline.");
+        return false;
+    }
+
+    return VerifyMultiDrawAttribs(Attribs);
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyMultiDrawIndexedArguments(const MultiDrawIndexedAttribs& Attribs) const
+{
+    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return true;
+
+    if (!m_pPipelineState)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexed command arguments are invalid: no pipeline state is bound.");
+        return false;
+    }
+
+    if (m_pPipelineState->GetDesc().PipelineType != PIPELINE_TYPE_GRAPHICS)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexed command arguments are invalid: pipeline state '",
+                          m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline.");
+        return false;
+    }
+
+    if (!m_pIndexBuffer)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexed command arguments are invalid: no index buffer is bound.");
+        return false;
+    }
+
+    return VerifyMultiDrawIndexedAttribs(Attribs);
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyMultiDrawIndirectArguments(
+    const MultiDrawIndirectAttribs& Attribs,
+    const IBuffer*                  pAttribsBuffer,
+    const IBuffer*                  pCountBuffer) const
+{
+    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return true;
+
+    if (!m_pPipelineState)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndirect command arguments are invalid: no pipeline state is bound.");
+        return false;
+    }
+
+    if (m_pPipelineState->GetDesc().PipelineType != PIPELINE_TYPE_GRAPHICS)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndirect command arguments are invalid: pipeline state '",
+                          m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline.");
+        return false;
+    }
+
+    if (pCountBuffer != nullptr && m_pDevice->GetDeviceCaps().Features.DrawIndirectCount != DEVICE_FEATURE_STATE_ENABLED)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndirect: count buffer can't be used because DrawIndirectCount feature is not enabled.");
+        return false;
+    }
+
+    if (m_pActiveRenderPass != nullptr &&
+        (Attribs.IndirectAttribsBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION ||
+         (pCountBuffer != nullptr && Attribs.CountBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)))
+    {
+        LOG_ERROR_MESSAGE("Resource state transitons are not allowed inside a render pass and may result in an undefined behavior. "
+                          "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
+        return false;
+    }
+
+    return VerifyMultiDrawIndirectAttribs(Attribs, pAttribsBuffer, pCountBuffer);
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyMultiDrawIndexedIndirectArguments(
+    const MultiDrawIndexedIndirectAttribs& Attribs,
+    const IBuffer*                         pAttribsBuffer,
+    const IBuffer*                         pCountBuffer) const
+{
+    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return true;
+
+    if (!m_pPipelineState)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexedIndirect command arguments are invalid: no pipeline state is bound.");
+        return false;
+    }
+
+    if (m_pPipelineState->GetDesc().PipelineType != PIPELINE_TYPE_GRAPHICS)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexedIndirect command arguments are invalid: pipeline state '",
+                          m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline.");
+        return false;
+    }
+
+    if (!m_pIndexBuffer)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexedIndirect command arguments are invalid: no index buffer is bound.");
+        return false;
+    }
+
+    if (pCountBuffer != nullptr && m_pDevice->GetDeviceCaps().Features.DrawIndirectCount != DEVICE_FEATURE_STATE_ENABLED)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexedIndirect: count buffer can't be used because DrawIndirectCount feature is not enabled.");
+        return false;
+    }
+
+    if (m_pActiveRenderPass != nullptr &&
+        (Attribs.IndirectAttribsBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION ||
+         (pCountBuffer != nullptr && Attribs.CountBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)))
+    {
+        LOG_ERROR_MESSAGE("Resource state transitons are not allowed inside a render pass and may result in an undefined behavior. "
+                          "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
+        return false;
+    }
+
+    return VerifyMultiDrawIndexedIndirectAttribs(Attribs, pAttribsBuffer, pCountBuffer);
+}
+
 template <typename BaseInterface, typename ImplementationTraits>
 inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyRenderTargets() const
 {
@@ -31,6 +31,10 @@
 /// Implementation of the Diligent::PipelineStateBase template class
 
 #include <array>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <cstring>
@@ -42,6 +46,9 @@
 #include "GraphicsAccessories.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "HashUtils.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "PipelineStateCreateInfoCopy.hpp"
+#include "ShaderResourceBindingPool.hpp"
 
 namespace Diligent
 {
@@ -87,6 +94,9 @@ private:
                       "No bits in the command queue mask (0x", std::hex, this->m_Desc.CommandQueueMask,
                       ") correspond to one of ", pDevice->GetCommandQueueCount(), " available device command queues.");
         this->m_Desc.CommandQueueMask &= DeviceQueuesMask;
+
+        if (this->m_Desc.SRBPoolSize > 0)
+            m_pSRBPool = std::make_shared<ShaderResourceBindingPool>(this->m_Desc.SRBPoolSize);
     }
 
 public:
@@ -103,9 +113,11 @@ public:
                       bool                                   bIsDeviceInternal = false) :
         PipelineStateBase{pRefCounters, pDevice, GraphicsPipelineCI.PSODesc, bIsDeviceInternal}
     {
+        m_IsShared = (GraphicsPipelineCI.Flags & PSO_CREATE_FLAG_SHARED) != 0;
         try
         {
             ValidateGraphicsPipelineCreateInfo(GraphicsPipelineCI);
+            InitBindlessTable(GraphicsPipelineCI);
         }
         catch (...)
         {
@@ -127,9 +139,11 @@ public:
                       bool                                  bIsDeviceInternal = false) :
         PipelineStateBase{pRefCounters, pDevice, ComputePipelineCI.PSODesc, bIsDeviceInternal}
     {
+        m_IsShared = (ComputePipelineCI.Flags & PSO_CREATE_FLAG_SHARED) != 0;
         try
         {
             ValidateComputePipelineCreateInfo(ComputePipelineCI);
+            InitBindlessTable(ComputePipelineCI);
         }
         catch (...)
         {
@@ -154,6 +168,7 @@ public:
         try
         {
             ValidateRayTracingPipelineCreateInfo(pDevice, pDevice->GetProperties().MaxRayTracingRecursionDepth, RayTracingPipelineCI);
+            InitBindlessTable(RayTracingPipelineCI);
         }
         catch (...)
         {
@@ -165,23 +180,19 @@ public:
 
     ~PipelineStateBase()
     {
-        /*
-        /// \note Destructor cannot directly remove the object from the registry as this may cause a  
+        /// \note Destructor cannot directly remove the object from the registry as this may cause a
         ///       deadlock at the point where StateObjectsRegistry::Find() locks the weak pointer: if we
-        ///       are in dtor, the object is locked by Diligent::RefCountedObject::Release() and 
+        ///       are in dtor, the object is locked by Diligent::RefCountedObject::Release() and
         ///       StateObjectsRegistry::Find() will wait for that lock to be released.
         ///       A the same time this thread will be waiting for the other thread to unlock the registry.\n
         ///       Thus destructor only notifies the registry that there is a deleted object.
         ///       The reference to the object will be removed later.
-        auto &PipelineStateRegistry = static_cast<TRenderDeviceBase*>(this->GetDevice())->GetBSRegistry();
-        auto &RasterizerStateRegistry = static_cast<TRenderDeviceBase*>(this->GetDevice())->GetRSRegistry();
-        auto &DSSRegistry = static_cast<TRenderDeviceBase*>(this->GetDevice())->GetDSSRegistry();
-        // StateObjectsRegistry::ReportDeletedObject() does not lock the registry, but only 
-        // atomically increments the outstanding deleted objects counter.
-        PipelineStateRegistry.ReportDeletedObject();
-        RasterizerStateRegistry.ReportDeletedObject();
-        DSSRegistry.ReportDeletedObject();
-        */
+        if (m_IsShared)
+        {
+            // StateObjectsRegistry::ReportDeletedObject() does not lock the registry, but only
+            // atomically increments the outstanding deleted objects counter.
+            this->GetDevice()->GetPipelineStateRegistry().ReportDeletedObject();
+        }
         VERIFY(m_IsDestructed, "This object must be explicitly destructed with Destruct()");
     }
 
@@ -189,6 +200,11 @@ public:
     {
         VERIFY(!m_IsDestructed, "This object has already been destructed");
 
+        // Pooled SRBs do not reference the pipeline, so they must be destroyed
+        // while the pipeline is still fully functional.
+        if (m_pSRBPool)
+            m_pSRBPool->Clear();
+
         if (this->m_Desc.IsAnyGraphicsPipeline() && m_pGraphicsPipelineDesc != nullptr)
         {
             m_pGraphicsPipelineDesc->~GraphicsPipelineDesc();
@@ -206,6 +222,20 @@ public:
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_PipelineState, TDeviceObjectBase)
 
+    bool HasSRBPool() const
+    {
+        return m_pSRBPool != nullptr;
+    }
+
+    /// Returns the shader resource binding to the pool. Called by ShaderResourceBindingBase::Release()
+    /// after the last reference to the SRB has been released and its resources have been reset.
+    /// Backends where the SRB may still be used by the GPU hide this method to defer the recycling.
+    void RecycleShaderResourceBinding(IShaderResourceBinding* pSRB)
+    {
+        VERIFY_EXPR(m_pSRBPool);
+        m_pSRBPool->Add(pSRB);
+    }
+
     Uint32 GetBufferStride(Uint32 BufferSlot) const
     {
         return BufferSlot < m_BufferSlotsUsed ? m_pStrides[BufferSlot] : 0;
@@ -226,9 +256,97 @@ public:
         return m_ShaderResourceLayoutHash != ValidatedCast<const PipelineStateBase>(pPSO)->m_ShaderResourceLayoutHash;
     }
 
+    /// Implementation of IPipelineState::GetStatus().
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus(bool WaitForCompletion) override final
+    {
+        if (WaitForCompletion)
+            WaitForAsyncInitialization();
+        return m_Status.load();
+    }
+
+    bool IsReady() const
+    {
+        return m_Status.load() == PIPELINE_STATE_STATUS_READY;
+    }
+
+    /// Waits until asynchronous initialization of the pipeline is finished.
+    /// Does nothing if the pipeline was created synchronously.
+    void WaitForAsyncInitialization() const
+    {
+        if (m_Status.load() == PIPELINE_STATE_STATUS_COMPILING)
+        {
+            VERIFY(m_AsyncInitCompletion.valid(), "Asynchronous initialization of pipeline '", this->m_Desc.Name, "' has not been started");
+            m_AsyncInitCompletion.wait();
+        }
+    }
+
+    /// Starts the initialization deferred by DeferInitialization() on the device's worker threads.
+    /// The render device calls this method once the object has been created and referenced.
+    void StartDeferredInitialization()
+    {
+        if (!m_DeferredInitializer)
+            return;
+
+        auto pCompletion      = std::make_shared<std::promise<void>>();
+        m_AsyncInitCompletion = pCompletion->get_future().share();
+
+        // The task keeps the object alive until the initialization is complete
+        RefCntAutoPtr<IPipelineState> pThis{this};
+        auto                          Initializer = std::move(m_DeferredInitializer);
+        m_DeferredInitializer                     = nullptr;
+
+        this->m_pDevice->GetPipelineCompilationPool().EnqueueTask(
+            [this, pThis, Initializer, pCompletion]() //
+            {
+                try
+                {
+                    Initializer();
+                    m_Status.store(PIPELINE_STATE_STATUS_READY);
+                }
+                catch (...)
+                {
+                    LOG_ERROR_MESSAGE("Failed to asynchronously create pipeline state '", this->m_Desc.Name, "'");
+                    m_Status.store(PIPELINE_STATE_STATUS_FAILED);
+                }
+                pCompletion->set_value();
+            });
+    }
+
+    /// Returns the bindless resource table the pipeline was created with, or null.
+    const IBindlessResourceTable* GetBindlessTable() const
+    {
+        return m_pBindlessTable;
+    }
+
+    /// Returns the pipeline state that a device context binds when this pipeline is set:
+    /// the pipeline itself if it is ready, or the fallback pipeline while this one is being compiled.
+    /// If there is no fallback or it is not ready either, the method waits for the compilation to finish.
+    /// Returns null if the pipeline failed to compile.
+    IPipelineState* GetPipelineStateToBind()
+    {
+        auto Status = m_Status.load();
+        if (Status == PIPELINE_STATE_STATUS_COMPILING)
+        {
+            if (m_pAsyncFallbackPSO && m_pAsyncFallbackPSO->GetStatus() == PIPELINE_STATE_STATUS_READY)
+                return m_pAsyncFallbackPSO;
+
+            WaitForAsyncInitialization();
+            Status = m_Status.load();
+        }
+
+        if (Status == PIPELINE_STATE_STATUS_FAILED)
+        {
+            LOG_ERROR_MESSAGE("Pipeline state '", this->m_Desc.Name, "' failed to compile and can't be bound");
+            return nullptr;
+        }
+
+        return this;
+    }
+
     virtual const GraphicsPipelineDesc& DILIGENT_CALL_TYPE GetGraphicsPipelineDesc() const override final
     {
         VERIFY_EXPR(this->m_Desc.IsAnyGraphicsPipeline());
+        WaitForAsyncInitialization();
         VERIFY_EXPR(m_pGraphicsPipelineDesc != nullptr);
         return *m_pGraphicsPipelineDesc;
     }
@@ -268,6 +386,65 @@ public:
 protected:
     using TNameToGroupIndexMap = std::unordered_map<HashMapStringKey, Uint32, HashMapStringKey::Hasher>;
 
+    /// Takes a recycled shader resource binding from the pool, or returns null if the pool is empty.
+    /// The caller receives the reference that was held by the pool.
+    template <typename SRBImplType>
+    SRBImplType* TakeSRBFromPool()
+    {
+        if (!m_pSRBPool)
+            return nullptr;
+
+        auto* pSRB = m_pSRBPool->Take();
+        if (pSRB == nullptr)
+            return nullptr;
+
+        auto* pSRBImpl = ValidatedCast<SRBImplType>(pSRB);
+        pSRBImpl->AttachToPipeline();
+        return pSRBImpl;
+    }
+
+    /// If PSO_CREATE_FLAG_ASYNCHRONOUS is set, saves a deep copy of the create info together with the
+    /// initializer that StartDeferredInitialization() will run on the device's worker threads, and returns true.
+    /// Otherwise returns false, and the caller is expected to initialize the pipeline immediately.
+    template <typename PSOCreateInfoType, typename InitializerType>
+    bool DeferInitialization(const PSOCreateInfoType& CreateInfo, InitializerType Initializer)
+    {
+        if ((CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) == 0)
+            return false;
+
+        if (CreateInfo.pAsyncFallbackPSO != nullptr)
+        {
+            DEV_CHECK_ERR(CreateInfo.pAsyncFallbackPSO->GetDesc().PipelineType == CreateInfo.PSODesc.PipelineType,
+                          "The type of the fallback pipeline '", CreateInfo.pAsyncFallbackPSO->GetDesc().Name,
+                          "' does not match the type of pipeline '", this->m_Desc.Name, "'");
+            m_pAsyncFallbackPSO = CreateInfo.pAsyncFallbackPSO;
+        }
+
+        auto pCreateInfoCopy  = std::make_shared<PipelineStateCreateInfoCopy<PSOCreateInfoType>>(CreateInfo);
+        m_DeferredInitializer = [pCreateInfoCopy, Initializer]() //
+        {
+            Initializer(pCreateInfoCopy->Get());
+        };
+        m_Status.store(PIPELINE_STATE_STATUS_COMPILING);
+        return true;
+    }
+
+    void InitBindlessTable(const PipelineStateCreateInfo& CreateInfo)
+    {
+        if (CreateInfo.pBindlessTable == nullptr)
+            return;
+
+        if (this->GetDevice()->GetDeviceCaps().Features.BindlessResources != DEVICE_FEATURE_STATE_ENABLED)
+            LOG_ERROR_AND_THROW("Pipeline state '", this->m_Desc.Name, "' uses a bindless resource table, but BindlessResources device feature is not enabled.");
+
+        DEV_CHECK_ERR((this->m_Desc.CommandQueueMask & ~CreateInfo.pBindlessTable->GetDesc().CommandQueueMask) == 0,
+                      "Command queue mask (0x", std::hex, this->m_Desc.CommandQueueMask, ") of pipeline state '", this->m_Desc.Name,
+                      "' includes queues that bindless resource table '", CreateInfo.pBindlessTable->GetDesc().Name, "' can't be used with (0x",
+                      CreateInfo.pBindlessTable->GetDesc().CommandQueueMask, ").");
+
+        m_pBindlessTable = CreateInfo.pBindlessTable;
+    }
+
     Int8 GetStaticVariableCountHelper(SHADER_TYPE ShaderType, const std::array<Int8, MAX_SHADERS_IN_PIPELINE>& ResourceLayoutIndex) const
     {
         if (!IsConsistentShaderType(ShaderType, this->m_Desc.PipelineType))
@@ -776,6 +953,27 @@ protected:
         RayTracingPipelineData* m_pRayTracingPipelineData;
     };
 
+    std::atomic<PIPELINE_STATE_STATUS> m_Status{PIPELINE_STATE_STATUS_READY};
+
+    /// Pipeline that device contexts bind while this pipeline is being compiled asynchronously
+    RefCntAutoPtr<IPipelineState> m_pAsyncFallbackPSO;
+
+    /// Bindless resource table that unbounded resource arrays in the pipeline shaders are bound to
+    RefCntAutoPtr<IBindlessResourceTable> m_pBindlessTable;
+
+    /// Initialization routine saved by DeferInitialization()
+    std::function<void()> m_DeferredInitializer;
+
+    /// Becomes ready when asynchronous initialization is finished
+    std::shared_future<void> m_AsyncInitCompletion;
+
+    /// Released shader resource bindings kept for reuse, see PipelineStateDesc::SRBPoolSize.
+    /// Shared with the stale objects in the release queue in D3D12 and Vulkan backends.
+    std::shared_ptr<ShaderResourceBindingPool> m_pSRBPool;
+
+    /// Whether the pipeline was created with PSO_CREATE_FLAG_SHARED
+    bool m_IsShared = false;
+
 #ifdef DILIGENT_DEBUG
     bool m_IsDestructed = false;
 #endif
@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the Diligent::PipelineStateCreateInfoCopy template class
+
+#include <deque>
+#include <vector>
+
+#include "PipelineState.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Deep copy of a graphics or compute pipeline state create info.
+
+/// The copy owns all strings and arrays the create info refers to and keeps strong references
+/// to the shaders, render pass, pipeline state cache and fallback pipeline, so that the pipeline
+/// can be initialized after the original create info has gone out of scope.
+template <typename PSOCreateInfoType>
+class PipelineStateCreateInfoCopy
+{
+public:
+    explicit PipelineStateCreateInfoCopy(const PSOCreateInfoType& CreateInfo) :
+        m_CreateInfo{CreateInfo}
+    {
+        CopyCommonAttribs();
+        CopyPipelineAttribs(m_CreateInfo);
+    }
+
+    // clang-format off
+    PipelineStateCreateInfoCopy           (const PipelineStateCreateInfoCopy&)  = delete;
+    PipelineStateCreateInfoCopy           (      PipelineStateCreateInfoCopy&&) = delete;
+    PipelineStateCreateInfoCopy& operator=(const PipelineStateCreateInfoCopy&)  = delete;
+    PipelineStateCreateInfoCopy& operator=(      PipelineStateCreateInfoCopy&&) = delete;
+    // clang-format on
+
+    const PSOCreateInfoType& Get() const { return m_CreateInfo; }
+
+private:
+    const char* CopyString(const char* Str)
+    {
+        if (Str == nullptr)
+            return nullptr;
+
+        // Deque never relocates its elements when new ones are added to the end
+        m_Strings.emplace_back(Str);
+        return m_Strings.back().c_str();
+    }
+
+    void KeepReference(IObject* pObject)
+    {
+        if (pObject != nullptr)
+            m_Objects.emplace_back(pObject);
+    }
+
+    void CopyCommonAttribs()
+    {
+        auto& PSODesc = m_CreateInfo.PSODesc;
+        PSODesc.Name  = CopyString(PSODesc.Name);
+
+        auto& ResourceLayout = PSODesc.ResourceLayout;
+        if (ResourceLayout.Variables != nullptr)
+        {
+            m_Variables.assign(ResourceLayout.Variables, ResourceLayout.Variables + ResourceLayout.NumVariables);
+            for (auto& Var : m_Variables)
+                Var.Name = CopyString(Var.Name);
+            ResourceLayout.Variables = m_Variables.data();
+        }
+
+        if (ResourceLayout.ImmutableSamplers != nullptr)
+        {
+            m_ImmutableSamplers.assign(ResourceLayout.ImmutableSamplers, ResourceLayout.ImmutableSamplers + ResourceLayout.NumImmutableSamplers);
+            for (auto& ImtblSam : m_ImmutableSamplers)
+                ImtblSam.SamplerOrTextureName = CopyString(ImtblSam.SamplerOrTextureName);
+            ResourceLayout.ImmutableSamplers = m_ImmutableSamplers.data();
+        }
+
+        KeepReference(m_CreateInfo.pPSOCache);
+        KeepReference(m_CreateInfo.pAsyncFallbackPSO);
+        KeepReference(m_CreateInfo.pBindlessTable);
+    }
+
+    void CopyPipelineAttribs(GraphicsPipelineStateCreateInfo& CreateInfo)
+    {
+        auto& InputLayout = CreateInfo.GraphicsPipeline.InputLayout;
+        if (InputLayout.LayoutElements != nullptr)
+        {
+            m_LayoutElements.assign(InputLayout.LayoutElements, InputLayout.LayoutElements + InputLayout.NumElements);
+            for (auto& Elem : m_LayoutElements)
+                Elem.HLSLSemantic = CopyString(Elem.HLSLSemantic);
+            InputLayout.LayoutElements = m_LayoutElements.data();
+        }
+
+        KeepReference(CreateInfo.GraphicsPipeline.pRenderPass);
+
+        KeepReference(CreateInfo.pVS);
+        KeepReference(CreateInfo.pPS);
+        KeepReference(CreateInfo.pDS);
+        KeepReference(CreateInfo.pHS);
+        KeepReference(CreateInfo.pGS);
+        KeepReference(CreateInfo.pAS);
+        KeepReference(CreateInfo.pMS);
+    }
+
+    void CopyPipelineAttribs(ComputePipelineStateCreateInfo& CreateInfo)
+    {
+        KeepReference(CreateInfo.pCS);
+    }
+
+    PSOCreateInfoType m_CreateInfo;
+
+    std::deque<String>                      m_Strings;
+    std::vector<ShaderResourceVariableDesc> m_Variables;
+    std::vector<ImmutableSamplerDesc>       m_ImmutableSamplers;
+    std::vector<LayoutElement>              m_LayoutElements;
+    std::vector<RefCntAutoPtr<IObject>>     m_Objects;
+};
+
+} // namespace Diligent
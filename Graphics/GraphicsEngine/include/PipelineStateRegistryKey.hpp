@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PipelineStateRegistryKey class
+
+#include <memory>
+#include <vector>
+
+#include "PipelineState.h"
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Key of the pipeline state registry (see Diligent::PSO_CREATE_FLAG_SHARED).
+
+/// The key is a flat binary representation of all pipeline create info members that
+/// affect the pipeline. Shaders are represented by their types and byte code identities
+/// (see ShaderBase::GetBytecodeId()), render passes by their addresses.
+class PipelineStateRegistryKey
+{
+public:
+    /// Shader byte code identity and its hash
+    struct ShaderBytecodeId
+    {
+        size_t                                    Hash = 0;
+        std::shared_ptr<const std::vector<Uint8>> pData;
+    };
+
+    /// Function that returns the byte code identity of the shader
+    using ShaderBytecodeIdFuncType = ShaderBytecodeId (*)(IShader* pShader);
+
+    PipelineStateRegistryKey() noexcept {}
+
+    PipelineStateRegistryKey(const GraphicsPipelineStateCreateInfo& CreateInfo, ShaderBytecodeIdFuncType GetShaderBytecodeId);
+    PipelineStateRegistryKey(const ComputePipelineStateCreateInfo& CreateInfo, ShaderBytecodeIdFuncType GetShaderBytecodeId);
+
+    bool operator==(const PipelineStateRegistryKey& rhs) const;
+
+    size_t GetHash() const { return m_Hash; }
+
+    bool IsEmpty() const { return m_Data.empty(); }
+
+    /// Sets the name that StateObjectsRegistry uses in diagnostic messages.
+    /// The key keeps a copy of the string as it may outlive the pipeline.
+    void SetName(const Char* PSOName);
+
+    /// Pipeline name, the member is required by StateObjectsRegistry
+    const Char* Name = nullptr;
+
+private:
+    template <typename T>
+    void Write(const T& Val);
+
+    void WriteString(const Char* Str);
+    void WriteShader(IShader* pShader, ShaderBytecodeIdFuncType GetShaderBytecodeId);
+    void WritePipelineDesc(const PipelineStateDesc& Desc);
+    void WriteGraphicsPipelineDesc(const GraphicsPipelineDesc& Desc);
+    void WriteAsyncState(const PipelineStateCreateInfo& CreateInfo);
+
+    void ComputeHash();
+
+    std::vector<Uint8> m_Data;
+    size_t             m_Hash = 0;
+
+    // Byte code of every shader. The data only contains the hashes, so the byte code
+    // is compared as well to make sure that a hash collision never returns a wrong pipeline.
+    std::vector<std::shared_ptr<const std::vector<Uint8>>> m_ShaderBytecodes;
+
+    std::shared_ptr<const String> m_pName;
+};
+
+} // namespace Diligent
+
+namespace std
+{
+
+template <>
+struct hash<Diligent::PipelineStateRegistryKey>
+{
+    size_t operator()(const Diligent::PipelineStateRegistryKey& Key) const
+    {
+        return Key.GetHash();
+    }
+};
+
+} // namespace std
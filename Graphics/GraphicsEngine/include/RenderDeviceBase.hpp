@@ -35,6 +35,7 @@
 #include "Defines.h"
 #include "ResourceMappingImpl.hpp"
 #include "StateObjectsRegistry.hpp"
+#include "PipelineStateRegistryKey.hpp"
 #include "HashUtils.hpp"
 #include "ObjectBase.hpp"
 #include "DeviceContext.h"
@@ -43,6 +44,16 @@
 #include "FixedBlockMemoryAllocator.hpp"
 #include "EngineMemory.h"
 #include "STDAllocator.hpp"
+#include "ThreadPool.hpp"
+#include "ValidatedCast.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace std
 {
@@ -235,6 +246,12 @@ public:
 
         /// Size of the SBT object (ShaderBindingTableD3D12Impl, ShaderBindingtableVkImpl, etc.), in bytes
         const size_t SBTObjSize;
+
+        /// Size of the pipeline state cache object (PipelineStateCacheVkImpl), in bytes
+        const size_t PSOCacheObjSize;
+
+        /// Size of the bindless resource table object (BindlessResourceTableVkImpl, etc.), in bytes
+        const size_t BindlessTableObjSize;
     };
 
     /// \param pRefCounters        - Reference counters object that controls the lifetime of this render device
@@ -254,6 +271,7 @@ public:
         TObjectBase             {pRefCounters},
         m_pEngineFactory        {pEngineFactory},
         m_SamplersRegistry      {RawMemAllocator, "sampler"},
+        m_PSORegistry           {RawMemAllocator, "pipeline state"},
         m_TextureFormatsInfo    (TEX_FORMAT_NUM_FORMATS, TextureFormatInfoExt(), STD_ALLOCATOR_RAW_MEM(TextureFormatInfoExt, RawMemAllocator, "Allocator for vector<TextureFormatInfoExt>")),
         m_TexFmtInfoInitFlags   (TEX_FORMAT_NUM_FORMATS, false, STD_ALLOCATOR_RAW_MEM(bool, RawMemAllocator, "Allocator for vector<bool>")),
         m_wpDeferredContexts    (NumDeferredContexts, RefCntWeakPtr<IDeviceContext>(), STD_ALLOCATOR_RAW_MEM(RefCntWeakPtr<IDeviceContext>, RawMemAllocator, "Allocator for vector< RefCntWeakPtr<IDeviceContext> >")),
@@ -274,6 +292,8 @@ public:
         m_BLASAllocator         {RawMemAllocator, ObjectSizes.BLASObjSize,        16  },
         m_TLASAllocator         {RawMemAllocator, ObjectSizes.TLASObjSize,        16  },
         m_SBTAllocator          {RawMemAllocator, ObjectSizes.SBTObjSize,         16  },
+        m_PSOCacheAllocator     {RawMemAllocator, ObjectSizes.PSOCacheObjSize,    16  },
+        m_BindlessTableAllocator{RawMemAllocator, ObjectSizes.BindlessTableObjSize, 16 },
         m_DeviceProperties      {}
     // clang-format on
     {
@@ -342,6 +362,9 @@ public:
     /// Implementation of IRenderDevice::CreateResourceMapping().
     virtual void DILIGENT_CALL_TYPE CreateResourceMapping(const ResourceMappingDesc& MappingDesc, IResourceMapping** ppMapping) override final;
 
+    /// Implementation of IRenderDevice::CreateShaders().
+    virtual void DILIGENT_CALL_TYPE CreateShaders(const ShaderCreateInfo* pShaderCIs, Uint32 NumShaders, IShader** ppShaders) override final;
+
     /// Implementation of IRenderDevice::GetDeviceCaps().
     virtual const DeviceCaps& DILIGENT_CALL_TYPE GetDeviceCaps() const override final
     {
@@ -389,6 +412,15 @@ public:
 
     StateObjectsRegistry<SamplerDesc>& GetSamplerRegistry() { return m_SamplersRegistry; }
 
+    StateObjectsRegistry<PipelineStateRegistryKey>& GetPipelineStateRegistry() { return m_PSORegistry; }
+
+    /// Implementation of IRenderDevice::GetPipelineStateRegistryStats().
+    virtual void DILIGENT_CALL_TYPE GetPipelineStateRegistryStats(PipelineStateRegistryStats& Stats) const override final
+    {
+        Stats.NumHits   = m_PSORegistryHits.load();
+        Stats.NumMisses = m_PSORegistryMisses.load();
+    }
+
     /// Set weak reference to the immediate context
     void SetImmediateContext(IDeviceContext* pImmediateContext)
     {
@@ -412,6 +444,18 @@ public:
     RefCntAutoPtr<IDeviceContext> GetImmediateContext() { return m_wpImmediateContext.Lock(); }
     RefCntAutoPtr<IDeviceContext> GetDeferredContext(size_t Ctx) { return m_wpDeferredContexts[Ctx].Lock(); }
 
+    /// Returns the pool of worker threads that initialize asynchronously created pipeline states
+    /// and create shaders in IRenderDevice::CreateShaders(). The pool is created on the first call.
+    ThreadingTools::ThreadPool& GetPipelineCompilationPool()
+    {
+        std::call_once(m_PipelineCompilationPoolFlag, [this]() {
+            const auto NumCores   = std::max(std::thread::hardware_concurrency(), 1u);
+            const auto NumThreads = std::max(NumCores - 1, 1u);
+            m_pPipelineCompilationPool.reset(new ThreadingTools::ThreadPool{NumThreads});
+        });
+        return *m_pPipelineCompilationPool;
+    }
+
     FixedBlockMemoryAllocator& GetTexViewObjAllocator() { return m_TexViewObjAllocator; }
     FixedBlockMemoryAllocator& GetBuffViewObjAllocator() { return m_BuffViewObjAllocator; }
     FixedBlockMemoryAllocator& GetSRBAllocator() { return m_SRBAllocator; }
@@ -423,6 +467,63 @@ protected:
     template <typename TObjectType, typename TObjectDescType, typename TObjectConstructor>
     void CreateDeviceObject(const Char* ObjectTypeName, const TObjectDescType& Desc, TObjectType** ppObject, TObjectConstructor ConstructObject);
 
+    /// Looks up the pipeline state registry if the pipeline is created with Diligent::PSO_CREATE_FLAG_SHARED.
+
+    /// \tparam ShaderImplType - Type of the shader implementation.
+    /// \param [in]  CreateInfo      - Pipeline state create info.
+    /// \param [out] Key             - Registry key. If the pipeline is shared, but is not found in the registry,
+    ///                                the key should be passed to AddSharedPipelineState() once the pipeline is created.
+    /// \param [out] ppPipelineState - Address of the memory location where the pointer to the
+    ///                                existing pipeline will be written.
+    /// \return true if an existing pipeline was found, and false otherwise.
+    template <typename ShaderImplType, typename PSOCreateInfoType>
+    bool FindSharedPipelineState(const PSOCreateInfoType& CreateInfo, PipelineStateRegistryKey& Key, IPipelineState** ppPipelineState)
+    {
+        if ((CreateInfo.Flags & PSO_CREATE_FLAG_SHARED) == 0)
+            return false;
+
+        Key = PipelineStateRegistryKey{
+            CreateInfo,
+            [](IShader* pShader) -> PipelineStateRegistryKey::ShaderBytecodeId {
+                const auto* pShaderImpl = ValidatedCast<ShaderImplType>(pShader);
+
+                PipelineStateRegistryKey::ShaderBytecodeId BytecodeId;
+                BytecodeId.Hash  = pShaderImpl->GetBytecodeHash();
+                BytecodeId.pData = pShaderImpl->GetBytecodeId();
+                return BytecodeId;
+            } //
+        };
+
+        m_PSORegistry.Find(Key, reinterpret_cast<IDeviceObject**>(ppPipelineState));
+        if (*ppPipelineState != nullptr)
+        {
+            ++m_PSORegistryHits;
+            return true;
+        }
+        else
+        {
+            ++m_PSORegistryMisses;
+            return false;
+        }
+    }
+
+    /// Ray tracing pipelines are never shared.
+    template <typename ShaderImplType>
+    bool FindSharedPipelineState(const RayTracingPipelineStateCreateInfo& CreateInfo, PipelineStateRegistryKey& Key, IPipelineState** ppPipelineState)
+    {
+        return false;
+    }
+
+    /// Adds the new pipeline to the registry if the key was initialized by FindSharedPipelineState().
+    void AddSharedPipelineState(PipelineStateRegistryKey& Key, IPipelineState* pPipelineState)
+    {
+        if (Key.IsEmpty() || pPipelineState == nullptr)
+            return;
+
+        Key.SetName(pPipelineState->GetDesc().Name);
+        m_PSORegistry.Add(Key, pPipelineState);
+    }
+
     RefCntAutoPtr<IEngineFactory> m_pEngineFactory;
 
     DeviceCaps       m_DeviceCaps;
@@ -432,6 +533,7 @@ protected:
     // This is safe because every object unregisters itself
     // when it is deleted.
     StateObjectsRegistry<SamplerDesc>                                           m_SamplersRegistry; ///< Sampler state registry
+    StateObjectsRegistry<PipelineStateRegistryKey>                              m_PSORegistry;      ///< Shared pipeline state registry
     std::vector<TextureFormatInfoExt, STDAllocatorRawMem<TextureFormatInfoExt>> m_TextureFormatsInfo;
     std::vector<bool, STDAllocatorRawMem<bool>>                                 m_TexFmtInfoInitFlags;
 
@@ -459,6 +561,14 @@ protected:
     FixedBlockMemoryAllocator m_BLASAllocator;        ///< Allocator for bottom-level acceleration structure objects
     FixedBlockMemoryAllocator m_TLASAllocator;        ///< Allocator for top-level acceleration structure objects
     FixedBlockMemoryAllocator m_SBTAllocator;         ///< Allocator for shader binding table objects
+    FixedBlockMemoryAllocator m_PSOCacheAllocator;    ///< Allocator for pipeline state cache objects
+    FixedBlockMemoryAllocator m_BindlessTableAllocator; ///< Allocator for bindless resource table objects
+
+    std::once_flag                              m_PipelineCompilationPoolFlag;
+    std::unique_ptr<ThreadingTools::ThreadPool> m_pPipelineCompilationPool; ///< Worker threads for asynchronous pipeline creation
+
+    std::atomic<Uint32> m_PSORegistryHits{0};
+    std::atomic<Uint32> m_PSORegistryMisses{0};
 };
 
 
@@ -482,6 +592,64 @@ void RenderDeviceBase<BaseInterface>::CreateResourceMapping(const ResourceMappin
 }
 
 
+template <typename BaseInterface>
+void RenderDeviceBase<BaseInterface>::CreateShaders(const ShaderCreateInfo* pShaderCIs, Uint32 NumShaders, IShader** ppShaders)
+{
+    DEV_CHECK_ERR(NumShaders == 0 || (pShaderCIs != nullptr && ppShaders != nullptr), "pShaderCIs and ppShaders must not be null");
+    if (NumShaders == 0 || pShaderCIs == nullptr || ppShaders == nullptr)
+        return;
+
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        DEV_CHECK_ERR(ppShaders[i] == nullptr, "Overwriting reference to existing object may cause memory leaks");
+        ppShaders[i] = nullptr;
+    }
+
+    // Every thread, including the calling one, picks the next shader from the shared counter
+    // until all shaders have been claimed. The state is shared with the pool tasks, which may
+    // start after all shaders have been created and this function has returned.
+    struct BatchState
+    {
+        std::atomic<Uint32>     NextShader{0};
+        Uint32                  NumCompleted = 0;
+        std::mutex              Mtx;
+        std::condition_variable CompletedCV;
+    };
+    auto pState = std::make_shared<BatchState>();
+
+    auto CreateShadersWorker = [this, pShaderCIs, NumShaders, ppShaders](BatchState& State) //
+    {
+        for (Uint32 i = State.NextShader.fetch_add(1); i < NumShaders; i = State.NextShader.fetch_add(1))
+        {
+            this->CreateShader(pShaderCIs[i], &ppShaders[i]);
+
+            std::lock_guard<std::mutex> Lock{State.Mtx};
+            if (++State.NumCompleted == NumShaders)
+                State.CompletedCV.notify_one();
+        }
+    };
+
+    if (m_DeviceCaps.Features.MultithreadedResourceCreation && NumShaders > 1)
+    {
+        auto&      Pool     = GetPipelineCompilationPool();
+        const auto NumTasks = std::min(NumShaders - 1, Pool.GetNumThreads());
+        for (Uint32 i = 0; i < NumTasks; ++i)
+        {
+            Pool.EnqueueTask([CreateShadersWorker, pState]() {
+                CreateShadersWorker(*pState);
+            });
+        }
+    }
+
+    CreateShadersWorker(*pState);
+
+    // The calling thread never waits for the tasks that have not started, so the function
+    // does not deadlock when all pool threads are busy, even if it is called from a pool task.
+    std::unique_lock<std::mutex> Lock{pState->Mtx};
+    pState->CompletedCV.wait(Lock, [&]() { return pState->NumCompleted == NumShaders; });
+}
+
+
 /// \tparam TObjectType        - The type of the object being created (IBuffer, ITexture, etc.).
 /// \tparam TObjectDescType    - The type of the object description structure (BufferDesc, TextureDesc, etc.).
 /// \tparam TObjectConstructor - The type of the function that constructs the object.
@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ResourceBindingPlanImpl class
+
+#include <string>
+#include <vector>
+
+#include "ResourceBindingPlan.h"
+#include "ShaderResourceBinding.h"
+#include "PipelineState.h"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "ResourceMappingImpl.hpp"
+
+namespace Diligent
+{
+
+/// Implementation of the resource binding plan
+
+/// The plan keeps the list of the shader variables of a shader resource binding object
+/// and, for every array element, the index of the resource mapping slot that the element is bound from
+/// (see ResourceMappingImpl::AddSlotReference()). Variables are referenced by the handles and indices that
+/// are the same for all SRBs of the pipeline, so the plan does not depend on a particular SRB.
+class ResourceBindingPlanImpl final : public ObjectBase<IResourceBindingPlan>
+{
+public:
+    using TObjectBase = ObjectBase<IResourceBindingPlan>;
+
+    /// \param pRefCounters    - Reference counters object that controls the lifetime of this plan.
+    /// \param SRB             - Shader resource binding object to build the plan for.
+    /// \param pShaderStages   - Shader stages of the pipeline, for which the resources will be bound.
+    /// \param NumShaderStages - The number of elements in pShaderStages array.
+    /// \param ResMapping      - Resource mapping to bind the resources from.
+    /// \param Flags           - Binding flags, see Diligent::BIND_SHADER_RESOURCES_FLAGS.
+    ResourceBindingPlanImpl(IReferenceCounters*     pRefCounters,
+                            IShaderResourceBinding& SRB,
+                            const SHADER_TYPE*      pShaderStages,
+                            Uint32                  NumShaderStages,
+                            IResourceMapping&       ResMapping,
+                            Uint32                  Flags);
+
+    ~ResourceBindingPlanImpl();
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ResourceBindingPlan, TObjectBase)
+
+    /// Implementation of IResourceBindingPlan::BindResources().
+    virtual void DILIGENT_CALL_TYPE BindResources(IShaderResourceBinding* pSRB) override final;
+
+    /// Implementation of IResourceBindingPlan::GetNumBindings().
+    virtual Uint32 DILIGENT_CALL_TYPE GetNumBindings() const override final
+    {
+        return static_cast<Uint32>(m_Slots.size());
+    }
+
+private:
+    struct VariableInfo
+    {
+        SHADER_TYPE ShaderType = SHADER_TYPE_UNKNOWN;
+
+        /// Variable index in the shader stage, see IShaderResourceBinding::GetVariableByIndex()
+        Uint32 Index = 0;
+
+        /// Variable handle, see IShaderResourceBinding::GetVariableHandle()
+        Uint32 Handle = INVALID_SHADER_VARIABLE_HANDLE;
+
+        Uint32 ArraySize = 0;
+
+        /// Index of the first array element in m_Slots
+        Uint32 FirstSlot = 0;
+
+        std::string Name;
+    };
+
+    void LogUnresolvedResource(const VariableInfo& Var, Uint32 ArrayIndex) const;
+
+    RefCntAutoPtr<IPipelineState>      m_pPSO;
+    RefCntAutoPtr<ResourceMappingImpl> m_pResMapping;
+
+    const Uint32 m_Flags;
+
+    std::vector<VariableInfo> m_Variables;
+
+    // Resource mapping slot for every array element of every variable.
+    // The slots are referenced until the plan is destroyed.
+    std::vector<Uint32> m_Slots;
+};
+
+} // namespace Diligent
@@ -31,6 +31,7 @@
 /// Declaration of the Diligent::ResourceMappingImpl class
 
 #include <unordered_map>
+#include <vector>
 
 #include "ResourceMapping.h"
 #include "ObjectBase.hpp"
@@ -53,7 +54,9 @@ public:
     /// \param RawMemAllocator - raw memory allocator that is used by the m_HashTable member
     ResourceMappingImpl(IReferenceCounters* pRefCounters, IMemoryAllocator& RawMemAllocator) :
         TObjectBase{pRefCounters},
-        m_HashTable{STD_ALLOCATOR_RAW_MEM(HashTableElem, RawMemAllocator, "Allocator for unordered_map<ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>")}
+        m_HashTable{STD_ALLOCATOR_RAW_MEM(HashTableElem, RawMemAllocator, "Allocator for unordered_map<ResMappingHashKey, Uint32>")},
+        m_Slots{STD_ALLOCATOR_RAW_MEM(ResourceSlot, RawMemAllocator, "Allocator for vector<ResourceSlot>")},
+        m_FreeSlots{STD_ALLOCATOR_RAW_MEM(Uint32, RawMemAllocator, "Allocator for vector<Uint32>")}
     {}
 
     ~ResourceMappingImpl();
@@ -83,7 +86,31 @@ public:
     /// Returns number of resources in the resource mapping.
     virtual size_t DILIGENT_CALL_TYPE GetSize() override final;
 
+    ThreadingTools::LockHelper Lock();
+
+    /// Returns the index of the slot that holds the resource with the given name and array index
+    /// and adds a reference to the slot. If there is no such resource, an empty slot is reserved for it.
+
+    /// \remarks The index remains valid and always references the resource that is currently mapped
+    ///          to the name until the reference is released by ReleaseSlotReference().
+    ///          The mapping must be locked by the caller.
+    Uint32 AddSlotReference(const Char* Name, Uint32 ArrayIndex);
+
+    /// Releases the reference added by AddSlotReference(). The slot is recycled when it is not
+    /// referenced and holds no resource. The mapping must be locked by the caller.
+    void ReleaseSlotReference(Uint32 SlotIndex);
+
+    /// Returns the object in the slot, or null if the slot is empty. The mapping must be locked by the caller.
+    IDeviceObject* GetSlotObject(Uint32 SlotIndex)
+    {
+        VERIFY_EXPR(SlotIndex < m_Slots.size());
+        return m_Slots[SlotIndex].pObject;
+    }
+
 private:
+    Uint32 FindOrCreateSlot(const Char* Name, Uint32 ArrayIndex);
+    void   RecycleSlotIfUnused(Uint32 SlotIndex);
+
     struct ResMappingHashKey : public HashMapStringKey
     {
         using TBase = HashMapStringKey;
@@ -114,17 +141,39 @@ private:
         const Uint32 ArrayIndex;
     };
 
-    ThreadingTools::LockHelper Lock();
-
     ThreadingTools::LockFlag m_LockFlag;
 
-    using HashTableElem = std::pair<const ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>;
+    struct ResourceSlot
+    {
+        RefCntAutoPtr<IDeviceObject> pObject;
+
+        // Key of the slot in the hash table, or null if the slot is free
+        const ResMappingHashKey* pKey = nullptr;
+
+        // The number of references added by AddSlotReference(). Referenced slots are
+        // left in place when the resource is removed.
+        Uint32 NumRefs = 0;
+
+        // Indicates if the resource is in the mapping
+        bool IsMapped = false;
+    };
+
+    // The hash table maps resource name and array index to the slot in m_Slots
+    using HashTableElem = std::pair<const ResMappingHashKey, Uint32>;
     std::unordered_map<ResMappingHashKey,
-                       RefCntAutoPtr<IDeviceObject>,
+                       Uint32,
                        ResMappingHashKey::Hasher,
                        std::equal_to<ResMappingHashKey>,
                        STDAllocatorRawMem<HashTableElem>>
         m_HashTable;
+
+    std::vector<ResourceSlot, STDAllocatorRawMem<ResourceSlot>> m_Slots;
+
+    // Indices of the free slots in m_Slots that may be reused
+    std::vector<Uint32, STDAllocatorRawMem<Uint32>> m_FreeSlots;
+
+    // The number of slots that hold mapped resources
+    size_t m_NumMappedResources = 0;
 };
 
 } // namespace Diligent
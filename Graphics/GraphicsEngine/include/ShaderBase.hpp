@@ -31,6 +31,8 @@
 /// Implementation of the Diligent::ShaderBase template class
 
 #include <vector>
+#include <memory>
+#include <cstring>
 
 #include "Shader.h"
 #include "DeviceObjectBase.hpp"
@@ -38,6 +40,7 @@
 #include "PlatformMisc.hpp"
 #include "EngineMemory.h"
 #include "Align.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -85,6 +88,47 @@ public:
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Shader, TDeviceObjectBase)
+
+    /// Shader byte code together with the entry point and the combined sampler suffix
+    /// that affect the shader reflection. Identifies the shader in the pipeline state registry.
+    using BytecodeIdType = std::shared_ptr<const std::vector<Uint8>>;
+
+    const BytecodeIdType& GetBytecodeId() const { return m_pBytecodeId; }
+
+    /// Returns the hash of the byte code identity (see GetBytecodeId()).
+    size_t GetBytecodeHash() const { return m_BytecodeHash; }
+
+protected:
+    /// Initializes the byte code identity and its hash.
+    void InitBytecodeId(const void* pBytecode, size_t Size, const ShaderCreateInfo& ShaderCI)
+    {
+        const Char* EntryPoint    = ShaderCI.EntryPoint != nullptr ? ShaderCI.EntryPoint : "";
+        const Char* SamplerSuffix = ShaderCI.UseCombinedTextureSamplers && ShaderCI.CombinedSamplerSuffix != nullptr ? ShaderCI.CombinedSamplerSuffix : "";
+
+        const auto  ByteCodeSize = static_cast<Uint64>(Size);
+        const Uint8 UseCombined  = ShaderCI.UseCombinedTextureSamplers ? 1 : 0;
+
+        std::vector<Uint8> Id;
+        Id.reserve(sizeof(ByteCodeSize) + Size + strlen(EntryPoint) + 1 + sizeof(UseCombined) + strlen(SamplerSuffix) + 1);
+
+        auto Append = [&Id](const void* pData, size_t DataSize) {
+            const auto* pBytes = static_cast<const Uint8*>(pData);
+            Id.insert(Id.end(), pBytes, pBytes + DataSize);
+        };
+        // The size goes first, and strings are null-terminated, so different
+        // combinations of the parameters never produce the same identity.
+        Append(&ByteCodeSize, sizeof(ByteCodeSize));
+        Append(pBytecode, Size);
+        Append(EntryPoint, strlen(EntryPoint) + 1);
+        Append(&UseCombined, sizeof(UseCombined));
+        Append(SamplerSuffix, strlen(SamplerSuffix) + 1);
+
+        m_BytecodeHash = ComputeHashRaw(Id.data(), Id.size());
+        m_pBytecodeId  = std::make_shared<const std::vector<Uint8>>(std::move(Id));
+    }
+
+    BytecodeIdType m_pBytecodeId;
+    size_t m_BytecodeHash = 0;
 };
 
 } // namespace Diligent
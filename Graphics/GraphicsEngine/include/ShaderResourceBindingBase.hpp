@@ -38,6 +38,8 @@
 #include "Constants.h"
 #include "RefCntAutoPtr.hpp"
 #include "GraphicsAccessories.hpp"
+#include "ResourceBindingPlanImpl.hpp"
+#include "EngineMemory.h"
 
 namespace Diligent
 {
@@ -63,10 +65,36 @@ public:
         TObjectBase{pRefCounters},
         m_spPSO{IsInternal ? nullptr : pPSO},
         m_pPSO{pPSO}
-    {}
+    {
+        const auto& ResLayout = pPSO->GetDesc().ResourceLayout;
+        m_HasDynamicVariables = ResLayout.DefaultVariableType == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+        for (Uint32 v = 0; v < ResLayout.NumVariables && !m_HasDynamicVariables; ++v)
+            m_HasDynamicVariables = ResLayout.Variables[v].Type == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ShaderResourceBinding, TObjectBase)
 
+    virtual ReferenceCounterValueType DILIGENT_CALL_TYPE Release() override final
+    {
+        // Internal objects do not hold the reference to the PSO and are never pooled
+        if (m_spPSO && m_pPSO->HasSRBPool())
+        {
+            // If there are no weak references, the strong reference counter can only be incremented
+            // by the owner of one of the strong references, so if it is one, this is the last reference.
+            auto* pRefCounters = this->GetReferenceCounters();
+            if (pRefCounters->GetNumStrongRefs() == 1 && pRefCounters->GetNumWeakRefs() == 0)
+            {
+                ResetResources();
+                // Pooled objects must not keep the pipeline alive. Note that releasing the
+                // pipeline may destroy the pool and this object, so it must not be accessed after that.
+                RefCntAutoPtr<PipelineStateImplType> pPSO = std::move(m_spPSO);
+                pPSO->RecycleShaderResourceBinding(this);
+                return 0;
+            }
+        }
+        return TObjectBase::Release();
+    }
+
     /// Implementation of IShaderResourceBinding::GetPipelineState().
     virtual IPipelineState* DILIGENT_CALL_TYPE GetPipelineState() override final
     {
@@ -85,7 +113,53 @@ public:
         return ValidatedCast<PSOType>(m_pPSO);
     }
 
+    /// Implementation of IShaderResourceBinding::CreateBindingPlan().
+    virtual void DILIGENT_CALL_TYPE CreateBindingPlan(Uint32                 ShaderFlags,
+                                                      IResourceMapping*      pResMapping,
+                                                      Uint32                 Flags,
+                                                      IResourceBindingPlan** ppPlan) override final
+    {
+        DEV_CHECK_ERR(ppPlan != nullptr, "Null pointer provided");
+        if (ppPlan == nullptr)
+            return;
+        DEV_CHECK_ERR(*ppPlan == nullptr, "Overwriting reference to existing object may cause memory leaks");
+        *ppPlan = nullptr;
+
+        if (pResMapping == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Failed to create resource binding plan for pipeline '", m_pPSO->GetDesc().Name, "': resource mapping is null");
+            return;
+        }
+
+        std::array<SHADER_TYPE, MAX_SHADERS_IN_PIPELINE> ShaderStages = {};
+
+        Uint32 NumShaderStages = 0;
+        for (Uint32 s = 0; s < m_pPSO->GetNumShaderStages(); ++s)
+        {
+            const auto ShaderType = m_pPSO->GetShaderStageType(s);
+            if ((ShaderType & ShaderFlags) != 0)
+                ShaderStages[NumShaderStages++] = ShaderType;
+        }
+
+        auto* pPlan = NEW_RC_OBJ(GetRawAllocator(), "ResourceBindingPlanImpl instance", ResourceBindingPlanImpl)(*this, ShaderStages.data(), NumShaderStages, *pResMapping, Flags);
+        pPlan->QueryInterface(IID_ResourceBindingPlan, reinterpret_cast<IObject**>(ppPlan));
+    }
+
+    /// Returns true if the pipeline resource layout defines dynamic variables.
+    bool HasDynamicVariables() const { return m_HasDynamicVariables; }
+
+    /// Restores the strong reference to the pipeline state when the object is taken from the SRB pool.
+    void AttachToPipeline()
+    {
+        VERIFY(!m_spPSO, "The object is already referencing the pipeline");
+        m_spPSO = m_pPSO;
+    }
+
 protected:
+    /// Releases all resources bound to the object and resets static resources initialization
+    /// status, so that the object can be reused from the SRB pool.
+    virtual void ResetResources() = 0;
+
     Int8 GetVariableByNameHelper(SHADER_TYPE ShaderType, const char* Name, const std::array<Int8, MAX_SHADERS_IN_PIPELINE>& ResourceLayoutIndex) const
     {
         const auto PipelineType = m_pPSO->GetDesc().PipelineType;
@@ -149,11 +223,49 @@ protected:
         return ResLayoutInd;
     }
 
+    /// Packs the resource layout index and the index of the variable in that layout into
+    /// the handle returned by IShaderResourceBinding::GetVariableHandle().
+    static Uint32 PackVariableHandle(Uint32 ResLayoutInd, Uint32 VarIndex)
+    {
+        VERIFY(ResLayoutInd < (1u << VariableHandleLayoutBits), "Resource layout index (", ResLayoutInd, ") is out of range");
+        VERIFY(VarIndex < (1u << VariableHandleIndexBits), "Variable index (", VarIndex, ") is out of range");
+        return (ResLayoutInd << VariableHandleIndexBits) | VarIndex;
+    }
+
+    /// Decodes every handle and calls BindVariable(ResLayoutInd, VarIndex, pObject).
+    /// Invalid handles are skipped.
+    template <typename BindVariableType>
+    void SetVariablesHelper(const Uint32*         pHandles,
+                            IDeviceObject* const* ppObjects,
+                            Uint32                NumVariables,
+                            Uint32                NumResourceLayouts,
+                            BindVariableType      BindVariable) const
+    {
+        DEV_CHECK_ERR(NumVariables == 0 || (pHandles != nullptr && ppObjects != nullptr), "Variable handles and objects must not be null");
+        for (Uint32 i = 0; i < NumVariables; ++i)
+        {
+            const auto Handle = pHandles[i];
+            if (Handle == INVALID_SHADER_VARIABLE_HANDLE)
+                continue;
+
+            const auto ResLayoutInd = Handle >> VariableHandleIndexBits;
+            const auto VarIndex     = Handle & ((1u << VariableHandleIndexBits) - 1u);
+            DEV_CHECK_ERR(ResLayoutInd < NumResourceLayouts, "Variable handle 0x", std::hex, Handle, " does not belong to pipeline '", m_pPSO->GetDesc().Name, "'");
+            if (ResLayoutInd < NumResourceLayouts)
+                BindVariable(ResLayoutInd, VarIndex, ppObjects[i]);
+        }
+    }
+
+    static constexpr Uint32 VariableHandleIndexBits  = 24;
+    static constexpr Uint32 VariableHandleLayoutBits = 32 - VariableHandleIndexBits;
+
     /// Strong reference to PSO. We must use strong reference, because
     /// shader resource binding uses PSO's memory allocator to allocate
     /// memory for shader resource cache.
     RefCntAutoPtr<PipelineStateImplType> m_spPSO;
     PipelineStateImplType* const         m_pPSO;
+
+    bool m_HasDynamicVariables = false;
 };
 
 } // namespace Diligent
@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderResourceBindingPool class
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ShaderResourceBinding.h"
+
+namespace Diligent
+{
+
+/// Pool of released shader resource binding objects of a pipeline state
+
+/// Every object in the pool keeps one strong reference that is transferred to the caller
+/// when the object is taken from the pool. Objects that may still be used by the GPU are
+/// added to the pool as pending and only become available when MakeAvailable() is called.
+/// The pool is shared between the pipeline state and the stale objects in the device release
+/// queues that may outlive the pipeline, so it is always owned by std::shared_ptr.
+class ShaderResourceBindingPool
+{
+public:
+    explicit ShaderResourceBindingPool(Uint32 MaxSize) noexcept :
+        m_MaxSize{MaxSize}
+    {}
+
+    ~ShaderResourceBindingPool();
+
+    // clang-format off
+    ShaderResourceBindingPool             (const ShaderResourceBindingPool&)  = delete;
+    ShaderResourceBindingPool             (      ShaderResourceBindingPool&&) = delete;
+    ShaderResourceBindingPool& operator = (const ShaderResourceBindingPool&)  = delete;
+    ShaderResourceBindingPool& operator = (      ShaderResourceBindingPool&&) = delete;
+    // clang-format on
+
+    /// Takes an available object from the pool, or returns null if there are none.
+    IShaderResourceBinding* Take();
+
+    /// Adds the object to the pool. If the pool is full or has been cleared, the object is released.
+    void Add(IShaderResourceBinding* pSRB);
+
+    /// Adds the object to the pool, but does not make it available until MakeAvailable() is called.
+    /// If the pool is full or has been cleared, the object is released and the method returns false.
+    bool AddPending(IShaderResourceBinding* pSRB);
+
+    /// Makes the pending object available. Does nothing if the pool has been cleared.
+    void MakeAvailable(IShaderResourceBinding* pSRB);
+
+    /// Releases all available and pending objects. Objects that are added after that are released immediately.
+    void Clear();
+
+    /// Wrapper that is kept in the device release queues in D3D12 and Vulkan backends and
+    /// makes the pending object available once the command buffers that may use it have completed.
+    class StaleObject
+    {
+    public:
+        StaleObject(std::shared_ptr<ShaderResourceBindingPool> pPool,
+                    IShaderResourceBinding*                    pSRB) noexcept :
+            // clang-format off
+            m_pPool{std::move(pPool)},
+            m_pSRB {pSRB}
+        // clang-format on
+        {}
+
+        // clang-format off
+        StaleObject             (const StaleObject&)  = delete;
+        StaleObject& operator = (const StaleObject&)  = delete;
+        StaleObject& operator = (      StaleObject&&) = delete;
+
+        StaleObject(StaleObject&& rhs) noexcept :
+            m_pPool{std::move(rhs.m_pPool)},
+            m_pSRB {rhs.m_pSRB}
+        {
+        }
+        // clang-format on
+
+        ~StaleObject()
+        {
+            if (m_pPool)
+                m_pPool->MakeAvailable(m_pSRB);
+        }
+
+    private:
+        // The wrapper must not reference the pipeline state as this would create a reference cycle
+        // through the device, so it only keeps the pool that outlives the pipeline.
+        std::shared_ptr<ShaderResourceBindingPool> m_pPool;
+        IShaderResourceBinding* const              m_pSRB;
+    };
+
+private:
+    const Uint32 m_MaxSize;
+
+    std::mutex m_Mtx;
+
+    std::vector<IShaderResourceBinding*> m_Available;
+    std::vector<IShaderResourceBinding*> m_Pending;
+
+    bool m_IsCleared = false;
+};
+
+} // namespace Diligent
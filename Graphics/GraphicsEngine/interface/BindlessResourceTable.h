@@ -0,0 +1,200 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::IBindlessResourceTable interface and related data structures
+
+#include "DeviceObject.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+// {3E579034-6B7F-4DB7-B615-6134FC58848D}
+static const INTERFACE_ID IID_BindlessResourceTable =
+    {0x3e579034, 0x6b7f, 0x4db7, {0xb6, 0x15, 0x61, 0x34, 0xfc, 0x58, 0x84, 0x8d}};
+
+// clang-format off
+
+/// Invalid bindless resource handle
+#define DILIGENT_INVALID_BINDLESS_HANDLE 0xFFFFFFFFu
+
+static const Uint32 INVALID_BINDLESS_HANDLE = DILIGENT_INVALID_BINDLESS_HANDLE;
+
+
+/// Bindless resource type
+
+/// Every type has its own descriptor array in the table, and handles
+/// of different types are allocated independently.
+DILIGENT_TYPED_ENUM(BINDLESS_RESOURCE_TYPE, Uint8)
+{
+    /// Texture shader resource views, e.g. "Texture2D g_Textures[];"
+    BINDLESS_RESOURCE_TYPE_TEXTURE_SRV = 0,
+
+    /// Texture unordered access views, e.g. "RWTexture2D<float4> g_RWTextures[];"
+    BINDLESS_RESOURCE_TYPE_TEXTURE_UAV,
+
+    /// Structured and raw buffer shader resource views, e.g. "StructuredBuffer<Material> g_Buffers[];"
+    BINDLESS_RESOURCE_TYPE_BUFFER_SRV,
+
+    /// Structured and raw buffer unordered access views, e.g. "RWStructuredBuffer<Data> g_RWBuffers[];"
+    BINDLESS_RESOURCE_TYPE_BUFFER_UAV,
+
+    /// Separate samplers, e.g. "SamplerState g_Samplers[];"
+    BINDLESS_RESOURCE_TYPE_SAMPLER,
+
+    /// Helper value that stores the total number of bindless resource types
+    BINDLESS_RESOURCE_TYPE_COUNT
+};
+
+
+/// Bindless resource table description
+struct BindlessResourceTableDesc DILIGENT_DERIVE(DeviceObjectAttribs)
+
+    /// The size of the texture SRV array
+    Uint32 NumTextureSRVs   DEFAULT_INITIALIZER(0);
+
+    /// The size of the texture UAV array
+    Uint32 NumTextureUAVs   DEFAULT_INITIALIZER(0);
+
+    /// The size of the buffer SRV array
+    Uint32 NumBufferSRVs    DEFAULT_INITIALIZER(0);
+
+    /// The size of the buffer UAV array
+    Uint32 NumBufferUAVs    DEFAULT_INITIALIZER(0);
+
+    /// The size of the sampler array
+    Uint32 NumSamplers      DEFAULT_INITIALIZER(0);
+
+    /// Defines which command queues the table can be used with.
+    /// Released handles are only reused when all these queues are done with them.
+    Uint64 CommandQueueMask DEFAULT_INITIALIZER(1);
+};
+typedef struct BindlessResourceTableDesc BindlessResourceTableDesc;
+
+
+/// Bindless resource table statistics
+struct BindlessResourceTableStats
+{
+    /// The number of handles currently in use, for every resource type
+    Uint32 NumAllocatedHandles[BINDLESS_RESOURCE_TYPE_COUNT] DEFAULT_INITIALIZER({});
+
+    /// The number of released handles that may still be accessed by the GPU
+    /// and can't be reused yet, for every resource type
+    Uint32 NumPendingHandles  [BINDLESS_RESOURCE_TYPE_COUNT] DEFAULT_INITIALIZER({});
+};
+typedef struct BindlessResourceTableStats BindlessResourceTableStats;
+
+// clang-format on
+
+#define DILIGENT_INTERFACE_NAME IBindlessResourceTable
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+#define IBindlessResourceTableInclusiveMethods \
+    IDeviceObjectInclusiveMethods;             \
+    IBindlessResourceTableMethods BindlessResourceTable
+
+// clang-format off
+
+/// Bindless resource table interface
+
+/// Bindless resource table is a set of large descriptor arrays, one per resource type
+/// (see Diligent::BINDLESS_RESOURCE_TYPE), that are owned by the device. Every resource
+/// placed into the table receives a stable integer handle that shaders use to index the
+/// array of the corresponding type. Shaders access the arrays through unbounded resource
+/// arrays, e.g. "Texture2D g_Textures[];", and pipelines that use them must be created with
+/// the table (see PipelineStateCreateInfo::pBindlessTable). The table is bound automatically
+/// together with the pipeline, so drawing objects with different resources does not require
+/// committing shader resource bindings.
+///
+/// \remarks The table keeps strong references to all resources it contains. Released handles
+///          are recycled only after the GPU has finished all commands that could have used them.
+///
+///          Resource state transitions are not performed for the resources in the table,
+///          the application must transition them explicitly (see IDeviceContext::TransitionResourceStates()).
+///
+///          The table may be used by multiple threads simultaneously.
+///
+///          DeviceFeatures::BindlessResources feature must be enabled.
+DILIGENT_BEGIN_INTERFACE(IBindlessResourceTable, IDeviceObject)
+{
+#if DILIGENT_CPP_INTERFACE
+    /// Returns the bindless resource table description used to create the object
+    virtual const BindlessResourceTableDesc& METHOD(GetDesc)() const override = 0;
+#endif
+
+    /// Places the resource into the table and returns its handle.
+
+    /// \param [in] pObject - Resource to place into the table: texture SRV or UAV, structured or raw
+    ///                       buffer SRV or UAV, or sampler. The resource type is determined from the object.
+    ///                       Views of dynamic buffers are not allowed.
+    ///
+    /// \return     The index of the resource in the descriptor array of the corresponding type,
+    ///             or Diligent::INVALID_BINDLESS_HANDLE if the object can't be placed into the table
+    ///             or the array is full.
+    ///
+    /// \remarks    Allocating the handle for the object that is already in the table returns the same handle.
+    ///             Every call to AllocateHandle() must be matched by a call to ReleaseHandle().
+    VIRTUAL Uint32 METHOD(AllocateHandle)(THIS_
+                                          IDeviceObject* pObject) PURE;
+
+    /// Releases the handle previously allocated for the resource by AllocateHandle().
+
+    /// \remarks When the last reference to the handle is released, the table releases the resource.
+    ///          The handle may be reused by another resource once the GPU has finished
+    ///          all commands submitted before this call.
+    VIRTUAL void METHOD(ReleaseHandle)(THIS_
+                                       IDeviceObject* pObject) PURE;
+
+    /// Returns the handle of the resource in the table, or Diligent::INVALID_BINDLESS_HANDLE if the resource is not in the table.
+    VIRTUAL Uint32 METHOD(GetHandle)(THIS_
+                                     IDeviceObject* pObject) CONST PURE;
+
+    /// Returns the table statistics, see Diligent::BindlessResourceTableStats.
+    VIRTUAL void METHOD(GetStats)(THIS_
+                                  BindlessResourceTableStats REF Stats) CONST PURE;
+};
+DILIGENT_END_INTERFACE
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format off
+
+#    define IBindlessResourceTable_GetDesc(This) (const struct BindlessResourceTableDesc*)IDeviceObject_GetDesc(This)
+
+#    define IBindlessResourceTable_AllocateHandle(This, ...) CALL_IFACE_METHOD(BindlessResourceTable, AllocateHandle, This, __VA_ARGS__)
+#    define IBindlessResourceTable_ReleaseHandle(This, ...)  CALL_IFACE_METHOD(BindlessResourceTable, ReleaseHandle,  This, __VA_ARGS__)
+#    define IBindlessResourceTable_GetHandle(This, ...)      CALL_IFACE_METHOD(BindlessResourceTable, GetHandle,      This, __VA_ARGS__)
+#    define IBindlessResourceTable_GetStats(This, ...)       CALL_IFACE_METHOD(BindlessResourceTable, GetStats,       This, __VA_ARGS__)
+
+// clang-format on
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
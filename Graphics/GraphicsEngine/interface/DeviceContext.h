@@ -370,6 +370,227 @@ struct DrawIndexedIndirectAttribs
 typedef struct DrawIndexedIndirectAttribs DrawIndexedIndirectAttribs;
 
 
+/// Describes a single draw in the multi-draw command.
+
+/// This structure is used by IDeviceContext::MultiDraw().
+struct MultiDrawItem
+{
+    /// The number of vertices to draw.
+    Uint32 NumVertices           DEFAULT_INITIALIZER(0);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) of the first vertex in the
+    /// vertex buffer to start reading vertices from.
+    Uint32 StartVertexLocation   DEFAULT_INITIALIZER(0);
+};
+typedef struct MultiDrawItem MultiDrawItem;
+
+
+/// Defines the multi-draw command attributes.
+
+/// This structure is used by IDeviceContext::MultiDraw().
+struct MultiDrawAttribs
+{
+    /// The number of draws in the pDrawItems array.
+    Uint32               DrawCount             DEFAULT_INITIALIZER(0);
+
+    /// An array of DrawCount draw items, see Diligent::MultiDrawItem.
+    const MultiDrawItem* pDrawItems            DEFAULT_INITIALIZER(nullptr);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS           Flags                 DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// The number of instances to draw in every draw.
+    Uint32               NumInstances          DEFAULT_INITIALIZER(1);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) in the vertex buffer to start
+    /// reading instance data from.
+    Uint32               FirstInstanceLocation DEFAULT_INITIALIZER(0);
+
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values.
+    MultiDrawAttribs()noexcept{}
+
+    /// Initializes the structure with user-specified values.
+    MultiDrawAttribs(Uint32               _DrawCount,
+                     const MultiDrawItem* _pDrawItems,
+                     DRAW_FLAGS           _Flags,
+                     Uint32               _NumInstances          = 1,
+                     Uint32               _FirstInstanceLocation = 0)noexcept :
+        DrawCount            {_DrawCount            },
+        pDrawItems           {_pDrawItems           },
+        Flags                {_Flags                },
+        NumInstances         {_NumInstances         },
+        FirstInstanceLocation{_FirstInstanceLocation}
+    {}
+#endif
+};
+typedef struct MultiDrawAttribs MultiDrawAttribs;
+
+
+/// Describes a single draw in the indexed multi-draw command.
+
+/// This structure is used by IDeviceContext::MultiDrawIndexed().
+struct MultiDrawIndexedItem
+{
+    /// The number of indices to draw.
+    Uint32 NumIndices            DEFAULT_INITIALIZER(0);
+
+    /// LOCATION (NOT the byte offset) of the first index in
+    /// the index buffer to start reading indices from.
+    Uint32 FirstIndexLocation    DEFAULT_INITIALIZER(0);
+
+    /// A constant which is added to each index before accessing the vertex buffer.
+    Uint32 BaseVertex            DEFAULT_INITIALIZER(0);
+};
+typedef struct MultiDrawIndexedItem MultiDrawIndexedItem;
+
+
+/// Defines the indexed multi-draw command attributes.
+
+/// This structure is used by IDeviceContext::MultiDrawIndexed().
+struct MultiDrawIndexedAttribs
+{
+    /// The number of draws in the pDrawItems array.
+    Uint32                      DrawCount             DEFAULT_INITIALIZER(0);
+
+    /// An array of DrawCount draw items, see Diligent::MultiDrawIndexedItem.
+    const MultiDrawIndexedItem* pDrawItems            DEFAULT_INITIALIZER(nullptr);
+
+    /// The type of elements in the index buffer.
+    /// Allowed values: VT_UINT16 and VT_UINT32.
+    VALUE_TYPE                  IndexType             DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS                  Flags                 DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// The number of instances to draw in every draw.
+    Uint32                      NumInstances          DEFAULT_INITIALIZER(1);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) in the vertex
+    /// buffer to start reading instance data from.
+    Uint32                      FirstInstanceLocation DEFAULT_INITIALIZER(0);
+
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values.
+    MultiDrawIndexedAttribs()noexcept{}
+
+    /// Initializes the structure with user-specified values.
+    MultiDrawIndexedAttribs(Uint32                      _DrawCount,
+                            const MultiDrawIndexedItem* _pDrawItems,
+                            VALUE_TYPE                  _IndexType,
+                            DRAW_FLAGS                  _Flags,
+                            Uint32                      _NumInstances          = 1,
+                            Uint32                      _FirstInstanceLocation = 0)noexcept :
+        DrawCount            {_DrawCount            },
+        pDrawItems           {_pDrawItems           },
+        IndexType            {_IndexType            },
+        Flags                {_Flags                },
+        NumInstances         {_NumInstances         },
+        FirstInstanceLocation{_FirstInstanceLocation}
+    {}
+#endif
+};
+typedef struct MultiDrawIndexedAttribs MultiDrawIndexedAttribs;
+
+
+/// Defines the indirect multi-draw command attributes.
+
+/// This structure is used by IDeviceContext::MultiDrawIndirect().
+struct MultiDrawIndirectAttribs
+{
+    /// The maximum number of draws to execute. If the count buffer is provided,
+    /// the actual number of draws is the minimum of the value read from the count
+    /// buffer and DrawCount.
+    Uint32     DrawCount                DEFAULT_INITIALIZER(0);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS Flags                    DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// State transition mode for indirect draw arguments buffer.
+    RESOURCE_STATE_TRANSITION_MODE IndirectAttribsBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Offset from the beginning of the buffer to the location of the first draw command attributes.
+    Uint32     IndirectDrawArgsOffset   DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the count buffer.
+    RESOURCE_STATE_TRANSITION_MODE CountBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Offset from the beginning of the count buffer to the Uint32 value that contains the number of draws.
+    Uint32     CountBufferOffset        DEFAULT_INITIALIZER(0);
+
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values.
+    MultiDrawIndirectAttribs()noexcept{}
+
+    /// Initializes the structure members with user-specified values.
+    MultiDrawIndirectAttribs(Uint32                         _DrawCount,
+                             DRAW_FLAGS                     _Flags,
+                             RESOURCE_STATE_TRANSITION_MODE _IndirectAttribsBufferStateTransitionMode,
+                             Uint32                         _IndirectDrawArgsOffset = 0)noexcept :
+        DrawCount                               {_DrawCount                               },
+        Flags                                   {_Flags                                   },
+        IndirectAttribsBufferStateTransitionMode{_IndirectAttribsBufferStateTransitionMode},
+        IndirectDrawArgsOffset                  {_IndirectDrawArgsOffset                  }
+    {}
+#endif
+};
+typedef struct MultiDrawIndirectAttribs MultiDrawIndirectAttribs;
+
+
+/// Defines the indexed indirect multi-draw command attributes.
+
+/// This structure is used by IDeviceContext::MultiDrawIndexedIndirect().
+struct MultiDrawIndexedIndirectAttribs
+{
+    /// The maximum number of draws to execute. If the count buffer is provided,
+    /// the actual number of draws is the minimum of the value read from the count
+    /// buffer and DrawCount.
+    Uint32     DrawCount                DEFAULT_INITIALIZER(0);
+
+    /// The type of the elements in the index buffer.
+    /// Allowed values: VT_UINT16 and VT_UINT32.
+    VALUE_TYPE IndexType                DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS Flags                    DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// State transition mode for indirect draw arguments buffer.
+    RESOURCE_STATE_TRANSITION_MODE IndirectAttribsBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Offset from the beginning of the buffer to the location of the first draw command attributes.
+    Uint32     IndirectDrawArgsOffset   DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the count buffer.
+    RESOURCE_STATE_TRANSITION_MODE CountBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Offset from the beginning of the count buffer to the Uint32 value that contains the number of draws.
+    Uint32     CountBufferOffset        DEFAULT_INITIALIZER(0);
+
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values.
+    MultiDrawIndexedIndirectAttribs()noexcept{}
+
+    /// Initializes the structure members with user-specified values.
+    MultiDrawIndexedIndirectAttribs(Uint32                         _DrawCount,
+                                    VALUE_TYPE                     _IndexType,
+                                    DRAW_FLAGS                     _Flags,
+                                    RESOURCE_STATE_TRANSITION_MODE _IndirectAttribsBufferStateTransitionMode,
+                                    Uint32                         _IndirectDrawArgsOffset = 0)noexcept :
+        DrawCount                               {_DrawCount                               },
+        IndexType                               {_IndexType                               },
+        Flags                                   {_Flags                                   },
+        IndirectAttribsBufferStateTransitionMode{_IndirectAttribsBufferStateTransitionMode},
+        IndirectDrawArgsOffset                  {_IndirectDrawArgsOffset                  }
+    {}
+#endif
+};
+typedef struct MultiDrawIndexedIndirectAttribs MultiDrawIndexedIndirectAttribs;
+
+
 /// Defines the mesh draw command attributes.
 
 /// This structure is used by IDeviceContext::DrawMesh().
@@ -1355,6 +1576,34 @@ struct StateTransitionDesc
 typedef struct StateTransitionDesc StateTransitionDesc;
 
 
+/// Statistics of redundant state changes, see IDeviceContext::GetRedundantStateStats().
+
+/// Every counter is the number of calls that did not change the context state and were
+/// filtered out before reaching the underlying graphics API.
+struct RedundantStateStats
+{
+    /// The number of redundant IDeviceContext::SetVertexBuffers() calls
+    Uint32 NumVertexBuffersCalls          DEFAULT_INITIALIZER(0);
+
+    /// The number of redundant IDeviceContext::SetViewports() calls
+    Uint32 NumViewportsCalls              DEFAULT_INITIALIZER(0);
+
+    /// The number of redundant IDeviceContext::SetScissorRects() calls
+    Uint32 NumScissorRectsCalls           DEFAULT_INITIALIZER(0);
+
+    /// The number of redundant IDeviceContext::SetStencilRef() calls
+    Uint32 NumStencilRefCalls             DEFAULT_INITIALIZER(0);
+
+    /// The number of redundant IDeviceContext::SetBlendFactors() calls
+    Uint32 NumBlendFactorsCalls           DEFAULT_INITIALIZER(0);
+
+    /// The number of IDeviceContext::CommitShaderResources() calls that
+    /// re-committed the shader resource binding that is already committed
+    Uint32 NumCommitShaderResourcesCalls  DEFAULT_INITIALIZER(0);
+};
+typedef struct RedundantStateStats RedundantStateStats;
+
+
 #define DILIGENT_INTERFACE_NAME IDeviceContext
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -1742,6 +1991,72 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                           IBuffer*                          pAttribsBuffer) PURE;
 
 
+    /// Executes a sequence of draw commands that share the same pipeline state and resources.
+
+    /// \param [in] Attribs - Multi-draw command attributes, see Diligent::MultiDrawAttribs for details.
+    ///
+    /// \remarks  The method validates the arguments and prepares the pipeline only once for
+    ///           all draws, which is considerably cheaper than calling IDeviceContext::Draw()
+    ///           multiple times.
+    ///
+    ///           If Diligent::DRAW_FLAG_VERIFY_STATES flag is set, the method reads the state of vertex
+    ///           buffers, so no other threads are allowed to alter the states of the same resources.
+    ///           It is OK to read these states.
+    VIRTUAL void METHOD(MultiDraw)(THIS_
+                                   const MultiDrawAttribs REF Attribs) PURE;
+
+
+    /// Executes a sequence of indexed draw commands that share the same pipeline state and resources.
+
+    /// \param [in] Attribs - Multi-draw command attributes, see Diligent::MultiDrawIndexedAttribs for details.
+    ///
+    /// \remarks  If Diligent::DRAW_FLAG_VERIFY_STATES flag is set, the method reads the state of vertex/index
+    ///           buffers, so no other threads are allowed to alter the states of the same resources.
+    ///           It is OK to read these states.
+    VIRTUAL void METHOD(MultiDrawIndexed)(THIS_
+                                          const MultiDrawIndexedAttribs REF Attribs) PURE;
+
+
+    /// Executes a sequence of indirect draw commands.
+
+    /// \param [in] Attribs        - Structure describing the command attributes, see Diligent::MultiDrawIndirectAttribs for details.
+    /// \param [in] pAttribsBuffer - Pointer to the buffer, from which indirect draw attributes will be read.
+    ///                              The buffer must contain Attribs.DrawCount tightly packed structures
+    ///                              with the same layout as in IDeviceContext::DrawIndirect(), starting
+    ///                              at the specified offset.
+    /// \param [in] pCountBuffer   - Optional pointer to the buffer that contains the number of draws to execute.
+    ///                              If the buffer is not null, DeviceFeatures::DrawIndirectCount feature must be enabled.
+    ///
+    /// \remarks  If IndirectAttribsBufferStateTransitionMode or CountBufferStateTransitionMode member is
+    ///           Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION, the method may transition the state of the
+    ///           corresponding buffer. This is not a thread safe operation, so no other thread is allowed to
+    ///           read or write the state of the buffer.
+    VIRTUAL void METHOD(MultiDrawIndirect)(THIS_
+                                           const MultiDrawIndirectAttribs REF Attribs,
+                                           IBuffer*                           pAttribsBuffer,
+                                           IBuffer*                           pCountBuffer) PURE;
+
+
+    /// Executes a sequence of indexed indirect draw commands.
+
+    /// \param [in] Attribs        - Structure describing the command attributes, see Diligent::MultiDrawIndexedIndirectAttribs for details.
+    /// \param [in] pAttribsBuffer - Pointer to the buffer, from which indirect draw attributes will be read.
+    ///                              The buffer must contain Attribs.DrawCount tightly packed structures
+    ///                              with the same layout as in IDeviceContext::DrawIndexedIndirect(), starting
+    ///                              at the specified offset.
+    /// \param [in] pCountBuffer   - Optional pointer to the buffer that contains the number of draws to execute.
+    ///                              If the buffer is not null, DeviceFeatures::DrawIndirectCount feature must be enabled.
+    ///
+    /// \remarks  If IndirectAttribsBufferStateTransitionMode or CountBufferStateTransitionMode member is
+    ///           Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION, the method may transition the state of the
+    ///           corresponding buffer. This is not a thread safe operation, so no other thread is allowed to
+    ///           read or write the state of the buffer.
+    VIRTUAL void METHOD(MultiDrawIndexedIndirect)(THIS_
+                                                  const MultiDrawIndexedIndirectAttribs REF Attribs,
+                                                  IBuffer*                                  pAttribsBuffer,
+                                                  IBuffer*                                  pCountBuffer) PURE;
+
+
     /// Executes a dispatch compute command.
     
     /// \param [in] Attribs - Dispatch command attributes, see Diligent::DispatchComputeAttribs for details.
@@ -2093,6 +2408,19 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     VIRTUAL Uint64 METHOD(GetFrameNumber)(THIS) CONST PURE;
 
 
+    /// Returns the statistics of redundant state changes filtered out by the context.
+
+    /// \param [out] Stats - Redundant state change statistics, see Diligent::RedundantStateStats.
+    ///
+    /// \remarks The context compares the new state with the state it already tracks and drops the
+    ///          calls that do not change it. An identical shader resource binding is not re-committed
+    ///          if the pipeline state has not changed since the last commit, the resource binding has no
+    ///          dynamic variables, and Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION mode is not used.
+    ///          The counters are accumulated over the lifetime of the context.
+    VIRTUAL void METHOD(GetRedundantStateStats)(THIS_
+                                                RedundantStateStats REF Stats) CONST PURE;
+
+
     /// Transitions resource states.
 
     /// \param [in] BarrierCount      - Number of barriers in pResourceBarriers array
@@ -2226,6 +2554,10 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_DrawIndexedIndirect(This, ...)       CALL_IFACE_METHOD(DeviceContext, DrawIndexedIndirect,       This, __VA_ARGS__)
 #    define IDeviceContext_DrawMesh(This, ...)                  CALL_IFACE_METHOD(DeviceContext, DrawMesh,                  This, __VA_ARGS__)
 #    define IDeviceContext_DrawMeshIndirect(This, ...)          CALL_IFACE_METHOD(DeviceContext, DrawMeshIndirect,          This, __VA_ARGS__)
+#    define IDeviceContext_MultiDraw(This, ...)                 CALL_IFACE_METHOD(DeviceContext, MultiDraw,                 This, __VA_ARGS__)
+#    define IDeviceContext_MultiDrawIndexed(This, ...)          CALL_IFACE_METHOD(DeviceContext, MultiDrawIndexed,          This, __VA_ARGS__)
+#    define IDeviceContext_MultiDrawIndirect(This, ...)         CALL_IFACE_METHOD(DeviceContext, MultiDrawIndirect,         This, __VA_ARGS__)
+#    define IDeviceContext_MultiDrawIndexedIndirect(This, ...)  CALL_IFACE_METHOD(DeviceContext, MultiDrawIndexedIndirect,  This, __VA_ARGS__)
 #    define IDeviceContext_DispatchCompute(This, ...)           CALL_IFACE_METHOD(DeviceContext, DispatchCompute,           This, __VA_ARGS__)
 #    define IDeviceContext_DispatchComputeIndirect(This, ...)   CALL_IFACE_METHOD(DeviceContext, DispatchComputeIndirect,   This, __VA_ARGS__)
 #    define IDeviceContext_ClearDepthStencil(This, ...)         CALL_IFACE_METHOD(DeviceContext, ClearDepthStencil,         This, __VA_ARGS__)
@@ -2249,6 +2581,7 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_GenerateMips(This, ...)              CALL_IFACE_METHOD(DeviceContext, GenerateMips,              This, __VA_ARGS__)
 #    define IDeviceContext_FinishFrame(This)                    CALL_IFACE_METHOD(DeviceContext, FinishFrame,               This)
 #    define IDeviceContext_GetFrameNumber(This)                 CALL_IFACE_METHOD(DeviceContext, GetFrameNumber,            This)
+#    define IDeviceContext_GetRedundantStateStats(This, ...)    CALL_IFACE_METHOD(DeviceContext, GetRedundantStateStats,    This, __VA_ARGS__)
 #    define IDeviceContext_TransitionResourceStates(This, ...)  CALL_IFACE_METHOD(DeviceContext, TransitionResourceStates,  This, __VA_ARGS__)
 #    define IDeviceContext_ResolveTextureSubresource(This, ...) CALL_IFACE_METHOD(DeviceContext, ResolveTextureSubresource, This, __VA_ARGS__)
 #    define IDeviceContext_BuildBLAS(This, ...)                 CALL_IFACE_METHOD(DeviceContext, BuildBLAS,                 This, __VA_ARGS__)
@@ -1440,7 +1440,8 @@ enum RENDER_DEVICE_TYPE
     RENDER_DEVICE_TYPE_GL,             ///< OpenGL device 
     RENDER_DEVICE_TYPE_GLES,           ///< OpenGLES device
     RENDER_DEVICE_TYPE_VULKAN,         ///< Vulkan device
-    RENDER_DEVICE_TYPE_METAL           ///< Metal device (not yet implemented)
+    RENDER_DEVICE_TYPE_METAL,          ///< Metal device (not yet implemented)
+    RENDER_DEVICE_TYPE_NULL            ///< Null device that does not execute any GPU commands
 };
 
 
@@ -1633,6 +1634,10 @@ struct DeviceFeatures
     /// Indicates if device supports reading 8-bit types from uniform buffers.
     DEVICE_FEATURE_STATE UniformBuffer8BitAccess          DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
 
+    /// Indicates if device supports indirect multi-draw commands that read the number
+    /// of draws from a GPU buffer (see IDeviceContext::MultiDrawIndirect()).
+    DEVICE_FEATURE_STATE DrawIndirectCount                DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
 
 #if DILIGENT_CPP_INTERFACE
     DeviceFeatures() noexcept {}
@@ -1669,10 +1674,11 @@ struct DeviceFeatures
         ShaderInputOutput16               {State},
         ShaderInt8                        {State},
         ResourceBuffer8BitAccess          {State},
-        UniformBuffer8BitAccess           {State}
+        UniformBuffer8BitAccess           {State},
+        DrawIndirectCount                 {State}
     {
 #   if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(*this) == 32, "Did you add a new feature to DeviceFeatures? Please handle its status above.");
+        static_assert(sizeof(*this) == 33, "Did you add a new feature to DeviceFeatures? Please handle its status above.");
 #   endif
     }
 #endif
@@ -1807,6 +1813,10 @@ struct DeviceCaps
     {
         return DevType == RENDER_DEVICE_TYPE_METAL;
     }
+    bool IsNullDevice()const
+    {
+        return DevType == RENDER_DEVICE_TYPE_NULL;
+    }
 
     struct NDCAttribs
     {
@@ -2169,6 +2179,30 @@ struct VulkanDescriptorPoolSize
 typedef struct VulkanDescriptorPoolSize VulkanDescriptorPoolSize;
 
 
+/// Shader bytecode cache statistics
+struct ShaderBytecodeCacheStats
+{
+    /// The number of shaders whose bytecode was found in the cache
+    Uint32 NumHits      DEFAULT_INITIALIZER(0);
+
+    /// The number of shaders that were not found in the cache and had to be compiled
+    Uint32 NumMisses    DEFAULT_INITIALIZER(0);
+
+    /// The number of entries added to the cache
+    Uint32 NumStores    DEFAULT_INITIALIZER(0);
+
+    /// The number of entries evicted from the cache to keep its size within the limit
+    Uint32 NumEvictions DEFAULT_INITIALIZER(0);
+
+    /// The number of entries currently in the cache
+    Uint32 NumEntries   DEFAULT_INITIALIZER(0);
+
+    /// Total size of all entries currently in the cache, in bytes
+    Uint64 TotalSize    DEFAULT_INITIALIZER(0);
+};
+typedef struct ShaderBytecodeCacheStats ShaderBytecodeCacheStats;
+
+
 /// Attributes specific to Vulkan engine
 struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     
@@ -2262,6 +2296,18 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// Path to DirectX Shader Compiler, which is required to use Shader Model 6.0+
     /// features when compiling shaders from HLSL.
     const char* pDxCompilerPath DEFAULT_INITIALIZER(nullptr);
+
+    /// Path to the directory where compiled SPIRV bytecode is cached between runs.
+
+    /// When not null, shaders created from source code are looked up in the cache by
+    /// the hash of their source, all included files, macros and compiler settings before
+    /// they are compiled, and newly compiled shaders are added to the cache.
+    /// The directory must exist. When null, the cache is disabled.
+    const char* ShaderCacheDirectory DEFAULT_INITIALIZER(nullptr);
+
+    /// Maximum total size of the shader cache, in bytes. When the size is exceeded,
+    /// least recently used entries are evicted.
+    Uint64 ShaderCacheMaxSize DEFAULT_INITIALIZER(256 << 20);
 };
 typedef struct EngineVkCreateInfo EngineVkCreateInfo;
 
@@ -2299,6 +2345,16 @@ struct EngineMtlCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 typedef struct EngineMtlCreateInfo EngineMtlCreateInfo;
 
 
+/// Attributes of the Null engine implementation
+
+/// Null device does not use any graphics API: buffers and textures are kept in host memory and
+/// device context commands only go through the validation and state tracking that is common
+/// for all backends. The device is intended for measuring the engine CPU overhead.
+struct EngineNullCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
+};
+typedef struct EngineNullCreateInfo EngineNullCreateInfo;
+
+
 /// Box
 struct Box
 {
@@ -44,6 +44,8 @@
 #include "Shader.h"
 #include "Sampler.h"
 #include "RenderPass.h"
+#include "PipelineStateCache.h"
+#include "BindlessResourceTable.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
@@ -348,6 +350,19 @@ struct PipelineStateDesc DILIGENT_DERIVE(DeviceObjectAttribs)
     /// binding object instances.
     Uint32 SRBAllocationGranularity DEFAULT_INITIALIZER(1);
 
+    /// Shader resource binding pool size
+
+    /// This member defines the maximum number of released shader resource binding objects that
+    /// the pipeline keeps for reuse. When the last reference to an SRB created by the pipeline
+    /// is released, the object is reset and returned to the pool instead of being destroyed,
+    /// and IPipelineState::CreateShaderResourceBinding() takes the objects from the pool first.
+    /// Zero disables the pool.
+    ///
+    /// \note  Pooled objects are only returned to the pool if there are no weak references to them.
+    ///        In Direct3D12 and Vulkan backends, the objects become available for reuse once the
+    ///        GPU has finished all command buffers submitted before the object was released.
+    Uint32 SRBPoolSize              DEFAULT_INITIALIZER(0);
+
     /// Defines which command queues this pipeline state can be used with
     Uint64 CommandQueueMask         DEFAULT_INITIALIZER(1);
 
@@ -384,10 +399,63 @@ DILIGENT_TYPED_ENUM(PSO_CREATE_FLAGS, Uint32)
     /// that is not found in any of the designated shader stages.
     /// Use this flag to silence these warnings.
     PSO_CREATE_FLAG_IGNORE_MISSING_IMMUTABLE_SAMPLERS = 0x02,
+
+    /// Create the pipeline asynchronously.
+
+    /// The pipeline state object is returned immediately, while shader resource
+    /// layouts and the driver pipeline are created by the device's worker threads.
+    /// Use IPipelineState::GetStatus() to query the compilation status.
+    /// The flag is ignored for ray tracing pipelines and by the backends that do not
+    /// support asynchronous pipeline creation (Direct3D11, Direct3D12 and OpenGL).
+    PSO_CREATE_FLAG_ASYNCHRONOUS                      = 0x04,
+
+    /// Share the pipeline with other identical pipelines.
+
+    /// The device keeps a registry of the pipelines created with this flag. If the registry
+    /// contains a live pipeline that was created from an identical create info, this pipeline
+    /// is returned instead of creating a new one. The create infos are compared by all members that
+    /// affect the pipeline except for the name, the pipeline state cache and the creation flags other than
+    /// Diligent::PSO_CREATE_FLAG_ASYNCHRONOUS. Asynchronous pipelines are only shared with asynchronous
+    /// pipelines that use the same fallback pipeline. Shaders are compared by their byte code, so that
+    /// identical shaders created separately are considered equal.
+    ///
+    /// \note  Shared pipelines share the static shader resource variables. An application
+    ///        must not use this flag if it binds different static resources to pipelines
+    ///        created from identical create infos.
+    ///
+    /// The flag is ignored for ray tracing pipelines. Use IRenderDevice::GetPipelineStateRegistryStats()
+    /// to query the registry hit rate.
+    PSO_CREATE_FLAG_SHARED                            = 0x08,
 };
 DEFINE_FLAG_ENUM_OPERATORS(PSO_CREATE_FLAGS);
 
 
+/// Pipeline state registry statistics, see Diligent::PSO_CREATE_FLAG_SHARED.
+struct PipelineStateRegistryStats
+{
+    /// The number of pipelines that were found in the registry
+    Uint32 NumHits   DEFAULT_INITIALIZER(0);
+
+    /// The number of pipelines that were not found in the registry and had to be created
+    Uint32 NumMisses DEFAULT_INITIALIZER(0);
+};
+typedef struct PipelineStateRegistryStats PipelineStateRegistryStats;
+
+
+/// Pipeline state status
+DILIGENT_TYPED_ENUM(PIPELINE_STATE_STATUS, Uint8)
+{
+    /// The pipeline is being compiled asynchronously.
+    PIPELINE_STATE_STATUS_COMPILING = 0,
+
+    /// The pipeline is ready to be used.
+    PIPELINE_STATE_STATUS_READY,
+
+    /// Asynchronous compilation has failed. The pipeline can't be used.
+    PIPELINE_STATE_STATUS_FAILED
+};
+
+
 /// Pipeline state creation attributes
 struct PipelineStateCreateInfo
 {
@@ -396,6 +464,21 @@ struct PipelineStateCreateInfo
 
     /// Pipeline state creation flags, see Diligent::PSO_CREATE_FLAGS.
     PSO_CREATE_FLAGS  Flags      DEFAULT_INITIALIZER(PSO_CREATE_FLAG_NONE);
+
+    /// Optional pipeline state cache that the driver will use to look up and
+    /// store the compiled pipeline, see Diligent::IPipelineStateCache.
+    IPipelineStateCache* pPSOCache DEFAULT_INITIALIZER(nullptr);
+
+    /// Optional pipeline state that a device context binds in place of this pipeline
+    /// while it is being compiled asynchronously (see Diligent::PSO_CREATE_FLAG_ASYNCHRONOUS).
+    /// The fallback pipeline must use the same shader resource layout.
+    struct IPipelineState* pAsyncFallbackPSO DEFAULT_INITIALIZER(nullptr);
+
+    /// Optional bindless resource table, see Diligent::IBindlessResourceTable.
+    /// Unbounded resource arrays in the pipeline shaders, e.g. "Texture2D g_Textures[];",
+    /// are bound to the descriptor arrays of the corresponding types in the table.
+    /// The table is bound automatically when the pipeline is set in a device context.
+    IBindlessResourceTable* pBindlessTable DEFAULT_INITIALIZER(nullptr);
 };
 typedef struct PipelineStateCreateInfo PipelineStateCreateInfo;
 
@@ -601,6 +684,21 @@ DILIGENT_BEGIN_INTERFACE(IPipelineState, IDeviceObject)
     ///             into account vertex shader input layout, number of outputs, etc.
     VIRTUAL bool METHOD(IsCompatibleWith)(THIS_
                                           const struct IPipelineState* pPSO) CONST PURE;
+
+
+    /// Returns the pipeline state status, see Diligent::PIPELINE_STATE_STATUS.
+
+    /// \param [in] WaitForCompletion - If true, the method waits until asynchronous
+    ///                                 compilation of the pipeline is finished.
+    /// \remarks   Pipelines created without Diligent::PSO_CREATE_FLAG_ASYNCHRONOUS are always ready.\n
+    ///            While the pipeline is being compiled, methods of the pipeline state object other
+    ///            than GetDesc() and GetStatus() wait for the compilation to finish.\n
+    ///            When the pipeline is set in a device context while it is being compiled,
+    ///            the context binds the fallback pipeline (see PipelineStateCreateInfo::pAsyncFallbackPSO)
+    ///            if it is ready, and otherwise waits for the compilation to finish. A pipeline that
+    ///            failed to compile is not bound.
+    VIRTUAL PIPELINE_STATE_STATUS METHOD(GetStatus)(THIS_
+                                                    bool WaitForCompletion DEFAULT_VALUE(false)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -620,6 +718,7 @@ DILIGENT_END_INTERFACE
 #    define IPipelineState_GetStaticVariableByIndex(This, ...)    CALL_IFACE_METHOD(PipelineState, GetStaticVariableByIndex,    This, __VA_ARGS__)
 #    define IPipelineState_CreateShaderResourceBinding(This, ...) CALL_IFACE_METHOD(PipelineState, CreateShaderResourceBinding, This, __VA_ARGS__)
 #    define IPipelineState_IsCompatibleWith(This, ...)            CALL_IFACE_METHOD(PipelineState, IsCompatibleWith,            This, __VA_ARGS__)
+#    define IPipelineState_GetStatus(This, ...)                   CALL_IFACE_METHOD(PipelineState, GetStatus,                   This, __VA_ARGS__)
 
 // clang-format on
 
@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::IPipelineStateCache interface and related data structures
+
+#include "../../../Primitives/interface/DataBlob.h"
+#include "DeviceObject.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+// {4E430A7A-03EC-4A8E-9D2C-261ED76D66EC}
+static const INTERFACE_ID IID_PipelineStateCache =
+    {0x4e430a7a, 0x3ec, 0x4a8e, {0x9d, 0x2c, 0x26, 0x1e, 0xd7, 0x6d, 0x66, 0xec}};
+
+// clang-format off
+
+/// Pipeline state cache description
+struct PipelineStateCacheDesc DILIGENT_DERIVE(DeviceObjectAttribs)
+};
+typedef struct PipelineStateCacheDesc PipelineStateCacheDesc;
+
+
+/// Pipeline state cache create information
+struct PipelineStateCacheCreateInfo
+{
+    /// Pipeline state cache description
+    PipelineStateCacheDesc Desc;
+
+    /// Pointer to the cache data previously retrieved with IPipelineStateCache::GetData(), or null.
+
+    /// \remarks If the data was produced by a different device or driver version, or is corrupted,
+    ///          it is ignored and an empty cache is created.
+    const void* pCacheData    DEFAULT_INITIALIZER(nullptr);
+
+    /// Size of the cache data, in bytes.
+    Uint32      CacheDataSize DEFAULT_INITIALIZER(0);
+};
+typedef struct PipelineStateCacheCreateInfo PipelineStateCacheCreateInfo;
+
+
+/// Pipeline state cache statistics
+struct PipelineStateCacheStats
+{
+    /// The size of the initial data that was accepted by the device, in bytes.
+    /// Zero if no data was provided or the data was rejected.
+    Uint32 InitialDataSize       DEFAULT_INITIALIZER(0);
+
+    /// The number of pipelines created with this cache
+    Uint32 NumPipelinesCreated   DEFAULT_INITIALIZER(0);
+
+    /// Total time spent in the driver creating pipelines with this cache, in seconds
+    double TotalCreationTime     DEFAULT_INITIALIZER(0);
+};
+typedef struct PipelineStateCacheStats PipelineStateCacheStats;
+
+// clang-format on
+
+#define DILIGENT_INTERFACE_NAME IPipelineStateCache
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+#define IPipelineStateCacheInclusiveMethods \
+    IDeviceObjectInclusiveMethods;          \
+    IPipelineStateCacheMethods PipelineStateCache
+
+// clang-format off
+
+/// Pipeline state cache interface
+
+/// Pipeline state cache accumulates the driver-compiled pipelines created with it
+/// (see PipelineStateCreateInfo::pPSOCache) and can be serialized to a blob to
+/// speed up pipeline creation in subsequent runs of the application.
+///
+/// \remarks The cache may be used by multiple threads simultaneously.
+DILIGENT_BEGIN_INTERFACE(IPipelineStateCache, IDeviceObject)
+{
+#if DILIGENT_CPP_INTERFACE
+    /// Returns the pipeline state cache description used to create the object
+    virtual const PipelineStateCacheDesc& METHOD(GetDesc)() const override = 0;
+#endif
+
+    /// Creates a blob with the cache data.
+
+    /// \param [out] ppBlob - Address of the memory location where the pointer to the
+    ///                       data blob will be written. The data can be passed to
+    ///                       IRenderDevice::CreatePipelineStateCache() in the next run.
+    VIRTUAL void METHOD(GetData)(THIS_
+                                 IDataBlob** ppBlob) PURE;
+
+    /// Returns the cache statistics, see Diligent::PipelineStateCacheStats.
+    VIRTUAL void METHOD(GetStats)(THIS_
+                                  PipelineStateCacheStats REF Stats) CONST PURE;
+};
+DILIGENT_END_INTERFACE
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format off
+
+#    define IPipelineStateCache_GetDesc(This) (const struct PipelineStateCacheDesc*)IDeviceObject_GetDesc(This)
+
+#    define IPipelineStateCache_GetData(This, ...)  CALL_IFACE_METHOD(PipelineStateCache, GetData,  This, __VA_ARGS__)
+#    define IPipelineStateCache_GetStats(This, ...) CALL_IFACE_METHOD(PipelineStateCache, GetStats, This, __VA_ARGS__)
+
+// clang-format on
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
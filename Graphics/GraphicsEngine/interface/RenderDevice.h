@@ -50,6 +50,7 @@
 #include "BottomLevelAS.h"
 #include "TopLevelAS.h"
 #include "ShaderBindingTable.h"
+#include "PipelineStateCache.h"
 
 #include "DepthStencilState.h"
 #include "RasterizerState.h"
@@ -104,6 +105,29 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
                                       const ShaderCreateInfo REF ShaderCI,
                                       IShader**                   ppShader) PURE;
 
+    /// Creates multiple shader objects
+
+    /// \param [in] pShaderCIs - Pointer to the array of NumShaders shader create infos,
+    ///                          see Diligent::ShaderCreateInfo for details.
+    /// \param [in] NumShaders - The number of shaders to create.
+    /// \param [out] ppShaders - Address of the array of NumShaders pointers where the
+    ///                          shader interfaces will be stored. If a shader could not be
+    ///                          created, the corresponding element is set to null.
+    ///                          The function calls AddRef() for every new object.
+    ///
+    /// \remarks If the device supports multithreaded resource creation (see
+    ///          Diligent::DeviceFeatures::MultithreadedResourceCreation), the shaders are
+    ///          compiled in parallel by the calling thread and the worker threads that
+    ///          the device keeps for shader and pipeline compilation. Otherwise they are
+    ///          created sequentially by the calling thread.
+    ///          The method returns when all shaders have been created.\n
+    ///          Shader source stream factories referenced by the create infos must be
+    ///          safe to use from multiple threads.
+    VIRTUAL void METHOD(CreateShaders)(THIS_
+                                       const ShaderCreateInfo* pShaderCIs,
+                                       Uint32                  NumShaders,
+                                       IShader**               ppShaders) PURE;
+
     /// Creates a new texture object
 
     /// \param [in] TexDesc - Texture description, see Diligent::TextureDesc for details.
@@ -274,6 +298,40 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
                                    IShaderBindingTable**            ppSBT) PURE;
 
 
+    /// Creates a pipeline state cache object.
+
+    /// \param [in]  CreateInfo - Pipeline state cache create info, see Diligent::PipelineStateCacheCreateInfo for details.
+    /// \param [out] ppPSOCache - Address of the memory location where the pointer to the
+    ///                           pipeline state cache interface will be stored.
+    ///                           The function calls AddRef(), so that the new object will contain
+    ///                           one reference.
+    /// \remarks Pipeline state caches are only supported by Vulkan backend. Other backends
+    ///          write null to ppPSOCache. It is valid to use null cache when creating pipelines.
+    VIRTUAL void METHOD(CreatePipelineStateCache)(THIS_
+                                                  const PipelineStateCacheCreateInfo REF CreateInfo,
+                                                  IPipelineStateCache**                  ppPSOCache) PURE;
+
+
+    /// Creates a bindless resource table.
+
+    /// \param [in]  Desc            - Bindless resource table description, see Diligent::BindlessResourceTableDesc for details.
+    /// \param [out] ppBindlessTable - Address of the memory location where the pointer to the
+    ///                                bindless resource table interface will be stored.
+    ///                                The function calls AddRef(), so that the new object will contain
+    ///                                one reference.
+    /// \remarks DeviceFeatures::BindlessResources feature must be enabled. In Vulkan backend, the device must
+    ///          also support descriptor indexing (VK_EXT_descriptor_indexing). Bindless resource tables are
+    ///          currently implemented by Vulkan and Null backends. Other backends write null to ppBindlessTable.
+    VIRTUAL void METHOD(CreateBindlessResourceTable)(THIS_
+                                                     const BindlessResourceTableDesc REF Desc,
+                                                     IBindlessResourceTable**            ppBindlessTable) PURE;
+
+
+    /// Returns the statistics of the pipeline state registry, see Diligent::PSO_CREATE_FLAG_SHARED.
+    VIRTUAL void METHOD(GetPipelineStateRegistryStats)(THIS_
+                                                       PipelineStateRegistryStats REF Stats) CONST PURE;
+
+
     /// Gets the device capabilities, see Diligent::DeviceCaps for details
     VIRTUAL const DeviceCaps REF METHOD(GetDeviceCaps)(THIS) CONST PURE;
     
@@ -335,24 +393,28 @@ DILIGENT_END_INTERFACE
 #if DILIGENT_C_INTERFACE
 
 // clang-format off
-#    define IRenderDevice_CreateBuffer(This, ...)                  CALL_IFACE_METHOD(RenderDevice, CreateBuffer,                This, __VA_ARGS__)
-#    define IRenderDevice_CreateShader(This, ...)                  CALL_IFACE_METHOD(RenderDevice, CreateShader,                This, __VA_ARGS__)
-#    define IRenderDevice_CreateTexture(This, ...)                 CALL_IFACE_METHOD(RenderDevice, CreateTexture,               This, __VA_ARGS__)
-#    define IRenderDevice_CreateSampler(This, ...)                 CALL_IFACE_METHOD(RenderDevice, CreateSampler,               This, __VA_ARGS__)
-#    define IRenderDevice_CreateResourceMapping(This, ...)         CALL_IFACE_METHOD(RenderDevice, CreateResourceMapping,       This, __VA_ARGS__)
-#    define IRenderDevice_CreateGraphicsPipelineState(This, ...)   CALL_IFACE_METHOD(RenderDevice, CreateGraphicsPipelineState, This, __VA_ARGS__)
-#    define IRenderDevice_CreateComputePipelineState(This, ...)    CALL_IFACE_METHOD(RenderDevice, CreateComputePipelineState,  This, __VA_ARGS__)
+#    define IRenderDevice_CreateBuffer(This, ...)                  CALL_IFACE_METHOD(RenderDevice, CreateBuffer,                  This, __VA_ARGS__)
+#    define IRenderDevice_CreateShader(This, ...)                  CALL_IFACE_METHOD(RenderDevice, CreateShader,                  This, __VA_ARGS__)
+#    define IRenderDevice_CreateShaders(This, ...)                 CALL_IFACE_METHOD(RenderDevice, CreateShaders,                 This, __VA_ARGS__)
+#    define IRenderDevice_CreateTexture(This, ...)                 CALL_IFACE_METHOD(RenderDevice, CreateTexture,                 This, __VA_ARGS__)
+#    define IRenderDevice_CreateSampler(This, ...)                 CALL_IFACE_METHOD(RenderDevice, CreateSampler,                 This, __VA_ARGS__)
+#    define IRenderDevice_CreateResourceMapping(This, ...)         CALL_IFACE_METHOD(RenderDevice, CreateResourceMapping,         This, __VA_ARGS__)
+#    define IRenderDevice_CreateGraphicsPipelineState(This, ...)   CALL_IFACE_METHOD(RenderDevice, CreateGraphicsPipelineState,   This, __VA_ARGS__)
+#    define IRenderDevice_CreateComputePipelineState(This, ...)    CALL_IFACE_METHOD(RenderDevice, CreateComputePipelineState,    This, __VA_ARGS__)
 #    define IRenderDevice_CreateRayTracingPipelineState(This, ...) CALL_IFACE_METHOD(RenderDevice, CreateRayTracingPipelineState, This, __VA_ARGS__)
-#    define IRenderDevice_CreateFence(This, ...)                   CALL_IFACE_METHOD(RenderDevice, CreateFence,                 This, __VA_ARGS__)
-#    define IRenderDevice_CreateQuery(This, ...)                   CALL_IFACE_METHOD(RenderDevice, CreateQuery,                 This, __VA_ARGS__)
-#    define IRenderDevice_CreateRenderPass(This, ...)              CALL_IFACE_METHOD(RenderDevice, CreateRenderPass,            This, __VA_ARGS__)
-#    define IRenderDevice_CreateFramebuffer(This, ...)             CALL_IFACE_METHOD(RenderDevice, CreateFramebuffer,           This, __VA_ARGS__)
-#    define IRenderDevice_GetDeviceCaps(This)                      CALL_IFACE_METHOD(RenderDevice, GetDeviceCaps,               This)
-#    define IRenderDevice_GetTextureFormatInfo(This, ...)          CALL_IFACE_METHOD(RenderDevice, GetTextureFormatInfo,        This, __VA_ARGS__)
-#    define IRenderDevice_GetTextureFormatInfoExt(This, ...)       CALL_IFACE_METHOD(RenderDevice, GetTextureFormatInfoExt,     This, __VA_ARGS__)
-#    define IRenderDevice_ReleaseStaleResources(This, ...)         CALL_IFACE_METHOD(RenderDevice, ReleaseStaleResources,       This, __VA_ARGS__)
-#    define IRenderDevice_IdleGPU(This)                            CALL_IFACE_METHOD(RenderDevice, IdleGPU,                     This)
-#    define IRenderDevice_GetEngineFactory(This)                   CALL_IFACE_METHOD(RenderDevice, GetEngineFactory,            This)
+#    define IRenderDevice_CreateFence(This, ...)                   CALL_IFACE_METHOD(RenderDevice, CreateFence,                   This, __VA_ARGS__)
+#    define IRenderDevice_CreateQuery(This, ...)                   CALL_IFACE_METHOD(RenderDevice, CreateQuery,                   This, __VA_ARGS__)
+#    define IRenderDevice_CreateRenderPass(This, ...)              CALL_IFACE_METHOD(RenderDevice, CreateRenderPass,              This, __VA_ARGS__)
+#    define IRenderDevice_CreateFramebuffer(This, ...)             CALL_IFACE_METHOD(RenderDevice, CreateFramebuffer,             This, __VA_ARGS__)
+#    define IRenderDevice_CreatePipelineStateCache(This, ...)      CALL_IFACE_METHOD(RenderDevice, CreatePipelineStateCache,      This, __VA_ARGS__)
+#    define IRenderDevice_CreateBindlessResourceTable(This, ...)   CALL_IFACE_METHOD(RenderDevice, CreateBindlessResourceTable,   This, __VA_ARGS__)
+#    define IRenderDevice_GetPipelineStateRegistryStats(This, ...) CALL_IFACE_METHOD(RenderDevice, GetPipelineStateRegistryStats, This, __VA_ARGS__)
+#    define IRenderDevice_GetDeviceCaps(This)                      CALL_IFACE_METHOD(RenderDevice, GetDeviceCaps,                 This)
+#    define IRenderDevice_GetTextureFormatInfo(This, ...)          CALL_IFACE_METHOD(RenderDevice, GetTextureFormatInfo,          This, __VA_ARGS__)
+#    define IRenderDevice_GetTextureFormatInfoExt(This, ...)       CALL_IFACE_METHOD(RenderDevice, GetTextureFormatInfoExt,       This, __VA_ARGS__)
+#    define IRenderDevice_ReleaseStaleResources(This, ...)         CALL_IFACE_METHOD(RenderDevice, ReleaseStaleResources,         This, __VA_ARGS__)
+#    define IRenderDevice_IdleGPU(This)                            CALL_IFACE_METHOD(RenderDevice, IdleGPU,                       This)
+#    define IRenderDevice_GetEngineFactory(This)                   CALL_IFACE_METHOD(RenderDevice, GetEngineFactory,              This)
 // clang-format on
 
 #endif
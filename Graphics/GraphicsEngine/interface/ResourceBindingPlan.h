@@ -0,0 +1,91 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::IResourceBindingPlan interface
+
+#include "../../../Primitives/interface/Object.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+struct IShaderResourceBinding;
+
+// {36F06039-FFA3-4C47-A1C4-3A424CC2BBA0}
+static const INTERFACE_ID IID_ResourceBindingPlan =
+    {0x36f06039, 0xffa3, 0x4c47, {0xa1, 0xc4, 0x3a, 0x42, 0x4c, 0xc2, 0xbb, 0xa0}};
+
+#define DILIGENT_INTERFACE_NAME IResourceBindingPlan
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+#define IResourceBindingPlanInclusiveMethods \
+    IObjectInclusiveMethods;                 \
+    IResourceBindingPlanMethods ResourceBindingPlan
+
+// clang-format off
+
+/// Resource binding plan interface
+
+/// The plan is created by IShaderResourceBinding::CreateBindingPlan() and keeps the correspondence
+/// between the shader variables of the pipeline and the resource mapping entries, so that
+/// binding resources from the mapping does not require looking up the variables and the resources by name.
+/// The plan references the entries rather than the resources, so resources that are added
+/// to the mapping or replaced after the plan has been created are picked up by the next
+/// IResourceBindingPlan::BindResources() call.
+DILIGENT_BEGIN_INTERFACE(IResourceBindingPlan, IObject)
+{
+    /// Binds resources from the resource mapping to the shader resource binding object
+
+    /// \param [in] pSRB - Shader resource binding object to bind resources to. The object must
+    ///                    be created by the same pipeline state as the object the plan was created
+    ///                    from, or by a pipeline state compatible with it.
+    ///
+    /// \remarks The method is equivalent to calling IShaderResourceBinding::BindResources() with
+    ///          the shader flags, resource mapping and flags that were used to create the plan.
+    VIRTUAL void METHOD(BindResources)(THIS_
+                                       struct IShaderResourceBinding* pSRB) PURE;
+
+    /// Returns the number of shader variable array elements that the plan binds.
+    VIRTUAL Uint32 METHOD(GetNumBindings)(THIS) CONST PURE;
+};
+DILIGENT_END_INTERFACE
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format off
+
+#    define IResourceBindingPlan_BindResources(This, ...) CALL_IFACE_METHOD(ResourceBindingPlan, BindResources,  This, __VA_ARGS__)
+#    define IResourceBindingPlan_GetNumBindings(This)     CALL_IFACE_METHOD(ResourceBindingPlan, GetNumBindings, This)
+
+// clang-format on
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
@@ -129,6 +129,35 @@ DILIGENT_TYPED_ENUM(CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS, Uint32)
 };
 DEFINE_FLAG_ENUM_OPERATORS(CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS);
 
+
+/// Describes the SPIRV optimizations that are applied to the shader byte code after compilation.
+DILIGENT_TYPED_ENUM(SPIRV_OPTIMIZATION_FLAGS, Uint32)
+{
+    /// No optimizations. The byte code is used as produced by the compiler.
+    SPIRV_OPTIMIZATION_FLAG_NONE             = 0x00,
+
+    /// Run SPIRV-Tools performance passes (same as spirv-opt -O).
+    SPIRV_OPTIMIZATION_FLAG_PERFORMANCE      = 0x01,
+
+    /// Run SPIRV-Tools size reduction passes (same as spirv-opt -Os).
+    SPIRV_OPTIMIZATION_FLAG_SIZE             = 0x02,
+
+    /// Remove dead functions, code, constants, types and unused global variables.
+    ///
+    /// \note  Resources that are not used by the shader are removed
+    ///        and are not reported by the shader reflection.
+    SPIRV_OPTIMIZATION_FLAG_DEAD_CODE        = 0x04,
+
+    /// Strip debug information (source code, names, line information) from the byte code.
+    ///
+    /// \note  Resource names are reflected before the information is stripped,
+    ///        so resource binding is not affected.
+    SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO = 0x08,
+
+    SPIRV_OPTIMIZATION_FLAG_LAST = SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO
+};
+DEFINE_FLAG_ENUM_OPERATORS(SPIRV_OPTIMIZATION_FLAGS);
+
 /// Shader description
 struct ShaderDesc DILIGENT_DERIVE(DeviceObjectAttribs)
 
@@ -221,6 +250,26 @@ struct ShaderVersion
 };
 typedef struct ShaderVersion ShaderVersion;
 
+/// SPIRV optimization statistics, see ShaderCreateInfo::pSPIRVOptimizationStats.
+struct SPIRVOptimizationStats
+{
+    /// Size of the byte code before optimizations, in bytes
+    Uint32  OriginalSize        DEFAULT_INITIALIZER(0);
+
+    /// Size of the byte code after optimization passes, in bytes
+    Uint32  OptimizedSize       DEFAULT_INITIALIZER(0);
+
+    /// Final size of the byte code after debug information is stripped, in bytes
+    Uint32  FinalSize           DEFAULT_INITIALIZER(0);
+
+    /// Time spent in optimization passes, in milliseconds
+    Float32 OptimizationTimeMs  DEFAULT_INITIALIZER(0);
+
+    /// Time spent stripping debug information, in milliseconds
+    Float32 StripTimeMs         DEFAULT_INITIALIZER(0);
+};
+typedef struct SPIRVOptimizationStats SPIRVOptimizationStats;
+
 /// Shader creation attributes
 struct ShaderCreateInfo
 {
@@ -321,6 +370,19 @@ struct ShaderCreateInfo
     /// supported by the device.
     ShaderVersion GLESSLVersion DEFAULT_INITIALIZER({});
 
+    /// SPIRV optimizations to apply to the byte code, see Diligent::SPIRV_OPTIMIZATION_FLAGS.
+    ///
+    /// \note  This member is only used by Vulkan backend. The optimizations are also applied
+    ///        to the byte code provided through the ByteCode member. When the byte code
+    ///        is loaded from the shader cache, it has already been optimized.
+    SPIRV_OPTIMIZATION_FLAGS SPIRVOptimizationFlags DEFAULT_INITIALIZER(SPIRV_OPTIMIZATION_FLAG_NONE);
+
+    /// Optional pointer to the structure that receives SPIRV optimization statistics.
+    ///
+    /// \note  If no optimizations were performed (e.g. the byte code was loaded from
+    ///        the shader cache), all sizes are equal to the final byte code size.
+    SPIRVOptimizationStats* pSPIRVOptimizationStats DEFAULT_INITIALIZER(nullptr);
+
 
     /// Memory address where pointer to the compiler messages data blob will be written
 
@@ -38,11 +38,16 @@
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
 struct IPipelineState;
+struct IResourceBindingPlan;
 
 // {061F8774-9A09-48E8-8411-B5BD20560104}
 static const INTERFACE_ID IID_ShaderResourceBinding =
     {0x61f8774, 0x9a09, 0x48e8, {0x84, 0x11, 0xb5, 0xbd, 0x20, 0x56, 0x1, 0x4}};
 
+/// Invalid shader variable handle
+#define DILIGENT_INVALID_SHADER_VARIABLE_HANDLE 0xFFFFFFFFu
+
+static const Uint32 INVALID_SHADER_VARIABLE_HANDLE = DILIGENT_INVALID_SHADER_VARIABLE_HANDLE;
 
 #define DILIGENT_INTERFACE_NAME IShaderResourceBinding
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
@@ -128,6 +133,71 @@ DILIGENT_BEGIN_INTERFACE(IShaderResourceBinding, IObject)
     ///       no effect and a warning messge will be displayed.
     VIRTUAL void METHOD(InitializeStaticResources)(THIS_
                                                    const struct IPipelineState* pPipelineState DEFAULT_VALUE(nullptr)) PURE;
+
+    /// Creates a copy of this shader resource binding object
+
+    /// \param [out] ppClone - Address of the memory location where the pointer to the new
+    ///                        shader resource binding object will be written.
+    ///
+    /// \remark The new object belongs to the same pipeline state and references the same resources
+    ///         as this object, including the static resources if they have been initialized.
+    ///         The resources are copied directly from the resource cache, without resolving
+    ///         the variables. If the pipeline state has the SRB pool (see PipelineStateDesc::SRBPoolSize),
+    ///         the new object is taken from the pool.
+    VIRTUAL void METHOD(Clone)(THIS_
+                               struct IShaderResourceBinding** ppClone) PURE;
+
+    /// Returns the handle of the variable that can be used with IShaderResourceBinding::SetVariables()
+
+    /// \param [in] ShaderType - Type of the shader to look up the variable.
+    ///                          Must be one of Diligent::SHADER_TYPE.
+    /// \param [in] Name       - Variable name
+    ///
+    /// \return    The variable handle, or Diligent::INVALID_SHADER_VARIABLE_HANDLE if the variable
+    ///            is not found. Only mutable and dynamic variables have handles.
+    ///
+    /// \remark The handle is a compact value that identifies the variable in the pipeline
+    ///         resource layout rather than in this particular object, so it is the same for all shader
+    ///         resource binding objects created by the same pipeline state, and may be resolved once
+    ///         and reused for all of them.
+    VIRTUAL Uint32 METHOD(GetVariableHandle)(THIS_
+                                             SHADER_TYPE ShaderType,
+                                             const char* Name) PURE;
+
+    /// Binds resources to multiple variables identified by their handles
+
+    /// \param [in] pHandles     - Array of NumVariables variable handles returned by
+    ///                            IShaderResourceBinding::GetVariableHandle().
+    /// \param [in] ppObjects    - Array of NumVariables objects to bind.
+    /// \param [in] NumVariables - The number of variables to set.
+    ///
+    /// \remark The method is equivalent to calling IShaderResourceVariable::Set() for every variable,
+    ///         but avoids looking up the variables and dispatching the calls through the variable interface.
+    ///         Handles equal to Diligent::INVALID_SHADER_VARIABLE_HANDLE are ignored, so the handles
+    ///         of variables that are not present in the pipeline may be kept in the array.
+    VIRTUAL void METHOD(SetVariables)(THIS_
+                                      const Uint32*         pHandles,
+                                      IDeviceObject* const* ppObjects,
+                                      Uint32                NumVariables) PURE;
+
+    /// Creates a plan that binds resources from the resource mapping
+
+    /// \param [in]  ShaderFlags - Flags that specify shader stages, for which resources will be bound.
+    ///                            Any combination of Diligent::SHADER_TYPE may be used.
+    /// \param [in]  pResMapping - Shader resource mapping, where required resources will be looked up.
+    /// \param [in]  Flags       - Additional flags. See Diligent::BIND_SHADER_RESOURCES_FLAGS.
+    /// \param [out] ppPlan      - Address of the memory location where the pointer to the
+    ///                            plan interface will be written.
+    ///
+    /// \remarks The plan resolves every variable array element to the resource mapping entry once,
+    ///          so that IResourceBindingPlan::BindResources() is a plain walk over the precomputed
+    ///          entries. The plan may be used with all shader resource binding objects created by the same
+    ///          pipeline state, and is the preferred way to repeatedly bind resources from large mappings.
+    VIRTUAL void METHOD(CreateBindingPlan)(THIS_
+                                           Uint32                       ShaderFlags,
+                                           IResourceMapping*            pResMapping,
+                                           Uint32                       Flags,
+                                           struct IResourceBindingPlan** ppPlan) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -143,6 +213,10 @@ DILIGENT_END_INTERFACE
 #    define IShaderResourceBinding_GetVariableCount(This, ...)          CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableCount,          This, __VA_ARGS__)
 #    define IShaderResourceBinding_GetVariableByIndex(This, ...)        CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByIndex,        This, __VA_ARGS__)
 #    define IShaderResourceBinding_InitializeStaticResources(This, ...) CALL_IFACE_METHOD(ShaderResourceBinding, InitializeStaticResources, This, __VA_ARGS__)
+#    define IShaderResourceBinding_Clone(This, ...)                     CALL_IFACE_METHOD(ShaderResourceBinding, Clone,                     This, __VA_ARGS__)
+#    define IShaderResourceBinding_GetVariableHandle(This, ...)         CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableHandle,         This, __VA_ARGS__)
+#    define IShaderResourceBinding_SetVariables(This, ...)              CALL_IFACE_METHOD(ShaderResourceBinding, SetVariables,              This, __VA_ARGS__)
+#    define IShaderResourceBinding_CreateBindingPlan(This, ...)         CALL_IFACE_METHOD(ShaderResourceBinding, CreateBindingPlan,         This, __VA_ARGS__)
 
 // clang-format on
 
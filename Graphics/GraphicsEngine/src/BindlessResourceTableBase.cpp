@@ -0,0 +1,228 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "BindlessResourceTableBase.hpp"
+
+#include "TextureView.h"
+#include "BufferView.h"
+#include "Sampler.h"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+#define LOG_BINDLESS_TABLE_ERROR_AND_THROW(...) LOG_ERROR_AND_THROW("Description of bindless resource table '", (Desc.Name ? Desc.Name : ""), "' is invalid: ", ##__VA_ARGS__)
+
+void ValidateBindlessResourceTableDesc(const BindlessResourceTableDesc& Desc, const DeviceCaps& deviceCaps) noexcept(false)
+{
+    if (deviceCaps.Features.BindlessResources != DEVICE_FEATURE_STATE_ENABLED)
+        LOG_BINDLESS_TABLE_ERROR_AND_THROW("BindlessResources device feature is not enabled.");
+
+    Uint32 TotalSize = 0;
+    for (Uint32 t = 0; t < BINDLESS_RESOURCE_TYPE_COUNT; ++t)
+        TotalSize += GetBindlessTableArraySize(Desc, static_cast<BINDLESS_RESOURCE_TYPE>(t));
+
+    if (TotalSize == 0)
+        LOG_BINDLESS_TABLE_ERROR_AND_THROW("at least one descriptor array must have non-zero size.");
+
+    if (Desc.CommandQueueMask == 0)
+        LOG_BINDLESS_TABLE_ERROR_AND_THROW("command queue mask must not be zero.");
+}
+
+Uint32 GetBindlessTableArraySize(const BindlessResourceTableDesc& Desc, BINDLESS_RESOURCE_TYPE Type)
+{
+    static_assert(BINDLESS_RESOURCE_TYPE_COUNT == 5, "Please handle the new resource type below");
+    switch (Type)
+    {
+        // clang-format off
+        case BINDLESS_RESOURCE_TYPE_TEXTURE_SRV: return Desc.NumTextureSRVs;
+        case BINDLESS_RESOURCE_TYPE_TEXTURE_UAV: return Desc.NumTextureUAVs;
+        case BINDLESS_RESOURCE_TYPE_BUFFER_SRV:  return Desc.NumBufferSRVs;
+        case BINDLESS_RESOURCE_TYPE_BUFFER_UAV:  return Desc.NumBufferUAVs;
+        case BINDLESS_RESOURCE_TYPE_SAMPLER:     return Desc.NumSamplers;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected bindless resource type");
+            return 0;
+    }
+}
+
+BINDLESS_RESOURCE_TYPE GetBindlessResourceType(IDeviceObject* pObject)
+{
+    if (pObject == nullptr)
+        return BINDLESS_RESOURCE_TYPE_COUNT;
+
+    if (RefCntAutoPtr<ITextureView> pTexView{pObject, IID_TextureView})
+    {
+        switch (pTexView->GetDesc().ViewType)
+        {
+            // clang-format off
+            case TEXTURE_VIEW_SHADER_RESOURCE:  return BINDLESS_RESOURCE_TYPE_TEXTURE_SRV;
+            case TEXTURE_VIEW_UNORDERED_ACCESS: return BINDLESS_RESOURCE_TYPE_TEXTURE_UAV;
+            default:                            return BINDLESS_RESOURCE_TYPE_COUNT;
+            // clang-format on
+        }
+    }
+
+    if (RefCntAutoPtr<IBufferView> pBuffView{pObject, IID_BufferView})
+    {
+        // Formatted buffer views require texel buffer descriptors and are not supported.
+        // Dynamic buffers are suballocated from the dynamic heap every time they are mapped,
+        // so a descriptor written once can't reference them.
+        const auto& BuffDesc = pBuffView->GetBuffer()->GetDesc();
+        if ((BuffDesc.Mode != BUFFER_MODE_STRUCTURED && BuffDesc.Mode != BUFFER_MODE_RAW) || BuffDesc.Usage == USAGE_DYNAMIC)
+            return BINDLESS_RESOURCE_TYPE_COUNT;
+
+        switch (pBuffView->GetDesc().ViewType)
+        {
+            // clang-format off
+            case BUFFER_VIEW_SHADER_RESOURCE:  return BINDLESS_RESOURCE_TYPE_BUFFER_SRV;
+            case BUFFER_VIEW_UNORDERED_ACCESS: return BINDLESS_RESOURCE_TYPE_BUFFER_UAV;
+            default:                           return BINDLESS_RESOURCE_TYPE_COUNT;
+            // clang-format on
+        }
+    }
+
+    if (RefCntAutoPtr<ISampler> pSampler{pObject, IID_Sampler})
+        return BINDLESS_RESOURCE_TYPE_SAMPLER;
+
+    return BINDLESS_RESOURCE_TYPE_COUNT;
+}
+
+BINDLESS_RESOURCE_TYPE GetBindlessResourceType(SHADER_RESOURCE_TYPE ResourceType)
+{
+    static_assert(SHADER_RESOURCE_TYPE_LAST == SHADER_RESOURCE_TYPE_ACCEL_STRUCT, "Please handle the new resource type below");
+    switch (ResourceType)
+    {
+        // clang-format off
+        case SHADER_RESOURCE_TYPE_TEXTURE_SRV: return BINDLESS_RESOURCE_TYPE_TEXTURE_SRV;
+        case SHADER_RESOURCE_TYPE_TEXTURE_UAV: return BINDLESS_RESOURCE_TYPE_TEXTURE_UAV;
+        case SHADER_RESOURCE_TYPE_BUFFER_SRV:  return BINDLESS_RESOURCE_TYPE_BUFFER_SRV;
+        case SHADER_RESOURCE_TYPE_BUFFER_UAV:  return BINDLESS_RESOURCE_TYPE_BUFFER_UAV;
+        case SHADER_RESOURCE_TYPE_SAMPLER:     return BINDLESS_RESOURCE_TYPE_SAMPLER;
+        // clang-format on
+        default:
+            return BINDLESS_RESOURCE_TYPE_COUNT;
+    }
+}
+
+BINDLESS_RESOURCE_TYPE GetUnboundedArrayBindlessType(const IBindlessResourceTable* pTable,
+                                                     SHADER_RESOURCE_TYPE          ResourceType,
+                                                     const Char*                   ResourceName,
+                                                     const Char*                   ShaderName,
+                                                     const Char*                   PSOName) noexcept(false)
+{
+    if (pTable == nullptr)
+    {
+        LOG_ERROR_AND_THROW("Shader '", ShaderName, "' declares unbounded array '", ResourceName, "', but pipeline state '", PSOName,
+                            "' is created without a bindless resource table. Unbounded arrays can only be bound to bindless resource tables.");
+    }
+
+    const auto Type = GetBindlessResourceType(ResourceType);
+    if (Type == BINDLESS_RESOURCE_TYPE_COUNT)
+    {
+        LOG_ERROR_AND_THROW("Unbounded array '", ResourceName, "' in shader '", ShaderName, "' has type ", GetShaderResourceTypeLiteralName(ResourceType),
+                            " that can't be placed into a bindless resource table.");
+    }
+
+    const auto& TableDesc = pTable->GetDesc();
+    if (GetBindlessTableArraySize(TableDesc, Type) == 0)
+    {
+        LOG_ERROR_AND_THROW("Unbounded array '", ResourceName, "' in shader '", ShaderName, "' is bound to the ", GetBindlessResourceTypeString(Type),
+                            " array of bindless resource table '", TableDesc.Name, "', but the array size is zero.");
+    }
+
+    return Type;
+}
+
+const Char* GetBindlessResourceTypeString(BINDLESS_RESOURCE_TYPE Type)
+{
+    static_assert(BINDLESS_RESOURCE_TYPE_COUNT == 5, "Please handle the new resource type below");
+    switch (Type)
+    {
+        // clang-format off
+        case BINDLESS_RESOURCE_TYPE_TEXTURE_SRV: return "texture SRV";
+        case BINDLESS_RESOURCE_TYPE_TEXTURE_UAV: return "texture UAV";
+        case BINDLESS_RESOURCE_TYPE_BUFFER_SRV:  return "buffer SRV";
+        case BINDLESS_RESOURCE_TYPE_BUFFER_UAV:  return "buffer UAV";
+        case BINDLESS_RESOURCE_TYPE_SAMPLER:     return "sampler";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected bindless resource type");
+            return "unknown";
+    }
+}
+
+
+Uint32 BindlessHandleAllocator::Allocate(BINDLESS_RESOURCE_TYPE Type, Uint32 ArraySize)
+{
+    VERIFY_EXPR(Type < BINDLESS_RESOURCE_TYPE_COUNT);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto& FreeHandles = m_FreeHandles[Type];
+    if (!FreeHandles.empty())
+    {
+        const auto Handle = FreeHandles.back();
+        FreeHandles.pop_back();
+        return Handle;
+    }
+
+    if (m_NextHandle[Type] < ArraySize)
+        return m_NextHandle[Type]++;
+
+    return INVALID_BINDLESS_HANDLE;
+}
+
+void BindlessHandleAllocator::MarkPending(BINDLESS_RESOURCE_TYPE Type)
+{
+    VERIFY_EXPR(Type < BINDLESS_RESOURCE_TYPE_COUNT);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    ++m_NumPending[Type];
+}
+
+void BindlessHandleAllocator::Recycle(BINDLESS_RESOURCE_TYPE Type, Uint32 Handle)
+{
+    VERIFY_EXPR(Type < BINDLESS_RESOURCE_TYPE_COUNT);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    VERIFY(m_NumPending[Type] > 0, "Handle ", Handle, " has not been marked as pending");
+    VERIFY(Handle < m_NextHandle[Type], "Handle ", Handle, " has never been allocated");
+    --m_NumPending[Type];
+    m_FreeHandles[Type].push_back(Handle);
+}
+
+Uint32 BindlessHandleAllocator::GetNumPending(BINDLESS_RESOURCE_TYPE Type) const
+{
+    VERIFY_EXPR(Type < BINDLESS_RESOURCE_TYPE_COUNT);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_NumPending[Type];
+}
+
+} // namespace Diligent
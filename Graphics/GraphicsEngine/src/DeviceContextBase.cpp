@@ -136,6 +136,87 @@ bool VerifyDrawMeshIndirectAttribs(const DrawMeshIndirectAttribs& Attribs, const
     return true;
 }
 
+bool VerifyMultiDrawAttribs(const MultiDrawAttribs& Attribs)
+{
+#define CHECK_MULTI_DRAW_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Multi-draw attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_MULTI_DRAW_ATTRIBS(Attribs.DrawCount == 0 || Attribs.pDrawItems != nullptr, "pDrawItems must not be null when DrawCount (", Attribs.DrawCount, ") is not zero.");
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+        CHECK_MULTI_DRAW_ATTRIBS(Attribs.pDrawItems[i].NumVertices != 0, "NumVertices of draw item ", i, " must not be zero.");
+
+#undef CHECK_MULTI_DRAW_ATTRIBS
+
+    return true;
+}
+
+bool VerifyMultiDrawIndexedAttribs(const MultiDrawIndexedAttribs& Attribs)
+{
+#define CHECK_MULTI_DRAW_INDEXED_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Multi-draw indexed attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_MULTI_DRAW_INDEXED_ATTRIBS(Attribs.IndexType == VT_UINT16 || Attribs.IndexType == VT_UINT32,
+                                     "IndexType (", GetValueTypeString(Attribs.IndexType), ") must be VT_UINT16 or VT_UINT32.");
+    CHECK_MULTI_DRAW_INDEXED_ATTRIBS(Attribs.DrawCount == 0 || Attribs.pDrawItems != nullptr, "pDrawItems must not be null when DrawCount (", Attribs.DrawCount, ") is not zero.");
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+        CHECK_MULTI_DRAW_INDEXED_ATTRIBS(Attribs.pDrawItems[i].NumIndices != 0, "NumIndices of draw item ", i, " must not be zero.");
+
+#undef CHECK_MULTI_DRAW_INDEXED_ATTRIBS
+
+    return true;
+}
+
+// Indirect arguments are tightly packed, see IDeviceContext::DrawIndirect() and IDeviceContext::DrawIndexedIndirect()
+static constexpr Uint32 DrawIndirectArgsSize        = sizeof(Uint32) * 4;
+static constexpr Uint32 DrawIndexedIndirectArgsSize = sizeof(Uint32) * 5;
+
+static bool VerifyMultiDrawIndirectBuffers(const char*    CmdName,
+                                           Uint32         DrawCount,
+                                           Uint32         ArgsSize,
+                                           const IBuffer* pAttribsBuffer,
+                                           Uint32         IndirectDrawArgsOffset,
+                                           const IBuffer* pCountBuffer,
+                                           Uint32         CountBufferOffset)
+{
+#define CHECK_MULTI_DRAW_INDIRECT_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, CmdName, " attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_MULTI_DRAW_INDIRECT_ATTRIBS(pAttribsBuffer != nullptr, "indirect draw arguments buffer must not be null.");
+
+    const auto& ArgsBuffDesc = pAttribsBuffer->GetDesc();
+    CHECK_MULTI_DRAW_INDIRECT_ATTRIBS((ArgsBuffDesc.BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
+                                      "indirect draw arguments buffer '", ArgsBuffDesc.Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
+    CHECK_MULTI_DRAW_INDIRECT_ATTRIBS(Uint64{IndirectDrawArgsOffset} + Uint64{DrawCount} * ArgsSize <= ArgsBuffDesc.uiSizeInBytes,
+                                      "indirect draw arguments buffer '", ArgsBuffDesc.Name, "' is too small to hold ", DrawCount,
+                                      " draws starting at offset ", IndirectDrawArgsOffset, ".");
+
+    if (pCountBuffer != nullptr)
+    {
+        const auto& CountBuffDesc = pCountBuffer->GetDesc();
+        CHECK_MULTI_DRAW_INDIRECT_ATTRIBS((CountBuffDesc.BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
+                                          "count buffer '", CountBuffDesc.Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
+        CHECK_MULTI_DRAW_INDIRECT_ATTRIBS((CountBufferOffset % 4) == 0, "CountBufferOffset (", CountBufferOffset, ") must be a multiple of 4.");
+        CHECK_MULTI_DRAW_INDIRECT_ATTRIBS(Uint64{CountBufferOffset} + sizeof(Uint32) <= CountBuffDesc.uiSizeInBytes,
+                                          "CountBufferOffset (", CountBufferOffset, ") is out of bounds of count buffer '", CountBuffDesc.Name, "'.");
+    }
+
+#undef CHECK_MULTI_DRAW_INDIRECT_ATTRIBS
+
+    return true;
+}
+
+bool VerifyMultiDrawIndirectAttribs(const MultiDrawIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuffer)
+{
+    return VerifyMultiDrawIndirectBuffers("Multi-draw indirect", Attribs.DrawCount, DrawIndirectArgsSize,
+                                          pAttribsBuffer, Attribs.IndirectDrawArgsOffset, pCountBuffer, Attribs.CountBufferOffset);
+}
+
+bool VerifyMultiDrawIndexedIndirectAttribs(const MultiDrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuffer)
+{
+    CHECK_PARAMETER(Attribs.IndexType == VT_UINT16 || Attribs.IndexType == VT_UINT32,
+                    "Multi-draw indexed indirect attribs are invalid: IndexType (", GetValueTypeString(Attribs.IndexType), ") must be VT_UINT16 or VT_UINT32.");
+
+    return VerifyMultiDrawIndirectBuffers("Multi-draw indexed indirect", Attribs.DrawCount, DrawIndexedIndirectArgsSize,
+                                          pAttribsBuffer, Attribs.IndirectDrawArgsOffset, pCountBuffer, Attribs.CountBufferOffset);
+}
+
 
 bool VerifyDispatchComputeAttribs(const DispatchComputeAttribs& Attribs)
 {
@@ -0,0 +1,264 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "PipelineStateRegistryKey.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+#include "HashUtils.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+template <typename T>
+void PipelineStateRegistryKey::Write(const T& Val)
+{
+    // Structures may contain padding, so only scalar members are written
+    static_assert(std::is_scalar<T>::value, "Only scalar values can be written to the key");
+
+    const auto Offset = m_Data.size();
+    m_Data.resize(Offset + sizeof(Val));
+    memcpy(&m_Data[Offset], &Val, sizeof(Val));
+}
+
+void PipelineStateRegistryKey::WriteString(const Char* Str)
+{
+    // Null and empty strings are considered equal
+    const auto Len = Str != nullptr ? strlen(Str) : size_t{0};
+    Write(Len);
+    if (Len > 0)
+    {
+        const auto Offset = m_Data.size();
+        m_Data.resize(Offset + Len);
+        memcpy(&m_Data[Offset], Str, Len);
+    }
+}
+
+void PipelineStateRegistryKey::WriteShader(IShader* pShader, ShaderBytecodeIdFuncType GetShaderBytecodeId)
+{
+    if (pShader != nullptr)
+    {
+        auto BytecodeId = GetShaderBytecodeId(pShader);
+        VERIFY_EXPR(BytecodeId.pData);
+        Write(pShader->GetDesc().ShaderType);
+        Write(BytecodeId.Hash);
+        m_ShaderBytecodes.emplace_back(std::move(BytecodeId.pData));
+    }
+    else
+    {
+        Write(SHADER_TYPE_UNKNOWN);
+    }
+}
+
+void PipelineStateRegistryKey::WritePipelineDesc(const PipelineStateDesc& Desc)
+{
+    // The name is ignored
+    Write(Desc.PipelineType);
+    Write(Desc.SRBAllocationGranularity);
+    Write(Desc.SRBPoolSize);
+    Write(Desc.CommandQueueMask);
+
+    const auto& ResLayout = Desc.ResourceLayout;
+    Write(ResLayout.DefaultVariableType);
+
+    Write(ResLayout.NumVariables);
+    for (Uint32 i = 0; i < ResLayout.NumVariables; ++i)
+    {
+        const auto& Var = ResLayout.Variables[i];
+        Write(Var.ShaderStages);
+        WriteString(Var.Name);
+        Write(Var.Type);
+    }
+
+    Write(ResLayout.NumImmutableSamplers);
+    for (Uint32 i = 0; i < ResLayout.NumImmutableSamplers; ++i)
+    {
+        const auto& ImtblSam = ResLayout.ImmutableSamplers[i];
+        Write(ImtblSam.ShaderStages);
+        WriteString(ImtblSam.SamplerOrTextureName);
+
+        const auto& SamDesc = ImtblSam.Desc;
+        Write(SamDesc.MinFilter);
+        Write(SamDesc.MagFilter);
+        Write(SamDesc.MipFilter);
+        Write(SamDesc.AddressU);
+        Write(SamDesc.AddressV);
+        Write(SamDesc.AddressW);
+        Write(SamDesc.MipLODBias);
+        Write(SamDesc.MaxAnisotropy);
+        Write(SamDesc.ComparisonFunc);
+        for (size_t c = 0; c < _countof(SamDesc.BorderColor); ++c)
+            Write(SamDesc.BorderColor[c]);
+        Write(SamDesc.MinLOD);
+        Write(SamDesc.MaxLOD);
+    }
+}
+
+void PipelineStateRegistryKey::WriteGraphicsPipelineDesc(const GraphicsPipelineDesc& Desc)
+{
+    const auto& BSDesc = Desc.BlendDesc;
+    Write(BSDesc.AlphaToCoverageEnable);
+    Write(BSDesc.IndependentBlendEnable);
+    for (size_t rt = 0; rt < _countof(BSDesc.RenderTargets); ++rt)
+    {
+        const auto& RT = BSDesc.RenderTargets[rt];
+        Write(RT.BlendEnable);
+        Write(RT.LogicOperationEnable);
+        Write(RT.SrcBlend);
+        Write(RT.DestBlend);
+        Write(RT.BlendOp);
+        Write(RT.SrcBlendAlpha);
+        Write(RT.DestBlendAlpha);
+        Write(RT.BlendOpAlpha);
+        Write(RT.LogicOp);
+        Write(RT.RenderTargetWriteMask);
+    }
+
+    Write(Desc.SampleMask);
+
+    const auto& RSDesc = Desc.RasterizerDesc;
+    Write(RSDesc.FillMode);
+    Write(RSDesc.CullMode);
+    Write(RSDesc.FrontCounterClockwise);
+    Write(RSDesc.DepthClipEnable);
+    Write(RSDesc.ScissorEnable);
+    Write(RSDesc.AntialiasedLineEnable);
+    Write(RSDesc.DepthBias);
+    Write(RSDesc.DepthBiasClamp);
+    Write(RSDesc.SlopeScaledDepthBias);
+
+    const auto& DSSDesc = Desc.DepthStencilDesc;
+    Write(DSSDesc.DepthEnable);
+    Write(DSSDesc.DepthWriteEnable);
+    Write(DSSDesc.DepthFunc);
+    Write(DSSDesc.StencilEnable);
+    Write(DSSDesc.StencilReadMask);
+    Write(DSSDesc.StencilWriteMask);
+    for (const auto* pStOp : {&DSSDesc.FrontFace, &DSSDesc.BackFace})
+    {
+        Write(pStOp->StencilFailOp);
+        Write(pStOp->StencilDepthFailOp);
+        Write(pStOp->StencilPassOp);
+        Write(pStOp->StencilFunc);
+    }
+
+    const auto& InputLayout = Desc.InputLayout;
+    Write(InputLayout.NumElements);
+    for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+    {
+        const auto& Elem = InputLayout.LayoutElements[i];
+        WriteString(Elem.HLSLSemantic);
+        Write(Elem.InputIndex);
+        Write(Elem.BufferSlot);
+        Write(Elem.NumComponents);
+        Write(Elem.ValueType);
+        Write(Elem.IsNormalized);
+        Write(Elem.RelativeOffset);
+        Write(Elem.Stride);
+        Write(Elem.Frequency);
+        Write(Elem.InstanceDataStepRate);
+    }
+
+    Write(Desc.PrimitiveTopology);
+    Write(Desc.NumViewports);
+    Write(Desc.NumRenderTargets);
+    Write(Desc.SubpassIndex);
+    for (size_t rt = 0; rt < _countof(Desc.RTVFormats); ++rt)
+        Write(Desc.RTVFormats[rt]);
+    Write(Desc.DSVFormat);
+    Write(Desc.SmplDesc.Count);
+    Write(Desc.SmplDesc.Quality);
+    // Render pass is kept alive by the pipeline, so its address can't be reused while
+    // the pipeline is in the registry.
+    Write(Desc.pRenderPass);
+    Write(Desc.NodeMask);
+}
+
+void PipelineStateRegistryKey::WriteAsyncState(const PipelineStateCreateInfo& CreateInfo)
+{
+    // Asynchronous pipelines may still be compiling when they are returned, so they
+    // are never shared with synchronous ones.
+    const bool IsAsync = (CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0;
+    Write(IsAsync);
+    // The fallback pipeline is only used by asynchronous pipelines, which keep it alive.
+    if (IsAsync)
+        Write(CreateInfo.pAsyncFallbackPSO);
+}
+
+void PipelineStateRegistryKey::ComputeHash()
+{
+    m_Hash = ComputeHashRaw(m_Data.data(), m_Data.size());
+}
+
+PipelineStateRegistryKey::PipelineStateRegistryKey(const GraphicsPipelineStateCreateInfo& CreateInfo, ShaderBytecodeIdFuncType GetShaderBytecodeId)
+{
+    WritePipelineDesc(CreateInfo.PSODesc);
+    WriteGraphicsPipelineDesc(CreateInfo.GraphicsPipeline);
+    for (auto* pShader : {CreateInfo.pVS, CreateInfo.pPS, CreateInfo.pDS, CreateInfo.pHS, CreateInfo.pGS, CreateInfo.pAS, CreateInfo.pMS})
+        WriteShader(pShader, GetShaderBytecodeId);
+    // Bindless table is kept alive by the pipeline, the same way as the render pass.
+    Write(CreateInfo.pBindlessTable);
+    WriteAsyncState(CreateInfo);
+    ComputeHash();
+}
+
+PipelineStateRegistryKey::PipelineStateRegistryKey(const ComputePipelineStateCreateInfo& CreateInfo, ShaderBytecodeIdFuncType GetShaderBytecodeId)
+{
+    WritePipelineDesc(CreateInfo.PSODesc);
+    WriteShader(CreateInfo.pCS, GetShaderBytecodeId);
+    Write(CreateInfo.pBindlessTable);
+    WriteAsyncState(CreateInfo);
+    ComputeHash();
+}
+
+bool PipelineStateRegistryKey::operator==(const PipelineStateRegistryKey& rhs) const
+{
+    if (m_Hash != rhs.m_Hash || m_Data != rhs.m_Data)
+        return false;
+
+    // The data contains the types of all shaders, so both keys reference the same number of shaders
+    VERIFY_EXPR(m_ShaderBytecodes.size() == rhs.m_ShaderBytecodes.size());
+    for (size_t i = 0; i < m_ShaderBytecodes.size(); ++i)
+    {
+        const auto& pBytecode    = m_ShaderBytecodes[i];
+        const auto& pRHSBytecode = rhs.m_ShaderBytecodes[i];
+        if (pBytecode != pRHSBytecode && *pBytecode != *pRHSBytecode)
+            return false;
+    }
+
+    return true;
+}
+
+void PipelineStateRegistryKey::SetName(const Char* PSOName)
+{
+    m_pName = std::make_shared<const String>(PSOName != nullptr ? PSOName : "");
+    Name    = m_pName->c_str();
+}
+
+} // namespace Diligent
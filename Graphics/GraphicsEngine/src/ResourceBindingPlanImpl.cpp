@@ -0,0 +1,190 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ResourceBindingPlanImpl.hpp"
+
+#include <array>
+
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+ResourceBindingPlanImpl::ResourceBindingPlanImpl(IReferenceCounters*     pRefCounters,
+                                                 IShaderResourceBinding& SRB,
+                                                 const SHADER_TYPE*      pShaderStages,
+                                                 Uint32                  NumShaderStages,
+                                                 IResourceMapping&       ResMapping,
+                                                 Uint32                  Flags) :
+    // clang-format off
+    TObjectBase  {pRefCounters},
+    m_pPSO       {SRB.GetPipelineState()},
+    m_pResMapping{ValidatedCast<ResourceMappingImpl>(&ResMapping)},
+    m_Flags      {(Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) != 0 ? Flags : (Flags | BIND_SHADER_RESOURCES_UPDATE_ALL)}
+// clang-format on
+{
+    for (Uint32 s = 0; s < NumShaderStages; ++s)
+    {
+        const auto ShaderType = pShaderStages[s];
+        const auto NumVars    = SRB.GetVariableCount(ShaderType);
+        for (Uint32 v = 0; v < NumVars; ++v)
+        {
+            auto* pVar = SRB.GetVariableByIndex(ShaderType, v);
+            VERIFY_EXPR(pVar != nullptr);
+            if ((m_Flags & (1u << pVar->GetType())) == 0)
+                continue;
+
+            ShaderResourceDesc ResDesc;
+            pVar->GetResourceDesc(ResDesc);
+            if (ResDesc.ArraySize == 0)
+                continue;
+
+            VariableInfo Var;
+            Var.ShaderType = ShaderType;
+            Var.Index      = v;
+            Var.Handle     = SRB.GetVariableHandle(ShaderType, ResDesc.Name);
+            Var.ArraySize  = ResDesc.ArraySize;
+            Var.Name       = ResDesc.Name;
+            VERIFY(Var.Handle != INVALID_SHADER_VARIABLE_HANDLE, "Failed to get the handle of variable '", ResDesc.Name, "'");
+            m_Variables.emplace_back(std::move(Var));
+        }
+    }
+
+    {
+        auto LockHelper = m_pResMapping->Lock();
+        for (auto& Var : m_Variables)
+        {
+            Var.FirstSlot = static_cast<Uint32>(m_Slots.size());
+            for (Uint32 elem = 0; elem < Var.ArraySize; ++elem)
+                m_Slots.push_back(m_pResMapping->AddSlotReference(Var.Name.c_str(), elem));
+        }
+    }
+}
+
+ResourceBindingPlanImpl::~ResourceBindingPlanImpl()
+{
+    auto LockHelper = m_pResMapping->Lock();
+    for (auto SlotIndex : m_Slots)
+        m_pResMapping->ReleaseSlotReference(SlotIndex);
+}
+
+void ResourceBindingPlanImpl::LogUnresolvedResource(const VariableInfo& Var, Uint32 ArrayIndex) const
+{
+    if (Var.ArraySize > 1)
+    {
+        LOG_ERROR_MESSAGE("Unable to bind resource to shader variable '", Var.Name, '[', ArrayIndex, "]' in shader stage ",
+                          GetShaderTypeLiteralName(Var.ShaderType), ": resource is not found in the resource mapping");
+    }
+    else
+    {
+        LOG_ERROR_MESSAGE("Unable to bind resource to shader variable '", Var.Name, "' in shader stage ",
+                          GetShaderTypeLiteralName(Var.ShaderType), ": resource is not found in the resource mapping");
+    }
+}
+
+void ResourceBindingPlanImpl::BindResources(IShaderResourceBinding* pSRB)
+{
+    DEV_CHECK_ERR(pSRB != nullptr, "Shader resource binding must not be null");
+    if (pSRB == nullptr)
+        return;
+
+    DEV_CHECK_ERR(pSRB->GetPipelineState() == m_pPSO || pSRB->GetPipelineState()->IsCompatibleWith(m_pPSO),
+                  "Shader resource binding object is not compatible with the pipeline state '", m_pPSO->GetDesc().Name,
+                  "' that the resource binding plan was created for");
+
+    const bool KeepExisting      = (m_Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) != 0;
+    const bool VerifyAllResolved = (m_Flags & BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED) != 0;
+
+    // The lock keeps the objects alive until they are bound
+    auto LockHelper = m_pResMapping->Lock();
+
+    // Objects are collected in local batches, so that the plan may be used by multiple threads
+    static constexpr Uint32 MaxBatchSize = 32;
+
+    std::array<Uint32, MaxBatchSize>         Handles;
+    std::array<IDeviceObject*, MaxBatchSize> Objects;
+    std::array<IDeviceObject*, MaxBatchSize> ArrayElems;
+
+    Uint32 NumHandles = 0;
+    for (const auto& Var : m_Variables)
+    {
+        if (Var.ArraySize == 1 && !KeepExisting)
+        {
+            if (auto* pObject = m_pResMapping->GetSlotObject(m_Slots[Var.FirstSlot]))
+            {
+                Handles[NumHandles] = Var.Handle;
+                Objects[NumHandles] = pObject;
+                if (++NumHandles == MaxBatchSize)
+                {
+                    pSRB->SetVariables(Handles.data(), Objects.data(), NumHandles);
+                    NumHandles = 0;
+                }
+            }
+            else if (VerifyAllResolved && !pSRB->GetVariableByIndex(Var.ShaderType, Var.Index)->IsBound(0))
+            {
+                LogUnresolvedResource(Var, 0);
+            }
+            continue;
+        }
+
+        // Arrays and variables whose existing bindings must be preserved are set through the variable
+        auto* pVar = pSRB->GetVariableByIndex(Var.ShaderType, Var.Index);
+        VERIFY_EXPR(pVar != nullptr);
+
+        // Set every run of consecutive resolved elements with a single SetArray() call
+        Uint32 FirstElem = 0;
+        Uint32 NumElems  = 0;
+        for (Uint32 elem = 0; elem <= Var.ArraySize; ++elem)
+        {
+            IDeviceObject* pObject = nullptr;
+            if (elem < Var.ArraySize && !(KeepExisting && pVar->IsBound(elem)))
+            {
+                pObject = m_pResMapping->GetSlotObject(m_Slots[Var.FirstSlot + elem]);
+                if (pObject == nullptr && VerifyAllResolved && !pVar->IsBound(elem))
+                    LogUnresolvedResource(Var, elem);
+            }
+
+            if (pObject != nullptr)
+            {
+                if (NumElems == 0)
+                    FirstElem = elem;
+                ArrayElems[NumElems++] = pObject;
+            }
+
+            if (NumElems > 0 && (pObject == nullptr || NumElems == MaxBatchSize))
+            {
+                pVar->SetArray(ArrayElems.data(), FirstElem, NumElems);
+                NumElems = 0;
+            }
+        }
+    }
+
+    if (NumHandles > 0)
+        pSRB->SetVariables(Handles.data(), Objects.data(), NumHandles);
+}
+
+} // namespace Diligent
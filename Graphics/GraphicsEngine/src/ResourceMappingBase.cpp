@@ -40,6 +40,63 @@ ThreadingTools::LockHelper ResourceMappingImpl::Lock()
     return ThreadingTools::LockHelper(m_LockFlag);
 }
 
+Uint32 ResourceMappingImpl::FindOrCreateSlot(const Char* Name, Uint32 ArrayIndex)
+{
+    VERIFY(m_LockFlag == ThreadingTools::LockFlag::LOCK_FLAG_LOCKED, "The resource mapping must be locked");
+    // Try to find the existing slot first to avoid copying the name
+    auto It = m_HashTable.find(ResMappingHashKey{Name, false, ArrayIndex});
+    if (It != m_HashTable.end())
+        return It->second;
+
+    Uint32 SlotIndex = 0;
+    if (!m_FreeSlots.empty())
+    {
+        SlotIndex = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    }
+    else
+    {
+        SlotIndex = static_cast<Uint32>(m_Slots.size());
+        m_Slots.emplace_back();
+    }
+
+    auto NewIt = m_HashTable.emplace(ResMappingHashKey{Name, true /*Make copy*/, ArrayIndex}, SlotIndex).first;
+    // References to the elements of unordered_map are not invalidated by rehashing
+    m_Slots[SlotIndex].pKey = &NewIt->first;
+    return SlotIndex;
+}
+
+void ResourceMappingImpl::RecycleSlotIfUnused(Uint32 SlotIndex)
+{
+    auto& Slot = m_Slots[SlotIndex];
+    if (Slot.IsMapped || Slot.NumRefs > 0)
+        return;
+
+    VERIFY_EXPR(Slot.pKey != nullptr && !Slot.pObject);
+    auto It = m_HashTable.find(*Slot.pKey);
+    VERIFY_EXPR(It != m_HashTable.end() && It->second == SlotIndex);
+    m_HashTable.erase(It);
+    Slot.pKey = nullptr;
+    m_FreeSlots.push_back(SlotIndex);
+}
+
+Uint32 ResourceMappingImpl::AddSlotReference(const Char* Name, Uint32 ArrayIndex)
+{
+    const auto SlotIndex = FindOrCreateSlot(Name, ArrayIndex);
+    ++m_Slots[SlotIndex].NumRefs;
+    return SlotIndex;
+}
+
+void ResourceMappingImpl::ReleaseSlotReference(Uint32 SlotIndex)
+{
+    VERIFY(m_LockFlag == ThreadingTools::LockFlag::LOCK_FLAG_LOCKED, "The resource mapping must be locked");
+    VERIFY_EXPR(SlotIndex < m_Slots.size());
+    auto& Slot = m_Slots[SlotIndex];
+    VERIFY(Slot.NumRefs > 0, "The slot is not referenced");
+    --Slot.NumRefs;
+    RecycleSlotIfUnused(SlotIndex);
+}
+
 void ResourceMappingImpl::AddResourceArray(const Char* Name, Uint32 StartIndex, IDeviceObject* const* ppObjects, Uint32 NumElements, bool bIsUnique)
 {
     if (Name == nullptr || *Name == 0)
@@ -50,10 +107,14 @@ void ResourceMappingImpl::AddResourceArray(const Char* Name, Uint32 StartIndex,
     {
         auto* pObject = ppObjects[Elem];
 
-        // Try to construct new element in place
-        auto Elems = m_HashTable.emplace(ResMappingHashKey{Name, true /*Make copy*/, StartIndex + Elem}, pObject);
+        auto& Slot = m_Slots[FindOrCreateSlot(Name, StartIndex + Elem)];
+        if (!Slot.IsMapped)
+        {
+            Slot.IsMapped = true;
+            ++m_NumMappedResources;
+        }
         // If there is already element with the same name, replace it
-        if (!Elems.second && Elems.first->second != pObject)
+        else if (Slot.pObject != pObject)
         {
             if (bIsUnique)
             {
@@ -63,8 +124,8 @@ void ResourceMappingImpl::AddResourceArray(const Char* Name, Uint32 StartIndex,
                     " marked is unique, but already present in the hash.\n"
                     "New resource will be used\n.");
             }
-            Elems.first->second = pObject;
         }
+        Slot.pObject = pObject;
     }
 }
 
@@ -79,9 +140,21 @@ void ResourceMappingImpl::RemoveResourceByName(const Char* Name, Uint32 ArrayInd
         return;
 
     auto LockHelper = Lock();
-    // Remove object with the given name
-    // Name will be implicitly converted to HashMapStringKey without making a copy
-    m_HashTable.erase(ResMappingHashKey{Name, false, ArrayIndex});
+    // Name will be implicitly converted to HashMapStringKey without making a copy.
+    // The slot is kept in the table while it is referenced by resource binding plans.
+    auto It = m_HashTable.find(ResMappingHashKey{Name, false, ArrayIndex});
+    if (It != m_HashTable.end())
+    {
+        const auto SlotIndex = It->second;
+        auto&      Slot      = m_Slots[SlotIndex];
+        if (Slot.IsMapped)
+        {
+            Slot.pObject.Release();
+            Slot.IsMapped = false;
+            --m_NumMappedResources;
+            RecycleSlotIfUnused(SlotIndex);
+        }
+    }
 }
 
 void ResourceMappingImpl::GetResource(const Char* Name, IDeviceObject** ppResource, Uint32 ArrayIndex)
@@ -104,7 +177,7 @@ void ResourceMappingImpl::GetResource(const Char* Name, IDeviceObject** ppResour
     auto It = m_HashTable.find(ResMappingHashKey{Name, false, ArrayIndex});
     if (It != m_HashTable.end())
     {
-        *ppResource = It->second.RawPtr();
+        *ppResource = m_Slots[It->second].pObject.RawPtr();
         if (*ppResource)
             (*ppResource)->AddRef();
     }
@@ -112,7 +185,7 @@ void ResourceMappingImpl::GetResource(const Char* Name, IDeviceObject** ppResour
 
 size_t ResourceMappingImpl::GetSize()
 {
-    return m_HashTable.size();
+    return m_NumMappedResources;
 }
 
 } // namespace Diligent
@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderResourceBindingPool.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+ShaderResourceBindingPool::~ShaderResourceBindingPool()
+{
+    VERIFY(m_Available.empty() && m_Pending.empty(), "The pool must be cleared before it is destroyed");
+}
+
+IShaderResourceBinding* ShaderResourceBindingPool::Take()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    if (m_Available.empty())
+        return nullptr;
+
+    auto* pSRB = m_Available.back();
+    m_Available.pop_back();
+    return pSRB;
+}
+
+void ShaderResourceBindingPool::Add(IShaderResourceBinding* pSRB)
+{
+    VERIFY_EXPR(pSRB != nullptr);
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (!m_IsCleared && m_Available.size() + m_Pending.size() < m_MaxSize)
+        {
+            m_Available.push_back(pSRB);
+            return;
+        }
+    }
+    // Release the object outside of the lock
+    pSRB->Release();
+}
+
+bool ShaderResourceBindingPool::AddPending(IShaderResourceBinding* pSRB)
+{
+    VERIFY_EXPR(pSRB != nullptr);
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (!m_IsCleared && m_Available.size() + m_Pending.size() < m_MaxSize)
+        {
+            m_Pending.push_back(pSRB);
+            return true;
+        }
+    }
+    pSRB->Release();
+    return false;
+}
+
+void ShaderResourceBindingPool::MakeAvailable(IShaderResourceBinding* pSRB)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    if (m_IsCleared)
+        return; // The object has already been released by Clear()
+
+    // Stale objects are released in the order they were added, so the object
+    // is normally found at the beginning of the array.
+    auto it = std::find(m_Pending.begin(), m_Pending.end(), pSRB);
+    VERIFY(it != m_Pending.end(), "The object is not pending in this pool");
+    if (it == m_Pending.end())
+        return;
+
+    m_Pending.erase(it);
+    m_Available.push_back(pSRB);
+}
+
+void ShaderResourceBindingPool::Clear()
+{
+    std::vector<IShaderResourceBinding*> SRBs;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_IsCleared = true;
+
+        SRBs.swap(m_Available);
+        SRBs.insert(SRBs.end(), m_Pending.begin(), m_Pending.end());
+        m_Pending.clear();
+    }
+
+    for (auto* pSRB : SRBs)
+        pSRB->Release();
+}
+
+} // namespace Diligent
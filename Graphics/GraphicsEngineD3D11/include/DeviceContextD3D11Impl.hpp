@@ -37,6 +37,7 @@
 #include "BufferD3D11Impl.hpp"
 #include "TextureBaseD3D11.hpp"
 #include "PipelineStateD3D11Impl.hpp"
+#include "ShaderResourceBindingD3D11Impl.hpp"
 #include "QueryD3D11Impl.hpp"
 #include "FramebufferD3D11Impl.hpp"
 #include "RenderPassD3D11Impl.hpp"
@@ -53,15 +54,16 @@ namespace Diligent
 
 struct DeviceContextD3D11ImplTraits
 {
-    using BufferType        = BufferD3D11Impl;
-    using TextureType       = TextureBaseD3D11;
-    using PipelineStateType = PipelineStateD3D11Impl;
-    using DeviceType        = RenderDeviceD3D11Impl;
-    using QueryType         = QueryD3D11Impl;
-    using FramebufferType   = FramebufferD3D11Impl;
-    using RenderPassType    = RenderPassD3D11Impl;
-    using BottomLevelASType = BottomLevelASBase<IBottomLevelAS, RenderDeviceD3D11Impl>;
-    using TopLevelASType    = TopLevelASBase<ITopLevelAS, BottomLevelASType, RenderDeviceD3D11Impl>;
+    using BufferType                = BufferD3D11Impl;
+    using TextureType               = TextureBaseD3D11;
+    using PipelineStateType         = PipelineStateD3D11Impl;
+    using ShaderResourceBindingType = ShaderResourceBindingD3D11Impl;
+    using DeviceType                = RenderDeviceD3D11Impl;
+    using QueryType                 = QueryD3D11Impl;
+    using FramebufferType           = FramebufferD3D11Impl;
+    using RenderPassType            = RenderPassD3D11Impl;
+    using BottomLevelASType         = BottomLevelASBase<IBottomLevelAS, RenderDeviceD3D11Impl>;
+    using TopLevelASType            = TopLevelASBase<ITopLevelAS, BottomLevelASType, RenderDeviceD3D11Impl>;
 };
 
 /// Device context implementation in Direct3D11 backend.
@@ -151,6 +153,15 @@ public:
     /// Implementation of IDeviceContext::DrawMeshIndirect() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
 
+    /// Implementation of IDeviceContext::MultiDraw() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE MultiDraw(const MultiDrawAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexed() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndirect() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexedIndirect() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
+
     /// Implementation of IDeviceContext::DispatchCompute() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE DispatchCompute(const DispatchComputeAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DispatchComputeIndirect() in Direct3D11 backend.
@@ -74,6 +74,15 @@ public:
     /// Implementation of IShaderResourceBinding::InitializeStaticResources() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE InitializeStaticResources(const IPipelineState* pPipelineState) override final;
 
+    /// Implementation of IShaderResourceBinding::Clone() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE Clone(IShaderResourceBinding** ppClone) override final;
+
+    /// Implementation of IShaderResourceBinding::GetVariableHandle() in Direct3D11 backend.
+    virtual Uint32 DILIGENT_CALL_TYPE GetVariableHandle(SHADER_TYPE ShaderType, const char* Name) override final;
+
+    /// Implementation of IShaderResourceBinding::SetVariables() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE SetVariables(const Uint32* pHandles, IDeviceObject* const* ppObjects, Uint32 NumVariables) override final;
+
     ShaderResourceCacheD3D11& GetResourceCache(Uint32 Ind)
     {
         VERIFY_EXPR(Ind < m_NumActiveShaders);
@@ -99,7 +108,18 @@ public:
         return m_ShaderTypes[s];
     }
 
+    /// Returns the combined version of all resource caches, which changes every time a resource is modified.
+    Uint32 GetResourcesVersion() const
+    {
+        Uint32 Version = 0;
+        for (Uint32 s = 0; s < m_NumActiveShaders; ++s)
+            Version += m_pBoundResourceCaches[s].GetVersion();
+        return Version;
+    }
+
 private:
+    virtual void ResetResources() override final;
+
     void Destruct();
 
     // The caches are indexed by the shader order in the PSO, not shader index
@@ -30,6 +30,8 @@
 /// \file
 /// Declaration of Diligent::ShaderResourceCacheD3D11 class
 
+#include <atomic>
+
 #include "MemoryAllocator.h"
 #include "TextureBaseD3D11.hpp"
 #include "BufferD3D11Impl.hpp"
@@ -131,6 +133,12 @@ public:
     void Initialize(Uint32 CBCount, Uint32 SRVCount, Uint32 SamplerCount, Uint32 UAVCount, IMemoryAllocator& MemAllocator);
     void Destroy(IMemoryAllocator& MemAllocator);
 
+    /// Releases all resources in the cache
+    void ResetResources();
+
+    /// Copies all resources from the cache with identical layout
+    void CopyResources(const ShaderResourceCacheD3D11& SrcCache);
+
 
     __forceinline void SetCB(Uint32 Slot, RefCntAutoPtr<BufferD3D11Impl>&& pBuffD3D11Impl)
     {
@@ -299,6 +307,17 @@ public:
         return m_MemoryEndOffset != InvalidResourceOffset;
     }
 
+    /// Returns the version of the cache that is incremented every time a resource is modified
+    Uint32 GetVersion() const
+    {
+        return m_Version.load(std::memory_order_relaxed);
+    }
+
+    void IncrementVersion()
+    {
+        m_Version.fetch_add(1, std::memory_order_relaxed);
+    }
+
 private:
     template <typename TCachedResourceType, typename TGetResourceArraysFunc, typename TSrcResourceType, typename TD3D11ResourceType>
     __forceinline void SetD3D11ResourceInternal(Uint32 Slot, Uint32 Size, TGetResourceArraysFunc GetArrays, TSrcResourceType&& pResource, TD3D11ResourceType* pd3d11Resource)
@@ -311,6 +330,7 @@ private:
         (this->*GetArrays)(Resources, d3d11ResArr);
         Resources[Slot].Set(std::forward<TSrcResourceType>(pResource));
         d3d11ResArr[Slot] = pd3d11Resource;
+        IncrementVersion();
     }
 
     static constexpr const Uint16 InvalidResourceOffset = 0xFFFF;
@@ -327,6 +347,8 @@ private:
 
     Uint8* m_pResourceData = nullptr;
 
+    std::atomic<Uint32> m_Version{0};
+
 #ifdef DILIGENT_DEBUG
     IMemoryAllocator* m_pdbgMemoryAllocator = nullptr;
 #endif
@@ -270,6 +270,8 @@ public:
 
     IShaderResourceVariable*  GetShaderVariable(const Char* Name);
     IShaderResourceVariable*  GetShaderVariable(Uint32 Index);
+    /// Binds the object to the first element of the variable with the given index
+    void BindVariable(Uint32 Index, IDeviceObject* pObject);
     __forceinline SHADER_TYPE GetShaderType() const { return m_pResources->GetShaderType(); }
 
     IObject& GetOwner() { return m_Owner; }
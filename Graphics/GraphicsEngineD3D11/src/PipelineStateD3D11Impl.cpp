@@ -342,6 +342,15 @@ ID3D11InputLayout* PipelineStateD3D11Impl::GetD3D11InputLayout()
 
 void PipelineStateD3D11Impl::CreateShaderResourceBinding(IShaderResourceBinding** ppShaderResourceBinding, bool InitStaticResources)
 {
+    if (auto* pPooledSRB = TakeSRBFromPool<ShaderResourceBindingD3D11Impl>())
+    {
+        if (InitStaticResources)
+            pPooledSRB->InitializeStaticResources(nullptr);
+        // Transfer the reference held by the pool to the caller
+        *ppShaderResourceBinding = pPooledSRB;
+        return;
+    }
+
     auto& SRBAllocator      = GetDevice()->GetSRBAllocator();
     auto  pShaderResBinding = NEW_RC_OBJ(SRBAllocator, "ShaderResourceBindingD3D11Impl instance", ShaderResourceBindingD3D11Impl)(this, false);
     if (InitStaticResources)
@@ -104,6 +104,8 @@ RenderDeviceD3D11Impl::RenderDeviceD3D11Impl(IReferenceCounters*          pRefCo
             sizeof(FramebufferD3D11Impl),
             0,
             0,
+            0,
+            0,
             0
         }
     },
@@ -111,7 +113,7 @@ RenderDeviceD3D11Impl::RenderDeviceD3D11Impl(IReferenceCounters*          pRefCo
     m_pd3d11Device {pd3d11Device }
 // clang-format on
 {
-    static_assert(sizeof(DeviceObjectSizes) == sizeof(size_t) * 15, "Please add new objects to DeviceObjectSizes constructor");
+    static_assert(sizeof(DeviceObjectSizes) == sizeof(size_t) * 17, "Please add new objects to DeviceObjectSizes constructor");
 
     m_DeviceCaps.DevType = RENDER_DEVICE_TYPE_D3D11;
     auto FeatureLevel    = m_pd3d11Device->GetFeatureLevel();
@@ -178,11 +180,14 @@ RenderDeviceD3D11Impl::RenderDeviceD3D11Impl(IReferenceCounters*          pRefCo
     UNSUPPORTED_FEATURE(ShaderInt8,               "Native 8-bit shader operations are");
     UNSUPPORTED_FEATURE(ResourceBuffer8BitAccess, "8-bit native access to resource buffers is");
     UNSUPPORTED_FEATURE(UniformBuffer8BitAccess,  "8-bit native access to uniform buffers is");
+
+    // Direct3D11 has no way to source the number of indirect draws from a GPU buffer
+    UNSUPPORTED_FEATURE(DrawIndirectCount,        "Indirect draw count is");
     // clang-format on
 #undef UNSUPPORTED_FEATURE
 
 #if defined(_MSC_VER) && defined(_WIN64)
-    static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+    static_assert(sizeof(DeviceFeatures) == 33, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 
     auto& TexCaps = m_DeviceCaps.TexCaps;
@@ -397,9 +402,14 @@ void RenderDeviceD3D11Impl::CreatePipelineState(const PSOCreateInfoType& PSOCrea
     CreateDeviceObject("Pipeline state", PSOCreateInfo.PSODesc, ppPipelineState,
                        [&]() //
                        {
+                           PipelineStateRegistryKey RegistryKey;
+                           if (FindSharedPipelineState<ShaderD3D11Impl>(PSOCreateInfo, RegistryKey, ppPipelineState))
+                               return;
+
                            PipelineStateD3D11Impl* pPipelineStateD3D11{NEW_RC_OBJ(m_PSOAllocator, "PipelineStateD3D11Impl instance", PipelineStateD3D11Impl)(this, PSOCreateInfo)};
                            pPipelineStateD3D11->QueryInterface(IID_PipelineState, reinterpret_cast<IObject**>(ppPipelineState));
                            OnCreateDeviceObject(pPipelineStateD3D11);
+                           AddSharedPipelineState(RegistryKey, *ppPipelineState);
                        });
 }
 
@@ -485,6 +495,21 @@ void RenderDeviceD3D11Impl::CreateSBT(const ShaderBindingTableDesc& Desc,
     *ppSBT = nullptr;
 }
 
+void RenderDeviceD3D11Impl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                     IPipelineStateCache**               ppPSOCache)
+{
+    // Pipeline state caches are not supported in DirectX 11, so pipelines are always created without one.
+    *ppPSOCache = nullptr;
+}
+
+void RenderDeviceD3D11Impl::CreateBindlessResourceTable(const BindlessResourceTableDesc& Desc,
+                                                        IBindlessResourceTable**         ppBindlessTable)
+{
+    // Direct3D11 does not support descriptor indexing.
+    LOG_ERROR_MESSAGE("Bindless resource tables are not supported in Direct3D11 backend");
+    *ppBindlessTable = nullptr;
+}
+
 void RenderDeviceD3D11Impl::IdleGPU()
 {
     if (auto pImmediateCtx = m_wpImmediateContext.Lock())
@@ -214,6 +214,32 @@ void ShaderResourceBindingD3D11Impl::InitializeStaticResources(const IPipelineSt
     m_bIsStaticResourcesBound = true;
 }
 
+void ShaderResourceBindingD3D11Impl::Clone(IShaderResourceBinding** ppClone)
+{
+    DEV_CHECK_ERR(ppClone != nullptr, "Pointer to the clone must not be null");
+
+    RefCntAutoPtr<IShaderResourceBinding> pClone;
+    m_pPSO->CreateShaderResourceBinding(&pClone, false);
+    if (!pClone)
+        return;
+
+    auto* pCloneD3D11 = pClone.RawPtr<ShaderResourceBindingD3D11Impl>();
+    VERIFY_EXPR(pCloneD3D11->m_NumActiveShaders == m_NumActiveShaders);
+    for (Uint32 s = 0; s < m_NumActiveShaders; ++s)
+        pCloneD3D11->m_pBoundResourceCaches[s].CopyResources(m_pBoundResourceCaches[s]);
+    pCloneD3D11->m_bIsStaticResourcesBound = m_bIsStaticResourcesBound;
+
+    *ppClone = pClone.Detach();
+}
+
+void ShaderResourceBindingD3D11Impl::ResetResources()
+{
+    // Immutable samplers are set again by InitializeStaticResources()
+    for (Uint32 s = 0; s < m_NumActiveShaders; ++s)
+        m_pBoundResourceCaches[s].ResetResources();
+    m_bIsStaticResourcesBound = false;
+}
+
 IShaderResourceVariable* ShaderResourceBindingD3D11Impl::GetVariableByName(SHADER_TYPE ShaderType, const char* Name)
 {
     auto ResLayoutInd = GetVariableByNameHelper(ShaderType, Name, m_ResourceLayoutIndex);
@@ -244,4 +270,24 @@ IShaderResourceVariable* ShaderResourceBindingD3D11Impl::GetVariableByIndex(SHAD
     return m_pResourceLayouts[ResLayoutInd].GetShaderVariable(Index);
 }
 
+Uint32 ShaderResourceBindingD3D11Impl::GetVariableHandle(SHADER_TYPE ShaderType, const char* Name)
+{
+    auto ResLayoutInd = GetVariableByNameHelper(ShaderType, Name, m_ResourceLayoutIndex);
+    if (ResLayoutInd < 0)
+        return INVALID_SHADER_VARIABLE_HANDLE;
+
+    VERIFY_EXPR(static_cast<Uint32>(ResLayoutInd) < Uint32{m_NumActiveShaders});
+    auto* pVar = m_pResourceLayouts[ResLayoutInd].GetShaderVariable(Name);
+    return pVar != nullptr ? PackVariableHandle(ResLayoutInd, pVar->GetIndex()) : INVALID_SHADER_VARIABLE_HANDLE;
+}
+
+void ShaderResourceBindingD3D11Impl::SetVariables(const Uint32* pHandles, IDeviceObject* const* ppObjects, Uint32 NumVariables)
+{
+    SetVariablesHelper(pHandles, ppObjects, NumVariables, m_NumActiveShaders,
+                       [this](Uint32 ResLayoutInd, Uint32 VarIndex, IDeviceObject* pObject) //
+                       {
+                           m_pResourceLayouts[ResLayoutInd].BindVariable(VarIndex, pObject);
+                       });
+}
+
 } // namespace Diligent
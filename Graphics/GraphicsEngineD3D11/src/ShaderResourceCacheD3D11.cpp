@@ -209,6 +209,113 @@ ShaderResourceCacheD3D11::~ShaderResourceCacheD3D11()
     VERIFY(!IsInitialized(), "Shader resource cache memory must be released with ShaderResourceCacheD3D11::Destroy()");
 }
 
+namespace
+{
+
+template <typename TCachedResourceType, typename TD3D11ResourceType>
+void ResetResourceArrays(TCachedResourceType* Resources, TD3D11ResourceType** d3d11Resources, Uint32 Count)
+{
+    for (Uint32 res = 0; res < Count; ++res)
+    {
+        Resources[res]      = TCachedResourceType{};
+        d3d11Resources[res] = nullptr;
+    }
+}
+
+template <typename TCachedResourceType, typename TD3D11ResourceType>
+void CopyResourceArrays(const TCachedResourceType* SrcResources,
+                        TD3D11ResourceType* const* Srcd3d11Resources,
+                        TCachedResourceType*       DstResources,
+                        TD3D11ResourceType**       Dstd3d11Resources,
+                        Uint32                     Count)
+{
+    for (Uint32 res = 0; res < Count; ++res)
+    {
+        DstResources[res]      = SrcResources[res];
+        Dstd3d11Resources[res] = Srcd3d11Resources[res];
+    }
+}
+
+} // namespace
+
+void ShaderResourceCacheD3D11::ResetResources()
+{
+    if (!IsInitialized())
+        return;
+
+    CachedCB*      CBs      = nullptr;
+    ID3D11Buffer** d3d11CBs = nullptr;
+    GetCBArrays(CBs, d3d11CBs);
+    ResetResourceArrays(CBs, d3d11CBs, GetCBCount());
+
+    CachedResource*            SRVResources = nullptr;
+    ID3D11ShaderResourceView** d3d11SRVs    = nullptr;
+    GetSRVArrays(SRVResources, d3d11SRVs);
+    ResetResourceArrays(SRVResources, d3d11SRVs, GetSRVCount());
+
+    CachedSampler*       Samplers      = nullptr;
+    ID3D11SamplerState** d3d11Samplers = nullptr;
+    GetSamplerArrays(Samplers, d3d11Samplers);
+    ResetResourceArrays(Samplers, d3d11Samplers, GetSamplerCount());
+
+    CachedResource*             UAVResources = nullptr;
+    ID3D11UnorderedAccessView** d3d11UAVs    = nullptr;
+    GetUAVArrays(UAVResources, d3d11UAVs);
+    ResetResourceArrays(UAVResources, d3d11UAVs, GetUAVCount());
+
+    IncrementVersion();
+}
+
+void ShaderResourceCacheD3D11::CopyResources(const ShaderResourceCacheD3D11& SrcCache)
+{
+    // clang-format off
+    VERIFY(GetCBCount()      == SrcCache.GetCBCount()      &&
+           GetSRVCount()     == SrcCache.GetSRVCount()     &&
+           GetSamplerCount() == SrcCache.GetSamplerCount() &&
+           GetUAVCount()     == SrcCache.GetUAVCount(),
+           "Inconsistent cache layouts");
+    // clang-format on
+    if (!IsInitialized())
+        return;
+
+    // Resource arrays are only accessed for reading
+    auto& Src = const_cast<ShaderResourceCacheD3D11&>(SrcCache);
+
+    CachedCB*      SrcCBs      = nullptr;
+    ID3D11Buffer** Srcd3d11CBs = nullptr;
+    CachedCB*      DstCBs      = nullptr;
+    ID3D11Buffer** Dstd3d11CBs = nullptr;
+    Src.GetCBArrays(SrcCBs, Srcd3d11CBs);
+    GetCBArrays(DstCBs, Dstd3d11CBs);
+    CopyResourceArrays(SrcCBs, Srcd3d11CBs, DstCBs, Dstd3d11CBs, GetCBCount());
+
+    CachedResource*            SrcSRVs      = nullptr;
+    ID3D11ShaderResourceView** Srcd3d11SRVs = nullptr;
+    CachedResource*            DstSRVs      = nullptr;
+    ID3D11ShaderResourceView** Dstd3d11SRVs = nullptr;
+    Src.GetSRVArrays(SrcSRVs, Srcd3d11SRVs);
+    GetSRVArrays(DstSRVs, Dstd3d11SRVs);
+    CopyResourceArrays(SrcSRVs, Srcd3d11SRVs, DstSRVs, Dstd3d11SRVs, GetSRVCount());
+
+    CachedSampler*       SrcSamplers      = nullptr;
+    ID3D11SamplerState** Srcd3d11Samplers = nullptr;
+    CachedSampler*       DstSamplers      = nullptr;
+    ID3D11SamplerState** Dstd3d11Samplers = nullptr;
+    Src.GetSamplerArrays(SrcSamplers, Srcd3d11Samplers);
+    GetSamplerArrays(DstSamplers, Dstd3d11Samplers);
+    CopyResourceArrays(SrcSamplers, Srcd3d11Samplers, DstSamplers, Dstd3d11Samplers, GetSamplerCount());
+
+    CachedResource*             SrcUAVs      = nullptr;
+    ID3D11UnorderedAccessView** Srcd3d11UAVs = nullptr;
+    CachedResource*             DstUAVs      = nullptr;
+    ID3D11UnorderedAccessView** Dstd3d11UAVs = nullptr;
+    Src.GetUAVArrays(SrcUAVs, Srcd3d11UAVs);
+    GetUAVArrays(DstUAVs, Dstd3d11UAVs);
+    CopyResourceArrays(SrcUAVs, Srcd3d11UAVs, DstUAVs, Dstd3d11UAVs, GetUAVCount());
+
+    IncrementVersion();
+}
+
 void dbgVerifyResource(ShaderResourceCacheD3D11::CachedResource& Res, ID3D11View* pd3d11View, const char* ViewType)
 {
     if (pd3d11View != nullptr)
@@ -420,6 +420,8 @@ void ShaderResourceLayoutD3D11::CopyResources(ShaderResourceCacheD3D11& DstCache
                 DstD3D11Samplers[SamSlot] = d3d11Samplers[SamSlot];
             }
         });
+
+    DstCache.IncrementVersion();
 }
 
 void ShaderResourceLayoutD3D11::ConstBuffBindInfo::BindResource(IDeviceObject* pBuffer,
@@ -836,7 +838,7 @@ public:
     }
 
     template <typename ResourceType>
-    IShaderResourceVariable* TryResource()
+    ResourceType* TryResource()
     {
 #ifdef DILIGENT_DEBUG
         {
@@ -892,6 +894,35 @@ IShaderResourceVariable* ShaderResourceLayoutD3D11::GetShaderVariable(Uint32 Ind
     return nullptr;
 }
 
+void ShaderResourceLayoutD3D11::BindVariable(Uint32 Index, IDeviceObject* pObject)
+{
+    // Call the type-specific methods directly rather than through IShaderResourceVariable::Set()
+    ShaderVariableLocator VarLocator(*this, Index);
+
+    if (auto* pCB = VarLocator.TryResource<ConstBuffBindInfo>())
+        return pCB->BindResource(pObject, 0);
+
+    if (auto* pTexSRV = VarLocator.TryResource<TexSRVBindInfo>())
+        return pTexSRV->BindResource(pObject, 0);
+
+    if (auto* pTexUAV = VarLocator.TryResource<TexUAVBindInfo>())
+        return pTexUAV->BindResource(pObject, 0);
+
+    if (auto* pBuffSRV = VarLocator.TryResource<BuffSRVBindInfo>())
+        return pBuffSRV->BindResource(pObject, 0);
+
+    if (auto* pBuffUAV = VarLocator.TryResource<BuffUAVBindInfo>())
+        return pBuffUAV->BindResource(pObject, 0);
+
+    if (!m_pResources->IsUsingCombinedTextureSamplers())
+    {
+        if (auto* pSampler = VarLocator.TryResource<SamplerBindInfo>())
+            return pSampler->BindResource(pObject, 0);
+    }
+
+    LOG_ERROR(Index, " is not a valid variable index. Total resource count: ", GetTotalResourceCount());
+}
+
 
 #ifdef DILIGENT_DEVELOPMENT
 bool ShaderResourceLayoutD3D11::dvpVerifyBindings() const
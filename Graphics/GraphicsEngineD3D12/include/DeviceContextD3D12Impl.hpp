@@ -41,6 +41,7 @@
 #include "FramebufferD3D12Impl.hpp"
 #include "RenderPassD3D12Impl.hpp"
 #include "PipelineStateD3D12Impl.hpp"
+#include "ShaderResourceBindingD3D12Impl.hpp"
 #include "D3D12DynamicHeap.hpp"
 #include "BottomLevelASD3D12Impl.hpp"
 #include "TopLevelASD3D12Impl.hpp"
@@ -50,16 +51,17 @@ namespace Diligent
 
 struct DeviceContextD3D12ImplTraits
 {
-    using BufferType        = BufferD3D12Impl;
-    using TextureType       = TextureD3D12Impl;
-    using PipelineStateType = PipelineStateD3D12Impl;
-    using DeviceType        = RenderDeviceD3D12Impl;
-    using ICommandQueueType = ICommandQueueD3D12;
-    using QueryType         = QueryD3D12Impl;
-    using FramebufferType   = FramebufferD3D12Impl;
-    using RenderPassType    = RenderPassD3D12Impl;
-    using BottomLevelASType = BottomLevelASD3D12Impl;
-    using TopLevelASType    = TopLevelASD3D12Impl;
+    using BufferType                = BufferD3D12Impl;
+    using TextureType               = TextureD3D12Impl;
+    using PipelineStateType         = PipelineStateD3D12Impl;
+    using ShaderResourceBindingType = ShaderResourceBindingD3D12Impl;
+    using DeviceType                = RenderDeviceD3D12Impl;
+    using ICommandQueueType         = ICommandQueueD3D12;
+    using QueryType                 = QueryD3D12Impl;
+    using FramebufferType           = FramebufferD3D12Impl;
+    using RenderPassType            = RenderPassD3D12Impl;
+    using BottomLevelASType         = BottomLevelASD3D12Impl;
+    using TopLevelASType            = TopLevelASD3D12Impl;
 };
 
 /// Device context implementation in Direct3D12 backend.
@@ -151,6 +153,15 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawMesh           (const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE DrawMeshIndirect   (const DrawMeshIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+
+    /// Implementation of IDeviceContext::MultiDraw() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE MultiDraw               (const MultiDrawAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexed() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexed        (const MultiDrawIndexedAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndirect() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndirect       (const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexedIndirect() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
     
 
     /// Implementation of IDeviceContext::DispatchCompute() in Direct3D12 backend.
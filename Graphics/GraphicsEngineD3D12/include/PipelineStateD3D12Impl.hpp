@@ -124,6 +124,9 @@ public:
         return m_SRBMemAllocator;
     }
 
+    // Hides PipelineStateBase::RecycleShaderResourceBinding() as the SRB may still be used by the GPU
+    void RecycleShaderResourceBinding(IShaderResourceBinding* pSRB);
+
 private:
     struct ShaderStageInfo
     {
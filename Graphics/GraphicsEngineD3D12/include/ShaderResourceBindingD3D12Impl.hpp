@@ -66,8 +66,17 @@ public:
 
     virtual void DILIGENT_CALL_TYPE InitializeStaticResources(const IPipelineState* pPipelineState) override final;
 
+    virtual void DILIGENT_CALL_TYPE Clone(IShaderResourceBinding** ppClone) override final;
+
+    virtual Uint32 DILIGENT_CALL_TYPE GetVariableHandle(SHADER_TYPE ShaderType, const char* Name) override final;
+
+    virtual void DILIGENT_CALL_TYPE SetVariables(const Uint32* pHandles, IDeviceObject* const* ppObjects, Uint32 NumVariables) override final;
+
     ShaderResourceCacheD3D12& GetResourceCache() { return m_ShaderResourceCache; }
 
+    // Returns the version of the resource cache, which changes every time a resource is modified
+    Uint32 GetResourcesVersion() const { return m_ShaderResourceCache.GetVersion(); }
+
 #ifdef DILIGENT_DEVELOPMENT
     void dvpVerifyResourceBindings(const PipelineStateD3D12Impl* pPSO) const;
 #endif
@@ -78,6 +87,8 @@ public:
     }
 
 private:
+    virtual void ResetResources() override final;
+
     void Destruct();
 
     ShaderResourceCacheD3D12    m_ShaderResourceCache;
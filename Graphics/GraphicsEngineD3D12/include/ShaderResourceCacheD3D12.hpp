@@ -83,6 +83,8 @@
 //                 .....       |   DescrptHndl[0]  ...  DescrptHndl[n-1]   |    ....
 //
 
+#include <atomic>
+
 #include "DescriptorHeap.hpp"
 
 namespace Diligent
@@ -320,6 +322,17 @@ public:
     // Returns the number of dynamic constant buffers bound in the cache regardless of their variable types
     Uint32 GetNumDynamicCBsBound() const { return m_NumDynamicCBsBound; }
 
+    // Returns the version of the cache that is incremented every time a resource is modified
+    Uint32 GetVersion() const { return m_Version.load(std::memory_order_relaxed); }
+    void   IncrementVersion() { m_Version.fetch_add(1, std::memory_order_relaxed); }
+
+    // Releases all resources in the cache. Descriptors in the GPU-visible heaps are not modified.
+    void ResetResources();
+
+    // Copies all resources from the cache with identical layout, as well as the descriptors
+    // of the bound resources in the GPU-visible heaps.
+    void CopyResources(ID3D12Device* pd3d12Device, const ShaderResourceCacheD3D12& SrcCache);
+
 #ifdef DILIGENT_DEBUG
     // Only for debug purposes: indicates what types of resources are stored in the cache
     DbgCacheContentType DbgGetContentType() const { return m_DbgContentType; }
@@ -346,6 +359,8 @@ private:
     // The number of the dynamic buffers bound in the resource cache regardless of their variable type
     Uint32 m_NumDynamicCBsBound = 0;
 
+    std::atomic<Uint32> m_Version{0};
+
 #ifdef DILIGENT_DEBUG
     // Only for debug purposes: indicates what types of resources are stored in the cache
     const DbgCacheContentType m_DbgContentType;
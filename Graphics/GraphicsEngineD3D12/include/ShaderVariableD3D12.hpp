@@ -93,6 +93,9 @@ public:
     ShaderVariableD3D12Impl* GetVariable(const Char* Name);
     ShaderVariableD3D12Impl* GetVariable(Uint32 Index);
 
+    /// Binds the object to the first element of the variable with the given index
+    void BindVariable(Uint32 Index, IDeviceObject* pObject);
+
     void BindResources(IResourceMapping* pResourceMapping, Uint32 Flags);
 
     static size_t GetRequiredMemorySize(const ShaderResourceLayoutD3D12&     Layout,
@@ -223,4 +226,15 @@ private:
     const ShaderResourceLayoutD3D12::D3D12Resource& m_Resource;
 };
 
+inline void ShaderVariableManagerD3D12::BindVariable(Uint32 Index, IDeviceObject* pObject)
+{
+    // The index comes from a variable handle provided by the application, so it is always validated
+    if (Index >= m_NumVariables)
+    {
+        LOG_ERROR("Index ", Index, " is out of range");
+        return;
+    }
+    m_pVariables[Index].m_Resource.BindResource(pObject, 0, m_ResourceCache);
+}
+
 } // namespace Diligent
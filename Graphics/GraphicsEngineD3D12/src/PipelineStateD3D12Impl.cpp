@@ -868,6 +868,15 @@ void PipelineStateD3D12Impl::InitResourceLayouts(const PipelineStateCreateInfo&
 
 void PipelineStateD3D12Impl::CreateShaderResourceBinding(IShaderResourceBinding** ppShaderResourceBinding, bool InitStaticResources)
 {
+    if (auto* pPooledSRB = TakeSRBFromPool<ShaderResourceBindingD3D12Impl>())
+    {
+        if (InitStaticResources)
+            pPooledSRB->InitializeStaticResources(nullptr);
+        // Transfer the reference held by the pool to the caller
+        *ppShaderResourceBinding = pPooledSRB;
+        return;
+    }
+
     auto& SRBAllocator     = m_pDevice->GetSRBAllocator();
     auto* pResBindingD3D12 = NEW_RC_OBJ(SRBAllocator, "ShaderResourceBindingD3D12Impl instance", ShaderResourceBindingD3D12Impl)(this, false);
     if (InitStaticResources)
@@ -875,6 +884,15 @@ void PipelineStateD3D12Impl::CreateShaderResourceBinding(IShaderResourceBinding*
     pResBindingD3D12->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(ppShaderResourceBinding));
 }
 
+void PipelineStateD3D12Impl::RecycleShaderResourceBinding(IShaderResourceBinding* pSRB)
+{
+    VERIFY_EXPR(m_pSRBPool);
+    // Descriptors of the SRB in the GPU-visible heaps may be referenced by command lists that
+    // have not completed yet, so the SRB only becomes available once the release queues are purged.
+    if (m_pSRBPool->AddPending(pSRB))
+        m_pDevice->SafeReleaseDeviceObject(ShaderResourceBindingPool::StaleObject{m_pSRBPool, pSRB}, m_Desc.CommandQueueMask);
+}
+
 bool PipelineStateD3D12Impl::IsCompatibleWith(const IPipelineState* pPSO) const
 {
     VERIFY_EXPR(pPSO != nullptr);
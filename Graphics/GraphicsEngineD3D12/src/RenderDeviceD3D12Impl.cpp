@@ -138,7 +138,9 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
             sizeof(FramebufferD3D12Impl),
             sizeof(BottomLevelASD3D12Impl),
             sizeof(TopLevelASD3D12Impl),
-            sizeof(ShaderBindingTableD3D12Impl)
+            sizeof(ShaderBindingTableD3D12Impl),
+            0,
+            0
         }
     },
     m_pd3d12Device  {pd3d12Device},
@@ -163,7 +165,7 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
     m_pDxCompiler         {CreateDXCompiler(DXCompilerTarget::Direct3D12, EngineCI.pDxCompilerPath)}
 // clang-format on
 {
-    static_assert(sizeof(DeviceObjectSizes) == sizeof(size_t) * 15, "Please add new objects to DeviceObjectSizes constructor");
+    static_assert(sizeof(DeviceObjectSizes) == sizeof(size_t) * 17, "Please add new objects to DeviceObjectSizes constructor");
 
     // set device properties
     {
@@ -326,11 +328,17 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
         CHECK_REQUIRED_FEATURE(UniformBuffer8BitAccess,  "8-bit uniform buffer access is");
 
         CHECK_REQUIRED_FEATURE(RayTracing,               "ray tracing is");
+
         // clang-format on
 #undef CHECK_REQUIRED_FEATURE
 
+        // ExecuteIndirect always accepts a count buffer, so the feature is only disabled when requested
+        m_DeviceCaps.Features.DrawIndirectCount = EngineCI.Features.DrawIndirectCount != DEVICE_FEATURE_STATE_DISABLED ?
+            DEVICE_FEATURE_STATE_ENABLED :
+            DEVICE_FEATURE_STATE_DISABLED;
+
 #if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+        static_assert(sizeof(DeviceFeatures) == 33, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 
         auto& TexCaps = m_DeviceCaps.TexCaps;
@@ -570,9 +578,14 @@ void RenderDeviceD3D12Impl::CreatePipelineState(const PSOCreateInfoType& PSOCrea
     CreateDeviceObject("Pipeline State", PSOCreateInfo.PSODesc, ppPipelineState,
                        [&]() //
                        {
+                           PipelineStateRegistryKey RegistryKey;
+                           if (FindSharedPipelineState<ShaderD3D12Impl>(PSOCreateInfo, RegistryKey, ppPipelineState))
+                               return;
+
                            PipelineStateD3D12Impl* pPipelineStateD3D12{NEW_RC_OBJ(m_PSOAllocator, "PipelineStateD3D12Impl instance", PipelineStateD3D12Impl)(this, PSOCreateInfo)};
                            pPipelineStateD3D12->QueryInterface(IID_PipelineState, reinterpret_cast<IObject**>(ppPipelineState));
                            OnCreateDeviceObject(pPipelineStateD3D12);
+                           AddSharedPipelineState(RegistryKey, *ppPipelineState);
                        });
 }
 
@@ -791,6 +804,21 @@ void RenderDeviceD3D12Impl::CreateSBT(const ShaderBindingTableDesc& Desc,
                        });
 }
 
+void RenderDeviceD3D12Impl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                     IPipelineStateCache**               ppPSOCache)
+{
+    // Pipeline state caches are not supported in Direct3D12, so pipelines are always created without one.
+    *ppPSOCache = nullptr;
+}
+
+void RenderDeviceD3D12Impl::CreateBindlessResourceTable(const BindlessResourceTableDesc& Desc,
+                                                        IBindlessResourceTable**         ppBindlessTable)
+{
+    // Bindless resource tables are not yet implemented in Direct3D12 backend.
+    LOG_ERROR_MESSAGE("Bindless resource tables are not yet supported in Direct3D12 backend");
+    *ppBindlessTable = nullptr;
+}
+
 DescriptorHeapAllocation RenderDeviceD3D12Impl::AllocateDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE Type, UINT Count /*= 1*/)
 {
     VERIFY(Type >= D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV && Type < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES, "Invalid heap type");
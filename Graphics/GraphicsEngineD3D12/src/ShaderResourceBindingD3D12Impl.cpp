@@ -189,6 +189,26 @@ void ShaderResourceBindingD3D12Impl::dvpVerifyResourceBindings(const PipelineSta
 #endif
 
 
+Uint32 ShaderResourceBindingD3D12Impl::GetVariableHandle(SHADER_TYPE ShaderType, const char* Name)
+{
+    auto ResLayoutInd = GetVariableByNameHelper(ShaderType, Name, m_ResourceLayoutIndex);
+    if (ResLayoutInd < 0)
+        return INVALID_SHADER_VARIABLE_HANDLE;
+
+    VERIFY_EXPR(static_cast<Uint32>(ResLayoutInd) < Uint32{m_NumShaders});
+    auto* pVar = m_pShaderVarMgrs[ResLayoutInd].GetVariable(Name);
+    return pVar != nullptr ? PackVariableHandle(ResLayoutInd, pVar->GetIndex()) : INVALID_SHADER_VARIABLE_HANDLE;
+}
+
+void ShaderResourceBindingD3D12Impl::SetVariables(const Uint32* pHandles, IDeviceObject* const* ppObjects, Uint32 NumVariables)
+{
+    SetVariablesHelper(pHandles, ppObjects, NumVariables, m_NumShaders,
+                       [this](Uint32 ResLayoutInd, Uint32 VarIndex, IDeviceObject* pObject) //
+                       {
+                           m_pShaderVarMgrs[ResLayoutInd].BindVariable(VarIndex, pObject);
+                       });
+}
+
 void ShaderResourceBindingD3D12Impl::InitializeStaticResources(const IPipelineState* pPSO)
 {
     if (StaticResourcesInitialized())
@@ -236,4 +256,26 @@ void ShaderResourceBindingD3D12Impl::InitializeStaticResources(const IPipelineSt
     m_bStaticResourcesInitialized = true;
 }
 
+void ShaderResourceBindingD3D12Impl::Clone(IShaderResourceBinding** ppClone)
+{
+    DEV_CHECK_ERR(ppClone != nullptr, "Pointer to the clone must not be null");
+
+    RefCntAutoPtr<IShaderResourceBinding> pClone;
+    m_pPSO->CreateShaderResourceBinding(&pClone, false);
+    if (!pClone)
+        return;
+
+    auto* pCloneD3D12 = pClone.RawPtr<ShaderResourceBindingD3D12Impl>();
+    pCloneD3D12->m_ShaderResourceCache.CopyResources(m_pPSO->GetDevice()->GetD3D12Device(), m_ShaderResourceCache);
+    pCloneD3D12->m_bStaticResourcesInitialized = m_bStaticResourcesInitialized;
+
+    *ppClone = pClone.Detach();
+}
+
+void ShaderResourceBindingD3D12Impl::ResetResources()
+{
+    m_ShaderResourceCache.ResetResources();
+    m_bStaticResourcesInitialized = false;
+}
+
 } // namespace Diligent
@@ -99,6 +99,48 @@ ShaderResourceCacheD3D12::~ShaderResourceCacheD3D12()
     }
 }
 
+void ShaderResourceCacheD3D12::ResetResources()
+{
+    Uint32 TotalResources = 0;
+    for (Uint32 t = 0; t < m_NumTables; ++t)
+        TotalResources += GetRootTable(t).GetSize();
+    auto* pResources = reinterpret_cast<Resource*>(reinterpret_cast<RootTable*>(m_pMemory) + m_NumTables);
+    for (Uint32 res = 0; res < TotalResources; ++res)
+        pResources[res] = Resource{};
+    m_NumDynamicCBsBound = 0;
+    IncrementVersion();
+}
+
+void ShaderResourceCacheD3D12::CopyResources(ID3D12Device* pd3d12Device, const ShaderResourceCacheD3D12& SrcCache)
+{
+    VERIFY(m_NumTables == SrcCache.m_NumTables, "Inconsistent cache layouts");
+    // Resources of all root tables are stored in one continuous array
+    auto* pDstRes = reinterpret_cast<Resource*>(reinterpret_cast<RootTable*>(m_pMemory) + m_NumTables);
+    for (Uint32 t = 0; t < m_NumTables; ++t)
+    {
+        const auto& DstRT = GetRootTable(t);
+        const auto& SrcRT = SrcCache.GetRootTable(t);
+        VERIFY(DstRT.GetSize() == SrcRT.GetSize() && DstRT.m_TableStartOffset == SrcRT.m_TableStartOffset, "Inconsistent root tables");
+        for (Uint32 res = 0; res < SrcRT.GetSize(); ++res, ++pDstRes)
+        {
+            const auto& SrcRes = SrcRT.GetResource(res);
+            *pDstRes           = SrcRes;
+
+            // Dynamic resources do not have space in the GPU-visible heaps, their
+            // descriptors are copied by the root signature at every draw call
+            if (DstRT.m_TableStartOffset == InvalidDescriptorOffset || !SrcRes.pObject || SrcRes.CPUDescriptorHandle.ptr == 0)
+                continue;
+
+            const auto HeapType  = SrcRes.Type == CachedResourceType::Sampler ? D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER : D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+            auto&      HeapSpace = HeapType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? m_SamplerHeapSpace : m_CbvSrvUavHeapSpace;
+            VERIFY_EXPR(!HeapSpace.IsNull());
+            pd3d12Device->CopyDescriptorsSimple(1, HeapSpace.GetCpuHandle(DstRT.m_TableStartOffset + res), SrcRes.CPUDescriptorHandle, HeapType);
+        }
+    }
+    m_NumDynamicCBsBound = SrcCache.m_NumDynamicCBsBound;
+    IncrementVersion();
+}
+
 #ifdef DILIGENT_DEBUG
 void ShaderResourceCacheD3D12::DbgVerifyBoundDynamicCBsCounter() const
 {
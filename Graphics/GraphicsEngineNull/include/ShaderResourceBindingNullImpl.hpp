@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderResourceBindingNullImpl class
+
+#include <array>
+
+#include "ShaderResourceBindingBase.hpp"
+#include "ShaderResourceLayoutNull.hpp"
+
+namespace Diligent
+{
+
+class PipelineStateNullImpl;
+
+/// Implementation of shader resource binding object in Null backend.
+class ShaderResourceBindingNullImpl final : public ShaderResourceBindingBase<IShaderResourceBinding, PipelineStateNullImpl>
+{
+public:
+    using TBase = ShaderResourceBindingBase<IShaderResourceBinding, PipelineStateNullImpl>;
+
+    ShaderResourceBindingNullImpl(IReferenceCounters*    pRefCounters,
+                                  PipelineStateNullImpl* pPSO,
+                                  bool                   IsInternal);
+    ~ShaderResourceBindingNullImpl();
+
+    /// Implementation of IShaderResourceBinding::BindResources() in Null backend.
+    virtual void DILIGENT_CALL_TYPE BindResources(Uint32            ShaderFlags,
+                                                  IResourceMapping* pResMapping,
+                                                  Uint32            Flags) override final;
+
+    /// Implementation of IShaderResourceBinding::GetVariableByName() in Null backend.
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByName(SHADER_TYPE ShaderType, const char* Name) override final;
+
+    /// Implementation of IShaderResourceBinding::GetVariableCount() in Null backend.
+    virtual Uint32 DILIGENT_CALL_TYPE GetVariableCount(SHADER_TYPE ShaderType) const override final;
+
+    /// Implementation of IShaderResourceBinding::GetVariableByIndex() in Null backend.
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByIndex(SHADER_TYPE ShaderType, Uint32 Index) override final;
+
+    /// Implementation of IShaderResourceBinding::InitializeStaticResources() in Null backend.
+    virtual void DILIGENT_CALL_TYPE InitializeStaticResources(const IPipelineState* pPipelineState) override final;
+
+    /// Implementation of IShaderResourceBinding::Clone() in Null backend.
+    virtual void DILIGENT_CALL_TYPE Clone(IShaderResourceBinding** ppClone) override final;
+
+    /// Implementation of IShaderResourceBinding::GetVariableHandle() in Null backend.
+    virtual Uint32 DILIGENT_CALL_TYPE GetVariableHandle(SHADER_TYPE ShaderType, const char* Name) override final;
+
+    /// Implementation of IShaderResourceBinding::SetVariables() in Null backend.
+    virtual void DILIGENT_CALL_TYPE SetVariables(const Uint32* pHandles, IDeviceObject* const* ppObjects, Uint32 NumVariables) override final;
+
+    ShaderResourceLayoutNull& GetResourceLayout(Uint32 Ind)
+    {
+        VERIFY_EXPR(Ind < m_NumActiveShaders);
+        return m_pResourceLayouts[Ind];
+    }
+
+    inline bool IsStaticResourcesBound() const { return m_bIsStaticResourcesBound; }
+
+    Uint32 GetNumActiveShaders() const
+    {
+        return Uint32{m_NumActiveShaders};
+    }
+
+    SHADER_TYPE GetActiveShaderType(Uint32 s) const
+    {
+        VERIFY_EXPR(s < m_NumActiveShaders);
+        return m_ShaderTypes[s];
+    }
+
+    /// Returns the combined version of all resource caches, which changes every time a resource is modified.
+    Uint32 GetResourcesVersion() const
+    {
+        Uint32 Version = 0;
+        for (Uint32 s = 0; s < m_NumActiveShaders; ++s)
+            Version += m_pResourceLayouts[s].GetCacheVersion();
+        return Version;
+    }
+
+private:
+    virtual void ResetResources() override final;
+
+    void Destruct();
+
+    // The layouts are indexed by the shader order in the PSO, not shader index.
+    // Every layout has a resource cache slot for all shader resources, including static ones;
+    // static resources are copied from the PSO by InitializeStaticResources().
+    ShaderResourceLayoutNull* m_pResourceLayouts = nullptr;
+
+    std::array<SHADER_TYPE, MAX_SHADERS_IN_PIPELINE> m_ShaderTypes = {};
+
+    // Resource layout index in m_pResourceLayouts array for every shader stage,
+    // indexed by the shader type pipeline index (returned by GetShaderTypePipelineIndex)
+    std::array<Int8, MAX_SHADERS_IN_PIPELINE> m_ResourceLayoutIndex = {-1, -1, -1, -1, -1, -1};
+    static_assert(MAX_SHADERS_IN_PIPELINE == 6, "Please update the initializer list above");
+
+    Uint8 m_NumActiveShaders = 0;
+
+    bool m_bIsStaticResourcesBound = false;
+};
+
+} // namespace Diligent
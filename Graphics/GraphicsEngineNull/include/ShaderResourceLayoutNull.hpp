@@ -0,0 +1,202 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderResourceLayoutNull class
+
+#include <memory>
+#include <vector>
+#include <atomic>
+
+#include "PipelineState.h"
+#include "ShaderResourceVariableBase.hpp"
+#include "ShaderResourcesNull.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Diligent::ShaderResourceLayoutNull class
+
+/// The layout keeps the shader variables of the allowed types together with the resource cache
+/// that has a slot for every array element of every resource in the shader, so that static resources
+/// can be copied from the pipeline state to the SRB the same way as in other backends.
+class ShaderResourceLayoutNull
+{
+public:
+    explicit ShaderResourceLayoutNull(IObject& Owner) noexcept :
+        m_Owner{Owner}
+    {
+    }
+
+    void Initialize(std::shared_ptr<const ShaderResourcesNull> pSrcResources,
+                    const PipelineResourceLayoutDesc&          ResourceLayout,
+                    const SHADER_RESOURCE_VARIABLE_TYPE*       AllowedVarTypes,
+                    Uint32                                     NumAllowedTypes);
+
+    // clang-format off
+    ShaderResourceLayoutNull             (const ShaderResourceLayoutNull&)  = delete;
+    ShaderResourceLayoutNull             (      ShaderResourceLayoutNull&&) = delete;
+    ShaderResourceLayoutNull& operator = (const ShaderResourceLayoutNull&)  = delete;
+    ShaderResourceLayoutNull& operator = (      ShaderResourceLayoutNull&&) = delete;
+    // clang-format on
+
+    struct ShaderVariableNullImpl final : ShaderVariableBase<ShaderResourceLayoutNull>
+    {
+        ShaderVariableNullImpl(ShaderResourceLayoutNull&        ParentResLayout,
+                               const ShaderResourceAttribsNull& Attribs,
+                               SHADER_RESOURCE_VARIABLE_TYPE    VariableType) :
+            // clang-format off
+            ShaderVariableBase<ShaderResourceLayoutNull>{ParentResLayout},
+            m_Attribs     {Attribs     },
+            m_VariableType{VariableType}
+        // clang-format on
+        {}
+
+        virtual SHADER_RESOURCE_VARIABLE_TYPE DILIGENT_CALL_TYPE GetType() const override final
+        {
+            return m_VariableType;
+        }
+
+        virtual void DILIGENT_CALL_TYPE Set(IDeviceObject* pObject) override final { BindResource(pObject, 0); }
+
+        virtual void DILIGENT_CALL_TYPE SetArray(IDeviceObject* const* ppObjects,
+                                                 Uint32                FirstElement,
+                                                 Uint32                NumElements) override final
+        {
+            VerifyAndCorrectSetArrayArguments(m_Attribs.Name.c_str(), m_Attribs.ArraySize, FirstElement, NumElements);
+            for (Uint32 elem = 0; elem < NumElements; ++elem)
+                BindResource(ppObjects[elem], FirstElement + elem);
+        }
+
+        virtual void DILIGENT_CALL_TYPE GetResourceDesc(ShaderResourceDesc& ResourceDesc) const override final
+        {
+            ResourceDesc = m_Attribs.GetResourceDesc();
+        }
+
+        virtual Uint32 DILIGENT_CALL_TYPE GetIndex() const override final
+        {
+            return m_ParentResLayout.GetVariableIndex(*this);
+        }
+
+        virtual bool DILIGENT_CALL_TYPE IsBound(Uint32 ArrayIndex) const override final
+        {
+            VERIFY_EXPR(ArrayIndex < m_Attribs.ArraySize);
+            return m_ParentResLayout.m_ResourceCache[m_Attribs.CacheOffset + ArrayIndex] != nullptr;
+        }
+
+        void BindResource(IDeviceObject* pObject, Uint32 ArrayIndex);
+
+        const ShaderResourceAttribsNull&    m_Attribs;
+        const SHADER_RESOURCE_VARIABLE_TYPE m_VariableType;
+    };
+
+    void BindResources(IResourceMapping* pResourceMapping, Uint32 Flags);
+
+    /// Copies resources of all variables in this layout to the cache of the destination layout
+    void CopyResources(ShaderResourceLayoutNull& DstLayout) const;
+
+    /// Releases all resources in the cache
+    void ResetResourceCache();
+
+    /// Copies the entire resource cache of the source layout that must be compatible with this layout
+    void CopyResourceCache(const ShaderResourceLayoutNull& SrcLayout);
+
+#ifdef DILIGENT_DEVELOPMENT
+    bool dvpVerifyBindings() const;
+#endif
+
+    IShaderResourceVariable* GetShaderVariable(const Char* Name);
+    IShaderResourceVariable* GetShaderVariable(Uint32 Index);
+
+    /// Binds the object to the first element of the variable with the given index
+    void BindVariable(Uint32 Index, IDeviceObject* pObject)
+    {
+        // The index comes from a variable handle provided by the application, so it is always validated
+        if (Index >= m_Variables.size())
+        {
+            LOG_ERROR(Index, " is not a valid variable index.");
+            return;
+        }
+        m_Variables[Index].BindResource(pObject, 0);
+    }
+
+    IObject& GetOwner() { return m_Owner; }
+
+    Uint32 GetVariableIndex(const ShaderVariableNullImpl& Variable) const;
+
+    Uint32 GetTotalResourceCount() const
+    {
+        return static_cast<Uint32>(m_Variables.size());
+    }
+
+    SHADER_TYPE GetShaderType() const
+    {
+        return m_pResources->GetShaderType();
+    }
+
+    const ShaderResourcesNull& GetResources() const
+    {
+        return *m_pResources;
+    }
+
+    const Char* GetShaderName() const
+    {
+        return m_pResources->GetShaderName();
+    }
+
+    IDeviceObject* GetCachedResource(Uint32 CacheOffset)
+    {
+        VERIFY_EXPR(CacheOffset < m_ResourceCache.size());
+        return m_ResourceCache[CacheOffset];
+    }
+
+    /// Returns the version of the resource cache that is incremented every time a resource is modified
+    Uint32 GetCacheVersion() const
+    {
+        return m_CacheVersion.load(std::memory_order_relaxed);
+    }
+
+private:
+    void IncrementCacheVersion()
+    {
+        m_CacheVersion.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    IObject& m_Owner;
+
+    std::shared_ptr<const ShaderResourcesNull> m_pResources;
+
+    std::vector<ShaderVariableNullImpl>        m_Variables;
+    std::vector<RefCntAutoPtr<IDeviceObject>> m_ResourceCache;
+
+    std::atomic<Uint32> m_CacheVersion{0};
+};
+
+} // namespace Diligent
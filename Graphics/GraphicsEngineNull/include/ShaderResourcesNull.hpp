@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderResourcesNull class
+
+#include <string>
+#include <vector>
+
+#include "Shader.h"
+#include "GraphicsTypes.h"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Shader resource attributes in Null backend
+struct ShaderResourceAttribsNull
+{
+    // clang-format off
+    std::string          Name;
+    SHADER_RESOURCE_TYPE Type        = SHADER_RESOURCE_TYPE_UNKNOWN;
+    Uint32               ArraySize   = 1; ///< Zero for unbounded arrays, e.g. "Texture2D g_Textures[]"
+    RESOURCE_DIMENSION   ResourceDim = RESOURCE_DIM_UNDEFINED;
+    bool                 IsMS        = false;
+
+    /// Offset of the first array element in the resource cache
+    Uint32               CacheOffset = 0;
+    // clang-format on
+
+    String GetPrintName(Uint32 ArrayInd) const
+    {
+        VERIFY_EXPR(ArrayInd < ArraySize);
+        if (ArraySize > 1)
+            return Name + '[' + std::to_string(ArrayInd) + ']';
+        else
+            return Name;
+    }
+
+    /// Unbounded arrays are not part of the resource layout and are bound to the bindless resource table
+    bool IsUnboundedArray() const
+    {
+        return ArraySize == 0;
+    }
+
+    RESOURCE_DIMENSION GetResourceDimension() const
+    {
+        return ResourceDim;
+    }
+
+    bool IsMultisample() const
+    {
+        return IsMS;
+    }
+
+    ShaderResourceDesc GetResourceDesc() const
+    {
+        return ShaderResourceDesc{Name.c_str(), Type, ArraySize};
+    }
+
+    bool IsCompatibleWith(const ShaderResourceAttribsNull& Attribs) const
+    {
+        // clang-format off
+        return Type        == Attribs.Type        &&
+               ArraySize   == Attribs.ArraySize   &&
+               ResourceDim == Attribs.ResourceDim &&
+               IsMS        == Attribs.IsMS;
+        // clang-format on
+    }
+};
+
+/// Shader resources of a shader in Null backend.
+
+/// Null backend does not compile shaders. The resources are extracted from the
+/// preprocessed HLSL or GLSL source by scanning the global-scope declarations.
+class ShaderResourcesNull
+{
+public:
+    /// \param [in] ShaderType            - Shader type.
+    /// \param [in] ShaderName            - Shader name.
+    /// \param [in] Source                - Preprocessed shader source (see PreprocessShaderSource()).
+    /// \param [in] CombinedSamplerSuffix - Suffix of the combined texture samplers, or null
+    ///                                     if the shader does not use combined samplers.
+    ShaderResourcesNull(SHADER_TYPE        ShaderType,
+                        const char*        ShaderName,
+                        const std::string& Source,
+                        const char*        CombinedSamplerSuffix);
+
+    // clang-format off
+    ShaderResourcesNull             (const ShaderResourcesNull&)  = delete;
+    ShaderResourcesNull             (      ShaderResourcesNull&&) = delete;
+    ShaderResourcesNull& operator = (const ShaderResourcesNull&)  = delete;
+    ShaderResourcesNull& operator = (      ShaderResourcesNull&&) = delete;
+    // clang-format on
+
+    Uint32 GetNumResources() const { return static_cast<Uint32>(m_Resources.size()); }
+
+    const ShaderResourceAttribsNull& GetResource(Uint32 n) const
+    {
+        VERIFY_EXPR(n < m_Resources.size());
+        return m_Resources[n];
+    }
+
+    /// Returns the total number of resource cache slots required by all resources
+    Uint32 GetCacheSize() const { return m_CacheSize; }
+
+    SHADER_TYPE GetShaderType() const { return m_ShaderType; }
+    const char* GetShaderName() const { return m_ShaderName.c_str(); }
+    const char* GetCombinedSamplerSuffix() const { return m_CombinedSamplerSuffix.empty() ? nullptr : m_CombinedSamplerSuffix.c_str(); }
+
+    bool   IsCompatibleWith(const ShaderResourcesNull& Resources) const;
+    size_t GetHash() const;
+
+private:
+    void ParseSource(const std::string& Source);
+
+    const SHADER_TYPE m_ShaderType;
+    const std::string m_ShaderName;
+    const std::string m_CombinedSamplerSuffix;
+
+    std::vector<ShaderResourceAttribsNull> m_Resources;
+
+    Uint32 m_CacheSize = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::TextureNullImpl class
+
+#include <vector>
+
+#include "RenderDevice.h"
+#include "TextureBase.hpp"
+#include "TextureViewNullImpl.hpp"
+#include "RenderDeviceNullImpl.hpp"
+
+namespace Diligent
+{
+
+class FixedBlockMemoryAllocator;
+
+/// Texture object implementation in Null backend.
+
+/// Every subresource is kept in a separate tightly packed host memory
+/// block laid out as described by GetMipLevelProperties().
+class TextureNullImpl final : public TextureBase<ITexture, RenderDeviceNullImpl, TextureViewNullImpl, FixedBlockMemoryAllocator>
+{
+public:
+    using TTextureBase = TextureBase<ITexture, RenderDeviceNullImpl, TextureViewNullImpl, FixedBlockMemoryAllocator>;
+    using ViewImplType = TextureViewNullImpl;
+
+    TextureNullImpl(IReferenceCounters*        pRefCounters,
+                    FixedBlockMemoryAllocator& TexViewObjAllocator,
+                    RenderDeviceNullImpl*      pDevice,
+                    const TextureDesc&         TexDesc,
+                    const TextureData*         pInitData = nullptr);
+    ~TextureNullImpl();
+
+    /// Implementation of ITexture::GetNativeHandle() in Null backend.
+    virtual void* DILIGENT_CALL_TYPE GetNativeHandle() override final { return nullptr; }
+
+    /// Returns the address and strides of the texel at (X, Y, Z) in the given subresource.
+    MappedTextureSubresource GetSubresourceData(Uint32 MipLevel, Uint32 Slice, Uint32 X = 0, Uint32 Y = 0, Uint32 Z = 0);
+
+    /// Copies the texel data from the host memory to the region of the subresource.
+    void WriteRegion(Uint32      MipLevel,
+                     Uint32      Slice,
+                     const Box&  Region,
+                     const void* pSrcData,
+                     Uint32      SrcStride,
+                     Uint32      SrcDepthStride);
+
+private:
+    virtual void CreateViewInternal(const struct TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView) override;
+
+    Uint32 GetNumSlices() const
+    {
+        return m_Desc.Type == RESOURCE_DIM_TEX_3D ? 1 : m_Desc.ArraySize;
+    }
+
+    std::vector<std::vector<Uint8>> m_Subresources;
+};
+
+} // namespace Diligent
@@ -0,0 +1,788 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <cstring>
+
+#include "DeviceContextNullImpl.hpp"
+#include "RenderDeviceNullImpl.hpp"
+#include "ShaderResourceBindingNullImpl.hpp"
+#include "CommandListNullImpl.hpp"
+#include "FenceNullImpl.hpp"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+DeviceContextNullImpl::DeviceContextNullImpl(IReferenceCounters*   pRefCounters,
+                                             RenderDeviceNullImpl* pDevice,
+                                             bool                  bIsDeferred) :
+    // clang-format off
+    TDeviceContextBase
+    {
+        pRefCounters,
+        pDevice,
+        bIsDeferred
+    },
+    m_CmdListAllocator{GetRawAllocator(), sizeof(CommandListNullImpl), 64}
+// clang-format on
+{
+}
+
+DeviceContextNullImpl::~DeviceContextNullImpl()
+{
+}
+
+void DeviceContextNullImpl::TransitionOrVerifyBufferState(BufferNullImpl&                Buffer,
+                                                          RESOURCE_STATE_TRANSITION_MODE TransitionMode,
+                                                          RESOURCE_STATE                 RequiredState,
+                                                          const char*                    OperationName)
+{
+    if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+    {
+        if (Buffer.IsInKnownState() && !Buffer.CheckState(RequiredState))
+            Buffer.SetState(RequiredState);
+    }
+#ifdef DILIGENT_DEVELOPMENT
+    else if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_VERIFY)
+    {
+        DvpVerifyBufferState(Buffer, RequiredState, OperationName);
+    }
+#endif
+}
+
+void DeviceContextNullImpl::TransitionOrVerifyTextureState(TextureNullImpl&               Texture,
+                                                           RESOURCE_STATE_TRANSITION_MODE TransitionMode,
+                                                           RESOURCE_STATE                 RequiredState,
+                                                           const char*                    OperationName)
+{
+    if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+    {
+        if (Texture.IsInKnownState() && !Texture.CheckState(RequiredState))
+            Texture.SetState(RequiredState);
+    }
+#ifdef DILIGENT_DEVELOPMENT
+    else if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_VERIFY)
+    {
+        DvpVerifyTextureState(Texture, RequiredState, OperationName);
+    }
+#endif
+}
+
+void DeviceContextNullImpl::SetPipelineState(IPipelineState* pPipelineState)
+{
+    auto* pPipelineStateNull = ValidatedCast<PipelineStateNullImpl>(pPipelineState);
+    if (pPipelineStateNull != nullptr && !pPipelineStateNull->IsReady())
+    {
+        // The pipeline is being compiled asynchronously or has failed to compile
+        pPipelineStateNull = ValidatedCast<PipelineStateNullImpl>(pPipelineStateNull->GetPipelineStateToBind());
+        if (pPipelineStateNull == nullptr)
+            return;
+    }
+    if (PipelineStateNullImpl::IsSameObject(m_pPipelineState, pPipelineStateNull))
+        return;
+
+    TDeviceContextBase::SetPipelineState(pPipelineStateNull, 0 /*Dummy*/);
+}
+
+void DeviceContextNullImpl::TransitionShaderResources(ShaderResourceBindingNullImpl& SRB, bool Verify)
+{
+    const auto TransitionMode = Verify ? RESOURCE_STATE_TRANSITION_MODE_VERIFY : RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    for (Uint32 s = 0; s < SRB.GetNumActiveShaders(); ++s)
+    {
+        auto&       ResLayout = SRB.GetResourceLayout(s);
+        const auto& Resources = ResLayout.GetResources();
+        for (Uint32 r = 0; r < Resources.GetNumResources(); ++r)
+        {
+            const auto& Attribs = Resources.GetResource(r);
+            for (Uint32 elem = 0; elem < Attribs.ArraySize; ++elem)
+            {
+                auto* pResource = ResLayout.GetCachedResource(Attribs.CacheOffset + elem);
+                if (pResource == nullptr)
+                    continue;
+
+                switch (Attribs.Type)
+                {
+                    case SHADER_RESOURCE_TYPE_CONSTANT_BUFFER:
+                        TransitionOrVerifyBufferState(*ValidatedCast<BufferNullImpl>(pResource), TransitionMode, RESOURCE_STATE_CONSTANT_BUFFER,
+                                                      "Committing constant buffers (DeviceContextNullImpl::CommitShaderResources)");
+                        break;
+
+                    case SHADER_RESOURCE_TYPE_TEXTURE_SRV:
+                    case SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT:
+                    {
+                        auto* pTexture = ValidatedCast<TextureNullImpl>(ValidatedCast<TextureViewNullImpl>(pResource)->GetTexture());
+                        TransitionOrVerifyTextureState(*pTexture, TransitionMode, RESOURCE_STATE_SHADER_RESOURCE,
+                                                       "Committing shader resource views (DeviceContextNullImpl::CommitShaderResources)");
+                        break;
+                    }
+
+                    case SHADER_RESOURCE_TYPE_TEXTURE_UAV:
+                    {
+                        auto* pTexture = ValidatedCast<TextureNullImpl>(ValidatedCast<TextureViewNullImpl>(pResource)->GetTexture());
+                        TransitionOrVerifyTextureState(*pTexture, TransitionMode, RESOURCE_STATE_UNORDERED_ACCESS,
+                                                       "Committing unordered access views (DeviceContextNullImpl::CommitShaderResources)");
+                        break;
+                    }
+
+                    case SHADER_RESOURCE_TYPE_BUFFER_SRV:
+                    {
+                        auto* pBuffer = ValidatedCast<BufferNullImpl>(ValidatedCast<BufferViewNullImpl>(pResource)->GetBuffer());
+                        TransitionOrVerifyBufferState(*pBuffer, TransitionMode, RESOURCE_STATE_SHADER_RESOURCE,
+                                                      "Committing shader resource views (DeviceContextNullImpl::CommitShaderResources)");
+                        break;
+                    }
+
+                    case SHADER_RESOURCE_TYPE_BUFFER_UAV:
+                    {
+                        auto* pBuffer = ValidatedCast<BufferNullImpl>(ValidatedCast<BufferViewNullImpl>(pResource)->GetBuffer());
+                        TransitionOrVerifyBufferState(*pBuffer, TransitionMode, RESOURCE_STATE_UNORDERED_ACCESS,
+                                                      "Committing unordered access views (DeviceContextNullImpl::CommitShaderResources)");
+                        break;
+                    }
+
+                    default:
+                        // Samplers and acceleration structures have no tracked state
+                        break;
+                }
+            }
+        }
+    }
+}
+
+void DeviceContextNullImpl::TransitionShaderResources(IPipelineState* pPipelineState, IShaderResourceBinding* pShaderResourceBinding)
+{
+    DEV_CHECK_ERR(pShaderResourceBinding != nullptr, "Shader resource binding must not be null");
+    if (m_pActiveRenderPass)
+    {
+        LOG_ERROR_MESSAGE("State transitions are not allowed inside a render pass.");
+        return;
+    }
+
+    TransitionShaderResources(*ValidatedCast<ShaderResourceBindingNullImpl>(pShaderResourceBinding), false);
+}
+
+void DeviceContextNullImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/))
+        return;
+
+    if (pShaderResourceBinding == nullptr)
+        return;
+
+    auto* pSRBNull = ValidatedCast<ShaderResourceBindingNullImpl>(pShaderResourceBinding);
+#ifdef DILIGENT_DEVELOPMENT
+    if (!pSRBNull->IsStaticResourcesBound())
+    {
+        bool HasStaticResources = false;
+        for (Uint32 s = 0; s < m_pPipelineState->GetNumShaderStages(); ++s)
+            HasStaticResources = HasStaticResources || m_pPipelineState->GetStaticResourceLayout(s).GetTotalResourceCount() > 0;
+        if (HasStaticResources)
+        {
+            LOG_ERROR_MESSAGE("Static resources have not been initialized in the shader resource binding object being committed for PSO '",
+                              m_pPipelineState->GetDesc().Name, "'. Please call IShaderResourceBinding::InitializeStaticResources().");
+        }
+    }
+#endif
+
+    if (StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+        TransitionShaderResources(*pSRBNull, false);
+#ifdef DILIGENT_DEVELOPMENT
+    else if (StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_VERIFY)
+        TransitionShaderResources(*pSRBNull, true);
+#endif
+}
+
+void DeviceContextNullImpl::SetStencilRef(Uint32 StencilRef)
+{
+    TDeviceContextBase::SetStencilRef(StencilRef, 0);
+}
+
+void DeviceContextNullImpl::SetBlendFactors(const float* pBlendFactors)
+{
+    TDeviceContextBase::SetBlendFactors(pBlendFactors, 0);
+}
+
+void DeviceContextNullImpl::SetVertexBuffers(Uint32                         StartSlot,
+                                             Uint32                         NumBuffersSet,
+                                             IBuffer**                      ppBuffers,
+                                             Uint32*                        pOffsets,
+                                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                             SET_VERTEX_BUFFERS_FLAGS       Flags)
+{
+    if (!TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags, 0 /*Dummy*/))
+        return;
+
+    for (Uint32 Slot = 0; Slot < m_NumVertexStreams; ++Slot)
+    {
+        if (auto* pBuffNull = m_VertexStreams[Slot].pBuffer.RawPtr())
+            TransitionOrVerifyBufferState(*pBuffNull, StateTransitionMode, RESOURCE_STATE_VERTEX_BUFFER, "Setting vertex buffers (DeviceContextNullImpl::SetVertexBuffers)");
+    }
+}
+
+void DeviceContextNullImpl::InvalidateState()
+{
+    TDeviceContextBase::InvalidateState();
+}
+
+void DeviceContextNullImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+    if (m_pIndexBuffer)
+        TransitionOrVerifyBufferState(*m_pIndexBuffer, StateTransitionMode, RESOURCE_STATE_INDEX_BUFFER, "Setting index buffer (DeviceContextNullImpl::SetIndexBuffer)");
+}
+
+void DeviceContextNullImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
+{
+    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+}
+
+void DeviceContextNullImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
+{
+    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+}
+
+void DeviceContextNullImpl::SetRenderTargets(Uint32                         NumRenderTargets,
+                                             ITextureView*                  ppRenderTargets[],
+                                             ITextureView*                  pDepthStencil,
+                                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+#ifdef DILIGENT_DEVELOPMENT
+    if (m_pActiveRenderPass != nullptr)
+    {
+        LOG_ERROR_MESSAGE("Calling SetRenderTargets inside active render pass is invalid. End the render pass first");
+        return;
+    }
+#endif
+
+    if (TDeviceContextBase::SetRenderTargets(NumRenderTargets, ppRenderTargets, pDepthStencil))
+    {
+        for (Uint32 RT = 0; RT < NumRenderTargets; ++RT)
+        {
+            if (ppRenderTargets[RT] != nullptr)
+            {
+                auto* pTexNull = ValidatedCast<TextureNullImpl>(ppRenderTargets[RT]->GetTexture());
+                TransitionOrVerifyTextureState(*pTexNull, StateTransitionMode, RESOURCE_STATE_RENDER_TARGET, "Setting render targets (DeviceContextNullImpl::SetRenderTargets)");
+            }
+        }
+
+        if (pDepthStencil != nullptr)
+        {
+            auto* pTexNull = ValidatedCast<TextureNullImpl>(pDepthStencil->GetTexture());
+            TransitionOrVerifyTextureState(*pTexNull, StateTransitionMode, RESOURCE_STATE_DEPTH_WRITE, "Setting depth-stencil buffer (DeviceContextNullImpl::SetRenderTargets)");
+        }
+
+        SetViewports(1, nullptr, 0, 0);
+    }
+}
+
+void DeviceContextNullImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
+{
+    TDeviceContextBase::BeginRenderPass(Attribs);
+    // BeginRenderPass() transitions resources to required states
+
+    // Set the viewport to match the framebuffer size
+    SetViewports(1, nullptr, 0, 0);
+}
+
+void DeviceContextNullImpl::NextSubpass()
+{
+    TDeviceContextBase::NextSubpass();
+}
+
+void DeviceContextNullImpl::EndRenderPass()
+{
+    TDeviceContextBase::EndRenderPass();
+}
+
+void DeviceContextNullImpl::PrepareForDraw(DRAW_FLAGS Flags)
+{
+#ifdef DILIGENT_DEVELOPMENT
+    if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
+        DvpVerifyRenderTargets();
+
+    DEV_CHECK_ERR(m_NumVertexStreams >= m_pPipelineState->GetNumBufferSlotsUsed(), "Currently bound pipeline state '", m_pPipelineState->GetDesc().Name,
+                  "' expects ", m_pPipelineState->GetNumBufferSlotsUsed(), " input buffer slots, but only ", m_NumVertexStreams, " is bound");
+
+    if ((Flags & DRAW_FLAG_VERIFY_STATES) != 0)
+    {
+        for (Uint32 Slot = 0; Slot < m_NumVertexStreams; ++Slot)
+        {
+            if (auto* pBuffNull = m_VertexStreams[Slot].pBuffer.RawPtr())
+                DvpVerifyBufferState(*pBuffNull, RESOURCE_STATE_VERTEX_BUFFER, "Using vertex buffers (DeviceContextNullImpl::Draw)");
+        }
+    }
+#endif
+}
+
+void DeviceContextNullImpl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE IndexType)
+{
+    if (!m_pIndexBuffer)
+    {
+        LOG_ERROR_MESSAGE("Index buffer is not set up for indexed draw command");
+        return;
+    }
+
+#ifdef DILIGENT_DEVELOPMENT
+    if ((Flags & DRAW_FLAG_VERIFY_STATES) != 0)
+        DvpVerifyBufferState(*m_pIndexBuffer, RESOURCE_STATE_INDEX_BUFFER, "Indexed draw (DeviceContextNullImpl::DrawIndexed)");
+#endif
+
+    PrepareForDraw(Flags);
+}
+
+void DeviceContextNullImpl::Draw(const DrawAttribs& Attribs)
+{
+    if (!DvpVerifyDrawArguments(Attribs))
+        return;
+
+    PrepareForDraw(Attribs.Flags);
+}
+
+void DeviceContextNullImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
+{
+    if (!DvpVerifyDrawIndexedArguments(Attribs))
+        return;
+
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+}
+
+void DeviceContextNullImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    if (!DvpVerifyDrawIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    TransitionOrVerifyBufferState(*ValidatedCast<BufferNullImpl>(pAttribsBuffer), Attribs.IndirectAttribsBufferStateTransitionMode,
+                                  RESOURCE_STATE_INDIRECT_ARGUMENT, "Indirect draw (DeviceContextNullImpl::DrawIndirect)");
+    PrepareForDraw(Attribs.Flags);
+}
+
+void DeviceContextNullImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    if (!DvpVerifyDrawIndexedIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    TransitionOrVerifyBufferState(*ValidatedCast<BufferNullImpl>(pAttribsBuffer), Attribs.IndirectAttribsBufferStateTransitionMode,
+                                  RESOURCE_STATE_INDIRECT_ARGUMENT, "Indirect draw (DeviceContextNullImpl::DrawIndexedIndirect)");
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+}
+
+void DeviceContextNullImpl::DrawMesh(const DrawMeshAttribs& Attribs)
+{
+    if (!DvpVerifyDrawMeshArguments(Attribs))
+        return;
+
+    PrepareForDraw(Attribs.Flags);
+}
+
+void DeviceContextNullImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    if (!DvpVerifyDrawMeshIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    TransitionOrVerifyBufferState(*ValidatedCast<BufferNullImpl>(pAttribsBuffer), Attribs.IndirectAttribsBufferStateTransitionMode,
+                                  RESOURCE_STATE_INDIRECT_ARGUMENT, "Indirect draw (DeviceContextNullImpl::DrawMeshIndirect)");
+    PrepareForDraw(Attribs.Flags);
+}
+
+void DeviceContextNullImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawArguments(Attribs))
+        return;
+
+    PrepareForDraw(Attribs.Flags);
+}
+
+void DeviceContextNullImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawIndexedArguments(Attribs))
+        return;
+
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+}
+
+void DeviceContextNullImpl::MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    if (!DvpVerifyMultiDrawIndirectArguments(Attribs, pAttribsBuffer, pCountBuffer))
+        return;
+
+    TransitionOrVerifyBufferState(*ValidatedCast<BufferNullImpl>(pAttribsBuffer), Attribs.IndirectAttribsBufferStateTransitionMode,
+                                  RESOURCE_STATE_INDIRECT_ARGUMENT, "Indirect draw (DeviceContextNullImpl::MultiDrawIndirect)");
+    if (pCountBuffer != nullptr)
+    {
+        TransitionOrVerifyBufferState(*ValidatedCast<BufferNullImpl>(pCountBuffer), Attribs.CountBufferStateTransitionMode,
+                                      RESOURCE_STATE_INDIRECT_ARGUMENT, "Indirect draw count (DeviceContextNullImpl::MultiDrawIndirect)");
+    }
+    PrepareForDraw(Attribs.Flags);
+}
+
+void DeviceContextNullImpl::MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    if (!DvpVerifyMultiDrawIndexedIndirectArguments(Attribs, pAttribsBuffer, pCountBuffer))
+        return;
+
+    TransitionOrVerifyBufferState(*ValidatedCast<BufferNullImpl>(pAttribsBuffer), Attribs.IndirectAttribsBufferStateTransitionMode,
+                                  RESOURCE_STATE_INDIRECT_ARGUMENT, "Indirect draw (DeviceContextNullImpl::MultiDrawIndexedIndirect)");
+    if (pCountBuffer != nullptr)
+    {
+        TransitionOrVerifyBufferState(*ValidatedCast<BufferNullImpl>(pCountBuffer), Attribs.CountBufferStateTransitionMode,
+                                      RESOURCE_STATE_INDIRECT_ARGUMENT, "Indirect draw count (DeviceContextNullImpl::MultiDrawIndexedIndirect)");
+    }
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+}
+
+void DeviceContextNullImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
+{
+    DvpVerifyDispatchArguments(Attribs);
+}
+
+void DeviceContextNullImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    if (!DvpVerifyDispatchIndirectArguments(Attribs, pAttribsBuffer))
+        return;
+
+    TransitionOrVerifyBufferState(*ValidatedCast<BufferNullImpl>(pAttribsBuffer), Attribs.IndirectAttribsBufferStateTransitionMode,
+                                  RESOURCE_STATE_INDIRECT_ARGUMENT, "Indirect dispatch (DeviceContextNullImpl::DispatchComputeIndirect)");
+}
+
+void DeviceContextNullImpl::ClearDepthStencil(ITextureView*                  pView,
+                                              CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags,
+                                              float                          fDepth,
+                                              Uint8                          Stencil,
+                                              RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    if (!TDeviceContextBase::ClearDepthStencil(pView))
+        return;
+
+    VERIFY_EXPR(pView != nullptr);
+    // Clears are not executed: the contents of render targets and depth buffers are undefined in Null backend
+    auto* pTexNull = ValidatedCast<TextureNullImpl>(pView->GetTexture());
+    TransitionOrVerifyTextureState(*pTexNull, StateTransitionMode, RESOURCE_STATE_DEPTH_WRITE, "Clearing depth-stencil buffer (DeviceContextNullImpl::ClearDepthStencil)");
+}
+
+void DeviceContextNullImpl::ClearRenderTarget(ITextureView* pView, const float* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    if (!TDeviceContextBase::ClearRenderTarget(pView))
+        return;
+
+    VERIFY_EXPR(pView != nullptr);
+    auto* pTexNull = ValidatedCast<TextureNullImpl>(pView->GetTexture());
+    TransitionOrVerifyTextureState(*pTexNull, StateTransitionMode, RESOURCE_STATE_RENDER_TARGET, "Clearing render target (DeviceContextNullImpl::ClearRenderTarget)");
+}
+
+void DeviceContextNullImpl::UpdateBuffer(IBuffer*                       pBuffer,
+                                         Uint32                         Offset,
+                                         Uint32                         Size,
+                                         const void*                    pData,
+                                         RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    TDeviceContextBase::UpdateBuffer(pBuffer, Offset, Size, pData, StateTransitionMode);
+
+    auto* pBufferNull = ValidatedCast<BufferNullImpl>(pBuffer);
+    TransitionOrVerifyBufferState(*pBufferNull, StateTransitionMode, RESOURCE_STATE_COPY_DEST, "Updating buffer (DeviceContextNullImpl::UpdateBuffer)");
+    if (pData != nullptr && Size > 0)
+        memcpy(pBufferNull->GetData() + Offset, pData, Size);
+}
+
+void DeviceContextNullImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
+                                       Uint32                         SrcOffset,
+                                       RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+                                       IBuffer*                       pDstBuffer,
+                                       Uint32                         DstOffset,
+                                       Uint32                         Size,
+                                       RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode)
+{
+    TDeviceContextBase::CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
+
+    auto* pSrcBufferNull = ValidatedCast<BufferNullImpl>(pSrcBuffer);
+    auto* pDstBufferNull = ValidatedCast<BufferNullImpl>(pDstBuffer);
+    TransitionOrVerifyBufferState(*pSrcBufferNull, SrcBufferTransitionMode, RESOURCE_STATE_COPY_SOURCE, "Using resource as copy source (DeviceContextNullImpl::CopyBuffer)");
+    TransitionOrVerifyBufferState(*pDstBufferNull, DstBufferTransitionMode, RESOURCE_STATE_COPY_DEST, "Using resource as copy destination (DeviceContextNullImpl::CopyBuffer)");
+    // Source and destination ranges may overlap if the same buffer is used
+    memmove(pDstBufferNull->GetData() + DstOffset, pSrcBufferNull->GetData() + SrcOffset, Size);
+}
+
+void DeviceContextNullImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
+{
+    TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
+
+    // All buffers are kept in host memory, so the data is always directly accessible.
+    // Discarding the buffer contents is not required as no GPU can be reading the data.
+    pMappedData = ValidatedCast<BufferNullImpl>(pBuffer)->GetData();
+}
+
+void DeviceContextNullImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
+{
+    TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
+}
+
+void DeviceContextNullImpl::UpdateTexture(ITexture*                      pTexture,
+                                          Uint32                         MipLevel,
+                                          Uint32                         Slice,
+                                          const Box&                     DstBox,
+                                          const TextureSubResData&       SubresData,
+                                          RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+                                          RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+{
+    TDeviceContextBase::UpdateTexture(pTexture, MipLevel, Slice, DstBox, SubresData, SrcBufferTransitionMode, TextureTransitionMode);
+
+    auto* pTexNull = ValidatedCast<TextureNullImpl>(pTexture);
+    TransitionOrVerifyTextureState(*pTexNull, TextureTransitionMode, RESOURCE_STATE_COPY_DEST, "Updating texture (DeviceContextNullImpl::UpdateTexture)");
+
+    const void* pSrcData = SubresData.pData;
+    if (SubresData.pSrcBuffer != nullptr)
+    {
+        auto* pSrcBufferNull = ValidatedCast<BufferNullImpl>(SubresData.pSrcBuffer);
+        TransitionOrVerifyBufferState(*pSrcBufferNull, SrcBufferTransitionMode, RESOURCE_STATE_COPY_SOURCE, "Using buffer as copy source (DeviceContextNullImpl::UpdateTexture)");
+        pSrcData = pSrcBufferNull->GetData() + SubresData.SrcOffset;
+    }
+
+    pTexNull->WriteRegion(MipLevel, Slice, DstBox, pSrcData, SubresData.Stride, SubresData.DepthStride);
+}
+
+void DeviceContextNullImpl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
+{
+    TDeviceContextBase::CopyTexture(CopyAttribs);
+
+    auto* pSrcTexNull = ValidatedCast<TextureNullImpl>(CopyAttribs.pSrcTexture);
+    auto* pDstTexNull = ValidatedCast<TextureNullImpl>(CopyAttribs.pDstTexture);
+    TransitionOrVerifyTextureState(*pSrcTexNull, CopyAttribs.SrcTextureTransitionMode, RESOURCE_STATE_COPY_SOURCE, "Using texture as copy source (DeviceContextNullImpl::CopyTexture)");
+    TransitionOrVerifyTextureState(*pDstTexNull, CopyAttribs.DstTextureTransitionMode, RESOURCE_STATE_COPY_DEST, "Using texture as copy destination (DeviceContextNullImpl::CopyTexture)");
+
+    Box SrcBox;
+    if (CopyAttribs.pSrcBox != nullptr)
+    {
+        SrcBox = *CopyAttribs.pSrcBox;
+    }
+    else
+    {
+        const auto MipProps = GetMipLevelProperties(pSrcTexNull->GetDesc(), CopyAttribs.SrcMipLevel);
+
+        SrcBox.MaxX = MipProps.LogicalWidth;
+        SrcBox.MaxY = MipProps.LogicalHeight;
+        SrcBox.MaxZ = MipProps.Depth;
+    }
+
+    const auto SrcData = pSrcTexNull->GetSubresourceData(CopyAttribs.SrcMipLevel, CopyAttribs.SrcSlice, SrcBox.MinX, SrcBox.MinY, SrcBox.MinZ);
+
+    Box DstBox;
+    DstBox.MinX = CopyAttribs.DstX;
+    DstBox.MinY = CopyAttribs.DstY;
+    DstBox.MinZ = CopyAttribs.DstZ;
+    DstBox.MaxX = DstBox.MinX + (SrcBox.MaxX - SrcBox.MinX);
+    DstBox.MaxY = DstBox.MinY + (SrcBox.MaxY - SrcBox.MinY);
+    DstBox.MaxZ = DstBox.MinZ + (SrcBox.MaxZ - SrcBox.MinZ);
+    pDstTexNull->WriteRegion(CopyAttribs.DstMipLevel, CopyAttribs.DstSlice, DstBox, SrcData.pData, SrcData.Stride, SrcData.DepthStride);
+}
+
+void DeviceContextNullImpl::MapTextureSubresource(ITexture*                 pTexture,
+                                                  Uint32                    MipLevel,
+                                                  Uint32                    ArraySlice,
+                                                  MAP_TYPE                  MapType,
+                                                  MAP_FLAGS                 MapFlags,
+                                                  const Box*                pMapRegion,
+                                                  MappedTextureSubresource& MappedData)
+{
+    TDeviceContextBase::MapTextureSubresource(pTexture, MipLevel, ArraySlice, MapType, MapFlags, pMapRegion, MappedData);
+
+    auto* pTexNull = ValidatedCast<TextureNullImpl>(pTexture);
+    if (pMapRegion != nullptr)
+        MappedData = pTexNull->GetSubresourceData(MipLevel, ArraySlice, pMapRegion->MinX, pMapRegion->MinY, pMapRegion->MinZ);
+    else
+        MappedData = pTexNull->GetSubresourceData(MipLevel, ArraySlice);
+}
+
+void DeviceContextNullImpl::UnmapTextureSubresource(ITexture* pTexture, Uint32 MipLevel, Uint32 ArraySlice)
+{
+    TDeviceContextBase::UnmapTextureSubresource(pTexture, MipLevel, ArraySlice);
+}
+
+void DeviceContextNullImpl::GenerateMips(ITextureView* pTextureView)
+{
+    TDeviceContextBase::GenerateMips(pTextureView);
+}
+
+void DeviceContextNullImpl::FinishFrame()
+{
+    TDeviceContextBase::EndFrame();
+}
+
+void DeviceContextNullImpl::TransitionResourceStates(Uint32 BarrierCount, StateTransitionDesc* pResourceBarriers)
+{
+    VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
+
+    for (Uint32 i = 0; i < BarrierCount; ++i)
+    {
+        const auto& Barrier = pResourceBarriers[i];
+#ifdef DILIGENT_DEVELOPMENT
+        DvpVerifyStateTransitionDesc(Barrier);
+#endif
+        DEV_CHECK_ERR(Barrier.NewState != RESOURCE_STATE_UNKNOWN, "New resource state can't be unknown");
+
+        if (Barrier.TransitionType == STATE_TRANSITION_TYPE_BEGIN)
+        {
+            // Skip begin-split barriers
+            VERIFY(!Barrier.UpdateResourceState, "Resource state can't be updated in begin-split barrier");
+            continue;
+        }
+        VERIFY(Barrier.TransitionType == STATE_TRANSITION_TYPE_IMMEDIATE || Barrier.TransitionType == STATE_TRANSITION_TYPE_END, "Unexpected barrier type");
+
+        if (!Barrier.UpdateResourceState)
+            continue;
+
+        if (RefCntAutoPtr<ITexture> pTexture{Barrier.pResource, IID_Texture})
+        {
+            ValidatedCast<TextureNullImpl>(pTexture.RawPtr())->SetState(Barrier.NewState);
+        }
+        else if (RefCntAutoPtr<IBuffer> pBuffer{Barrier.pResource, IID_Buffer})
+        {
+            ValidatedCast<BufferNullImpl>(pBuffer.RawPtr())->SetState(Barrier.NewState);
+        }
+        else
+        {
+            UNEXPECTED("Ray tracing is not supported in Null backend");
+        }
+    }
+}
+
+void DeviceContextNullImpl::ResolveTextureSubresource(ITexture*                               pSrcTexture,
+                                                      ITexture*                               pDstTexture,
+                                                      const ResolveTextureSubresourceAttribs& ResolveAttribs)
+{
+    TDeviceContextBase::ResolveTextureSubresource(pSrcTexture, pDstTexture, ResolveAttribs);
+
+    auto* pSrcTexNull = ValidatedCast<TextureNullImpl>(pSrcTexture);
+    auto* pDstTexNull = ValidatedCast<TextureNullImpl>(pDstTexture);
+    TransitionOrVerifyTextureState(*pSrcTexNull, ResolveAttribs.SrcTextureTransitionMode, RESOURCE_STATE_RESOLVE_SOURCE, "Resolving multi-sampled texture (DeviceContextNullImpl::ResolveTextureSubresource)");
+    TransitionOrVerifyTextureState(*pDstTexNull, ResolveAttribs.DstTextureTransitionMode, RESOURCE_STATE_RESOLVE_DEST, "Resolving multi-sampled texture (DeviceContextNullImpl::ResolveTextureSubresource)");
+}
+
+void DeviceContextNullImpl::FinishCommandList(ICommandList** ppCommandList)
+{
+    VERIFY(m_pActiveRenderPass == nullptr, "Finishing command list inside an active render pass.");
+    if (!m_bIsDeferred)
+    {
+        LOG_ERROR_MESSAGE("Only deferred context can finish command list");
+        return;
+    }
+
+    auto* pCmdListNull(NEW_RC_OBJ(m_CmdListAllocator, "CommandListNullImpl instance", CommandListNullImpl)(m_pDevice));
+    pCmdListNull->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
+
+    // Device context is now in default state
+    InvalidateState();
+}
+
+void DeviceContextNullImpl::ExecuteCommandList(ICommandList* pCommandList)
+{
+    if (m_bIsDeferred)
+    {
+        LOG_ERROR_MESSAGE("Only immediate context can execute command list");
+        return;
+    }
+
+    // Deferred contexts execute commands immediately, so there is nothing to do here
+
+    // Device context is now in default state
+    InvalidateState();
+}
+
+void DeviceContextNullImpl::SignalFence(IFence* pFence, Uint64 Value)
+{
+    VERIFY(!m_bIsDeferred, "Fence can only be signaled from immediate context");
+    ValidatedCast<FenceNullImpl>(pFence)->Signal(Value);
+}
+
+void DeviceContextNullImpl::WaitForFence(IFence* pFence, Uint64 Value, bool FlushContext)
+{
+    VERIFY(!m_bIsDeferred, "Fence can only be waited from immediate context");
+    // Fences are signaled immediately by SignalFence(), so waiting for a value
+    // that has not been signaled yet would never complete
+    DEV_CHECK_ERR(pFence->GetCompletedValue() >= Value, "Waiting for value ", Value, " of fence '", pFence->GetDesc().Name,
+                  "' that has not been signaled will never complete");
+}
+
+void DeviceContextNullImpl::WaitForIdle()
+{
+    VERIFY(!m_bIsDeferred, "Only immediate contexts can be idled");
+}
+
+void DeviceContextNullImpl::BeginQuery(IQuery* pQuery)
+{
+    TDeviceContextBase::BeginQuery(pQuery, 0);
+}
+
+void DeviceContextNullImpl::EndQuery(IQuery* pQuery)
+{
+    TDeviceContextBase::EndQuery(pQuery, 0);
+}
+
+void DeviceContextNullImpl::Flush()
+{
+    if (m_pActiveRenderPass != nullptr)
+    {
+        LOG_ERROR_MESSAGE("Flushing device context inside an active render pass.");
+    }
+}
+
+void DeviceContextNullImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
+{
+    UNSUPPORTED("BuildBLAS is not supported in Null backend");
+}
+
+void DeviceContextNullImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
+{
+    UNSUPPORTED("BuildTLAS is not supported in Null backend");
+}
+
+void DeviceContextNullImpl::CopyBLAS(const CopyBLASAttribs& Attribs)
+{
+    UNSUPPORTED("CopyBLAS is not supported in Null backend");
+}
+
+void DeviceContextNullImpl::CopyTLAS(const CopyTLASAttribs& Attribs)
+{
+    UNSUPPORTED("CopyTLAS is not supported in Null backend");
+}
+
+void DeviceContextNullImpl::WriteBLASCompactedSize(const WriteBLASCompactedSizeAttribs& Attribs)
+{
+    UNSUPPORTED("WriteBLASCompactedSize is not supported in Null backend");
+}
+
+void DeviceContextNullImpl::WriteTLASCompactedSize(const WriteTLASCompactedSizeAttribs& Attribs)
+{
+    UNSUPPORTED("WriteTLASCompactedSize is not supported in Null backend");
+}
+
+void DeviceContextNullImpl::TraceRays(const TraceRaysAttribs& Attribs)
+{
+    UNSUPPORTED("TraceRays is not supported in Null backend");
+}
+
+} // namespace Diligent
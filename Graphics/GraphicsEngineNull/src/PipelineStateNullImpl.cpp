@@ -0,0 +1,267 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "PipelineStateNullImpl.hpp"
+#include "ShaderResourceBindingNullImpl.hpp"
+#include "BindlessResourceTableBase.hpp"
+#include "FixedLinearAllocator.hpp"
+#include "EngineMemory.h"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+template <typename PSOCreateInfoType>
+void PipelineStateNullImpl::InitInternalObjects(const PSOCreateInfoType& CreateInfo)
+{
+    m_ResourceLayoutIndex.fill(-1);
+
+    std::vector<ShaderNullImpl*> Shaders;
+    ExtractShaders<ShaderNullImpl>(CreateInfo, Shaders);
+
+    const auto NumShaderStages = GetNumShaderStages();
+    VERIFY_EXPR(NumShaderStages > 0 && NumShaderStages == Shaders.size());
+
+    FixedLinearAllocator MemPool{GetRawAllocator()};
+
+    MemPool.AddSpace<ShaderResourceLayoutNull>(NumShaderStages);
+
+    ReserveSpaceForPipelineDesc(CreateInfo, MemPool);
+
+    MemPool.Reserve();
+
+    m_pStaticResourceLayouts = MemPool.Allocate<ShaderResourceLayoutNull>(NumShaderStages);
+    for (Uint32 i = 0; i < NumShaderStages; ++i)
+        new (m_pStaticResourceLayouts + i) ShaderResourceLayoutNull{*this}; // noexcept
+
+    // The memory is now owned by PipelineStateNullImpl and will be freed by Destruct().
+    auto* Ptr = MemPool.ReleaseOwnership();
+    VERIFY_EXPR(Ptr == m_pStaticResourceLayouts);
+    (void)Ptr;
+
+    InitializePipelineDesc(CreateInfo, MemPool);
+
+    m_Shaders.reserve(NumShaderStages);
+    for (auto* pShader : Shaders)
+    {
+        m_Shaders.emplace_back(pShader);
+        HashCombine(m_ShaderResourceLayoutHash, pShader->GetNullResources()->GetHash());
+    }
+
+    // It is important to construct all objects before initializing them because if an exception is thrown,
+    // destructors will be called for all objects
+
+    InitResourceLayouts();
+}
+
+
+PipelineStateNullImpl::PipelineStateNullImpl(IReferenceCounters*                    pRefCounters,
+                                             RenderDeviceNullImpl*                  pDevice,
+                                             const GraphicsPipelineStateCreateInfo& CreateInfo) :
+    TPipelineStateBase{pRefCounters, pDevice, CreateInfo}
+{
+    try
+    {
+        auto Initialize = [this](const GraphicsPipelineStateCreateInfo& CI) { InitInternalObjects(CI); };
+        if (!DeferInitialization(CreateInfo, Initialize))
+            Initialize(CreateInfo);
+    }
+    catch (...)
+    {
+        Destruct();
+        throw;
+    }
+}
+
+PipelineStateNullImpl::PipelineStateNullImpl(IReferenceCounters*                   pRefCounters,
+                                             RenderDeviceNullImpl*                 pDevice,
+                                             const ComputePipelineStateCreateInfo& CreateInfo) :
+    TPipelineStateBase{pRefCounters, pDevice, CreateInfo}
+{
+    try
+    {
+        auto Initialize = [this](const ComputePipelineStateCreateInfo& CI) { InitInternalObjects(CI); };
+        if (!DeferInitialization(CreateInfo, Initialize))
+            Initialize(CreateInfo);
+    }
+    catch (...)
+    {
+        Destruct();
+        throw;
+    }
+}
+
+PipelineStateNullImpl::~PipelineStateNullImpl()
+{
+    Destruct();
+}
+
+void PipelineStateNullImpl::Destruct()
+{
+    TPipelineStateBase::Destruct();
+
+    if (m_pStaticResourceLayouts != nullptr)
+    {
+        for (Uint32 l = 0; l < GetNumShaderStages(); ++l)
+        {
+            m_pStaticResourceLayouts[l].~ShaderResourceLayoutNull();
+        }
+    }
+
+    // All subobjects are allocated in contiguous chunks of memory.
+    if (auto* pRawMem = m_pStaticResourceLayouts)
+        GetRawAllocator().Free(pRawMem);
+}
+
+void PipelineStateNullImpl::InitResourceLayouts()
+{
+    for (Uint32 s = 0; s < m_Shaders.size(); ++s)
+    {
+        const auto* pShader    = m_Shaders[s].RawPtr();
+        const auto& ShaderDesc = pShader->GetDesc();
+
+        const auto& Resources = *pShader->GetNullResources();
+        for (Uint32 r = 0; r < Resources.GetNumResources(); ++r)
+        {
+            const auto& Attribs = Resources.GetResource(r);
+            if (Attribs.IsUnboundedArray())
+                GetUnboundedArrayBindlessType(m_pBindlessTable, Attribs.Type, Attribs.Name.c_str(), ShaderDesc.Name, m_Desc.Name);
+        }
+
+        // Static resource layout only contains static variables
+        const SHADER_RESOURCE_VARIABLE_TYPE StaticVarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_STATIC};
+        m_pStaticResourceLayouts[s].Initialize(pShader->GetNullResources(), m_Desc.ResourceLayout, StaticVarTypes, _countof(StaticVarTypes));
+
+        auto ShaderInd                   = GetShaderTypePipelineIndex(ShaderDesc.ShaderType, m_Desc.PipelineType);
+        m_ResourceLayoutIndex[ShaderInd] = static_cast<Int8>(s);
+    }
+}
+
+void PipelineStateNullImpl::CreateShaderResourceBinding(IShaderResourceBinding** ppShaderResourceBinding, bool InitStaticResources)
+{
+    WaitForAsyncInitialization();
+
+    if (auto* pPooledSRB = TakeSRBFromPool<ShaderResourceBindingNullImpl>())
+    {
+        if (InitStaticResources)
+            pPooledSRB->InitializeStaticResources(nullptr);
+        // Transfer the reference held by the pool to the caller
+        *ppShaderResourceBinding = pPooledSRB;
+        return;
+    }
+
+    auto& SRBAllocator      = GetDevice()->GetSRBAllocator();
+    auto  pShaderResBinding = NEW_RC_OBJ(SRBAllocator, "ShaderResourceBindingNullImpl instance", ShaderResourceBindingNullImpl)(this, false);
+    if (InitStaticResources)
+        pShaderResBinding->InitializeStaticResources(nullptr);
+    pShaderResBinding->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(static_cast<IShaderResourceBinding**>(ppShaderResourceBinding)));
+}
+
+bool PipelineStateNullImpl::IsCompatibleWith(const IPipelineState* pPSO) const
+{
+    VERIFY_EXPR(pPSO != nullptr);
+
+    if (pPSO == this)
+        return true;
+
+    const auto* pPSONull = ValidatedCast<const PipelineStateNullImpl>(pPSO);
+    WaitForAsyncInitialization();
+    pPSONull->WaitForAsyncInitialization();
+
+    if (m_ShaderResourceLayoutHash != pPSONull->m_ShaderResourceLayoutHash)
+        return false;
+
+    if (m_pBindlessTable != pPSONull->m_pBindlessTable)
+        return false;
+
+    if (GetNumShaderStages() != pPSONull->GetNumShaderStages())
+        return false;
+
+    for (Uint32 s = 0; s < GetNumShaderStages(); ++s)
+    {
+        const auto* pShader0 = GetShader(s);
+        const auto* pShader1 = pPSONull->GetShader(s);
+        if (pShader0->GetDesc().ShaderType != pShader1->GetDesc().ShaderType)
+            return false;
+        if (!pShader0->GetNullResources()->IsCompatibleWith(*pShader1->GetNullResources()))
+            return false;
+    }
+
+    return true;
+}
+
+void PipelineStateNullImpl::BindStaticResources(Uint32 ShaderFlags, IResourceMapping* pResourceMapping, Uint32 Flags)
+{
+    WaitForAsyncInitialization();
+
+    for (Uint32 s = 0; s < GetNumShaderStages(); ++s)
+    {
+        auto& StaticResLayout = m_pStaticResourceLayouts[s];
+        if ((ShaderFlags & StaticResLayout.GetShaderType()) != 0)
+            StaticResLayout.BindResources(pResourceMapping, Flags);
+    }
+}
+
+Uint32 PipelineStateNullImpl::GetStaticVariableCount(SHADER_TYPE ShaderType) const
+{
+    WaitForAsyncInitialization();
+
+    const auto LayoutInd = GetStaticVariableCountHelper(ShaderType, m_ResourceLayoutIndex);
+    if (LayoutInd < 0)
+        return 0;
+
+    VERIFY_EXPR(static_cast<Uint32>(LayoutInd) <= GetNumShaderStages());
+    return m_pStaticResourceLayouts[LayoutInd].GetTotalResourceCount();
+}
+
+IShaderResourceVariable* PipelineStateNullImpl::GetStaticVariableByName(SHADER_TYPE ShaderType, const Char* Name)
+{
+    WaitForAsyncInitialization();
+
+    const auto LayoutInd = GetStaticVariableByNameHelper(ShaderType, Name, m_ResourceLayoutIndex);
+    if (LayoutInd < 0)
+        return nullptr;
+
+    VERIFY_EXPR(static_cast<Uint32>(LayoutInd) <= GetNumShaderStages());
+    return m_pStaticResourceLayouts[LayoutInd].GetShaderVariable(Name);
+}
+
+IShaderResourceVariable* PipelineStateNullImpl::GetStaticVariableByIndex(SHADER_TYPE ShaderType, Uint32 Index)
+{
+    WaitForAsyncInitialization();
+
+    const auto LayoutInd = GetStaticVariableByIndexHelper(ShaderType, Index, m_ResourceLayoutIndex);
+    if (LayoutInd < 0)
+        return nullptr;
+
+    VERIFY_EXPR(static_cast<Uint32>(LayoutInd) <= GetNumShaderStages());
+    return m_pStaticResourceLayouts[LayoutInd].GetShaderVariable(Index);
+}
+
+} // namespace Diligent
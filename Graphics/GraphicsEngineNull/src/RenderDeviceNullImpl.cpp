@@ -0,0 +1,325 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "RenderDeviceNullImpl.hpp"
+#include "DeviceContextNullImpl.hpp"
+#include "BufferNullImpl.hpp"
+#include "BufferViewNullImpl.hpp"
+#include "ShaderNullImpl.hpp"
+#include "TextureNullImpl.hpp"
+#include "TextureViewNullImpl.hpp"
+#include "SamplerNullImpl.hpp"
+#include "PipelineStateNullImpl.hpp"
+#include "ShaderResourceBindingNullImpl.hpp"
+#include "FenceNullImpl.hpp"
+#include "QueryNullImpl.hpp"
+#include "RenderPassNullImpl.hpp"
+#include "FramebufferNullImpl.hpp"
+#include "BindlessResourceTableNullImpl.hpp"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+RenderDeviceNullImpl::RenderDeviceNullImpl(IReferenceCounters*         pRefCounters,
+                                           IMemoryAllocator&           RawMemAllocator,
+                                           IEngineFactory*             pEngineFactory,
+                                           const EngineNullCreateInfo& EngineCI,
+                                           Uint32                      NumDeferredContexts) :
+    // clang-format off
+    TRenderDeviceBase
+    {
+        pRefCounters,
+        RawMemAllocator,
+        pEngineFactory,
+        NumDeferredContexts,
+        DeviceObjectSizes
+        {
+            sizeof(TextureNullImpl),
+            sizeof(TextureViewNullImpl),
+            sizeof(BufferNullImpl),
+            sizeof(BufferViewNullImpl),
+            sizeof(ShaderNullImpl),
+            sizeof(SamplerNullImpl),
+            sizeof(PipelineStateNullImpl),
+            sizeof(ShaderResourceBindingNullImpl),
+            sizeof(FenceNullImpl),
+            sizeof(QueryNullImpl),
+            sizeof(RenderPassNullImpl),
+            sizeof(FramebufferNullImpl),
+            0,
+            0,
+            0,
+            0,
+            sizeof(BindlessResourceTableNullImpl)
+        }
+    }
+// clang-format on
+{
+    static_assert(sizeof(DeviceObjectSizes) == sizeof(size_t) * 17, "Please add new objects to DeviceObjectSizes constructor");
+
+    m_DeviceCaps.DevType      = RENDER_DEVICE_TYPE_NULL;
+    m_DeviceCaps.MajorVersion = 1;
+    m_DeviceCaps.MinorVersion = 0;
+
+    // Null device does not execute any commands, so it can expose every feature
+    // except for ray tracing that requires acceleration structures.
+    m_DeviceCaps.Features = DeviceFeatures{DEVICE_FEATURE_STATE_ENABLED};
+    if (EngineCI.Features.RayTracing == DEVICE_FEATURE_STATE_ENABLED)
+        LOG_ERROR_AND_THROW("Ray tracing is not supported by Null device");
+    m_DeviceCaps.Features.RayTracing = DEVICE_FEATURE_STATE_DISABLED;
+
+    m_DeviceCaps.AdapterInfo.Type = ADAPTER_TYPE_SOFTWARE;
+
+    auto& TexCaps = m_DeviceCaps.TexCaps;
+
+    TexCaps.MaxTexture1DDimension     = 16384;
+    TexCaps.MaxTexture1DArraySlices   = 2048;
+    TexCaps.MaxTexture2DDimension     = 16384;
+    TexCaps.MaxTexture2DArraySlices   = 2048;
+    TexCaps.MaxTexture3DDimension     = 2048;
+    TexCaps.MaxTextureCubeDimension   = 16384;
+    TexCaps.Texture2DMSSupported      = True;
+    TexCaps.Texture2DMSArraySupported = True;
+    TexCaps.TextureViewSupported      = True;
+    TexCaps.CubemapArraysSupported    = True;
+
+    auto& SamCaps = m_DeviceCaps.SamCaps;
+
+    SamCaps.BorderSamplingModeSupported   = True;
+    SamCaps.AnisotropicFilteringSupported = True;
+    SamCaps.LODBiasSupported              = True;
+}
+
+void RenderDeviceNullImpl::TestTextureFormat(TEXTURE_FORMAT TexFormat)
+{
+    auto& TexFormatInfo = m_TextureFormatsInfo[TexFormat];
+    VERIFY(TexFormatInfo.Supported, "Texture format is not supported");
+
+    TexFormatInfo.Filterable = true;
+    TexFormatInfo.BindFlags  = BIND_SHADER_RESOURCE;
+    TexFormatInfo.Dimensions = RESOURCE_DIMENSION_SUPPORT_TEX_1D | RESOURCE_DIMENSION_SUPPORT_TEX_1D_ARRAY |
+        RESOURCE_DIMENSION_SUPPORT_TEX_2D | RESOURCE_DIMENSION_SUPPORT_TEX_2D_ARRAY |
+        RESOURCE_DIMENSION_SUPPORT_TEX_CUBE | RESOURCE_DIMENSION_SUPPORT_TEX_CUBE_ARRAY;
+    TexFormatInfo.SampleCounts = 0x01;
+
+    if (TexFormatInfo.ComponentType == COMPONENT_TYPE_COMPRESSED)
+        return;
+
+    if (TexFormatInfo.ComponentType == COMPONENT_TYPE_DEPTH ||
+        TexFormatInfo.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+    {
+        TexFormatInfo.BindFlags |= BIND_DEPTH_STENCIL;
+    }
+    else
+    {
+        TexFormatInfo.BindFlags |= BIND_RENDER_TARGET | BIND_UNORDERED_ACCESS;
+        TexFormatInfo.Dimensions |= RESOURCE_DIMENSION_SUPPORT_TEX_3D;
+    }
+    TexFormatInfo.SampleCounts = 0x01 | 0x02 | 0x04 | 0x08;
+}
+
+void RenderDeviceNullImpl::CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer)
+{
+    CreateDeviceObject("buffer", BuffDesc, ppBuffer,
+                       [&]() //
+                       {
+                           BufferNullImpl* pBufferNull{NEW_RC_OBJ(m_BufObjAllocator, "BufferNullImpl instance", BufferNullImpl)(m_BuffViewObjAllocator, this, BuffDesc, pBuffData)};
+                           pBufferNull->QueryInterface(IID_Buffer, reinterpret_cast<IObject**>(ppBuffer));
+                           pBufferNull->CreateDefaultViews();
+                           OnCreateDeviceObject(pBufferNull);
+                       });
+}
+
+void RenderDeviceNullImpl::CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader)
+{
+    CreateDeviceObject("shader", ShaderCI.Desc, ppShader,
+                       [&]() //
+                       {
+                           ShaderNullImpl* pShaderNull{NEW_RC_OBJ(m_ShaderObjAllocator, "ShaderNullImpl instance", ShaderNullImpl)(this, ShaderCI)};
+                           pShaderNull->QueryInterface(IID_Shader, reinterpret_cast<IObject**>(ppShader));
+
+                           OnCreateDeviceObject(pShaderNull);
+                       });
+}
+
+void RenderDeviceNullImpl::CreateTexture(const TextureDesc& TexDesc, const TextureData* pData, ITexture** ppTexture)
+{
+    CreateDeviceObject("texture", TexDesc, ppTexture,
+                       [&]() //
+                       {
+                           TextureNullImpl* pTextureNull{NEW_RC_OBJ(m_TexObjAllocator, "TextureNullImpl instance", TextureNullImpl)(m_TexViewObjAllocator, this, TexDesc, pData)};
+                           pTextureNull->QueryInterface(IID_Texture, reinterpret_cast<IObject**>(ppTexture));
+                           pTextureNull->CreateDefaultViews();
+                           OnCreateDeviceObject(pTextureNull);
+                       });
+}
+
+void RenderDeviceNullImpl::CreateSampler(const SamplerDesc& SamplerDesc, ISampler** ppSampler)
+{
+    CreateDeviceObject("sampler", SamplerDesc, ppSampler,
+                       [&]() //
+                       {
+                           m_SamplersRegistry.Find(SamplerDesc, reinterpret_cast<IDeviceObject**>(ppSampler));
+                           if (*ppSampler == nullptr)
+                           {
+                               SamplerNullImpl* pSamplerNull{NEW_RC_OBJ(m_SamplerObjAllocator, "SamplerNullImpl instance", SamplerNullImpl)(this, SamplerDesc)};
+                               pSamplerNull->QueryInterface(IID_Sampler, reinterpret_cast<IObject**>(ppSampler));
+                               OnCreateDeviceObject(pSamplerNull);
+                               m_SamplersRegistry.Add(SamplerDesc, *ppSampler);
+                           }
+                       });
+}
+
+template <typename PSOCreateInfoType>
+void RenderDeviceNullImpl::CreatePipelineState(const PSOCreateInfoType& PSOCreateInfo, IPipelineState** ppPipelineState)
+{
+    CreateDeviceObject("Pipeline state", PSOCreateInfo.PSODesc, ppPipelineState,
+                       [&]() //
+                       {
+                           PipelineStateRegistryKey RegistryKey;
+                           if (FindSharedPipelineState<ShaderNullImpl>(PSOCreateInfo, RegistryKey, ppPipelineState))
+                               return;
+
+                           PipelineStateNullImpl* pPipelineStateNull{NEW_RC_OBJ(m_PSOAllocator, "PipelineStateNullImpl instance", PipelineStateNullImpl)(this, PSOCreateInfo)};
+                           pPipelineStateNull->QueryInterface(IID_PipelineState, reinterpret_cast<IObject**>(ppPipelineState));
+                           OnCreateDeviceObject(pPipelineStateNull);
+                           pPipelineStateNull->StartDeferredInitialization();
+                           AddSharedPipelineState(RegistryKey, *ppPipelineState);
+                       });
+}
+
+void RenderDeviceNullImpl::CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+{
+    CreatePipelineState(PSOCreateInfo, ppPipelineState);
+}
+
+void RenderDeviceNullImpl::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+{
+    CreatePipelineState(PSOCreateInfo, ppPipelineState);
+}
+
+void RenderDeviceNullImpl::CreateRayTracingPipelineState(const RayTracingPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+{
+    UNSUPPORTED("Ray tracing is not supported in Null backend");
+    *ppPipelineState = nullptr;
+}
+
+void RenderDeviceNullImpl::CreateFence(const FenceDesc& Desc, IFence** ppFence)
+{
+    CreateDeviceObject("Fence", Desc, ppFence,
+                       [&]() //
+                       {
+                           FenceNullImpl* pFenceNull{NEW_RC_OBJ(m_FenceAllocator, "FenceNullImpl instance", FenceNullImpl)(this, Desc)};
+                           pFenceNull->QueryInterface(IID_Fence, reinterpret_cast<IObject**>(ppFence));
+                           OnCreateDeviceObject(pFenceNull);
+                       });
+}
+
+void RenderDeviceNullImpl::CreateQuery(const QueryDesc& Desc, IQuery** ppQuery)
+{
+    CreateDeviceObject("Query", Desc, ppQuery,
+                       [&]() //
+                       {
+                           QueryNullImpl* pQueryNull{NEW_RC_OBJ(m_QueryAllocator, "QueryNullImpl instance", QueryNullImpl)(this, Desc)};
+                           pQueryNull->QueryInterface(IID_Query, reinterpret_cast<IObject**>(ppQuery));
+                           OnCreateDeviceObject(pQueryNull);
+                       });
+}
+
+void RenderDeviceNullImpl::CreateRenderPass(const RenderPassDesc& Desc, IRenderPass** ppRenderPass)
+{
+    CreateDeviceObject("RenderPass", Desc, ppRenderPass,
+                       [&]() //
+                       {
+                           RenderPassNullImpl* pRenderPassNull{NEW_RC_OBJ(m_RenderPassAllocator, "RenderPassNullImpl instance", RenderPassNullImpl)(this, Desc)};
+                           pRenderPassNull->QueryInterface(IID_RenderPass, reinterpret_cast<IObject**>(ppRenderPass));
+                           OnCreateDeviceObject(pRenderPassNull);
+                       });
+}
+
+void RenderDeviceNullImpl::CreateFramebuffer(const FramebufferDesc& Desc, IFramebuffer** ppFramebuffer)
+{
+    CreateDeviceObject("Framebuffer", Desc, ppFramebuffer,
+                       [&]() //
+                       {
+                           FramebufferNullImpl* pFramebufferNull{NEW_RC_OBJ(m_FramebufferAllocator, "FramebufferNullImpl instance", FramebufferNullImpl)(this, Desc)};
+                           pFramebufferNull->QueryInterface(IID_Framebuffer, reinterpret_cast<IObject**>(ppFramebuffer));
+                           OnCreateDeviceObject(pFramebufferNull);
+                       });
+}
+
+void RenderDeviceNullImpl::CreateBLAS(const BottomLevelASDesc& Desc,
+                                      IBottomLevelAS**         ppBLAS)
+{
+    UNSUPPORTED("CreateBLAS is not supported in Null backend");
+    *ppBLAS = nullptr;
+}
+
+void RenderDeviceNullImpl::CreateTLAS(const TopLevelASDesc& Desc,
+                                      ITopLevelAS**         ppTLAS)
+{
+    UNSUPPORTED("CreateTLAS is not supported in Null backend");
+    *ppTLAS = nullptr;
+}
+
+void RenderDeviceNullImpl::CreateSBT(const ShaderBindingTableDesc& Desc,
+                                     IShaderBindingTable**         ppSBT)
+{
+    UNSUPPORTED("CreateSBT is not supported in Null backend");
+    *ppSBT = nullptr;
+}
+
+void RenderDeviceNullImpl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                    IPipelineStateCache**               ppPSOCache)
+{
+    // Pipeline state caches are not supported in Null backend, so pipelines are always created without one.
+    *ppPSOCache = nullptr;
+}
+
+void RenderDeviceNullImpl::CreateBindlessResourceTable(const BindlessResourceTableDesc& Desc,
+                                                       IBindlessResourceTable**         ppBindlessTable)
+{
+    CreateDeviceObject("BindlessResourceTable", Desc, ppBindlessTable,
+                       [&]() //
+                       {
+                           BindlessResourceTableNullImpl* pTableNull(NEW_RC_OBJ(m_BindlessTableAllocator, "BindlessResourceTableNullImpl instance", BindlessResourceTableNullImpl)(this, Desc));
+                           pTableNull->QueryInterface(IID_BindlessResourceTable, reinterpret_cast<IObject**>(ppBindlessTable));
+                           OnCreateDeviceObject(pTableNull);
+                       });
+}
+
+void RenderDeviceNullImpl::IdleGPU()
+{
+    if (auto pImmediateCtx = m_wpImmediateContext.Lock())
+    {
+        pImmediateCtx->WaitForIdle();
+    }
+}
+
+} // namespace Diligent
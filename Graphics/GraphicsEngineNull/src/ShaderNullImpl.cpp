@@ -0,0 +1,74 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "ShaderNullImpl.hpp"
+#include "ShaderPreprocessor.hpp"
+
+namespace Diligent
+{
+
+ShaderNullImpl::ShaderNullImpl(IReferenceCounters*     pRefCounters,
+                               RenderDeviceNullImpl*   pDevice,
+                               const ShaderCreateInfo& ShaderCI) :
+    // clang-format off
+    TShaderBase
+    {
+        pRefCounters,
+        pDevice,
+        ShaderCI.Desc
+    }
+// clang-format on
+{
+    std::string Source;
+    if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
+    {
+        if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_MSL)
+            LOG_ERROR_AND_THROW("Metal shading language is not supported by the Null backend");
+
+        // The preprocessor reports errors by throwing an exception
+        PreprocessShaderSource(ShaderCI, nullptr, &Source, nullptr);
+        InitBytecodeId(Source.data(), Source.size(), ShaderCI);
+    }
+    else
+    {
+        DEV_CHECK_ERR(ShaderCI.ByteCode != nullptr, "Shader source or byte code must be provided");
+        LOG_WARNING_MESSAGE("Shader '", m_Desc.Name, "' is created from byte code that the Null backend can't reflect. The shader will not expose any resources.");
+        InitBytecodeId(ShaderCI.ByteCode, ShaderCI.ByteCodeSize, ShaderCI);
+    }
+
+    m_pShaderResources = std::make_shared<const ShaderResourcesNull>(
+        m_Desc.ShaderType, m_Desc.Name, Source,
+        ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr);
+}
+
+ShaderNullImpl::~ShaderNullImpl()
+{
+}
+
+} // namespace Diligent
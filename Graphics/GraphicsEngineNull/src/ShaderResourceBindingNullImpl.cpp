@@ -0,0 +1,238 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "ShaderResourceBindingNullImpl.hpp"
+#include "PipelineStateNullImpl.hpp"
+#include "ShaderNullImpl.hpp"
+#include "FixedLinearAllocator.hpp"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+ShaderResourceBindingNullImpl::ShaderResourceBindingNullImpl(IReferenceCounters*    pRefCounters,
+                                                             PipelineStateNullImpl* pPSO,
+                                                             bool                   IsInternal) :
+    TBase{pRefCounters, pPSO, IsInternal}
+{
+    try
+    {
+        m_ResourceLayoutIndex.fill(-1);
+        m_NumActiveShaders = static_cast<Uint8>(pPSO->GetNumShaderStages());
+
+        FixedLinearAllocator MemPool{GetRawAllocator()};
+        MemPool.AddSpace<ShaderResourceLayoutNull>(m_NumActiveShaders);
+
+        MemPool.Reserve();
+
+        m_pResourceLayouts = MemPool.Allocate<ShaderResourceLayoutNull>(m_NumActiveShaders);
+        for (Uint8 s = 0; s < m_NumActiveShaders; ++s)
+            new (m_pResourceLayouts + s) ShaderResourceLayoutNull{*this}; // noexcept
+
+        // The memory is now owned by ShaderResourceBindingNullImpl and will be freed by Destruct().
+        auto* Ptr = MemPool.ReleaseOwnership();
+        VERIFY_EXPR(Ptr == m_pResourceLayouts);
+        (void)Ptr;
+
+        // It is important to construct all objects before initializing them because if an exception is thrown,
+        // destructors will be called for all objects
+
+        const auto& PSODesc = pPSO->GetDesc();
+        for (Uint8 s = 0; s < m_NumActiveShaders; ++s)
+        {
+            const auto* pShaderNull = pPSO->GetShader(s);
+
+            // Shader resource layout will only contain dynamic and mutable variables
+            const SHADER_RESOURCE_VARIABLE_TYPE VarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
+            m_pResourceLayouts[s].Initialize(pShaderNull->GetNullResources(), PSODesc.ResourceLayout, VarTypes, _countof(VarTypes));
+
+            const auto ShaderType = pShaderNull->GetDesc().ShaderType;
+            const auto ShaderInd  = GetShaderTypePipelineIndex(ShaderType, PSODesc.PipelineType);
+            VERIFY_EXPR(ShaderType == m_pResourceLayouts[s].GetShaderType());
+            m_ShaderTypes[s] = ShaderType;
+
+            m_ResourceLayoutIndex[ShaderInd] = s;
+        }
+    }
+    catch (...)
+    {
+        Destruct();
+        throw;
+    }
+}
+
+ShaderResourceBindingNullImpl::~ShaderResourceBindingNullImpl()
+{
+    Destruct();
+}
+
+void ShaderResourceBindingNullImpl::Destruct()
+{
+    if (m_pResourceLayouts != nullptr)
+    {
+        for (Int32 l = 0; l < m_NumActiveShaders; ++l)
+        {
+            m_pResourceLayouts[l].~ShaderResourceLayoutNull();
+        }
+    }
+
+    if (void* pRawMem = m_pResourceLayouts)
+    {
+        GetRawAllocator().Free(pRawMem);
+    }
+}
+
+void ShaderResourceBindingNullImpl::BindResources(Uint32 ShaderFlags, IResourceMapping* pResMapping, Uint32 Flags)
+{
+    for (Uint32 ResLayoutInd = 0; ResLayoutInd < m_NumActiveShaders; ++ResLayoutInd)
+    {
+        auto& ResLayout = m_pResourceLayouts[ResLayoutInd];
+        if (ShaderFlags & ResLayout.GetShaderType())
+        {
+            ResLayout.BindResources(pResMapping, Flags);
+        }
+    }
+}
+
+void ShaderResourceBindingNullImpl::InitializeStaticResources(const IPipelineState* pPipelineState)
+{
+    if (m_bIsStaticResourcesBound)
+    {
+        LOG_WARNING_MESSAGE("Static resources have already been initialized in this shader resource binding object. The operation will be ignored.");
+        return;
+    }
+
+    if (pPipelineState == nullptr)
+    {
+        pPipelineState = GetPipelineState();
+    }
+    else
+    {
+        DEV_CHECK_ERR(pPipelineState->IsCompatibleWith(GetPipelineState()), "The pipeline state is not compatible with this SRB");
+    }
+
+    const auto* pPSONull   = ValidatedCast<const PipelineStateNullImpl>(pPipelineState);
+    auto        NumShaders = pPSONull->GetNumShaderStages();
+    VERIFY_EXPR(NumShaders == m_NumActiveShaders);
+
+    for (Uint32 shader = 0; shader < NumShaders; ++shader)
+    {
+        const auto& StaticResLayout = pPSONull->GetStaticResourceLayout(shader);
+#ifdef DILIGENT_DEVELOPMENT
+        if (!StaticResLayout.dvpVerifyBindings())
+        {
+            LOG_ERROR_MESSAGE("Static resources in SRB of PSO '", pPSONull->GetDesc().Name,
+                              "' will not be successfully initialized because not all static resource bindings in shader '",
+                              pPSONull->GetShader(shader)->GetDesc().Name,
+                              "' are valid. Please make sure you bind all static resources to PSO before calling InitializeStaticResources() "
+                              "directly or indirectly by passing InitStaticResources=true to CreateShaderResourceBinding() method.");
+        }
+#endif
+        StaticResLayout.CopyResources(m_pResourceLayouts[shader]);
+    }
+
+    m_bIsStaticResourcesBound = true;
+}
+
+void ShaderResourceBindingNullImpl::Clone(IShaderResourceBinding** ppClone)
+{
+    DEV_CHECK_ERR(ppClone != nullptr, "Pointer to the clone must not be null");
+
+    RefCntAutoPtr<IShaderResourceBinding> pClone;
+    m_pPSO->CreateShaderResourceBinding(&pClone, false);
+    if (!pClone)
+        return;
+
+    auto* pCloneNull = pClone.RawPtr<ShaderResourceBindingNullImpl>();
+    VERIFY_EXPR(pCloneNull->m_NumActiveShaders == m_NumActiveShaders);
+    for (Uint32 s = 0; s < m_NumActiveShaders; ++s)
+        pCloneNull->m_pResourceLayouts[s].CopyResourceCache(m_pResourceLayouts[s]);
+    pCloneNull->m_bIsStaticResourcesBound = m_bIsStaticResourcesBound;
+
+    *ppClone = pClone.Detach();
+}
+
+void ShaderResourceBindingNullImpl::ResetResources()
+{
+    for (Uint32 s = 0; s < m_NumActiveShaders; ++s)
+        m_pResourceLayouts[s].ResetResourceCache();
+    m_bIsStaticResourcesBound = false;
+}
+
+IShaderResourceVariable* ShaderResourceBindingNullImpl::GetVariableByName(SHADER_TYPE ShaderType, const char* Name)
+{
+    auto ResLayoutInd = GetVariableByNameHelper(ShaderType, Name, m_ResourceLayoutIndex);
+    if (ResLayoutInd < 0)
+        return nullptr;
+
+    VERIFY_EXPR(static_cast<Uint32>(ResLayoutInd) < Uint32{m_NumActiveShaders});
+    return m_pResourceLayouts[ResLayoutInd].GetShaderVariable(Name);
+}
+
+Uint32 ShaderResourceBindingNullImpl::GetVariableCount(SHADER_TYPE ShaderType) const
+{
+    auto ResLayoutInd = GetVariableCountHelper(ShaderType, m_ResourceLayoutIndex);
+    if (ResLayoutInd < 0)
+        return 0;
+
+    VERIFY_EXPR(static_cast<Uint32>(ResLayoutInd) < Uint32{m_NumActiveShaders});
+    return m_pResourceLayouts[ResLayoutInd].GetTotalResourceCount();
+}
+
+IShaderResourceVariable* ShaderResourceBindingNullImpl::GetVariableByIndex(SHADER_TYPE ShaderType, Uint32 Index)
+{
+    auto ResLayoutInd = GetVariableByIndexHelper(ShaderType, Index, m_ResourceLayoutIndex);
+    if (ResLayoutInd < 0)
+        return nullptr;
+
+    VERIFY_EXPR(static_cast<Uint32>(ResLayoutInd) < Uint32{m_NumActiveShaders});
+    return m_pResourceLayouts[ResLayoutInd].GetShaderVariable(Index);
+}
+
+Uint32 ShaderResourceBindingNullImpl::GetVariableHandle(SHADER_TYPE ShaderType, const char* Name)
+{
+    auto ResLayoutInd = GetVariableByNameHelper(ShaderType, Name, m_ResourceLayoutIndex);
+    if (ResLayoutInd < 0)
+        return INVALID_SHADER_VARIABLE_HANDLE;
+
+    VERIFY_EXPR(static_cast<Uint32>(ResLayoutInd) < Uint32{m_NumActiveShaders});
+    auto* pVar = m_pResourceLayouts[ResLayoutInd].GetShaderVariable(Name);
+    return pVar != nullptr ? PackVariableHandle(ResLayoutInd, pVar->GetIndex()) : INVALID_SHADER_VARIABLE_HANDLE;
+}
+
+void ShaderResourceBindingNullImpl::SetVariables(const Uint32* pHandles, IDeviceObject* const* ppObjects, Uint32 NumVariables)
+{
+    SetVariablesHelper(pHandles, ppObjects, NumVariables, m_NumActiveShaders,
+                       [this](Uint32 ResLayoutInd, Uint32 VarIndex, IDeviceObject* pObject) //
+                       {
+                           m_pResourceLayouts[ResLayoutInd].BindVariable(VarIndex, pObject);
+                       });
+}
+
+} // namespace Diligent
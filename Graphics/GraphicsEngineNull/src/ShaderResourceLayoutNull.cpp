@@ -0,0 +1,336 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "ShaderResourceLayoutNull.hpp"
+#include "ResourceMapping.h"
+#include "TopLevelAS.h"
+
+namespace Diligent
+{
+
+void ShaderResourceLayoutNull::Initialize(std::shared_ptr<const ShaderResourcesNull> pSrcResources,
+                                          const PipelineResourceLayoutDesc&          ResourceLayout,
+                                          const SHADER_RESOURCE_VARIABLE_TYPE*       AllowedVarTypes,
+                                          Uint32                                     NumAllowedTypes)
+{
+    m_pResources = std::move(pSrcResources);
+
+    const auto  AllowedTypeBits       = GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes);
+    const auto  ShaderType            = m_pResources->GetShaderType();
+    const auto* CombinedSamplerSuffix = m_pResources->GetCombinedSamplerSuffix();
+
+    m_ResourceCache.resize(m_pResources->GetCacheSize());
+
+    m_Variables.reserve(m_pResources->GetNumResources());
+    for (Uint32 r = 0; r < m_pResources->GetNumResources(); ++r)
+    {
+        const auto& Attribs = m_pResources->GetResource(r);
+        // Unbounded arrays are bound to the bindless resource table of the pipeline
+        if (Attribs.IsUnboundedArray())
+            continue;
+
+        if (Attribs.Type == SHADER_RESOURCE_TYPE_SAMPLER)
+        {
+            // Combined samplers are set through the texture views, and immutable
+            // samplers are never created in the resource layout
+            if (CombinedSamplerSuffix != nullptr)
+                continue;
+            if (FindImmutableSampler(ResourceLayout.ImmutableSamplers, ResourceLayout.NumImmutableSamplers, ShaderType, Attribs.Name.c_str(), nullptr) >= 0)
+                continue;
+        }
+
+        const auto VarType = GetShaderVariableType(ShaderType, Attribs.Name, ResourceLayout);
+        if (!IsAllowedType(VarType, AllowedTypeBits))
+            continue;
+
+        m_Variables.emplace_back(*this, Attribs, VarType);
+    }
+}
+
+void ShaderResourceLayoutNull::ShaderVariableNullImpl::BindResource(IDeviceObject* pObject, Uint32 ArrayIndex)
+{
+    DEV_CHECK_ERR(ArrayIndex < m_Attribs.ArraySize, "Array index (", ArrayIndex, ") is out of range for variable '", m_Attribs.Name, "'. Max allowed index: ", m_Attribs.ArraySize - 1);
+
+    auto& CachedResource = m_ParentResLayout.m_ResourceCache[m_Attribs.CacheOffset + ArrayIndex];
+    m_ParentResLayout.IncrementCacheVersion();
+
+    // We cannot use ValidatedCast<> here as the resource retrieved from the
+    // resource mapping can be of wrong type
+    RefCntAutoPtr<IDeviceObject> pResource;
+    switch (m_Attribs.Type)
+    {
+        case SHADER_RESOURCE_TYPE_CONSTANT_BUFFER:
+        {
+            RefCntAutoPtr<IBuffer> pBuffer{pObject, IID_Buffer};
+#ifdef DILIGENT_DEVELOPMENT
+            VerifyConstantBufferBinding(m_Attribs, GetType(), ArrayIndex, pObject, pBuffer.RawPtr(), CachedResource.RawPtr(), m_ParentResLayout.GetShaderName());
+#endif
+            pResource = std::move(pBuffer);
+            break;
+        }
+
+        case SHADER_RESOURCE_TYPE_TEXTURE_SRV:
+        case SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT:
+        {
+            RefCntAutoPtr<ITextureView> pView{pObject, IID_TextureView};
+#ifdef DILIGENT_DEVELOPMENT
+            VerifyResourceViewBinding(m_Attribs, GetType(), ArrayIndex, pObject, pView.RawPtr(), {TEXTURE_VIEW_SHADER_RESOURCE},
+                                      CachedResource.RawPtr(), m_ParentResLayout.GetShaderName());
+#endif
+            pResource = std::move(pView);
+            break;
+        }
+
+        case SHADER_RESOURCE_TYPE_TEXTURE_UAV:
+        {
+            RefCntAutoPtr<ITextureView> pView{pObject, IID_TextureView};
+#ifdef DILIGENT_DEVELOPMENT
+            VerifyResourceViewBinding(m_Attribs, GetType(), ArrayIndex, pObject, pView.RawPtr(), {TEXTURE_VIEW_UNORDERED_ACCESS},
+                                      CachedResource.RawPtr(), m_ParentResLayout.GetShaderName());
+#endif
+            pResource = std::move(pView);
+            break;
+        }
+
+        case SHADER_RESOURCE_TYPE_BUFFER_SRV:
+        {
+            RefCntAutoPtr<IBufferView> pView{pObject, IID_BufferView};
+#ifdef DILIGENT_DEVELOPMENT
+            VerifyResourceViewBinding(m_Attribs, GetType(), ArrayIndex, pObject, pView.RawPtr(), {BUFFER_VIEW_SHADER_RESOURCE},
+                                      CachedResource.RawPtr(), m_ParentResLayout.GetShaderName());
+#endif
+            pResource = std::move(pView);
+            break;
+        }
+
+        case SHADER_RESOURCE_TYPE_BUFFER_UAV:
+        {
+            RefCntAutoPtr<IBufferView> pView{pObject, IID_BufferView};
+#ifdef DILIGENT_DEVELOPMENT
+            VerifyResourceViewBinding(m_Attribs, GetType(), ArrayIndex, pObject, pView.RawPtr(), {BUFFER_VIEW_UNORDERED_ACCESS},
+                                      CachedResource.RawPtr(), m_ParentResLayout.GetShaderName());
+#endif
+            pResource = std::move(pView);
+            break;
+        }
+
+        case SHADER_RESOURCE_TYPE_SAMPLER:
+        {
+            RefCntAutoPtr<ISampler> pSampler{pObject, IID_Sampler};
+#ifdef DILIGENT_DEVELOPMENT
+            if (pObject != nullptr && pSampler == nullptr)
+            {
+                LOG_ERROR_MESSAGE("Failed to bind object '", pObject->GetDesc().Name, "' to variable '", m_Attribs.GetPrintName(ArrayIndex),
+                                  "' in shader '", m_ParentResLayout.GetShaderName(), "'. Invalid resource type: sampler is expected.");
+            }
+            if (GetType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC && CachedResource != nullptr && CachedResource.RawPtr() != pSampler.RawPtr())
+            {
+                auto VarTypeStr = GetShaderVariableTypeLiteralName(GetType());
+                LOG_ERROR_MESSAGE("Non-null sampler is already bound to ", VarTypeStr, " shader variable '", m_Attribs.GetPrintName(ArrayIndex),
+                                  "' in shader '", m_ParentResLayout.GetShaderName(), "'. Attempting to bind another sampler or null is an error and may "
+                                                                                      "cause unpredicted behavior. Use another shader resource binding instance or label the variable as dynamic.");
+            }
+#endif
+            pResource = std::move(pSampler);
+            break;
+        }
+
+        case SHADER_RESOURCE_TYPE_ACCEL_STRUCT:
+        {
+            RefCntAutoPtr<ITopLevelAS> pTLAS{pObject, IID_TopLevelAS};
+#ifdef DILIGENT_DEVELOPMENT
+            if (pTLAS != nullptr)
+                VerifyTLASResourceBinding(m_Attribs, GetType(), ArrayIndex, pTLAS.RawPtr(), CachedResource.RawPtr(), m_ParentResLayout.GetShaderName());
+#endif
+            pResource = std::move(pTLAS);
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unexpected resource type");
+    }
+
+    CachedResource = std::move(pResource);
+}
+
+
+namespace
+{
+
+// Helper class that facilitates binding resources from the resource mapping
+class BindResourceHelper
+{
+public:
+    BindResourceHelper(IResourceMapping& RM, Uint32 Fl) :
+        ResourceMapping{RM},
+        Flags{Fl}
+    {
+    }
+
+    template <typename ResourceType>
+    void Bind(ResourceType& Res)
+    {
+        if ((Flags & (1 << Res.GetType())) == 0)
+            return;
+
+        for (Uint32 elem = 0; elem < Res.m_Attribs.ArraySize; ++elem)
+        {
+            if ((Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) && Res.IsBound(elem))
+                continue;
+
+            const auto*                  VarName = Res.m_Attribs.Name.c_str();
+            RefCntAutoPtr<IDeviceObject> pRes;
+            ResourceMapping.GetResource(VarName, &pRes, elem);
+            if (pRes)
+            {
+                //  Call non-virtual function
+                Res.BindResource(pRes, elem);
+            }
+            else
+            {
+                if ((Flags & BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED) && !Res.IsBound(elem))
+                {
+                    LOG_ERROR_MESSAGE("Unable to bind resource to shader variable '", VarName,
+                                      "': resource is not found in the resource mapping");
+                }
+            }
+        }
+    }
+
+private:
+    IResourceMapping& ResourceMapping;
+    const Uint32      Flags;
+};
+
+} // namespace
+
+void ShaderResourceLayoutNull::BindResources(IResourceMapping* pResourceMapping, Uint32 Flags)
+{
+    if (pResourceMapping == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to bind resources in shader '", GetShaderName(), "': resource mapping is null");
+        return;
+    }
+
+    if ((Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) == 0)
+        Flags |= BIND_SHADER_RESOURCES_UPDATE_ALL;
+
+    BindResourceHelper BindResHelper(*pResourceMapping, Flags);
+    for (auto& Var : m_Variables)
+        BindResHelper.Bind(Var);
+}
+
+void ShaderResourceLayoutNull::CopyResources(ShaderResourceLayoutNull& DstLayout) const
+{
+    VERIFY(m_pResources->IsCompatibleWith(*DstLayout.m_pResources), "Incompatible resource layouts");
+    for (const auto& Var : m_Variables)
+    {
+        for (Uint32 elem = 0; elem < Var.m_Attribs.ArraySize; ++elem)
+        {
+            const auto CacheOffset                 = Var.m_Attribs.CacheOffset + elem;
+            DstLayout.m_ResourceCache[CacheOffset] = m_ResourceCache[CacheOffset];
+        }
+    }
+    DstLayout.IncrementCacheVersion();
+}
+
+void ShaderResourceLayoutNull::ResetResourceCache()
+{
+    for (auto& pResource : m_ResourceCache)
+        pResource.Release();
+    IncrementCacheVersion();
+}
+
+void ShaderResourceLayoutNull::CopyResourceCache(const ShaderResourceLayoutNull& SrcLayout)
+{
+    VERIFY(m_pResources->IsCompatibleWith(*SrcLayout.m_pResources), "Incompatible resource layouts");
+    VERIFY_EXPR(m_ResourceCache.size() == SrcLayout.m_ResourceCache.size());
+    for (size_t i = 0; i < m_ResourceCache.size(); ++i)
+        m_ResourceCache[i] = SrcLayout.m_ResourceCache[i];
+    IncrementCacheVersion();
+}
+
+#ifdef DILIGENT_DEVELOPMENT
+bool ShaderResourceLayoutNull::dvpVerifyBindings() const
+{
+    bool BindingsOK = true;
+    for (const auto& Var : m_Variables)
+    {
+        for (Uint32 elem = 0; elem < Var.m_Attribs.ArraySize; ++elem)
+        {
+            if (m_ResourceCache[Var.m_Attribs.CacheOffset + elem] == nullptr)
+            {
+                LOG_ERROR_MESSAGE("No resource is bound to ", GetShaderVariableTypeLiteralName(Var.GetType()), " variable '",
+                                  Var.m_Attribs.GetPrintName(elem), "' in shader '", GetShaderName(), "'");
+                BindingsOK = false;
+            }
+        }
+    }
+    return BindingsOK;
+}
+#endif
+
+IShaderResourceVariable* ShaderResourceLayoutNull::GetShaderVariable(const Char* Name)
+{
+    for (auto& Var : m_Variables)
+    {
+        if (Var.m_Attribs.Name == Name)
+            return &Var;
+    }
+    return nullptr;
+}
+
+IShaderResourceVariable* ShaderResourceLayoutNull::GetShaderVariable(Uint32 Index)
+{
+    if (Index >= m_Variables.size())
+    {
+        LOG_ERROR(Index, " is not a valid variable index.");
+        return nullptr;
+    }
+    return &m_Variables[Index];
+}
+
+Uint32 ShaderResourceLayoutNull::GetVariableIndex(const ShaderVariableNullImpl& Variable) const
+{
+    if (m_Variables.empty())
+    {
+        LOG_ERROR("This shader resource layout does not have resources");
+        return static_cast<Uint32>(-1);
+    }
+
+    const auto Index = &Variable - m_Variables.data();
+    if (Index < 0 || static_cast<size_t>(Index) >= m_Variables.size())
+    {
+        LOG_ERROR("Failed to get variable index. The variable ", &Variable, " does not belong to this shader resource layout");
+        return static_cast<Uint32>(-1);
+    }
+    return static_cast<Uint32>(Index);
+}
+
+} // namespace Diligent
@@ -0,0 +1,485 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <cctype>
+#include <cstring>
+#include <cstdlib>
+
+#include "ShaderResourcesNull.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Tokens that may precede the type in a global-scope declaration
+static const char* const DeclarationQualifiers[] =
+    {
+        "uniform", "static", "const", "extern", "readonly", "writeonly", "coherent", "volatile",
+        "restrict", "globallycoherent", "highp", "mediump", "lowp", "precise" //
+};
+
+bool IsQualifier(const std::string& Token)
+{
+    for (const auto* Qualifier : DeclarationQualifiers)
+    {
+        if (Token == Qualifier)
+            return true;
+    }
+    return false;
+}
+
+bool IsIdentifier(const std::string& Token)
+{
+    return !Token.empty() && (std::isalpha(static_cast<unsigned char>(Token[0])) || Token[0] == '_');
+}
+
+// Parses texture dimension suffix such as "2DArray" or "CubeShadow"
+bool ParseTextureDimension(std::string Suffix, RESOURCE_DIMENSION& Dim, bool& IsMS)
+{
+    static const char   ShadowSuffix[] = "Shadow";
+    static const size_t ShadowLen      = sizeof(ShadowSuffix) - 1;
+    if (Suffix.length() > ShadowLen && Suffix.compare(Suffix.length() - ShadowLen, ShadowLen, ShadowSuffix) == 0)
+        Suffix.erase(Suffix.length() - ShadowLen);
+
+    static const struct
+    {
+        const char*        Suffix;
+        RESOURCE_DIMENSION Dim;
+        bool               IsMS;
+    } TexDims[] =
+        {
+            {"1D", RESOURCE_DIM_TEX_1D, false},
+            {"1DArray", RESOURCE_DIM_TEX_1D_ARRAY, false},
+            {"2D", RESOURCE_DIM_TEX_2D, false},
+            {"2DRect", RESOURCE_DIM_TEX_2D, false},
+            {"2DArray", RESOURCE_DIM_TEX_2D_ARRAY, false},
+            {"2DMS", RESOURCE_DIM_TEX_2D, true},
+            {"2DMSArray", RESOURCE_DIM_TEX_2D_ARRAY, true},
+            {"3D", RESOURCE_DIM_TEX_3D, false},
+            {"Cube", RESOURCE_DIM_TEX_CUBE, false},
+            {"CubeArray", RESOURCE_DIM_TEX_CUBE_ARRAY, false} //
+        };
+
+    for (const auto& TexDim : TexDims)
+    {
+        if (Suffix == TexDim.Suffix)
+        {
+            Dim  = TexDim.Dim;
+            IsMS = TexDim.IsMS;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool StartsWith(const std::string& Str, const char* Prefix, std::string& Suffix)
+{
+    const auto Len = strlen(Prefix);
+    if (Str.compare(0, Len, Prefix) != 0)
+        return false;
+    Suffix = Str.substr(Len);
+    return true;
+}
+
+// Returns the resource type of the HLSL or GLSL type, or SHADER_RESOURCE_TYPE_UNKNOWN
+// if the type is not a resource type.
+SHADER_RESOURCE_TYPE GetResourceType(const std::string& TypeName, RESOURCE_DIMENSION& Dim, bool& IsMS)
+{
+    Dim  = RESOURCE_DIM_UNDEFINED;
+    IsMS = false;
+
+    // HLSL
+    static const struct
+    {
+        const char*          Name;
+        SHADER_RESOURCE_TYPE Type;
+    } HLSLTypes[] =
+        {
+            {"ConstantBuffer", SHADER_RESOURCE_TYPE_CONSTANT_BUFFER},
+            {"Buffer", SHADER_RESOURCE_TYPE_BUFFER_SRV},
+            {"StructuredBuffer", SHADER_RESOURCE_TYPE_BUFFER_SRV},
+            {"ByteAddressBuffer", SHADER_RESOURCE_TYPE_BUFFER_SRV},
+            {"RWBuffer", SHADER_RESOURCE_TYPE_BUFFER_UAV},
+            {"RWStructuredBuffer", SHADER_RESOURCE_TYPE_BUFFER_UAV},
+            {"RWByteAddressBuffer", SHADER_RESOURCE_TYPE_BUFFER_UAV},
+            {"AppendStructuredBuffer", SHADER_RESOURCE_TYPE_BUFFER_UAV},
+            {"ConsumeStructuredBuffer", SHADER_RESOURCE_TYPE_BUFFER_UAV},
+            {"RasterizerOrderedBuffer", SHADER_RESOURCE_TYPE_BUFFER_UAV},
+            {"RasterizerOrderedStructuredBuffer", SHADER_RESOURCE_TYPE_BUFFER_UAV},
+            {"RasterizerOrderedByteAddressBuffer", SHADER_RESOURCE_TYPE_BUFFER_UAV},
+            {"SamplerState", SHADER_RESOURCE_TYPE_SAMPLER},
+            {"SamplerComparisonState", SHADER_RESOURCE_TYPE_SAMPLER},
+            {"RaytracingAccelerationStructure", SHADER_RESOURCE_TYPE_ACCEL_STRUCT},
+            // GLSL
+            {"sampler", SHADER_RESOURCE_TYPE_SAMPLER},
+            {"samplerShadow", SHADER_RESOURCE_TYPE_SAMPLER},
+            {"accelerationStructureEXT", SHADER_RESOURCE_TYPE_ACCEL_STRUCT},
+            {"subpassInput", SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT},
+            {"subpassInputMS", SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT},
+            {"isubpassInput", SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT},
+            {"isubpassInputMS", SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT},
+            {"usubpassInput", SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT},
+            {"usubpassInputMS", SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT} //
+        };
+
+    for (const auto& HLSLType : HLSLTypes)
+    {
+        if (TypeName == HLSLType.Name)
+        {
+            if (HLSLType.Type == SHADER_RESOURCE_TYPE_BUFFER_SRV || HLSLType.Type == SHADER_RESOURCE_TYPE_BUFFER_UAV)
+                Dim = RESOURCE_DIM_BUFFER;
+            return HLSLType.Type;
+        }
+    }
+
+    std::string Suffix;
+    if (StartsWith(TypeName, "Texture", Suffix))
+        return ParseTextureDimension(Suffix, Dim, IsMS) ? SHADER_RESOURCE_TYPE_TEXTURE_SRV : SHADER_RESOURCE_TYPE_UNKNOWN;
+
+    if (StartsWith(TypeName, "RWTexture", Suffix) || StartsWith(TypeName, "RasterizerOrderedTexture", Suffix))
+        return ParseTextureDimension(Suffix, Dim, IsMS) ? SHADER_RESOURCE_TYPE_TEXTURE_UAV : SHADER_RESOURCE_TYPE_UNKNOWN;
+
+    // GLSL: [i|u]sampler*, [i|u]texture*, [i|u]image*
+    auto GLSLTypeName = TypeName;
+    if (!GLSLTypeName.empty() && (GLSLTypeName[0] == 'i' || GLSLTypeName[0] == 'u'))
+        GLSLTypeName.erase(0, 1);
+
+    bool IsUAV = false;
+    if (StartsWith(GLSLTypeName, "sampler", Suffix) || StartsWith(GLSLTypeName, "texture", Suffix))
+        IsUAV = false;
+    else if (StartsWith(GLSLTypeName, "image", Suffix))
+        IsUAV = true;
+    else
+        return SHADER_RESOURCE_TYPE_UNKNOWN;
+
+    if (Suffix == "Buffer")
+    {
+        Dim = RESOURCE_DIM_BUFFER;
+        return IsUAV ? SHADER_RESOURCE_TYPE_BUFFER_UAV : SHADER_RESOURCE_TYPE_BUFFER_SRV;
+    }
+
+    if (!ParseTextureDimension(Suffix, Dim, IsMS))
+        return SHADER_RESOURCE_TYPE_UNKNOWN;
+
+    return IsUAV ? SHADER_RESOURCE_TYPE_TEXTURE_UAV : SHADER_RESOURCE_TYPE_TEXTURE_SRV;
+}
+
+void Tokenize(const std::string& Source, std::vector<std::string>& Tokens)
+{
+    const auto* c   = Source.c_str();
+    const auto* End = c + Source.length();
+    while (c < End)
+    {
+        if (std::isspace(static_cast<unsigned char>(*c)))
+        {
+            ++c;
+        }
+        else if (*c == '#')
+        {
+            // Skip remaining directives (#version, #extension, #pragma, #line)
+            while (c < End && *c != '\n')
+                ++c;
+        }
+        else if (c[0] == '/' && c + 1 < End && c[1] == '/')
+        {
+            while (c < End && *c != '\n')
+                ++c;
+        }
+        else if (c[0] == '/' && c + 1 < End && c[1] == '*')
+        {
+            c += 2;
+            while (c + 1 < End && !(c[0] == '*' && c[1] == '/'))
+                ++c;
+            c = std::min(c + 2, End);
+        }
+        else if (std::isalnum(static_cast<unsigned char>(*c)) || *c == '_')
+        {
+            const auto* Start = c;
+            while (c < End && (std::isalnum(static_cast<unsigned char>(*c)) || *c == '_'))
+                ++c;
+            Tokens.emplace_back(Start, c);
+        }
+        else if (*c == '"')
+        {
+            // String literals may only appear in annotations; skip them
+            ++c;
+            while (c < End && *c != '"')
+                ++c;
+            if (c < End)
+                ++c;
+        }
+        else
+        {
+            Tokens.emplace_back(1, *c);
+            ++c;
+        }
+    }
+}
+
+// Removes parenthesized groups (layout qualifiers, register bindings, function
+// parameter lists) and replaces each of them with a single "()" token.
+std::vector<std::string> CollapseParentheses(const std::vector<std::string>& Decl)
+{
+    std::vector<std::string> Collapsed;
+    Collapsed.reserve(Decl.size());
+
+    int Depth = 0;
+    for (const auto& Token : Decl)
+    {
+        if (Token == "(")
+        {
+            if (Depth++ == 0)
+                Collapsed.emplace_back("()");
+        }
+        else if (Token == ")")
+        {
+            Depth = std::max(Depth - 1, 0);
+        }
+        else if (Depth == 0)
+        {
+            Collapsed.emplace_back(Token);
+        }
+    }
+    return Collapsed;
+}
+
+} // namespace
+
+
+ShaderResourcesNull::ShaderResourcesNull(SHADER_TYPE        ShaderType,
+                                         const char*        ShaderName,
+                                         const std::string& Source,
+                                         const char*        CombinedSamplerSuffix) :
+    // clang-format off
+    m_ShaderType           {ShaderType},
+    m_ShaderName           {ShaderName != nullptr ? ShaderName : ""},
+    m_CombinedSamplerSuffix{CombinedSamplerSuffix != nullptr ? CombinedSamplerSuffix : ""}
+// clang-format on
+{
+    ParseSource(Source);
+
+    for (auto& Res : m_Resources)
+    {
+        Res.CacheOffset = m_CacheSize;
+        m_CacheSize += Res.ArraySize;
+    }
+}
+
+void ShaderResourcesNull::ParseSource(const std::string& Source)
+{
+    std::vector<std::string> Tokens;
+    Tokenize(Source, Tokens);
+
+    auto AddResource = [this](const std::string& Name, SHADER_RESOURCE_TYPE Type, Uint32 ArraySize, RESOURCE_DIMENSION Dim, bool IsMS) //
+    {
+        for (const auto& Res : m_Resources)
+        {
+            // Resources may be declared multiple times in GLSL
+            if (Res.Name == Name)
+                return;
+        }
+
+        ShaderResourceAttribsNull Attribs;
+        Attribs.Name        = Name;
+        Attribs.Type        = Type;
+        Attribs.ArraySize   = ArraySize;
+        Attribs.ResourceDim = Dim;
+        Attribs.IsMS        = IsMS;
+        m_Resources.emplace_back(std::move(Attribs));
+    };
+
+    // Handles a declaration that is followed by a block, e.g. HLSL cbuffer or GLSL interface block
+    auto ProcessBlock = [&](const std::vector<std::string>& Decl) //
+    {
+        const auto Tokens = CollapseParentheses(Decl);
+        if (Tokens.size() >= 2 && (Tokens[0] == "cbuffer" || Tokens[0] == "tbuffer"))
+        {
+            AddResource(Tokens[1], Tokens[0] == "cbuffer" ? SHADER_RESOURCE_TYPE_CONSTANT_BUFFER : SHADER_RESOURCE_TYPE_BUFFER_SRV, 1, RESOURCE_DIM_UNDEFINED, false);
+            return;
+        }
+
+        bool IsReadOnly = false;
+        for (size_t i = 0; i < Tokens.size(); ++i)
+        {
+            const auto& Token = Tokens[i];
+            if (Token == "readonly")
+                IsReadOnly = true;
+
+            if (Token != "uniform" && Token != "buffer")
+                continue;
+
+            // Skip the remaining qualifiers to find the block name
+            size_t n = i + 1;
+            while (n < Tokens.size() && IsQualifier(Tokens[n]))
+            {
+                if (Tokens[n] == "readonly")
+                    IsReadOnly = true;
+                ++n;
+            }
+            if (n >= Tokens.size() || !IsIdentifier(Tokens[n]))
+                return;
+
+            if (Token == "uniform")
+                AddResource(Tokens[n], SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, 1, RESOURCE_DIM_UNDEFINED, false);
+            else
+                AddResource(Tokens[n], IsReadOnly ? SHADER_RESOURCE_TYPE_BUFFER_SRV : SHADER_RESOURCE_TYPE_BUFFER_UAV, 1, RESOURCE_DIM_BUFFER, false);
+            return;
+        }
+    };
+
+    // Handles a declaration terminated by semicolon, e.g. "Texture2D g_Tex[2] : register(t0);"
+    auto ProcessDeclaration = [&](const std::vector<std::string>& Decl) //
+    {
+        const auto Tokens = CollapseParentheses(Decl);
+
+        size_t i = 0;
+        while (i < Tokens.size() && (IsQualifier(Tokens[i]) || Tokens[i] == "layout" || Tokens[i] == "()"))
+            ++i;
+        if (i >= Tokens.size())
+            return;
+
+        RESOURCE_DIMENSION Dim  = RESOURCE_DIM_UNDEFINED;
+        bool               IsMS = false;
+
+        const auto Type = GetResourceType(Tokens[i], Dim, IsMS);
+        if (Type == SHADER_RESOURCE_TYPE_UNKNOWN)
+            return;
+        ++i;
+
+        // Skip template arguments, e.g. Texture2D<float4>
+        if (i < Tokens.size() && Tokens[i] == "<")
+        {
+            int Depth = 0;
+            for (; i < Tokens.size(); ++i)
+            {
+                if (Tokens[i] == "<")
+                    ++Depth;
+                else if (Tokens[i] == ">" && --Depth == 0)
+                    break;
+            }
+            ++i;
+        }
+
+        // Process all declarators, e.g. "SamplerState g_Sam0, g_Sam1;"
+        while (i < Tokens.size() && IsIdentifier(Tokens[i]))
+        {
+            const auto& Name = Tokens[i++];
+
+            Uint32 ArraySize   = 1;
+            bool   IsUnbounded = false;
+            while (i + 1 < Tokens.size() && Tokens[i] == "[")
+            {
+                if (Tokens[i + 1] == "]")
+                    IsUnbounded = true;
+                else if (std::isdigit(static_cast<unsigned char>(Tokens[i + 1][0])))
+                    ArraySize *= std::max(static_cast<Uint32>(strtoul(Tokens[i + 1].c_str(), nullptr, 0)), 1u);
+                while (i < Tokens.size() && Tokens[i] != "]")
+                    ++i;
+                ++i;
+            }
+
+            if (i < Tokens.size() && Tokens[i] == "()")
+            {
+                // Function declaration
+                return;
+            }
+
+            AddResource(Name, Type, IsUnbounded ? 0 : ArraySize, Dim, IsMS);
+
+            // Skip register binding, annotations or initializer
+            while (i < Tokens.size() && Tokens[i] != ",")
+                ++i;
+            ++i;
+        }
+    };
+
+    std::vector<std::string> Decl;
+
+    int BraceDepth = 0;
+    int ParenDepth = 0;
+    for (const auto& Token : Tokens)
+    {
+        if (BraceDepth > 0)
+        {
+            if (Token == "{")
+                ++BraceDepth;
+            else if (Token == "}")
+                --BraceDepth;
+            continue;
+        }
+
+        if (Token == "(")
+            ++ParenDepth;
+        else if (Token == ")")
+            ParenDepth = std::max(ParenDepth - 1, 0);
+
+        if (ParenDepth == 0 && Token == "{")
+        {
+            ProcessBlock(Decl);
+            Decl.clear();
+            BraceDepth = 1;
+        }
+        else if (ParenDepth == 0 && Token == ";")
+        {
+            ProcessDeclaration(Decl);
+            Decl.clear();
+        }
+        else
+        {
+            Decl.emplace_back(Token);
+        }
+    }
+}
+
+bool ShaderResourcesNull::IsCompatibleWith(const ShaderResourcesNull& Resources) const
+{
+    if (GetNumResources() != Resources.GetNumResources())
+        return false;
+
+    for (Uint32 n = 0; n < GetNumResources(); ++n)
+    {
+        if (!GetResource(n).IsCompatibleWith(Resources.GetResource(n)))
+            return false;
+    }
+
+    return true;
+}
+
+size_t ShaderResourcesNull::GetHash() const
+{
+    size_t Hash = ComputeHash(GetNumResources());
+    for (const auto& Res : m_Resources)
+        HashCombine(Hash, static_cast<Uint32>(Res.Type), Res.ArraySize, static_cast<Uint32>(Res.ResourceDim), Res.IsMS);
+    return Hash;
+}
+
+} // namespace Diligent
@@ -0,0 +1,190 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <cstring>
+
+#include "TextureNullImpl.hpp"
+#include "RenderDeviceNullImpl.hpp"
+#include "TextureViewNullImpl.hpp"
+#include "GraphicsAccessories.hpp"
+#include "EngineMemory.h"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+TextureNullImpl::TextureNullImpl(IReferenceCounters*        pRefCounters,
+                                 FixedBlockMemoryAllocator& TexViewObjAllocator,
+                                 RenderDeviceNullImpl*      pDevice,
+                                 const TextureDesc&         TexDesc,
+                                 const TextureData*         pInitData /*= nullptr*/) :
+    // clang-format off
+    TTextureBase
+    {
+        pRefCounters,
+        TexViewObjAllocator,
+        pDevice,
+        TexDesc
+    }
+// clang-format on
+{
+    if (m_Desc.Usage == USAGE_IMMUTABLE && (pInitData == nullptr || pInitData->pSubResources == nullptr))
+        LOG_ERROR_AND_THROW("Immutable textures must be initialized with data at creation time: pInitData can't be null");
+
+    const auto NumSlices = GetNumSlices();
+    if (pInitData != nullptr && pInitData->pSubResources != nullptr && pInitData->NumSubresources != NumSlices * m_Desc.MipLevels)
+    {
+        LOG_ERROR_AND_THROW("Incorrect number of subresources in init data. ", NumSlices * m_Desc.MipLevels, " expected, while ",
+                            pInitData->NumSubresources, " provided");
+    }
+
+    m_Subresources.resize(size_t{NumSlices} * size_t{m_Desc.MipLevels});
+    for (Uint32 Slice = 0; Slice < NumSlices; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < m_Desc.MipLevels; ++Mip)
+        {
+            const auto MipProps = GetMipLevelProperties(m_Desc, Mip);
+            const auto SubresId = Slice * m_Desc.MipLevels + Mip;
+            m_Subresources[SubresId].resize(MipProps.MipSize);
+
+            if (pInitData != nullptr && pInitData->pSubResources != nullptr)
+            {
+                const auto& SubResData = pInitData->pSubResources[SubresId];
+                if (SubResData.pSrcBuffer != nullptr)
+                    LOG_ERROR_AND_THROW("Buffers can't be used as texture initialization data source");
+
+                const Box Region{0, MipProps.StorageWidth, 0, MipProps.StorageHeight, 0, MipProps.Depth};
+                WriteRegion(Mip, Slice, Region, SubResData.pData, SubResData.Stride, SubResData.DepthStride);
+            }
+        }
+    }
+
+    SetState(RESOURCE_STATE_UNDEFINED);
+}
+
+TextureNullImpl::~TextureNullImpl()
+{
+}
+
+MappedTextureSubresource TextureNullImpl::GetSubresourceData(Uint32 MipLevel, Uint32 Slice, Uint32 X, Uint32 Y, Uint32 Z)
+{
+    VERIFY_EXPR(MipLevel < m_Desc.MipLevels && Slice < GetNumSlices());
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(m_Desc.Format);
+    const auto  MipProps   = GetMipLevelProperties(m_Desc, MipLevel);
+
+    Uint32 Offset = Z * MipProps.DepthSliceSize;
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+    {
+        VERIFY((X % FmtAttribs.BlockWidth) == 0 && (Y % FmtAttribs.BlockHeight) == 0, "Compressed texture region must be block-aligned");
+        // ComponentSize is the block size
+        Offset += Y / FmtAttribs.BlockHeight * MipProps.RowSize + X / FmtAttribs.BlockWidth * Uint32{FmtAttribs.ComponentSize};
+    }
+    else
+    {
+        Offset += Y * MipProps.RowSize + X * Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+    }
+
+    auto& Subres = m_Subresources[Slice * m_Desc.MipLevels + MipLevel];
+    VERIFY_EXPR(Offset <= Subres.size());
+    return MappedTextureSubresource{Subres.data() + Offset, MipProps.RowSize, MipProps.DepthSliceSize};
+}
+
+void TextureNullImpl::WriteRegion(Uint32      MipLevel,
+                                  Uint32      Slice,
+                                  const Box&  Region,
+                                  const void* pSrcData,
+                                  Uint32      SrcStride,
+                                  Uint32      SrcDepthStride)
+{
+    if (pSrcData == nullptr)
+        return;
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(m_Desc.Format);
+
+    Uint32 RowSize = 0;
+    Uint32 NumRows = 0;
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+    {
+        const auto Width  = Align(Region.MaxX - Region.MinX, Uint32{FmtAttribs.BlockWidth});
+        const auto Height = Align(Region.MaxY - Region.MinY, Uint32{FmtAttribs.BlockHeight});
+        RowSize           = Width / FmtAttribs.BlockWidth * Uint32{FmtAttribs.ComponentSize};
+        NumRows           = Height / FmtAttribs.BlockHeight;
+    }
+    else
+    {
+        RowSize = (Region.MaxX - Region.MinX) * Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+        NumRows = Region.MaxY - Region.MinY;
+    }
+
+    const auto DstData = GetSubresourceData(MipLevel, Slice, Region.MinX, Region.MinY, Region.MinZ);
+    for (Uint32 z = 0; z < Region.MaxZ - Region.MinZ; ++z)
+    {
+        for (Uint32 row = 0; row < NumRows; ++row)
+        {
+            const auto* pSrcRow = reinterpret_cast<const Uint8*>(pSrcData) + z * SrcDepthStride + row * SrcStride;
+            auto*       pDstRow = reinterpret_cast<Uint8*>(DstData.pData) + z * DstData.DepthStride + row * DstData.Stride;
+            memcpy(pDstRow, pSrcRow, RowSize);
+        }
+    }
+}
+
+void TextureNullImpl::CreateViewInternal(const struct TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView)
+{
+    VERIFY(ppView != nullptr, "View pointer address is null");
+    if (!ppView) return;
+    VERIFY(*ppView == nullptr, "Overwriting reference to existing object may cause memory leaks");
+
+    *ppView = nullptr;
+
+    try
+    {
+        auto UpdatedViewDesc = ViewDesc;
+        ValidatedAndCorrectTextureViewDesc(m_Desc, UpdatedViewDesc);
+
+        auto* pDeviceNullImpl  = GetDevice();
+        auto& TexViewAllocator = pDeviceNullImpl->GetTexViewObjAllocator();
+        VERIFY(&TexViewAllocator == &m_dbgTexViewObjAllocator, "Texture view allocator does not match allocator provided during texture initialization");
+
+        auto pViewNull = NEW_RC_OBJ(TexViewAllocator, "TextureViewNullImpl instance", TextureViewNullImpl, bIsDefaultView ? this : nullptr)(pDeviceNullImpl, UpdatedViewDesc, this, bIsDefaultView);
+        VERIFY(pViewNull->GetDesc().ViewType == ViewDesc.ViewType, "Incorrect view type");
+
+        if (bIsDefaultView)
+            *ppView = pViewNull;
+        else
+            pViewNull->QueryInterface(IID_TextureView, reinterpret_cast<IObject**>(ppView));
+    }
+    catch (const std::runtime_error&)
+    {
+        const auto* ViewTypeName = GetTexViewTypeLiteralName(ViewDesc.ViewType);
+        LOG_ERROR("Failed to create view \"", ViewDesc.Name ? ViewDesc.Name : "", "\" (", ViewTypeName, ") for texture \"", m_Desc.Name ? m_Desc.Name : "", "\"");
+    }
+}
+
+} // namespace Diligent
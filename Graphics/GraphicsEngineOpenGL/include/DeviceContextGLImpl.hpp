@@ -40,6 +40,7 @@
 #include "FramebufferGLImpl.hpp"
 #include "RenderPassGLImpl.hpp"
 #include "PipelineStateGLImpl.hpp"
+#include "ShaderResourceBindingGLImpl.hpp"
 #include "BottomLevelASBase.hpp"
 #include "TopLevelASBase.hpp"
 
@@ -48,15 +49,16 @@ namespace Diligent
 
 struct DeviceContextGLImplTraits
 {
-    using BufferType        = BufferGLImpl;
-    using TextureType       = TextureBaseGL;
-    using PipelineStateType = PipelineStateGLImpl;
-    using DeviceType        = RenderDeviceGLImpl;
-    using QueryType         = QueryGLImpl;
-    using FramebufferType   = FramebufferGLImpl;
-    using RenderPassType    = RenderPassGLImpl;
-    using BottomLevelASType = BottomLevelASBase<IBottomLevelAS, RenderDeviceGLImpl>;
-    using TopLevelASType    = TopLevelASBase<ITopLevelAS, BottomLevelASType, RenderDeviceGLImpl>;
+    using BufferType                = BufferGLImpl;
+    using TextureType               = TextureBaseGL;
+    using PipelineStateType         = PipelineStateGLImpl;
+    using ShaderResourceBindingType = ShaderResourceBindingGLImpl;
+    using DeviceType                = RenderDeviceGLImpl;
+    using QueryType                 = QueryGLImpl;
+    using FramebufferType           = FramebufferGLImpl;
+    using RenderPassType            = RenderPassGLImpl;
+    using BottomLevelASType         = BottomLevelASBase<IBottomLevelAS, RenderDeviceGLImpl>;
+    using TopLevelASType            = TopLevelASBase<ITopLevelAS, BottomLevelASType, RenderDeviceGLImpl>;
 };
 
 /// Device context implementation in OpenGL backend.
@@ -144,6 +146,15 @@ public:
     /// Implementation of IDeviceContext::DrawMeshIndirect() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE DrawMeshIndirect   (const DrawMeshIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
 
+    /// Implementation of IDeviceContext::MultiDraw() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE MultiDraw               (const MultiDrawAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexed() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexed        (const MultiDrawIndexedAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndirect() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndirect       (const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexedIndirect() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
+
     /// Implementation of IDeviceContext::DispatchCompute() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE DispatchCompute        (const DispatchComputeAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DispatchComputeIndirect() in OpenGL backend.
@@ -293,6 +304,7 @@ private:
     __forceinline void PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenum& GlTopology);
     __forceinline void PrepareForIndexedDraw(VALUE_TYPE IndexType, Uint32 FirstIndexLocation, GLenum& GLIndexType, Uint32& FirstIndexByteOffset);
     __forceinline void PrepareForIndirectDraw(IBuffer* pAttribsBuffer);
+    __forceinline void PrepareIndirectDrawCountBuffer(IBuffer* pCountBuffer);
     __forceinline void PostDraw();
 
     void BeginSubpass();
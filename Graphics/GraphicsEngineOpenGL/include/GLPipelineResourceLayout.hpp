@@ -294,6 +294,10 @@ public:
     IShaderResourceVariable* GetShaderVariable(SHADER_TYPE ShaderStage, const Char* Name);
     IShaderResourceVariable* GetShaderVariable(SHADER_TYPE ShaderStage, Uint32 Index);
 
+    /// Binds the object to the first element of the variable with the given index in the
+    /// shader stage identified by its pipeline index (see GetShaderTypePipelineIndex)
+    void BindVariable(Uint32 ShaderInd, Uint32 Index, IDeviceObject* pObject);
+
     IObject& GetOwner() { return m_Owner; }
 
     Uint32 GetNumVariables(SHADER_TYPE ShaderStage) const;
@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "BufferGLImpl.hpp"
 #include "TextureBaseGL.hpp"
 #include "SamplerGLImpl.hpp"
@@ -118,6 +120,12 @@ public:
     void Initialize(Uint32 UBCount, Uint32 SamplerCount, Uint32 ImageCount, Uint32 SSBOCount, IMemoryAllocator& MemAllocator);
     void Destroy(IMemoryAllocator& MemAllocator);
 
+    /// Releases all resources in the cache, including immutable samplers
+    void ResetResources();
+
+    /// Copies all resources from the cache with identical layout
+    void CopyResources(const GLProgramResourceCache& SrcCache);
+
     void SetUniformBuffer(Uint32 Binding, RefCntAutoPtr<BufferGLImpl>&& pBuff)
     {
         GetUB(Binding).pBuffer = std::move(pBuff);
@@ -237,27 +245,44 @@ public:
         return m_MemoryEndOffset != InvalidResourceOffset;
     }
 
+    /// Returns the version of the cache that is incremented every time a resource is modified
+    Uint32 GetVersion() const
+    {
+        return m_Version.load(std::memory_order_relaxed);
+    }
+
 private:
+    // Non-const accessors are only used to modify the resources, so every call increments the cache version
+
     CachedUB& GetUB(Uint32 Binding)
     {
+        IncrementVersion();
         return const_cast<CachedUB&>(const_cast<const GLProgramResourceCache*>(this)->GetConstUB(Binding));
     }
 
     CachedResourceView& GetSampler(Uint32 Binding)
     {
+        IncrementVersion();
         return const_cast<CachedResourceView&>(const_cast<const GLProgramResourceCache*>(this)->GetConstSampler(Binding));
     }
 
     CachedResourceView& GetImage(Uint32 Binding)
     {
+        IncrementVersion();
         return const_cast<CachedResourceView&>(const_cast<const GLProgramResourceCache*>(this)->GetConstImage(Binding));
     }
 
     CachedSSBO& GetSSBO(Uint32 Binding)
     {
+        IncrementVersion();
         return const_cast<CachedSSBO&>(const_cast<const GLProgramResourceCache*>(this)->GetConstSSBO(Binding));
     }
 
+    void IncrementVersion()
+    {
+        m_Version.fetch_add(1, std::memory_order_relaxed);
+    }
+
     static constexpr const Uint16 InvalidResourceOffset = 0xFFFF;
     static constexpr const Uint16 m_UBsOffset           = 0;
 
@@ -268,6 +293,8 @@ private:
 
     Uint8* m_pResourceData = nullptr;
 
+    std::atomic<Uint32> m_Version{0};
+
 #ifdef DILIGENT_DEBUG
     IMemoryAllocator* m_pdbgMemoryAllocator = nullptr;
 #endif
@@ -88,6 +88,9 @@ public:
 
     void InitializeSRBResourceCache(GLProgramResourceCache& ResourceCache) const;
 
+    // Releases all resources in the SRB resource cache and restores the immutable samplers
+    void ResetSRBResourceCache(GLProgramResourceCache& ResourceCache) const;
+
     const GLPipelineResourceLayout& GetResourceLayout() const { return m_ResourceLayout; }
     const GLPipelineResourceLayout& GetStaticResourceLayout() const { return m_StaticResourceLayout; }
     const GLProgramResourceCache&   GetStaticResourceCache() const { return m_StaticResourceCache; }
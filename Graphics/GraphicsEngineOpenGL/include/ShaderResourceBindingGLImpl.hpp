@@ -74,9 +74,23 @@ public:
     /// Implementation of IShaderResourceBinding::InitializeStaticResources() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE InitializeStaticResources(const IPipelineState* pPipelineState) override final;
 
+    /// Implementation of IShaderResourceBinding::Clone() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE Clone(IShaderResourceBinding** ppClone) override final;
+
+    /// Implementation of IShaderResourceBinding::GetVariableHandle() in OpenGL backend.
+    virtual Uint32 DILIGENT_CALL_TYPE GetVariableHandle(SHADER_TYPE ShaderType, const char* Name) override final;
+
+    /// Implementation of IShaderResourceBinding::SetVariables() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE SetVariables(const Uint32* pHandles, IDeviceObject* const* ppObjects, Uint32 NumVariables) override final;
+
     const GLProgramResourceCache& GetResourceCache(PipelineStateGLImpl* pdbgPSO);
 
+    /// Returns the version of the resource cache, which changes every time a resource is modified.
+    Uint32 GetResourcesVersion() const { return m_ResourceCache.GetVersion(); }
+
 private:
+    virtual void ResetResources() override final;
+
     // The resource layout only references mutable and dynamic variables
     GLPipelineResourceLayout m_ResourceLayout;
 
@@ -177,6 +177,10 @@ void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
     BindProgramResources(m_CommitedResourcesTentativeBarriers, pShaderResourceBinding);
     // m_CommitedResourcesTentativeBarriers will contain memory barriers that will be required
     // AFTER the actual draw/dispatch command is executed. Before that they have no meaning
+
+    // Texture units and image bindings may be changed by other commands through the context
+    // state, and memory barriers must be issued after every draw, so resources are always re-committed.
+    InvalidateCommittedShaderResources();
 }
 
 void DeviceContextGLImpl::SetStencilRef(Uint32 StencilRef)
@@ -203,7 +207,9 @@ void DeviceContextGLImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+    if (!TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags, 0 /*Dummy*/))
+        return;
+
     m_ContextState.InvalidateVAO();
 }
 
@@ -225,7 +231,8 @@ void DeviceContextGLImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffse
 
 void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
 
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
     if (NumViewports == 1)
@@ -288,7 +295,8 @@ void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pVie
 
 void DeviceContextGLImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight))
+        return;
 
     VERIFY(NumRects == m_NumScissorRects, "Unexpected number of scissor rects");
     if (NumRects == 1)
@@ -1116,6 +1124,200 @@ void DeviceContextGLImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
     UNSUPPORTED("DrawMeshIndirect is not supported in OpenGL");
 }
 
+void DeviceContextGLImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawArguments(Attribs))
+        return;
+
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, false, GlTopology);
+
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        if (Attribs.NumInstances > 1 || Attribs.FirstInstanceLocation != 0)
+        {
+            if (Attribs.FirstInstanceLocation != 0)
+                glDrawArraysInstancedBaseInstance(GlTopology, Item.StartVertexLocation, Item.NumVertices, Attribs.NumInstances, Attribs.FirstInstanceLocation);
+            else
+                glDrawArraysInstanced(GlTopology, Item.StartVertexLocation, Item.NumVertices, Attribs.NumInstances);
+        }
+        else
+        {
+            glDrawArrays(GlTopology, Item.StartVertexLocation, Item.NumVertices);
+        }
+    }
+    DEV_CHECK_GL_ERROR("OpenGL multi-draw command failed");
+
+    PostDraw();
+}
+
+void DeviceContextGLImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawIndexedArguments(Attribs))
+        return;
+
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, true, GlTopology);
+
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+
+        GLenum GLIndexType;
+        Uint32 FirstIndexByteOffset;
+        PrepareForIndexedDraw(Attribs.IndexType, Item.FirstIndexLocation, GLIndexType, FirstIndexByteOffset);
+        auto* pIndices = reinterpret_cast<GLvoid*>(static_cast<size_t>(FirstIndexByteOffset));
+
+        if (Attribs.NumInstances > 1 || Attribs.FirstInstanceLocation != 0)
+        {
+            if (Item.BaseVertex > 0)
+            {
+                if (Attribs.FirstInstanceLocation != 0)
+                    glDrawElementsInstancedBaseVertexBaseInstance(GlTopology, Item.NumIndices, GLIndexType, pIndices, Attribs.NumInstances, Item.BaseVertex, Attribs.FirstInstanceLocation);
+                else
+                    glDrawElementsInstancedBaseVertex(GlTopology, Item.NumIndices, GLIndexType, pIndices, Attribs.NumInstances, Item.BaseVertex);
+            }
+            else
+            {
+                if (Attribs.FirstInstanceLocation != 0)
+                    glDrawElementsInstancedBaseInstance(GlTopology, Item.NumIndices, GLIndexType, pIndices, Attribs.NumInstances, Attribs.FirstInstanceLocation);
+                else
+                    glDrawElementsInstanced(GlTopology, Item.NumIndices, GLIndexType, pIndices, Attribs.NumInstances);
+            }
+        }
+        else
+        {
+            if (Item.BaseVertex > 0)
+                glDrawElementsBaseVertex(GlTopology, Item.NumIndices, GLIndexType, pIndices, Item.BaseVertex);
+            else
+                glDrawElements(GlTopology, Item.NumIndices, GLIndexType, pIndices);
+        }
+    }
+    DEV_CHECK_GL_ERROR("OpenGL multi-draw command failed");
+
+    PostDraw();
+}
+
+void DeviceContextGLImpl::PrepareIndirectDrawCountBuffer(IBuffer* pCountBuffer)
+{
+#if GL_ARB_indirect_parameters
+    auto* pCountBufferGL = ValidatedCast<BufferGLImpl>(pCountBuffer);
+    // Draw count is sourced from the GL_PARAMETER_BUFFER_ARB binding the same way as
+    // indirect arguments are sourced from GL_DRAW_INDIRECT_BUFFER.
+    pCountBufferGL->BufferMemoryBarrier(GL_COMMAND_BARRIER_BIT, m_ContextState);
+    constexpr bool ResetVAO = false; // GL_PARAMETER_BUFFER_ARB does not affect VAO
+    m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, pCountBufferGL->m_GlBuffer, ResetVAO);
+#endif
+}
+
+void DeviceContextGLImpl::MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    if (!DvpVerifyMultiDrawIndirectArguments(Attribs, pAttribsBuffer, pCountBuffer))
+        return;
+
+#if GL_ARB_draw_indirect
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, false, GlTopology);
+
+    PrepareForIndirectDraw(pAttribsBuffer);
+
+    // DrawArraysIndirectCommand structures are tightly packed
+    constexpr GLsizei Stride = sizeof(GLuint) * 4;
+    if (pCountBuffer != nullptr)
+    {
+#    if GL_ARB_indirect_parameters
+        PrepareIndirectDrawCountBuffer(pCountBuffer);
+        glMultiDrawArraysIndirectCountARB(GlTopology, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)),
+                                          static_cast<GLintptr>(Attribs.CountBufferOffset), Attribs.DrawCount, Stride);
+        DEV_CHECK_GL_ERROR("glMultiDrawArraysIndirectCountARB() failed");
+
+        constexpr bool ResetVAO = false; // GL_PARAMETER_BUFFER_ARB does not affect VAO
+        m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+#    else
+        UNSUPPORTED("Indirect draw count is not supported");
+#    endif
+    }
+    else
+    {
+#    if GL_ARB_multi_draw_indirect
+        if (glMultiDrawArraysIndirect != nullptr)
+        {
+            glMultiDrawArraysIndirect(GlTopology, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)), Attribs.DrawCount, Stride);
+        }
+        else
+#    endif
+        {
+            for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+                glDrawArraysIndirect(GlTopology, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset + i * Stride)));
+        }
+        DEV_CHECK_GL_ERROR("OpenGL multi-draw indirect command failed");
+    }
+
+    constexpr bool ResetVAO = false; // GL_DRAW_INDIRECT_BUFFER does not affect VAO
+    m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+
+    PostDraw();
+#else
+    LOG_ERROR_MESSAGE("Indirect rendering is not supported");
+#endif
+}
+
+void DeviceContextGLImpl::MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    if (!DvpVerifyMultiDrawIndexedIndirectArguments(Attribs, pAttribsBuffer, pCountBuffer))
+        return;
+
+#if GL_ARB_draw_indirect
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, true, GlTopology);
+    GLenum GLIndexType;
+    Uint32 FirstIndexByteOffset;
+    PrepareForIndexedDraw(Attribs.IndexType, 0, GLIndexType, FirstIndexByteOffset);
+
+    PrepareForIndirectDraw(pAttribsBuffer);
+
+    // DrawElementsIndirectCommand structures are tightly packed
+    constexpr GLsizei Stride = sizeof(GLuint) * 5;
+    if (pCountBuffer != nullptr)
+    {
+#    if GL_ARB_indirect_parameters
+        PrepareIndirectDrawCountBuffer(pCountBuffer);
+        glMultiDrawElementsIndirectCountARB(GlTopology, GLIndexType, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)),
+                                            static_cast<GLintptr>(Attribs.CountBufferOffset), Attribs.DrawCount, Stride);
+        DEV_CHECK_GL_ERROR("glMultiDrawElementsIndirectCountARB() failed");
+
+        constexpr bool ResetVAO = false; // GL_PARAMETER_BUFFER_ARB does not affect VAO
+        m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+#    else
+        UNSUPPORTED("Indirect draw count is not supported");
+#    endif
+    }
+    else
+    {
+#    if GL_ARB_multi_draw_indirect
+        if (glMultiDrawElementsIndirect != nullptr)
+        {
+            glMultiDrawElementsIndirect(GlTopology, GLIndexType, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)), Attribs.DrawCount, Stride);
+        }
+        else
+#    endif
+        {
+            for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+                glDrawElementsIndirect(GlTopology, GLIndexType, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset + i * Stride)));
+        }
+        DEV_CHECK_GL_ERROR("OpenGL multi-draw indirect command failed");
+    }
+
+    constexpr bool ResetVAO = false; // GL_DRAW_INDIRECT_BUFFER does not affect VAO
+    m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+
+    PostDraw();
+#else
+    LOG_ERROR_MESSAGE("Indirect rendering is not supported");
+#endif
+}
+
 
 void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
@@ -588,7 +588,7 @@ public:
     }
 
     template <typename ResourceType>
-    IShaderResourceVariable* TryResource(Uint32 StartVarOffset, Uint32 EndVarOffset)
+    ResourceType* TryResource(Uint32 StartVarOffset, Uint32 EndVarOffset)
     {
         auto NumResources = EndVarOffset - StartVarOffset;
         if (Index < NumResources)
@@ -636,6 +636,37 @@ IShaderResourceVariable* GLPipelineResourceLayout::GetShaderVariable(SHADER_TYPE
     return nullptr;
 }
 
+void GLPipelineResourceLayout::BindVariable(Uint32 ShaderInd, Uint32 Index, IDeviceObject* pObject)
+{
+    VERIFY_EXPR(ShaderInd < m_ProgramIndex.size());
+    auto ProgIdx = m_ProgramIndex[ShaderInd];
+    if (ProgIdx < 0)
+    {
+        LOG_ERROR("Shader stage ", ShaderInd, " is not initialized in the resource layout");
+        return;
+    }
+
+    const auto& VariableEndOffset   = GetProgramVarEndOffsets(ProgIdx);
+    const auto& VariableStartOffset = ProgIdx > 0 ? GetProgramVarEndOffsets(ProgIdx - 1) : GLProgramResources::ResourceCounters{};
+
+    // Call the type-specific methods directly rather than through IShaderResourceVariable::Set()
+    ShaderVariableLocator VarLocator(*this, Index);
+
+    if (auto* pUB = VarLocator.TryResource<UniformBuffBindInfo>(VariableStartOffset.NumUBs, VariableEndOffset.NumUBs))
+        return pUB->BindResource(pObject, 0);
+
+    if (auto* pSampler = VarLocator.TryResource<SamplerBindInfo>(VariableStartOffset.NumSamplers, VariableEndOffset.NumSamplers))
+        return pSampler->BindResource(pObject, 0);
+
+    if (auto* pImage = VarLocator.TryResource<ImageBindInfo>(VariableStartOffset.NumImages, VariableEndOffset.NumImages))
+        return pImage->BindResource(pObject, 0);
+
+    if (auto* pSSBO = VarLocator.TryResource<StorageBufferBindInfo>(VariableStartOffset.NumStorageBlocks, VariableEndOffset.NumStorageBlocks))
+        return pSSBO->BindResource(pObject, 0);
+
+    LOG_ERROR(Index, " is not a valid variable index.");
+}
+
 
 
 class ShaderVariableIndexLocator
@@ -119,4 +119,47 @@ void GLProgramResourceCache::Destroy(IMemoryAllocator& MemAllocator)
     m_MemoryEndOffset = InvalidResourceOffset;
 }
 
+void GLProgramResourceCache::ResetResources()
+{
+    if (!IsInitialized())
+        return;
+
+    for (Uint32 cb = 0; cb < GetUBCount(); ++cb)
+        GetUB(cb) = CachedUB{};
+
+    for (Uint32 s = 0; s < GetSamplerCount(); ++s)
+        GetSampler(s) = CachedResourceView{};
+
+    for (Uint32 i = 0; i < GetImageCount(); ++i)
+        GetImage(i) = CachedResourceView{};
+
+    for (Uint32 s = 0; s < GetSSBOCount(); ++s)
+        GetSSBO(s) = CachedSSBO{};
+}
+
+void GLProgramResourceCache::CopyResources(const GLProgramResourceCache& SrcCache)
+{
+    // clang-format off
+    VERIFY(GetUBCount()      == SrcCache.GetUBCount()      &&
+           GetSamplerCount() == SrcCache.GetSamplerCount() &&
+           GetImageCount()   == SrcCache.GetImageCount()   &&
+           GetSSBOCount()    == SrcCache.GetSSBOCount(),
+           "Inconsistent cache layouts");
+    // clang-format on
+    if (!IsInitialized())
+        return;
+
+    for (Uint32 cb = 0; cb < GetUBCount(); ++cb)
+        GetUB(cb) = SrcCache.GetConstUB(cb);
+
+    for (Uint32 s = 0; s < GetSamplerCount(); ++s)
+        GetSampler(s) = SrcCache.GetConstSampler(s);
+
+    for (Uint32 i = 0; i < GetImageCount(); ++i)
+        GetImage(i) = SrcCache.GetConstImage(i);
+
+    for (Uint32 s = 0; s < GetSSBOCount(); ++s)
+        GetSSBO(s) = SrcCache.GetConstSSBO(s);
+}
+
 } // namespace Diligent
@@ -265,6 +265,15 @@ void PipelineStateGLImpl::InitResourceLayouts(std::vector<ShaderGLImpl*>& Shader
 
 void PipelineStateGLImpl::CreateShaderResourceBinding(IShaderResourceBinding** ppShaderResourceBinding, bool InitStaticResources)
 {
+    if (auto* pPooledSRB = TakeSRBFromPool<ShaderResourceBindingGLImpl>())
+    {
+        if (InitStaticResources)
+            pPooledSRB->InitializeStaticResources(this);
+        // Transfer the reference held by the pool to the caller
+        *ppShaderResourceBinding = pPooledSRB;
+        return;
+    }
+
     auto* pRenderDeviceGL = GetDevice();
     auto& SRBAllocator    = pRenderDeviceGL->GetSRBAllocator();
     auto  pResBinding     = NEW_RC_OBJ(SRBAllocator, "ShaderResourceBindingGLImpl instance", ShaderResourceBindingGLImpl)(this, m_ProgramResources, GetNumShaderStages());
@@ -348,6 +357,12 @@ void PipelineStateGLImpl::InitializeSRBResourceCache(GLProgramResourceCache& Res
     InitImmutableSamplersInResourceCache(m_ResourceLayout, ResourceCache);
 }
 
+void PipelineStateGLImpl::ResetSRBResourceCache(GLProgramResourceCache& ResourceCache) const
+{
+    ResourceCache.ResetResources();
+    InitImmutableSamplersInResourceCache(m_ResourceLayout, ResourceCache);
+}
+
 void PipelineStateGLImpl::InitImmutableSamplersInResourceCache(const GLPipelineResourceLayout& ResourceLayout, GLProgramResourceCache& Cache) const
 {
     for (Uint32 s = 0; s < ResourceLayout.GetNumResources<GLPipelineResourceLayout::SamplerBindInfo>(); ++s)
@@ -152,6 +152,8 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
             sizeof(FramebufferGLImpl),
             0,
             0,
+            0,
+            0,
             0
         }
     },
@@ -159,7 +161,7 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
     m_GLContext{InitAttribs, m_DeviceCaps, pSCDesc}
 // clang-format on
 {
-    static_assert(sizeof(DeviceObjectSizes) == sizeof(size_t) * 15, "Please add new objects to DeviceObjectSizes constructor");
+    static_assert(sizeof(DeviceObjectSizes) == sizeof(size_t) * 17, "Please add new objects to DeviceObjectSizes constructor");
 
     GLint NumExtensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &NumExtensions);
@@ -377,6 +379,7 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         SET_FEATURE_STATE(ShaderInt8,                CheckExtension("GL_EXT_shader_explicit_arithmetic_types_int8"),    "8-bit integer shader operations are");
         SET_FEATURE_STATE(ResourceBuffer8BitAccess,  CheckExtension("GL_EXT_shader_8bit_storage"),                      "8-bit resoure buffer access is");
         SET_FEATURE_STATE(UniformBuffer8BitAccess,   CheckExtension("GL_EXT_shader_8bit_storage"),                      "8-bit uniform buffer access is");
+        SET_FEATURE_STATE(DrawIndirectCount,         IsGL46OrAbove || CheckExtension("GL_ARB_indirect_parameters"),     "Indirect draw count is");
         // clang-format on
 
         TexCaps.MaxTexture1DDimension     = MaxTextureSize;
@@ -440,6 +443,7 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         SET_FEATURE_STATE(ShaderInt8,                strstr(Extensions, "shader_explicit_arithmetic_types_int8"),    "8-bit integer shader operations are");
         SET_FEATURE_STATE(ResourceBuffer8BitAccess,  strstr(Extensions, "shader_8bit_storage"),                      "8-bit resoure buffer access is");
         SET_FEATURE_STATE(UniformBuffer8BitAccess,   strstr(Extensions, "shader_8bit_storage"),                      "8-bit uniform buffer access is");
+        SET_FEATURE_STATE(DrawIndirectCount,         false,                                                          "Indirect draw count is");
         // clang-format on
 
         TexCaps.MaxTexture1DDimension     = 0; // Not supported in GLES 3.2
@@ -467,7 +471,7 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
 #undef SET_FEATURE_STATE
 
 #if defined(_MSC_VER) && defined(_WIN64)
-    static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+    static_assert(sizeof(DeviceFeatures) == 33, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 }
 
@@ -714,9 +718,14 @@ void RenderDeviceGLImpl::CreatePipelineState(const PSOCreateInfoType& PSOCreateI
         "Pipeline state", PSOCreateInfo.PSODesc, ppPipelineState,
         [&]() //
         {
+            PipelineStateRegistryKey RegistryKey;
+            if (FindSharedPipelineState<ShaderGLImpl>(PSOCreateInfo, RegistryKey, ppPipelineState))
+                return;
+
             PipelineStateGLImpl* pPipelineStateOGL(NEW_RC_OBJ(m_PSOAllocator, "PipelineStateGLImpl instance", PipelineStateGLImpl)(this, PSOCreateInfo, bIsDeviceInternal));
             pPipelineStateOGL->QueryInterface(IID_PipelineState, reinterpret_cast<IObject**>(ppPipelineState));
             OnCreateDeviceObject(pPipelineStateOGL);
+            AddSharedPipelineState(RegistryKey, *ppPipelineState);
         } //
     );
 }
@@ -822,6 +831,21 @@ void RenderDeviceGLImpl::CreateSBT(const ShaderBindingTableDesc& Desc,
     *ppSBT = nullptr;
 }
 
+void RenderDeviceGLImpl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                  IPipelineStateCache**               ppPSOCache)
+{
+    // Pipeline state caches are not supported in OpenGL, so pipelines are always created without one.
+    *ppPSOCache = nullptr;
+}
+
+void RenderDeviceGLImpl::CreateBindlessResourceTable(const BindlessResourceTableDesc& Desc,
+                                                     IBindlessResourceTable**         ppBindlessTable)
+{
+    // OpenGL does not support descriptor indexing.
+    LOG_ERROR_MESSAGE("Bindless resource tables are not supported in OpenGL backend");
+    *ppBindlessTable = nullptr;
+}
+
 bool RenderDeviceGLImpl::CheckExtension(const Char* ExtensionString)
 {
     return m_ExtensionStrings.find(ExtensionString) != m_ExtensionStrings.end();
@@ -103,6 +103,8 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
     }
 
 
+    InitBytecodeId(ShaderStrings[0], static_cast<size_t>(Lenghts[0]), ShaderCI);
+
     // Provide source strings (the strings will be saved in internal OpenGL memory)
     glShaderSource(m_GLShaderObj, static_cast<GLsizei>(ShaderStrings.size()), ShaderStrings.data(), Lenghts.data());
     // When the shader is compiled, it will be compiled as if all of the given strings were concatenated end-to-end.
@@ -104,6 +104,26 @@ IShaderResourceVariable* ShaderResourceBindingGLImpl::GetVariableByIndex(SHADER_
     return m_ResourceLayout.GetShaderVariable(ShaderType, Index);
 }
 
+Uint32 ShaderResourceBindingGLImpl::GetVariableHandle(SHADER_TYPE ShaderType, const char* Name)
+{
+    auto* pVar = GetVariableByName(ShaderType, Name);
+    if (pVar == nullptr)
+        return INVALID_SHADER_VARIABLE_HANDLE;
+
+    // The layout is shared by all stages, so the handle references the shader stage instead of the layout
+    const auto ShaderInd = GetShaderTypePipelineIndex(ShaderType, m_pPSO->GetDesc().PipelineType);
+    return PackVariableHandle(static_cast<Uint32>(ShaderInd), pVar->GetIndex());
+}
+
+void ShaderResourceBindingGLImpl::SetVariables(const Uint32* pHandles, IDeviceObject* const* ppObjects, Uint32 NumVariables)
+{
+    SetVariablesHelper(pHandles, ppObjects, NumVariables, MAX_SHADERS_IN_PIPELINE,
+                       [this](Uint32 ShaderInd, Uint32 VarIndex, IDeviceObject* pObject) //
+                       {
+                           m_ResourceLayout.BindVariable(ShaderInd, VarIndex, pObject);
+                       });
+}
+
 const GLProgramResourceCache& ShaderResourceBindingGLImpl::GetResourceCache(PipelineStateGLImpl* pdbgPSO)
 {
 #ifdef DILIGENT_DEBUG
@@ -149,4 +169,26 @@ void ShaderResourceBindingGLImpl::InitializeStaticResources(const IPipelineState
     m_bIsStaticResourcesBound = true;
 }
 
+void ShaderResourceBindingGLImpl::Clone(IShaderResourceBinding** ppClone)
+{
+    DEV_CHECK_ERR(ppClone != nullptr, "Pointer to the clone must not be null");
+
+    RefCntAutoPtr<IShaderResourceBinding> pClone;
+    m_pPSO->CreateShaderResourceBinding(&pClone, false);
+    if (!pClone)
+        return;
+
+    auto* pCloneGL = pClone.RawPtr<ShaderResourceBindingGLImpl>();
+    pCloneGL->m_ResourceCache.CopyResources(m_ResourceCache);
+    pCloneGL->m_bIsStaticResourcesBound = m_bIsStaticResourcesBound;
+
+    *ppClone = pClone.Detach();
+}
+
+void ShaderResourceBindingGLImpl::ResetResources()
+{
+    m_pPSO->ResetSRBResourceCache(m_ResourceCache);
+    m_bIsStaticResourcesBound = false;
+}
+
 } // namespace Diligent
@@ -44,6 +44,7 @@
 #include "BufferVkImpl.hpp"
 #include "TextureVkImpl.hpp"
 #include "PipelineStateVkImpl.hpp"
+#include "ShaderResourceBindingVkImpl.hpp"
 #include "QueryVkImpl.hpp"
 #include "FramebufferVkImpl.hpp"
 #include "RenderPassVkImpl.hpp"
@@ -60,16 +61,17 @@ namespace Diligent
 
 struct DeviceContextVkImplTraits
 {
-    using BufferType        = BufferVkImpl;
-    using TextureType       = TextureVkImpl;
-    using PipelineStateType = PipelineStateVkImpl;
-    using DeviceType        = RenderDeviceVkImpl;
-    using ICommandQueueType = ICommandQueueVk;
-    using QueryType         = QueryVkImpl;
-    using FramebufferType   = FramebufferVkImpl;
-    using RenderPassType    = RenderPassVkImpl;
-    using BottomLevelASType = BottomLevelASVkImpl;
-    using TopLevelASType    = TopLevelASVkImpl;
+    using BufferType                = BufferVkImpl;
+    using TextureType               = TextureVkImpl;
+    using PipelineStateType         = PipelineStateVkImpl;
+    using ShaderResourceBindingType = ShaderResourceBindingVkImpl;
+    using DeviceType                = RenderDeviceVkImpl;
+    using ICommandQueueType         = ICommandQueueVk;
+    using QueryType                 = QueryVkImpl;
+    using FramebufferType           = FramebufferVkImpl;
+    using RenderPassType            = RenderPassVkImpl;
+    using BottomLevelASType         = BottomLevelASVkImpl;
+    using TopLevelASType            = TopLevelASVkImpl;
 };
 
 /// Device context implementation in Vulkan backend.
@@ -163,6 +165,15 @@ public:
     /// Implementation of IDeviceContext::DrawMeshIndirect() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DrawMeshIndirect   (const DrawMeshIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
 
+    /// Implementation of IDeviceContext::MultiDraw() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE MultiDraw               (const MultiDrawAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexed() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexed        (const MultiDrawIndexedAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndirect() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndirect       (const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexedIndirect() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
+
     /// Implementation of IDeviceContext::DispatchCompute() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DispatchCompute        (const DispatchComputeAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DispatchComputeIndirect() in Vulkan backend.
@@ -475,6 +486,10 @@ private:
         Uint32 NumCommands = 0;
     } m_State;
 
+    /// The maximum number of draws a single vkCmdDraw*Indirect command may execute
+    /// (1 if multiDrawIndirect feature is not enabled).
+    const Uint32 m_MaxDrawIndirectCount;
+
 
     /// Render pass that matches currently bound render targets.
     /// This render pass may or may not be currently set in the command buffer
@@ -43,6 +43,7 @@ namespace Diligent
 class RenderDeviceVkImpl;
 class DeviceContextVkImpl;
 class ShaderResourceCacheVk;
+class BindlessResourceTableVkImpl;
 
 /// Implementation of the Diligent::PipelineLayout class
 class PipelineLayout
@@ -71,6 +72,32 @@ public:
                               Uint32&                           Binding,
                               Uint32&                           OffsetInCache);
 
+    /// Sets the bindless resource table whose descriptor set layout is appended to the pipeline layout
+    /// if shaders use unbounded resource arrays. Must be called before any resource slot is allocated.
+    void SetBindlessTable(const BindlessResourceTableVkImpl* pBindlessTable)
+    {
+        m_LayoutMgr.SetBindlessTable(pBindlessTable);
+    }
+
+    const BindlessResourceTableVkImpl* GetBindlessTable() const
+    {
+        return m_LayoutMgr.GetBindlessTable();
+    }
+
+    /// Returns the index of the bindless resource table descriptor set. The set follows all
+    /// other sets, so this function must be called after all resource slots have been allocated.
+    Uint32 AllocateBindlessSet()
+    {
+        return m_LayoutMgr.AllocateBindlessSet();
+    }
+
+    /// Returns the index of the bindless resource table descriptor set, or -1
+    /// if shaders do not use unbounded arrays.
+    Int32 GetBindlessSetIndex() const
+    {
+        return m_LayoutMgr.GetBindlessSetIndex();
+    }
+
     Uint32 GetTotalDescriptors(SHADER_RESOURCE_VARIABLE_TYPE VarType) const
     {
         VERIFY_EXPR(VarType >= 0 && VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES);
@@ -203,6 +230,11 @@ private:
         size_t           GetHash() const;
         VkPipelineLayout GetVkPipelineLayout() const { return m_VkPipelineLayout; }
 
+        void                               SetBindlessTable(const BindlessResourceTableVkImpl* pBindlessTable);
+        const BindlessResourceTableVkImpl* GetBindlessTable() const { return m_pBindlessTable; }
+        Uint32                             AllocateBindlessSet();
+        Int32                              GetBindlessSetIndex() const { return m_BindlessSetIndex; }
+
         void AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResAttribs,
                                   SHADER_RESOURCE_VARIABLE_TYPE     VariableType,
                                   VkSampler                         vkImmutableSampler,
@@ -216,7 +248,9 @@ private:
         VulkanUtilities::PipelineLayoutWrapper                                                      m_VkPipelineLayout;
         std::array<DescriptorSetLayout, 2>                                                          m_DescriptorSetLayouts;
         std::vector<VkDescriptorSetLayoutBinding, STDAllocatorRawMem<VkDescriptorSetLayoutBinding>> m_LayoutBindings;
-        uint8_t                                                                                     m_ActiveSets = 0;
+        uint8_t                                                                                     m_ActiveSets       = 0;
+        int8_t                                                                                      m_BindlessSetIndex = -1;
+        const BindlessResourceTableVkImpl*                                                          m_pBindlessTable   = nullptr;
     };
 
     IMemoryAllocator&          m_MemAllocator;
@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PipelineStateCacheVkImpl class
+
+#include <mutex>
+
+#include "PipelineStateCacheBase.hpp"
+#include "RenderDeviceVkImpl.hpp"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+
+namespace Diligent
+{
+
+/// Pipeline state cache implementation in Vulkan backend.
+
+/// The object wraps VkPipelineCache. The serialized data is prefixed with a header that
+/// identifies the physical device and the driver version, so that data produced by another
+/// device or driver is rejected by the engine rather than passed to the driver.
+class PipelineStateCacheVkImpl final : public PipelineStateCacheBase<IPipelineStateCache, RenderDeviceVkImpl>
+{
+public:
+    using TPipelineStateCacheBase = PipelineStateCacheBase<IPipelineStateCache, RenderDeviceVkImpl>;
+
+    PipelineStateCacheVkImpl(IReferenceCounters*                 pRefCounters,
+                             RenderDeviceVkImpl*                 pDeviceVk,
+                             const PipelineStateCacheCreateInfo& CreateInfo);
+    ~PipelineStateCacheVkImpl();
+
+    /// Implementation of IPipelineStateCache::GetData() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE GetData(IDataBlob** ppBlob) override final;
+
+    /// Implementation of IPipelineStateCache::GetStats() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE GetStats(PipelineStateCacheStats& Stats) const override final;
+
+    VkPipelineCache GetVkPipelineCache() const { return m_PipelineCache; }
+
+    /// Accounts for the time the driver spent creating a pipeline with this cache.
+    void OnPipelineCreated(double CreationTime);
+
+private:
+    VulkanUtilities::PipelineCacheWrapper m_PipelineCache;
+
+    mutable std::mutex      m_StatsMtx;
+    PipelineStateCacheStats m_Stats;
+};
+
+} // namespace Diligent
@@ -126,6 +126,9 @@ public:
 
     void InitializeStaticSRBResources(ShaderResourceCacheVk& ResourceCache) const;
 
+    // Hides PipelineStateBase::RecycleShaderResourceBinding() as the SRB may still be used by the GPU
+    void RecycleShaderResourceBinding(IShaderResourceBinding* pSRB);
+
 private:
     using TShaderStages = ShaderResourceLayoutVk::TShaderStages;
 
@@ -49,6 +49,7 @@
 #include "RenderPassCache.hpp"
 #include "CommandPoolManager.hpp"
 #include "DXCompiler.hpp"
+#include "ShaderBytecodeCache.hpp"
 
 namespace Diligent
 {
@@ -67,7 +68,8 @@ public:
                        ICommandQueueVk**                                      pCmdQueues,
                        std::shared_ptr<VulkanUtilities::VulkanInstance>       Instance,
                        std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> PhysicalDevice,
-                       std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  LogicalDevice) noexcept(false);
+                       std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  LogicalDevice,
+                       std::shared_ptr<ShaderBytecodeCache>                   pShaderBytecodeCache) noexcept(false);
     ~RenderDeviceVkImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_RenderDeviceVk, TRenderDeviceBase)
@@ -130,6 +132,14 @@ public:
     virtual void DILIGENT_CALL_TYPE CreateSBT(const ShaderBindingTableDesc& Desc,
                                               IShaderBindingTable**         ppSBT) override final;
 
+    /// Implementation of IRenderDevice::CreatePipelineStateCache() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                             IPipelineStateCache**               ppPSOCache) override final;
+
+    /// Implementation of IRenderDevice::CreateBindlessResourceTable() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE CreateBindlessResourceTable(const BindlessResourceTableDesc& Desc,
+                                                                IBindlessResourceTable**         ppBindlessTable) override final;
+
     /// Implementation of IRenderDeviceVk::GetVkDevice().
     virtual VkDevice DILIGENT_CALL_TYPE GetVkDevice() override final { return m_LogicalVkDevice->GetVkDevice(); }
 
@@ -209,6 +219,9 @@ public:
 
     IDXCompiler* GetDxCompiler() const { return m_pDxCompiler.get(); }
 
+    // Returns null if the shader cache is disabled
+    ShaderBytecodeCache* GetShaderBytecodeCache() const { return m_pShaderBytecodeCache.get(); }
+
     struct Properties
     {
         const Uint32 ShaderGroupHandleSize;
@@ -259,6 +272,8 @@ private:
 
     std::unique_ptr<IDXCompiler> m_pDxCompiler;
 
+    std::shared_ptr<ShaderBytecodeCache> m_pShaderBytecodeCache;
+
     Properties m_Properties;
 };
 
@@ -71,11 +71,25 @@ public:
     /// Implementation of IShaderResourceBinding::InitializeStaticResources() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE InitializeStaticResources(const IPipelineState* pPipelineState) override final;
 
+    /// Implementation of IShaderResourceBinding::Clone() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE Clone(IShaderResourceBinding** ppClone) override final;
+
+    /// Implementation of IShaderResourceBinding::GetVariableHandle() in Vulkan backend.
+    virtual Uint32 DILIGENT_CALL_TYPE GetVariableHandle(SHADER_TYPE ShaderType, const char* Name) override final;
+
+    /// Implementation of IShaderResourceBinding::SetVariables() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetVariables(const Uint32* pHandles, IDeviceObject* const* ppObjects, Uint32 NumVariables) override final;
+
     ShaderResourceCacheVk& GetResourceCache() { return m_ShaderResourceCache; }
 
+    /// Returns the version of the resource cache, which changes every time a resource is modified.
+    Uint32 GetResourcesVersion() const { return m_ShaderResourceCache.GetVersion(); }
+
     bool StaticResourcesInitialized() const { return m_bStaticResourcesInitialized; }
 
 private:
+    virtual void ResetResources() override final;
+
     void Destruct();
 
     ShaderResourceCacheVk    m_ShaderResourceCache;
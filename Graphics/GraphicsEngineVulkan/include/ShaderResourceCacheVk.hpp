@@ -54,6 +54,7 @@
 // Descriptor set for dynamic resources is assigned at every draw call
 
 #include <vector>
+#include <atomic>
 #include "DescriptorPoolManager.hpp"
 #include "SPIRVShaderResources.hpp"
 #include "BufferVkImpl.hpp"
@@ -188,6 +189,16 @@ public:
 
     Uint16& GetDynamicBuffersCounter() { return m_NumDynamicBuffers; }
 
+    // Returns the version of the cache that is incremented every time a resource is modified
+    Uint32 GetVersion() const { return m_Version.load(std::memory_order_relaxed); }
+    void   IncrementVersion() { m_Version.fetch_add(1, std::memory_order_relaxed); }
+
+    // Releases all resources in the cache. Vulkan descriptor sets are not modified.
+    void ResetResources();
+
+    // Copies all resources from the cache with identical layout. Vulkan descriptor sets are not modified.
+    void CopyResources(const ShaderResourceCacheVk& SrcCache);
+
 #ifdef DILIGENT_DEBUG
     // Only for debug purposes: indicates what types of resources are stored in the cache
     DbgCacheContentType DbgGetContentType() const { return m_DbgContentType; }
@@ -217,6 +228,8 @@ private:
     Uint16 m_NumDynamicBuffers = 0;
     Uint32 m_TotalResources    = 0;
 
+    std::atomic<Uint32> m_Version{0};
+
 #ifdef DILIGENT_DEBUG
     // Only for debug purposes: indicates what types of resources are stored in the cache
     const DbgCacheContentType m_DbgContentType;
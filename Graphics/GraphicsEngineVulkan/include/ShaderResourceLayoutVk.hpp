@@ -148,13 +148,15 @@ public:
                                         ShaderResourceCacheVk&                  StaticResourceCache);
 
     // This method is called by PipelineStateVkImpl class instance to initialize resource
-    // layouts for all shader stages in the pipeline.
+    // layouts for all shader stages in the pipeline. Unbounded resource arrays are not part
+    // of the layouts and are mapped to the bindless resource table set of the pipeline layout.
     static void Initialize(IRenderDevice*                    pRenderDevice,
                            TShaderStages&                    ShaderStages,
                            ShaderResourceLayoutVk            Layouts[],
                            IMemoryAllocator&                 LayoutDataAllocator,
                            const PipelineResourceLayoutDesc& ResourceLayoutDesc,
                            class PipelineLayout&             PipelineLayout,
+                           const char*                       PSOName,
                            bool                              VerifyVariables,
                            bool                              VerifyImmutableSamplers);
 
@@ -372,6 +374,11 @@ public:
                                    const ShaderResourceCacheVk&  SrcResourceCache,
                                    ShaderResourceCacheVk&        DstResourceCache) const;
 
+    // Copies descriptors of static and mutable resources bound in SrcResourceCache
+    // to the descriptor sets of DstResourceCache. Both caches must be initialized by this layout.
+    void CopyDescriptors(const ShaderResourceCacheVk& SrcResourceCache,
+                         ShaderResourceCacheVk&       DstResourceCache) const;
+
 #ifdef DILIGENT_DEVELOPMENT
     bool        dvpVerifyBindings(const ShaderResourceCacheVk& ResourceCache) const;
     static void dvpVerifyResourceLayoutDesc(const TShaderStages&              ShaderStages,
@@ -91,6 +91,9 @@ public:
     ShaderVariableVkImpl* GetVariable(const Char* Name) const;
     ShaderVariableVkImpl* GetVariable(Uint32 Index) const;
 
+    /// Binds the object to the first element of the variable with the given index
+    void BindVariable(Uint32 Index, IDeviceObject* pObject) const;
+
     void BindResources(IResourceMapping* pResourceMapping, Uint32 Flags) const;
 
     static size_t GetRequiredMemorySize(const ShaderResourceLayoutVk&        Layout,
@@ -215,4 +218,15 @@ private:
     const ShaderResourceLayoutVk::VkResource& m_Resource;
 };
 
+inline void ShaderVariableManagerVk::BindVariable(Uint32 Index, IDeviceObject* pObject) const
+{
+    // The index comes from a variable handle provided by the application, so it is always validated
+    if (Index >= m_NumVariables)
+    {
+        LOG_ERROR("Index ", Index, " is out of range");
+        return;
+    }
+    m_pVariables[Index].m_Resource.BindResource(pObject, 0, m_ResourceCache);
+}
+
 } // namespace Diligent
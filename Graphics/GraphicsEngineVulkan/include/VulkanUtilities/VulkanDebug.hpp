@@ -69,6 +69,7 @@ void SetDeviceMemoryName        (VkDevice device, VkDeviceMemory        memory,
 void SetShaderModuleName        (VkDevice device, VkShaderModule        shaderModule,        const char * name);
 void SetPipelineName            (VkDevice device, VkPipeline            pipeline,            const char * name);
 void SetPipelineLayoutName      (VkDevice device, VkPipelineLayout      pipelineLayout,      const char * name);
+void SetPipelineCacheName       (VkDevice device, VkPipelineCache       pipelineCache,       const char * name);
 void SetRenderPassName          (VkDevice device, VkRenderPass          renderPass,          const char * name);
 void SetFramebufferName         (VkDevice device, VkFramebuffer         framebuffer,         const char * name);
 void SetDescriptorSetLayoutName (VkDevice device, VkDescriptorSetLayout descriptorSetLayout, const char * name);
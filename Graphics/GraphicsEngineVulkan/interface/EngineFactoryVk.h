@@ -97,6 +97,16 @@ DILIGENT_BEGIN_INTERFACE(IEngineFactoryVk, IEngineFactory)
                                            const SwapChainDesc REF SwapChainDesc,
                                            const NativeWindow REF  Window,
                                            ISwapChain**            ppSwapChain) PURE;
+
+
+    /// Returns the statistics of the shader bytecode cache
+
+    /// \param [out] Stats - Shader bytecode cache statistics summed over all existing devices
+    ///                      created by the factory. Devices that were created with the cache
+    ///                      disabled (EngineVkCreateInfo::ShaderCacheDirectory is null) do not
+    ///                      contribute to the statistics.
+    VIRTUAL void METHOD(GetShaderBytecodeCacheStats)(THIS_
+                                                     ShaderBytecodeCacheStats REF Stats) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -106,8 +116,9 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IEngineFactoryVk_CreateDeviceAndContextsVk(This, ...) CALL_IFACE_METHOD(EngineFactoryVk, CreateDeviceAndContextsVk, This, __VA_ARGS__)
-#    define IEngineFactoryVk_CreateSwapChainVk(This, ...)         CALL_IFACE_METHOD(EngineFactoryVk, CreateSwapChainVk,         This, __VA_ARGS__)
+#    define IEngineFactoryVk_CreateDeviceAndContextsVk(This, ...)   CALL_IFACE_METHOD(EngineFactoryVk, CreateDeviceAndContextsVk,   This, __VA_ARGS__)
+#    define IEngineFactoryVk_CreateSwapChainVk(This, ...)           CALL_IFACE_METHOD(EngineFactoryVk, CreateSwapChainVk,           This, __VA_ARGS__)
+#    define IEngineFactoryVk_GetShaderBytecodeCacheStats(This, ...) CALL_IFACE_METHOD(EngineFactoryVk, GetShaderBytecodeCacheStats, This, __VA_ARGS__)
 
 // clang-format on
 
@@ -0,0 +1,283 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <array>
+
+#include "BindlessResourceTableVkImpl.hpp"
+#include "TextureViewVkImpl.hpp"
+#include "TextureVkImpl.hpp"
+#include "BufferViewVkImpl.hpp"
+#include "BufferVkImpl.hpp"
+#include "SamplerVkImpl.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+VkDescriptorType BindlessResourceTypeToVkDescriptorType(BINDLESS_RESOURCE_TYPE Type)
+{
+    static_assert(BINDLESS_RESOURCE_TYPE_COUNT == 5, "Please handle the new bindless resource type below");
+    switch (Type)
+    {
+        // clang-format off
+        case BINDLESS_RESOURCE_TYPE_TEXTURE_SRV: return VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        case BINDLESS_RESOURCE_TYPE_TEXTURE_UAV: return VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        case BINDLESS_RESOURCE_TYPE_BUFFER_SRV:  return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        case BINDLESS_RESOURCE_TYPE_BUFFER_UAV:  return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        case BINDLESS_RESOURCE_TYPE_SAMPLER:     return VK_DESCRIPTOR_TYPE_SAMPLER;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected bindless resource type");
+            return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+    }
+}
+
+void VerifyDescriptorIndexingSupport(const VkPhysicalDeviceDescriptorIndexingFeaturesEXT& Feats,
+                                     const BindlessResourceTableDesc&                     Desc) noexcept(false)
+{
+    if (Feats.runtimeDescriptorArray == VK_FALSE || Feats.descriptorBindingPartiallyBound == VK_FALSE ||
+        Feats.descriptorBindingUpdateUnusedWhilePending == VK_FALSE)
+    {
+        LOG_ERROR_AND_THROW("Failed to create bindless resource table '", Desc.Name,
+                            "': the device does not support runtime descriptor arrays, partially bound or update-unused-while-pending descriptor bindings (VK_EXT_descriptor_indexing).");
+    }
+
+    // clang-format off
+    if (((Desc.NumTextureSRVs != 0 || Desc.NumSamplers != 0) && Feats.descriptorBindingSampledImageUpdateAfterBind  == VK_FALSE) ||
+        ( Desc.NumTextureUAVs != 0                           && Feats.descriptorBindingStorageImageUpdateAfterBind  == VK_FALSE) ||
+        ((Desc.NumBufferSRVs  != 0 || Desc.NumBufferUAVs != 0) && Feats.descriptorBindingStorageBufferUpdateAfterBind == VK_FALSE))
+    // clang-format on
+    {
+        LOG_ERROR_AND_THROW("Failed to create bindless resource table '", Desc.Name,
+                            "': the device does not support update-after-bind descriptors of the requested types.");
+    }
+}
+
+// Stale handle wrapper that is kept in the device release queues and returns
+// the handle to the allocator once the command buffers that may use it have completed.
+class StaleBindlessHandle
+{
+public:
+    StaleBindlessHandle(std::shared_ptr<BindlessHandleAllocator> pAllocator,
+                        BINDLESS_RESOURCE_TYPE                   Type,
+                        Uint32                                   Handle) noexcept :
+        // clang-format off
+        m_pAllocator{std::move(pAllocator)},
+        m_Type      {Type},
+        m_Handle    {Handle}
+    // clang-format on
+    {}
+
+    // clang-format off
+    StaleBindlessHandle             (const StaleBindlessHandle&)  = delete;
+    StaleBindlessHandle& operator = (const StaleBindlessHandle&)  = delete;
+    StaleBindlessHandle& operator = (      StaleBindlessHandle&&) = delete;
+
+    StaleBindlessHandle(StaleBindlessHandle&& rhs) noexcept :
+        m_pAllocator{std::move(rhs.m_pAllocator)},
+        m_Type      {rhs.m_Type      },
+        m_Handle    {rhs.m_Handle    }
+    {
+    }
+    // clang-format on
+
+    ~StaleBindlessHandle()
+    {
+        if (m_pAllocator)
+            m_pAllocator->Recycle(m_Type, m_Handle);
+    }
+
+private:
+    std::shared_ptr<BindlessHandleAllocator> m_pAllocator;
+
+    const BINDLESS_RESOURCE_TYPE m_Type;
+    const Uint32                 m_Handle;
+};
+
+} // namespace
+
+BindlessResourceTableVkImpl::BindlessResourceTableVkImpl(IReferenceCounters*              pRefCounters,
+                                                         RenderDeviceVkImpl*              pDeviceVk,
+                                                         const BindlessResourceTableDesc& Desc) :
+    TBindlessResourceTableBase{pRefCounters, pDeviceVk, Desc}
+{
+    const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
+    VerifyDescriptorIndexingSupport(LogicalDevice.GetEnabledExtFeatures().DescriptorIndexing, m_Desc);
+
+    const auto& DescrIndexingProps = pDeviceVk->GetPhysicalDevice().GetExtProperties().DescriptorIndexing;
+
+    std::array<VkDescriptorSetLayoutBinding, BINDLESS_RESOURCE_TYPE_COUNT> Bindings      = {};
+    std::array<VkDescriptorBindingFlagsEXT, BINDLESS_RESOURCE_TYPE_COUNT>  BindingFlags  = {};
+    std::array<VkDescriptorPoolSize, BINDLESS_RESOURCE_TYPE_COUNT>         PoolSizes     = {};
+    Uint32                                                                 NumBindings   = 0;
+    Uint32                                                                 TotalNumDescr = 0;
+    for (Uint32 t = 0; t < BINDLESS_RESOURCE_TYPE_COUNT; ++t)
+    {
+        const auto Type      = static_cast<BINDLESS_RESOURCE_TYPE>(t);
+        const auto ArraySize = GetBindlessTableArraySize(m_Desc, Type);
+        if (ArraySize == 0)
+            continue;
+
+        auto& Binding              = Bindings[NumBindings];
+        Binding.binding            = t; // Shaders reference the arrays by the resource type
+        Binding.descriptorType     = BindlessResourceTypeToVkDescriptorType(Type);
+        Binding.descriptorCount    = ArraySize;
+        Binding.stageFlags         = VK_SHADER_STAGE_ALL;
+        Binding.pImmutableSamplers = nullptr;
+
+        // Descriptors of handles that are not allocated are never written, and new handles
+        // are written while the set may be in use by command buffers in flight.
+        BindingFlags[NumBindings] =
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+
+        PoolSizes[NumBindings].type            = Binding.descriptorType;
+        PoolSizes[NumBindings].descriptorCount = ArraySize;
+
+        TotalNumDescr += ArraySize;
+        ++NumBindings;
+    }
+
+    if (TotalNumDescr > DescrIndexingProps.maxUpdateAfterBindDescriptorsInAllPools)
+    {
+        LOG_ERROR_AND_THROW("Failed to create bindless resource table '", m_Desc.Name, "': the total number of descriptors (", TotalNumDescr,
+                            ") exceeds the device limit (", DescrIndexingProps.maxUpdateAfterBindDescriptorsInAllPools, ").");
+    }
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT BindingFlagsCI = {};
+    BindingFlagsCI.sType                                          = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    BindingFlagsCI.pNext                                          = nullptr;
+    BindingFlagsCI.bindingCount                                   = NumBindings;
+    BindingFlagsCI.pBindingFlags                                  = BindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo SetLayoutCI = {};
+    SetLayoutCI.sType                           = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    SetLayoutCI.pNext                           = &BindingFlagsCI;
+    SetLayoutCI.flags                           = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    SetLayoutCI.bindingCount                    = NumBindings;
+    SetLayoutCI.pBindings                       = Bindings.data();
+    m_VkSetLayout                               = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI, m_Desc.Name);
+
+    VkDescriptorPoolCreateInfo PoolCI = {};
+    PoolCI.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    PoolCI.pNext                      = nullptr;
+    PoolCI.flags                      = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    PoolCI.maxSets                    = 1;
+    PoolCI.poolSizeCount              = NumBindings;
+    PoolCI.pPoolSizes                 = PoolSizes.data();
+    m_VkDescriptorPool                = LogicalDevice.CreateDescriptorPool(PoolCI, m_Desc.Name);
+
+    VkDescriptorSetLayout       vkSetLayout       = m_VkSetLayout;
+    VkDescriptorSetAllocateInfo DescrSetAllocInfo = {};
+    DescrSetAllocInfo.sType                       = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    DescrSetAllocInfo.pNext                       = nullptr;
+    DescrSetAllocInfo.descriptorPool              = m_VkDescriptorPool;
+    DescrSetAllocInfo.descriptorSetCount          = 1;
+    DescrSetAllocInfo.pSetLayouts                 = &vkSetLayout;
+    m_VkDescriptorSet                             = LogicalDevice.AllocateVkDescriptorSet(DescrSetAllocInfo, m_Desc.Name);
+    if (m_VkDescriptorSet == VK_NULL_HANDLE)
+        LOG_ERROR_AND_THROW("Failed to allocate descriptor set for bindless resource table '", m_Desc.Name, "'");
+}
+
+BindlessResourceTableVkImpl::~BindlessResourceTableVkImpl()
+{
+    // The descriptor set is freed together with the pool
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_VkDescriptorPool), m_Desc.CommandQueueMask);
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_VkSetLayout), m_Desc.CommandQueueMask);
+}
+
+void BindlessResourceTableVkImpl::WriteDescriptor(BINDLESS_RESOURCE_TYPE Type, Uint32 Handle, IDeviceObject* pObject)
+{
+    VkWriteDescriptorSet WriteDescrSet = {};
+    WriteDescrSet.sType                = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    WriteDescrSet.pNext                = nullptr;
+    WriteDescrSet.dstSet               = m_VkDescriptorSet;
+    WriteDescrSet.dstBinding           = Type;
+    WriteDescrSet.dstArrayElement      = Handle;
+    WriteDescrSet.descriptorCount      = 1;
+    WriteDescrSet.descriptorType       = BindlessResourceTypeToVkDescriptorType(Type);
+
+    VkDescriptorImageInfo  DescrImgInfo  = {};
+    VkDescriptorBufferInfo DescrBuffInfo = {};
+    switch (Type)
+    {
+        case BINDLESS_RESOURCE_TYPE_TEXTURE_SRV:
+        case BINDLESS_RESOURCE_TYPE_TEXTURE_UAV:
+        {
+            auto* pTexViewVk       = ValidatedCast<TextureViewVkImpl>(pObject);
+            DescrImgInfo.imageView = pTexViewVk->GetVulkanImageView();
+            // Storage images must be in GENERAL layout (13.2.4). The application is responsible
+            // for transitioning the resources in the table to the states that match these layouts.
+            if (Type == BINDLESS_RESOURCE_TYPE_TEXTURE_UAV)
+                DescrImgInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+            else if (pTexViewVk->GetTexture()->GetDesc().BindFlags & BIND_DEPTH_STENCIL)
+                DescrImgInfo.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            else
+                DescrImgInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            WriteDescrSet.pImageInfo = &DescrImgInfo;
+            break;
+        }
+
+        case BINDLESS_RESOURCE_TYPE_BUFFER_SRV:
+        case BINDLESS_RESOURCE_TYPE_BUFFER_UAV:
+        {
+            auto*       pBuffViewVk   = ValidatedCast<BufferViewVkImpl>(pObject);
+            const auto& ViewDesc      = pBuffViewVk->GetDesc();
+            DescrBuffInfo.buffer      = pBuffViewVk->GetBufferVk()->GetVkBuffer();
+            DescrBuffInfo.offset      = ViewDesc.ByteOffset;
+            DescrBuffInfo.range       = ViewDesc.ByteWidth;
+            WriteDescrSet.pBufferInfo = &DescrBuffInfo;
+            break;
+        }
+
+        case BINDLESS_RESOURCE_TYPE_SAMPLER:
+            DescrImgInfo.sampler     = ValidatedCast<SamplerVkImpl>(pObject)->GetVkSampler();
+            DescrImgInfo.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            WriteDescrSet.pImageInfo = &DescrImgInfo;
+            break;
+
+        default:
+            UNEXPECTED("Unexpected bindless resource type");
+            return;
+    }
+
+    // The descriptor at this index is not used by any command buffer in flight as the handle
+    // is recycled only after all command buffers that could reference it have completed.
+    m_pDevice->GetLogicalDevice().UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
+}
+
+void BindlessResourceTableVkImpl::RecycleHandle(BINDLESS_RESOURCE_TYPE Type, Uint32 Handle)
+{
+    m_pDevice->SafeReleaseDeviceObject(StaleBindlessHandle{m_pHandleAllocator, Type, Handle}, m_Desc.CommandQueueMask);
+}
+
+} // namespace Diligent
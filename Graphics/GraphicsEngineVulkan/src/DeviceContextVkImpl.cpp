@@ -30,6 +30,7 @@
 #include "RenderDeviceVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
 #include "PipelineStateVkImpl.hpp"
+#include "BindlessResourceTableVkImpl.hpp"
 #include "TextureVkImpl.hpp"
 #include "BufferVkImpl.hpp"
 #include "RenderPassVkImpl.hpp"
@@ -70,6 +71,12 @@ DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*                   p
         bIsDeferred
     },
     m_CommandBuffer { pDeviceVkImpl->GetLogicalDevice().GetEnabledShaderStages() },
+    m_MaxDrawIndirectCount
+    {
+        pDeviceVkImpl->GetLogicalDevice().GetEnabledFeatures().multiDrawIndirect != VK_FALSE ?
+            pDeviceVkImpl->GetPhysicalDevice().GetProperties().limits.maxDrawIndirectCount :
+            1
+    },
     m_CmdListAllocator { GetRawAllocator(), sizeof(CommandListVkImpl), 64 },
     // Command pools must be thread safe because command buffers are returned into pools by release queues
     // potentially running in another thread
@@ -231,6 +238,13 @@ inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(Uint32 CmdQueue, Uint64
 void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
     auto* pPipelineStateVk = ValidatedCast<PipelineStateVkImpl>(pPipelineState);
+    if (pPipelineStateVk != nullptr && !pPipelineStateVk->IsReady())
+    {
+        // The pipeline is being compiled asynchronously or has failed to compile
+        pPipelineStateVk = ValidatedCast<PipelineStateVkImpl>(pPipelineStateVk->GetPipelineStateToBind());
+        if (pPipelineStateVk == nullptr)
+            return;
+    }
     if (PipelineStateVkImpl::IsSameObject(m_pPipelineState, pPipelineStateVk))
         return;
 
@@ -272,6 +286,7 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 
     auto vkPipeline = pPipelineStateVk->GetVkPipeline();
 
+    VkPipelineBindPoint BindPoint = VK_PIPELINE_BIND_POINT_MAX_ENUM;
     switch (PSODesc.PipelineType)
     {
         case PIPELINE_TYPE_GRAPHICS:
@@ -279,6 +294,7 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
         {
             auto& GraphicsPipeline = pPipelineStateVk->GetGraphicsPipelineDesc();
             m_CommandBuffer.BindGraphicsPipeline(vkPipeline);
+            BindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 
             if (CommitStates)
             {
@@ -296,17 +312,28 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
         case PIPELINE_TYPE_COMPUTE:
         {
             m_CommandBuffer.BindComputePipeline(vkPipeline);
+            BindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
             break;
         }
         case PIPELINE_TYPE_RAY_TRACING:
         {
             m_CommandBuffer.BindRayTracingPipeline(vkPipeline);
+            BindPoint = VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR;
             break;
         }
         default:
             UNEXPECTED("unknown pipeline type");
     }
 
+    const auto& Layout = pPipelineStateVk->GetPipelineLayout();
+    if (Layout.GetBindlessSetIndex() >= 0)
+    {
+        // The bindless resource table set goes after all other sets, so binding shader resources
+        // with the same pipeline layout does not disturb it, and it only needs to be bound once per pipeline.
+        VkDescriptorSet vkBindlessSet = Layout.GetBindlessTable()->GetVkDescriptorSet();
+        m_CommandBuffer.BindDescriptorSets(BindPoint, Layout.GetVkPipelineLayout(), static_cast<Uint32>(Layout.GetBindlessSetIndex()), 1, &vkBindlessSet);
+    }
+
     m_DescrSetBindInfo.Reset();
 }
 
@@ -613,6 +640,100 @@ void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
     ++m_State.NumCommands;
 }
 
+void DeviceContextVkImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawArguments(Attribs))
+        return;
+
+    PrepareForDraw(Attribs.Flags);
+
+    // VK_EXT_multi_draw is not available in the Vulkan headers the engine is built with, so the
+    // draws are recorded one by one. The pipeline and resources are only prepared once though.
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        m_CommandBuffer.Draw(Item.NumVertices, Attribs.NumInstances, Item.StartVertexLocation, Attribs.FirstInstanceLocation);
+    }
+    m_State.NumCommands += Attribs.DrawCount;
+}
+
+void DeviceContextVkImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    if (!DvpVerifyMultiDrawIndexedArguments(Attribs))
+        return;
+
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        m_CommandBuffer.DrawIndexed(Item.NumIndices, Attribs.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Attribs.FirstInstanceLocation);
+    }
+    m_State.NumCommands += Attribs.DrawCount;
+}
+
+void DeviceContextVkImpl::MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    if (!DvpVerifyMultiDrawIndirectArguments(Attribs, pAttribsBuffer, pCountBuffer))
+        return;
+
+    // We must prepare indirect draw attribs and count buffers first because state transitions must
+    // be performed outside of render pass, and PrepareForDraw commits render pass
+    BufferVkImpl* pIndirectDrawAttribsVk = PrepareIndirectDrawAttribsBuffer(pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode);
+    BufferVkImpl* pCountBufferVk         = pCountBuffer != nullptr ? PrepareIndirectDrawAttribsBuffer(pCountBuffer, Attribs.CountBufferStateTransitionMode) : nullptr;
+
+    PrepareForDraw(Attribs.Flags);
+
+    constexpr Uint32 Stride     = sizeof(VkDrawIndirectCommand);
+    const auto       ArgsOffset = pIndirectDrawAttribsVk->GetDynamicOffset(m_ContextId, this) + Attribs.IndirectDrawArgsOffset;
+    if (pCountBufferVk != nullptr)
+    {
+        m_CommandBuffer.DrawIndirectCount(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset,
+                                          pCountBufferVk->GetVkBuffer(), pCountBufferVk->GetDynamicOffset(m_ContextId, this) + Attribs.CountBufferOffset,
+                                          Attribs.DrawCount, Stride);
+    }
+    else
+    {
+        for (Uint32 FirstDraw = 0; FirstDraw < Attribs.DrawCount; FirstDraw += m_MaxDrawIndirectCount)
+        {
+            const auto DrawCount = std::min(Attribs.DrawCount - FirstDraw, m_MaxDrawIndirectCount);
+            m_CommandBuffer.DrawIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset + VkDeviceSize{FirstDraw} * Stride, DrawCount, Stride);
+        }
+    }
+    ++m_State.NumCommands;
+}
+
+void DeviceContextVkImpl::MultiDrawIndexedIndirect(const MultiDrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    if (!DvpVerifyMultiDrawIndexedIndirectArguments(Attribs, pAttribsBuffer, pCountBuffer))
+        return;
+
+    // We must prepare indirect draw attribs and count buffers first because state transitions must
+    // be performed outside of render pass, and PrepareForDraw commits render pass
+    BufferVkImpl* pIndirectDrawAttribsVk = PrepareIndirectDrawAttribsBuffer(pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode);
+    BufferVkImpl* pCountBufferVk         = pCountBuffer != nullptr ? PrepareIndirectDrawAttribsBuffer(pCountBuffer, Attribs.CountBufferStateTransitionMode) : nullptr;
+
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+
+    constexpr Uint32 Stride     = sizeof(VkDrawIndexedIndirectCommand);
+    const auto       ArgsOffset = pIndirectDrawAttribsVk->GetDynamicOffset(m_ContextId, this) + Attribs.IndirectDrawArgsOffset;
+    if (pCountBufferVk != nullptr)
+    {
+        m_CommandBuffer.DrawIndexedIndirectCount(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset,
+                                                 pCountBufferVk->GetVkBuffer(), pCountBufferVk->GetDynamicOffset(m_ContextId, this) + Attribs.CountBufferOffset,
+                                                 Attribs.DrawCount, Stride);
+    }
+    else
+    {
+        for (Uint32 FirstDraw = 0; FirstDraw < Attribs.DrawCount; FirstDraw += m_MaxDrawIndirectCount)
+        {
+            const auto DrawCount = std::min(Attribs.DrawCount - FirstDraw, m_MaxDrawIndirectCount);
+            m_CommandBuffer.DrawIndexedIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset + VkDeviceSize{FirstDraw} * Stride, DrawCount, Stride);
+        }
+    }
+    ++m_State.NumCommands;
+}
+
 void DeviceContextVkImpl::PrepareForDispatchCompute()
 {
     EnsureVkCmdBuffer();
@@ -1036,6 +1157,7 @@ void DeviceContextVkImpl::Flush()
     m_pPipelineState    = nullptr;
     m_pActiveRenderPass = nullptr;
     m_pBoundFramebuffer = nullptr;
+    InvalidateCommittedShaderResources();
 }
 
 void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartSlot,
@@ -1045,7 +1167,9 @@ void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+    if (!TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags, 0 /*Dummy*/))
+        return;
+
     for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
     {
         auto& CurrStream = m_VertexStreams[Buff];
@@ -1132,7 +1256,9 @@ void DeviceContextVkImpl::CommitViewports()
 
 void DeviceContextVkImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
+
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
 
     CommitViewports();
@@ -1161,7 +1287,8 @@ void DeviceContextVkImpl::CommitScissorRects()
 
 void DeviceContextVkImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight))
+        return;
 
     // Only commit scissor rects if scissor test is enabled in the rasterizer state.
     // If scissor is currently disabled, or no PSO is bound, scissor rects will be committed by
@@ -30,6 +30,8 @@
 
 #include "pch.h"
 #include <array>
+#include <algorithm>
+#include <mutex>
 #include "EngineFactoryVk.h"
 #include "RenderDeviceVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
@@ -39,6 +41,7 @@
 #include "VulkanUtilities/VulkanInstance.hpp"
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
 #include "EngineFactoryBase.hpp"
+#include "ShaderBytecodeCache.hpp"
 
 #if PLATFORM_ANDROID
 #    include "FileSystem.hpp"
@@ -81,6 +84,8 @@ public:
                                                       const NativeWindow&  Window,
                                                       ISwapChain**         ppSwapChain) override final;
 
+    virtual void DILIGENT_CALL_TYPE GetShaderBytecodeCacheStats(ShaderBytecodeCacheStats& Stats) const override final;
+
 #if PLATFORM_ANDROID
     virtual void InitAndroidFileSystem(struct ANativeActivity* NativeActivity,
                                        const char*             NativeActivityClassName,
@@ -89,6 +94,10 @@ public:
 
 private:
     std::function<void(RenderDeviceVkImpl*)> OnRenderDeviceCreated = nullptr;
+
+    // Shader bytecode caches of the render devices created by the factory
+    mutable std::mutex                              m_ShaderCachesMtx;
+    std::vector<std::weak_ptr<ShaderBytecodeCache>> m_ShaderBytecodeCaches;
 };
 
 
@@ -178,6 +187,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         DeviceCreateInfo.pQueueCreateInfos       = &QueueInfo;
         VkPhysicalDeviceFeatures EnabledFeatures = {};
         EnabledFeatures.fullDrawIndexUint32      = PhysicalDeviceFeatures.fullDrawIndexUint32;
+        EnabledFeatures.multiDrawIndirect        = PhysicalDeviceFeatures.multiDrawIndirect;
 
         auto GetFeatureState = [](DEVICE_FEATURE_STATE RequestedState, bool IsFeatureSupported, const char* FeatureName) //
         {
@@ -279,6 +289,14 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         // clang-format on
 
         ENABLE_FEATURE(DeviceExtFeatures.AccelStruct.accelerationStructure != VK_FALSE && DeviceExtFeatures.RayTracingPipeline.rayTracingPipeline != VK_FALSE, RayTracing, "Ray tracing is");
+
+#if DILIGENT_USE_VOLK
+        const bool DrawIndirectCountSupported = PhysicalDevice->IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+#else
+        // vkCmdDrawIndirectCountKHR can only be loaded through volk
+        const bool DrawIndirectCountSupported = false;
+#endif
+        ENABLE_FEATURE(DrawIndirectCountSupported, DrawIndirectCount, "Indirect draw count is");
 #undef FeatureSupport
 
 
@@ -414,8 +432,6 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
                     VERIFY_EXPR(DeviceExtFeatures.Spirv14);
                 }
 
-                DeviceExtensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);             // required for VK_EXT_descriptor_indexing
-                DeviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);      // required for VK_KHR_acceleration_structure
                 DeviceExtensions.push_back(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);    // required for VK_KHR_acceleration_structure
                 DeviceExtensions.push_back(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME); // required for VK_KHR_acceleration_structure
                 DeviceExtensions.push_back(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME);   // required for ray tracing
@@ -424,7 +440,6 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
                 EnabledExtFeats.AccelStruct         = DeviceExtFeatures.AccelStruct;
                 EnabledExtFeats.RayTracingPipeline  = DeviceExtFeatures.RayTracingPipeline;
                 EnabledExtFeats.BufferDeviceAddress = DeviceExtFeatures.BufferDeviceAddress;
-                EnabledExtFeats.DescriptorIndexing  = DeviceExtFeatures.DescriptorIndexing;
 
                 // disable unused features
                 EnabledExtFeats.AccelStruct.accelerationStructureCaptureReplay                    = false;
@@ -441,18 +456,34 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
                 NextExt  = &EnabledExtFeats.AccelStruct.pNext;
                 *NextExt = &EnabledExtFeats.RayTracingPipeline;
                 NextExt  = &EnabledExtFeats.RayTracingPipeline.pNext;
-                *NextExt = &EnabledExtFeats.DescriptorIndexing;
-                NextExt  = &EnabledExtFeats.DescriptorIndexing.pNext;
                 *NextExt = &EnabledExtFeats.BufferDeviceAddress;
                 NextExt  = &EnabledExtFeats.BufferDeviceAddress.pNext;
             }
 
+            // Descriptor indexing is required by VK_KHR_acceleration_structure and by bindless resource tables
+            if (EngineCI.Features.RayTracing != DEVICE_FEATURE_STATE_DISABLED ||
+                (EngineCI.Features.BindlessResources != DEVICE_FEATURE_STATE_DISABLED &&
+                 PhysicalDevice->IsExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)))
+            {
+                DeviceExtensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);        // required for VK_EXT_descriptor_indexing
+                DeviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+
+                EnabledExtFeats.DescriptorIndexing = DeviceExtFeatures.DescriptorIndexing;
+
+                *NextExt = &EnabledExtFeats.DescriptorIndexing;
+                NextExt  = &EnabledExtFeats.DescriptorIndexing.pNext;
+            }
+
             // make sure that last pNext is null
             *NextExt = nullptr;
         }
 
+        // VK_KHR_draw_indirect_count does not define any features
+        if (EngineCI.Features.DrawIndirectCount != DEVICE_FEATURE_STATE_DISABLED)
+            DeviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+
 #if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+        static_assert(sizeof(DeviceFeatures) == 33, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 
         DeviceCreateInfo.ppEnabledExtensionNames = DeviceExtensions.empty() ? nullptr : DeviceExtensions.data();
@@ -529,7 +560,20 @@ void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::
     {
         auto& RawMemAllocator = GetRawAllocator();
 
-        RenderDeviceVkImpl* pRenderDeviceVk(NEW_RC_OBJ(RawMemAllocator, "RenderDeviceVkImpl instance", RenderDeviceVkImpl)(RawMemAllocator, this, EngineCI, CommandQueueCount, ppCommandQueues, Instance, std::move(PhysicalDevice), LogicalDevice));
+        std::shared_ptr<ShaderBytecodeCache> pShaderBytecodeCache;
+        if (EngineCI.ShaderCacheDirectory != nullptr)
+        {
+            pShaderBytecodeCache = std::make_shared<ShaderBytecodeCache>(EngineCI.ShaderCacheDirectory, EngineCI.ShaderCacheMaxSize);
+
+            std::lock_guard<std::mutex> Lock{m_ShaderCachesMtx};
+            // Forget the caches of the devices that have been destroyed
+            m_ShaderBytecodeCaches.erase(std::remove_if(m_ShaderBytecodeCaches.begin(), m_ShaderBytecodeCaches.end(),
+                                                        [](const std::weak_ptr<ShaderBytecodeCache>& pCache) { return pCache.expired(); }),
+                                         m_ShaderBytecodeCaches.end());
+            m_ShaderBytecodeCaches.emplace_back(pShaderBytecodeCache);
+        }
+
+        RenderDeviceVkImpl* pRenderDeviceVk(NEW_RC_OBJ(RawMemAllocator, "RenderDeviceVkImpl instance", RenderDeviceVkImpl)(RawMemAllocator, this, EngineCI, CommandQueueCount, ppCommandQueues, Instance, std::move(PhysicalDevice), LogicalDevice, std::move(pShaderBytecodeCache)));
         pRenderDeviceVk->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
 
         if (OnRenderDeviceCreated != nullptr)
@@ -606,6 +650,27 @@ void EngineFactoryVkImpl::CreateSwapChainVk(IRenderDevice*       pDevice,
     }
 }
 
+void EngineFactoryVkImpl::GetShaderBytecodeCacheStats(ShaderBytecodeCacheStats& Stats) const
+{
+    Stats = ShaderBytecodeCacheStats{};
+
+    std::lock_guard<std::mutex> Lock{m_ShaderCachesMtx};
+    for (const auto& pWeakCache : m_ShaderBytecodeCaches)
+    {
+        auto pCache = pWeakCache.lock();
+        if (!pCache)
+            continue;
+
+        const auto CacheStats = pCache->GetStats();
+        Stats.NumHits += CacheStats.NumHits;
+        Stats.NumMisses += CacheStats.NumMisses;
+        Stats.NumStores += CacheStats.NumStores;
+        Stats.NumEvictions += CacheStats.NumEvictions;
+        Stats.NumEntries += CacheStats.NumEntries;
+        Stats.TotalSize += CacheStats.TotalSize;
+    }
+}
+
 #if PLATFORM_ANDROID
 void EngineFactoryVkImpl::InitAndroidFileSystem(struct ANativeActivity* NativeActivity,
                                                 const char*             NativeActivityClassName,
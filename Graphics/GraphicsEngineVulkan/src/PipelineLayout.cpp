@@ -36,6 +36,7 @@
 #include "BufferVkImpl.hpp"
 #include "VulkanTypeConversions.hpp"
 #include "HashUtils.hpp"
+#include "BindlessResourceTableVkImpl.hpp"
 
 namespace Diligent
 {
@@ -242,7 +243,8 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
     m_LayoutBindings.resize(TotalBindings);
     size_t BindingOffset = 0;
 
-    std::array<VkDescriptorSetLayout, 2> ActiveDescrSetLayouts = {};
+    // The bindless resource table set, if any, goes after the static/mutable and dynamic sets
+    std::array<VkDescriptorSetLayout, 3> ActiveDescrSetLayouts = {};
     for (auto& Layout : m_DescriptorSetLayouts)
     {
         if (Layout.SetIndex >= 0)
@@ -260,12 +262,20 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
                 m_ActiveSets == 2 && ActiveDescrSetLayouts[0] != VK_NULL_HANDLE && ActiveDescrSetLayouts[1] != VK_NULL_HANDLE);
     // clang-format on
 
+    Uint32 NumSetLayouts = m_ActiveSets;
+    if (m_BindlessSetIndex >= 0)
+    {
+        VERIFY_EXPR(m_pBindlessTable != nullptr && m_BindlessSetIndex == m_ActiveSets);
+        ActiveDescrSetLayouts[m_BindlessSetIndex] = m_pBindlessTable->GetVkDescriptorSetLayout();
+        ++NumSetLayouts;
+    }
+
     VkPipelineLayoutCreateInfo PipelineLayoutCI = {};
 
     PipelineLayoutCI.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     PipelineLayoutCI.pNext                  = nullptr;
     PipelineLayoutCI.flags                  = 0; // reserved for future use
-    PipelineLayoutCI.setLayoutCount         = m_ActiveSets;
+    PipelineLayoutCI.setLayoutCount         = NumSetLayouts;
     PipelineLayoutCI.pSetLayouts            = PipelineLayoutCI.setLayoutCount != 0 ? ActiveDescrSetLayouts.data() : nullptr;
     PipelineLayoutCI.pushConstantRangeCount = 0;
     PipelineLayoutCI.pPushConstantRanges    = nullptr;
@@ -296,6 +306,9 @@ bool PipelineLayout::DescriptorSetLayoutManager::operator==(const DescriptorSetL
     if (m_ActiveSets != rhs.m_ActiveSets)
         return false;
 
+    if (m_pBindlessTable != rhs.m_pBindlessTable || m_BindlessSetIndex != rhs.m_BindlessSetIndex)
+        return false;
+
     for (size_t i = 0; i < m_DescriptorSetLayouts.size(); ++i)
         if (m_DescriptorSetLayouts[i] != rhs.m_DescriptorSetLayouts[i])
             return false;
@@ -308,10 +321,26 @@ size_t PipelineLayout::DescriptorSetLayoutManager::GetHash() const
     size_t Hash = 0;
     for (const auto& SetLayout : m_DescriptorSetLayouts)
         HashCombine(Hash, SetLayout.GetHash());
+    HashCombine(Hash, m_pBindlessTable, m_BindlessSetIndex);
 
     return Hash;
 }
 
+void PipelineLayout::DescriptorSetLayoutManager::SetBindlessTable(const BindlessResourceTableVkImpl* pBindlessTable)
+{
+    VERIFY(m_ActiveSets == 0 && m_BindlessSetIndex < 0, "Bindless resource table must be set before any resource slot is allocated");
+    m_pBindlessTable = pBindlessTable;
+}
+
+Uint32 PipelineLayout::DescriptorSetLayoutManager::AllocateBindlessSet()
+{
+    VERIFY(m_pBindlessTable != nullptr, "Bindless resource table is not set");
+    if (m_BindlessSetIndex < 0)
+        m_BindlessSetIndex = static_cast<int8_t>(m_ActiveSets);
+
+    return static_cast<Uint32>(m_BindlessSetIndex);
+}
+
 void PipelineLayout::DescriptorSetLayoutManager::AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResAttribs,
                                                                       SHADER_RESOURCE_VARIABLE_TYPE     VariableType,
                                                                       VkSampler                         vkImmutableSampler,
@@ -320,6 +349,8 @@ void PipelineLayout::DescriptorSetLayoutManager::AllocateResourceSlot(const SPIR
                                                                       Uint32&                           Binding,
                                                                       Uint32&                           OffsetInCache)
 {
+    VERIFY(m_BindlessSetIndex < 0, "Resource slots must be allocated before the bindless resource table set");
+
     auto& DescrSet = GetDescriptorSet(VariableType);
     if (DescrSet.SetIndex < 0)
     {
@@ -0,0 +1,209 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <cstring>
+
+#include "PipelineStateCacheVkImpl.hpp"
+#include "DataBlobImpl.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 PSOCacheMagic   = 0x43505644; // 'DVPC'
+constexpr Uint32 PSOCacheVersion = 1;
+
+// Header that precedes the data returned by vkGetPipelineCacheData().
+// VkPipelineCacheHeaderVersionOne does not include the driver version, so
+// it is stored here along with the device identification.
+struct PSOCacheDataHeader
+{
+    Uint32 Magic                           = PSOCacheMagic;
+    Uint32 Version                         = PSOCacheVersion;
+    Uint32 VendorID                        = 0;
+    Uint32 DeviceID                        = 0;
+    Uint32 DriverVersion                   = 0;
+    Uint32 DataSize                        = 0;
+    Uint64 DataHash                        = 0;
+    Uint8  PipelineCacheUUID[VK_UUID_SIZE] = {};
+};
+
+// 64-bit FNV-1a hash used to detect corrupted cache data
+Uint64 ComputeDataHash(const void* pData, size_t Size)
+{
+    const auto* pBytes = static_cast<const Uint8*>(pData);
+
+    Uint64 Hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < Size; ++i)
+    {
+        Hash ^= pBytes[i];
+        Hash *= 0x100000001B3ull;
+    }
+    return Hash;
+}
+
+PSOCacheDataHeader GetDeviceHeader(const VkPhysicalDeviceProperties& Props)
+{
+    PSOCacheDataHeader Header;
+    Header.VendorID      = Props.vendorID;
+    Header.DeviceID      = Props.deviceID;
+    Header.DriverVersion = Props.driverVersion;
+    memcpy(Header.PipelineCacheUUID, Props.pipelineCacheUUID, sizeof(Header.PipelineCacheUUID));
+    return Header;
+}
+
+// Returns the size of the Vulkan cache data that follows the header if the data is compatible
+// with the device, and zero otherwise.
+size_t ValidateCacheData(const PipelineStateCacheCreateInfo& CreateInfo,
+                         const VkPhysicalDeviceProperties&   Props)
+{
+    if (CreateInfo.pCacheData == nullptr || CreateInfo.CacheDataSize == 0)
+        return 0;
+
+    const auto* Name = CreateInfo.Desc.Name != nullptr ? CreateInfo.Desc.Name : "";
+    if (CreateInfo.CacheDataSize < sizeof(PSOCacheDataHeader))
+    {
+        LOG_WARNING_MESSAGE("Pipeline state cache '", Name, "': the data is too small and will be ignored.");
+        return 0;
+    }
+
+    PSOCacheDataHeader Header;
+    memcpy(&Header, CreateInfo.pCacheData, sizeof(Header));
+    if (Header.Magic != PSOCacheMagic || Header.Version != PSOCacheVersion)
+    {
+        LOG_WARNING_MESSAGE("Pipeline state cache '", Name, "': the data was not created by this version of the engine and will be ignored.");
+        return 0;
+    }
+
+    const auto DeviceHeader = GetDeviceHeader(Props);
+    // clang-format off
+    if (Header.VendorID      != DeviceHeader.VendorID ||
+        Header.DeviceID      != DeviceHeader.DeviceID ||
+        Header.DriverVersion != DeviceHeader.DriverVersion ||
+        memcmp(Header.PipelineCacheUUID, DeviceHeader.PipelineCacheUUID, sizeof(Header.PipelineCacheUUID)) != 0)
+    // clang-format on
+    {
+        LOG_INFO_MESSAGE("Pipeline state cache '", Name, "': the data was created by a different device or driver version and will be ignored.");
+        return 0;
+    }
+
+    const auto* pVkData = static_cast<const Uint8*>(CreateInfo.pCacheData) + sizeof(Header);
+    if (Header.DataSize != CreateInfo.CacheDataSize - sizeof(Header) ||
+        Header.DataHash != ComputeDataHash(pVkData, Header.DataSize))
+    {
+        LOG_WARNING_MESSAGE("Pipeline state cache '", Name, "': the data is corrupted and will be ignored.");
+        return 0;
+    }
+
+    return Header.DataSize;
+}
+
+} // namespace
+
+PipelineStateCacheVkImpl::PipelineStateCacheVkImpl(IReferenceCounters*                 pRefCounters,
+                                                   RenderDeviceVkImpl*                 pDeviceVk,
+                                                   const PipelineStateCacheCreateInfo& CreateInfo) :
+    TPipelineStateCacheBase{pRefCounters, pDeviceVk, CreateInfo}
+{
+    const auto& Props = pDeviceVk->GetPhysicalDevice().GetProperties();
+
+    const auto VkDataSize = ValidateCacheData(CreateInfo, Props);
+
+    VkPipelineCacheCreateInfo PipelineCacheCI{};
+    PipelineCacheCI.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    PipelineCacheCI.pNext           = nullptr;
+    PipelineCacheCI.flags           = 0;
+    PipelineCacheCI.initialDataSize = VkDataSize;
+    PipelineCacheCI.pInitialData    = VkDataSize != 0 ? static_cast<const Uint8*>(CreateInfo.pCacheData) + sizeof(PSOCacheDataHeader) : nullptr;
+
+    m_PipelineCache = pDeviceVk->GetLogicalDevice().CreatePipelineCache(PipelineCacheCI, m_Desc.Name);
+
+    m_Stats.InitialDataSize = static_cast<Uint32>(VkDataSize);
+}
+
+PipelineStateCacheVkImpl::~PipelineStateCacheVkImpl()
+{
+    // Pipeline cache is not used by the GPU, so it can be destroyed immediately
+}
+
+void PipelineStateCacheVkImpl::GetData(IDataBlob** ppBlob)
+{
+    DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
+    DEV_CHECK_ERR(*ppBlob == nullptr, "Overwriting reference to existing object may cause memory leaks");
+    *ppBlob = nullptr;
+
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+
+    size_t VkDataSize = 0;
+    auto   err        = LogicalDevice.GetPipelineCacheData(m_PipelineCache, &VkDataSize, nullptr);
+    if (err != VK_SUCCESS)
+    {
+        LOG_ERROR_MESSAGE("Failed to get the size of the pipeline cache '", m_Desc.Name, "' data");
+        return;
+    }
+
+    RefCntAutoPtr<DataBlobImpl> pDataBlob{MakeNewRCObj<DataBlobImpl>()(sizeof(PSOCacheDataHeader) + VkDataSize)};
+
+    auto* pVkData = static_cast<Uint8*>(pDataBlob->GetDataPtr()) + sizeof(PSOCacheDataHeader);
+    // The cache may grow between the two calls if other threads create pipelines. In this case
+    // vkGetPipelineCacheData returns VK_INCOMPLETE and writes as much data as fits into the buffer,
+    // which is still a valid cache.
+    err = LogicalDevice.GetPipelineCacheData(m_PipelineCache, &VkDataSize, pVkData);
+    if (err != VK_SUCCESS && err != VK_INCOMPLETE)
+    {
+        LOG_ERROR_MESSAGE("Failed to get the pipeline cache '", m_Desc.Name, "' data");
+        return;
+    }
+    pDataBlob->Resize(sizeof(PSOCacheDataHeader) + VkDataSize);
+    pVkData = static_cast<Uint8*>(pDataBlob->GetDataPtr()) + sizeof(PSOCacheDataHeader);
+
+    auto Header     = GetDeviceHeader(m_pDevice->GetPhysicalDevice().GetProperties());
+    Header.DataSize = static_cast<Uint32>(VkDataSize);
+    Header.DataHash = ComputeDataHash(pVkData, VkDataSize);
+    memcpy(pDataBlob->GetDataPtr(), &Header, sizeof(Header));
+
+    *ppBlob = pDataBlob.Detach();
+}
+
+void PipelineStateCacheVkImpl::GetStats(PipelineStateCacheStats& Stats) const
+{
+    std::lock_guard<std::mutex> Lock{m_StatsMtx};
+    Stats = m_Stats;
+}
+
+void PipelineStateCacheVkImpl::OnPipelineCreated(double CreationTime)
+{
+    std::lock_guard<std::mutex> Lock{m_StatsMtx};
+    ++m_Stats.NumPipelinesCreated;
+    m_Stats.TotalCreationTime += CreationTime;
+}
+
+} // namespace Diligent
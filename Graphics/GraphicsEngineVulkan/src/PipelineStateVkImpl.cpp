@@ -34,8 +34,11 @@
 #include "DeviceContextVkImpl.hpp"
 #include "RenderPassVkImpl.hpp"
 #include "ShaderResourceBindingVkImpl.hpp"
+#include "PipelineStateCacheVkImpl.hpp"
+#include "BindlessResourceTableVkImpl.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
+#include "Timer.hpp"
 
 
 #if !DILIGENT_NO_HLSL
@@ -129,10 +132,28 @@ void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&
 }
 
 
+// Creates the pipeline using the Vulkan pipeline cache if one is provided
+// and accounts for the time the driver spent in the cache statistics.
+template <typename CreatePipelineFuncType>
+VulkanUtilities::PipelineWrapper CreatePipelineWithCache(IPipelineStateCache* pPSOCache, CreatePipelineFuncType CreatePipeline)
+{
+    if (pPSOCache == nullptr)
+        return CreatePipeline(VK_NULL_HANDLE);
+
+    auto* pPSOCacheVk = ValidatedCast<PipelineStateCacheVkImpl>(pPSOCache);
+
+    Timer T;
+    auto  Pipeline = CreatePipeline(pPSOCacheVk->GetVkPipelineCache());
+    pPSOCacheVk->OnPipelineCreated(T.GetElapsedTime());
+    return Pipeline;
+}
+
+
 void CreateComputePipeline(RenderDeviceVkImpl*                           pDeviceVk,
                            std::vector<VkPipelineShaderStageCreateInfo>& Stages,
                            const PipelineLayout&                         Layout,
                            const PipelineStateDesc&                      PSODesc,
+                           IPipelineStateCache*                          pPSOCache,
                            VulkanUtilities::PipelineWrapper&             Pipeline)
 {
     const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
@@ -150,7 +171,9 @@ void CreateComputePipeline(RenderDeviceVkImpl*                           pDevice
     PipelineCI.stage  = Stages[0];
     PipelineCI.layout = Layout.GetVkPipelineLayout();
 
-    Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, VK_NULL_HANDLE, PSODesc.Name);
+    Pipeline = CreatePipelineWithCache(pPSOCache, [&](VkPipelineCache vkCache) {
+        return LogicalDevice.CreateComputePipeline(PipelineCI, vkCache, PSODesc.Name);
+    });
 }
 
 
@@ -159,6 +182,7 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
                             const PipelineLayout&                         Layout,
                             const PipelineStateDesc&                      PSODesc,
                             const GraphicsPipelineDesc&                   GraphicsPipeline,
+                            IPipelineStateCache*                          pPSOCache,
                             VulkanUtilities::PipelineWrapper&             Pipeline,
                             RefCntAutoPtr<IRenderPass>&                   pRenderPass)
 {
@@ -334,7 +358,9 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
     PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex  = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
-    Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, VK_NULL_HANDLE, PSODesc.Name);
+    Pipeline = CreatePipelineWithCache(pPSOCache, [&](VkPipelineCache vkCache) {
+        return LogicalDevice.CreateGraphicsPipeline(PipelineCI, vkCache, PSODesc.Name);
+    });
 }
 
 
@@ -344,6 +370,7 @@ void CreateRayTracingPipeline(RenderDeviceVkImpl*
                               const PipelineLayout&                                    Layout,
                               const PipelineStateDesc&                                 PSODesc,
                               const RayTracingPipelineDesc&                            RayTracingPipeline,
+                              IPipelineStateCache*                                     pPSOCache,
                               VulkanUtilities::PipelineWrapper&                        Pipeline)
 {
     const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
@@ -368,7 +395,9 @@ void CreateRayTracingPipeline(RenderDeviceVkImpl*
     PipelineCI.basePipelineHandle           = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex            = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
-    Pipeline = LogicalDevice.CreateRayTracingPipeline(PipelineCI, VK_NULL_HANDLE, PSODesc.Name);
+    Pipeline = CreatePipelineWithCache(pPSOCache, [&](VkPipelineCache vkCache) {
+        return LogicalDevice.CreateRayTracingPipeline(PipelineCI, vkCache, PSODesc.Name);
+    });
 }
 
 
@@ -609,9 +638,12 @@ void PipelineStateVkImpl::InitResourceLayouts(const PipelineStateCreateInfo& Cre
         m_StaticVarsMgrs[s].Initialize(StaticResLayout, GetRawAllocator(), nullptr, 0);
     }
 
+    if (m_pBindlessTable)
+        m_PipelineLayout.SetBindlessTable(m_pBindlessTable.RawPtr<BindlessResourceTableVkImpl>());
+
     // Initialize shader resource layouts and assign bindings and descriptor sets in shader SPIRVs
     ShaderResourceLayoutVk::Initialize(pDeviceVk, ShaderStages, m_ShaderResourceLayouts, GetRawAllocator(),
-                                       m_Desc.ResourceLayout, m_PipelineLayout,
+                                       m_Desc.ResourceLayout, m_PipelineLayout, m_Desc.Name,
                                        (CreateInfo.Flags & PSO_CREATE_FLAG_IGNORE_MISSING_VARIABLES) == 0,
                                        (CreateInfo.Flags & PSO_CREATE_FLAG_IGNORE_MISSING_IMMUTABLE_SAMPLERS) == 0);
     m_PipelineLayout.Finalize(LogicalDevice);
@@ -711,12 +743,18 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+        auto Initialize = [this](const GraphicsPipelineStateCreateInfo& CI) //
+        {
+            std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
+            std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
 
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+            InitInternalObjects(CI, vkShaderStages, ShaderModules);
 
-        CreateGraphicsPipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(), m_Pipeline, m_pRenderPass);
+            // GetGraphicsPipelineDesc() can't be used here as it waits for asynchronous initialization
+            CreateGraphicsPipeline(GetDevice(), vkShaderStages, m_PipelineLayout, m_Desc, *m_pGraphicsPipelineDesc, CI.pPSOCache, m_Pipeline, m_pRenderPass);
+        };
+        if (!DeferInitialization(CreateInfo, Initialize))
+            Initialize(CreateInfo);
     }
     catch (...)
     {
@@ -734,12 +772,17 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*                   p
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+        auto Initialize = [this](const ComputePipelineStateCreateInfo& CI) //
+        {
+            std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
+            std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
 
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+            InitInternalObjects(CI, vkShaderStages, ShaderModules);
 
-        CreateComputePipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline);
+            CreateComputePipeline(GetDevice(), vkShaderStages, m_PipelineLayout, m_Desc, CI.pPSOCache, m_Pipeline);
+        };
+        if (!DeferInitialization(CreateInfo, Initialize))
+            Initialize(CreateInfo);
     }
     catch (...)
     {
@@ -766,7 +809,7 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*
 
         const auto ShaderGroups = BuildRTShaderGroupDescription(CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex, ShaderStages);
 
-        CreateRayTracingPipeline(pDeviceVk, vkShaderStages, ShaderGroups, m_PipelineLayout, m_Desc, GetRayTracingPipelineDesc(), m_Pipeline);
+        CreateRayTracingPipeline(pDeviceVk, vkShaderStages, ShaderGroups, m_PipelineLayout, m_Desc, GetRayTracingPipelineDesc(), CreateInfo.pPSOCache, m_Pipeline);
 
         auto err = LogicalDevice.GetRayTracingShaderGroupHandles(m_Pipeline, 0, static_cast<uint32_t>(ShaderGroups.size()), m_pRayTracingPipelineData->ShaderDataSize, m_pRayTracingPipelineData->ShaderHandles);
         DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to get shader group handles");
@@ -821,6 +864,17 @@ void PipelineStateVkImpl::Destruct()
 
 void PipelineStateVkImpl::CreateShaderResourceBinding(IShaderResourceBinding** ppShaderResourceBinding, bool InitStaticResources)
 {
+    WaitForAsyncInitialization();
+
+    if (auto* pPooledSRB = TakeSRBFromPool<ShaderResourceBindingVkImpl>())
+    {
+        if (InitStaticResources)
+            pPooledSRB->InitializeStaticResources(nullptr);
+        // Transfer the reference held by the pool to the caller
+        *ppShaderResourceBinding = pPooledSRB;
+        return;
+    }
+
     auto& SRBAllocator  = m_pDevice->GetSRBAllocator();
     auto  pResBindingVk = NEW_RC_OBJ(SRBAllocator, "ShaderResourceBindingVkImpl instance", ShaderResourceBindingVkImpl)(this, false);
     if (InitStaticResources)
@@ -828,6 +882,15 @@ void PipelineStateVkImpl::CreateShaderResourceBinding(IShaderResourceBinding** p
     pResBindingVk->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(ppShaderResourceBinding));
 }
 
+void PipelineStateVkImpl::RecycleShaderResourceBinding(IShaderResourceBinding* pSRB)
+{
+    VERIFY_EXPR(m_pSRBPool);
+    // Descriptor sets of the SRB may be referenced by command buffers that have not completed yet,
+    // so the SRB only becomes available once the release queues are purged.
+    if (m_pSRBPool->AddPending(pSRB))
+        m_pDevice->SafeReleaseDeviceObject(ShaderResourceBindingPool::StaleObject{m_pSRBPool, pSRB}, m_Desc.CommandQueueMask);
+}
+
 bool PipelineStateVkImpl::IsCompatibleWith(const IPipelineState* pPSO) const
 {
     VERIFY_EXPR(pPSO != nullptr);
@@ -836,6 +899,9 @@ bool PipelineStateVkImpl::IsCompatibleWith(const IPipelineState* pPSO) const
         return true;
 
     const PipelineStateVkImpl* pPSOVk = ValidatedCast<const PipelineStateVkImpl>(pPSO);
+    WaitForAsyncInitialization();
+    pPSOVk->WaitForAsyncInitialization();
+
     if (m_ShaderResourceLayoutHash != pPSOVk->m_ShaderResourceLayoutHash)
         return false;
 
@@ -982,6 +1048,8 @@ void PipelineStateVkImpl::CommitAndTransitionShaderResources(IShaderResourceBind
 
 void PipelineStateVkImpl::BindStaticResources(Uint32 ShaderFlags, IResourceMapping* pResourceMapping, Uint32 Flags)
 {
+    WaitForAsyncInitialization();
+
     for (Uint32 s = 0; s < GetNumShaderStages(); ++s)
     {
         auto ShaderType = GetStaticShaderResLayout(s).GetShaderType();
@@ -995,6 +1063,8 @@ void PipelineStateVkImpl::BindStaticResources(Uint32 ShaderFlags, IResourceMappi
 
 Uint32 PipelineStateVkImpl::GetStaticVariableCount(SHADER_TYPE ShaderType) const
 {
+    WaitForAsyncInitialization();
+
     const auto LayoutInd = GetStaticVariableCountHelper(ShaderType, m_ResourceLayoutIndex);
     if (LayoutInd < 0)
         return 0;
@@ -1005,6 +1075,8 @@ Uint32 PipelineStateVkImpl::GetStaticVariableCount(SHADER_TYPE ShaderType) const
 
 IShaderResourceVariable* PipelineStateVkImpl::GetStaticVariableByName(SHADER_TYPE ShaderType, const Char* Name)
 {
+    WaitForAsyncInitialization();
+
     const auto LayoutInd = GetStaticVariableByNameHelper(ShaderType, Name, m_ResourceLayoutIndex);
     if (LayoutInd < 0)
         return nullptr;
@@ -1015,6 +1087,8 @@ IShaderResourceVariable* PipelineStateVkImpl::GetStaticVariableByName(SHADER_TYP
 
 IShaderResourceVariable* PipelineStateVkImpl::GetStaticVariableByIndex(SHADER_TYPE ShaderType, Uint32 Index)
 {
+    WaitForAsyncInitialization();
+
     const auto LayoutInd = GetStaticVariableByIndexHelper(ShaderType, Index, m_ResourceLayoutIndex);
     if (LayoutInd < 0)
         return nullptr;
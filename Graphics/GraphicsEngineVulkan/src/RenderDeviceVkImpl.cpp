@@ -42,6 +42,8 @@
 #include "BottomLevelASVkImpl.hpp"
 #include "TopLevelASVkImpl.hpp"
 #include "ShaderBindingTableVkImpl.hpp"
+#include "PipelineStateCacheVkImpl.hpp"
+#include "BindlessResourceTableVkImpl.hpp"
 #include "EngineMemory.h"
 
 namespace Diligent
@@ -55,7 +57,8 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
                                        ICommandQueueVk**                                      CmdQueues,
                                        std::shared_ptr<VulkanUtilities::VulkanInstance>       Instance,
                                        std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> PhysicalDevice,
-                                       std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  LogicalDevice) :
+                                       std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  LogicalDevice,
+                                       std::shared_ptr<ShaderBytecodeCache>                   pShaderBytecodeCache) :
     // clang-format off
     TRenderDeviceBase
     {
@@ -82,6 +85,8 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
             sizeof(BottomLevelASVkImpl),
             sizeof(TopLevelASVkImpl),
             sizeof(ShaderBindingTableVkImpl),
+            sizeof(PipelineStateCacheVkImpl),
+            sizeof(BindlessResourceTableVkImpl),
         }
     },
     m_VulkanInstance         {Instance                 },
@@ -160,6 +165,7 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         ~Uint64{0}
     },
     m_pDxCompiler{CreateDXCompiler(DXCompilerTarget::Vulkan, EngineCI.pDxCompilerPath)},
+    m_pShaderBytecodeCache{std::move(pShaderBytecodeCache)},
     m_Properties
     {
         m_PhysicalDevice->GetExtProperties().RayTracingPipeline.shaderGroupHandleSize,
@@ -172,7 +178,7 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
 // clang-format on
 {
     static_assert(sizeof(VulkanDescriptorPoolSize) == sizeof(Uint32) * 11, "Please add new descriptors to m_DescriptorSetAllocator and m_DynamicDescriptorPool constructors");
-    static_assert(sizeof(DeviceObjectSizes) == sizeof(size_t) * 15, "Please add new objects to DeviceObjectSizes constructor");
+    static_assert(sizeof(DeviceObjectSizes) == sizeof(size_t) * 17, "Please add new objects to DeviceObjectSizes constructor");
 
     // set device properties
     {
@@ -249,7 +255,7 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
     Features.DurationQueries               = DEVICE_FEATURE_STATE_ENABLED;
 
 #if defined(_MSC_VER) && defined(_WIN64)
-    static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here (if necessary).");
+    static_assert(sizeof(DeviceFeatures) == 33, "Did you add a new feature to DeviceFeatures? Please handle its satus here (if necessary).");
 #endif
 
     const auto& vkDeviceLimits    = m_PhysicalDevice->GetProperties().limits;
@@ -288,6 +294,9 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
     // Wait for the GPU to complete all its operations
     IdleGPU();
 
+    if (m_pShaderBytecodeCache)
+        m_pShaderBytecodeCache->Flush();
+
     ReleaseStaleResources(true);
 
     DEV_CHECK_ERR(m_DescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated descriptor sets must have been released now.");
@@ -572,9 +581,15 @@ void RenderDeviceVkImpl::CreatePipelineState(const PSOCreateInfoType& PSOCreateI
         "Pipeline State", PSOCreateInfo.PSODesc, ppPipelineState,
         [&]() //
         {
+            PipelineStateRegistryKey RegistryKey;
+            if (FindSharedPipelineState<ShaderVkImpl>(PSOCreateInfo, RegistryKey, ppPipelineState))
+                return;
+
             PipelineStateVkImpl* pPipelineStateVk(NEW_RC_OBJ(m_PSOAllocator, "PipelineStateVkImpl instance", PipelineStateVkImpl)(this, PSOCreateInfo));
             pPipelineStateVk->QueryInterface(IID_PipelineState, reinterpret_cast<IObject**>(ppPipelineState));
             OnCreateDeviceObject(pPipelineStateVk);
+            pPipelineStateVk->StartDeferredInitialization();
+            AddSharedPipelineState(RegistryKey, *ppPipelineState);
         } //
     );
 }
@@ -827,4 +842,28 @@ void RenderDeviceVkImpl::CreateSBT(const ShaderBindingTableDesc& Desc,
                        });
 }
 
+void RenderDeviceVkImpl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                  IPipelineStateCache**               ppPSOCache)
+{
+    CreateDeviceObject("PipelineStateCache", CreateInfo.Desc, ppPSOCache,
+                       [&]() //
+                       {
+                           PipelineStateCacheVkImpl* pPSOCacheVk(NEW_RC_OBJ(m_PSOCacheAllocator, "PipelineStateCacheVkImpl instance", PipelineStateCacheVkImpl)(this, CreateInfo));
+                           pPSOCacheVk->QueryInterface(IID_PipelineStateCache, reinterpret_cast<IObject**>(ppPSOCache));
+                           OnCreateDeviceObject(pPSOCacheVk);
+                       });
+}
+
+void RenderDeviceVkImpl::CreateBindlessResourceTable(const BindlessResourceTableDesc& Desc,
+                                                     IBindlessResourceTable**         ppBindlessTable)
+{
+    CreateDeviceObject("BindlessResourceTable", Desc, ppBindlessTable,
+                       [&]() //
+                       {
+                           BindlessResourceTableVkImpl* pTableVk(NEW_RC_OBJ(m_BindlessTableAllocator, "BindlessResourceTableVkImpl instance", BindlessResourceTableVkImpl)(this, Desc));
+                           pTableVk->QueryInterface(IID_BindlessResourceTable, reinterpret_cast<IObject**>(ppBindlessTable));
+                           OnCreateDeviceObject(pTableVk);
+                       });
+}
+
 } // namespace Diligent
@@ -171,6 +171,26 @@ IShaderResourceVariable* ShaderResourceBindingVkImpl::GetVariableByIndex(SHADER_
     return m_pShaderVarMgrs[ResLayoutInd].GetVariable(Index);
 }
 
+Uint32 ShaderResourceBindingVkImpl::GetVariableHandle(SHADER_TYPE ShaderType, const char* Name)
+{
+    auto ResLayoutInd = GetVariableByNameHelper(ShaderType, Name, m_ResourceLayoutIndex);
+    if (ResLayoutInd < 0)
+        return INVALID_SHADER_VARIABLE_HANDLE;
+
+    VERIFY_EXPR(static_cast<Uint32>(ResLayoutInd) < Uint32{m_NumShaders});
+    auto* pVar = m_pShaderVarMgrs[ResLayoutInd].GetVariable(Name);
+    return pVar != nullptr ? PackVariableHandle(ResLayoutInd, pVar->GetIndex()) : INVALID_SHADER_VARIABLE_HANDLE;
+}
+
+void ShaderResourceBindingVkImpl::SetVariables(const Uint32* pHandles, IDeviceObject* const* ppObjects, Uint32 NumVariables)
+{
+    SetVariablesHelper(pHandles, ppObjects, NumVariables, m_NumShaders,
+                       [this](Uint32 ResLayoutInd, Uint32 VarIndex, IDeviceObject* pObject) //
+                       {
+                           m_pShaderVarMgrs[ResLayoutInd].BindVariable(VarIndex, pObject);
+                       });
+}
+
 void ShaderResourceBindingVkImpl::InitializeStaticResources(const IPipelineState* pPipelineState)
 {
     if (StaticResourcesInitialized())
@@ -195,4 +215,32 @@ void ShaderResourceBindingVkImpl::InitializeStaticResources(const IPipelineState
     m_bStaticResourcesInitialized = true;
 }
 
+void ShaderResourceBindingVkImpl::Clone(IShaderResourceBinding** ppClone)
+{
+    DEV_CHECK_ERR(ppClone != nullptr, "Pointer to the clone must not be null");
+
+    RefCntAutoPtr<IShaderResourceBinding> pClone;
+    m_pPSO->CreateShaderResourceBinding(&pClone, false);
+    if (!pClone)
+        return;
+
+    auto* pCloneVk = pClone.RawPtr<ShaderResourceBindingVkImpl>();
+    // Resource objects are copied from the cache, and descriptors - directly between
+    // the Vulkan descriptor sets, so that no resource views need to be resolved.
+    pCloneVk->m_ShaderResourceCache.CopyResources(m_ShaderResourceCache);
+    for (Uint32 s = 0; s < m_NumShaders; ++s)
+        m_pPSO->GetShaderResLayout(s).CopyDescriptors(m_ShaderResourceCache, pCloneVk->m_ShaderResourceCache);
+    pCloneVk->m_bStaticResourcesInitialized = m_bStaticResourcesInitialized;
+
+    *ppClone = pClone.Detach();
+}
+
+void ShaderResourceBindingVkImpl::ResetResources()
+{
+    // Stale descriptors remain in the descriptor set, but all static and mutable
+    // resources must be bound again before the SRB can be committed.
+    m_ShaderResourceCache.ResetResources();
+    m_bStaticResourcesInitialized = false;
+}
+
 } // namespace Diligent
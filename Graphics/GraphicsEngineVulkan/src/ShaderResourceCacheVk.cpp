@@ -101,6 +101,30 @@ void ShaderResourceCacheVk::InitializeResources(Uint32 Set, Uint32 Offset, Uint3
     }
 }
 
+void ShaderResourceCacheVk::ResetResources()
+{
+    auto* pResources = GetFirstResourcePtr();
+    for (Uint32 res = 0; res < m_TotalResources; ++res)
+        pResources[res].pObject.Release();
+    m_NumDynamicBuffers = 0;
+    IncrementVersion();
+}
+
+void ShaderResourceCacheVk::CopyResources(const ShaderResourceCacheVk& SrcCache)
+{
+    VERIFY(m_NumSets == SrcCache.m_NumSets && m_TotalResources == SrcCache.m_TotalResources, "Inconsistent cache layouts");
+
+    auto*       pDstResources = GetFirstResourcePtr();
+    const auto* pSrcResources = SrcCache.GetFirstResourcePtr();
+    for (Uint32 res = 0; res < m_TotalResources; ++res)
+    {
+        VERIFY(pDstResources[res].Type == pSrcResources[res].Type, "Inconsistent resource types");
+        pDstResources[res].pObject = pSrcResources[res].pObject;
+    }
+    m_NumDynamicBuffers = SrcCache.m_NumDynamicBuffers;
+    IncrementVersion();
+}
+
 #ifdef DILIGENT_DEBUG
 void ShaderResourceCacheVk::DbgVerifyResourceInitialization() const
 {
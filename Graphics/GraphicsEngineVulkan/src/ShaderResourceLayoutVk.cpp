@@ -40,6 +40,7 @@
 #include "StringTools.hpp"
 #include "PipelineStateVkImpl.hpp"
 #include "TopLevelASVkImpl.hpp"
+#include "BindlessResourceTableVkImpl.hpp"
 
 namespace Diligent
 {
@@ -172,6 +173,10 @@ StringPool ShaderResourceLayoutVk::AllocateMemory(const std::vector<const Shader
         Resources.ProcessResources(
             [&](const SPIRVShaderResourceAttribs& ResAttribs, Uint32) //
             {
+                // Unbounded arrays are bound through the bindless resource table
+                if (ResAttribs.ArraySize == 0)
+                    return;
+
                 auto VarType = FindShaderVariableType(m_ShaderType, ResAttribs, ResourceLayoutDesc, CombinedSamplerSuffix);
                 if (IsAllowedType(VarType, AllowedTypeBits))
                 {
@@ -329,6 +334,9 @@ void ShaderResourceLayoutVk::InitializeStaticResourceLayout(const std::vector<co
         Resources.ProcessResources(
             [&](const SPIRVShaderResourceAttribs& Attribs, Uint32) //
             {
+                if (Attribs.ArraySize == 0)
+                    return;
+
                 auto VarType = FindShaderVariableType(m_ShaderType, Attribs, ResourceLayoutDesc, CombinedSamplerSuffix);
                 if (!IsAllowedType(VarType, AllowedTypeBits))
                     return;
@@ -551,6 +559,7 @@ void ShaderResourceLayoutVk::Initialize(IRenderDevice*                    pRende
                                         IMemoryAllocator&                 LayoutDataAllocator,
                                         const PipelineResourceLayoutDesc& ResourceLayoutDesc,
                                         class PipelineLayout&             PipelineLayout,
+                                        const char*                       PSOName,
                                         bool                              VerifyVariables,
                                         bool                              VerifyImmutableSamplers)
 {
@@ -584,6 +593,16 @@ void ShaderResourceLayoutVk::Initialize(IRenderDevice*                    pRende
     std::unordered_map<Uint32, std::pair<Uint32, Uint32>> dbgBindings_CacheOffsets;
 #endif
 
+    struct UnboundedArrayInfo
+    {
+        const SPIRVShaderResourceAttribs* pAttribs;
+        const SPIRVShaderResources*       pResources;
+        std::vector<uint32_t>*            pSPIRV;
+    };
+    // Unbounded arrays are assigned to the bindless resource table set that
+    // follows all other sets, so they are processed after all other resources.
+    std::vector<UnboundedArrayInfo> UnboundedArrays;
+
     auto AddResource = [&](const Uint32                      ShaderInd,
                            ShaderResourceLayoutVk&           ResLayout,
                            const SPIRVShaderResources&       Resources,
@@ -591,6 +610,12 @@ void ShaderResourceLayoutVk::Initialize(IRenderDevice*                    pRende
                            ResourceNameToIndex_t&            ResourceNameToIndex,
                            std::vector<uint32_t>&            SPIRV) //
     {
+        if (Attribs.ArraySize == 0)
+        {
+            UnboundedArrays.push_back({&Attribs, &Resources, &SPIRV});
+            return;
+        }
+
         const auto                          ShaderType = Resources.GetShaderType();
         const SHADER_RESOURCE_VARIABLE_TYPE VarType    = FindShaderVariableType(ShaderType, Attribs, ResourceLayoutDesc, Resources.GetCombinedSamplerSuffix());
         if (!IsAllowedType(VarType, AllowedTypeBits))
@@ -786,6 +811,39 @@ void ShaderResourceLayoutVk::Initialize(IRenderDevice*                    pRende
         }
     }
 
+    if (!UnboundedArrays.empty())
+    {
+        for (const auto& Arr : UnboundedArrays)
+        {
+            const auto& Attribs = *Arr.pAttribs;
+            // clang-format off
+            if (Attribs.Type == SPIRVShaderResourceAttribs::ResourceType::SampledImage       ||
+                Attribs.Type == SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer ||
+                Attribs.Type == SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer)
+            // clang-format on
+            {
+                LOG_ERROR_AND_THROW("Unbounded array '", Attribs.Name, "' in shader '", Arr.pResources->GetShaderName(), "' of PSO '", PSOName,
+                                    "' is an array of combined image samplers or texel buffers. Only separate images, storage images, storage buffers "
+                                    "and separate samplers can be placed into the bindless resource table.");
+            }
+        }
+
+        const auto BindlessSet = PipelineLayout.AllocateBindlessSet();
+        for (auto& Arr : UnboundedArrays)
+        {
+            const auto& Attribs = *Arr.pAttribs;
+
+            const auto BindlessType =
+                GetUnboundedArrayBindlessType(PipelineLayout.GetBindlessTable(), SPIRVShaderResourceAttribs::GetShaderResourceType(Attribs.Type),
+                                              Attribs.Name, Arr.pResources->GetShaderName(), PSOName);
+
+            // Arrays of every type are bound to the table binding whose index is the bindless resource type
+            auto& SPIRV                                  = *Arr.pSPIRV;
+            SPIRV[Attribs.BindingDecorationOffset]       = BindlessType;
+            SPIRV[Attribs.DescriptorSetDecorationOffset] = BindlessSet;
+        }
+    }
+
 #ifdef DILIGENT_DEBUG
     for (size_t s = 0; s < ShaderStages.size(); ++s)
     {
@@ -1188,6 +1246,7 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject* pObj, Uint3
 
     auto& DstDescrSet = ResourceCache.GetDescriptorSet(DescriptorSet);
     auto  vkDescrSet  = DstDescrSet.GetVkDescriptorSet();
+    ResourceCache.IncrementVersion();
 #ifdef DILIGENT_DEBUG
     if (ResourceCache.DbgGetContentType() == ShaderResourceCacheVk::DbgCacheContentType::SRBResources)
     {
@@ -1343,6 +1402,68 @@ void ShaderResourceLayoutVk::InitializeStaticResources(const ShaderResourceLayou
     }
 }
 
+void ShaderResourceLayoutVk::CopyDescriptors(const ShaderResourceCacheVk& SrcResourceCache,
+                                             ShaderResourceCacheVk&       DstResourceCache) const
+{
+    // Dynamic resources are written to a new descriptor set at every draw call, so
+    // only descriptors of static and mutable resources need to be copied.
+    std::array<VkCopyDescriptorSet, 32> CopyDescrSetArr;
+
+    Uint32 NumCopies = 0;
+    for (auto VarType : {SHADER_RESOURCE_VARIABLE_TYPE_STATIC, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE})
+    {
+        for (Uint32 r = 0; r < m_NumResources[VarType]; ++r)
+        {
+            const auto& Res = GetResource(VarType, r);
+            if (Res.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler &&
+                Res.IsImmutableSamplerAssigned())
+                continue; // Immutable samplers are never copied
+
+            const auto& SrcSet     = SrcResourceCache.GetDescriptorSet(Res.DescriptorSet);
+            const auto  vkSrcSet   = SrcSet.GetVkDescriptorSet();
+            const auto  vkDstSet   = DstResourceCache.GetDescriptorSet(Res.DescriptorSet).GetVkDescriptorSet();
+            VERIFY(vkSrcSet != VK_NULL_HANDLE && vkDstSet != VK_NULL_HANDLE, "Static and mutable variables must have valid vulkan descriptor set assigned");
+            if (vkSrcSet == VK_NULL_HANDLE || vkDstSet == VK_NULL_HANDLE)
+                continue;
+
+            // Copy every continuous range of bound array elements with one VkCopyDescriptorSet
+            Uint32 ArrElem = 0;
+            while (ArrElem < Res.ArraySize)
+            {
+                while (ArrElem < Res.ArraySize && !SrcSet.GetResource(Res.CacheOffset + ArrElem).pObject)
+                    ++ArrElem;
+
+                const auto FirstElem = ArrElem;
+                while (ArrElem < Res.ArraySize && SrcSet.GetResource(Res.CacheOffset + ArrElem).pObject)
+                    ++ArrElem;
+
+                if (ArrElem == FirstElem)
+                    break;
+
+                auto& CopyDescrSet           = CopyDescrSetArr[NumCopies++];
+                CopyDescrSet.sType           = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
+                CopyDescrSet.pNext           = nullptr;
+                CopyDescrSet.srcSet          = vkSrcSet;
+                CopyDescrSet.srcBinding      = Res.Binding;
+                CopyDescrSet.srcArrayElement = FirstElem;
+                CopyDescrSet.dstSet          = vkDstSet;
+                CopyDescrSet.dstBinding      = Res.Binding;
+                CopyDescrSet.dstArrayElement = FirstElem;
+                CopyDescrSet.descriptorCount = ArrElem - FirstElem;
+
+                if (NumCopies == CopyDescrSetArr.size())
+                {
+                    m_LogicalDevice.UpdateDescriptorSets(0, nullptr, NumCopies, CopyDescrSetArr.data());
+                    NumCopies = 0;
+                }
+            }
+        }
+    }
+
+    if (NumCopies > 0)
+        m_LogicalDevice.UpdateDescriptorSets(0, nullptr, NumCopies, CopyDescrSetArr.data());
+}
+
 
 #ifdef DILIGENT_DEVELOPMENT
 bool ShaderResourceLayoutVk::dvpVerifyBindings(const ShaderResourceCacheVk& ResourceCache) const
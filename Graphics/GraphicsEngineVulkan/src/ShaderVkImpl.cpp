@@ -35,14 +35,211 @@
 #include "GLSLUtils.hpp"
 #include "DXCompiler.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "SPIRVReflection.hpp"
+#include "APIInfo.h"
+#include "Timer.hpp"
 
 #if !DILIGENT_NO_GLSLANG
 #    include "GLSLangUtils.hpp"
 #endif
 
+#if !DILIGENT_NO_HLSL
+#    include "spirv-tools/optimizer.hpp"
+#endif
+
 namespace Diligent
 {
 
+namespace
+{
+
+// Computes the shader cache key from everything that affects the generated SPIRV
+ShaderBytecodeCache::Key ComputeShaderCacheKey(const ShaderCreateInfo& ShaderCI,
+                                               const DeviceCaps&       Caps,
+                                               SHADER_COMPILER         ShaderCompiler,
+                                               const char*             ExtraDefinitions,
+                                               IDXCompiler*            pDXCompiler,
+                                               bool                    Spirv14,
+                                               bool                    Spirv15)
+{
+    ShaderBytecodeCache::KeyBuilder Builder;
+
+    Builder
+        .Update("SPIRV")
+        .UpdateValue(Uint32{DILIGENT_API_VERSION})
+        .UpdateValue(ShaderCompiler)
+        .UpdateValue(Spirv14)
+        .UpdateValue(Spirv15)
+        .UpdateValue(ShaderCI.Desc.ShaderType)
+        .UpdateValue(ShaderCI.SourceLanguage)
+        .UpdateValue(ShaderCI.HLSLVersion.Major)
+        .UpdateValue(ShaderCI.HLSLVersion.Minor)
+        .UpdateValue(ShaderCI.GLSLVersion.Major)
+        .UpdateValue(ShaderCI.GLSLVersion.Minor)
+        .UpdateValue(ShaderCI.UseCombinedTextureSamplers)
+        .UpdateValue(ShaderCI.SPIRVOptimizationFlags)
+        .Update(ShaderCI.CombinedSamplerSuffix)
+        .Update(ShaderCI.EntryPoint)
+        .Update(ExtraDefinitions);
+
+    // GLSL source string built by BuildGLSLSourceString() depends on the device caps and features
+    Builder
+        .UpdateValue(Caps.DevType)
+        .UpdateValue(Caps.MajorVersion)
+        .UpdateValue(Caps.MinorVersion)
+        .UpdateValue(Caps.TexCaps.Texture2DMSSupported)
+        .UpdateValue(Caps.TexCaps.Texture2DMSArraySupported)
+        .UpdateValue(Caps.TexCaps.CubemapArraysSupported);
+    static_assert(sizeof(DeviceFeatures) % sizeof(DEVICE_FEATURE_STATE) == 0, "DeviceFeatures is expected to only contain DEVICE_FEATURE_STATE members");
+    Builder.Update(&Caps.Features, sizeof(Caps.Features));
+
+    if (ShaderCompiler == SHADER_COMPILER_DXC && pDXCompiler != nullptr)
+    {
+        const auto MaxSM = pDXCompiler->GetMaxShaderModel();
+        Builder.UpdateValue(MaxSM.Major).UpdateValue(MaxSM.Minor);
+    }
+
+    if (ShaderCI.Macros != nullptr)
+    {
+        // The list is terminated by the null name. A null definition is hashed as an empty string
+        // so that it does not hide the macros that follow it.
+        for (const auto* pMacro = ShaderCI.Macros; pMacro->Name != nullptr; ++pMacro)
+            Builder.Update(pMacro->Name).Update(pMacro->Definition != nullptr ? pMacro->Definition : "");
+    }
+    Builder.Update(nullptr);
+
+    // Hash the source and all included files
+    ProcessShaderIncludes(ShaderCI,
+                          [&Builder](const char* FilePath, const char* Source, size_t SourceLength) //
+                          {
+                              Builder.Update(FilePath).UpdateValue(Uint64{SourceLength}).Update(Source, SourceLength);
+                          });
+
+    return Builder.Finalize();
+}
+
+#if !DILIGENT_NO_HLSL
+spv_target_env GetSPIRVTargetEnv(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+{
+    const auto& ExtFeats = LogicalDevice.GetEnabledExtFeatures();
+    if (ExtFeats.Spirv15)
+        return SPV_ENV_VULKAN_1_2;
+    else if (ExtFeats.Spirv14)
+        return SPV_ENV_VULKAN_1_1_SPIRV_1_4;
+    else
+        return SPV_ENV_VULKAN_1_0;
+}
+
+bool OptimizeSPIRV(spv_target_env Target, SPIRV_OPTIMIZATION_FLAGS Flags, std::vector<uint32_t>& SPIRV)
+{
+    spvtools::Optimizer SpirvOptimizer(Target);
+    if ((Flags & SPIRV_OPTIMIZATION_FLAG_PERFORMANCE) != 0)
+        SpirvOptimizer.RegisterPerformancePasses();
+    if ((Flags & SPIRV_OPTIMIZATION_FLAG_SIZE) != 0)
+        SpirvOptimizer.RegisterSizePasses();
+    if ((Flags & SPIRV_OPTIMIZATION_FLAG_DEAD_CODE) != 0)
+    {
+        SpirvOptimizer.RegisterPass(spvtools::CreateEliminateDeadFunctionsPass());
+        SpirvOptimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
+        SpirvOptimizer.RegisterPass(spvtools::CreateDeadVariableEliminationPass());
+        SpirvOptimizer.RegisterPass(spvtools::CreateEliminateDeadConstantPass());
+    }
+
+    std::vector<uint32_t> OptimizedSPIRV;
+    if (!SpirvOptimizer.Run(SPIRV.data(), SPIRV.size(), &OptimizedSPIRV))
+        return false;
+
+    SPIRV = std::move(OptimizedSPIRV);
+    return true;
+}
+
+// Strips debug information from the byte code. As resource names are removed along with
+// the rest of debug information, the resources are reflected from the original byte code,
+// and the names are restored in the reflection data of the stripped byte code.
+bool StripSPIRVDebugInfo(spv_target_env         Target,
+                         SHADER_TYPE            ShaderType,
+                         std::vector<uint32_t>& SPIRV,
+                         std::string&           EntryPoint,
+                         SPIRVReflectionData&   StrippedData)
+{
+    std::string         OriginalEntryPoint;
+    SPIRVReflectionData OriginalData;
+    if (!ScanSPIRVResources(SPIRV, ShaderType, OriginalEntryPoint, OriginalData))
+        return false;
+
+    spvtools::Optimizer SpirvOptimizer(Target);
+    SpirvOptimizer.RegisterPass(spvtools::CreateStripDebugInfoPass());
+    std::vector<uint32_t> StrippedSPIRV;
+    if (!SpirvOptimizer.Run(SPIRV.data(), SPIRV.size(), &StrippedSPIRV))
+        return false;
+
+    std::string StrippedEntryPoint;
+    if (!ScanSPIRVResources(StrippedSPIRV, ShaderType, StrippedEntryPoint, StrippedData) ||
+        StrippedEntryPoint != OriginalEntryPoint ||
+        !RestoreStrippedSPIRVNames(OriginalData, StrippedData))
+        return false;
+
+    SPIRV      = std::move(StrippedSPIRV);
+    EntryPoint = std::move(StrippedEntryPoint);
+    return true;
+}
+#endif
+
+// Applies the optimizations requested by ShaderCI.SPIRVOptimizationFlags to the byte code.
+// Returns true if debug information was stripped, in which case StrippedData contains the
+// resources of the stripped byte code that must be used instead of reflecting it.
+bool ApplySPIRVOptimizations(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                             const ShaderCreateInfo&                     ShaderCI,
+                             std::vector<uint32_t>&                      SPIRV,
+                             std::string&                                EntryPoint,
+                             SPIRVReflectionData&                        StrippedData)
+{
+    const auto Flags = ShaderCI.SPIRVOptimizationFlags;
+
+    SPIRVOptimizationStats Stats;
+    Stats.OriginalSize = static_cast<Uint32>(SPIRV.size() * sizeof(uint32_t));
+
+    bool IsStripped = false;
+#if DILIGENT_NO_HLSL
+    if (Flags != SPIRV_OPTIMIZATION_FLAG_NONE)
+        LOG_WARNING_MESSAGE("SPIRV optimizations requested for shader '", ShaderCI.Desc.Name, "' are ignored as the engine was built without SPIRV-Tools.");
+    (void)LogicalDevice;
+    (void)EntryPoint;
+    (void)StrippedData;
+#else
+    const auto Target = GetSPIRVTargetEnv(LogicalDevice);
+
+    Timer T;
+    if ((Flags & ~SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO) != 0)
+    {
+        const auto StartTime = T.GetElapsedTime();
+        if (!OptimizeSPIRV(Target, Flags, SPIRV))
+            LOG_ERROR_MESSAGE("Failed to optimize SPIRV byte code of shader '", ShaderCI.Desc.Name, "'. Unoptimized byte code will be used.");
+        Stats.OptimizationTimeMs = static_cast<Float32>((T.GetElapsedTime() - StartTime) * 1000.0);
+    }
+    Stats.OptimizedSize = static_cast<Uint32>(SPIRV.size() * sizeof(uint32_t));
+
+    if ((Flags & SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO) != 0)
+    {
+        const auto StartTime = T.GetElapsedTime();
+        IsStripped           = StripSPIRVDebugInfo(Target, ShaderCI.Desc.ShaderType, SPIRV, EntryPoint, StrippedData);
+        if (!IsStripped)
+            LOG_WARNING_MESSAGE("Failed to strip debug information from SPIRV byte code of shader '", ShaderCI.Desc.Name, "'. The information will be kept.");
+        Stats.StripTimeMs = static_cast<Float32>((T.GetElapsedTime() - StartTime) * 1000.0);
+    }
+#endif
+    if (Stats.OptimizedSize == 0)
+        Stats.OptimizedSize = Stats.OriginalSize;
+    Stats.FinalSize = static_cast<Uint32>(SPIRV.size() * sizeof(uint32_t));
+
+    if (ShaderCI.pSPIRVOptimizationStats != nullptr)
+        *ShaderCI.pSPIRVOptimizationStats = Stats;
+
+    return IsStripped;
+}
+
+} // namespace
+
 ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
                            RenderDeviceVkImpl*     pRenderDeviceVk,
                            const ShaderCreateInfo& ShaderCI) :
@@ -55,6 +252,14 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     }
 // clang-format on
 {
+    auto* CombinedSamplerSuffix = ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr;
+
+    // Shader cache is only used for shaders compiled from source
+    ShaderBytecodeCache*     pShaderCache = nullptr;
+    ShaderBytecodeCache::Key CacheKey;
+    std::vector<Uint8>       CachedResources;
+    bool                     IsCachedSPIRV = false;
+
     if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
     {
         DEV_CHECK_ERR(ShaderCI.ByteCode == nullptr, "'ByteCode' must be null when shader is created from source code or a file");
@@ -76,76 +281,96 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
             }
         }
 
-        switch (ShaderCompiler)
+        const auto& ExtFeats = pRenderDeviceVk->GetLogicalDevice().GetEnabledExtFeatures();
+
+        pShaderCache = pRenderDeviceVk->GetShaderBytecodeCache();
+        if (pShaderCache != nullptr)
         {
-            case SHADER_COMPILER_DXC:
+            CacheKey = ComputeShaderCacheKey(ShaderCI, pRenderDeviceVk->GetDeviceCaps(), ShaderCompiler, VulkanDefine, pRenderDeviceVk->GetDxCompiler(), ExtFeats.Spirv14, ExtFeats.Spirv15);
+            IsCachedSPIRV = pShaderCache->Load(CacheKey, m_SPIRV, &CachedResources);
+            // Resource names can't be reflected from the byte code without debug information,
+            // so stripped byte code is only usable together with the serialized resources.
+            if (IsCachedSPIRV && (ShaderCI.SPIRVOptimizationFlags & SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO) != 0)
+                IsCachedSPIRV = SPIRVShaderResources::IsValidSerializedData(CachedResources.data(), CachedResources.size(), m_SPIRV, m_Desc, CombinedSamplerSuffix);
+            if (!IsCachedSPIRV)
             {
-                auto* pDXComiler = pRenderDeviceVk->GetDxCompiler();
-                VERIFY_EXPR(pDXComiler != nullptr && pDXComiler->IsLoaded());
-                pDXComiler->Compile(ShaderCI, ShaderVersion{}, VulkanDefine, nullptr, &m_SPIRV, ShaderCI.ppCompilerOutput);
+                m_SPIRV.clear();
+                CachedResources.clear();
             }
-            break;
+        }
 
-            case SHADER_COMPILER_DEFAULT:
-            case SHADER_COMPILER_GLSLANG:
+        if (m_SPIRV.empty())
+        {
+            switch (ShaderCompiler)
             {
-#if DILIGENT_NO_GLSLANG
-                LOG_ERROR_AND_THROW("Diligent engine was not linked with glslang, use DXC or precompiled SPIRV bytecode.");
-#else
-                if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
+                case SHADER_COMPILER_DXC:
                 {
-                    m_SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, VulkanDefine, ShaderCI.ppCompilerOutput);
+                    auto* pDXComiler = pRenderDeviceVk->GetDxCompiler();
+                    VERIFY_EXPR(pDXComiler != nullptr && pDXComiler->IsLoaded());
+                    pDXComiler->Compile(ShaderCI, ShaderVersion{}, VulkanDefine, nullptr, &m_SPIRV, ShaderCI.ppCompilerOutput);
                 }
-                else
-                {
-                    std::string              GLSLSourceString;
-                    RefCntAutoPtr<IDataBlob> pSourceFileData;
+                break;
 
-                    const char*        ShaderSource = nullptr;
-                    size_t             SourceLength = 0;
-                    const ShaderMacro* Macros       = nullptr;
-                    if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM)
+                case SHADER_COMPILER_DEFAULT:
+                case SHADER_COMPILER_GLSLANG:
+                {
+#if DILIGENT_NO_GLSLANG
+                    LOG_ERROR_AND_THROW("Diligent engine was not linked with glslang, use DXC or precompiled SPIRV bytecode.");
+#else
+                    if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
                     {
-                        // Read the source file directly and use it as is
-                        ShaderSource = ReadShaderSourceFile(ShaderCI.Source, ShaderCI.pShaderSourceStreamFactory, ShaderCI.FilePath, pSourceFileData, SourceLength);
-
-                        // Add user macros.
-                        // BuildGLSLSourceString adds the macros to the source string, so we don't need to do this for SHADER_SOURCE_LANGUAGE_GLSL
-                        Macros = ShaderCI.Macros;
+                        m_SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, VulkanDefine, ShaderCI.ppCompilerOutput);
                     }
                     else
                     {
-                        // Build the full source code string that will contain GLSL version declaration,
-                        // platform definitions, user-provided shader macros, etc.
-                        GLSLSourceString = BuildGLSLSourceString(ShaderCI, pRenderDeviceVk->GetDeviceCaps(), TargetGLSLCompiler::glslang, VulkanDefine);
-                        ShaderSource     = GLSLSourceString.c_str();
-                        SourceLength     = GLSLSourceString.length();
-                    }
+                        std::string              GLSLSourceString;
+                        RefCntAutoPtr<IDataBlob> pSourceFileData;
 
-                    GLSLangUtils::SpirvVersion spvVersion = GLSLangUtils::SpirvVersion::Vk100;
-                    const auto&                ExtFeats   = GetDevice()->GetLogicalDevice().GetEnabledExtFeatures();
-                    if (ExtFeats.Spirv15)
-                        spvVersion = GLSLangUtils::SpirvVersion::Vk120;
-                    else if (ExtFeats.Spirv14)
-                        spvVersion = GLSLangUtils::SpirvVersion::Vk110_Spirv14;
-
-                    m_SPIRV = GLSLangUtils::GLSLtoSPIRV(m_Desc.ShaderType, ShaderSource,
-                                                        static_cast<int>(SourceLength), Macros,
-                                                        ShaderCI.pShaderSourceStreamFactory,
-                                                        spvVersion,
-                                                        ShaderCI.ppCompilerOutput);
-                }
+                        const char*        ShaderSource = nullptr;
+                        size_t             SourceLength = 0;
+                        const ShaderMacro* Macros       = nullptr;
+                        if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM)
+                        {
+                            // Read the source file directly and use it as is
+                            ShaderSource = ReadShaderSourceFile(ShaderCI.Source, ShaderCI.pShaderSourceStreamFactory, ShaderCI.FilePath, pSourceFileData, SourceLength);
+
+                            // Add user macros.
+                            // BuildGLSLSourceString adds the macros to the source string, so we don't need to do this for SHADER_SOURCE_LANGUAGE_GLSL
+                            Macros = ShaderCI.Macros;
+                        }
+                        else
+                        {
+                            // Build the full source code string that will contain GLSL version declaration,
+                            // platform definitions, user-provided shader macros, etc.
+                            GLSLSourceString = BuildGLSLSourceString(ShaderCI, pRenderDeviceVk->GetDeviceCaps(), TargetGLSLCompiler::glslang, VulkanDefine);
+                            ShaderSource     = GLSLSourceString.c_str();
+                            SourceLength     = GLSLSourceString.length();
+                        }
+
+                        GLSLangUtils::SpirvVersion spvVersion = GLSLangUtils::SpirvVersion::Vk100;
+                        if (ExtFeats.Spirv15)
+                            spvVersion = GLSLangUtils::SpirvVersion::Vk120;
+                        else if (ExtFeats.Spirv14)
+                            spvVersion = GLSLangUtils::SpirvVersion::Vk110_Spirv14;
+
+                        m_SPIRV = GLSLangUtils::GLSLtoSPIRV(m_Desc.ShaderType, ShaderSource,
+                                                            static_cast<int>(SourceLength), Macros,
+                                                            ShaderCI.pShaderSourceStreamFactory,
+                                                            spvVersion,
+                                                            ShaderCI.ppCompilerOutput);
+                    }
 #endif
-                break;
-            }
+                    break;
+                }
 
-            default:
-                LOG_ERROR_AND_THROW("Unsupported shader compiler");
-        }
+                default:
+                    LOG_ERROR_AND_THROW("Unsupported shader compiler");
+            }
 
-        if (m_SPIRV.empty())
-        {
-            LOG_ERROR_AND_THROW("Failed to compile shader '", ShaderCI.Desc.Name, '\'');
+            if (m_SPIRV.empty())
+            {
+                LOG_ERROR_AND_THROW("Failed to compile shader '", ShaderCI.Desc.Name, '\'');
+            }
         }
     }
     else if (ShaderCI.ByteCode != nullptr)
@@ -160,6 +385,22 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
         LOG_ERROR_AND_THROW("Shader source must be provided through one of the 'Source', 'FilePath' or 'ByteCode' members");
     }
 
+    // Cached byte code has already been optimized
+    SPIRVReflectionData StrippedResources;
+    bool                UseStrippedResources = false;
+    if (!IsCachedSPIRV)
+    {
+        UseStrippedResources = ApplySPIRVOptimizations(pRenderDeviceVk->GetLogicalDevice(), ShaderCI, m_SPIRV, m_EntryPoint, StrippedResources);
+    }
+    else if (ShaderCI.pSPIRVOptimizationStats != nullptr)
+    {
+        auto& Stats         = *ShaderCI.pSPIRVOptimizationStats;
+        Stats               = SPIRVOptimizationStats{};
+        Stats.OriginalSize  = static_cast<Uint32>(m_SPIRV.size() * sizeof(uint32_t));
+        Stats.OptimizedSize = Stats.OriginalSize;
+        Stats.FinalSize     = Stats.OriginalSize;
+    }
+
     // We cannot create shader module here because resource bindings are assigned when
     // pipeline state is created
 
@@ -167,18 +408,61 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     auto& Allocator        = GetRawAllocator();
     auto* pRawMem          = ALLOCATE(Allocator, "Allocator for ShaderResources", SPIRVShaderResources, 1);
     auto  LoadShaderInputs = m_Desc.ShaderType == SHADER_TYPE_VERTEX;
-    auto* pResources       = new (pRawMem) SPIRVShaderResources //
-        {
-            Allocator,
-            pRenderDeviceVk,
-            m_SPIRV,
-            m_Desc,
-            ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr,
-            LoadShaderInputs,
-            m_EntryPoint //
-        };
+
+    // Resources serialized alongside the cached SPIRV are loaded without reflecting the byte code
+    const auto UseCachedResources =
+        !CachedResources.empty() &&
+        SPIRVShaderResources::IsValidSerializedData(CachedResources.data(), CachedResources.size(), m_SPIRV, m_Desc, CombinedSamplerSuffix);
+
+    SPIRVShaderResources* pResources = nullptr;
+    if (UseCachedResources)
+    {
+        pResources = new (pRawMem) SPIRVShaderResources //
+            {
+                Allocator,
+                CachedResources.data(),
+                CachedResources.size(),
+                m_Desc,
+                LoadShaderInputs,
+                m_EntryPoint //
+            };
+    }
+    else if (UseStrippedResources)
+    {
+        pResources = new (pRawMem) SPIRVShaderResources //
+            {
+                Allocator,
+                StrippedResources,
+                m_Desc,
+                CombinedSamplerSuffix,
+                LoadShaderInputs //
+            };
+    }
+    else
+    {
+        pResources = new (pRawMem) SPIRVShaderResources //
+            {
+                Allocator,
+                pRenderDeviceVk,
+                m_SPIRV,
+                m_Desc,
+                CombinedSamplerSuffix,
+                LoadShaderInputs,
+                m_EntryPoint //
+            };
+    }
     m_pShaderResources.reset(pResources, STDDeleterRawMem<SPIRVShaderResources>(Allocator));
 
+    InitBytecodeId(m_SPIRV.data(), m_SPIRV.size() * sizeof(m_SPIRV[0]), ShaderCI);
+
+    if (pShaderCache != nullptr && !UseCachedResources)
+    {
+        // Store the newly compiled byte code or add the resources to the existing entry
+        std::vector<Uint8> SerializedResources;
+        m_pShaderResources->Serialize(m_SPIRV, m_EntryPoint, SerializedResources);
+        pShaderCache->Store(CacheKey, m_SPIRV, SerializedResources.data(), SerializedResources.size());
+    }
+
     if (LoadShaderInputs && m_pShaderResources->IsHLSLSource())
     {
         MapHLSLVertexShaderInputs();
@@ -372,6 +372,11 @@ void SetPipelineLayoutName(VkDevice device, VkPipelineLayout pipelineLayout, con
     SetObjectName(device, (uint64_t)pipelineLayout, VK_OBJECT_TYPE_PIPELINE_LAYOUT, name);
 }
 
+void SetPipelineCacheName(VkDevice device, VkPipelineCache pipelineCache, const char* name)
+{
+    SetObjectName(device, (uint64_t)pipelineCache, VK_OBJECT_TYPE_PIPELINE_CACHE, name);
+}
+
 void SetRenderPassName(VkDevice device, VkRenderPass renderPass, const char* name)
 {
     SetObjectName(device, (uint64_t)renderPass, VK_OBJECT_TYPE_RENDER_PASS, name);
@@ -555,6 +560,12 @@ void SetVulkanObjectName<VkAccelerationStructureKHR, VulkanHandleTypeId::Acceler
     SetAccelStructName(device, accelStruct, name);
 }
 
+template <>
+void SetVulkanObjectName<VkPipelineCache, VulkanHandleTypeId::PipelineCache>(VkDevice device, VkPipelineCache pipelineCache, const char* name)
+{
+    SetPipelineCacheName(device, pipelineCache, name);
+}
+
 
 const char* VkResultToString(VkResult errorCode)
 {
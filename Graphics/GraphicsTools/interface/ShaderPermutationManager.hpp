@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a ShaderPermutationManager class
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Creates shader permutations and shares shader objects between equivalent permutations.
+
+/// Material systems typically generate many permutations of the same shader that differ
+/// only in macros the source never references. The manager canonicalizes the macro set
+/// of every request: macros that are not referenced by the shader source, its include files
+/// or definitions of other referenced macros are removed, and the remaining macros are sorted
+/// by name. Requests that result in the same canonical permutation share one shader object,
+/// so that every unique permutation is compiled only once.
+///
+/// \note   The manager assumes that shader sources are not modified while it is in use.
+///         Call Clear() after the sources have changed.
+class ShaderPermutationManager
+{
+public:
+    /// Permutation manager statistics
+    struct Statistics
+    {
+        /// The number of shaders requested through CreateShader()
+        Uint32 NumRequested = 0;
+
+        /// The number of unique canonical permutations
+        Uint32 NumUnique = 0;
+
+        /// The number of shaders compiled by the render device
+        Uint32 NumCompiled = 0;
+
+        /// The total number of macros that were removed from the requests
+        /// because they are not referenced by the shader source
+        Uint32 NumIgnoredMacros = 0;
+    };
+
+    ShaderPermutationManager() = default;
+
+    // clang-format off
+    ShaderPermutationManager           (const ShaderPermutationManager&)  = delete;
+    ShaderPermutationManager& operator=(const ShaderPermutationManager&)  = delete;
+    ShaderPermutationManager           (      ShaderPermutationManager&&) = delete;
+    ShaderPermutationManager& operator=(      ShaderPermutationManager&&) = delete;
+    // clang-format on
+
+
+    /// Creates a new shader or returns an existing one that is equivalent to the requested permutation.
+
+    /// \param[in]  pDevice  - Render device that is used to compile new permutations. All shaders
+    ///                        of the manager must be created by the same device.
+    /// \param[in]  ShaderCI - Shader create info.
+    /// \param[out] ppShader - Address of the memory location where the pointer to the shader
+    ///                        will be written.
+    ///
+    /// \remarks    When an existing shader is returned, ShaderCI.Desc.Name is ignored, and
+    ///             ShaderCI.ppCompilerOutput and ShaderCI.pSPIRVOptimizationStats are not written.
+    ///             Shaders that failed to compile are not cached.
+    ///
+    ///             The method is thread-safe. If several threads request the same new permutation
+    ///             at the same time, it may be compiled more than once, but all threads will receive
+    ///             the same shader object.
+    void CreateShader(IRenderDevice* pDevice, const ShaderCreateInfo& ShaderCI, IShader** ppShader);
+
+    /// Returns the manager statistics
+    Statistics GetStatistics() const;
+
+    /// Releases all shaders and cached source information
+    void Clear();
+
+private:
+    struct SourceInfo
+    {
+        // Unique index of the source that is used in permutation keys
+        Uint32 Id = 0;
+
+        // Identifiers found in the source and all its include files
+        std::unordered_set<std::string> Identifiers;
+
+        // If the source uses token pasting, macro references cannot be determined,
+        // and all macros are considered to be used
+        bool UsesTokenPasting = false;
+
+        // Keeps the factory alive so that its address uniquely identifies it in the source key
+        RefCntAutoPtr<IShaderSourceInputStreamFactory> pSourceFactory;
+    };
+
+    // Must be called with m_Mtx locked
+    std::string GetPermutationKey(const ShaderCreateInfo& ShaderCI, const SourceInfo& Source);
+
+    mutable std::mutex m_Mtx;
+
+    std::unordered_map<std::string, SourceInfo>             m_Sources;
+    std::unordered_map<std::string, RefCntAutoPtr<IShader>> m_Shaders;
+
+    Uint32     m_NextSourceId = 0;
+    Statistics m_Stats;
+};
+
+} // namespace Diligent
@@ -0,0 +1,332 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderPermutationManager.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "ShaderToolsCommon.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+inline bool IsIdentifierStart(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+inline bool IsIdentifierChar(char c)
+{
+    return IsIdentifierStart(c) || (c >= '0' && c <= '9');
+}
+
+// Adds all identifiers found in the source to the set. Comments and string literals are skipped.
+// UsesTokenPasting is set to true if the source contains the token-pasting operator.
+void FindIdentifiers(const char* Source, size_t Length, std::unordered_set<std::string>& Identifiers, bool& UsesTokenPasting)
+{
+    const auto* const End = Source + Length;
+
+    const auto* c = Source;
+    while (c < End)
+    {
+        if (c[0] == '/' && c + 1 < End && c[1] == '/')
+        {
+            while (c < End && *c != '\n')
+                ++c;
+        }
+        else if (c[0] == '/' && c + 1 < End && c[1] == '*')
+        {
+            c += 2;
+            while (c + 1 < End && !(c[0] == '*' && c[1] == '/'))
+                ++c;
+            c = c + 1 < End ? c + 2 : End;
+        }
+        else if (c[0] == '"')
+        {
+            ++c;
+            while (c < End && *c != '"' && *c != '\n')
+            {
+                if (*c == '\\' && c + 1 < End)
+                    ++c;
+                ++c;
+            }
+            if (c < End)
+                ++c;
+        }
+        else if (IsIdentifierStart(*c))
+        {
+            const auto* IdentifierStart = c;
+            while (c < End && IsIdentifierChar(*c))
+                ++c;
+            Identifiers.emplace(IdentifierStart, c);
+        }
+        else if (*c >= '0' && *c <= '9')
+        {
+            // Skip numeric literals together with their suffixes, e.g. 1.5f or 0x10u
+            while (c < End && (IsIdentifierChar(*c) || *c == '.'))
+                ++c;
+        }
+        else if (c[0] == '#' && c + 1 < End && c[1] == '#')
+        {
+            UsesTokenPasting = true;
+            c += 2;
+        }
+        else
+        {
+            ++c;
+        }
+    }
+}
+
+// Returns the identifier of the macro name, e.g. "SAMPLE" for "SAMPLE(Tex, UV)"
+std::string GetMacroIdentifier(const char* Name)
+{
+    const auto* End = Name;
+    while (IsIdentifierChar(*End))
+        ++End;
+    return std::string{Name, End};
+}
+
+template <typename T>
+void AppendValue(std::string& Key, const T& Value)
+{
+    Key.append(reinterpret_cast<const char*>(&Value), sizeof(Value));
+}
+
+void AppendString(std::string& Key, const char* Str)
+{
+    if (Str != nullptr)
+        Key.append(Str);
+    Key.push_back('\0');
+}
+
+std::string GetSourceKey(const ShaderCreateInfo& ShaderCI)
+{
+    std::string Key;
+    if (ShaderCI.ByteCode != nullptr)
+    {
+        Key.push_back('B');
+        Key.append(static_cast<const char*>(ShaderCI.ByteCode), ShaderCI.ByteCodeSize);
+    }
+    else
+    {
+        // Include files are resolved by the factory, so it is a part of the key
+        Key.push_back(ShaderCI.Source != nullptr ? 'S' : 'F');
+        AppendValue(Key, ShaderCI.pShaderSourceStreamFactory);
+        AppendString(Key, ShaderCI.Source != nullptr ? ShaderCI.Source : ShaderCI.FilePath);
+    }
+    return Key;
+}
+
+} // namespace
+
+std::string ShaderPermutationManager::GetPermutationKey(const ShaderCreateInfo& ShaderCI, const SourceInfo& Source)
+{
+    std::string Key;
+    AppendValue(Key, Source.Id);
+    AppendValue(Key, ShaderCI.Desc.ShaderType);
+    AppendValue(Key, ShaderCI.SourceLanguage);
+    AppendValue(Key, ShaderCI.ShaderCompiler);
+    AppendValue(Key, ShaderCI.HLSLVersion.Major);
+    AppendValue(Key, ShaderCI.HLSLVersion.Minor);
+    AppendValue(Key, ShaderCI.GLSLVersion.Major);
+    AppendValue(Key, ShaderCI.GLSLVersion.Minor);
+    AppendValue(Key, ShaderCI.GLESSLVersion.Major);
+    AppendValue(Key, ShaderCI.GLESSLVersion.Minor);
+    AppendValue(Key, ShaderCI.SPIRVOptimizationFlags);
+    AppendValue(Key, ShaderCI.UseCombinedTextureSamplers);
+    AppendString(Key, ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr);
+    AppendString(Key, ShaderCI.EntryPoint);
+
+    // Macros have no effect on the byte code
+    if (ShaderCI.Macros == nullptr || ShaderCI.ByteCode != nullptr)
+        return Key;
+
+    std::vector<const ShaderMacro*> Macros;
+    std::vector<std::string>        MacroIdentifiers;
+    for (const auto* pMacro = ShaderCI.Macros; pMacro->Name != nullptr && pMacro->Definition != nullptr; ++pMacro)
+    {
+        Macros.push_back(pMacro);
+        MacroIdentifiers.emplace_back(GetMacroIdentifier(pMacro->Name));
+    }
+
+    // A macro is used if it is referenced by the source or, recursively, by the definition
+    // of another used macro.
+    std::vector<bool>   IsUsed(Macros.size(), Source.UsesTokenPasting);
+    std::vector<size_t> PendingMacros;
+    for (size_t i = 0; i < Macros.size(); ++i)
+    {
+        if (!IsUsed[i] && Source.Identifiers.find(MacroIdentifiers[i]) != Source.Identifiers.end())
+        {
+            IsUsed[i] = true;
+            PendingMacros.push_back(i);
+        }
+    }
+    while (!PendingMacros.empty())
+    {
+        const auto* pMacro = Macros[PendingMacros.back()];
+        PendingMacros.pop_back();
+
+        std::unordered_set<std::string> Identifiers;
+        bool                            UsesTokenPasting = false;
+        FindIdentifiers(pMacro->Definition, strlen(pMacro->Definition), Identifiers, UsesTokenPasting);
+        for (size_t i = 0; i < Macros.size(); ++i)
+        {
+            if (!IsUsed[i] && (UsesTokenPasting || Identifiers.find(MacroIdentifiers[i]) != Identifiers.end()))
+            {
+                IsUsed[i] = true;
+                PendingMacros.push_back(i);
+            }
+        }
+    }
+
+    std::vector<const ShaderMacro*> UsedMacros;
+    for (size_t i = 0; i < Macros.size(); ++i)
+    {
+        if (IsUsed[i])
+            UsedMacros.push_back(Macros[i]);
+        else
+            ++m_Stats.NumIgnoredMacros;
+    }
+
+    // Stable sort keeps the order of redefinitions of the same macro
+    std::stable_sort(UsedMacros.begin(), UsedMacros.end(),
+                     [](const ShaderMacro* pMacro1, const ShaderMacro* pMacro2) {
+                         return strcmp(pMacro1->Name, pMacro2->Name) < 0;
+                     });
+    for (const auto* pMacro : UsedMacros)
+    {
+        AppendString(Key, pMacro->Name);
+        AppendString(Key, pMacro->Definition);
+    }
+
+    return Key;
+}
+
+void ShaderPermutationManager::CreateShader(IRenderDevice* pDevice, const ShaderCreateInfo& ShaderCI, IShader** ppShader)
+{
+    DEV_CHECK_ERR(pDevice != nullptr, "Render device must not be null");
+    DEV_CHECK_ERR(ppShader != nullptr && *ppShader == nullptr, "ppShader must not be null and must point to null");
+
+    const auto SourceKey = GetSourceKey(ShaderCI);
+
+    std::string PermutationKey;
+    {
+        std::lock_guard<std::mutex> Guard{m_Mtx};
+        ++m_Stats.NumRequested;
+
+        auto SourceIt = m_Sources.find(SourceKey);
+        if (SourceIt != m_Sources.end())
+            PermutationKey = GetPermutationKey(ShaderCI, SourceIt->second);
+    }
+
+    if (PermutationKey.empty())
+    {
+        // Scan the source outside of the lock as reading the files may take time
+        SourceInfo Source;
+        Source.pSourceFactory = ShaderCI.pShaderSourceStreamFactory;
+        if (ShaderCI.ByteCode == nullptr)
+        {
+            try
+            {
+                ProcessShaderIncludes(ShaderCI,
+                                      [&Source](const char*, const char* SourceCode, size_t SourceLength) //
+                                      {
+                                          FindIdentifiers(SourceCode, SourceLength, Source.Identifiers, Source.UsesTokenPasting);
+                                      });
+            }
+            catch (...)
+            {
+                // The source can't be read. Let the device create the shader and report the error.
+                pDevice->CreateShader(ShaderCI, ppShader);
+
+                std::lock_guard<std::mutex> Guard{m_Mtx};
+                ++m_Stats.NumCompiled;
+                return;
+            }
+        }
+
+        std::lock_guard<std::mutex> Guard{m_Mtx};
+
+        auto Inserted = m_Sources.emplace(SourceKey, std::move(Source));
+        if (Inserted.second)
+            Inserted.first->second.Id = m_NextSourceId++;
+        PermutationKey = GetPermutationKey(ShaderCI, Inserted.first->second);
+    }
+
+    {
+        std::lock_guard<std::mutex> Guard{m_Mtx};
+
+        auto ShaderIt = m_Shaders.find(PermutationKey);
+        if (ShaderIt != m_Shaders.end())
+        {
+            *ppShader = ShaderIt->second;
+            (*ppShader)->AddRef();
+            return;
+        }
+    }
+
+    RefCntAutoPtr<IShader> pShader;
+    pDevice->CreateShader(ShaderCI, &pShader);
+
+    std::lock_guard<std::mutex> Guard{m_Mtx};
+    ++m_Stats.NumCompiled;
+    if (pShader)
+    {
+        // Another thread may have created the same permutation in the meantime
+        auto Inserted = m_Shaders.emplace(std::move(PermutationKey), pShader);
+        if (Inserted.second)
+            ++m_Stats.NumUnique;
+        else
+            pShader = Inserted.first->second;
+    }
+    *ppShader = pShader.Detach();
+}
+
+ShaderPermutationManager::Statistics ShaderPermutationManager::GetStatistics() const
+{
+    std::lock_guard<std::mutex> Guard{m_Mtx};
+    return m_Stats;
+}
+
+void ShaderPermutationManager::Clear()
+{
+    std::lock_guard<std::mutex> Guard{m_Mtx};
+    m_Shaders.clear();
+    m_Sources.clear();
+    // Source ids are not reset, so that keys computed by concurrent
+    // requests can never refer to a different source
+    m_Stats = {};
+}
+
+} // namespace Diligent
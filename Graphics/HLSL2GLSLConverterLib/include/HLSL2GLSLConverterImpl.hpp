@@ -32,6 +32,8 @@
 #include <unordered_map>
 #include <vector>
 #include <array>
+#include <memory>
+#include <mutex>
 
 #include "HLSL2GLSLConverter.h"
 #include "ObjectBase.hpp"
@@ -40,6 +42,12 @@
 #include "HashUtils.hpp"
 #include "HLSLKeywords.h"
 #include "Constants.h"
+#include "DataBlob.h"
+#include "RefCntAutoPtr.hpp"
+#include "StringPool.hpp"
+#include "TokenString.hpp"
+#include "TokenListAllocator.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -163,6 +171,13 @@ public:
                       size_t                           NumSymbols,
                       IHLSL2GLSLConversionStream**     ppStream) const;
 
+    /// Releases all cached shader sources, include files and converted shaders.
+
+    /// The cache is keyed on the shader source with all includes expanded, and include
+    /// files are only reused while their content is unchanged, so modified shader files
+    /// never hit stale entries and the cache never needs to be cleared for correctness.
+    void ClearCache() const;
+
 private:
     HLSL2GLSLConverterImpl();
 
@@ -243,9 +258,9 @@ private:
 
     struct TokenInfo
     {
-        TokenType Type;
-        String    Literal;
-        String    Delimiter;
+        TokenType   Type;
+        TokenString Literal;
+        TokenString Delimiter;
 
         bool IsBuiltInType() const
         {
@@ -262,14 +277,155 @@ private:
         }
 
         TokenInfo(TokenType   _Type      = TokenType::Undefined,
-                  const Char* _Literal   = "",
-                  const Char* _Delimiter = "") :
+                  TokenString _Literal   = {},
+                  TokenString _Delimiter = {}) :
             Type{_Type},
-            Literal{_Literal},
-            Delimiter{_Delimiter}
+            Literal{std::move(_Literal)},
+            Delimiter{std::move(_Delimiter)}
+        {}
+    };
+    typedef std::list<TokenInfo, TokenListAllocator<TokenInfo>> TokenListType;
+
+    // Tokenized shader source. The object is shared by all streams that convert
+    // the same source: every conversion works on its own copy of the token list
+    // that references the text in the shared pool.
+    struct TokenizedSource
+    {
+        TokenizedSource(const HLSL2GLSLConverterImpl& Converter, const String& Source);
+
+        // Creates an empty object, see Join()
+        TokenizedSource();
+
+        // clang-format off
+        TokenizedSource           (const TokenizedSource&) = delete;
+        TokenizedSource           (TokenizedSource&&)      = delete;
+        TokenizedSource& operator=(const TokenizedSource&) = delete;
+        TokenizedSource& operator=(TokenizedSource&&)      = delete;
+        // clang-format on
+
+        // Text of all tokens produced by the tokenizer. Tokens reference
+        // this memory and only allocate their own when they are modified.
+        StringPool TextPool;
+
+        // Pool for the token list nodes
+        TokenNodePool NodePool;
+
+        TokenListType Tokens;
+
+        // Delimiters and comments that follow the last token
+        String TrailingDelimiter;
+
+        // Sources whose text the tokens of the joined source reference
+        std::vector<std::shared_ptr<const TokenizedSource>> JoinedSources;
+
+        // Returns the position of the delimiters that follow the last token
+        static size_t Tokenize(const HLSL2GLSLConverterImpl& Converter,
+                               const String&                 Source,
+                               StringPool&                   TextPool,
+                               TokenListType&                Tokens);
+
+        // Joins the tokens of consecutive parts of the source without copying their text.
+        // Returns null if a token may span the boundary between the parts, in which case
+        // the whole source must be tokenized.
+        static std::shared_ptr<const TokenizedSource> Join(std::vector<std::shared_ptr<const TokenizedSource>> Sources);
+    };
+
+    // Shader source file split into chunks by #include directives:
+    //
+    //   Chunks[0] #include "Includes[0]" Chunks[1] ... #include "Includes[N-1]" Chunks[N]
+    //
+    struct SourceFile
+    {
+        SourceFile(String&& _Text, size_t _Hash);
+
+        const String Text;
+        const size_t Hash;
+
+        std::vector<String> Chunks;
+        std::vector<String> Includes;
+
+        // Tokens of every chunk, created when the chunk is tokenized for the first time.
+        // Protected by the converter cache mutex.
+        mutable std::vector<std::shared_ptr<const TokenizedSource>> ChunkTokens;
+    };
+
+    // Chunk of the source file that is a part of the expanded shader source
+    struct SourceChunk
+    {
+        std::shared_ptr<const SourceFile> pFile;
+        size_t                            Index;
+    };
+
+    // Conversion parameters that, together with the source, define the resulting GLSL
+    struct ConvertedShaderKey
+    {
+        String      EntryPoint;
+        SHADER_TYPE ShaderType;
+        String      SamplerSuffix;
+        bool        IncludeDefinitions;
+        bool        UseInOutLocationQualifiers;
+
+        bool operator==(const ConvertedShaderKey& rhs) const
+        {
+            // clang-format off
+            return ShaderType                 == rhs.ShaderType                 &&
+                   IncludeDefinitions         == rhs.IncludeDefinitions         &&
+                   UseInOutLocationQualifiers == rhs.UseInOutLocationQualifiers &&
+                   EntryPoint                 == rhs.EntryPoint                 &&
+                   SamplerSuffix              == rhs.SamplerSuffix;
+            // clang-format on
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const ConvertedShaderKey& Key) const
+            {
+                return ComputeHash(Key.EntryPoint, static_cast<Uint32>(Key.ShaderType), Key.SamplerSuffix, Key.IncludeDefinitions, Key.UseInOutLocationQualifiers);
+            }
+        };
+    };
+
+    // Shader source with all includes expanded. Streams created from the same
+    // text share one entry.
+    struct SourceCacheEntry
+    {
+        SourceCacheEntry(String&& _Source, size_t _Hash) :
+            Source{std::move(_Source)},
+            Hash{_Hash}
         {}
+
+        const String Source;
+        const size_t Hash;
+
+        // The members below are protected by the converter cache mutex
+
+        // Total size of the source and all converted shaders
+        size_t DataSize = 0;
+
+        // Whether the entry is still in the cache. Streams keep evicted entries alive.
+        bool IsCached = false;
+
+        // Tokens of the source. The entry does not keep them alive: they are only
+        // shared while at least one stream converting this source exists.
+        std::weak_ptr<const TokenizedSource> wpTokens;
+
+        // GLSL source of every shader converted from this source
+        std::unordered_map<ConvertedShaderKey, String, ConvertedShaderKey::Hasher> ConvertedShaders;
     };
-    typedef std::list<TokenInfo> TokenListType;
+
+    std::shared_ptr<const SourceFile> LoadIncludeFile(IShaderSourceInputStreamFactory* pSourceStreamFactory, const String& IncludeName) const;
+
+    std::shared_ptr<SourceCacheEntry> GetSourceCacheEntry(String&& Source) const;
+
+    std::shared_ptr<const TokenizedSource> GetChunkTokens(const SourceChunk& Chunk) const;
+
+    // Chunks are the parts of the expanded source that are used to assemble the tokens
+    // of the source from the tokens of the include files
+    std::shared_ptr<const TokenizedSource> GetTokenizedSource(SourceCacheEntry& Entry, const std::vector<SourceChunk>& Chunks) const;
+
+    bool FindConvertedShader(SourceCacheEntry& Entry, const ConvertedShaderKey& Key, String& GLSLSource) const;
+
+    void AddConvertedShader(SourceCacheEntry& Entry, ConvertedShaderKey&& Key, const String& GLSLSource) const;
 
 
     class ConversionStream : public ObjectBase<IHLSL2GLSLConversionStream>
@@ -291,7 +447,8 @@ private:
         ///                             the input stream factory using InputFileName.
         /// \param [in] NumSymbols    - Number of symbols in the HLSLSource string
         /// \param [in] bPreserveTokens - Whether to preserve original tokens. This must be set to true if the stream
-        ///                               will be used for multiple conversions.
+        ///                               will be used for multiple conversions. Original tokens are shared with other
+        ///                               streams that convert the same source.
         ConversionStream(IReferenceCounters*              pRefCounters,
                          const HLSL2GLSLConverterImpl&    Converter,
                          const char*                      InputFileName,
@@ -313,17 +470,58 @@ private:
                                                 bool        UseInOutLocationQualifiers,
                                                 IDataBlob** ppGLSLSource) override final;
 
+        virtual void DILIGENT_CALL_TYPE ConvertMultiple(const HLSL2GLSLEntryPointInfo* pEntryPoints,
+                                                        Uint32                         NumEntryPoints,
+                                                        bool                           IncludeDefintions,
+                                                        const char*                    SamplerSuffix,
+                                                        bool                           UseInOutLocationQualifiers,
+                                                        Uint32                         NumThreads,
+                                                        IDataBlob**                    ppGLSLSources) override final;
+
         IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_HLSL2GLSLConversionStream, TBase)
 
         const String& GetInputFileName() const { return m_InputFileName; }
 
     private:
-        void InsertIncludes(String& GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory);
-        void Tokenize(const String& Source);
+        // Creates a stream that converts an entry point from the copy of the parent stream
+        // tokens processed by ProcessCommonTokens(). Used by ConvertMultiple().
+        ConversionStream(IReferenceCounters* pRefCounters, const ConversionStream& Parent);
+
+        void ExpandIncludes(const std::shared_ptr<const SourceFile>& pFile,
+                            IShaderSourceInputStreamFactory*         pSourceStreamFactory,
+                            std::unordered_set<String>&              ProcessedIncludes,
+                            String&                                  Source);
+
+        // Resets m_Tokens to the original tokens of the source
+        void ResetTokens();
+
+        String ConvertTokens(const Char* EntryPoint,
+                             SHADER_TYPE ShaderType,
+                             bool        IncludeDefintions,
+                             const char* SamplerSuffix,
+                             bool        UseInOutLocationQualifiers);
+
+        // Performs all processing that does not depend on the entry point and finds
+        // the tokens of the entry point function names.
+        void ProcessCommonTokens(const char*                           SamplerSuffix,
+                                 const Char* const*                    EntryPoints,
+                                 size_t                                NumEntryPoints,
+                                 std::vector<TokenListType::iterator>& EntryPointTokens);
+
+        // Processes the entry point declaration and builds the GLSL source
+        String ProcessEntryPoint(TokenListType::iterator EntryPointToken,
+                                 SHADER_TYPE             ShaderType,
+                                 bool                    IncludeDefintions);
+
+        // Copies the tokens of the parent stream processed by ProcessCommonTokens() and registers
+        // structures at the given positions. Returns the token at EntryPointIdx position in the copy.
+        TokenListType::iterator CopyCommonTokens(const ConversionStream&    Parent,
+                                                 const std::vector<size_t>& StructDefIndices,
+                                                 size_t                     EntryPointIdx);
 
         typedef std::unordered_map<String, bool> SamplerHashType;
 
-        const HLSLObjectInfo* FindHLSLObject(const String& Name);
+        const HLSLObjectInfo* FindHLSLObject(const Char* Name);
 
         void ProcessShaderDeclaration(TokenListType::iterator EntryPointToken, SHADER_TYPE ShaderType);
 
@@ -503,6 +701,24 @@ private:
 
         String BuildGLSLSource();
 
+        // Source code of the stream with all includes expanded
+        std::shared_ptr<SourceCacheEntry> m_pSource;
+
+        // Chunks of the source file and include files that make up the expanded source
+        std::vector<SourceChunk> m_SourceChunks;
+
+        // Original tokens of the expanded source when the tokens are preserved or the source
+        // has includes. They are tokenized by the first conversion that is not found in the
+        // cache, and are copied to m_Tokens by every conversion.
+        std::shared_ptr<const TokenizedSource> m_pTokenizedSource;
+
+        // Text of the tokens when the tokens are not preserved and the source has no
+        // includes, in which case the source is tokenized directly into m_Tokens.
+        StringPool m_TokenTextPool;
+
+        // Pool for the token list nodes
+        TokenNodePool m_TokenNodePool;
+
         // Tokenized source code
         TokenListType m_Tokens;
 
@@ -545,6 +761,53 @@ private:
     static constexpr int MaxShaderStages = 6; // Maximum supported shader stages: VS, GS, PS, DS, HS, CS
 
     std::array<std::array<std::unordered_map<HashMapStringKey, String, HashMapStringKey::Hasher>, 2>, MaxShaderStages> m_HLSLSemanticToGLSLVar;
+
+    // Once the total size of the cached text exceeds this limit, least recently used sources are evicted
+    static constexpr size_t MaxCachedDataSize = size_t{64} << 20;
+
+    // The converter is shared by all threads, so all caches are protected by the mutex.
+    // Conversion itself is performed outside of the lock.
+    mutable std::mutex m_CacheMtx;
+
+    struct SourceKey
+    {
+        // References the text owned by the cache entry
+        const String* pSource;
+        size_t        Hash;
+
+        bool operator==(const SourceKey& rhs) const
+        {
+            return Hash == rhs.Hash && *pSource == *rhs.pSource;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const SourceKey& Key) const
+            {
+                return Key.Hash;
+            }
+        };
+    };
+    using SourceLRUList = std::list<std::shared_ptr<SourceCacheEntry>>;
+
+    void EvictSourceCacheEntries(const SourceCacheEntry* pKeepEntry) const;
+
+    // Worker threads that convert entry points in ConversionStream::ConvertMultiple()
+    ThreadingTools::ThreadPool& GetConversionPool() const;
+
+    mutable std::once_flag                              m_ConversionPoolFlag;
+    mutable std::unique_ptr<ThreadingTools::ThreadPool> m_pConversionPool;
+
+    // Expanded shader sources, most recently used first
+    mutable SourceLRUList m_SourceLRU;
+
+    mutable std::unordered_map<SourceKey, SourceLRUList::iterator, SourceKey::Hasher> m_SourceCache;
+
+    // Total size of expanded sources and converted shaders in the cache
+    mutable size_t m_CachedDataSize = 0;
+
+    // Last loaded version of every include file. The entry is replaced when the file is modified.
+    mutable std::unordered_map<String, std::shared_ptr<const SourceFile>> m_IncludeCache;
 };
 
 } // namespace Diligent
@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::TokenNodePool and Diligent::TokenListAllocator classes
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "BasicTypes.h"
+#include "MemoryAllocator.h"
+#include "DebugUtilities.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+/// Single-threaded pool of fixed-size nodes.
+
+/// Nodes are allocated from memory pages that grow geometrically in size.
+/// Released nodes are put into the free list and are reused by subsequent
+/// allocations. The memory is returned to the raw allocator when the pool is destroyed.
+class TokenNodePool
+{
+public:
+    explicit TokenNodePool(IMemoryAllocator& RawAllocator) noexcept :
+        m_RawAllocator{RawAllocator}
+    {}
+
+    // clang-format off
+    TokenNodePool           (const TokenNodePool&) = delete;
+    TokenNodePool           (TokenNodePool&&)      = delete;
+    TokenNodePool& operator=(const TokenNodePool&) = delete;
+    TokenNodePool& operator=(TokenNodePool&&)      = delete;
+    // clang-format on
+
+    ~TokenNodePool()
+    {
+        for (auto* pPage : m_Pages)
+            m_RawAllocator.Free(pPage);
+    }
+
+    /// Returns true if nodes of the given size can be allocated from the pool.
+    /// The size of the first requested node defines the node size of the pool.
+    bool IsNodeSizeSupported(size_t Size)
+    {
+        Size = Align(std::max(Size, sizeof(void*)), sizeof(void*));
+        if (m_NodeSize == 0)
+            m_NodeSize = Size;
+        return Size == m_NodeSize;
+    }
+
+    void* Allocate()
+    {
+        VERIFY(m_NodeSize != 0, "Node size is not initialized");
+        if (m_pFreeList != nullptr)
+        {
+            auto* pNode = m_pFreeList;
+            m_pFreeList = *reinterpret_cast<void**>(pNode);
+            return pNode;
+        }
+
+        if (m_pCurrPtr == m_pPageEnd)
+        {
+            const size_t NumNodes = size_t{MinNodesInPage} << std::min(m_Pages.size(), size_t{MaxPageSizeLog2});
+            auto*        pPage    = reinterpret_cast<Uint8*>(m_RawAllocator.Allocate(NumNodes * m_NodeSize, "Token node pool page", __FILE__, __LINE__));
+            m_Pages.push_back(pPage);
+            m_pCurrPtr = pPage;
+            m_pPageEnd = pPage + NumNodes * m_NodeSize;
+        }
+
+        auto* pNode = m_pCurrPtr;
+        m_pCurrPtr += m_NodeSize;
+        return pNode;
+    }
+
+    void Free(void* pNode)
+    {
+        *reinterpret_cast<void**>(pNode) = m_pFreeList;
+        m_pFreeList                      = pNode;
+    }
+
+private:
+    static constexpr Uint32 MinNodesInPage  = 64;
+    static constexpr Uint32 MaxPageSizeLog2 = 6;
+
+    IMemoryAllocator&  m_RawAllocator;
+    size_t             m_NodeSize  = 0;
+    void*              m_pFreeList = nullptr;
+    Uint8*             m_pCurrPtr  = nullptr;
+    Uint8*             m_pPageEnd  = nullptr;
+    std::vector<void*> m_Pages;
+};
+
+
+/// STL-compatible allocator for the token list that allocates individual
+/// nodes from the token node pool. Allocations of other sizes, as well as
+/// all allocations of the allocator without the pool, use operator new.
+template <typename T>
+struct TokenListAllocator
+{
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    TokenListAllocator() noexcept {}
+
+    explicit TokenListAllocator(TokenNodePool* pPool) noexcept :
+        m_pPool{pPool}
+    {}
+
+    template <typename U>
+    TokenListAllocator(const TokenListAllocator<U>& Other) noexcept :
+        m_pPool{Other.m_pPool}
+    {}
+
+    T* allocate(size_t Count)
+    {
+        static_assert(alignof(T) <= alignof(void*), "Node alignment exceeds the alignment guaranteed by the pool");
+        if (Count == 1 && m_pPool != nullptr && m_pPool->IsNodeSizeSupported(sizeof(T)))
+            return reinterpret_cast<T*>(m_pPool->Allocate());
+        else
+            return reinterpret_cast<T*>(::operator new(Count * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t Count)
+    {
+        if (Count == 1 && m_pPool != nullptr && m_pPool->IsNodeSizeSupported(sizeof(T)))
+            m_pPool->Free(p);
+        else
+            ::operator delete(p);
+    }
+
+    TokenNodePool* m_pPool = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(const TokenListAllocator<T>& lhs, const TokenListAllocator<U>& rhs)
+{
+    return lhs.m_pPool == rhs.m_pPool;
+}
+
+template <typename T, typename U>
+bool operator!=(const TokenListAllocator<T>& lhs, const TokenListAllocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+} // namespace Diligent
@@ -0,0 +1,343 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::TokenString class
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <ostream>
+
+#include "BasicTypes.h"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Text of a token produced by the HLSL->GLSL converter.
+
+/// A token string either references text that is owned by someone else (typically,
+/// the token text pool of the conversion stream), or owns a heap copy of its text.
+/// Referenced text must be null-terminated, so that c_str() never modifies the string
+/// and const strings can be safely read by multiple threads. Copying a referencing string
+/// never allocates memory: memory is only allocated when the string is modified.
+class TokenString
+{
+public:
+    TokenString() noexcept {}
+
+    TokenString(const Char* Str, size_t Length)
+    {
+        Assign(Str, Length);
+    }
+
+    TokenString(const Char* Str) :
+        TokenString{Str, strlen(Str)}
+    {}
+
+    TokenString(const String& Str) :
+        TokenString{Str.c_str(), Str.length()}
+    {}
+
+    TokenString(const TokenString& Str)
+    {
+        if (Str.IsOwner())
+            Assign(Str.m_Str, Str.m_Length);
+        else
+            Reference(Str);
+    }
+
+    TokenString(TokenString&& Str) noexcept :
+        // clang-format off
+        m_Str     {Str.m_Str     },
+        m_Length  {Str.m_Length  },
+        m_Capacity{Str.m_Capacity}
+    // clang-format on
+    {
+        Str.m_Str      = EmptyStr();
+        Str.m_Length   = 0;
+        Str.m_Capacity = 0;
+    }
+
+    ~TokenString()
+    {
+        ReleaseBuffer();
+    }
+
+    /// Creates a string that references Length characters starting at Str
+    /// without copying them. The text must be null-terminated, i.e. Str[Length]
+    /// must be '\0', and must outlive the returned string.
+    static TokenString MakeReference(const Char* Str, size_t Length)
+    {
+        VERIFY_EXPR(Str != nullptr && Length < std::numeric_limits<Uint32>::max());
+        VERIFY(Str[Length] == '\0', "Referenced text must be null-terminated");
+        TokenString RefStr;
+        RefStr.m_Str    = Str;
+        RefStr.m_Length = static_cast<Uint32>(Length);
+        return RefStr;
+    }
+
+    TokenString& operator=(const TokenString& Str)
+    {
+        if (this != &Str)
+        {
+            if (Str.IsOwner())
+                Assign(Str.m_Str, Str.m_Length);
+            else
+            {
+                ReleaseBuffer();
+                Reference(Str);
+            }
+        }
+        return *this;
+    }
+
+    TokenString& operator=(TokenString&& Str) noexcept
+    {
+        if (this != &Str)
+        {
+            ReleaseBuffer();
+            m_Str          = Str.m_Str;
+            m_Length       = Str.m_Length;
+            m_Capacity     = Str.m_Capacity;
+            Str.m_Str      = EmptyStr();
+            Str.m_Length   = 0;
+            Str.m_Capacity = 0;
+        }
+        return *this;
+    }
+
+    TokenString& operator=(const Char* Str)
+    {
+        Assign(Str, strlen(Str));
+        return *this;
+    }
+
+    TokenString& operator=(const String& Str)
+    {
+        Assign(Str.c_str(), Str.length());
+        return *this;
+    }
+
+    // clang-format off
+    size_t      length() const { return m_Length; }
+    size_t      size()   const { return m_Length; }
+    bool        empty()  const { return m_Length == 0; }
+    const Char* data()   const { return m_Str; }
+    const Char* begin()  const { return m_Str; }
+    const Char* end()    const { return m_Str + m_Length; }
+    // clang-format on
+
+    Char operator[](size_t i) const
+    {
+        VERIFY_EXPR(i < m_Length);
+        return m_Str[i];
+    }
+
+    Char back() const
+    {
+        VERIFY_EXPR(m_Length > 0);
+        return m_Str[m_Length - 1];
+    }
+
+    /// Returns the null-terminated string
+    const Char* c_str() const
+    {
+        VERIFY_EXPR(m_Str[m_Length] == '\0');
+        return m_Str;
+    }
+
+    String str() const
+    {
+        return String{m_Str, m_Length};
+    }
+
+    void clear()
+    {
+        ReleaseBuffer();
+        m_Str    = EmptyStr();
+        m_Length = 0;
+    }
+
+    void reserve(size_t Length)
+    {
+        Reserve(Length);
+    }
+
+    void push_back(Char Symbol)
+    {
+        append(&Symbol, 1);
+    }
+
+    void pop_back()
+    {
+        VERIFY_EXPR(m_Length > 0);
+        Reserve(m_Length);
+        GetBuffer()[--m_Length] = '\0';
+    }
+
+    TokenString& append(const Char* Str, size_t Length)
+    {
+        if (Length == 0)
+            return *this;
+
+        const auto NewLength = m_Length + Length;
+        if (NewLength + 1 > m_Capacity)
+            Reserve(std::max(NewLength, size_t{m_Capacity} * 2));
+        memcpy(GetBuffer() + m_Length, Str, Length);
+        m_Length              = static_cast<Uint32>(NewLength);
+        GetBuffer()[m_Length] = '\0';
+        return *this;
+    }
+
+    TokenString& append(const Char* Str)
+    {
+        return append(Str, strlen(Str));
+    }
+
+    TokenString& append(const String& Str)
+    {
+        return append(Str.c_str(), Str.length());
+    }
+
+    TokenString& append(const TokenString& Str)
+    {
+        return append(Str.m_Str, Str.m_Length);
+    }
+
+    bool Equals(const Char* Str, size_t Length) const
+    {
+        return m_Length == Length && (Length == 0 || memcmp(m_Str, Str, Length) == 0);
+    }
+
+    // clang-format off
+    friend bool operator==(const TokenString& lhs, const TokenString& rhs) { return lhs.Equals(rhs.m_Str, rhs.m_Length); }
+    friend bool operator==(const TokenString& lhs, const Char*        rhs) { return lhs.Equals(rhs, strlen(rhs)); }
+    friend bool operator==(const TokenString& lhs, const String&      rhs) { return lhs.Equals(rhs.c_str(), rhs.length()); }
+    friend bool operator==(const Char*        lhs, const TokenString& rhs) { return rhs == lhs; }
+    friend bool operator==(const String&      lhs, const TokenString& rhs) { return rhs == lhs; }
+
+    friend bool operator!=(const TokenString& lhs, const TokenString& rhs) { return !(lhs == rhs); }
+    friend bool operator!=(const TokenString& lhs, const Char*        rhs) { return !(lhs == rhs); }
+    friend bool operator!=(const TokenString& lhs, const String&      rhs) { return !(lhs == rhs); }
+    friend bool operator!=(const Char*        lhs, const TokenString& rhs) { return !(rhs == lhs); }
+    friend bool operator!=(const String&      lhs, const TokenString& rhs) { return !(rhs == lhs); }
+    // clang-format on
+
+    friend String& operator+=(String& lhs, const TokenString& rhs)
+    {
+        return lhs.append(rhs.m_Str, rhs.m_Length);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const TokenString& Str)
+    {
+        return os.write(Str.m_Str, Str.m_Length);
+    }
+
+private:
+    static const Char* EmptyStr()
+    {
+        return "";
+    }
+
+    bool IsOwner() const
+    {
+        return m_Capacity != 0;
+    }
+
+    Char* GetBuffer()
+    {
+        VERIFY_EXPR(IsOwner());
+        return const_cast<Char*>(m_Str);
+    }
+
+    void Reference(const TokenString& Str)
+    {
+        VERIFY_EXPR(!Str.IsOwner());
+        m_Str      = Str.m_Str;
+        m_Length   = Str.m_Length;
+        m_Capacity = 0;
+    }
+
+    void Assign(const Char* Str, size_t Length)
+    {
+        VERIFY_EXPR(Str != nullptr);
+        if (Length == 0)
+        {
+            clear();
+            return;
+        }
+
+        if (Length + 1 > m_Capacity)
+        {
+            ReleaseBuffer();
+            m_Str    = EmptyStr();
+            m_Length = 0;
+            Reserve(Length);
+        }
+        // Str may point to our own buffer
+        memmove(GetBuffer(), Str, Length);
+        m_Length              = static_cast<Uint32>(Length);
+        GetBuffer()[m_Length] = '\0';
+    }
+
+    // Makes sure that the string owns a buffer large enough to store
+    // Length characters plus the null terminator.
+    void Reserve(size_t Length)
+    {
+        VERIFY(Length < std::numeric_limits<Uint32>::max(), "String is too long");
+        if (IsOwner() && Length + 1 <= m_Capacity)
+            return;
+
+        const auto NewCapacity = static_cast<Uint32>(std::max(Length, size_t{m_Length}) + 1);
+        auto*      NewBuffer   = new Char[NewCapacity];
+        if (m_Length > 0)
+            memcpy(NewBuffer, m_Str, m_Length);
+        NewBuffer[m_Length] = '\0';
+        ReleaseBuffer();
+        m_Str      = NewBuffer;
+        m_Capacity = NewCapacity;
+    }
+
+    void ReleaseBuffer()
+    {
+        if (IsOwner())
+        {
+            delete[] m_Str;
+            m_Capacity = 0;
+        }
+    }
+
+    const Char* m_Str      = EmptyStr();
+    Uint32      m_Length   = 0;
+    Uint32      m_Capacity = 0; // Zero if the string does not own the memory
+};
+
+} // namespace Diligent
@@ -40,6 +40,27 @@ static const INTERFACE_ID IID_HLSL2GLSLConversionStream =
     {0x1fde020a, 0x9c73, 0x4a76, {0x8a, 0xef, 0xc2, 0xc6, 0xc2, 0xcf, 0xe, 0xa5}};
 
 
+/// Shader entry point to convert, see IHLSL2GLSLConversionStream::ConvertMultiple.
+struct HLSL2GLSLEntryPointInfo
+{
+    /// Entry point name.
+    const Char* EntryPoint DEFAULT_INITIALIZER(nullptr);
+
+    /// Shader type.
+    SHADER_TYPE ShaderType DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+#if DILIGENT_CPP_INTERFACE
+    HLSL2GLSLEntryPointInfo() noexcept {}
+
+    HLSL2GLSLEntryPointInfo(const Char* _EntryPoint, SHADER_TYPE _ShaderType) noexcept :
+        EntryPoint{_EntryPoint},
+        ShaderType{_ShaderType}
+    {}
+#endif
+};
+typedef struct HLSL2GLSLEntryPointInfo HLSL2GLSLEntryPointInfo;
+
+
 #define DILIGENT_INTERFACE_NAME IHLSL2GLSLConversionStream
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -58,6 +79,34 @@ DILIGENT_BEGIN_INTERFACE(IHLSL2GLSLConversionStream, IObject)
                                  const char* SamplerSuffix,
                                  bool        UseInOutLocationQualifiers,
                                  IDataBlob** ppGLSLSource) PURE;
+
+    /// Converts multiple entry points in one pass.
+
+    /// \param [in]  pEntryPoints    - Array of NumEntryPoints entry points to convert.
+    /// \param [in]  NumEntryPoints  - Number of entry points.
+    /// \param [in]  IncludeDefintions          - Whether to include GLSL definitions supporting HLSL->GLSL conversion.
+    /// \param [in]  SamplerSuffix              - Combined texture sampler suffix.
+    /// \param [in]  UseInOutLocationQualifiers - Whether to use in-out location qualifiers.
+    /// \param [in]  NumThreads      - Maximum number of threads, including the calling one, that
+    ///                                convert the entry points. Additional threads are taken from
+    ///                                the converter's worker thread pool. If this parameter is 0 or 1,
+    ///                                all entry points are converted by the calling thread.
+    /// \param [out] ppGLSLSources   - Array of NumEntryPoints pointers where the converted
+    ///                                GLSL sources will be written. If an entry point fails to convert,
+    ///                                the error is logged and null is written to the corresponding element.
+    ///
+    /// \remarks   The method processes the source code parts that do not depend on
+    ///            the entry point (constant buffers, structures, textures, samplers, etc.) once
+    ///            for all entry points. Every entry point is then converted from the copy of the
+    ///            processed tokens. The results are the same as the ones produced by Convert().
+    VIRTUAL void METHOD(ConvertMultiple)(THIS_
+                                         const HLSL2GLSLEntryPointInfo* pEntryPoints,
+                                         Uint32                         NumEntryPoints,
+                                         bool                           IncludeDefintions,
+                                         const char*                    SamplerSuffix,
+                                         bool                           UseInOutLocationQualifiers,
+                                         Uint32                         NumThreads,
+                                         IDataBlob**                    ppGLSLSources) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -67,7 +116,8 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IHLSL2GLSLConversionStream_Convert(This, ...) CALL_IFACE_METHOD(HLSL2GLSLConversionStream, Convert, This, __VA_ARGS__)
+#    define IHLSL2GLSLConversionStream_Convert(This, ...)         CALL_IFACE_METHOD(HLSL2GLSLConversionStream, Convert,         This, __VA_ARGS__)
+#    define IHLSL2GLSLConversionStream_ConvertMultiple(This, ...) CALL_IFACE_METHOD(HLSL2GLSLConversionStream, ConvertMultiple, This, __VA_ARGS__)
 
 // clang-format on
 
@@ -356,6 +356,11 @@
 #include "pch.h"
 #include <unordered_set>
 #include <string>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
 
 #include "HLSL2GLSLConverterImpl.hpp"
 #include "GraphicsAccessories.hpp"
@@ -462,6 +467,36 @@ static bool SkipComment(const String& Input, InteratorType& Pos)
     return false;
 }
 
+// Returns true if the text that only contains delimiters and comments ends inside a comment
+static bool EndsInsideComment(const String& Text)
+{
+    auto Pos = Text.cbegin();
+    while (Pos != Text.end())
+    {
+        if (IsDelimiter(*Pos))
+        {
+            ++Pos;
+            continue;
+        }
+
+        const auto CommentStart = Pos;
+        if (!SkipComment(Text, Pos))
+        {
+            UNEXPECTED("Only delimiters and comments are expected");
+            return true;
+        }
+
+        if (Pos == Text.end())
+        {
+            // // Comment      /* Comment */
+            //           ^                 ^
+            // Line comments end before the new line, so only a closed block comment may end at the end of the text
+            return CommentStart[1] == '/' || Pos - CommentStart < 4 || Pos[-2] != '*' || Pos[-1] != '/';
+        }
+    }
+    return false;
+}
+
 inline bool SkipDelimeters(const String& Input, String::const_iterator& SrcChar)
 {
     for (; SrcChar != Input.end() && IsDelimiter(*SrcChar); ++SrcChar)
@@ -768,7 +803,8 @@ HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
 #undef DEFINE_VARIABLE
 }
 
-String CompressNewLines(const String& Str)
+template <typename StringType>
+String CompressNewLines(const StringType& Str)
 {
     String Out;
     auto   Char = Str.begin();
@@ -794,7 +830,8 @@ String CompressNewLines(const String& Str)
     return Out;
 }
 
-static Int32 CountNewLines(const String& Str)
+template <typename StringType>
+static Int32 CountNewLines(const StringType& Str)
 {
     Int32 NumNewLines = 0;
     auto  Char        = Str.begin();
@@ -873,7 +910,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
     for (; Token != CurrLineStartToken; ++Token)
     {
         Ctx.append(CompressNewLines(Token->Delimiter));
-        Ctx.append(Token->Literal);
+        Ctx += Token->Literal;
     }
 
     //\n  if ( x != 0 )
@@ -905,7 +942,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
             Spaces.append(Token->Literal.length(), ' ');
 
         Ctx.append(CompressNewLines(Token->Delimiter));
-        Ctx.append(Token->Literal);
+        Ctx += Token->Literal;
         ++Token;
 
         if (Token == m_Tokens.end())
@@ -923,7 +960,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
     while (Token != m_Tokens.end() && NumLinesBelow <= NumAdjacentLines)
     {
         Ctx.append(CompressNewLines(Token->Delimiter));
-        Ctx.append(Token->Literal);
+        Ctx += Token->Literal;
         ++Token;
 
         if (Token == m_Tokens.end())
@@ -968,24 +1005,25 @@ bool SkipPrefix(const Char* RefStr, IterType& begin, IterType end)
     return false;
 }
 
-// The method scans the source code and replaces
-// all #include directives with the contents of the
-// file. It maintains a set of already parsed includes
-// to avoid double inclusion
-void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory)
+// The constructor scans the source code and splits it
+// into chunks separated by #include directives
+HLSL2GLSLConverterImpl::SourceFile::SourceFile(String&& _Text, size_t _Hash) :
+    // clang-format off
+    Text{std::move(_Text)},
+    Hash{_Hash}
+// clang-format on
 {
-    // Put all the includes into the set to avoid multiple inclusion
-    std::unordered_set<String> ProcessedIncludes;
-
+    // The text before this position has already been split into chunks
+    auto ChunkStart = Text.begin();
     do
     {
-        // Find the first #include statement
-        auto Pos             = GLSLSource.begin();
-        auto IncludeStartPos = GLSLSource.end();
-        while (Pos != GLSLSource.end())
+        // Find the next #include statement
+        auto Pos             = ChunkStart;
+        auto IncludeStartPos = Text.end();
+        while (Pos != Text.end())
         {
             // #   include "TestFile.fxh"
-            if (SkipDelimetersAndComments(GLSLSource, Pos))
+            if (SkipDelimetersAndComments(Text, Pos))
                 break;
             if (*Pos == '#')
             {
@@ -995,14 +1033,14 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
                 ++Pos;
                 // #   include "TestFile.fxh"
                 //  ^
-                if (SkipDelimetersAndComments(GLSLSource, Pos))
+                if (SkipDelimetersAndComments(Text, Pos))
                 {
                     // End of the file reached - break
                     break;
                 }
                 // #   include "TestFile.fxh"
                 //     ^
-                if (SkipPrefix("include", Pos, GLSLSource.end()))
+                if (SkipPrefix("include", Pos, Text.end()))
                 {
                     // #   include "TestFile.fxh"
                     //            ^
@@ -1020,11 +1058,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
         }
 
         // No more #include found
-        if (Pos == GLSLSource.end())
+        if (Pos == Text.end())
             break;
 
         // Find open quotes
-        if (SkipDelimetersAndComments(GLSLSource, Pos))
+        if (SkipDelimetersAndComments(Text, Pos))
             LOG_ERROR_AND_THROW("Unexpected EOF after #include directive");
         // #   include "TestFile.fxh"
         //             ^
@@ -1035,87 +1073,119 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
         //              ^
         auto IncludeNameStartPos = Pos;
         // Find closing quotes
-        while (Pos != GLSLSource.end() && *Pos != '\"' && *Pos != '>') ++Pos;
+        while (Pos != Text.end() && *Pos != '\"' && *Pos != '>') ++Pos;
         // #   include "TestFile.fxh"
         //                          ^
-        if (Pos == GLSLSource.end())
+        if (Pos == Text.end())
             LOG_ERROR_AND_THROW("Missing closing quotes or \'>\' after #include directive");
 
-        // Get the name of the include file
-        auto IncludeName = String(IncludeNameStartPos, Pos);
-        ++Pos;
         // #   include "TestFile.fxh"
-        // ^                         ^
-        // IncludeStartPos           Pos
-        GLSLSource.erase(IncludeStartPos, Pos);
-
-        // Convert the name to lower case
-        String IncludeFileLowercase = StrToLower(IncludeName);
-        // Insert the lower-case name into the set
-        auto It = ProcessedIncludes.insert(IncludeFileLowercase);
-        // If the name was actually inserted, which means the include encountered for the first time,
-        // replace the text with the file content
-        if (It.second)
+        // ^                        ^
+        // IncludeStartPos          Pos
+        Chunks.emplace_back(ChunkStart, IncludeStartPos);
+        Includes.emplace_back(IncludeNameStartPos, Pos);
+        ++Pos;
+        ChunkStart = Pos;
+    } while (true);
+
+    Chunks.emplace_back(ChunkStart, Text.end());
+    ChunkTokens.resize(Chunks.size());
+}
+
+// The method appends the file to the source and replaces
+// all #include directives with the contents of the
+// included files. It maintains a set of already parsed
+// includes to avoid double inclusion
+void HLSL2GLSLConverterImpl::ConversionStream::ExpandIncludes(const std::shared_ptr<const SourceFile>& pFile,
+                                                              IShaderSourceInputStreamFactory*         pSourceStreamFactory,
+                                                              std::unordered_set<String>&              ProcessedIncludes,
+                                                              String&                                  Source)
+{
+    for (size_t i = 0; i < pFile->Chunks.size(); ++i)
+    {
+        const auto& Chunk = pFile->Chunks[i];
+        if (!Chunk.empty())
         {
-            RefCntAutoPtr<IFileStream> pIncludeDataStream;
-            pSourceStreamFactory->CreateInputStream(IncludeName.c_str(), &pIncludeDataStream);
-            if (!pIncludeDataStream)
-                LOG_ERROR_AND_THROW("Failed to open include file ", IncludeName);
-            RefCntAutoPtr<IDataBlob> pIncludeData(MakeNewRCObj<DataBlobImpl>()(0));
-            pIncludeDataStream->ReadBlob(pIncludeData);
-
-            // Get include text
-            auto   IncludeText = reinterpret_cast<const Char*>(pIncludeData->GetDataPtr());
-            size_t NumSymbols  = pIncludeData->GetSize();
-
-            // Insert the text into source
-            GLSLSource.insert(IncludeStartPos - GLSLSource.begin(), IncludeText, NumSymbols);
+            Source.append(Chunk);
+            m_SourceChunks.push_back({pFile, i});
         }
-    } while (true);
+
+        if (i < pFile->Includes.size())
+        {
+            const auto& IncludeName = pFile->Includes[i];
+            // Insert the lower-case name into the set
+            auto It = ProcessedIncludes.insert(StrToLower(IncludeName));
+            // If the name was actually inserted, which means the include encountered for the first time,
+            // replace the directive with the file content
+            if (It.second)
+                ExpandIncludes(m_Converter.LoadIncludeFile(pSourceStreamFactory, IncludeName), pSourceStreamFactory, ProcessedIncludes, Source);
+        }
+    }
 }
 
 
-void ReadNumericConstant(const String& Source, String::const_iterator& Pos, String& Output)
+void SkipNumericConstant(const String& Source, String::const_iterator& Pos)
 {
-#define COPY_SYMBOL()                    \
+#define SKIP_SYMBOL()                    \
     {                                    \
-        Output.push_back(*(Pos++));      \
+        ++Pos;                           \
         if (Pos == Source.end()) return; \
     }
 
     while (Pos != Source.end() && *Pos >= '0' && *Pos <= '9')
-        COPY_SYMBOL()
+        SKIP_SYMBOL()
 
     if (*Pos == '.')
     {
-        COPY_SYMBOL()
-        // Copy all numbers
+        SKIP_SYMBOL()
+        // Skip all numbers
         while (Pos != Source.end() && *Pos >= '0' && *Pos <= '9')
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
     }
 
     // Scientific notation
     // e+1242, E-234
     if (*Pos == 'e' || *Pos == 'E')
     {
-        COPY_SYMBOL()
+        SKIP_SYMBOL()
 
         if (*Pos == '+' || *Pos == '-')
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
 
         // Skip all numbers
         while (Pos != Source.end() && *Pos >= '0' && *Pos <= '9')
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
     }
 
     if (*Pos == 'f' || *Pos == 'F')
-        COPY_SYMBOL()
-#undef COPY_SYMBOL
+        SKIP_SYMBOL()
+#undef SKIP_SYMBOL
 }
 
 
 // The function convertes source code into a token list
-void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
+HLSL2GLSLConverterImpl::TokenizedSource::TokenizedSource(const HLSL2GLSLConverterImpl& Converter, const String& Source) :
+    // clang-format off
+    NodePool{GetRawAllocator()},
+    Tokens  {TokenListAllocator<TokenInfo>{&NodePool}}
+// clang-format on
+{
+    auto TrailingDelimiterPos = Tokenize(Converter, Source, TextPool, Tokens);
+    TrailingDelimiter.assign(Source, TrailingDelimiterPos, String::npos);
+}
+
+HLSL2GLSLConverterImpl::TokenizedSource::TokenizedSource() :
+    // clang-format off
+    NodePool{GetRawAllocator()},
+    Tokens  {TokenListAllocator<TokenInfo>{&NodePool}}
+// clang-format on
+{
+}
+
+size_t HLSL2GLSLConverterImpl::TokenizedSource::Tokenize(const HLSL2GLSLConverterImpl& Converter,
+                                                         const String&                 Source,
+                                                         StringPool&                   TextPool,
+                                                         TokenListType&                Tokens)
 {
 #define CHECK_END(...)                      \
     do                                      \
@@ -1131,9 +1201,43 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
     int OpenBraceCount   = 0;
     int OpenStapleCount  = 0;
 
+    // Delimiter and literal of every token are copied into the token text pool
+    // one after another, each followed by the null terminator:
+    //
+    //   <Delimiter>\0<Literal>\0<Delimiter>\0<Literal>\0...
+    //
+    // Every source symbol is copied at most once, and every token consumes
+    // at least one symbol, so three times the source length is always enough.
+    TextPool.Reserve(Source.length() * 3 + 2, GetRawAllocator());
+
     // Push empty node in the beginning of the list to facilitate
     // backwards searching
-    m_Tokens.push_back(TokenInfo());
+    Tokens.push_back(TokenInfo());
+
+    // Appends the symbol to the literal of the last token. This is only called
+    // when the symbol immediately follows the last token in the source, so the
+    // literal is normally the last string in the pool and is extended in place.
+    auto AppendToLastToken = [&](Char Symbol, TokenType Type) //
+    {
+        auto&       LastToken   = Tokens.back();
+        const auto* pLiteralEnd = LastToken.Literal.data() + LastToken.Literal.length();
+        // Allocate(0) returns the current position in the pool
+        if (TextPool.GetRemainingSize() > 0 && TextPool.Allocate(0) == pLiteralEnd + 1)
+        {
+            auto* pSymbol = TextPool.Allocate(1);
+            pSymbol[-1]   = Symbol;
+            pSymbol[0]    = '\0';
+
+            LastToken.Literal = TokenString::MakeReference(LastToken.Literal.data(), LastToken.Literal.length() + 1);
+        }
+        else
+        {
+            UNEXPECTED("The literal of the last token is expected to be the last string in the pool");
+            // Copy the literal
+            LastToken.Literal.push_back(Symbol);
+        }
+        LastToken.Type = Type;
+    };
 
     // https://msdn.microsoft.com/en-us/library/windows/desktop/bb509638(v=vs.85).aspx
 
@@ -1142,99 +1246,94 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
     //   * This might be a + b, -a or -10
     // * Operator ?: is not detected
     auto SrcPos = Source.begin();
+    // Delimiters and comments after the last token
+    auto TrailingDelimStart = Source.end();
     while (SrcPos != Source.end())
     {
-        TokenInfo NewToken;
-        auto      DelimStart = SrcPos;
+        TokenType NewTokenType = TokenType::Undefined;
+        auto      DelimStart   = SrcPos;
         SkipDelimetersAndComments(Source, SrcPos);
-        if (DelimStart != SrcPos)
-        {
-            auto DelimSize = SrcPos - DelimStart;
-            NewToken.Delimiter.reserve(DelimSize);
-            NewToken.Delimiter.append(DelimStart, SrcPos);
-        }
         if (SrcPos == Source.end())
+        {
+            TrailingDelimStart = DelimStart;
             break;
+        }
 
+        const auto DelimEnd     = SrcPos;
+        const bool HasDelimiter = DelimStart != DelimEnd;
+        auto       LiteralStart = SrcPos;
+        auto       LiteralEnd   = SrcPos;
         switch (*SrcPos)
         {
             case '#':
             {
-                NewToken.Type       = TokenType::PreprocessorDirective;
-                auto DirectiveStart = SrcPos;
+                NewTokenType = TokenType::PreprocessorDirective;
                 ++SrcPos;
                 SkipDelimetersAndComments(Source, SrcPos);
                 CHECK_END("Missing preprocessor directive");
                 SkipIdentifier(Source, SrcPos);
-                auto DirectiveSize = SrcPos - DirectiveStart;
-                NewToken.Literal.reserve(DirectiveSize);
-                NewToken.Literal.append(DirectiveStart, SrcPos);
             }
             break;
 
             case ';':
-                NewToken.Type = TokenType::Semicolon;
-                NewToken.Literal.push_back(*(SrcPos++));
+                NewTokenType = TokenType::Semicolon;
+                ++SrcPos;
                 break;
 
             case '=':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "")
+                if (!HasDelimiter)
                 {
-                    auto& LastToken = m_Tokens.back();
+                    const auto& LastLiteral = Tokens.back().Literal;
                     // +=, -=, *=, /=, %=, <<=, >>=, &=, |=, ^=
-                    if (LastToken.Literal == "+" ||
-                        LastToken.Literal == "-" ||
-                        LastToken.Literal == "*" ||
-                        LastToken.Literal == "/" ||
-                        LastToken.Literal == "%" ||
-                        LastToken.Literal == "<<" ||
-                        LastToken.Literal == ">>" ||
-                        LastToken.Literal == "&" ||
-                        LastToken.Literal == "|" ||
-                        LastToken.Literal == "^")
+                    if (LastLiteral == "+" ||
+                        LastLiteral == "-" ||
+                        LastLiteral == "*" ||
+                        LastLiteral == "/" ||
+                        LastLiteral == "%" ||
+                        LastLiteral == "<<" ||
+                        LastLiteral == ">>" ||
+                        LastLiteral == "&" ||
+                        LastLiteral == "|" ||
+                        LastLiteral == "^")
                     {
-                        LastToken.Type = TokenType::Assignment;
-                        LastToken.Literal.push_back(*(SrcPos++));
+                        AppendToLastToken(*(SrcPos++), TokenType::Assignment);
                         continue;
                     }
-                    else if (LastToken.Literal == "<" ||
-                             LastToken.Literal == ">" ||
-                             LastToken.Literal == "=" ||
-                             LastToken.Literal == "!")
+                    else if (LastLiteral == "<" ||
+                             LastLiteral == ">" ||
+                             LastLiteral == "=" ||
+                             LastLiteral == "!")
                     {
-                        LastToken.Type = TokenType::ComparisonOp;
-                        LastToken.Literal.push_back(*(SrcPos++));
+                        AppendToLastToken(*(SrcPos++), TokenType::ComparisonOp);
                         continue;
                     }
                 }
 
-                NewToken.Type = TokenType::Assignment;
-                NewToken.Literal.push_back(*(SrcPos++));
+                NewTokenType = TokenType::Assignment;
+                ++SrcPos;
                 break;
 
             case '|':
             case '&':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
-                    m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
+                if (!HasDelimiter &&
+                    Tokens.back().Literal.length() == 1 && Tokens.back().Literal[0] == *SrcPos)
                 {
-                    m_Tokens.back().Type = TokenType::BooleanOp;
-                    m_Tokens.back().Literal.push_back(*(SrcPos++));
+                    AppendToLastToken(*(SrcPos++), TokenType::BooleanOp);
                     continue;
                 }
                 else
                 {
-                    NewToken.Type = TokenType::BitwiseOp;
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    NewTokenType = TokenType::BitwiseOp;
+                    ++SrcPos;
                 }
                 break;
 
             case '<':
             case '>':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
-                    m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
+                if (!HasDelimiter &&
+                    Tokens.back().Literal.length() == 1 && Tokens.back().Literal[0] == *SrcPos)
                 {
-                    m_Tokens.back().Type = TokenType::BitwiseOp;
-                    m_Tokens.back().Literal.push_back(*(SrcPos++));
+                    AppendToLastToken(*(SrcPos++), TokenType::BitwiseOp);
                     continue;
                 }
                 else
@@ -1242,73 +1341,74 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                     // Note: we do not distinguish between comparison operators
                     // and template arguments like in Texture2D<float> at this
                     // point. This will be clarified when textures are processed.
-                    NewToken.Type = TokenType::ComparisonOp;
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    NewTokenType = TokenType::ComparisonOp;
+                    ++SrcPos;
                 }
                 break;
 
             case '+':
             case '-':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
-                    m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
+                if (!HasDelimiter &&
+                    Tokens.back().Literal.length() == 1 && Tokens.back().Literal[0] == *SrcPos)
                 {
-                    m_Tokens.back().Type = TokenType::IncDecOp;
-                    m_Tokens.back().Literal.push_back(*(SrcPos++));
+                    AppendToLastToken(*(SrcPos++), TokenType::IncDecOp);
                     continue;
                 }
                 else
                 {
                     // We do not currently distinguish between math operator a + b,
                     // unary operator -a and numerical constant -1:
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    ++SrcPos;
                 }
                 break;
 
             case '~':
             case '^':
-                NewToken.Type = TokenType::BitwiseOp;
-                NewToken.Literal.push_back(*(SrcPos++));
+                NewTokenType = TokenType::BitwiseOp;
+                ++SrcPos;
                 break;
 
             case '*':
             case '/':
             case '%':
-                NewToken.Type = TokenType::MathOp;
-                NewToken.Literal.push_back(*(SrcPos++));
+                NewTokenType = TokenType::MathOp;
+                ++SrcPos;
                 break;
 
             case '!':
-                NewToken.Type = TokenType::BooleanOp;
-                NewToken.Literal.push_back(*(SrcPos++));
+                NewTokenType = TokenType::BooleanOp;
+                ++SrcPos;
                 break;
 
             case ',':
-                NewToken.Type = TokenType::Comma;
-                NewToken.Literal.push_back(*(SrcPos++));
+                NewTokenType = TokenType::Comma;
+                ++SrcPos;
                 break;
 
             case '"':
                 //[domain("quad")]
                 //        ^
-                NewToken.Type = TokenType::SrtingConstant;
+                NewTokenType = TokenType::SrtingConstant;
                 ++SrcPos;
                 //[domain("quad")]
                 //         ^
+                LiteralStart = SrcPos;
                 while (SrcPos != Source.end() && *SrcPos != '"')
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    ++SrcPos;
                 //[domain("quad")]
                 //             ^
+                LiteralEnd = SrcPos;
                 if (SrcPos != Source.end())
                     ++SrcPos;
                 //[domain("quad")]
                 //              ^
                 break;
 
-#define BRACKET_CASE(Symbol, TokenType, Action)  \
-    case Symbol:                                 \
-        NewToken.Type = TokenType;               \
-        NewToken.Literal.push_back(*(SrcPos++)); \
-        Action;                                  \
+#define BRACKET_CASE(Symbol, TokenType, Action) \
+    case Symbol:                                \
+        NewTokenType = TokenType;               \
+        ++SrcPos;                               \
+        Action;                                 \
         break;
 
                 BRACKET_CASE('(', TokenType::OpenBracket, ++OpenBracketCount);
@@ -1323,26 +1423,13 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
 
             default:
             {
-                auto IdentifierStartPos = SrcPos;
                 SkipIdentifier(Source, SrcPos);
-                if (IdentifierStartPos != SrcPos)
+                if (LiteralStart != SrcPos)
                 {
-                    auto IDSize = SrcPos - IdentifierStartPos;
-                    NewToken.Literal.reserve(IDSize);
-                    NewToken.Literal.append(IdentifierStartPos, SrcPos);
-                    auto KeywordIt = m_Converter.m_HLSLKeywords.find(NewToken.Literal.c_str());
-                    if (KeywordIt != m_Converter.m_HLSLKeywords.end())
-                    {
-                        NewToken.Type = KeywordIt->second.Type;
-                        VERIFY(NewToken.Literal == KeywordIt->second.Literal, "Inconsistent literal");
-                    }
-                    else
-                    {
-                        NewToken.Type = TokenType::Identifier;
-                    }
+                    // Identifier or keyword - the type is determined below
+                    NewTokenType = TokenType::Identifier;
                 }
-
-                if (NewToken.Type == TokenType::Undefined)
+                else
                 {
                     bool bIsNumericalCostant = *SrcPos >= '0' && *SrcPos <= '9';
                     if (!bIsNumericalCostant && *SrcPos == '.')
@@ -1352,23 +1439,121 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                     }
                     if (bIsNumericalCostant)
                     {
-                        ReadNumericConstant(Source, SrcPos, NewToken.Literal);
-                        NewToken.Type = TokenType::NumericConstant;
+                        SkipNumericConstant(Source, SrcPos);
+                        NewTokenType = TokenType::NumericConstant;
+                    }
+                    else
+                    {
+                        ++SrcPos;
                     }
-                }
-
-                if (NewToken.Type == TokenType::Undefined)
-                {
-                    NewToken.Literal.push_back(*(SrcPos++));
                 }
                 // Operators
                 // https://msdn.microsoft.com/en-us/library/windows/desktop/bb509631(v=vs.85).aspx
             }
         }
 
-        m_Tokens.push_back(NewToken);
+        if (NewTokenType != TokenType::SrtingConstant)
+            LiteralEnd = SrcPos;
+
+        const auto DelimSize   = static_cast<size_t>(DelimEnd - DelimStart);
+        const auto LiteralSize = static_cast<size_t>(LiteralEnd - LiteralStart);
+
+        auto* TokenText = TextPool.Allocate(DelimSize + 1 + LiteralSize + 1);
+        auto* Delimiter = TokenText;
+        auto* Literal   = TokenText + DelimSize + 1;
+        if (DelimSize != 0)
+            memcpy(Delimiter, &*DelimStart, DelimSize);
+        Delimiter[DelimSize] = '\0';
+        if (LiteralSize != 0)
+            memcpy(Literal, &*LiteralStart, LiteralSize);
+        Literal[LiteralSize] = '\0';
+
+        Tokens.emplace_back(NewTokenType,
+                            TokenString::MakeReference(Literal, LiteralSize),
+                            TokenString::MakeReference(Delimiter, DelimSize));
+
+        auto& NewToken = Tokens.back();
+        if (NewToken.Type == TokenType::Identifier)
+        {
+            auto KeywordIt = Converter.m_HLSLKeywords.find(NewToken.Literal.c_str());
+            if (KeywordIt != Converter.m_HLSLKeywords.end())
+            {
+                NewToken.Type = KeywordIt->second.Type;
+                VERIFY(NewToken.Literal == KeywordIt->second.Literal, "Inconsistent literal");
+            }
+        }
     }
 #undef CHECK_END
+
+    return static_cast<size_t>(TrailingDelimStart - Source.begin());
+}
+
+std::shared_ptr<const HLSL2GLSLConverterImpl::TokenizedSource> HLSL2GLSLConverterImpl::TokenizedSource::Join(std::vector<std::shared_ptr<const TokenizedSource>> Sources)
+{
+    // Every source is tokenized as if it started after a delimiter and ended before one.
+    // This is only true in the joined text if the last token of every source is followed
+    // by delimiters or comments that end in this source. Otherwise, the tokens may be
+    // different, for example '+' and '=' must be joined into '+=', or the comment may
+    // continue in the next source.
+    //
+    // The first token of every source except the first one also gets the delimiters
+    // that precede it in the joined text.
+    std::vector<String> FirstTokenDelimiters(Sources.size());
+
+    String PendingDelimiter;
+    bool   AtDelimiter  = true;
+    size_t TextPoolSize = 0;
+    for (size_t i = 0; i < Sources.size(); ++i)
+    {
+        const auto& Src = *Sources[i];
+        // Skip the empty node in the beginning of the list
+        const bool HasTokens = Src.Tokens.size() > 1;
+        // The last token or comment may continue in the text of this source
+        if (!AtDelimiter && (HasTokens || !Src.TrailingDelimiter.empty()))
+            return nullptr;
+
+        if (HasTokens)
+        {
+            if (!PendingDelimiter.empty())
+            {
+                const auto& FirstToken = *std::next(Src.Tokens.begin());
+
+                auto& Delimiter = FirstTokenDelimiters[i];
+                Delimiter       = std::move(PendingDelimiter);
+                Delimiter.append(FirstToken.Delimiter.data(), FirstToken.Delimiter.length());
+                TextPoolSize += Delimiter.length() + 1;
+            }
+
+            PendingDelimiter.clear();
+            AtDelimiter = !Src.TrailingDelimiter.empty();
+        }
+
+        PendingDelimiter.append(Src.TrailingDelimiter);
+        AtDelimiter = AtDelimiter && !EndsInsideComment(Src.TrailingDelimiter);
+    }
+
+    auto pJoined = std::make_shared<TokenizedSource>();
+    pJoined->TextPool.Reserve(TextPoolSize, GetRawAllocator());
+    // Push empty node in the beginning of the list to facilitate
+    // backwards searching
+    pJoined->Tokens.push_back(TokenInfo());
+    for (size_t i = 0; i < Sources.size(); ++i)
+    {
+        const auto& Src = *Sources[i];
+        if (Src.Tokens.size() <= 1)
+            continue;
+
+        // The copies reference the text of the source
+        auto FirstToken = pJoined->Tokens.insert(pJoined->Tokens.end(), std::next(Src.Tokens.begin()), Src.Tokens.end());
+
+        const auto& Delimiter = FirstTokenDelimiters[i];
+        if (!Delimiter.empty())
+            FirstToken->Delimiter = TokenString::MakeReference(pJoined->TextPool.CopyString(Delimiter), Delimiter.length());
+    }
+    pJoined->TrailingDelimiter = std::move(PendingDelimiter);
+    pJoined->JoinedSources     = std::move(Sources);
+
+    return pJoined;
 }
 
 
@@ -1515,7 +1700,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessStructuredBuffer(TokenList
     if (Token->Delimiter.empty())
         Token->Delimiter = " ";
 
-    m_Tokens.insert(OpenBraceToken, TokenInfo(TokenType::Identifier, Token->Literal.c_str(), " "));
+    m_Tokens.insert(OpenBraceToken, TokenInfo(TokenType::Identifier, Token->Literal, " "));
     //          OpenBraceToken
     //              V
     // buffer g_Data{DataType g_Data;
@@ -1553,8 +1738,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessStructuredBuffer(TokenList
     //                                 ^
     ++Token;
     String NameRedefine("#define ");
-    NameRedefine += GlobalVarNameToken->Literal + ' ' + GlobalVarNameToken->Literal + "_data\r\n";
-    m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, NameRedefine.c_str(), "\r\n"));
+    NameRedefine += GlobalVarNameToken->Literal;
+    NameRedefine += ' ';
+    NameRedefine += GlobalVarNameToken->Literal;
+    NameRedefine += "_data\r\n";
+    m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, NameRedefine, "\r\n"));
     GlobalVarNameToken->Literal.append("_data");
     // buffer g_Data{DataType g_Data_data[]};
     // #define g_Data g_Data_data
@@ -1676,7 +1864,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseSamplers(TokenListType::iter
                 const auto& SamplerName = Token->Literal;
 
                 // Add sampler state into the hash map
-                SamplersHash.insert(std::make_pair(SamplerName, bIsComparison));
+                SamplersHash.insert(std::make_pair(SamplerName.str(), bIsComparison));
 
                 ++Token;
                 // SamplerState LinearClamp ;
@@ -1905,13 +2093,13 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
         {
             // RWTexture2D<float /* format = r32f */ >
             //                                       ^
-            ParseImageFormat(Token->Delimiter, ImgFormat);
+            ParseImageFormat(Token->Delimiter.str(), ImgFormat);
             if (ImgFormat.length() == 0)
             {
                 // RWTexture2D</* format = r32f */ float >
                 //                                 ^
                 //                            TexFmtToken
-                ParseImageFormat(TexFmtToken->Delimiter, ImgFormat);
+                ParseImageFormat(TexFmtToken->Delimiter.str(), ImgFormat);
             }
 
             if (ImgFormat.length() != 0)
@@ -1996,7 +2184,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
         if (!IsRWTexture)
         {
             // Try to find matching sampler
-            auto SamplerName = TextureName + SamplerSuffix;
+            auto SamplerName = TextureName.str() + SamplerSuffix;
             // Search all scopes starting with the innermost
             for (auto ScopeIt = Samplers.rbegin(); ScopeIt != Samplers.rend(); ++ScopeIt)
             {
@@ -2030,7 +2218,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
                 TexDeclToken->Literal.append("IMAGE_WRITEONLY "); // defined as 'writeonly' on GLES and as '' on desktop in GLSLDefinitions.h
         }
         TexDeclToken->Literal.append(CompleteGLSLSampler);
-        Objects.m.insert(std::make_pair(HashMapStringKey(TextureName), HLSLObjectInfo(CompleteGLSLSampler, NumComponents)));
+        Objects.m.insert(std::make_pair(HashMapStringKey{TextureName.c_str(), true}, HLSLObjectInfo(CompleteGLSLSampler, NumComponents)));
 
         // In global scope, multiple variables can be declared in the same statement
         if (IsGlobalScope)
@@ -2103,11 +2291,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
 
 
 // Finds an HLSL object with the given name in object stack
-const HLSL2GLSLConverterImpl::HLSLObjectInfo* HLSL2GLSLConverterImpl::ConversionStream::FindHLSLObject(const String& Name)
+const HLSL2GLSLConverterImpl::HLSLObjectInfo* HLSL2GLSLConverterImpl::ConversionStream::FindHLSLObject(const Char* Name)
 {
     for (auto ScopeIt = m_Objects.rbegin(); ScopeIt != m_Objects.rend(); ++ScopeIt)
     {
-        auto It = ScopeIt->m.find(Name.c_str());
+        auto It = ScopeIt->m.find(Name);
         if (It != ScopeIt->m.end())
             return &It->second;
     }
@@ -2181,7 +2369,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
     // IdentifierToken
 
     // Try to find identifier
-    const auto* pObjectInfo = FindHLSLObject(IdentifierToken->Literal);
+    const auto* pObjectInfo = FindHLSLObject(IdentifierToken->Literal.c_str());
     if (pObjectInfo == nullptr)
     {
         return false;
@@ -2228,7 +2416,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
     // ^
     // IdentifierToken
 
-    m_Tokens.insert(IdentifierToken, TokenInfo(TokenType::Identifier, StubIt->second.Name.c_str(), IdentifierToken->Delimiter.c_str()));
+    m_Tokens.insert(IdentifierToken, TokenInfo(TokenType::Identifier, StubIt->second.Name, IdentifierToken->Delimiter));
     IdentifierToken->Delimiter = " ";
     // FunctionStub TestTextArr[2], TestTextArr_sampler, ...
     //              ^
@@ -2258,7 +2446,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
         //                                                            ^
         //                                                     ArgsListEndToken
 
-        auto SwizzleToken = m_Tokens.insert(ArgsListEndToken, TokenInfo(TokenType::TextBlock, StubIt->second.Swizzle.c_str(), ""));
+        auto SwizzleToken = m_Tokens.insert(ArgsListEndToken, TokenInfo(TokenType::TextBlock, StubIt->second.Swizzle, ""));
         SwizzleToken->Literal.push_back(static_cast<Char>('0' + pObjectInfo->NumComponents));
         // FunctionStub( TestTextArr[2], TestTextArr_sampler, ...    )_SWIZZLE4;
         //                                                                     ^
@@ -2439,7 +2627,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessRWTextureStore(TokenListTy
     // ^                                             ^
     // Token                                    SemicolonToken
 
-    m_Tokens.insert(Token, TokenInfo(TokenType::Identifier, "imageStore", Token->Delimiter.c_str()));
+    m_Tokens.insert(Token, TokenInfo(TokenType::Identifier, "imageStore", Token->Delimiter));
     m_Tokens.insert(Token, TokenInfo(TokenType::OpenBracket, "(", ""));
     Token->Delimiter = " ";
     // imageStore( RWTex[Location.x] = float4(0.0, 0.0, 0.0, 1.0);
@@ -2503,7 +2691,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessRWTextures(const TokenList
         if (Token->Type == TokenType::Identifier)
         {
             // Try to find the object in all scopes
-            const auto* pObjectInfo = FindHLSLObject(Token->Literal);
+            const auto* pObjectInfo = FindHLSLObject(Token->Literal.c_str());
             if (pObjectInfo == nullptr)
             {
                 ++Token;
@@ -2567,7 +2755,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessAtomics(const TokenListTyp
             ++Token;
             VERIFY_PARSER_STATE(Token, Token != ScopeEnd, "Unexpected EOF");
 
-            const auto* pObjectInfo = FindHLSLObject(Token->Literal);
+            const auto* pObjectInfo = FindHLSLObject(Token->Literal.c_str());
             if (pObjectInfo != nullptr)
             {
                 // InterlockedAdd(Tex2D[GTid.xy], 1, iOldVal);
@@ -2641,14 +2829,14 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
     VERIFY_PARSER_STATE(Token, Token->IsBuiltInType() || Token->Type == TokenType::Identifier,
                         "Missing argument type");
     auto TypeToken = Token;
-    ParamInfo.Type = Token->Literal;
+    ParamInfo.Type = Token->Literal.str();
 
     ++Token;
     //          out float4 Color : SV_Target,
     //                     ^
     VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected EOF while parsing argument list");
     VERIFY_PARSER_STATE(Token, Token->Type == TokenType::Identifier, "Missing argument name after ", ParamInfo.Type);
-    ParamInfo.Name = Token->Literal;
+    ParamInfo.Name = Token->Literal.str();
 
     ++Token;
     VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected EOF");
@@ -2660,8 +2848,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
         ProcessScope(
             Token, m_Tokens.end(), TokenType::OpenStaple, TokenType::ClosingStaple,
             [&](TokenListType::iterator& tkn, int) {
-                ParamInfo.ArraySize.append(tkn->Delimiter);
-                ParamInfo.ArraySize.append(tkn->Literal);
+                ParamInfo.ArraySize += tkn->Delimiter;
+                ParamInfo.ArraySize += tkn->Literal;
                 ++tkn;
             } //
         );
@@ -2689,7 +2877,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
             VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected end of file while looking for semantic for argument \"", ParamInfo.Name, '\"');
             VERIFY_PARSER_STATE(Token, Token->Type == TokenType::Identifier, "Missing semantic for argument \"", ParamInfo.Name, '\"');
             // Transform to lower case -  semantics are case-insensitive
-            ParamInfo.Semantic = StrToLower(Token->Literal);
+            ParamInfo.Semantic = StrToLower(Token->Literal.str());
 
             ++Token;
             //          out float4 Color : SV_Target,
@@ -2753,8 +2941,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters(TokenLi
     if (!bIsVoid)
     {
         ShaderParameterInfo RetParam;
-        RetParam.Type             = TypeToken->Literal;
-        RetParam.Name             = FuncNameToken->Literal;
+        RetParam.Type             = TypeToken->Literal.str();
+        RetParam.Name             = FuncNameToken->Literal.str();
         RetParam.storageQualifier = ShaderParameterInfo::StorageQualifier::Ret;
         Params.push_back(RetParam);
     }
@@ -2928,7 +3116,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters(TokenLi
                     //                                   ^
                     VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::NumericConstant, "Numeric constant expected");
 
-                    ParamInfo.ArraySize     = TmpToken->Literal;
+                    ParamInfo.ArraySize     = TmpToken->Literal.str();
                     auto NumCtrlPointsToken = TmpToken;
                     ++TmpToken;
                     VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Literal == ">", "Angle bracket expected");
@@ -2978,7 +3166,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters(TokenLi
             VERIFY_PARSER_STATE(SemanticToken, SemanticToken != m_Tokens.end(), "Unexpected EOF");
             VERIFY_PARSER_STATE(SemanticToken, SemanticToken->Type == TokenType::Identifier, "Exepcted semantic for the return argument ");
             // Transform to lower case -  semantics are case-insensitive
-            RetParam.Semantic = StrToLower(SemanticToken->Literal);
+            RetParam.Semantic = StrToLower(SemanticToken->Literal.str());
             ++SemanticToken;
             // float4 TestPS  ( in VSOutput In ) : SV_Target
             // {
@@ -3598,7 +3786,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessHullShaderConstantFunction
                 Argument.push_back('[');
                 Argument.append(TopLevelParam.ArraySize);
                 Argument.push_back(']');
-                m_Tokens.insert(ArgsListEndToken, TokenInfo(TokenType::TextBlock, Argument.c_str()));
+                m_Tokens.insert(ArgsListEndToken, TokenInfo(TokenType::TextBlock, Argument));
             }
             else
             {
@@ -3641,7 +3829,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessHullShaderConstantFunction
         }
     }
     ReturnHandlerSS << "return;}\n";
-    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, ReturnHandlerSS.str().c_str(), TypeToken->Delimiter.c_str()));
+    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, ReturnHandlerSS.str(), TypeToken->Delimiter));
     TypeToken->Delimiter = "\n";
 
     String Prologue = PrologueSS.str();
@@ -3659,7 +3847,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessHullShaderConstantFunction
     VERIFY_PARSER_STATE(FirstStatementToken, FirstStatementToken != m_Tokens.end(), "Unexpected end of file while looking for the body of \"", EntryPoint, "\".");
 
     // Insert prologue before the first token
-    m_Tokens.insert(FirstStatementToken, TokenInfo(TokenType::TextBlock, Prologue.c_str(), "\n"));
+    m_Tokens.insert(FirstStatementToken, TokenInfo(TokenType::TextBlock, Prologue, "\n"));
 
     ProcessReturnStatements(Token, bIsVoid, EntryPoint, ReturnMacroName);
 }
@@ -3691,7 +3879,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderAttributes(TokenList
         VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::Identifier, "Identifier expected");
         // [domain("quad")]
         //  ^
-        auto& Attrib = TmpToken->Literal;
+        auto Attrib = TmpToken->Literal.str();
         StrToLowerInPlace(Attrib);
 
         ++TmpToken;
@@ -3701,8 +3889,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderAttributes(TokenList
             TmpToken, m_Tokens.end(), TokenType::OpenBracket, TokenType::ClosingBracket,
             [&](TokenListType::iterator& tkn, int) //
             {
-                AttribValue.append(tkn->Delimiter);
-                AttribValue.append(tkn->Literal);
+                AttribValue += tkn->Delimiter;
+                AttribValue += tkn->Literal;
                 ++tkn;
             } //
         );
@@ -4008,7 +4196,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessDomainShaderArguments(Toke
     // ^
 
     std::unordered_map<HashMapStringKey, String, HashMapStringKey::Hasher> Attributes;
-    ParseAttributesInComment(TypeToken->Delimiter, Attributes);
+    ParseAttributesInComment(TypeToken->Delimiter.str(), Attributes);
     ProcessShaderAttributes(Token, Attributes);
 
     stringstream GlobalsSS;
@@ -4226,7 +4414,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessReturnStatements(TokenList
     if (IsVoid)
     {
         // Insert return handler before the closing brace
-        m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, MacroName, Token->Delimiter.c_str()));
+        m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, MacroName, Token->Delimiter));
         Token->Delimiter = "\n";
         // void main ()
         // {
@@ -4345,8 +4533,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderDeclaration(TokenLis
     // TypeToken
 
     // Insert global variables & return handler before the function
-    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, GlobalVariables.c_str(), TypeToken->Delimiter.c_str()));
-    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, ReturnHandlerSS.str().c_str(), "\n"));
+    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, GlobalVariables, TypeToken->Delimiter));
+    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, ReturnHandlerSS.str(), "\n"));
     TypeToken->Delimiter = "\n";
     auto BodyStartToken  = ArgsListEndToken;
     while (BodyStartToken != m_Tokens.end() && BodyStartToken->Type != TokenType::OpenBrace)
@@ -4364,7 +4552,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderDeclaration(TokenLis
     VERIFY_PARSER_STATE(FirstStatementToken, FirstStatementToken != m_Tokens.end(), "Unexpected end of file while looking for the body of shader entry point \"", EntryPoint, "\".");
 
     // Insert prologue before the first token
-    m_Tokens.insert(FirstStatementToken, TokenInfo(TokenType::TextBlock, Prologue.c_str(), "\n"));
+    m_Tokens.insert(FirstStatementToken, TokenInfo(TokenType::TextBlock, Prologue, "\n"));
 
     auto BodyEndToken = BodyStartToken;
     if (ShaderType == SHADER_TYPE_VERTEX || ShaderType == SHADER_TYPE_HULL || ShaderType == SHADER_TYPE_DOMAIN || ShaderType == SHADER_TYPE_PIXEL)
@@ -4548,7 +4736,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::RemoveSpecialShaderAttributes()
                 // void CS(uint3 ThreadId  : SV_DispatchThreadID)
                 // ^
                 if (Token != m_Tokens.end())
-                    Token->Delimiter = OpenStaple->Delimiter + Token->Delimiter;
+                {
+                    auto Delimiter = OpenStaple->Delimiter.str();
+                    Delimiter += Token->Delimiter;
+                    Token->Delimiter = Delimiter;
+                }
                 m_Tokens.erase(OpenStaple, Token);
             }
             else
@@ -4562,8 +4754,8 @@ String HLSL2GLSLConverterImpl::ConversionStream::BuildGLSLSource()
     String Output;
     for (const auto& Token : m_Tokens)
     {
-        Output.append(Token.Delimiter);
-        Output.append(Token.Literal);
+        Output += Token.Delimiter;
+        Output += Token.Literal;
     }
     return Output;
 }
@@ -4576,9 +4768,11 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
                                                            size_t                           NumSymbols,
                                                            bool                             bPreserveTokens) :
     // clang-format off
-    TBase            {pRefCounters   },
-    m_bPreserveTokens{bPreserveTokens},
-    m_Converter      {Converter      },
+    TBase            {pRefCounters      },
+    m_TokenNodePool  {GetRawAllocator() },
+    m_Tokens         {TokenListAllocator<TokenInfo>{&m_TokenNodePool}},
+    m_bPreserveTokens{bPreserveTokens   },
+    m_Converter      {Converter         },
     m_InputFileName  {InputFileName != nullptr ? InputFileName : "<Unknown>"}
 // clang-format on
 {
@@ -4602,11 +4796,33 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
         NumSymbols = pFileData->GetSize();
     }
 
-    String Source(HLSLSource, NumSymbols);
+    // Only include files are cached, so the hash of the file is not needed
+    String FileText(HLSLSource, NumSymbols);
+    auto   pFile = std::make_shared<const SourceFile>(std::move(FileText), 0);
 
-    InsertIncludes(Source, pInputStreamFactory);
+    String Source;
+    Source.reserve(NumSymbols);
+    // Put all the includes into the set to avoid multiple inclusion
+    std::unordered_set<String> ProcessedIncludes;
+    ExpandIncludes(pFile, pInputStreamFactory, ProcessedIncludes, Source);
 
-    Tokenize(Source);
+    // Tokenization is deferred until the first conversion that is not found in the cache
+    m_pSource = m_Converter.GetSourceCacheEntry(std::move(Source));
+}
+
+HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*     pRefCounters,
+                                                           const ConversionStream& Parent) :
+    // clang-format off
+    TBase                        {pRefCounters                          },
+    m_pSource                    {Parent.m_pSource                      },
+    m_TokenNodePool              {GetRawAllocator()                     },
+    m_Tokens                     {TokenListAllocator<TokenInfo>{&m_TokenNodePool}},
+    m_bPreserveTokens            {false                                 },
+    m_bUseInOutLocationQualifiers{Parent.m_bUseInOutLocationQualifiers  },
+    m_Converter                  {Parent.m_Converter                    },
+    m_InputFileName              {Parent.m_InputFileName                }
+// clang-format on
+{
 }
 
 
@@ -4667,6 +4883,186 @@ void HLSL2GLSLConverterImpl::CreateStream(const Char*                      Input
     }
 }
 
+std::shared_ptr<const HLSL2GLSLConverterImpl::SourceFile> HLSL2GLSLConverterImpl::LoadIncludeFile(IShaderSourceInputStreamFactory* pSourceStreamFactory, const String& IncludeName) const
+{
+    if (pSourceStreamFactory == nullptr)
+        LOG_ERROR_AND_THROW("Input stream factory must not be null to load include file ", IncludeName);
+
+    // The file is always read from the factory, so that modified files are picked up.
+    // The parsed file and its tokens are reused while the file content is unchanged.
+    RefCntAutoPtr<IFileStream> pIncludeDataStream;
+    pSourceStreamFactory->CreateInputStream(IncludeName.c_str(), &pIncludeDataStream);
+    if (!pIncludeDataStream)
+        LOG_ERROR_AND_THROW("Failed to open include file ", IncludeName);
+    RefCntAutoPtr<IDataBlob> pIncludeData(MakeNewRCObj<DataBlobImpl>()(0));
+    pIncludeDataStream->ReadBlob(pIncludeData);
+
+    String     Text{reinterpret_cast<const Char*>(pIncludeData->GetDataPtr()), pIncludeData->GetSize()};
+    const auto Hash = std::hash<String>{}(Text);
+    {
+        std::lock_guard<std::mutex> Lock{m_CacheMtx};
+
+        auto It = m_IncludeCache.find(IncludeName);
+        if (It != m_IncludeCache.end() && It->second->Hash == Hash && It->second->Text == Text)
+            return It->second;
+    }
+
+    // Parse the file outside of the lock
+    auto pFile = std::make_shared<const SourceFile>(std::move(Text), Hash);
+
+    std::lock_guard<std::mutex> Lock{m_CacheMtx};
+    // Streams that use the previous version of the file keep it alive
+    m_IncludeCache[IncludeName] = pFile;
+
+    return pFile;
+}
+
+std::shared_ptr<HLSL2GLSLConverterImpl::SourceCacheEntry> HLSL2GLSLConverterImpl::GetSourceCacheEntry(String&& Source) const
+{
+    SourceKey Key{&Source, std::hash<String>{}(Source)};
+
+    std::lock_guard<std::mutex> Lock{m_CacheMtx};
+
+    auto It = m_SourceCache.find(Key);
+    if (It != m_SourceCache.end())
+    {
+        // Move the entry to the front of the LRU list
+        m_SourceLRU.splice(m_SourceLRU.begin(), m_SourceLRU, It->second);
+        return *It->second;
+    }
+
+    auto pEntry      = std::make_shared<SourceCacheEntry>(std::move(Source), Key.Hash);
+    pEntry->DataSize = pEntry->Source.length();
+    pEntry->IsCached = true;
+    Key.pSource      = &pEntry->Source;
+
+    m_SourceLRU.emplace_front(pEntry);
+    m_SourceCache.emplace(Key, m_SourceLRU.begin());
+    m_CachedDataSize += pEntry->DataSize;
+
+    EvictSourceCacheEntries(pEntry.get());
+
+    return pEntry;
+}
+
+void HLSL2GLSLConverterImpl::EvictSourceCacheEntries(const SourceCacheEntry* pKeepEntry) const
+{
+    // Streams keep their entries alive, so any entry can be safely evicted at any time.
+    // The entry that is currently being used is never evicted.
+    while (m_CachedDataSize > MaxCachedDataSize && !m_SourceLRU.empty() && m_SourceLRU.back().get() != pKeepEntry)
+    {
+        auto& Entry = *m_SourceLRU.back();
+        VERIFY_EXPR(Entry.IsCached && m_CachedDataSize >= Entry.DataSize);
+        m_CachedDataSize -= Entry.DataSize;
+        Entry.IsCached = false;
+        m_SourceCache.erase(SourceKey{&Entry.Source, Entry.Hash});
+        m_SourceLRU.pop_back();
+    }
+}
+
+std::shared_ptr<const HLSL2GLSLConverterImpl::TokenizedSource> HLSL2GLSLConverterImpl::GetChunkTokens(const SourceChunk& Chunk) const
+{
+    const auto& File = *Chunk.pFile;
+    {
+        std::lock_guard<std::mutex> Lock{m_CacheMtx};
+        if (auto pTokens = File.ChunkTokens[Chunk.Index])
+            return pTokens;
+    }
+
+    // Tokenize the chunk outside of the lock. If another thread tokenizes the same
+    // chunk at the same time, the first result is shared and the other one is discarded.
+    std::shared_ptr<const TokenizedSource> pNewTokens = std::make_shared<TokenizedSource>(*this, File.Chunks[Chunk.Index]);
+
+    std::lock_guard<std::mutex> Lock{m_CacheMtx};
+    auto&                       pTokens = File.ChunkTokens[Chunk.Index];
+    if (!pTokens)
+        pTokens = std::move(pNewTokens);
+
+    return pTokens;
+}
+
+std::shared_ptr<const HLSL2GLSLConverterImpl::TokenizedSource> HLSL2GLSLConverterImpl::GetTokenizedSource(SourceCacheEntry& Entry, const std::vector<SourceChunk>& Chunks) const
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_CacheMtx};
+        if (auto pTokens = Entry.wpTokens.lock())
+            return pTokens;
+    }
+
+    // Tokenize the source outside of the lock. If another thread tokenizes the same
+    // source at the same time, the first result is shared and the other one is discarded.
+    std::shared_ptr<const TokenizedSource> pNewTokens;
+    if (Chunks.size() > 1)
+    {
+        // Include files are only tokenized once and their tokens are shared by all sources
+        // that include them
+        std::vector<std::shared_ptr<const TokenizedSource>> ChunkTokens;
+        ChunkTokens.reserve(Chunks.size());
+        for (const auto& Chunk : Chunks)
+            ChunkTokens.emplace_back(GetChunkTokens(Chunk));
+        pNewTokens = TokenizedSource::Join(std::move(ChunkTokens));
+    }
+    if (!pNewTokens)
+        pNewTokens = std::make_shared<TokenizedSource>(*this, Entry.Source);
+
+    std::lock_guard<std::mutex> Lock{m_CacheMtx};
+    if (auto pTokens = Entry.wpTokens.lock())
+        return pTokens;
+
+    Entry.wpTokens = pNewTokens;
+    return pNewTokens;
+}
+
+bool HLSL2GLSLConverterImpl::FindConvertedShader(SourceCacheEntry& Entry, const ConvertedShaderKey& Key, String& GLSLSource) const
+{
+    std::lock_guard<std::mutex> Lock{m_CacheMtx};
+
+    auto It = Entry.ConvertedShaders.find(Key);
+    if (It == Entry.ConvertedShaders.end())
+        return false;
+
+    GLSLSource = It->second;
+    return true;
+}
+
+void HLSL2GLSLConverterImpl::AddConvertedShader(SourceCacheEntry& Entry, ConvertedShaderKey&& Key, const String& GLSLSource) const
+{
+    std::lock_guard<std::mutex> Lock{m_CacheMtx};
+
+    // The entry may have been evicted while the shader was being converted. It is still
+    // updated as the stream that owns it may convert the same shader again.
+    auto Inserted = Entry.ConvertedShaders.emplace(std::move(Key), GLSLSource);
+    if (!Inserted.second || !Entry.IsCached)
+        return;
+
+    Entry.DataSize += GLSLSource.length();
+    m_CachedDataSize += GLSLSource.length();
+
+    EvictSourceCacheEntries(&Entry);
+}
+
+ThreadingTools::ThreadPool& HLSL2GLSLConverterImpl::GetConversionPool() const
+{
+    std::call_once(m_ConversionPoolFlag, [this]() {
+        const auto NumCores   = std::max(std::thread::hardware_concurrency(), 1u);
+        const auto NumThreads = std::max(NumCores - 1, 1u);
+        m_pConversionPool.reset(new ThreadingTools::ThreadPool{NumThreads});
+    });
+    return *m_pConversionPool;
+}
+
+void HLSL2GLSLConverterImpl::ClearCache() const
+{
+    std::lock_guard<std::mutex> Lock{m_CacheMtx};
+
+    for (auto& pEntry : m_SourceLRU)
+        pEntry->IsCached = false;
+    m_SourceCache.clear();
+    m_SourceLRU.clear();
+    m_CachedDataSize = 0;
+    m_IncludeCache.clear();
+}
+
 void HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
                                                        SHADER_TYPE ShaderType,
                                                        bool        IncludeDefintions,
@@ -4686,14 +5082,298 @@ void HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
     }
 }
 
+void HLSL2GLSLConverterImpl::ConversionStream::ResetTokens()
+{
+    // Every conversion modifies the tokens, so it starts from the original token list
+    m_Tokens.clear();
+    // Sources with includes are assembled from the shared tokens of the include files
+    if (m_bPreserveTokens || m_SourceChunks.size() > 1)
+    {
+        if (!m_pTokenizedSource)
+            m_pTokenizedSource = m_Converter.GetTokenizedSource(*m_pSource, m_SourceChunks);
+
+        // The copies reference the text of the shared tokenized source
+        m_Tokens.assign(m_pTokenizedSource->Tokens.begin(), m_pTokenizedSource->Tokens.end());
+    }
+    else
+    {
+        TokenizedSource::Tokenize(m_Converter, m_pSource->Source, m_TokenTextPool, m_Tokens);
+    }
+    m_StructDefinitions.clear();
+    m_Objects.clear();
+}
+
 String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
                                                          SHADER_TYPE ShaderType,
                                                          bool        IncludeDefintions,
                                                          const char* SamplerSuffix,
                                                          bool        UseInOutLocationQualifiers)
+{
+    ConvertedShaderKey Key{
+        EntryPoint != nullptr ? EntryPoint : "",
+        ShaderType,
+        SamplerSuffix != nullptr ? SamplerSuffix : "",
+        IncludeDefintions,
+        UseInOutLocationQualifiers //
+    };
+
+    String GLSLSource;
+    if (m_Converter.FindConvertedShader(*m_pSource, Key, GLSLSource))
+        return GLSLSource;
+
+    ResetTokens();
+
+    GLSLSource = ConvertTokens(EntryPoint, ShaderType, IncludeDefintions, SamplerSuffix, UseInOutLocationQualifiers);
+
+    m_Tokens.clear();
+    m_StructDefinitions.clear();
+    m_Objects.clear();
+
+    m_Converter.AddConvertedShader(*m_pSource, std::move(Key), GLSLSource);
+
+    return GLSLSource;
+}
+
+void HLSL2GLSLConverterImpl::ConversionStream::ConvertMultiple(const HLSL2GLSLEntryPointInfo* pEntryPoints,
+                                                               Uint32                         NumEntryPoints,
+                                                               bool                           IncludeDefintions,
+                                                               const char*                    SamplerSuffix,
+                                                               bool                           UseInOutLocationQualifiers,
+                                                               Uint32                         NumThreads,
+                                                               IDataBlob**                    ppGLSLSources)
+{
+    DEV_CHECK_ERR(NumEntryPoints == 0 || (pEntryPoints != nullptr && ppGLSLSources != nullptr), "pEntryPoints and ppGLSLSources must not be null");
+    if (NumEntryPoints == 0 || pEntryPoints == nullptr || ppGLSLSources == nullptr)
+        return;
+
+    std::vector<ConvertedShaderKey> Keys;
+    Keys.reserve(NumEntryPoints);
+    std::vector<String> GLSLSources(NumEntryPoints);
+    // Indices of the entry points that are not found in the cache
+    std::vector<Uint32> PendingEntryPoints;
+    for (Uint32 i = 0; i < NumEntryPoints; ++i)
+    {
+        const auto& EntryPoint = pEntryPoints[i];
+        Keys.emplace_back(ConvertedShaderKey{
+            EntryPoint.EntryPoint != nullptr ? EntryPoint.EntryPoint : "",
+            EntryPoint.ShaderType,
+            SamplerSuffix != nullptr ? SamplerSuffix : "",
+            IncludeDefintions,
+            UseInOutLocationQualifiers //
+        });
+        if (!m_Converter.FindConvertedShader(*m_pSource, Keys[i], GLSLSources[i]))
+            PendingEntryPoints.push_back(i);
+        ppGLSLSources[i] = nullptr;
+    }
+
+    std::vector<Uint8> Converted(NumEntryPoints, 1);
+    std::vector<Uint8> FoundInCache(NumEntryPoints, 1);
+    if (!PendingEntryPoints.empty())
+    {
+        for (auto i : PendingEntryPoints)
+            Converted[i] = FoundInCache[i] = 0;
+
+        try
+        {
+            ResetTokens();
+            m_bUseInOutLocationQualifiers = UseInOutLocationQualifiers;
+
+            std::vector<const Char*> EntryPointNames;
+            EntryPointNames.reserve(PendingEntryPoints.size());
+            for (auto i : PendingEntryPoints)
+                EntryPointNames.push_back(pEntryPoints[i].EntryPoint);
+
+            std::vector<TokenListType::iterator> EntryPointTokens;
+            ProcessCommonTokens(SamplerSuffix, EntryPointNames.data(), EntryPointNames.size(), EntryPointTokens);
+
+            // Every entry point is converted from its own copy of the processed tokens. Find positions
+            // of the tokens that reference structure definitions and entry points to locate them in the copies.
+            static constexpr size_t InvalidIdx = ~size_t{0};
+
+            std::vector<size_t> StructDefIndices;
+            std::vector<size_t> EntryPointIndices(EntryPointTokens.size(), InvalidIdx);
+            {
+                std::unordered_multimap<const TokenInfo*, size_t> EntryPointSlots;
+                for (size_t i = 0; i < EntryPointTokens.size(); ++i)
+                {
+                    if (EntryPointTokens[i] != m_Tokens.end())
+                        EntryPointSlots.emplace(&*EntryPointTokens[i], i);
+                }
+                std::unordered_set<const TokenInfo*> StructDefTokens;
+                for (const auto& StructDef : m_StructDefinitions)
+                    StructDefTokens.insert(&*StructDef.second);
+
+                size_t Idx = 0;
+                for (auto Token = m_Tokens.begin(); Token != m_Tokens.end(); ++Token, ++Idx)
+                {
+                    if (StructDefTokens.find(&*Token) != StructDefTokens.end())
+                        StructDefIndices.push_back(Idx);
+
+                    // The same function may be requested more than once
+                    auto Slots = EntryPointSlots.equal_range(&*Token);
+                    for (auto Slot = Slots.first; Slot != Slots.second; ++Slot)
+                        EntryPointIndices[Slot->second] = Idx;
+                }
+            }
+
+            // Every thread, including the calling one, picks the next entry point from the shared
+            // counter until all entry points have been claimed. The state is shared with the pool
+            // tasks, which may start after this function returns.
+            struct BatchState
+            {
+                explicit BatchState(size_t _NumEntryPoints) :
+                    NumEntryPoints{_NumEntryPoints}
+                {}
+
+                const size_t            NumEntryPoints;
+                std::atomic<size_t>     NextEntryPoint{0};
+                size_t                  NumCompleted = 0;
+                std::mutex              Mtx;
+                std::condition_variable CompletedCV;
+            };
+            auto pState = std::make_shared<BatchState>(PendingEntryPoints.size());
+
+            // The worker only accesses the local variables after it has claimed an entry point.
+            // The calling thread waits until all claimed entry points have been converted.
+            auto ConvertEntryPointsWorker = [&](BatchState& State) //
+            {
+                for (size_t i = State.NextEntryPoint.fetch_add(1); i < State.NumEntryPoints; i = State.NextEntryPoint.fetch_add(1))
+                {
+                    const auto  EntryPointIdx  = PendingEntryPoints[i];
+                    const auto& EntryPoint     = pEntryPoints[EntryPointIdx];
+                    const auto* EntryPointName = EntryPoint.EntryPoint != nullptr ? EntryPoint.EntryPoint : "<null>";
+                    try
+                    {
+                        if (EntryPointIndices[i] == InvalidIdx)
+                            LOG_ERROR_AND_THROW("Unable to find shader entry point \"", EntryPointName, '\"');
+
+                        ConversionStream Worker{nullptr, *this};
+
+                        auto EntryPointToken = Worker.CopyCommonTokens(*this, StructDefIndices, EntryPointIndices[i]);
+
+                        GLSLSources[EntryPointIdx] = Worker.ProcessEntryPoint(EntryPointToken, EntryPoint.ShaderType, IncludeDefintions);
+                        Converted[EntryPointIdx]   = 1;
+                    }
+                    catch (const std::exception& err)
+                    {
+                        LOG_ERROR_MESSAGE("Failed to convert shader entry point \"", EntryPointName, "\": ", err.what());
+                    }
+                    catch (...)
+                    {
+                        LOG_ERROR_MESSAGE("Failed to convert shader entry point \"", EntryPointName, "\": unknown error");
+                    }
+
+                    std::lock_guard<std::mutex> Lock{State.Mtx};
+                    if (++State.NumCompleted == State.NumEntryPoints)
+                        State.CompletedCV.notify_one();
+                }
+            };
+
+            if (NumThreads > 1 && PendingEntryPoints.size() > 1)
+            {
+                auto&      Pool     = m_Converter.GetConversionPool();
+                const auto NumTasks = std::min({static_cast<size_t>(NumThreads - 1), PendingEntryPoints.size() - 1, static_cast<size_t>(Pool.GetNumThreads())});
+                try
+                {
+                    for (size_t i = 0; i < NumTasks; ++i)
+                    {
+                        Pool.EnqueueTask([ConvertEntryPointsWorker, pState]() {
+                            ConvertEntryPointsWorker(*pState);
+                        });
+                    }
+                }
+                catch (const std::exception& err)
+                {
+                    // The entry points that are not claimed by the enqueued tasks are converted by the calling thread
+                    LOG_WARNING_MESSAGE("Failed to enqueue HLSL to GLSL conversion task: ", err.what());
+                }
+            }
+
+            ConvertEntryPointsWorker(*pState);
+
+            // The calling thread never waits for the tasks that have not started, so the method
+            // does not deadlock when all pool threads are busy.
+            std::unique_lock<std::mutex> Lock{pState->Mtx};
+            pState->CompletedCV.wait(Lock, [&]() { return pState->NumCompleted == pState->NumEntryPoints; });
+        }
+        catch (const std::exception& err)
+        {
+            LOG_ERROR_MESSAGE("Failed to process shader source for conversion: ", err.what());
+        }
+        catch (...)
+        {
+            LOG_ERROR_MESSAGE("Failed to process shader source for conversion: unknown error");
+        }
+
+        m_Tokens.clear();
+        m_StructDefinitions.clear();
+        m_Objects.clear();
+    }
+
+    for (Uint32 i = 0; i < NumEntryPoints; ++i)
+    {
+        if (!Converted[i])
+            continue;
+
+        if (!FoundInCache[i])
+            m_Converter.AddConvertedShader(*m_pSource, std::move(Keys[i]), GLSLSources[i]);
+
+        StringDataBlobImpl* pDataBlob = MakeNewRCObj<StringDataBlobImpl>()(std::move(GLSLSources[i]));
+        pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(&ppGLSLSources[i]));
+    }
+}
+
+HLSL2GLSLConverterImpl::TokenListType::iterator HLSL2GLSLConverterImpl::ConversionStream::CopyCommonTokens(const ConversionStream&    Parent,
+                                                                                                           const std::vector<size_t>& StructDefIndices,
+                                                                                                           size_t                     EntryPointIdx)
+{
+    VERIFY_EXPR(m_Tokens.empty() && m_StructDefinitions.empty());
+
+    auto   EntryPointToken = m_Tokens.end();
+    auto   NextStructDef   = StructDefIndices.begin();
+    size_t Idx             = 0;
+    for (const auto& ParentToken : Parent.m_Tokens)
+    {
+        auto Token = m_Tokens.insert(m_Tokens.end(), ParentToken);
+        if (NextStructDef != StructDefIndices.end() && *NextStructDef == Idx)
+        {
+            // struct VSOutput
+            //        ^
+            m_StructDefinitions.insert(std::make_pair(Token->Literal.c_str(), Token));
+            ++NextStructDef;
+        }
+        if (Idx == EntryPointIdx)
+            EntryPointToken = Token;
+        ++Idx;
+    }
+    VERIFY_EXPR(NextStructDef == StructDefIndices.end());
+
+    return EntryPointToken;
+}
+
+String HLSL2GLSLConverterImpl::ConversionStream::ConvertTokens(const Char* EntryPoint,
+                                                               SHADER_TYPE ShaderType,
+                                                               bool        IncludeDefintions,
+                                                               const char* SamplerSuffix,
+                                                               bool        UseInOutLocationQualifiers)
 {
     m_bUseInOutLocationQualifiers = UseInOutLocationQualifiers;
-    TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType());
+
+    std::vector<TokenListType::iterator> EntryPointTokens;
+    ProcessCommonTokens(SamplerSuffix, &EntryPoint, 1, EntryPointTokens);
+
+    auto ShaderEntryPointToken = EntryPointTokens[0];
+    VERIFY_PARSER_STATE(ShaderEntryPointToken, ShaderEntryPointToken != m_Tokens.end(), "Unable to find shader entry point \"", EntryPoint, '\"');
+
+    return ProcessEntryPoint(ShaderEntryPointToken, ShaderType, IncludeDefintions);
+}
+
+void HLSL2GLSLConverterImpl::ConversionStream::ProcessCommonTokens(const char*                           SamplerSuffix,
+                                                                   const Char* const*                    EntryPoints,
+                                                                   size_t                                NumEntryPoints,
+                                                                   std::vector<TokenListType::iterator>& EntryPointTokens)
+{
+    EntryPointTokens.assign(NumEntryPoints, m_Tokens.end());
 
     Uint32 ShaderStorageBlockBinding = 0;
     Uint32 ImageBinding              = 0;
@@ -4745,8 +5425,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
         }
     }
 
-    auto ShaderEntryPointToken = m_Tokens.end();
-    // Process textures and search for the shader entry point.
+    // Process textures and search for the shader entry points.
     // GLSL does not allow local variables of sampler type, so the
     // only two scopes where textures can be declared are global scope
     // and a function argument list.
@@ -4791,8 +5470,11 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
                 if ((ReturnTypeToken->IsBuiltInType() || ReturnTypeToken->Type == TokenType::Identifier) &&
                     OpenParenToken->Type == TokenType::OpenBracket)
                 {
-                    if (Token->Literal == EntryPoint)
-                        ShaderEntryPointToken = Token;
+                    for (size_t i = 0; i < NumEntryPoints; ++i)
+                    {
+                        if (Token->Literal == EntryPoints[i])
+                            EntryPointTokens[i] = Token;
+                    }
 
                     Token = OpenParenToken;
                     // float4 Func ( in float2 f2UV,
@@ -4909,9 +5591,13 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
                 ++Token;
         }
     }
-    VERIFY_PARSER_STATE(ShaderEntryPointToken, ShaderEntryPointToken != m_Tokens.end(), "Unable to find shader entry point \"", EntryPoint, '\"');
+}
 
-    ProcessShaderDeclaration(ShaderEntryPointToken, ShaderType);
+String HLSL2GLSLConverterImpl::ConversionStream::ProcessEntryPoint(TokenListType::iterator EntryPointToken,
+                                                                   SHADER_TYPE             ShaderType,
+                                                                   bool                    IncludeDefintions)
+{
+    ProcessShaderDeclaration(EntryPointToken, ShaderType);
 
     RemoveSemantics();
 
@@ -4919,13 +5605,6 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
 
     auto GLSLSource = BuildGLSLSource();
 
-    if (m_bPreserveTokens)
-    {
-        m_Tokens.swap(TokensCopy);
-        m_StructDefinitions.clear();
-        m_Objects.clear();
-    }
-
     if (IncludeDefintions)
         GLSLSource.insert(0, g_GLSLDefinitions);
 
@@ -45,9 +45,14 @@ enum class SpirvVersion
     Vk120,         // SPIRV 1.4
 };
 
+/// Initializes the glslang process-wide state. Must be called before any other function
+/// in this namespace and must not run concurrently with compilation.
 void InitializeGlslang();
 void FinalizeGlslang();
 
+// After InitializeGlslang() has returned, GLSLtoSPIRV() and HLSLtoSPIRV() may be called
+// from multiple threads simultaneously: every call uses its own TShader and TProgram objects.
+
 std::vector<unsigned int> GLSLtoSPIRV(SHADER_TYPE                      ShaderType,
                                       const char*                      ShaderSource,
                                       int                              SourceCodeLen,
@@ -0,0 +1,119 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Lightweight SPIRV reflection that does not use SPIRV-Cross
+
+#include <string>
+#include <vector>
+
+#include "SPIRVShaderResources.hpp"
+
+namespace Diligent
+{
+
+/// Shader resources reflected from a SPIRV binary.
+
+/// The resources are listed in the order they are declared in the binary, which is
+/// the same order SPIRV-Cross reports them in. SPIRVShaderResources packs this data into
+/// its memory buffer, so both reflection methods produce identical objects.
+struct SPIRVReflectionData
+{
+    struct Resource
+    {
+        std::string                              Name;
+        SPIRVShaderResourceAttribs::ResourceType Type                          = SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes;
+        Uint16                                   ArraySize                     = 1;
+        RESOURCE_DIMENSION                       ResourceDim                   = RESOURCE_DIM_UNDEFINED;
+        bool                                     IsMS                          = false;
+        uint32_t                                 BindingDecorationOffset       = 0;
+        uint32_t                                 DescriptorSetDecorationOffset = 0;
+        Uint32                                   BufferStaticSize              = 0;
+        Uint32                                   BufferStride                  = 0;
+    };
+
+    struct StageInput
+    {
+        std::string Name;
+        std::string Semantic;
+        bool        HasSemantic              = false;
+        uint32_t    LocationDecorationOffset = 0;
+    };
+
+    // clang-format off
+    std::vector<Resource> UBs;
+    std::vector<Resource> SBs;
+    std::vector<Resource> Imgs;
+    std::vector<Resource> SmpldImgs;
+    std::vector<Resource> ACs;
+    std::vector<Resource> SepSmplrs;
+    std::vector<Resource> SepImgs;
+    std::vector<Resource> InptAtts;
+    std::vector<Resource> AccelStructs;
+    // clang-format on
+
+    std::vector<StageInput> StageInputs;
+
+    // Indicates if the shader was compiled from HLSL source.
+    bool IsHLSLSource = false;
+
+    // Indicates if the binary declares SPV_GOOGLE_hlsl_functionality1 extension
+    // that provides semantics of shader inputs.
+    bool HlslFunctionality1 = false;
+};
+
+/// Reflects shader resources by scanning the SPIRV word stream once, without building the IR of the module.
+
+/// \param [in]  spirv_binary - SPIRV binary.
+/// \param [in]  ShaderType   - Shader type that defines the execution model of the entry point.
+/// \param [out] EntryPoint   - Name of the entry point. The string is not modified if the function returns false.
+/// \param [out] Data         - Reflected resources.
+///
+/// \return     true if the binary was reflected successfully, and false if it is malformed,
+///             does not contain the entry point of the given type, or uses constructs that
+///             the scanner does not handle (decoration groups, multi-dimensional or
+///             specialization-sized resource arrays, multiple entry points of the same type,
+///             names that SPIRV-Cross would rename in a version-specific way, etc.).
+///             In the latter case, the resources should be reflected with SPIRV-Cross.
+bool ScanSPIRVResources(const std::vector<uint32_t>& spirv_binary,
+                        SHADER_TYPE                  ShaderType,
+                        std::string&                 EntryPoint,
+                        SPIRVReflectionData&         Data);
+
+/// Restores resource names lost when debug information was stripped from the SPIRV binary.
+
+/// \param [in]     Original - Reflection data of the original binary.
+/// \param [in,out] Stripped - Reflection data of the same binary with debug information stripped.
+///                            Resource names and the source language are copied from Original.
+///
+/// \return     true if the resources of both binaries match, and false otherwise.
+bool RestoreStrippedSPIRVNames(const SPIRVReflectionData& Original,
+                               SPIRVReflectionData&       Stripped);
+
+} // namespace Diligent
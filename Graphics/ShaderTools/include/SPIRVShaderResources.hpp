@@ -46,15 +46,11 @@
 #include "RefCntAutoPtr.hpp"
 #include "StringPool.hpp"
 
-namespace diligent_spirv_cross
-{
-class Compiler;
-struct Resource;
-} // namespace diligent_spirv_cross
-
 namespace Diligent
 {
 
+struct SPIRVReflectionData;
+
 // sizeof(SPIRVShaderResourceAttribs) == 32, msvc x64
 struct SPIRVShaderResourceAttribs
 {
@@ -101,13 +97,32 @@ public:
 
     // clang-format on
 
-    SPIRVShaderResourceAttribs(const diligent_spirv_cross::Compiler& Compiler,
-                               const diligent_spirv_cross::Resource& Res,
-                               const char*                           _Name,
-                               ResourceType                          _Type,
-                               Uint32                                _SamplerOrSepImgInd = InvalidSepSmplrOrImgInd,
-                               Uint32                                _BufferStaticSize   = 0,
-                               Uint32                                _BufferStride       = 0) noexcept;
+    SPIRVShaderResourceAttribs(const char*        _Name,
+                               ResourceType       _Type,
+                               Uint16             _ArraySize,
+                               RESOURCE_DIMENSION _ResourceDim,
+                               bool               _IsMS,
+                               Uint32             _SepSmplrOrImgInd,
+                               uint32_t           _BindingDecorationOffset,
+                               uint32_t           _DescriptorSetDecorationOffset,
+                               Uint32             _BufferStaticSize,
+                               Uint32             _BufferStride) noexcept :
+        // clang-format off
+        Name                          {_Name},
+        ArraySize                     {_ArraySize},
+        Type                          {_Type},
+        ResourceDim                   {static_cast<Uint8>(_ResourceDim)},
+        IsMS                          {_IsMS ? Uint8{1} : Uint8{0}},
+        SepSmplrOrImgInd              {_SepSmplrOrImgInd},
+        BindingDecorationOffset       {_BindingDecorationOffset},
+        DescriptorSetDecorationOffset {_DescriptorSetDecorationOffset},
+        BufferStaticSize              {_BufferStaticSize},
+        BufferStride                  {_BufferStride}
+    // clang-format on
+    {
+        VERIFY(_SepSmplrOrImgInd == InvalidSepSmplrOrImgInd || (_Type == ResourceType::SeparateSampler || _Type == ResourceType::SeparateImage),
+               "Only separate images or separate samplers can be assinged valid SepSmplrOrImgInd value");
+    }
 
     bool IsValidSepSamplerAssigned() const
     {
@@ -190,13 +205,38 @@ static_assert(sizeof(SPIRVShaderStageInputAttribs) % sizeof(void*) == 0, "Size o
 class SPIRVShaderResources
 {
 public:
+    /// Reflects the resources of the SPIRV binary.
+
+    /// Unless UseSPIRVCross is true, the binary is reflected by the lightweight scanner (see ScanSPIRVResources).
+    /// SPIRV-Cross is only used if the scanner does not handle the binary. Both methods produce identical resources.
     SPIRVShaderResources(IMemoryAllocator&     Allocator,
                          IRenderDevice*        pRenderDevice,
                          std::vector<uint32_t> spirv_binary,
                          const ShaderDesc&     shaderDesc,
                          const char*           CombinedSamplerSuffix,
                          bool                  LoadShaderStageInputs,
-                         std::string&          EntryPoint);
+                         std::string&          EntryPoint,
+                         bool                  UseSPIRVCross = false);
+
+    /// Creates the resources from the reflection data (see ScanSPIRVResources and RestoreStrippedSPIRVNames).
+    SPIRVShaderResources(IMemoryAllocator&          Allocator,
+                         const SPIRVReflectionData& Data,
+                         const ShaderDesc&          shaderDesc,
+                         const char*                CombinedSamplerSuffix,
+                         bool                       LoadShaderStageInputs);
+
+    /// Creates the resources from the data produced by Serialize() without reflecting the SPIRV binary.
+
+    /// The shader name is taken from shaderDesc, while the combined sampler suffix and the
+    /// entry point are loaded from the data. Stage inputs are only loaded if LoadShaderStageInputs
+    /// is true. Use IsValidSerializedData() to check that the data matches the SPIRV binary
+    /// and the shader parameters. The constructor throws an exception if the data is malformed.
+    SPIRVShaderResources(IMemoryAllocator& Allocator,
+                         const void*       pSerializedData,
+                         size_t            SerializedDataSize,
+                         const ShaderDesc& shaderDesc,
+                         bool              LoadShaderStageInputs,
+                         std::string&      EntryPoint);
 
     // clang-format off
     SPIRVShaderResources             (const SPIRVShaderResources&)  = delete;
@@ -354,6 +394,30 @@ public:
 
     bool IsCompatibleWith(const SPIRVShaderResources& Resources) const;
 
+    /// Version of the serialized data format. Data with a different version is rejected.
+    static constexpr Uint32 SerializationVersion = 1;
+
+    /// Serializes the resources into a compact position-independent binary form.
+
+    /// \param [in]  spirv_binary - SPIRV binary the resources were reflected from. Its hash is
+    ///                             stored in the data to detect stale data.
+    /// \param [in]  EntryPoint   - Shader entry point.
+    /// \param [out] Data         - Serialized data.
+    ///
+    /// \remarks The data uses native byte order and can only be loaded on the platform with
+    ///          the same endianness.
+    void Serialize(const std::vector<uint32_t>& spirv_binary,
+                   const std::string&           EntryPoint,
+                   std::vector<Uint8>&          Data) const;
+
+    /// Checks that the serialized data is well-formed and was produced for the given
+    /// SPIRV binary, shader type and combined sampler suffix.
+    static bool IsValidSerializedData(const void*                  pSerializedData,
+                                      size_t                       SerializedDataSize,
+                                      const std::vector<uint32_t>& spirv_binary,
+                                      const ShaderDesc&            shaderDesc,
+                                      const char*                  CombinedSamplerSuffix);
+
     // clang-format off
 
     const char* GetCombinedSamplerSuffix() const { return m_CombinedSamplerSuffix; }
@@ -365,6 +429,12 @@ public:
     bool IsHLSLSource() const { return m_IsHLSLSource; }
 
 private:
+    void InitializeFromReflection(IMemoryAllocator&          Allocator,
+                                  const SPIRVReflectionData& Data,
+                                  const ShaderDesc&          shaderDesc,
+                                  const char*                CombinedSamplerSuffix,
+                                  bool                       LoadShaderStageInputs);
+
     void Initialize(IMemoryAllocator&       Allocator,
                     const ResourceCounters& Counters,
                     Uint32                  NumShaderStageInputs,
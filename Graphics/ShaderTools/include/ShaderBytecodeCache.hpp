@@ -0,0 +1,183 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderBytecodeCache class
+
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "GraphicsTypes.h"
+
+namespace Diligent
+{
+
+/// Persistent content-addressed shader bytecode cache.
+
+/// Every entry is stored in a separate file in the cache directory, whose name is derived
+/// from the 128-bit key. The key is computed by the client from everything that affects
+/// the compiled bytecode (source code, included files, macros, compiler and its settings)
+/// using ShaderBytecodeCache::KeyBuilder. Besides the bytecode, an entry may contain
+/// an arbitrary auxiliary blob (e.g. serialized reflection data).
+///
+/// Files are written to a temporary file first and then renamed, so that concurrent
+/// readers (including other processes) never see partially written entries. Entries
+/// that fail validation are treated as misses.
+///
+/// The cache keeps an index of the entries with their sizes and last use times that
+/// is saved to the directory by Flush() and by the destructor. When the total size of
+/// the entries exceeds the limit, the least recently used entries are deleted.
+///
+/// All methods are thread-safe.
+class ShaderBytecodeCache
+{
+public:
+    /// 128-bit content hash that identifies a cache entry
+    struct Key
+    {
+        Uint64 Lo = 0;
+        Uint64 Hi = 0;
+
+        bool operator==(const Key& rhs) const
+        {
+            return Lo == rhs.Lo && Hi == rhs.Hi;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const Key& k) const
+            {
+                return static_cast<size_t>(k.Lo ^ k.Hi);
+            }
+        };
+    };
+
+    /// Incrementally computes the key from the data.
+
+    /// The hash is stable across runs and platforms with the same endianness, so the keys
+    /// can be used to address entries stored by previous runs.
+    class KeyBuilder
+    {
+    public:
+        KeyBuilder& Update(const void* pData, size_t Size);
+
+        /// Hashes the string and its length, so that the sequences {"ab", "c"} and {"a", "bc"}
+        /// produce different keys. Null string is distinct from the empty string.
+        KeyBuilder& Update(const char* Str);
+
+        template <typename T>
+        KeyBuilder& UpdateValue(const T& Val)
+        {
+            static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only arithmetic types and enums can be hashed by value");
+            return Update(&Val, sizeof(Val));
+        }
+
+        Key Finalize() const;
+
+    private:
+        void ProcessBlock(Uint64 Block);
+
+        Uint64 m_H1         = 0x9E3779B97F4A7C15ull;
+        Uint64 m_H2         = 0xC2B2AE3D27D4EB4Full;
+        Uint64 m_Tail       = 0;
+        size_t m_TailSize   = 0;
+        Uint64 m_TotalBytes = 0;
+    };
+
+    /// Creates the cache.
+
+    /// \param [in] Directory - Path to the cache directory. The directory must exist.
+    /// \param [in] MaxSize   - Maximum total size of the entries, in bytes.
+    ShaderBytecodeCache(const char* Directory, Uint64 MaxSize);
+
+    ~ShaderBytecodeCache();
+
+    // clang-format off
+    ShaderBytecodeCache           (const ShaderBytecodeCache&) = delete;
+    ShaderBytecodeCache           (ShaderBytecodeCache&&)      = delete;
+    ShaderBytecodeCache& operator=(const ShaderBytecodeCache&) = delete;
+    ShaderBytecodeCache& operator=(ShaderBytecodeCache&&)      = delete;
+    // clang-format on
+
+    /// Loads the entry from the cache.
+
+    /// \param [in]  CacheKey - Entry key.
+    /// \param [out] Bytecode - Bytecode stored in the entry.
+    /// \param [out] pAuxData - Optional pointer to the vector that receives the auxiliary data.
+    ///
+    /// \return     true if the entry was found and is valid, and false otherwise.
+    bool Load(const Key& CacheKey, std::vector<Uint32>& Bytecode, std::vector<Uint8>* pAuxData = nullptr);
+
+    /// Adds the entry to the cache, replacing the existing one with the same key, if any.
+    void Store(const Key& CacheKey, const std::vector<Uint32>& Bytecode, const void* pAuxData = nullptr, size_t AuxDataSize = 0);
+
+    /// Saves the index to the cache directory.
+    void Flush();
+
+    /// Deletes all entries known to the cache and the index from the cache directory.
+    void Clear();
+
+    ShaderBytecodeCacheStats GetStats() const;
+
+    const std::string& GetDirectory() const { return m_Directory; }
+
+private:
+    struct EntryInfo
+    {
+        Uint64 Size    = 0;
+        Uint64 LastUse = 0;
+    };
+
+    std::string GetEntryPath(const Key& CacheKey) const;
+
+    void LoadIndex();
+
+    // Removes the least recently used entries from the index until the total size
+    // is within the limit and returns their keys. Must be called with the mutex locked.
+    std::vector<Key> EvictEntries();
+
+    const std::string m_Directory;
+    const Uint64      m_MaxSize;
+
+    mutable std::mutex m_Mtx;
+
+    std::unordered_map<Key, EntryInfo, Key::Hasher> m_Entries;
+
+    Uint64 m_UseCounter      = 0;
+    Uint64 m_TempFileCounter = 0;
+    bool   m_IndexDirty      = false;
+    bool   m_StoreFailed     = false;
+
+    ShaderBytecodeCacheStats m_Stats;
+};
+
+} // namespace Diligent
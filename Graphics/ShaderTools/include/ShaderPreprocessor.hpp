@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Shader source preprocessor
+
+#include <string>
+#include <vector>
+
+#include "Shader.h"
+#include "ShaderBytecodeCache.hpp"
+
+namespace Diligent
+{
+
+/// Source file processed by PreprocessShaderSource()
+struct ShaderSourceFileInfo
+{
+    /// File path. Empty for the source string provided through ShaderCreateInfo::Source.
+    std::string Path;
+
+    /// Hash of the file contents
+    ShaderBytecodeCache::Key Hash;
+};
+
+/// Runs the C preprocessor on the shader source without compiling it.
+
+/// \param [in]  ShaderCI    - Shader create info. The source is loaded from ShaderCI.Source or
+///                            ShaderCI.FilePath, and include files are loaded through
+///                            ShaderCI.pShaderSourceStreamFactory. Macros from ShaderCI.Macros
+///                            are defined, as well as the shader type macros (see GetShaderTypeMacros())
+///                            if ShaderCI.Desc.ShaderType is not SHADER_TYPE_UNKNOWN.
+/// \param [in]  ExtraMacros - Optional additional macros, e.g. the ones defined by the backend.
+///                            The array must be terminated by the null macro.
+/// \param [out] pSource     - Optional pointer to the string that receives the source with all macros
+///                            expanded, include directives replaced with the contents of the files,
+///                            and inactive conditional blocks, comments, blank lines and other directives removed.
+///                            #version, #extension, #pragma and #line directives are preserved.
+///                            If the pointer is null, only the dependencies are collected, which is faster.
+/// \param [out] pFiles      - Optional pointer to the vector that receives the source and all files it
+///                            includes, in the order of the first inclusion. Files that are only
+///                            referenced from inactive conditional blocks are not listed.
+///
+/// \remarks    The function does not use any global state and can be called from multiple threads
+///             simultaneously as long as the source stream factory is thread-safe.
+///
+///             Errors are reported by throwing an exception.
+void PreprocessShaderSource(const ShaderCreateInfo&            ShaderCI,
+                            const ShaderMacro*                 ExtraMacros,
+                            std::string*                       pSource,
+                            std::vector<ShaderSourceFileInfo>* pFiles) noexcept(false);
+
+} // namespace Diligent
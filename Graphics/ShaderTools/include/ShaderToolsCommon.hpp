@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "GraphicsTypes.h"
 #include "Shader.h"
 #include "RefCntAutoPtr.hpp"
@@ -79,4 +81,20 @@ const char* ReadShaderSourceFile(const char*                      SourceCode,
 void AppendShaderSourceCode(std::string& Source, const ShaderCreateInfo& ShaderCI) noexcept(false);
 
 
+/// Callback that is called by ProcessShaderIncludes() for every source file
+using ShaderIncludeHandlerType = std::function<void(const char* FilePath, const char* Source, size_t SourceLength)>;
+
+/// Calls IncludeHandler for the shader source and, recursively, for every unique
+/// file referenced by its #include directives.
+
+/// The handler is first called for the shader source itself (FilePath is null when the shader
+/// is created from the source string), and then for every included file in the order in which
+/// the directives are encountered. Every file is reported only once.
+///
+/// \note  The directives are found by a lightweight scan that skips comments, but does not
+///        evaluate preprocessor conditions, so the reported files are a superset of the files
+///        the compiler opens. Included files that cannot be opened are ignored.
+void ProcessShaderIncludes(const ShaderCreateInfo& ShaderCI, ShaderIncludeHandlerType IncludeHandler) noexcept(false);
+
+
 } // namespace Diligent
@@ -0,0 +1,1111 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "SPIRVReflection.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "spirv.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// The scanner reproduces the results of diligent_spirv_cross::Compiler::get_shader_resources()
+// for the subset of SPIRV that is produced by shader compilers, and bails out on everything else.
+class SPIRVResourceScanner
+{
+public:
+    explicit SPIRVResourceScanner(const std::vector<uint32_t>& spirv_binary) :
+        m_Words{spirv_binary.data()},
+        m_NumWords{static_cast<Uint32>(std::min<size_t>(spirv_binary.size(), std::numeric_limits<Uint32>::max()))}
+    {}
+
+    bool Scan(SHADER_TYPE ShaderType, std::string& EntryPoint, SPIRVReflectionData& Data);
+
+private:
+    enum ID_FLAGS : Uint32
+    {
+        ID_FLAG_NONE           = 0u,
+        ID_FLAG_BLOCK          = 1u << 0u,
+        ID_FLAG_BUFFER_BLOCK   = 1u << 1u,
+        ID_FLAG_BUILTIN        = 1u << 2u,
+        ID_FLAG_MEMBER_BUILTIN = 1u << 3u,
+        ID_FLAG_NON_WRITABLE   = 1u << 4u,
+        ID_FLAG_ARRAY_STRIDE   = 1u << 5u,
+        ID_FLAG_HLSL_SEMANTIC  = 1u << 6u,
+        ID_FLAG_INTERFACE      = 1u << 7u
+    };
+
+    struct IdInfo
+    {
+        Uint32 DefOffset           = 0; // Offset of the instruction that defines the id
+        Uint32 NameOffset          = 0; // Offset of the OpName instruction
+        Uint32 BindingOffset       = 0; // Offset of the Binding decoration literal
+        Uint32 DescriptorSetOffset = 0; // Offset of the DescriptorSet decoration literal
+        Uint32 LocationOffset      = 0; // Offset of the Location decoration literal
+        Uint32 SemanticOffset      = 0; // Offset of the OpDecorateStringGOOGLE instruction
+        Uint32 ArrayStride         = 0;
+        Uint32 Flags               = ID_FLAG_NONE;
+    };
+
+    struct MemberDecoration
+    {
+        Uint32 StructId;
+        Uint32 Member;
+        Uint32 Decoration;
+        Uint32 Value;
+
+        bool operator<(const MemberDecoration& rhs) const
+        {
+            return StructId != rhs.StructId ? StructId < rhs.StructId : Member < rhs.Member;
+        }
+    };
+
+    // Array dimensions of a variable type
+    struct ArrayInfo
+    {
+        Uint32 NumDims  = 0;
+        Uint32 ElemType = 0;
+        Uint32 Size     = 1;
+        bool   IsValid  = true;
+    };
+
+    Uint32 GetWordCount(Uint32 Offset) const { return m_Words[Offset] >> spv::WordCountShift; }
+    Uint32 GetOpCode(Uint32 Offset) const { return m_Words[Offset] & spv::OpCodeMask; }
+
+    // Returns the offset of the instruction that defines the id, or 0 if the id is not defined.
+    Uint32 GetDefinition(Uint32 Id) const { return Id < m_Ids.size() ? m_Ids[Id].DefOffset : 0; }
+
+    // Returns the opcode of the instruction that defines the id, or OpNop if the id is not defined.
+    spv::Op GetDefinitionOpCode(Uint32 Id) const
+    {
+        const auto Offset = GetDefinition(Id);
+        return Offset != 0 ? static_cast<spv::Op>(GetOpCode(Offset)) : spv::OpNop;
+    }
+
+    // Returns the operand of the instruction that defines the id, or 0 if the operand is out of range.
+    Uint32 GetDefinitionOperand(Uint32 Id, Uint32 Operand) const
+    {
+        const auto Offset = GetDefinition(Id);
+        return (Offset != 0 && Operand < GetWordCount(Offset)) ? m_Words[Offset + Operand] : 0;
+    }
+
+    bool ReadString(Uint32 Offset, Uint32 EndOffset, std::string& Str, Uint32* pNumWords = nullptr) const;
+    bool ReadName(Uint32 Id, std::string& Name) const;
+
+    bool ParseInstructions();
+    bool RegisterDefinition(Uint32 Id, Uint32 Offset);
+    bool SelectEntryPoint(spv::ExecutionModel ExecutionModel, std::string& EntryPoint);
+
+    bool IsSSBOInstanceNameSignificant() const;
+
+    ArrayInfo GetArrayInfo(Uint32 TypeId) const;
+
+    const MemberDecoration* FindMemberDecoration(Uint32 StructId, Uint32 Member, spv::Decoration Decoration) const;
+
+    bool GetDeclaredStructSize(Uint32 StructId, Uint32 Depth, Uint32& Size) const;
+    bool GetDeclaredStructMemberSize(Uint32 StructId, Uint32 Member, Uint32 Depth, Uint32& Size) const;
+    bool GetScalarSize(Uint32 TypeId, Uint32& Size) const;
+    bool GetRuntimeArrayStride(Uint32 StructId, Uint32& Stride) const;
+    bool IsReadOnlyBuffer(Uint32 VarId, Uint32 StructId) const;
+
+    bool GetBlockName(Uint32 VarId, Uint32 StructId, std::string& Name) const;
+
+    bool AddResource(Uint32                                      VarId,
+                     const ArrayInfo&                            Array,
+                     SPIRVShaderResourceAttribs::ResourceType    Type,
+                     std::string                                 Name,
+                     std::vector<SPIRVReflectionData::Resource>& Resources) const;
+
+    bool AddBuffer(Uint32 VarId, const ArrayInfo& Array, bool IsUniformBuffer, bool IsHLSL, bool SSBOInstanceName, SPIRVReflectionData& Data) const;
+
+    const uint32_t* const m_Words;
+    const Uint32          m_NumWords;
+
+    std::vector<IdInfo>           m_Ids;
+    std::vector<MemberDecoration> m_MemberDecorations;
+    std::vector<Uint32>           m_EntryPoints;
+    std::vector<Uint32>           m_Variables;
+
+    bool m_SourceKnown = false;
+    bool m_SourceHLSL  = false;
+    bool m_HlslFunc1   = false;
+};
+
+bool SPIRVResourceScanner::ReadString(Uint32 Offset, Uint32 EndOffset, std::string& Str, Uint32* pNumWords) const
+{
+    Str.clear();
+    for (Uint32 w = Offset; w < EndOffset; ++w)
+    {
+        const auto Word = m_Words[w];
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            const auto c = static_cast<char>((Word >> (i * 8u)) & 0xFFu);
+            if (c == '\0')
+            {
+                if (pNumWords != nullptr)
+                    *pNumWords = w - Offset + 1;
+                return true;
+            }
+            Str.push_back(c);
+        }
+    }
+    // The string is not null-terminated
+    return false;
+}
+
+inline bool IsNumeric(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool IsAlpha(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// Makes the name a valid identifier the same way SPIRV-Cross does it, and returns false
+// for the names that different versions of SPIRV-Cross handle differently.
+bool SanitizeName(std::string& Name)
+{
+    if (Name.empty())
+        return true;
+
+    // Function names mangled by glslang
+    if (Name.find('(') != std::string::npos)
+        return false;
+
+    if (IsNumeric(Name[0]))
+        Name[0] = '_';
+    for (auto& c : Name)
+    {
+        if (!IsAlpha(c) && !IsNumeric(c) && c != '_')
+            c = '_';
+    }
+
+    // Names that look like temporaries (_123), reserved member names (_m0),
+    // and names with double underscores are renamed by SPIRV-Cross.
+    if (Name.size() >= 2 && Name[0] == '_' && (IsNumeric(Name[1]) || (Name[1] == 'm' && (Name.size() == 2 || !IsAlpha(Name[2])))))
+        return false;
+    if (Name.find("__") != std::string::npos)
+        return false;
+
+    return true;
+}
+
+bool SPIRVResourceScanner::ReadName(Uint32 Id, std::string& Name) const
+{
+    Name.clear();
+    if (Id >= m_Ids.size() || m_Ids[Id].NameOffset == 0)
+        return true;
+
+    const auto Offset = m_Ids[Id].NameOffset;
+    if (!ReadString(Offset + 2, Offset + GetWordCount(Offset), Name))
+        return false;
+
+    return SanitizeName(Name);
+}
+
+bool SPIRVResourceScanner::RegisterDefinition(Uint32 Id, Uint32 Offset)
+{
+    if (Id == 0 || Id >= m_Ids.size() || m_Ids[Id].DefOffset != 0)
+        return false;
+    m_Ids[Id].DefOffset = Offset;
+    return true;
+}
+
+bool SPIRVResourceScanner::ParseInstructions()
+{
+    // https://www.khronos.org/registry/spir-v/specs/unified1/SPIRV.html#_a_id_physicallayout_a_physical_layout_of_a_spir_v_module_and_instruction
+    if (m_NumWords < 5 || m_Words[0] != spv::MagicNumber)
+        return false;
+
+    const auto Bound = m_Words[3];
+    // 0x3FFFFF is the default id bound limit of spirv-val
+    if (Bound == 0 || Bound > 0x400000)
+        return false;
+    m_Ids.resize(Bound);
+
+    Uint32 Offset = 5;
+    while (Offset < m_NumWords)
+    {
+        const auto WordCount = GetWordCount(Offset);
+        if (WordCount == 0 || WordCount > m_NumWords - Offset)
+            return false;
+
+        const auto  OpCode   = static_cast<spv::Op>(GetOpCode(Offset));
+        const auto* Operands = m_Words + Offset + 1;
+
+        switch (OpCode)
+        {
+            case spv::OpFunction:
+                // Resources are declared before the first function
+                return true;
+
+            case spv::OpSource:
+                if (WordCount < 2)
+                    return false;
+                switch (static_cast<spv::SourceLanguage>(Operands[0]))
+                {
+                    case spv::SourceLanguageESSL:
+                    case spv::SourceLanguageGLSL:
+                        m_SourceKnown = true;
+                        m_SourceHLSL  = false;
+                        break;
+
+                    case spv::SourceLanguageHLSL:
+                        m_SourceKnown = true;
+                        m_SourceHLSL  = true;
+                        break;
+
+                    default:
+                        m_SourceKnown = false;
+                }
+                break;
+
+            case spv::OpExtension:
+            {
+                std::string Extension;
+                if (!ReadString(Offset + 1, Offset + WordCount, Extension))
+                    return false;
+                if (Extension == "SPV_GOOGLE_hlsl_functionality1")
+                    m_HlslFunc1 = true;
+                break;
+            }
+
+            case spv::OpEntryPoint:
+                if (WordCount < 4)
+                    return false;
+                m_EntryPoints.push_back(Offset);
+                break;
+
+            case spv::OpName:
+                if (WordCount < 3 || Operands[0] >= m_Ids.size())
+                    return false;
+                m_Ids[Operands[0]].NameOffset = Offset;
+                break;
+
+            case spv::OpDecorate:
+            {
+                if (WordCount < 3 || Operands[0] >= m_Ids.size())
+                    return false;
+
+                auto& Id = m_Ids[Operands[0]];
+                switch (static_cast<spv::Decoration>(Operands[1]))
+                {
+                    // clang-format off
+                    case spv::DecorationBlock:       Id.Flags |= ID_FLAG_BLOCK;        break;
+                    case spv::DecorationBufferBlock: Id.Flags |= ID_FLAG_BUFFER_BLOCK; break;
+                    case spv::DecorationBuiltIn:     Id.Flags |= ID_FLAG_BUILTIN;      break;
+                    case spv::DecorationNonWritable: Id.Flags |= ID_FLAG_NON_WRITABLE; break;
+                    // clang-format on
+
+                    case spv::DecorationBinding:
+                    case spv::DecorationDescriptorSet:
+                    case spv::DecorationLocation:
+                    case spv::DecorationArrayStride:
+                    {
+                        if (WordCount < 4)
+                            return false;
+                        // Offset of the decoration literal, see diligent_spirv_cross::Compiler::get_binary_offset_for_decoration()
+                        const auto LiteralOffset = Offset + 3;
+                        switch (static_cast<spv::Decoration>(Operands[1]))
+                        {
+                            // clang-format off
+                            case spv::DecorationBinding:       Id.BindingOffset       = LiteralOffset; break;
+                            case spv::DecorationDescriptorSet: Id.DescriptorSetOffset = LiteralOffset; break;
+                            case spv::DecorationLocation:      Id.LocationOffset      = LiteralOffset; break;
+                            // clang-format on
+                            default:
+                                Id.ArrayStride = Operands[2];
+                                Id.Flags |= ID_FLAG_ARRAY_STRIDE;
+                        }
+                        break;
+                    }
+
+                    default:
+                        break;
+                }
+                break;
+            }
+
+            case spv::OpDecorateStringGOOGLE:
+                if (WordCount < 4 || Operands[0] >= m_Ids.size())
+                    return false;
+                if (static_cast<spv::Decoration>(Operands[1]) == spv::DecorationHlslSemanticGOOGLE)
+                {
+                    m_Ids[Operands[0]].SemanticOffset = Offset;
+                    m_Ids[Operands[0]].Flags |= ID_FLAG_HLSL_SEMANTIC;
+                }
+                break;
+
+            case spv::OpMemberDecorate:
+            {
+                if (WordCount < 4 || Operands[0] >= m_Ids.size())
+                    return false;
+
+                const auto Decoration = static_cast<spv::Decoration>(Operands[2]);
+                switch (Decoration)
+                {
+                    case spv::DecorationBuiltIn:
+                        m_Ids[Operands[0]].Flags |= ID_FLAG_MEMBER_BUILTIN;
+                        break;
+
+                    case spv::DecorationOffset:
+                    case spv::DecorationMatrixStride:
+                        if (WordCount < 5)
+                            return false;
+                        m_MemberDecorations.push_back({Operands[0], Operands[1], static_cast<Uint32>(Decoration), Operands[3]});
+                        break;
+
+                    case spv::DecorationRowMajor:
+                    case spv::DecorationColMajor:
+                    case spv::DecorationNonWritable:
+                        m_MemberDecorations.push_back({Operands[0], Operands[1], static_cast<Uint32>(Decoration), 0});
+                        break;
+
+                    default:
+                        break;
+                }
+                break;
+            }
+
+            case spv::OpDecorationGroup:
+            case spv::OpGroupDecorate:
+            case spv::OpGroupMemberDecorate:
+                // Decoration groups are deprecated and are not handled by the scanner
+                return false;
+
+            case spv::OpTypeVoid:
+            case spv::OpTypeBool:
+            case spv::OpTypeInt:
+            case spv::OpTypeFloat:
+            case spv::OpTypeVector:
+            case spv::OpTypeMatrix:
+            case spv::OpTypeImage:
+            case spv::OpTypeSampler:
+            case spv::OpTypeSampledImage:
+            case spv::OpTypeArray:
+            case spv::OpTypeRuntimeArray:
+            case spv::OpTypeStruct:
+            case spv::OpTypeOpaque:
+            case spv::OpTypePointer:
+            case spv::OpTypeFunction:
+            case spv::OpTypeEvent:
+            case spv::OpTypeDeviceEvent:
+            case spv::OpTypeReserveId:
+            case spv::OpTypeQueue:
+            case spv::OpTypePipe:
+            case spv::OpTypeAccelerationStructureKHR:
+            case spv::OpTypeRayQueryKHR:
+                if (WordCount < 2 || !RegisterDefinition(Operands[0], Offset))
+                    return false;
+                break;
+
+            case spv::OpConstantTrue:
+            case spv::OpConstantFalse:
+            case spv::OpConstant:
+            case spv::OpConstantComposite:
+            case spv::OpConstantSampler:
+            case spv::OpConstantNull:
+            case spv::OpSpecConstantTrue:
+            case spv::OpSpecConstantFalse:
+            case spv::OpSpecConstant:
+            case spv::OpSpecConstantComposite:
+            case spv::OpSpecConstantOp:
+                if (WordCount < 3 || !RegisterDefinition(Operands[1], Offset))
+                    return false;
+                break;
+
+            case spv::OpVariable:
+                if (WordCount < 4 || !RegisterDefinition(Operands[1], Offset))
+                    return false;
+                m_Variables.push_back(Offset);
+                break;
+
+            default:
+                break;
+        }
+
+        Offset += WordCount;
+    }
+
+    return true;
+}
+
+spv::ExecutionModel ShaderTypeToExecutionModel(SHADER_TYPE ShaderType)
+{
+    static_assert(SHADER_TYPE_LAST == SHADER_TYPE_CALLABLE, "Please handle the new shader type in the switch below");
+    switch (ShaderType)
+    {
+        // clang-format off
+        case SHADER_TYPE_VERTEX:           return spv::ExecutionModelVertex;
+        case SHADER_TYPE_HULL:             return spv::ExecutionModelTessellationControl;
+        case SHADER_TYPE_DOMAIN:           return spv::ExecutionModelTessellationEvaluation;
+        case SHADER_TYPE_GEOMETRY:         return spv::ExecutionModelGeometry;
+        case SHADER_TYPE_PIXEL:            return spv::ExecutionModelFragment;
+        case SHADER_TYPE_COMPUTE:          return spv::ExecutionModelGLCompute;
+        case SHADER_TYPE_AMPLIFICATION:    return spv::ExecutionModelTaskNV;
+        case SHADER_TYPE_MESH:             return spv::ExecutionModelMeshNV;
+        case SHADER_TYPE_RAY_GEN:          return spv::ExecutionModelRayGenerationKHR;
+        case SHADER_TYPE_RAY_MISS:         return spv::ExecutionModelMissKHR;
+        case SHADER_TYPE_RAY_CLOSEST_HIT:  return spv::ExecutionModelClosestHitKHR;
+        case SHADER_TYPE_RAY_ANY_HIT:      return spv::ExecutionModelAnyHitKHR;
+        case SHADER_TYPE_RAY_INTERSECTION: return spv::ExecutionModelIntersectionKHR;
+        case SHADER_TYPE_CALLABLE:         return spv::ExecutionModelCallableKHR;
+        // clang-format on
+        default:
+            return spv::ExecutionModelMax;
+    }
+}
+
+bool SPIRVResourceScanner::SelectEntryPoint(spv::ExecutionModel ExecutionModel, std::string& EntryPoint)
+{
+    Uint32 SelectedOffset = 0;
+    for (auto Offset : m_EntryPoints)
+    {
+        if (static_cast<spv::ExecutionModel>(m_Words[Offset + 1]) != ExecutionModel)
+            continue;
+
+        // SPIRV-Cross enumerates entry points in unspecified order, so the
+        // entry point it selects when there are several of them is unknown.
+        if (SelectedOffset != 0)
+            return false;
+        SelectedOffset = Offset;
+    }
+    if (SelectedOffset == 0)
+        return false;
+
+    const auto EndOffset = SelectedOffset + GetWordCount(SelectedOffset);
+
+    Uint32 NameWords = 0;
+    if (!ReadString(SelectedOffset + 3, EndOffset, EntryPoint, &NameWords))
+        return false;
+
+    for (Uint32 i = SelectedOffset + 3 + NameWords; i < EndOffset; ++i)
+    {
+        const auto Id = m_Words[i];
+        if (Id >= m_Ids.size())
+            return false;
+        m_Ids[Id].Flags |= ID_FLAG_INTERFACE;
+    }
+
+    return true;
+}
+
+// See diligent_spirv_cross::Compiler::reflection_ssbo_instance_name_is_significant()
+bool SPIRVResourceScanner::IsSSBOInstanceNameSignificant() const
+{
+    if (m_SourceKnown)
+    {
+        // UAVs from HLSL source tend to be declared in a way where the type is reused
+        // but the instance name is significant.
+        return m_SourceHLSL;
+    }
+
+    // If the block type is aliased, assume HLSL-style UAV declarations
+    std::vector<Uint32> SSBOTypes;
+    for (auto VarOffset : m_Variables)
+    {
+        const auto Storage = static_cast<spv::StorageClass>(m_Words[VarOffset + 3]);
+        if (Storage == spv::StorageClassFunction)
+            continue;
+
+        const auto StructId = GetArrayInfo(GetDefinitionOperand(m_Words[VarOffset + 1], 3)).ElemType;
+        if (Storage == spv::StorageClassStorageBuffer ||
+            (Storage == spv::StorageClassUniform && StructId < m_Ids.size() && (m_Ids[StructId].Flags & ID_FLAG_BUFFER_BLOCK) != 0))
+        {
+            if (std::find(SSBOTypes.begin(), SSBOTypes.end(), StructId) != SSBOTypes.end())
+                return true;
+            SSBOTypes.push_back(StructId);
+        }
+    }
+    return false;
+}
+
+SPIRVResourceScanner::ArrayInfo SPIRVResourceScanner::GetArrayInfo(Uint32 TypeId) const
+{
+    ArrayInfo Array;
+    Array.ElemType = TypeId;
+    while (Array.NumDims <= 2)
+    {
+        const auto OpCode = GetDefinitionOpCode(Array.ElemType);
+        if (OpCode == spv::OpTypeArray)
+        {
+            const auto LengthId = GetDefinitionOperand(Array.ElemType, 3);
+            // Arrays sized by specialization constants are not handled
+            if (GetDefinitionOpCode(LengthId) == spv::OpConstant && GetWordCount(GetDefinition(LengthId)) == 4)
+                Array.Size = GetDefinitionOperand(LengthId, 3);
+            else
+                Array.IsValid = false;
+        }
+        else if (OpCode == spv::OpTypeRuntimeArray)
+        {
+            Array.Size = 0;
+        }
+        else
+        {
+            break;
+        }
+        Array.ElemType = GetDefinitionOperand(Array.ElemType, 2);
+        ++Array.NumDims;
+    }
+    if (Array.NumDims > 1)
+        Array.IsValid = false;
+    return Array;
+}
+
+const SPIRVResourceScanner::MemberDecoration* SPIRVResourceScanner::FindMemberDecoration(Uint32 StructId, Uint32 Member, spv::Decoration Decoration) const
+{
+    const MemberDecoration Key{StructId, Member, 0, 0};
+
+    auto Range = std::equal_range(m_MemberDecorations.begin(), m_MemberDecorations.end(), Key);
+    // The last decoration wins
+    for (auto it = Range.second; it != Range.first;)
+    {
+        --it;
+        if (it->Decoration == static_cast<Uint32>(Decoration))
+            return &*it;
+    }
+    return nullptr;
+}
+
+bool SPIRVResourceScanner::GetScalarSize(Uint32 TypeId, Uint32& Size) const
+{
+    switch (GetDefinitionOpCode(TypeId))
+    {
+        case spv::OpTypeInt:
+        case spv::OpTypeFloat:
+            Size = GetDefinitionOperand(TypeId, 2) / 8;
+            return true;
+
+        default:
+            // Bools are purely logical and cannot be used in externally visible types
+            return false;
+    }
+}
+
+// See diligent_spirv_cross::Compiler::get_declared_struct_member_size()
+bool SPIRVResourceScanner::GetDeclaredStructMemberSize(Uint32 StructId, Uint32 Member, Uint32 Depth, Uint32& Size) const
+{
+    const auto StructOffset = GetDefinition(StructId);
+    const auto TypeId       = m_Words[StructOffset + 2 + Member];
+
+    Uint64 MemberSize = 0;
+    switch (GetDefinitionOpCode(TypeId))
+    {
+        case spv::OpTypeArray:
+        case spv::OpTypeRuntimeArray:
+        {
+            if ((m_Ids[TypeId].Flags & ID_FLAG_ARRAY_STRIDE) == 0)
+                return false;
+
+            Uint32 Length = 0;
+            if (GetDefinitionOpCode(TypeId) == spv::OpTypeArray)
+            {
+                const auto LengthId = GetDefinitionOperand(TypeId, 3);
+                if (GetDefinitionOpCode(LengthId) != spv::OpConstant || GetWordCount(GetDefinition(LengthId)) != 4)
+                    return false;
+                Length = GetDefinitionOperand(LengthId, 3);
+            }
+            MemberSize = Uint64{m_Ids[TypeId].ArrayStride} * Length;
+            break;
+        }
+
+        case spv::OpTypeStruct:
+        {
+            Uint32 StructSize = 0;
+            if (!GetDeclaredStructSize(TypeId, Depth + 1, StructSize))
+                return false;
+            MemberSize = StructSize;
+            break;
+        }
+
+        case spv::OpTypeInt:
+        case spv::OpTypeFloat:
+        {
+            Uint32 ScalarSize = 0;
+            if (!GetScalarSize(TypeId, ScalarSize))
+                return false;
+            MemberSize = ScalarSize;
+            break;
+        }
+
+        case spv::OpTypeVector:
+        {
+            Uint32 ScalarSize = 0;
+            if (!GetScalarSize(GetDefinitionOperand(TypeId, 2), ScalarSize))
+                return false;
+            MemberSize = Uint64{ScalarSize} * GetDefinitionOperand(TypeId, 3);
+            break;
+        }
+
+        case spv::OpTypeMatrix:
+        {
+            const auto ColumnType = GetDefinitionOperand(TypeId, 2);
+            if (GetDefinitionOpCode(ColumnType) != spv::OpTypeVector)
+                return false;
+
+            const auto* pMatrixStride = FindMemberDecoration(StructId, Member, spv::DecorationMatrixStride);
+            if (pMatrixStride == nullptr)
+                return false;
+
+            if (FindMemberDecoration(StructId, Member, spv::DecorationRowMajor) != nullptr)
+                MemberSize = Uint64{pMatrixStride->Value} * GetDefinitionOperand(ColumnType, 3);
+            else if (FindMemberDecoration(StructId, Member, spv::DecorationColMajor) != nullptr)
+                MemberSize = Uint64{pMatrixStride->Value} * GetDefinitionOperand(TypeId, 3);
+            else
+                return false;
+            break;
+        }
+
+        default:
+            // Opaque types, pointers, bools
+            return false;
+    }
+
+    if (MemberSize > std::numeric_limits<Uint32>::max())
+        return false;
+
+    Size = static_cast<Uint32>(MemberSize);
+    return true;
+}
+
+// See diligent_spirv_cross::Compiler::get_declared_struct_size()
+bool SPIRVResourceScanner::GetDeclaredStructSize(Uint32 StructId, Uint32 Depth, Uint32& Size) const
+{
+    // Structures can't be recursive in valid SPIRV
+    if (Depth > 32 || GetDefinitionOpCode(StructId) != spv::OpTypeStruct)
+        return false;
+
+    const auto NumMembers = GetWordCount(GetDefinition(StructId)) - 2;
+    if (NumMembers == 0)
+        return false;
+
+    // Depending on the version, SPIRV-Cross computes the size from either the last member
+    // or the member with the highest offset. Only handle the case when they are the same.
+    const auto  LastMember  = NumMembers - 1;
+    const auto* pLastOffset = FindMemberDecoration(StructId, LastMember, spv::DecorationOffset);
+    if (pLastOffset == nullptr)
+        return false;
+
+    const auto LastOffset = pLastOffset->Value;
+    for (Uint32 Member = 0; Member < LastMember; ++Member)
+    {
+        const auto* pOffset = FindMemberDecoration(StructId, Member, spv::DecorationOffset);
+        if (pOffset == nullptr || pOffset->Value >= LastOffset)
+            return false;
+    }
+
+    Uint32 LastMemberSize = 0;
+    if (!GetDeclaredStructMemberSize(StructId, LastMember, Depth, LastMemberSize))
+        return false;
+
+    const auto StructSize = Uint64{LastOffset} + LastMemberSize;
+    if (StructSize > std::numeric_limits<Uint32>::max())
+        return false;
+
+    Size = static_cast<Uint32>(StructSize);
+    return true;
+}
+
+// Returns the stride of the runtime array that ends the structure, or zero if there is no such array.
+// See diligent_spirv_cross::Compiler::get_declared_struct_size_runtime_array()
+bool SPIRVResourceScanner::GetRuntimeArrayStride(Uint32 StructId, Uint32& Stride) const
+{
+    Stride = 0;
+
+    const auto StructOffset = GetDefinition(StructId);
+    const auto NumMembers   = GetWordCount(StructOffset) - 2;
+    VERIFY_EXPR(NumMembers > 0);
+
+    const auto LastType = m_Words[StructOffset + 2 + NumMembers - 1];
+    if (GetDefinitionOpCode(LastType) != spv::OpTypeRuntimeArray)
+        return true;
+
+    // SPIRV-Cross only checks the innermost dimension
+    const auto ElemOpCode = GetDefinitionOpCode(GetDefinitionOperand(LastType, 2));
+    if (ElemOpCode == spv::OpTypeArray || ElemOpCode == spv::OpTypeRuntimeArray)
+        return false;
+
+    if ((m_Ids[LastType].Flags & ID_FLAG_ARRAY_STRIDE) == 0)
+        return false;
+
+    Stride = m_Ids[LastType].ArrayStride;
+    return true;
+}
+
+// See diligent_spirv_cross::ParsedIR::get_buffer_block_flags()
+bool SPIRVResourceScanner::IsReadOnlyBuffer(Uint32 VarId, Uint32 StructId) const
+{
+    if ((m_Ids[VarId].Flags & ID_FLAG_NON_WRITABLE) != 0)
+        return true;
+
+    // If all members are non-writable, the buffer is non-writable
+    const auto NumMembers = GetWordCount(GetDefinition(StructId)) - 2;
+    if (NumMembers == 0)
+        return false;
+
+    for (Uint32 Member = 0; Member < NumMembers; ++Member)
+    {
+        if (FindMemberDecoration(StructId, Member, spv::DecorationNonWritable) == nullptr)
+            return false;
+    }
+    return true;
+}
+
+// See diligent_spirv_cross::Compiler::get_remapped_declared_block_name()
+bool SPIRVResourceScanner::GetBlockName(Uint32 VarId, Uint32 StructId, std::string& Name) const
+{
+    if (!ReadName(StructId, Name))
+        return false;
+    if (!Name.empty())
+        return true;
+
+    // Fallback block name
+    if (!ReadName(VarId, Name))
+        return false;
+    if (Name.empty())
+        Name = "_" + std::to_string(StructId) + "_" + std::to_string(VarId);
+    return true;
+}
+
+bool SPIRVResourceScanner::AddResource(Uint32                                      VarId,
+                                       const ArrayInfo&                            Array,
+                                       SPIRVShaderResourceAttribs::ResourceType    Type,
+                                       std::string                                 Name,
+                                       std::vector<SPIRVReflectionData::Resource>& Resources) const
+{
+    const auto& Id = m_Ids[VarId];
+    if (!Array.IsValid || Array.Size > std::numeric_limits<decltype(SPIRVReflectionData::Resource::ArraySize)>::max())
+        return false;
+    if (Id.BindingOffset == 0 || Id.DescriptorSetOffset == 0)
+        return false;
+
+    SPIRVReflectionData::Resource Res;
+    Res.Name                          = std::move(Name);
+    Res.Type                          = Type;
+    Res.ArraySize                     = static_cast<decltype(Res.ArraySize)>(Array.Size);
+    Res.BindingDecorationOffset       = Id.BindingOffset;
+    Res.DescriptorSetDecorationOffset = Id.DescriptorSetOffset;
+
+    auto ImageType = Array.ElemType;
+    if (GetDefinitionOpCode(ImageType) == spv::OpTypeSampledImage)
+        ImageType = GetDefinitionOperand(ImageType, 2);
+    if (GetDefinitionOpCode(ImageType) == spv::OpTypeImage)
+    {
+        if (GetWordCount(GetDefinition(ImageType)) < 9)
+            return false;
+
+        const auto IsArrayed = GetDefinitionOperand(ImageType, 5) != 0;
+        switch (static_cast<spv::Dim>(GetDefinitionOperand(ImageType, 3)))
+        {
+            // clang-format off
+            case spv::Dim1D:     Res.ResourceDim = IsArrayed ? RESOURCE_DIM_TEX_1D_ARRAY   : RESOURCE_DIM_TEX_1D;   break;
+            case spv::Dim2D:     Res.ResourceDim = IsArrayed ? RESOURCE_DIM_TEX_2D_ARRAY   : RESOURCE_DIM_TEX_2D;   break;
+            case spv::Dim3D:     Res.ResourceDim = RESOURCE_DIM_TEX_3D;                                             break;
+            case spv::DimCube:   Res.ResourceDim = IsArrayed ? RESOURCE_DIM_TEX_CUBE_ARRAY : RESOURCE_DIM_TEX_CUBE; break;
+            case spv::DimBuffer: Res.ResourceDim = RESOURCE_DIM_BUFFER;                                             break;
+            // clang-format on
+            default: Res.ResourceDim = RESOURCE_DIM_UNDEFINED;
+        }
+        Res.IsMS = GetDefinitionOperand(ImageType, 6) != 0;
+    }
+
+    Resources.emplace_back(std::move(Res));
+    return true;
+}
+
+bool SPIRVResourceScanner::AddBuffer(Uint32 VarId, const ArrayInfo& Array, bool IsUniformBuffer, bool IsHLSL, bool SSBOInstanceName, SPIRVReflectionData& Data) const
+{
+    const auto StructId = Array.ElemType;
+
+    Uint32 Size = 0;
+    if (!GetDeclaredStructSize(StructId, 0, Size))
+        return false;
+
+    std::string Name;
+    if (IsUniformBuffer)
+    {
+        // See GetUBName() in SPIRVShaderResources.cpp
+        if (!ReadName(VarId, Name))
+            return false;
+        if (!IsHLSL || Name.empty())
+        {
+            if (!GetBlockName(VarId, StructId, Name))
+                return false;
+        }
+        if (!AddResource(VarId, Array, SPIRVShaderResourceAttribs::ResourceType::UniformBuffer, std::move(Name), Data.UBs))
+            return false;
+
+        Data.UBs.back().BufferStaticSize = Size;
+        return true;
+    }
+
+    if (SSBOInstanceName)
+    {
+        if (!ReadName(VarId, Name))
+            return false;
+        if (Name.empty())
+            Name = "_" + std::to_string(VarId);
+    }
+    else
+    {
+        if (!GetBlockName(VarId, StructId, Name))
+            return false;
+    }
+
+    Uint32 RuntimeArrayStride = 0;
+    if (!GetRuntimeArrayStride(StructId, RuntimeArrayStride))
+        return false;
+
+    const auto Type = IsReadOnlyBuffer(VarId, StructId) ?
+        SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer :
+        SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer;
+    if (!AddResource(VarId, Array, Type, std::move(Name), Data.SBs))
+        return false;
+
+    const auto Stride = Uint64{Size} + RuntimeArrayStride;
+    if (Stride > std::numeric_limits<Uint32>::max())
+        return false;
+
+    auto& SB            = Data.SBs.back();
+    SB.BufferStaticSize = Size;
+    SB.BufferStride     = static_cast<Uint32>(Stride);
+    return true;
+}
+
+bool SPIRVResourceScanner::Scan(SHADER_TYPE ShaderType, std::string& EntryPoint, SPIRVReflectionData& Data)
+{
+    if (!ParseInstructions())
+        return false;
+
+    const auto ExecutionModel = ShaderTypeToExecutionModel(ShaderType);
+    if (ExecutionModel == spv::ExecutionModelMax)
+        return false;
+
+    std::string EntryPointName;
+    if (!SelectEntryPoint(ExecutionModel, EntryPointName))
+        return false;
+
+    // Sort member decorations by structure and member index while keeping the declaration order
+    std::stable_sort(m_MemberDecorations.begin(), m_MemberDecorations.end());
+
+    const auto SPIRVVersion     = m_Words[1];
+    const auto SSBOInstanceName = IsSSBOInstanceNameSignificant();
+
+    Data.IsHLSLSource       = m_SourceHLSL;
+    Data.HlslFunctionality1 = m_HlslFunc1;
+
+    using ResourceType = SPIRVShaderResourceAttribs::ResourceType;
+    for (auto VarOffset : m_Variables)
+    {
+        const auto VarId   = m_Words[VarOffset + 2];
+        const auto Storage = static_cast<spv::StorageClass>(m_Words[VarOffset + 3]);
+        if (Storage == spv::StorageClassFunction)
+            continue;
+
+        const auto PtrType = m_Words[VarOffset + 1];
+        if (GetDefinitionOpCode(PtrType) != spv::OpTypePointer || GetWordCount(GetDefinition(PtrType)) < 4)
+            return false;
+
+        // In SPIRV 1.4 and up, every global variable must be listed in the entry point interface.
+        // Earlier versions only list inputs and outputs, and the list may be incomplete in
+        // single-entry-point modules produced by old compilers.
+        const auto& Id = m_Ids[VarId];
+        if (SPIRVVersion >= 0x10400 || Storage == spv::StorageClassInput || Storage == spv::StorageClassOutput)
+        {
+            const auto CheckInterface = SPIRVVersion >= 0x10400 || m_EntryPoints.size() > 1;
+            if (CheckInterface && (Id.Flags & ID_FLAG_INTERFACE) == 0)
+                continue;
+        }
+
+        const auto  Array    = GetArrayInfo(GetDefinitionOperand(PtrType, 3));
+        const auto  BaseType = Array.ElemType;
+        const auto  OpCode   = GetDefinitionOpCode(BaseType);
+        const auto* pBase    = BaseType < m_Ids.size() ? &m_Ids[BaseType] : nullptr;
+        if (pBase == nullptr || pBase->DefOffset == 0)
+            return false;
+
+        if ((Id.Flags & ID_FLAG_BUILTIN) != 0 || (pBase->Flags & ID_FLAG_MEMBER_BUILTIN) != 0)
+            continue;
+
+        if (Storage == spv::StorageClassInput)
+        {
+            SPIRVReflectionData::StageInput Input;
+            if (!ReadName(VarId, Input.Name))
+                return false;
+            Input.HasSemantic = (Id.Flags & ID_FLAG_HLSL_SEMANTIC) != 0;
+            if (Input.HasSemantic)
+            {
+                if (Id.LocationOffset == 0)
+                    return false;
+                if (!ReadString(Id.SemanticOffset + 3, Id.SemanticOffset + GetWordCount(Id.SemanticOffset), Input.Semantic))
+                    return false;
+                Input.LocationDecorationOffset = Id.LocationOffset;
+            }
+            Data.StageInputs.emplace_back(std::move(Input));
+            continue;
+        }
+
+        const auto IsImage      = OpCode == spv::OpTypeImage;
+        const auto ImageDim     = IsImage ? static_cast<spv::Dim>(GetDefinitionOperand(BaseType, 3)) : spv::DimMax;
+        const auto ImageSampled = IsImage ? GetDefinitionOperand(BaseType, 7) : 0;
+
+        auto TexelBufferType = [&](Uint32 ImageTypeId, ResourceType TexelBuffer, ResourceType Image) {
+            return static_cast<spv::Dim>(GetDefinitionOperand(ImageTypeId, 3)) == spv::DimBuffer ? TexelBuffer : Image;
+        };
+
+        bool Succeeded = true;
+        std::string Name;
+        if (Storage == spv::StorageClassUniformConstant && IsImage && ImageDim == spv::DimSubpassData)
+        {
+            Succeeded = ReadName(VarId, Name) && AddResource(VarId, Array, ResourceType::InputAttachment, std::move(Name), Data.InptAtts);
+        }
+        else if (Storage == spv::StorageClassUniform && (pBase->Flags & ID_FLAG_BLOCK) != 0)
+        {
+            Succeeded = AddBuffer(VarId, Array, true, m_SourceHLSL, SSBOInstanceName, Data);
+        }
+        else if ((Storage == spv::StorageClassUniform && (pBase->Flags & ID_FLAG_BUFFER_BLOCK) != 0) ||
+                 Storage == spv::StorageClassStorageBuffer)
+        {
+            Succeeded = AddBuffer(VarId, Array, false, m_SourceHLSL, SSBOInstanceName, Data);
+        }
+        else if (Storage == spv::StorageClassUniformConstant && IsImage && ImageSampled == 2)
+        {
+            const auto Type = TexelBufferType(BaseType, ResourceType::StorageTexelBuffer, ResourceType::StorageImage);
+            Succeeded       = ReadName(VarId, Name) && AddResource(VarId, Array, Type, std::move(Name), Data.Imgs);
+        }
+        else if (Storage == spv::StorageClassUniformConstant && IsImage && ImageSampled == 1)
+        {
+            const auto Type = TexelBufferType(BaseType, ResourceType::UniformTexelBuffer, ResourceType::SeparateImage);
+            Succeeded       = ReadName(VarId, Name) && AddResource(VarId, Array, Type, std::move(Name), Data.SepImgs);
+        }
+        else if (Storage == spv::StorageClassUniformConstant && OpCode == spv::OpTypeSampler)
+        {
+            Succeeded = ReadName(VarId, Name) && AddResource(VarId, Array, ResourceType::SeparateSampler, std::move(Name), Data.SepSmplrs);
+        }
+        else if (Storage == spv::StorageClassUniformConstant && OpCode == spv::OpTypeSampledImage)
+        {
+            const auto ImageType = GetDefinitionOperand(BaseType, 2);
+            if (GetDefinitionOpCode(ImageType) != spv::OpTypeImage)
+                return false;
+            const auto Type = TexelBufferType(ImageType, ResourceType::UniformTexelBuffer, ResourceType::SampledImage);
+            Succeeded       = ReadName(VarId, Name) && AddResource(VarId, Array, Type, std::move(Name), Data.SmpldImgs);
+        }
+        else if (Storage == spv::StorageClassAtomicCounter)
+        {
+            Succeeded = ReadName(VarId, Name) && AddResource(VarId, Array, ResourceType::AtomicCounter, std::move(Name), Data.ACs);
+        }
+        else if (Storage == spv::StorageClassUniformConstant && OpCode == spv::OpTypeAccelerationStructureKHR)
+        {
+            Succeeded = ReadName(VarId, Name) && AddResource(VarId, Array, ResourceType::AccelerationStructure, std::move(Name), Data.AccelStructs);
+        }
+        static_assert(Uint32{ResourceType::NumResourceTypes} == 12, "Please handle the new resource type here");
+
+        if (!Succeeded)
+            return false;
+    }
+
+    EntryPoint = std::move(EntryPointName);
+    return true;
+}
+
+} // namespace
+
+bool ScanSPIRVResources(const std::vector<uint32_t>& spirv_binary,
+                        SHADER_TYPE                  ShaderType,
+                        std::string&                 EntryPoint,
+                        SPIRVReflectionData&         Data)
+{
+    SPIRVResourceScanner Scanner{spirv_binary};
+    return Scanner.Scan(ShaderType, EntryPoint, Data);
+}
+
+bool RestoreStrippedSPIRVNames(const SPIRVReflectionData& Original,
+                               SPIRVReflectionData&       Stripped)
+{
+    auto RestoreNames = [](const std::vector<SPIRVReflectionData::Resource>& Src, std::vector<SPIRVReflectionData::Resource>& Dst) {
+        if (Src.size() != Dst.size())
+            return false;
+
+        for (size_t i = 0; i < Src.size(); ++i)
+        {
+            const auto& SrcRes = Src[i];
+            auto&       DstRes = Dst[i];
+            // clang-format off
+            if (SrcRes.Type             != DstRes.Type             ||
+                SrcRes.ArraySize        != DstRes.ArraySize        ||
+                SrcRes.ResourceDim      != DstRes.ResourceDim      ||
+                SrcRes.IsMS             != DstRes.IsMS             ||
+                SrcRes.BufferStaticSize != DstRes.BufferStaticSize ||
+                SrcRes.BufferStride     != DstRes.BufferStride)
+                return false;
+            // clang-format on
+            DstRes.Name = SrcRes.Name;
+        }
+        return true;
+    };
+
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please handle the new resource type here");
+    // clang-format off
+    if (!RestoreNames(Original.UBs,          Stripped.UBs)       ||
+        !RestoreNames(Original.SBs,          Stripped.SBs)       ||
+        !RestoreNames(Original.Imgs,         Stripped.Imgs)      ||
+        !RestoreNames(Original.SmpldImgs,    Stripped.SmpldImgs) ||
+        !RestoreNames(Original.ACs,          Stripped.ACs)       ||
+        !RestoreNames(Original.SepSmplrs,    Stripped.SepSmplrs) ||
+        !RestoreNames(Original.SepImgs,      Stripped.SepImgs)   ||
+        !RestoreNames(Original.InptAtts,     Stripped.InptAtts)  ||
+        !RestoreNames(Original.AccelStructs, Stripped.AccelStructs))
+        return false;
+    // clang-format on
+
+    if (Original.StageInputs.size() != Stripped.StageInputs.size())
+        return false;
+    for (size_t i = 0; i < Original.StageInputs.size(); ++i)
+    {
+        const auto& SrcInput = Original.StageInputs[i];
+        auto&       DstInput = Stripped.StageInputs[i];
+        if (SrcInput.HasSemantic != DstInput.HasSemantic || SrcInput.Semantic != DstInput.Semantic)
+            return false;
+        DstInput.Name = SrcInput.Name;
+    }
+
+    // OpSource instruction is removed with the rest of debug information
+    Stripped.IsHLSLSource       = Original.IsHLSLSource;
+    Stripped.HlslFunctionality1 = Original.HlslFunctionality1;
+
+    return true;
+}
+
+} // namespace Diligent
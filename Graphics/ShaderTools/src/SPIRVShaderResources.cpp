@@ -27,6 +27,7 @@
 
 #include <iomanip>
 #include "SPIRVShaderResources.hpp"
+#include "SPIRVReflection.hpp"
 #include "spirv_parser.hpp"
 #include "spirv_cross.hpp"
 #include "ShaderBase.hpp"
@@ -105,32 +106,6 @@ static uint32_t GetDecorationOffset(const diligent_spirv_cross::Compiler& Compil
     return offset;
 }
 
-SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const diligent_spirv_cross::Compiler& Compiler,
-                                                       const diligent_spirv_cross::Resource& Res,
-                                                       const char*                           _Name,
-                                                       ResourceType                          _Type,
-                                                       Uint32                                _SepSmplrOrImgInd,
-                                                       Uint32                                _BufferStaticSize,
-                                                       Uint32                                _BufferStride) noexcept :
-    // clang-format off
-    Name                          {_Name},
-    ArraySize                     {GetResourceArraySize<decltype(ArraySize)>(Compiler, Res)},
-    Type                          {_Type},
-    ResourceDim                   {Diligent::GetResourceDimension(Compiler, Res)},
-    IsMS                          {Diligent::IsMultisample(Compiler, Res) ? Uint8{1} : Uint8{0}},
-    SepSmplrOrImgInd              {_SepSmplrOrImgInd},
-    BindingDecorationOffset       {GetDecorationOffset(Compiler, Res, spv::Decoration::DecorationBinding)},
-    DescriptorSetDecorationOffset {GetDecorationOffset(Compiler, Res, spv::Decoration::DecorationDescriptorSet)},
-    BufferStaticSize              {_BufferStaticSize},
-    BufferStride                  {_BufferStride}
-// clang-format on
-{
-    VERIFY(_SepSmplrOrImgInd == SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd ||
-               (_Type == ResourceType::SeparateSampler || _Type == ResourceType::SeparateImage),
-           "Only separate images or separate samplers can be assinged valid SepSmplrOrImgInd value");
-}
-
-
 SHADER_RESOURCE_TYPE SPIRVShaderResourceAttribs::GetShaderResourceType(ResourceType Type)
 {
     static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please handle the new resource type below");
@@ -247,20 +222,39 @@ const std::string& GetUBName(diligent_spirv_cross::Compiler&               Compi
     return (IRSource.hlsl && !instance_name.empty()) ? instance_name : UB.name;
 }
 
-SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
-                                           IRenderDevice*        pRenderDevice,
-                                           std::vector<uint32_t> spirv_binary,
-                                           const ShaderDesc&     shaderDesc,
-                                           const char*           CombinedSamplerSuffix,
-                                           bool                  LoadShaderStageInputs,
-                                           std::string&          EntryPoint) :
-    m_ShaderType{shaderDesc.ShaderType}
+namespace
+{
+
+SPIRVReflectionData::Resource CreateReflectedResource(const diligent_spirv_cross::Compiler&    Compiler,
+                                                      const diligent_spirv_cross::Resource&    Res,
+                                                      const std::string&                       Name,
+                                                      SPIRVShaderResourceAttribs::ResourceType Type,
+                                                      Uint32                                   BufferStaticSize = 0,
+                                                      Uint32                                   BufferStride     = 0)
+{
+    SPIRVReflectionData::Resource Resource;
+    Resource.Name                          = Name;
+    Resource.Type                          = Type;
+    Resource.ArraySize                     = GetResourceArraySize<decltype(Resource.ArraySize)>(Compiler, Res);
+    Resource.ResourceDim                   = GetResourceDimension(Compiler, Res);
+    Resource.IsMS                          = IsMultisample(Compiler, Res);
+    Resource.BindingDecorationOffset       = GetDecorationOffset(Compiler, Res, spv::Decoration::DecorationBinding);
+    Resource.DescriptorSetDecorationOffset = GetDecorationOffset(Compiler, Res, spv::Decoration::DecorationDescriptorSet);
+    Resource.BufferStaticSize              = BufferStaticSize;
+    Resource.BufferStride                  = BufferStride;
+    return Resource;
+}
+
+void ReflectWithSPIRVCross(std::vector<uint32_t> spirv_binary,
+                           const ShaderDesc&     shaderDesc,
+                           std::string&          EntryPoint,
+                           SPIRVReflectionData&  Data)
 {
     // https://github.com/KhronosGroup/SPIRV-Cross/wiki/Reflection-API-user-guide
     diligent_spirv_cross::Parser parser(move(spirv_binary));
     parser.parse();
     const auto ParsedIRSource = parser.get_parsed_ir().source;
-    m_IsHLSLSource            = ParsedIRSource.hlsl;
+    Data.IsHLSLSource         = ParsedIRSource.hlsl;
     diligent_spirv_cross::Compiler Compiler(std::move(parser.get_parsed_ir()));
 
     spv::ExecutionModel ExecutionModel = ShaderTypeToExecutionModel(shaderDesc.ShaderType);
@@ -288,24 +282,151 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
     // The SPIR-V is now parsed, and we can perform reflection on it.
     diligent_spirv_cross::ShaderResources resources = Compiler.get_shader_resources();
 
-    size_t ResourceNamesPoolSize = 0;
-    for (const auto& ub : resources.uniform_buffers)
-        ResourceNamesPoolSize += GetUBName(Compiler, ub, ParsedIRSource).length() + 1;
+    for (const auto& UB : resources.uniform_buffers)
+    {
+        const auto& Type = Compiler.get_type(UB.type_id);
+        const auto  Size = Compiler.get_declared_struct_size(Type);
+        Data.UBs.emplace_back(CreateReflectedResource(Compiler, UB, GetUBName(Compiler, UB, ParsedIRSource),
+                                                      SPIRVShaderResourceAttribs::ResourceType::UniformBuffer,
+                                                      static_cast<Uint32>(Size)));
+    }
+
+    for (const auto& SB : resources.storage_buffers)
+    {
+        auto BufferFlags = Compiler.get_buffer_block_flags(SB.id);
+        auto IsReadOnly  = BufferFlags.get(spv::DecorationNonWritable);
+        auto ResType     = IsReadOnly ?
+            SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer :
+            SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer;
+        const auto& Type   = Compiler.get_type(SB.type_id);
+        const auto  Size   = Compiler.get_declared_struct_size(Type);
+        const auto  Stride = Compiler.get_declared_struct_size_runtime_array(Type, 1);
+        Data.SBs.emplace_back(CreateReflectedResource(Compiler, SB, SB.name, ResType, static_cast<Uint32>(Size), static_cast<Uint32>(Stride)));
+    }
+
+    for (const auto& SmplImg : resources.sampled_images)
+    {
+        const auto& type    = Compiler.get_type(SmplImg.type_id);
+        auto        ResType = type.image.dim == spv::DimBuffer ?
+            SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer :
+            SPIRVShaderResourceAttribs::ResourceType::SampledImage;
+        Data.SmpldImgs.emplace_back(CreateReflectedResource(Compiler, SmplImg, SmplImg.name, ResType));
+    }
+
+    for (const auto& Img : resources.storage_images)
+    {
+        const auto& type    = Compiler.get_type(Img.type_id);
+        auto        ResType = type.image.dim == spv::DimBuffer ?
+            SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer :
+            SPIRVShaderResourceAttribs::ResourceType::StorageImage;
+        Data.Imgs.emplace_back(CreateReflectedResource(Compiler, Img, Img.name, ResType));
+    }
+
+    for (const auto& AC : resources.atomic_counters)
+        Data.ACs.emplace_back(CreateReflectedResource(Compiler, AC, AC.name, SPIRVShaderResourceAttribs::ResourceType::AtomicCounter));
+
+    for (const auto& SepSam : resources.separate_samplers)
+        Data.SepSmplrs.emplace_back(CreateReflectedResource(Compiler, SepSam, SepSam.name, SPIRVShaderResourceAttribs::ResourceType::SeparateSampler));
+
+    for (const auto& SepImg : resources.separate_images)
+    {
+        const auto& type    = Compiler.get_type(SepImg.type_id);
+        auto        ResType = type.image.dim == spv::DimBuffer ?
+            SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer :
+            SPIRVShaderResourceAttribs::ResourceType::SeparateImage;
+        Data.SepImgs.emplace_back(CreateReflectedResource(Compiler, SepImg, SepImg.name, ResType));
+    }
+
+    for (const auto& SubpassInput : resources.subpass_inputs)
+        Data.InptAtts.emplace_back(CreateReflectedResource(Compiler, SubpassInput, SubpassInput.name, SPIRVShaderResourceAttribs::ResourceType::InputAttachment));
+
+    for (const auto& AccelStruct : resources.acceleration_structures)
+        Data.AccelStructs.emplace_back(CreateReflectedResource(Compiler, AccelStruct, AccelStruct.name, SPIRVShaderResourceAttribs::ResourceType::AccelerationStructure));
+
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please reflect the new resource type here");
+
+    for (const auto& ext : Compiler.get_declared_extensions())
+    {
+        if (ext == "SPV_GOOGLE_hlsl_functionality1")
+        {
+            Data.HlslFunctionality1 = true;
+            break;
+        }
+    }
+
+    for (const auto& Input : resources.stage_inputs)
+    {
+        SPIRVReflectionData::StageInput StageInput;
+        StageInput.Name        = Input.name;
+        StageInput.HasSemantic = Compiler.has_decoration(Input.id, spv::Decoration::DecorationHlslSemanticGOOGLE);
+        if (StageInput.HasSemantic)
+        {
+            StageInput.Semantic                 = Compiler.get_decoration_string(Input.id, spv::Decoration::DecorationHlslSemanticGOOGLE);
+            StageInput.LocationDecorationOffset = GetDecorationOffset(Compiler, Input, spv::Decoration::DecorationLocation);
+        }
+        Data.StageInputs.emplace_back(std::move(StageInput));
+    }
+}
+
+} // namespace
+
+SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
+                                           IRenderDevice*        pRenderDevice,
+                                           std::vector<uint32_t> spirv_binary,
+                                           const ShaderDesc&     shaderDesc,
+                                           const char*           CombinedSamplerSuffix,
+                                           bool                  LoadShaderStageInputs,
+                                           std::string&          EntryPoint,
+                                           bool                  UseSPIRVCross) :
+    m_ShaderType{shaderDesc.ShaderType}
+{
+    SPIRVReflectionData Data;
+    if (UseSPIRVCross || !ScanSPIRVResources(spirv_binary, shaderDesc.ShaderType, EntryPoint, Data))
+    {
+        Data = SPIRVReflectionData{};
+        ReflectWithSPIRVCross(std::move(spirv_binary), shaderDesc, EntryPoint, Data);
+    }
+
+    InitializeFromReflection(Allocator, Data, shaderDesc, CombinedSamplerSuffix, LoadShaderStageInputs);
+}
+
+SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&          Allocator,
+                                           const SPIRVReflectionData& Data,
+                                           const ShaderDesc&          shaderDesc,
+                                           const char*                CombinedSamplerSuffix,
+                                           bool                       LoadShaderStageInputs) :
+    m_ShaderType{shaderDesc.ShaderType}
+{
+    InitializeFromReflection(Allocator, Data, shaderDesc, CombinedSamplerSuffix, LoadShaderStageInputs);
+}
+
+void SPIRVShaderResources::InitializeFromReflection(IMemoryAllocator&          Allocator,
+                                                    const SPIRVReflectionData& Data,
+                                                    const ShaderDesc&          shaderDesc,
+                                                    const char*                CombinedSamplerSuffix,
+                                                    bool                       LoadShaderStageInputs)
+{
+    m_IsHLSLSource = Data.IsHLSLSource;
+
     static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please account for the new resource type below");
-    for (auto* pResType :
-         {
-             &resources.storage_buffers,
-             &resources.storage_images,
-             &resources.sampled_images,
-             &resources.atomic_counters,
-             &resources.separate_images,
-             &resources.separate_samplers,
-             &resources.subpass_inputs,
-             &resources.acceleration_structures //
-         })                                     //
+    const std::vector<SPIRVReflectionData::Resource>* const AllResources[] =
+        {
+            &Data.UBs,
+            &Data.SBs,
+            &Data.Imgs,
+            &Data.SmpldImgs,
+            &Data.ACs,
+            &Data.SepSmplrs,
+            &Data.SepImgs,
+            &Data.InptAtts,
+            &Data.AccelStructs //
+        };
+
+    size_t ResourceNamesPoolSize = 0;
+    for (const auto* pResources : AllResources)
     {
-        for (const auto& res : *pResType)
-            ResourceNamesPoolSize += res.name.length() + 1;
+        for (const auto& res : *pResources)
+            ResourceNamesPoolSize += res.Name.length() + 1;
     }
 
     if (CombinedSamplerSuffix != nullptr)
@@ -318,32 +439,22 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
 
     Uint32 NumShaderStageInputs = 0;
 
-    if (!m_IsHLSLSource || resources.stage_inputs.empty())
+    if (!m_IsHLSLSource || Data.StageInputs.empty())
         LoadShaderStageInputs = false;
     if (LoadShaderStageInputs)
     {
-        const auto& Extensions         = Compiler.get_declared_extensions();
-        bool        HlslFunctionality1 = false;
-        for (const auto& ext : Extensions)
-        {
-            HlslFunctionality1 = (ext == "SPV_GOOGLE_hlsl_functionality1");
-            if (HlslFunctionality1)
-                break;
-        }
-
-        if (HlslFunctionality1)
+        if (Data.HlslFunctionality1)
         {
-            for (const auto& Input : resources.stage_inputs)
+            for (const auto& Input : Data.StageInputs)
             {
-                if (Compiler.has_decoration(Input.id, spv::Decoration::DecorationHlslSemanticGOOGLE))
+                if (Input.HasSemantic)
                 {
-                    const auto& Semantic = Compiler.get_decoration_string(Input.id, spv::Decoration::DecorationHlslSemanticGOOGLE);
-                    ResourceNamesPoolSize += Semantic.length() + 1;
+                    ResourceNamesPoolSize += Input.Semantic.length() + 1;
                     ++NumShaderStageInputs;
                 }
                 else
                 {
-                    LOG_ERROR_MESSAGE("Shader input '", Input.name, "' does not have DecorationHlslSemanticGOOGLE decoration, which is unexpected as the shader declares SPV_GOOGLE_hlsl_functionality1 extension");
+                    LOG_ERROR_MESSAGE("Shader input '", Input.Name, "' does not have DecorationHlslSemanticGOOGLE decoration, which is unexpected as the shader declares SPV_GOOGLE_hlsl_functionality1 extension");
                 }
             }
         }
@@ -362,204 +473,81 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
     }
 
     ResourceCounters ResCounters;
-    ResCounters.NumUBs          = static_cast<Uint32>(resources.uniform_buffers.size());
-    ResCounters.NumSBs          = static_cast<Uint32>(resources.storage_buffers.size());
-    ResCounters.NumImgs         = static_cast<Uint32>(resources.storage_images.size());
-    ResCounters.NumSmpldImgs    = static_cast<Uint32>(resources.sampled_images.size());
-    ResCounters.NumACs          = static_cast<Uint32>(resources.atomic_counters.size());
-    ResCounters.NumSepSmplrs    = static_cast<Uint32>(resources.separate_samplers.size());
-    ResCounters.NumSepImgs      = static_cast<Uint32>(resources.separate_images.size());
-    ResCounters.NumInptAtts     = static_cast<Uint32>(resources.subpass_inputs.size());
-    ResCounters.NumAccelStructs = static_cast<Uint32>(resources.acceleration_structures.size());
+    ResCounters.NumUBs          = static_cast<Uint32>(Data.UBs.size());
+    ResCounters.NumSBs          = static_cast<Uint32>(Data.SBs.size());
+    ResCounters.NumImgs         = static_cast<Uint32>(Data.Imgs.size());
+    ResCounters.NumSmpldImgs    = static_cast<Uint32>(Data.SmpldImgs.size());
+    ResCounters.NumACs          = static_cast<Uint32>(Data.ACs.size());
+    ResCounters.NumSepSmplrs    = static_cast<Uint32>(Data.SepSmplrs.size());
+    ResCounters.NumSepImgs      = static_cast<Uint32>(Data.SepImgs.size());
+    ResCounters.NumInptAtts     = static_cast<Uint32>(Data.InptAtts.size());
+    ResCounters.NumAccelStructs = static_cast<Uint32>(Data.AccelStructs.size());
     static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please set the new resource type counter here");
 
     // Resource names pool is only needed to facilitate string allocation.
     StringPool ResourceNamesPool;
     Initialize(Allocator, ResCounters, NumShaderStageInputs, ResourceNamesPoolSize, ResourceNamesPool);
 
+    // Resources are stored in the memory buffer in the same order as in AllResources
+    Uint32 CurrRes = 0;
+    for (const auto* pResources : AllResources)
     {
-        Uint32 CurrUB = 0;
-        for (const auto& UB : resources.uniform_buffers)
-        {
-            const auto& name = GetUBName(Compiler, UB, ParsedIRSource);
-            const auto& Type = Compiler.get_type(UB.type_id);
-            const auto  Size = Compiler.get_declared_struct_size(Type);
-            new (&GetUB(CurrUB++))
-                SPIRVShaderResourceAttribs(Compiler,
-                                           UB,
-                                           ResourceNamesPool.CopyString(name),
-                                           SPIRVShaderResourceAttribs::ResourceType::UniformBuffer,
-                                           SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd,
-                                           static_cast<Uint32>(Size));
-        }
-        VERIFY_EXPR(CurrUB == GetNumUBs());
-    }
-
-    {
-        Uint32 CurrSB = 0;
-        for (const auto& SB : resources.storage_buffers)
-        {
-            auto BufferFlags = Compiler.get_buffer_block_flags(SB.id);
-            auto IsReadOnly  = BufferFlags.get(spv::DecorationNonWritable);
-            auto ResType     = IsReadOnly ?
-                SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer :
-                SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer;
-            const auto& Type   = Compiler.get_type(SB.type_id);
-            const auto  Size   = Compiler.get_declared_struct_size(Type);
-            const auto  Stride = Compiler.get_declared_struct_size_runtime_array(Type, 1);
-            new (&GetSB(CurrSB++))
-                SPIRVShaderResourceAttribs(Compiler,
-                                           SB,
-                                           ResourceNamesPool.CopyString(SB.name),
-                                           ResType,
-                                           SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd,
-                                           static_cast<Uint32>(Size),
-                                           static_cast<Uint32>(Stride));
-        }
-        VERIFY_EXPR(CurrSB == GetNumSBs());
-    }
-
-    {
-        Uint32 CurrSmplImg = 0;
-        for (const auto& SmplImg : resources.sampled_images)
-        {
-            const auto& type    = Compiler.get_type(SmplImg.type_id);
-            auto        ResType = type.image.dim == spv::DimBuffer ?
-                SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer :
-                SPIRVShaderResourceAttribs::ResourceType::SampledImage;
-            new (&GetSmpldImg(CurrSmplImg++))
-                SPIRVShaderResourceAttribs(Compiler,
-                                           SmplImg,
-                                           ResourceNamesPool.CopyString(SmplImg.name),
-                                           ResType);
-        }
-        VERIFY_EXPR(CurrSmplImg == GetNumSmpldImgs());
-    }
-
-    {
-        Uint32 CurrImg = 0;
-        for (const auto& Img : resources.storage_images)
+        for (const auto& Res : *pResources)
         {
-            const auto& type    = Compiler.get_type(Img.type_id);
-            auto        ResType = type.image.dim == spv::DimBuffer ?
-                SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer :
-                SPIRVShaderResourceAttribs::ResourceType::StorageImage;
-            new (&GetImg(CurrImg++))
-                SPIRVShaderResourceAttribs(Compiler,
-                                           Img,
-                                           ResourceNamesPool.CopyString(Img.name),
-                                           ResType);
+            new (&GetResource(CurrRes++))
+                SPIRVShaderResourceAttribs{
+                    ResourceNamesPool.CopyString(Res.Name),
+                    Res.Type,
+                    Res.ArraySize,
+                    Res.ResourceDim,
+                    Res.IsMS,
+                    SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd,
+                    Res.BindingDecorationOffset,
+                    Res.DescriptorSetDecorationOffset,
+                    Res.BufferStaticSize,
+                    Res.BufferStride //
+                };
         }
-        VERIFY_EXPR(CurrImg == GetNumImgs());
-    }
-
-    {
-        Uint32 CurrAC = 0;
-        for (const auto& AC : resources.atomic_counters)
-        {
-            new (&GetAC(CurrAC++))
-                SPIRVShaderResourceAttribs(Compiler,
-                                           AC,
-                                           ResourceNamesPool.CopyString(AC.name),
-                                           SPIRVShaderResourceAttribs::ResourceType::AtomicCounter);
-        }
-        VERIFY_EXPR(CurrAC == GetNumACs());
-    }
-
-    {
-        Uint32 CurrSepSmpl = 0;
-        for (const auto& SepSam : resources.separate_samplers)
-        {
-            new (&GetSepSmplr(CurrSepSmpl++))
-                SPIRVShaderResourceAttribs(Compiler,
-                                           SepSam,
-                                           ResourceNamesPool.CopyString(SepSam.name),
-                                           SPIRVShaderResourceAttribs::ResourceType::SeparateSampler);
-        }
-        VERIFY_EXPR(CurrSepSmpl == GetNumSepSmplrs());
     }
+    VERIFY_EXPR(CurrRes == GetTotalResources());
 
+    if (CombinedSamplerSuffix != nullptr)
     {
-        Uint32 CurrSepImg = 0;
-        for (const auto& SepImg : resources.separate_images)
+        const auto NumSepSmpls = GetNumSepSmplrs();
+        for (Uint32 CurrSepImg = 0; CurrSepImg < GetNumSepImgs(); ++CurrSepImg)
         {
-            const auto& type    = Compiler.get_type(SepImg.type_id);
-            auto        ResType = type.image.dim == spv::DimBuffer ?
-                SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer :
-                SPIRVShaderResourceAttribs::ResourceType::SeparateImage;
+            auto& SepImg = GetSepImg(CurrSepImg);
 
-            Uint32 SamplerInd = SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd;
-            if (CombinedSamplerSuffix != nullptr)
+            Uint32 SamplerInd = 0;
+            for (; SamplerInd < NumSepSmpls; ++SamplerInd)
             {
-                auto NumSepSmpls = GetNumSepSmplrs();
-                for (SamplerInd = 0; SamplerInd < NumSepSmpls; ++SamplerInd)
+                auto& SepSmplr = GetSepSmplr(SamplerInd);
+                if (StreqSuff(SepSmplr.Name, SepImg.Name, CombinedSamplerSuffix))
                 {
-                    auto& SepSmplr = GetSepSmplr(SamplerInd);
-                    if (StreqSuff(SepSmplr.Name, SepImg.name.c_str(), CombinedSamplerSuffix))
-                    {
-                        SepSmplr.AssignSeparateImage(CurrSepImg);
-                        break;
-                    }
-                }
-                if (SamplerInd == NumSepSmpls)
-                    SamplerInd = SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd;
-                else
-                {
-                    if (ResType == SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer)
-                    {
-                        LOG_WARNING_MESSAGE("Combined image sampler assigned to uniform texel buffer '", SepImg.name, "' will be ignored");
-                        SamplerInd = SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd;
-                    }
+                    SepSmplr.AssignSeparateImage(CurrSepImg);
+                    break;
                 }
             }
-            auto* pNewSepImg = new (&GetSepImg(CurrSepImg++))
-                SPIRVShaderResourceAttribs(Compiler,
-                                           SepImg,
-                                           ResourceNamesPool.CopyString(SepImg.name),
-                                           ResType,
-                                           SamplerInd);
-            if (ResType == SPIRVShaderResourceAttribs::ResourceType::SeparateImage && pNewSepImg->IsValidSepSamplerAssigned())
+            if (SamplerInd == NumSepSmpls)
+                continue;
+
+            if (SepImg.Type == SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer)
             {
-#ifdef DILIGENT_DEVELOPMENT
-                const auto& SepSmplr = GetSepSmplr(pNewSepImg->GetAssignedSepSamplerInd());
-                DEV_CHECK_ERR(SepSmplr.ArraySize == 1 || SepSmplr.ArraySize == pNewSepImg->ArraySize,
-                              "Array size (", SepSmplr.ArraySize, ") of separate sampler variable '",
-                              SepSmplr.Name, "' must be equal to 1 or be the same as the array size (", pNewSepImg->ArraySize,
-                              ") of separate image variable '", pNewSepImg->Name, "' it is assigned to");
-#endif
+                LOG_WARNING_MESSAGE("Combined image sampler assigned to uniform texel buffer '", SepImg.Name, "' will be ignored");
+                continue;
             }
-        }
-        VERIFY_EXPR(CurrSepImg == GetNumSepImgs());
-    }
-
-    {
-        Uint32 CurrSubpassInput = 0;
-        for (const auto& SubpassInput : resources.subpass_inputs)
-        {
-            new (&GetInptAtt(CurrSubpassInput++))
-                SPIRVShaderResourceAttribs(Compiler,
-                                           SubpassInput,
-                                           ResourceNamesPool.CopyString(SubpassInput.name),
-                                           SPIRVShaderResourceAttribs::ResourceType::InputAttachment);
-        }
-        VERIFY_EXPR(CurrSubpassInput == GetNumInptAtts());
-    }
 
-    {
-        Uint32 CurrAccelStruct = 0;
-        for (const auto& AccelStruct : resources.acceleration_structures)
-        {
-            new (&GetAccelStruct(CurrAccelStruct++))
-                SPIRVShaderResourceAttribs(Compiler,
-                                           AccelStruct,
-                                           ResourceNamesPool.CopyString(AccelStruct.name),
-                                           SPIRVShaderResourceAttribs::ResourceType::AccelerationStructure);
+            SepImg.AssignSeparateSampler(SamplerInd);
+#ifdef DILIGENT_DEVELOPMENT
+            const auto& SepSmplr = GetSepSmplr(SamplerInd);
+            DEV_CHECK_ERR(SepSmplr.ArraySize == 1 || SepSmplr.ArraySize == SepImg.ArraySize,
+                          "Array size (", SepSmplr.ArraySize, ") of separate sampler variable '",
+                          SepSmplr.Name, "' must be equal to 1 or be the same as the array size (", SepImg.ArraySize,
+                          ") of separate image variable '", SepImg.Name, "' it is assigned to");
+#endif
         }
-        VERIFY_EXPR(CurrAccelStruct == GetNumAccelStructs());
     }
 
-    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please initialize SPIRVShaderResourceAttribs for the new resource type here");
-
     if (CombinedSamplerSuffix != nullptr)
     {
         m_CombinedSamplerSuffix = ResourceNamesPool.CopyString(CombinedSamplerSuffix);
@@ -570,13 +558,12 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
     if (LoadShaderStageInputs)
     {
         Uint32 CurrStageInput = 0;
-        for (const auto& Input : resources.stage_inputs)
+        for (const auto& Input : Data.StageInputs)
         {
-            if (Compiler.has_decoration(Input.id, spv::Decoration::DecorationHlslSemanticGOOGLE))
+            if (Input.HasSemantic)
             {
-                const auto& Semantic = Compiler.get_decoration_string(Input.id, spv::Decoration::DecorationHlslSemanticGOOGLE);
                 new (&GetShaderStageInputAttribs(CurrStageInput++))
-                    SPIRVShaderStageInputAttribs(ResourceNamesPool.CopyString(Semantic), GetDecorationOffset(Compiler, Input, spv::Decoration::DecorationLocation));
+                    SPIRVShaderStageInputAttribs(ResourceNamesPool.CopyString(Input.Semantic), Input.LocationDecorationOffset);
             }
         }
         VERIFY_EXPR(CurrStageInput == GetNumShaderStageInputs());
@@ -0,0 +1,459 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Serialization of SPIRVShaderResources. This file intentionally does not depend on SPIRV-Cross
+// so that the resources can be loaded without reflecting the SPIRV binary.
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#include "SPIRVShaderResources.hpp"
+#include "ShaderBytecodeCache.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// The serialized data is laid out as follows (all offsets are relative to the beginning of the data):
+//
+//  | Header | Resources (SerializedResourceAttribs) | Stage inputs (SerializedStageInputAttribs) | Strings |
+//
+// Resources are stored in the same order as in SPIRVShaderResources memory buffer, so that
+// the counters in the header are sufficient to restore the resource type offsets.
+// Names are stored as offsets into the null-terminated string table.
+
+constexpr Uint32 SerializedResourcesMagic = 0x46525053; // "SPRF"
+constexpr Uint32 InvalidStringOffset      = ~Uint32{0};
+
+// Resource groups in the order they are stored in the memory buffer
+enum RESOURCE_GROUP : Uint32
+{
+    RESOURCE_GROUP_UB = 0,
+    RESOURCE_GROUP_SB,
+    RESOURCE_GROUP_IMG,
+    RESOURCE_GROUP_SMPLD_IMG,
+    RESOURCE_GROUP_AC,
+    RESOURCE_GROUP_SEP_SMPLR,
+    RESOURCE_GROUP_SEP_IMG,
+    RESOURCE_GROUP_INPT_ATT,
+    RESOURCE_GROUP_ACCEL_STRUCT,
+    RESOURCE_GROUP_COUNT
+};
+static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please add the new resource group, if needed");
+
+struct SerializedResourcesHeader
+{
+    Uint32 Magic;
+    Uint32 Version;
+    Uint32 DataSize;
+    Uint32 ShaderType;
+    Uint64 SPIRVHashLo;
+    Uint64 SPIRVHashHi;
+    Uint32 SPIRVSize; // In words
+    Uint32 IsHLSLSource;
+    Uint32 ResourceCounts[RESOURCE_GROUP_COUNT];
+    Uint32 NumStageInputs;
+    Uint32 EntryPointOffset;
+    Uint32 CombinedSamplerSuffixOffset;
+    Uint32 StringsSize;
+    Uint32 Reserved;
+};
+static_assert(sizeof(SerializedResourcesHeader) == 96, "Changing the header requires incrementing SerializationVersion");
+
+struct SerializedResourceAttribs
+{
+    Uint32 NameOffset;
+    Uint16 ArraySize;
+    Uint8  Type;
+    Uint8  ResourceDimAndMS; // Bits 0-6: resource dimension, bit 7: multisample flag
+    Uint32 SepSmplrOrImgInd;
+    Uint32 BindingDecorationOffset;
+    Uint32 DescriptorSetDecorationOffset;
+    Uint32 BufferStaticSize;
+    Uint32 BufferStride;
+};
+static_assert(sizeof(SerializedResourceAttribs) == 28, "Changing the resource attribs requires incrementing SerializationVersion");
+
+struct SerializedStageInputAttribs
+{
+    Uint32 SemanticOffset;
+    Uint32 LocationDecorationOffset;
+};
+static_assert(sizeof(SerializedStageInputAttribs) == 8, "Changing the stage input attribs requires incrementing SerializationVersion");
+
+constexpr Uint8 MultisampleFlag = 0x80;
+
+bool IsResourceTypeAllowedInGroup(Uint32 Group, Uint8 Type)
+{
+    using ResourceType = SPIRVShaderResourceAttribs::ResourceType;
+    switch (Group)
+    {
+        // clang-format off
+        case RESOURCE_GROUP_UB:           return Type == ResourceType::UniformBuffer;
+        case RESOURCE_GROUP_SB:           return Type == ResourceType::ROStorageBuffer || Type == ResourceType::RWStorageBuffer;
+        case RESOURCE_GROUP_IMG:          return Type == ResourceType::StorageImage    || Type == ResourceType::StorageTexelBuffer;
+        case RESOURCE_GROUP_SMPLD_IMG:    return Type == ResourceType::SampledImage    || Type == ResourceType::UniformTexelBuffer;
+        case RESOURCE_GROUP_AC:           return Type == ResourceType::AtomicCounter;
+        case RESOURCE_GROUP_SEP_SMPLR:    return Type == ResourceType::SeparateSampler;
+        case RESOURCE_GROUP_SEP_IMG:      return Type == ResourceType::SeparateImage   || Type == ResourceType::UniformTexelBuffer;
+        case RESOURCE_GROUP_INPT_ATT:     return Type == ResourceType::InputAttachment;
+        case RESOURCE_GROUP_ACCEL_STRUCT: return Type == ResourceType::AccelerationStructure;
+        // clang-format on
+        default:
+            return false;
+    }
+}
+
+// Verifies the structure of the serialized data and reads the header.
+// Returns null on success and the description of the problem otherwise.
+const char* ParseSerializedData(const void* pData, size_t DataSize, SerializedResourcesHeader& Header)
+{
+    if (pData == nullptr || DataSize < sizeof(Header))
+        return "the data is too small";
+
+    // The data is not required to be aligned
+    memcpy(&Header, pData, sizeof(Header));
+
+    if (Header.Magic != SerializedResourcesMagic)
+        return "invalid magic number";
+    if (Header.Version != SPIRVShaderResources::SerializationVersion)
+        return "unsupported version";
+    if (Header.DataSize != DataSize)
+        return "data size mismatch";
+
+    constexpr Uint64 MaxCount       = std::numeric_limits<Uint16>::max();
+    Uint64           TotalResources = 0;
+    for (Uint32 g = 0; g < RESOURCE_GROUP_COUNT; ++g)
+        TotalResources += Header.ResourceCounts[g];
+    if (TotalResources > MaxCount || Header.NumStageInputs > MaxCount)
+        return "too many resources";
+
+    const auto ExpectedSize =
+        sizeof(Header) +
+        TotalResources * sizeof(SerializedResourceAttribs) +
+        Uint64{Header.NumStageInputs} * sizeof(SerializedStageInputAttribs) +
+        Uint64{Header.StringsSize};
+    if (ExpectedSize != DataSize)
+        return "inconsistent data size";
+
+    const auto* pBytes   = static_cast<const Uint8*>(pData);
+    const auto* pStrings = pBytes + DataSize - Header.StringsSize;
+    // Null-terminated last string guarantees that every string in the table is terminated
+    if (Header.StringsSize == 0 || pStrings[Header.StringsSize - 1] != 0)
+        return "string table is not null-terminated";
+    if (Header.EntryPointOffset >= Header.StringsSize)
+        return "invalid entry point offset";
+    if (Header.CombinedSamplerSuffixOffset != InvalidStringOffset && Header.CombinedSamplerSuffixOffset >= Header.StringsSize)
+        return "invalid combined sampler suffix offset";
+
+    const auto* pSrcRes = pBytes + sizeof(Header);
+    for (Uint32 g = 0; g < RESOURCE_GROUP_COUNT; ++g)
+    {
+        for (Uint32 r = 0; r < Header.ResourceCounts[g]; ++r, pSrcRes += sizeof(SerializedResourceAttribs))
+        {
+            SerializedResourceAttribs Res;
+            memcpy(&Res, pSrcRes, sizeof(Res));
+            if (Res.NameOffset >= Header.StringsSize)
+                return "invalid resource name offset";
+            if (!IsResourceTypeAllowedInGroup(g, Res.Type))
+                return "invalid resource type";
+            if ((Res.ResourceDimAndMS & ~MultisampleFlag) >= RESOURCE_DIM_NUM_DIMENSIONS)
+                return "invalid resource dimension";
+            if (Res.BindingDecorationOffset >= Header.SPIRVSize || Res.DescriptorSetDecorationOffset >= Header.SPIRVSize)
+                return "decoration offset is out of range";
+            if (Res.SepSmplrOrImgInd != SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd)
+            {
+                if (g == RESOURCE_GROUP_SEP_IMG && Res.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateImage)
+                {
+                    if (Res.SepSmplrOrImgInd >= Header.ResourceCounts[RESOURCE_GROUP_SEP_SMPLR])
+                        return "invalid separate sampler index";
+                }
+                else if (g == RESOURCE_GROUP_SEP_SMPLR)
+                {
+                    if (Res.SepSmplrOrImgInd >= Header.ResourceCounts[RESOURCE_GROUP_SEP_IMG])
+                        return "invalid separate image index";
+                }
+                else
+                    return "only separate images and samplers can reference each other";
+            }
+        }
+    }
+
+    const auto* pSrcInput = pSrcRes;
+    for (Uint32 i = 0; i < Header.NumStageInputs; ++i, pSrcInput += sizeof(SerializedStageInputAttribs))
+    {
+        SerializedStageInputAttribs Input;
+        memcpy(&Input, pSrcInput, sizeof(Input));
+        if (Input.SemanticOffset >= Header.StringsSize)
+            return "invalid semantic offset";
+        if (Input.LocationDecorationOffset >= Header.SPIRVSize)
+            return "decoration offset is out of range";
+    }
+
+    return nullptr;
+}
+
+ShaderBytecodeCache::Key ComputeSPIRVHash(const std::vector<uint32_t>& spirv_binary)
+{
+    return ShaderBytecodeCache::KeyBuilder{}.Update(spirv_binary.data(), spirv_binary.size() * sizeof(uint32_t)).Finalize();
+}
+
+} // namespace
+
+void SPIRVShaderResources::Serialize(const std::vector<uint32_t>& spirv_binary,
+                                     const std::string&           EntryPoint,
+                                     std::vector<Uint8>&          Data) const
+{
+    std::vector<char> Strings;
+
+    auto AddString = [&Strings](const char* Str) {
+        const auto Offset = static_cast<Uint32>(Strings.size());
+        Strings.insert(Strings.end(), Str, Str + strlen(Str) + 1);
+        return Offset;
+    };
+
+    const auto SPIRVHash = ComputeSPIRVHash(spirv_binary);
+
+    SerializedResourcesHeader Header;
+    memset(&Header, 0, sizeof(Header));
+    Header.Magic        = SerializedResourcesMagic;
+    Header.Version      = SerializationVersion;
+    Header.ShaderType   = static_cast<Uint32>(m_ShaderType);
+    Header.SPIRVHashLo  = SPIRVHash.Lo;
+    Header.SPIRVHashHi  = SPIRVHash.Hi;
+    Header.SPIRVSize    = static_cast<Uint32>(spirv_binary.size());
+    Header.IsHLSLSource = m_IsHLSLSource ? 1 : 0;
+
+    // clang-format off
+    Header.ResourceCounts[RESOURCE_GROUP_UB]           = GetNumUBs();
+    Header.ResourceCounts[RESOURCE_GROUP_SB]           = GetNumSBs();
+    Header.ResourceCounts[RESOURCE_GROUP_IMG]          = GetNumImgs();
+    Header.ResourceCounts[RESOURCE_GROUP_SMPLD_IMG]    = GetNumSmpldImgs();
+    Header.ResourceCounts[RESOURCE_GROUP_AC]           = GetNumACs();
+    Header.ResourceCounts[RESOURCE_GROUP_SEP_SMPLR]    = GetNumSepSmplrs();
+    Header.ResourceCounts[RESOURCE_GROUP_SEP_IMG]      = GetNumSepImgs();
+    Header.ResourceCounts[RESOURCE_GROUP_INPT_ATT]     = GetNumInptAtts();
+    Header.ResourceCounts[RESOURCE_GROUP_ACCEL_STRUCT] = GetNumAccelStructs();
+    // clang-format on
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please set the new resource type counter here");
+
+    Header.NumStageInputs              = GetNumShaderStageInputs();
+    Header.EntryPointOffset            = AddString(EntryPoint.c_str());
+    Header.CombinedSamplerSuffixOffset = m_CombinedSamplerSuffix != nullptr ? AddString(m_CombinedSamplerSuffix) : InvalidStringOffset;
+
+    std::vector<SerializedResourceAttribs> Resources(GetTotalResources());
+    for (Uint32 n = 0; n < GetTotalResources(); ++n)
+    {
+        const auto& SrcRes = GetResource(n);
+        auto&       DstRes = Resources[n];
+        DstRes.NameOffset       = AddString(SrcRes.Name);
+        DstRes.ArraySize        = SrcRes.ArraySize;
+        DstRes.Type             = SrcRes.Type;
+        DstRes.ResourceDimAndMS = static_cast<Uint8>(SrcRes.ResourceDim | (SrcRes.IsMS ? MultisampleFlag : 0));
+        if (SrcRes.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateImage)
+            DstRes.SepSmplrOrImgInd = SrcRes.GetAssignedSepSamplerInd();
+        else if (SrcRes.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler)
+            DstRes.SepSmplrOrImgInd = SrcRes.GetAssignedSepImageInd();
+        else
+            DstRes.SepSmplrOrImgInd = SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd;
+        DstRes.BindingDecorationOffset       = SrcRes.BindingDecorationOffset;
+        DstRes.DescriptorSetDecorationOffset = SrcRes.DescriptorSetDecorationOffset;
+        DstRes.BufferStaticSize              = SrcRes.BufferStaticSize;
+        DstRes.BufferStride                  = SrcRes.BufferStride;
+    }
+
+    std::vector<SerializedStageInputAttribs> StageInputs(GetNumShaderStageInputs());
+    for (Uint32 i = 0; i < GetNumShaderStageInputs(); ++i)
+    {
+        const auto& SrcInput = GetShaderStageInputAttribs(i);
+        auto&       DstInput = StageInputs[i];
+
+        DstInput.SemanticOffset           = AddString(SrcInput.Semantic);
+        DstInput.LocationDecorationOffset = SrcInput.LocationDecorationOffset;
+    }
+
+    Header.StringsSize = static_cast<Uint32>(Strings.size());
+
+    const auto ResourcesSize   = Resources.size() * sizeof(SerializedResourceAttribs);
+    const auto StageInputsSize = StageInputs.size() * sizeof(SerializedStageInputAttribs);
+    const auto DataSize        = sizeof(Header) + ResourcesSize + StageInputsSize + Strings.size();
+    VERIFY_EXPR(DataSize <= std::numeric_limits<Uint32>::max());
+    Header.DataSize = static_cast<Uint32>(DataSize);
+
+    Data.resize(DataSize);
+    auto* pDst = Data.data();
+    memcpy(pDst, &Header, sizeof(Header));
+    pDst += sizeof(Header);
+    if (ResourcesSize != 0)
+        memcpy(pDst, Resources.data(), ResourcesSize);
+    pDst += ResourcesSize;
+    if (StageInputsSize != 0)
+        memcpy(pDst, StageInputs.data(), StageInputsSize);
+    pDst += StageInputsSize;
+    memcpy(pDst, Strings.data(), Strings.size());
+    VERIFY_EXPR(pDst + Strings.size() == Data.data() + Data.size());
+}
+
+bool SPIRVShaderResources::IsValidSerializedData(const void*                  pSerializedData,
+                                                 size_t                       SerializedDataSize,
+                                                 const std::vector<uint32_t>& spirv_binary,
+                                                 const ShaderDesc&            shaderDesc,
+                                                 const char*                  CombinedSamplerSuffix)
+{
+    SerializedResourcesHeader Header;
+    if (ParseSerializedData(pSerializedData, SerializedDataSize, Header) != nullptr)
+        return false;
+
+    if (Header.ShaderType != static_cast<Uint32>(shaderDesc.ShaderType))
+        return false;
+
+    const auto* pStrings = static_cast<const char*>(pSerializedData) + SerializedDataSize - Header.StringsSize;
+    if (Header.CombinedSamplerSuffixOffset != InvalidStringOffset)
+    {
+        if (CombinedSamplerSuffix == nullptr || strcmp(pStrings + Header.CombinedSamplerSuffixOffset, CombinedSamplerSuffix) != 0)
+            return false;
+    }
+    else if (CombinedSamplerSuffix != nullptr)
+        return false;
+
+    if (Header.SPIRVSize != spirv_binary.size())
+        return false;
+
+    const auto SPIRVHash = ComputeSPIRVHash(spirv_binary);
+    return Header.SPIRVHashLo == SPIRVHash.Lo && Header.SPIRVHashHi == SPIRVHash.Hi;
+}
+
+SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator& Allocator,
+                                           const void*       pSerializedData,
+                                           size_t            SerializedDataSize,
+                                           const ShaderDesc& shaderDesc,
+                                           bool              LoadShaderStageInputs,
+                                           std::string&      EntryPoint) :
+    m_ShaderType{shaderDesc.ShaderType}
+{
+    SerializedResourcesHeader Header;
+    if (const auto* Error = ParseSerializedData(pSerializedData, SerializedDataSize, Header))
+    {
+        LOG_ERROR_AND_THROW("Failed to load serialized resources of shader '", shaderDesc.Name, "': ", Error);
+    }
+    if (Header.ShaderType != static_cast<Uint32>(shaderDesc.ShaderType))
+    {
+        LOG_ERROR_AND_THROW("Serialized resources of shader '", shaderDesc.Name, "' were created for a different shader type");
+    }
+
+    m_IsHLSLSource = Header.IsHLSLSource != 0;
+
+    Uint32 NumResources = 0;
+    for (Uint32 g = 0; g < RESOURCE_GROUP_COUNT; ++g)
+        NumResources += Header.ResourceCounts[g];
+
+    const auto* pBytes     = static_cast<const Uint8*>(pSerializedData);
+    const auto* pSrcRes    = pBytes + sizeof(Header);
+    const auto* pSrcInputs = pSrcRes + NumResources * sizeof(SerializedResourceAttribs);
+    const auto* pStrings   = reinterpret_cast<const char*>(pBytes) + SerializedDataSize - Header.StringsSize;
+    const auto* pSuffix    = Header.CombinedSamplerSuffixOffset != InvalidStringOffset ? pStrings + Header.CombinedSamplerSuffixOffset : nullptr;
+
+    const Uint32 NumShaderStageInputs = LoadShaderStageInputs ? Header.NumStageInputs : 0;
+
+    size_t ResourceNamesPoolSize = 0;
+    for (Uint32 n = 0; n < NumResources; ++n)
+    {
+        Uint32 NameOffset = 0;
+        memcpy(&NameOffset, pSrcRes + n * sizeof(SerializedResourceAttribs) + offsetof(SerializedResourceAttribs, NameOffset), sizeof(NameOffset));
+        ResourceNamesPoolSize += strlen(pStrings + NameOffset) + 1;
+    }
+    for (Uint32 i = 0; i < NumShaderStageInputs; ++i)
+    {
+        Uint32 SemanticOffset = 0;
+        memcpy(&SemanticOffset, pSrcInputs + i * sizeof(SerializedStageInputAttribs) + offsetof(SerializedStageInputAttribs, SemanticOffset), sizeof(SemanticOffset));
+        ResourceNamesPoolSize += strlen(pStrings + SemanticOffset) + 1;
+    }
+    if (pSuffix != nullptr)
+        ResourceNamesPoolSize += strlen(pSuffix) + 1;
+
+    VERIFY_EXPR(shaderDesc.Name != nullptr);
+    ResourceNamesPoolSize += strlen(shaderDesc.Name) + 1;
+
+    ResourceCounters ResCounters;
+    // clang-format off
+    ResCounters.NumUBs          = Header.ResourceCounts[RESOURCE_GROUP_UB];
+    ResCounters.NumSBs          = Header.ResourceCounts[RESOURCE_GROUP_SB];
+    ResCounters.NumImgs         = Header.ResourceCounts[RESOURCE_GROUP_IMG];
+    ResCounters.NumSmpldImgs    = Header.ResourceCounts[RESOURCE_GROUP_SMPLD_IMG];
+    ResCounters.NumACs          = Header.ResourceCounts[RESOURCE_GROUP_AC];
+    ResCounters.NumSepSmplrs    = Header.ResourceCounts[RESOURCE_GROUP_SEP_SMPLR];
+    ResCounters.NumSepImgs      = Header.ResourceCounts[RESOURCE_GROUP_SEP_IMG];
+    ResCounters.NumInptAtts     = Header.ResourceCounts[RESOURCE_GROUP_INPT_ATT];
+    ResCounters.NumAccelStructs = Header.ResourceCounts[RESOURCE_GROUP_ACCEL_STRUCT];
+    // clang-format on
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please set the new resource type counter here");
+
+    StringPool ResourceNamesPool;
+    Initialize(Allocator, ResCounters, NumShaderStageInputs, ResourceNamesPoolSize, ResourceNamesPool);
+    VERIFY_EXPR(GetTotalResources() == NumResources);
+
+    for (Uint32 n = 0; n < NumResources; ++n)
+    {
+        SerializedResourceAttribs Res;
+        memcpy(&Res, pSrcRes + n * sizeof(SerializedResourceAttribs), sizeof(Res));
+        new (&GetResource(n))
+            SPIRVShaderResourceAttribs{
+                ResourceNamesPool.CopyString(pStrings + Res.NameOffset),
+                static_cast<SPIRVShaderResourceAttribs::ResourceType>(Res.Type),
+                Res.ArraySize,
+                static_cast<RESOURCE_DIMENSION>(Res.ResourceDimAndMS & ~MultisampleFlag),
+                (Res.ResourceDimAndMS & MultisampleFlag) != 0,
+                Res.SepSmplrOrImgInd,
+                Res.BindingDecorationOffset,
+                Res.DescriptorSetDecorationOffset,
+                Res.BufferStaticSize,
+                Res.BufferStride //
+            };
+    }
+
+    if (pSuffix != nullptr)
+        m_CombinedSamplerSuffix = ResourceNamesPool.CopyString(pSuffix);
+
+    m_ShaderName = ResourceNamesPool.CopyString(shaderDesc.Name);
+
+    for (Uint32 i = 0; i < NumShaderStageInputs; ++i)
+    {
+        SerializedStageInputAttribs Input;
+        memcpy(&Input, pSrcInputs + i * sizeof(SerializedStageInputAttribs), sizeof(Input));
+        new (&GetShaderStageInputAttribs(i))
+            SPIRVShaderStageInputAttribs{ResourceNamesPool.CopyString(pStrings + Input.SemanticOffset), Input.LocationDecorationOffset};
+    }
+
+    VERIFY(ResourceNamesPool.GetRemainingSize() == 0, "Names pool must be empty");
+
+    EntryPoint = pStrings + Header.EntryPointOffset;
+}
+
+} // namespace Diligent
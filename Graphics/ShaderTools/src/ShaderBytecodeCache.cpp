@@ -0,0 +1,576 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderBytecodeCache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+#include "FileWrapper.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+inline Uint64 RotL64(Uint64 x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+inline Uint64 FMix64(Uint64 k)
+{
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDull;
+    k ^= k >> 33;
+    k *= 0xC4CEB9FE1A85EC53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+constexpr Uint64 HashC1 = 0x87C37B91114253D5ull;
+constexpr Uint64 HashC2 = 0x4CF5AD432745937Full;
+
+constexpr Uint32 EntryMagic   = 0x43425344; // 'DSBC'
+constexpr Uint32 IndexMagic   = 0x49425344; // 'DSBI'
+constexpr Uint32 CacheVersion = 1;
+
+constexpr char IndexFileName[] = "index.dat";
+constexpr char EntryFileExt[]  = ".bin";
+
+struct EntryFileHeader
+{
+    Uint32 Magic         = EntryMagic;
+    Uint32 Version       = CacheVersion;
+    Uint64 KeyLo         = 0;
+    Uint64 KeyHi         = 0;
+    Uint64 BytecodeSize  = 0;
+    Uint64 AuxDataSize   = 0;
+    Uint64 PayloadHashLo = 0;
+    Uint64 PayloadHashHi = 0;
+};
+
+struct IndexFileHeader
+{
+    Uint32 Magic      = IndexMagic;
+    Uint32 Version    = CacheVersion;
+    Uint64 NumEntries = 0;
+    Uint64 UseCounter = 0;
+};
+
+struct IndexFileEntry
+{
+    Uint64 KeyLo   = 0;
+    Uint64 KeyHi   = 0;
+    Uint64 Size    = 0;
+    Uint64 LastUse = 0;
+};
+
+// Writes the data to a temporary file and renames it to the destination path,
+// so that readers never observe partially written files.
+bool WriteFileAtomically(const std::string& Path, const std::string& TmpPath, const void* const* ppData, const size_t* pSizes, size_t NumChunks)
+{
+    {
+        FileWrapper File{TmpPath.c_str(), EFileAccessMode::Overwrite};
+        if (!File)
+            return false;
+
+        bool Res = true;
+        for (size_t i = 0; i < NumChunks && Res; ++i)
+        {
+            if (pSizes[i] != 0)
+                Res = File->Write(ppData[i], pSizes[i]);
+        }
+        File.Close();
+
+        if (!Res)
+        {
+            FileSystem::DeleteFile(TmpPath.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(TmpPath.c_str(), Path.c_str()) != 0)
+    {
+        // On some platforms rename fails when the destination file exists
+        FileSystem::DeleteFile(Path.c_str());
+        if (std::rename(TmpPath.c_str(), Path.c_str()) != 0)
+        {
+            FileSystem::DeleteFile(TmpPath.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+
+void ShaderBytecodeCache::KeyBuilder::ProcessBlock(Uint64 Block)
+{
+    auto k1 = RotL64(Block * HashC1, 31) * HashC2;
+    m_H1 ^= k1;
+    m_H1 = (RotL64(m_H1, 27) + m_H2) * 5 + 0x52DCE729;
+
+    auto k2 = RotL64(Block * HashC2, 33) * HashC1;
+    m_H2 ^= k2;
+    m_H2 = (RotL64(m_H2, 31) + m_H1) * 5 + 0x38495AB5;
+}
+
+ShaderBytecodeCache::KeyBuilder& ShaderBytecodeCache::KeyBuilder::Update(const void* pData, size_t Size)
+{
+    VERIFY_EXPR(pData != nullptr || Size == 0);
+
+    const auto* pBytes = static_cast<const Uint8*>(pData);
+    const auto* pEnd   = pBytes + Size;
+    m_TotalBytes += Size;
+
+    // Complete the pending block
+    while (m_TailSize != 0 && pBytes < pEnd)
+    {
+        m_Tail |= Uint64{*(pBytes++)} << (m_TailSize * 8);
+        if (++m_TailSize == sizeof(Uint64))
+        {
+            ProcessBlock(m_Tail);
+            m_Tail     = 0;
+            m_TailSize = 0;
+        }
+    }
+
+    while (pEnd - pBytes >= static_cast<ptrdiff_t>(sizeof(Uint64)))
+    {
+        Uint64 Block;
+        memcpy(&Block, pBytes, sizeof(Block));
+        ProcessBlock(Block);
+        pBytes += sizeof(Uint64);
+    }
+
+    while (pBytes < pEnd)
+    {
+        m_Tail |= Uint64{*(pBytes++)} << (m_TailSize * 8);
+        ++m_TailSize;
+    }
+
+    return *this;
+}
+
+ShaderBytecodeCache::KeyBuilder& ShaderBytecodeCache::KeyBuilder::Update(const char* Str)
+{
+    if (Str == nullptr)
+        return UpdateValue(~Uint64{0});
+
+    const auto Len = strlen(Str);
+    UpdateValue(Uint64{Len});
+    return Update(Str, Len);
+}
+
+ShaderBytecodeCache::Key ShaderBytecodeCache::KeyBuilder::Finalize() const
+{
+    auto Builder = *this;
+    if (Builder.m_TailSize != 0)
+        Builder.ProcessBlock(Builder.m_Tail ^ HashC1);
+
+    auto h1 = Builder.m_H1 ^ m_TotalBytes;
+    auto h2 = Builder.m_H2 ^ m_TotalBytes;
+    h1 += h2;
+    h2 += h1;
+    h1 = FMix64(h1);
+    h2 = FMix64(h2);
+    h1 += h2;
+    h2 += h1;
+
+    Key k;
+    k.Lo = h1;
+    k.Hi = h2;
+    return k;
+}
+
+
+ShaderBytecodeCache::ShaderBytecodeCache(const char* Directory, Uint64 MaxSize) :
+    // clang-format off
+    m_Directory
+    {
+        [](const char* Dir)
+        {
+            std::string Path{Dir != nullptr ? Dir : ""};
+            if (!Path.empty() && Path.back() != '/' && Path.back() != '\\')
+                Path.push_back(FileSystem::GetSlashSymbol());
+            return Path;
+        }(Directory)
+    },
+    m_MaxSize{MaxSize},
+    // Temporary file names must be unique across processes that share the cache
+    m_TempFileCounter{static_cast<Uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count())}
+// clang-format on
+{
+    VERIFY(Directory != nullptr && *Directory != '\0', "Shader cache directory must not be empty");
+    LoadIndex();
+}
+
+ShaderBytecodeCache::~ShaderBytecodeCache()
+{
+    Flush();
+}
+
+std::string ShaderBytecodeCache::GetEntryPath(const Key& CacheKey) const
+{
+    static constexpr char HexDigits[] = "0123456789abcdef";
+
+    std::string Path = m_Directory;
+    Path.reserve(Path.length() + 32 + sizeof(EntryFileExt));
+    for (auto Val : {CacheKey.Hi, CacheKey.Lo})
+    {
+        for (int Shift = 60; Shift >= 0; Shift -= 4)
+            Path.push_back(HexDigits[(Val >> Shift) & 0xF]);
+    }
+    Path.append(EntryFileExt);
+    return Path;
+}
+
+void ShaderBytecodeCache::LoadIndex()
+{
+    const auto IndexPath = m_Directory + IndexFileName;
+    if (!FileSystem::FileExists(IndexPath.c_str()))
+        return;
+
+    FileWrapper File{IndexPath.c_str(), EFileAccessMode::Read};
+    if (!File)
+        return;
+
+    const auto FileSize = File->GetSize();
+
+    IndexFileHeader Header;
+    if (FileSize < sizeof(Header) ||
+        !File->Read(&Header, sizeof(Header)) ||
+        Header.Magic != IndexMagic ||
+        Header.Version != CacheVersion ||
+        Header.NumEntries != (FileSize - sizeof(Header)) / sizeof(IndexFileEntry))
+    {
+        LOG_WARNING_MESSAGE("Shader cache index '", IndexPath, "' is invalid and will be rebuilt");
+        return;
+    }
+
+    std::vector<IndexFileEntry> Entries(static_cast<size_t>(Header.NumEntries));
+    if (!Entries.empty() && !File->Read(Entries.data(), Entries.size() * sizeof(IndexFileEntry)))
+    {
+        LOG_WARNING_MESSAGE("Failed to read shader cache index '", IndexPath, "'");
+        return;
+    }
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    m_UseCounter = Header.UseCounter;
+    for (const auto& Entry : Entries)
+    {
+        Key CacheKey;
+        CacheKey.Lo = Entry.KeyLo;
+        CacheKey.Hi = Entry.KeyHi;
+
+        auto& Info   = m_Entries[CacheKey];
+        Info.Size    = Entry.Size;
+        Info.LastUse = Entry.LastUse;
+        m_Stats.TotalSize += Entry.Size;
+        m_UseCounter = std::max(m_UseCounter, Entry.LastUse);
+    }
+    m_Stats.NumEntries = static_cast<Uint32>(m_Entries.size());
+}
+
+bool ShaderBytecodeCache::Load(const Key& CacheKey, std::vector<Uint32>& Bytecode, std::vector<Uint8>* pAuxData)
+{
+    const auto Path = GetEntryPath(CacheKey);
+
+    bool   FileExists = FileSystem::FileExists(Path.c_str());
+    bool   IsValid    = false;
+    Uint64 FileSize   = 0;
+    if (FileExists)
+    {
+        FileWrapper File{Path.c_str(), EFileAccessMode::Read};
+        if (File)
+        {
+            FileSize = File->GetSize();
+
+            EntryFileHeader Header;
+            IsValid =
+                FileSize >= sizeof(Header) &&
+                File->Read(&Header, sizeof(Header)) &&
+                Header.Magic == EntryMagic &&
+                Header.Version == CacheVersion &&
+                Header.KeyLo == CacheKey.Lo &&
+                Header.KeyHi == CacheKey.Hi &&
+                Header.BytecodeSize % sizeof(Uint32) == 0 &&
+                // The sizes come from the file and are checked one by one so that corrupted values
+                // can't overflow the sum or cause huge allocations
+                Header.BytecodeSize <= FileSize - sizeof(Header) &&
+                Header.AuxDataSize == FileSize - sizeof(Header) - Header.BytecodeSize;
+
+            if (IsValid)
+            {
+                Bytecode.resize(static_cast<size_t>(Header.BytecodeSize / sizeof(Uint32)));
+
+                std::vector<Uint8> AuxData;
+                auto&              DstAuxData = pAuxData != nullptr ? *pAuxData : AuxData;
+                DstAuxData.resize(static_cast<size_t>(Header.AuxDataSize));
+
+                IsValid =
+                    (Bytecode.empty() || File->Read(Bytecode.data(), static_cast<size_t>(Header.BytecodeSize))) &&
+                    (DstAuxData.empty() || File->Read(DstAuxData.data(), DstAuxData.size()));
+
+                if (IsValid)
+                {
+                    KeyBuilder PayloadHasher;
+                    PayloadHasher.Update(Bytecode.data(), static_cast<size_t>(Header.BytecodeSize));
+                    PayloadHasher.Update(DstAuxData.data(), DstAuxData.size());
+                    const auto PayloadHash = PayloadHasher.Finalize();
+                    IsValid                = PayloadHash.Lo == Header.PayloadHashLo && PayloadHash.Hi == Header.PayloadHashHi;
+                }
+            }
+        }
+
+        if (!IsValid)
+        {
+            LOG_WARNING_MESSAGE("Shader cache entry '", Path, "' is corrupted and will be removed");
+            Bytecode.clear();
+            if (pAuxData != nullptr)
+                pAuxData->clear();
+        }
+    }
+
+    bool RemoveFile = false;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Entries.find(CacheKey);
+        if (IsValid)
+        {
+            ++m_Stats.NumHits;
+            if (it == m_Entries.end())
+            {
+                // The entry has been added by another process
+                it = m_Entries.emplace(CacheKey, EntryInfo{}).first;
+            }
+            m_Stats.TotalSize -= it->second.Size;
+            m_Stats.TotalSize += FileSize;
+            it->second.Size    = FileSize;
+            it->second.LastUse = ++m_UseCounter;
+        }
+        else
+        {
+            ++m_Stats.NumMisses;
+            if (it != m_Entries.end())
+            {
+                // The entry has been deleted externally or is corrupted
+                m_Stats.TotalSize -= it->second.Size;
+                m_Entries.erase(it);
+            }
+            RemoveFile = FileExists;
+        }
+        m_Stats.NumEntries = static_cast<Uint32>(m_Entries.size());
+        m_IndexDirty       = true;
+    }
+
+    if (RemoveFile)
+        FileSystem::DeleteFile(Path.c_str());
+
+    return IsValid;
+}
+
+void ShaderBytecodeCache::Store(const Key& CacheKey, const std::vector<Uint32>& Bytecode, const void* pAuxData, size_t AuxDataSize)
+{
+    VERIFY_EXPR(pAuxData != nullptr || AuxDataSize == 0);
+
+    std::string TmpPath;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (m_StoreFailed)
+            return;
+        TmpPath = m_Directory + std::to_string(m_TempFileCounter++) + ".tmp";
+    }
+
+    const auto BytecodeSize = Bytecode.size() * sizeof(Uint32);
+
+    KeyBuilder PayloadHasher;
+    PayloadHasher.Update(Bytecode.data(), BytecodeSize);
+    PayloadHasher.Update(pAuxData, AuxDataSize);
+    const auto PayloadHash = PayloadHasher.Finalize();
+
+    EntryFileHeader Header;
+    Header.KeyLo         = CacheKey.Lo;
+    Header.KeyHi         = CacheKey.Hi;
+    Header.BytecodeSize  = BytecodeSize;
+    Header.AuxDataSize   = AuxDataSize;
+    Header.PayloadHashLo = PayloadHash.Lo;
+    Header.PayloadHashHi = PayloadHash.Hi;
+
+    const void*  Chunks[]     = {&Header, Bytecode.data(), pAuxData};
+    const size_t ChunkSizes[] = {sizeof(Header), BytecodeSize, AuxDataSize};
+
+    const auto Path = GetEntryPath(CacheKey);
+    if (!WriteFileAtomically(Path, TmpPath, Chunks, ChunkSizes, _countof(Chunks)))
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (!m_StoreFailed)
+        {
+            LOG_WARNING_MESSAGE("Failed to write shader cache entry '", Path, "'. Make sure that the cache directory exists and is writable. "
+                                "No more entries will be added to the cache.");
+            m_StoreFailed = true;
+        }
+        return;
+    }
+
+    std::vector<Key> EvictedEntries;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        const auto EntrySize = Uint64{sizeof(Header) + BytecodeSize + AuxDataSize};
+
+        auto& Info = m_Entries[CacheKey];
+        m_Stats.TotalSize -= Info.Size;
+        m_Stats.TotalSize += EntrySize;
+        Info.Size    = EntrySize;
+        Info.LastUse = ++m_UseCounter;
+        ++m_Stats.NumStores;
+
+        if (m_Stats.TotalSize > m_MaxSize)
+            EvictedEntries = EvictEntries();
+
+        m_Stats.NumEntries = static_cast<Uint32>(m_Entries.size());
+        m_IndexDirty       = true;
+    }
+
+    for (const auto& EvictedKey : EvictedEntries)
+        FileSystem::DeleteFile(GetEntryPath(EvictedKey).c_str());
+}
+
+std::vector<ShaderBytecodeCache::Key> ShaderBytecodeCache::EvictEntries()
+{
+    std::vector<std::pair<Uint64, Key>> Entries;
+    Entries.reserve(m_Entries.size());
+    for (const auto& it : m_Entries)
+        Entries.emplace_back(it.second.LastUse, it.first);
+    std::sort(Entries.begin(), Entries.end(),
+              [](const std::pair<Uint64, Key>& lhs, const std::pair<Uint64, Key>& rhs) {
+                  return lhs.first < rhs.first;
+              });
+
+    // Evict slightly more than necessary so that every new entry does not trigger eviction
+    const auto TargetSize = m_MaxSize - m_MaxSize / 8;
+
+    std::vector<Key> EvictedEntries;
+    for (const auto& Entry : Entries)
+    {
+        if (m_Stats.TotalSize <= TargetSize)
+            break;
+
+        auto it = m_Entries.find(Entry.second);
+        VERIFY_EXPR(it != m_Entries.end());
+        m_Stats.TotalSize -= it->second.Size;
+        m_Entries.erase(it);
+        EvictedEntries.push_back(Entry.second);
+        ++m_Stats.NumEvictions;
+    }
+
+    return EvictedEntries;
+}
+
+void ShaderBytecodeCache::Flush()
+{
+    IndexFileHeader             Header;
+    std::vector<IndexFileEntry> Entries;
+    std::string                 TmpPath;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (!m_IndexDirty || m_StoreFailed)
+            return;
+
+        Header.NumEntries = m_Entries.size();
+        Header.UseCounter = m_UseCounter;
+
+        Entries.reserve(m_Entries.size());
+        for (const auto& it : m_Entries)
+        {
+            IndexFileEntry Entry;
+            Entry.KeyLo   = it.first.Lo;
+            Entry.KeyHi   = it.first.Hi;
+            Entry.Size    = it.second.Size;
+            Entry.LastUse = it.second.LastUse;
+            Entries.push_back(Entry);
+        }
+
+        TmpPath      = m_Directory + std::to_string(m_TempFileCounter++) + ".tmp";
+        m_IndexDirty = false;
+    }
+
+    const void*  Chunks[]     = {&Header, Entries.data()};
+    const size_t ChunkSizes[] = {sizeof(Header), Entries.size() * sizeof(IndexFileEntry)};
+
+    const auto IndexPath = m_Directory + IndexFileName;
+    if (!WriteFileAtomically(IndexPath, TmpPath, Chunks, ChunkSizes, _countof(Chunks)))
+    {
+        LOG_WARNING_MESSAGE("Failed to write shader cache index '", IndexPath, "'");
+    }
+}
+
+void ShaderBytecodeCache::Clear()
+{
+    std::vector<Key> Entries;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        Entries.reserve(m_Entries.size());
+        for (const auto& it : m_Entries)
+            Entries.push_back(it.first);
+
+        m_Entries.clear();
+        m_Stats.NumEntries = 0;
+        m_Stats.TotalSize  = 0;
+        m_IndexDirty       = false;
+    }
+
+    for (const auto& EntryKey : Entries)
+    {
+        const auto Path = GetEntryPath(EntryKey);
+        if (FileSystem::FileExists(Path.c_str()))
+            FileSystem::DeleteFile(Path.c_str());
+    }
+
+    const auto IndexPath = m_Directory + IndexFileName;
+    if (FileSystem::FileExists(IndexPath.c_str()))
+        FileSystem::DeleteFile(IndexPath.c_str());
+}
+
+ShaderBytecodeCacheStats ShaderBytecodeCache::GetStats() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_Stats;
+}
+
+} // namespace Diligent
@@ -0,0 +1,1167 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderPreprocessor.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ShaderToolsCommon.hpp"
+#include "DebugUtilities.hpp"
+#include "DataBlobImpl.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+inline bool IsIdentifierStart(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+inline bool IsIdentifierChar(char c)
+{
+    return IsIdentifierStart(c) || (c >= '0' && c <= '9');
+}
+
+inline bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+struct Token
+{
+    enum class TokenType : Uint8
+    {
+        Identifier,
+        Number,
+        String,
+        Punctuator,
+        Newline
+    };
+
+    TokenType   Type         = TokenType::Punctuator;
+    bool        LeadingSpace = false;
+    std::string Text;
+
+    // Names of the macros whose expansion produced this token. The token is never
+    // expanded by these macros again, which prevents infinite recursion.
+    std::vector<std::string> HideSet;
+
+    bool IsPunctuator(const char* Str) const
+    {
+        return Type == TokenType::Punctuator && Text == Str;
+    }
+
+    bool IsHidden(const std::string& Name) const
+    {
+        return std::find(HideSet.begin(), HideSet.end(), Name) != HideSet.end();
+    }
+};
+
+using TokenList = std::vector<Token>;
+
+// Replaces comments with spaces and removes line continuations. String literals are kept intact.
+std::string RemoveComments(const char* Source, size_t Length)
+{
+    std::string Result;
+    Result.reserve(Length);
+
+    const auto* const End = Source + Length;
+
+    const auto* c = Source;
+    while (c < End)
+    {
+        if (c[0] == '\\' && c + 1 < End && (c[1] == '\n' || (c[1] == '\r' && c + 2 < End && c[2] == '\n')))
+        {
+            c += c[1] == '\n' ? 2 : 3;
+        }
+        else if (c[0] == '/' && c + 1 < End && c[1] == '/')
+        {
+            while (c < End && *c != '\n')
+                ++c;
+            Result.push_back(' ');
+        }
+        else if (c[0] == '/' && c + 1 < End && c[1] == '*')
+        {
+            c += 2;
+            while (c + 1 < End && !(c[0] == '*' && c[1] == '/'))
+                ++c;
+            c = c + 1 < End ? c + 2 : End;
+            Result.push_back(' ');
+        }
+        else if (c[0] == '"')
+        {
+            const auto* LiteralStart = c++;
+            while (c < End && *c != '"' && *c != '\n')
+            {
+                if (*c == '\\' && c + 1 < End)
+                    ++c;
+                ++c;
+            }
+            if (c < End && *c == '"')
+                ++c;
+            Result.append(LiteralStart, c);
+        }
+        else
+        {
+            Result.push_back(*c++);
+        }
+    }
+
+    return Result;
+}
+
+void Tokenize(const char* c, const char* End, TokenList& Tokens)
+{
+    bool LeadingSpace = false;
+    while (c < End)
+    {
+        if (IsSpace(*c))
+        {
+            LeadingSpace = true;
+            ++c;
+            continue;
+        }
+
+        Token Tok;
+        Tok.LeadingSpace = LeadingSpace;
+        LeadingSpace     = false;
+
+        const auto* TokenStart = c;
+        if (*c == '\n')
+        {
+            Tok.Type = Token::TokenType::Newline;
+            ++c;
+        }
+        else if (IsIdentifierStart(*c))
+        {
+            Tok.Type = Token::TokenType::Identifier;
+            while (c < End && IsIdentifierChar(*c))
+                ++c;
+        }
+        else if (IsDigit(*c) || (*c == '.' && c + 1 < End && IsDigit(c[1])))
+        {
+            // Preprocessing number, e.g. 1.5e-3f or 0x10u
+            Tok.Type = Token::TokenType::Number;
+            ++c;
+            while (c < End)
+            {
+                if ((*c == '+' || *c == '-') && (c[-1] == 'e' || c[-1] == 'E' || c[-1] == 'p' || c[-1] == 'P'))
+                    ++c;
+                else if (IsIdentifierChar(*c) || *c == '.')
+                    ++c;
+                else
+                    break;
+            }
+        }
+        else if (*c == '"')
+        {
+            Tok.Type = Token::TokenType::String;
+            ++c;
+            while (c < End && *c != '"' && *c != '\n')
+            {
+                if (*c == '\\' && c + 1 < End)
+                    ++c;
+                ++c;
+            }
+            if (c < End && *c == '"')
+                ++c;
+        }
+        else
+        {
+            static constexpr const char* Punctuators[] =
+                {
+                    "<<=", ">>=", "...",
+                    "##", "<<", ">>", "<=", ">=", "==", "!=", "&&", "||", "++", "--",
+                    "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "->", "::" //
+                };
+
+            Tok.Type = Token::TokenType::Punctuator;
+
+            size_t Len = 1;
+            for (const auto* Punct : Punctuators)
+            {
+                const auto PunctLen = strlen(Punct);
+                if (static_cast<size_t>(End - c) >= PunctLen && strncmp(c, Punct, PunctLen) == 0)
+                {
+                    Len = PunctLen;
+                    break;
+                }
+            }
+            c += Len;
+        }
+        Tok.Text.assign(TokenStart, c);
+        Tokens.emplace_back(std::move(Tok));
+    }
+}
+
+// Appends the tokens to the string inserting spaces where the tokens would otherwise merge
+void AppendTokens(const TokenList& Tokens, std::string& Out)
+{
+    auto IsOperatorChar = [](char c) {
+        return strchr("+-*/%<>=&|^!#.:", c) != nullptr;
+    };
+
+    for (const auto& Tok : Tokens)
+    {
+        if (Tok.Type == Token::TokenType::Newline)
+        {
+            Out.push_back('\n');
+            continue;
+        }
+
+        if (!Out.empty() && Out.back() != '\n')
+        {
+            const auto Prev  = Out.back();
+            const auto First = Tok.Text.front();
+            if (Tok.LeadingSpace ||
+                (IsIdentifierChar(Prev) && IsIdentifierChar(First)) ||
+                (IsOperatorChar(Prev) && IsOperatorChar(First)))
+                Out.push_back(' ');
+        }
+        Out.append(Tok.Text);
+    }
+}
+
+struct Macro
+{
+    bool IsFunctionLike = false;
+    bool IsVariadic     = false;
+
+    // Parameter names. The last parameter of a variadic macro is __VA_ARGS__.
+    std::vector<std::string> Params;
+
+    TokenList Body;
+
+    int FindParam(const Token& Tok) const
+    {
+        if (Tok.Type != Token::TokenType::Identifier)
+            return -1;
+        for (size_t i = 0; i < Params.size(); ++i)
+        {
+            if (Params[i] == Tok.Text)
+                return static_cast<int>(i);
+        }
+        return -1;
+    }
+};
+
+class ShaderPreprocessor
+{
+public:
+    ShaderPreprocessor(IShaderSourceInputStreamFactory* pSourceFactory,
+                       std::string*                     pSource,
+                       std::vector<ShaderSourceFileInfo>* pFiles) :
+        m_pSourceFactory{pSourceFactory},
+        m_pSource{pSource},
+        m_pFiles{pFiles}
+    {}
+
+    void DefineMacros(const ShaderMacro* Macros)
+    {
+        if (Macros == nullptr)
+            return;
+
+        for (const auto* pMacro = Macros; pMacro->Name != nullptr && pMacro->Definition != nullptr; ++pMacro)
+        {
+            std::string Definition{pMacro->Name};
+            Definition += ' ';
+            Definition += pMacro->Definition;
+            ParseDefine(Definition.c_str(), Definition.c_str() + Definition.length());
+        }
+    }
+
+    void ProcessFile(const char* FilePath, const char* Source, size_t Length);
+
+private:
+    struct ConditionalBlock
+    {
+        // Whether the enclosing block is active
+        bool ParentActive = true;
+        // Whether one of the branches has already been taken
+        bool Taken = false;
+        // Whether the current branch is active
+        bool Active = true;
+        bool SeenElse = false;
+    };
+
+    template <typename... ArgsType>
+    void Error(const ArgsType&... Args) const
+    {
+        LOG_ERROR_AND_THROW("Failed to preprocess shader source: ",
+                            m_CurrentFile != nullptr && *m_CurrentFile != '\0' ? m_CurrentFile : "<source>",
+                            '(', m_CurrentLine, "): ", Args...);
+    }
+
+    const Macro* FindMacro(const std::string& Name) const
+    {
+        auto it = m_Macros.find(Name);
+        return it != m_Macros.end() ? &it->second : nullptr;
+    }
+
+    bool IsActive() const
+    {
+        return m_Conditionals.empty() || m_Conditionals.back().Active;
+    }
+
+    void ProcessDirective(const char* Line, const char* End, size_t ConditionalDepth);
+    void ParseDefine(const char* Start, const char* End);
+    void ProcessInclude(const char* Start, const char* End);
+    bool EvaluateCondition(const char* Start, const char* End);
+
+    void FlushText();
+    bool ReferencesMacros(const std::string& Text) const;
+
+    void ExpandMacros(TokenList Input, TokenList& Output);
+    TokenList SubstituteArgs(const Macro& M, const std::vector<TokenList>& Args);
+
+    IShaderSourceInputStreamFactory* const   m_pSourceFactory;
+    std::string* const                       m_pSource;
+    std::vector<ShaderSourceFileInfo>* const m_pFiles;
+
+    std::unordered_map<std::string, Macro> m_Macros;
+    std::vector<ConditionalBlock>          m_Conditionals;
+
+    // Contents of the include files
+    std::unordered_map<std::string, RefCntAutoPtr<IDataBlob>> m_IncludeFiles;
+    // Files marked with #pragma once
+    std::unordered_set<std::string> m_OnceFiles;
+
+    // Text lines that have not been expanded yet
+    std::string m_PendingText;
+
+    const char* m_CurrentFile   = nullptr;
+    size_t      m_CurrentLine   = 0;
+    Uint32      m_IncludeDepth  = 0;
+
+    static constexpr Uint32 MaxIncludeDepth = 64;
+};
+
+void ShaderPreprocessor::ProcessFile(const char* FilePath, const char* Source, size_t Length)
+{
+    const auto* const PrevFile = m_CurrentFile;
+    const auto        PrevLine = m_CurrentLine;
+    m_CurrentFile              = FilePath;
+    m_CurrentLine              = 0;
+
+    const auto CleanSource      = RemoveComments(Source, Length);
+    const auto ConditionalDepth = m_Conditionals.size();
+
+    const auto* c   = CleanSource.c_str();
+    const auto* End = c + CleanSource.length();
+    while (c < End)
+    {
+        ++m_CurrentLine;
+
+        const auto* LineEnd = std::find(c, End, '\n');
+
+        const auto* First = c;
+        while (First < LineEnd && IsSpace(*First))
+            ++First;
+
+        if (First < LineEnd && *First == '#')
+        {
+            FlushText();
+            ProcessDirective(First + 1, LineEnd, ConditionalDepth);
+        }
+        else if (First < LineEnd && IsActive() && m_pSource != nullptr)
+        {
+            // Blank lines and trailing whitespace are removed, so that changes in
+            // comments and formatting do not affect the output
+            auto* Last = LineEnd;
+            while (IsSpace(Last[-1]))
+                --Last;
+            m_PendingText.append(c, Last);
+            m_PendingText.push_back('\n');
+        }
+
+        c = LineEnd < End ? LineEnd + 1 : End;
+    }
+    FlushText();
+
+    if (m_Conditionals.size() != ConditionalDepth)
+        Error("unterminated conditional directive");
+
+    m_CurrentFile = PrevFile;
+    m_CurrentLine = PrevLine;
+}
+
+void ShaderPreprocessor::ProcessDirective(const char* c, const char* End, size_t ConditionalDepth)
+{
+    while (c < End && IsSpace(*c))
+        ++c;
+    const auto* NameStart = c;
+    while (c < End && IsIdentifierChar(*c))
+        ++c;
+    const std::string Directive{NameStart, c};
+    while (c < End && IsSpace(*c))
+        ++c;
+
+    if (Directive == "if" || Directive == "ifdef" || Directive == "ifndef")
+    {
+        ConditionalBlock Block;
+        Block.ParentActive = IsActive();
+        if (Block.ParentActive)
+        {
+            if (Directive == "if")
+            {
+                Block.Active = EvaluateCondition(c, End);
+            }
+            else
+            {
+                const auto* IdEnd = c;
+                while (IdEnd < End && IsIdentifierChar(*IdEnd))
+                    ++IdEnd;
+                if (IdEnd == c)
+                    Error("macro name expected after #", Directive);
+                const auto IsDefined = FindMacro(std::string{c, IdEnd}) != nullptr;
+                Block.Active         = Directive == "ifdef" ? IsDefined : !IsDefined;
+            }
+        }
+        else
+        {
+            Block.Active = false;
+        }
+        Block.Taken = Block.Active;
+        m_Conditionals.push_back(Block);
+        return;
+    }
+
+    if (Directive == "elif" || Directive == "else" || Directive == "endif")
+    {
+        if (m_Conditionals.size() <= ConditionalDepth)
+            Error('#', Directive, " without #if");
+
+        auto& Block = m_Conditionals.back();
+        if (Directive == "endif")
+        {
+            m_Conditionals.pop_back();
+            return;
+        }
+
+        if (Block.SeenElse)
+            Error('#', Directive, " after #else");
+
+        if (Directive == "else")
+        {
+            Block.SeenElse = true;
+            Block.Active   = Block.ParentActive && !Block.Taken;
+        }
+        else
+        {
+            // Condition must not be evaluated if a branch has already been taken
+            Block.Active = Block.ParentActive && !Block.Taken && EvaluateCondition(c, End);
+        }
+        Block.Taken = Block.Taken || Block.Active;
+        return;
+    }
+
+    if (!IsActive())
+        return;
+
+    if (Directive == "define")
+    {
+        ParseDefine(c, End);
+    }
+    else if (Directive == "undef")
+    {
+        const auto* IdEnd = c;
+        while (IdEnd < End && IsIdentifierChar(*IdEnd))
+            ++IdEnd;
+        if (IdEnd == c)
+            Error("macro name expected after #undef");
+        m_Macros.erase(std::string{c, IdEnd});
+    }
+    else if (Directive == "include")
+    {
+        ProcessInclude(c, End);
+    }
+    else if (Directive == "error")
+    {
+        Error("#error ", std::string{c, End});
+    }
+    else if (Directive == "pragma" && End - c >= 4 && strncmp(c, "once", 4) == 0)
+    {
+        if (m_CurrentFile != nullptr)
+            m_OnceFiles.emplace(m_CurrentFile);
+    }
+    else if (!Directive.empty() && m_pSource != nullptr)
+    {
+        // #version, #extension, #pragma, #line and any other directives are passed to the compiler
+        m_pSource->push_back('#');
+        m_pSource->append(Directive);
+        if (c < End)
+        {
+            m_pSource->push_back(' ');
+            m_pSource->append(c, End);
+        }
+        m_pSource->push_back('\n');
+    }
+}
+
+void ShaderPreprocessor::ParseDefine(const char* c, const char* End)
+{
+    const auto* NameStart = c;
+    while (c < End && IsIdentifierChar(*c))
+        ++c;
+    if (c == NameStart || !IsIdentifierStart(*NameStart))
+        Error("macro name expected in #define");
+
+    std::string Name{NameStart, c};
+    if (Name == "defined")
+        Error("'defined' cannot be used as a macro name");
+
+    Macro M;
+    // The macro is function-like only if the parenthesis immediately follows the name
+    if (c < End && *c == '(')
+    {
+        M.IsFunctionLike = true;
+        ++c;
+        while (true)
+        {
+            while (c < End && IsSpace(*c))
+                ++c;
+            if (c < End && *c == ')')
+            {
+                ++c;
+                break;
+            }
+
+            if (End - c >= 3 && strncmp(c, "...", 3) == 0)
+            {
+                M.IsVariadic = true;
+                M.Params.emplace_back("__VA_ARGS__");
+                c += 3;
+            }
+            else
+            {
+                const auto* ParamStart = c;
+                while (c < End && IsIdentifierChar(*c))
+                    ++c;
+                if (c == ParamStart)
+                    Error("invalid parameter list of macro '", Name, '\'');
+                M.Params.emplace_back(ParamStart, c);
+            }
+
+            while (c < End && IsSpace(*c))
+                ++c;
+            if (c < End && *c == ',' && !M.IsVariadic)
+                ++c;
+            else if (!(c < End && *c == ')'))
+                Error("invalid parameter list of macro '", Name, '\'');
+        }
+    }
+
+    Tokenize(c, End, M.Body);
+    if (!M.Body.empty())
+    {
+        M.Body.front().LeadingSpace = false;
+        if (M.Body.front().IsPunctuator("##") || M.Body.back().IsPunctuator("##"))
+            Error("'##' cannot appear at either end of macro expansion");
+    }
+
+    m_Macros[std::move(Name)] = std::move(M);
+}
+
+void ShaderPreprocessor::ProcessInclude(const char* c, const char* End)
+{
+    if (c >= End || (*c != '"' && *c != '<'))
+        Error("expected \"FILENAME\" or <FILENAME> after #include");
+
+    const auto  ClosingQuote = *c == '"' ? '"' : '>';
+    const auto* NameStart    = ++c;
+    while (c < End && *c != ClosingQuote)
+        ++c;
+    if (c == End)
+        Error("missing terminating ", ClosingQuote, " character");
+
+    const std::string FilePath{NameStart, c};
+    if (m_OnceFiles.find(FilePath) != m_OnceFiles.end())
+        return;
+
+    if (m_IncludeDepth >= MaxIncludeDepth)
+        Error("#include nested too deeply");
+
+    auto it = m_IncludeFiles.find(FilePath);
+    if (it == m_IncludeFiles.end())
+    {
+        RefCntAutoPtr<IFileStream> pSourceStream;
+        if (m_pSourceFactory != nullptr)
+            m_pSourceFactory->CreateInputStream2(FilePath.c_str(), CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pSourceStream);
+        if (pSourceStream == nullptr)
+            Error("failed to open include file '", FilePath, '\'');
+
+        RefCntAutoPtr<IDataBlob> pFileData{MakeNewRCObj<DataBlobImpl>{}(0)};
+        pSourceStream->ReadBlob(pFileData);
+        it = m_IncludeFiles.emplace(FilePath, std::move(pFileData)).first;
+
+        if (m_pFiles != nullptr)
+        {
+            ShaderSourceFileInfo FileInfo;
+            FileInfo.Path = FilePath;
+            FileInfo.Hash = ShaderBytecodeCache::KeyBuilder{}.Update(it->second->GetDataPtr(), it->second->GetSize()).Finalize();
+            m_pFiles->emplace_back(std::move(FileInfo));
+        }
+    }
+
+    ++m_IncludeDepth;
+    ProcessFile(it->first.c_str(), reinterpret_cast<const char*>(it->second->GetDataPtr()), it->second->GetSize());
+    --m_IncludeDepth;
+}
+
+bool ShaderPreprocessor::ReferencesMacros(const std::string& Text) const
+{
+    const auto* c   = Text.c_str();
+    const auto* End = c + Text.length();
+    while (c < End)
+    {
+        if (IsIdentifierStart(*c))
+        {
+            const auto* IdStart = c;
+            while (c < End && IsIdentifierChar(*c))
+                ++c;
+            if (m_Macros.find(std::string{IdStart, c}) != m_Macros.end())
+                return true;
+        }
+        else if (IsDigit(*c))
+        {
+            while (c < End && (IsIdentifierChar(*c) || *c == '.'))
+                ++c;
+        }
+        else if (*c == '"')
+        {
+            ++c;
+            while (c < End && *c != '"' && *c != '\n')
+            {
+                if (*c == '\\' && c + 1 < End)
+                    ++c;
+                ++c;
+            }
+            if (c < End)
+                ++c;
+        }
+        else
+        {
+            ++c;
+        }
+    }
+    return false;
+}
+
+void ShaderPreprocessor::FlushText()
+{
+    if (m_PendingText.empty())
+        return;
+
+    VERIFY_EXPR(m_pSource != nullptr);
+    // Most of the lines do not reference any macros and are copied as is
+    if (!ReferencesMacros(m_PendingText))
+    {
+        m_pSource->append(m_PendingText);
+    }
+    else
+    {
+        TokenList Tokens;
+        Tokenize(m_PendingText.c_str(), m_PendingText.c_str() + m_PendingText.length(), Tokens);
+        TokenList Expanded;
+        ExpandMacros(std::move(Tokens), Expanded);
+        AppendTokens(Expanded, *m_pSource);
+    }
+    m_PendingText.clear();
+}
+
+void ShaderPreprocessor::ExpandMacros(TokenList Input, TokenList& Output)
+{
+    // Tokens are processed from the back of the list, so that the expansion
+    // can be efficiently pushed back for rescanning
+    TokenList Pending{std::make_move_iterator(Input.rbegin()), std::make_move_iterator(Input.rend())};
+    while (!Pending.empty())
+    {
+        auto Tok = std::move(Pending.back());
+        Pending.pop_back();
+
+        const auto* pMacro = Tok.Type == Token::TokenType::Identifier ? FindMacro(Tok.Text) : nullptr;
+        if (pMacro == nullptr || Tok.IsHidden(Tok.Text))
+        {
+            Output.emplace_back(std::move(Tok));
+            continue;
+        }
+
+        TokenList Expansion;
+        if (!pMacro->IsFunctionLike)
+        {
+            Expansion = pMacro->Body;
+        }
+        else
+        {
+            // Function-like macro name that is not followed by the parenthesis is not an invocation
+            auto OpenParen = Pending.size();
+            while (OpenParen > 0 && Pending[OpenParen - 1].Type == Token::TokenType::Newline)
+                --OpenParen;
+            if (OpenParen == 0 || !Pending[OpenParen - 1].IsPunctuator("("))
+            {
+                Output.emplace_back(std::move(Tok));
+                continue;
+            }
+
+            std::vector<TokenList> Args(1);
+
+            int  Depth = 0;
+            auto Pos   = OpenParen - 1;
+            while (true)
+            {
+                if (Pos == 0)
+                    Error("unterminated argument list invoking macro '", Tok.Text, '\'');
+                auto& ArgTok = Pending[--Pos];
+                if (ArgTok.IsPunctuator(")") && Depth == 0)
+                    break;
+
+                if (ArgTok.IsPunctuator("("))
+                    ++Depth;
+                else if (ArgTok.IsPunctuator(")"))
+                    --Depth;
+
+                if (ArgTok.IsPunctuator(",") && Depth == 0 && !(pMacro->IsVariadic && Args.size() == pMacro->Params.size()))
+                {
+                    Args.emplace_back();
+                }
+                else if (ArgTok.Type == Token::TokenType::Newline)
+                {
+                    // Newlines inside the argument list are whitespace
+                    if (Pos > 0)
+                        Pending[Pos - 1].LeadingSpace = true;
+                }
+                else
+                {
+                    if (Args.back().empty())
+                        ArgTok.LeadingSpace = false;
+                    Args.back().emplace_back(std::move(ArgTok));
+                }
+            }
+            Pending.resize(Pos);
+
+            // A macro with no parameters is invoked with a single empty argument
+            if (Args.size() == 1 && Args[0].empty() && pMacro->Params.empty())
+                Args.clear();
+            // Variadic arguments may be omitted
+            if (pMacro->IsVariadic && Args.size() + 1 == pMacro->Params.size())
+                Args.emplace_back();
+            if (Args.size() != pMacro->Params.size())
+                Error("macro '", Tok.Text, "' requires ", pMacro->Params.size(), " arguments, but ", Args.size(), " given");
+
+            Expansion = SubstituteArgs(*pMacro, Args);
+        }
+
+        for (auto& ExpTok : Expansion)
+        {
+            ExpTok.HideSet.insert(ExpTok.HideSet.end(), Tok.HideSet.begin(), Tok.HideSet.end());
+            ExpTok.HideSet.push_back(Tok.Text);
+        }
+        if (!Expansion.empty())
+            Expansion.front().LeadingSpace = Tok.LeadingSpace;
+        else if (!Pending.empty())
+            Pending.back().LeadingSpace = Pending.back().LeadingSpace || Tok.LeadingSpace;
+
+        Pending.insert(Pending.end(), std::make_move_iterator(Expansion.rbegin()), std::make_move_iterator(Expansion.rend()));
+    }
+}
+
+TokenList ShaderPreprocessor::SubstituteArgs(const Macro& M, const std::vector<TokenList>& Args)
+{
+    std::vector<TokenList> ExpandedArgs(Args.size());
+    std::vector<bool>      IsArgExpanded(Args.size(), false);
+
+    const auto& Body = M.Body;
+
+    TokenList Result;
+    // Whether the left operand of ## produced no tokens
+    bool IsLeftOperandEmpty = false;
+    for (size_t i = 0; i < Body.size(); ++i)
+    {
+        const auto& BodyTok = Body[i];
+
+        if (BodyTok.IsPunctuator("##") && i + 1 < Body.size())
+        {
+            const auto& RightTok   = Body[++i];
+            const auto  RightParam = M.FindParam(RightTok);
+
+            TokenList RightOperand;
+            if (RightParam >= 0)
+                RightOperand = Args[RightParam];
+            else
+                RightOperand.push_back(RightTok);
+
+            if (!IsLeftOperandEmpty && !Result.empty() && !RightOperand.empty())
+            {
+                // Concatenate the tokens and re-tokenize the result
+                auto Pasted = Result.back().Text + RightOperand.front().Text;
+
+                TokenList PastedTokens;
+                Tokenize(Pasted.c_str(), Pasted.c_str() + Pasted.length(), PastedTokens);
+                if (PastedTokens.size() != 1)
+                    Error("pasting \"", Result.back().Text, "\" and \"", RightOperand.front().Text, "\" does not give a valid preprocessing token");
+                PastedTokens.front().LeadingSpace = Result.back().LeadingSpace;
+
+                Result.back() = std::move(PastedTokens.front());
+                Result.insert(Result.end(), RightOperand.begin() + 1, RightOperand.end());
+            }
+            else
+            {
+                Result.insert(Result.end(), RightOperand.begin(), RightOperand.end());
+            }
+            IsLeftOperandEmpty = Result.empty() || (RightOperand.empty() && IsLeftOperandEmpty);
+            continue;
+        }
+
+        if (BodyTok.IsPunctuator("#") && M.IsFunctionLike && i + 1 < Body.size() && M.FindParam(Body[i + 1]) >= 0)
+        {
+            // Stringification
+            const auto& Arg = Args[M.FindParam(Body[++i])];
+
+            std::string ArgText;
+            AppendTokens(Arg, ArgText);
+
+            Token Str;
+            Str.Type         = Token::TokenType::String;
+            Str.LeadingSpace = BodyTok.LeadingSpace;
+            Str.Text.push_back('"');
+            for (auto c : ArgText)
+            {
+                if (c == '"' || c == '\\')
+                    Str.Text.push_back('\\');
+                Str.Text.push_back(c);
+            }
+            Str.Text.push_back('"');
+            Result.emplace_back(std::move(Str));
+            IsLeftOperandEmpty = false;
+            continue;
+        }
+
+        const auto Param = M.FindParam(BodyTok);
+        if (Param < 0)
+        {
+            Result.push_back(BodyTok);
+            IsLeftOperandEmpty = false;
+            continue;
+        }
+
+        // Operands of ## are not macro-expanded
+        const auto IsPasteOperand = i + 1 < Body.size() && Body[i + 1].IsPunctuator("##");
+
+        const TokenList* pArg = &Args[Param];
+        if (!IsPasteOperand)
+        {
+            if (!IsArgExpanded[Param])
+            {
+                ExpandMacros(Args[Param], ExpandedArgs[Param]);
+                IsArgExpanded[Param] = true;
+            }
+            pArg = &ExpandedArgs[Param];
+        }
+
+        const auto FirstArgToken = Result.size();
+        Result.insert(Result.end(), pArg->begin(), pArg->end());
+        if (Result.size() > FirstArgToken)
+            Result[FirstArgToken].LeadingSpace = BodyTok.LeadingSpace;
+        IsLeftOperandEmpty = pArg->empty();
+    }
+
+    return Result;
+}
+
+class ConditionEvaluator
+{
+public:
+    explicit ConditionEvaluator(const TokenList& Tokens) :
+        m_Tokens{Tokens}
+    {}
+
+    bool Evaluate(Int64& Value)
+    {
+        Value = ParseConditional();
+        return !m_Error && m_Pos == m_Tokens.size();
+    }
+
+private:
+    const Token* Peek() const
+    {
+        return m_Pos < m_Tokens.size() ? &m_Tokens[m_Pos] : nullptr;
+    }
+
+    bool Accept(const char* Punct)
+    {
+        if (m_Pos < m_Tokens.size() && m_Tokens[m_Pos].IsPunctuator(Punct))
+        {
+            ++m_Pos;
+            return true;
+        }
+        return false;
+    }
+
+    Int64 ParseConditional()
+    {
+        const auto Cond = ParseBinary(0);
+        if (!Accept("?"))
+            return Cond;
+
+        const auto TrueVal = ParseConditional();
+        if (!Accept(":"))
+            m_Error = true;
+        const auto FalseVal = ParseConditional();
+        return Cond != 0 ? TrueVal : FalseVal;
+    }
+
+    static int GetPrecedence(const Token& Tok)
+    {
+        if (Tok.Type != Token::TokenType::Punctuator)
+            return -1;
+
+        static const std::unordered_map<std::string, int> Precedences =
+            {
+                {"||", 0},
+                {"&&", 1},
+                {"|", 2},
+                {"^", 3},
+                {"&", 4},
+                {"==", 5}, {"!=", 5},
+                {"<", 6}, {">", 6}, {"<=", 6}, {">=", 6},
+                {"<<", 7}, {">>", 7},
+                {"+", 8}, {"-", 8},
+                {"*", 9}, {"/", 9}, {"%", 9} //
+            };
+        auto it = Precedences.find(Tok.Text);
+        return it != Precedences.end() ? it->second : -1;
+    }
+
+    Int64 ParseBinary(int MinPrecedence)
+    {
+        auto Lhs = ParseUnary();
+        while (const auto* pOp = Peek())
+        {
+            const auto Precedence = GetPrecedence(*pOp);
+            if (Precedence < MinPrecedence)
+                break;
+            ++m_Pos;
+
+            const auto  Rhs = ParseBinary(Precedence + 1);
+            const auto& Op  = pOp->Text;
+            if (Op == "||")
+                Lhs = (Lhs != 0 || Rhs != 0) ? 1 : 0;
+            else if (Op == "&&")
+                Lhs = (Lhs != 0 && Rhs != 0) ? 1 : 0;
+            else if (Op == "|")
+                Lhs = Lhs | Rhs;
+            else if (Op == "^")
+                Lhs = Lhs ^ Rhs;
+            else if (Op == "&")
+                Lhs = Lhs & Rhs;
+            else if (Op == "==")
+                Lhs = Lhs == Rhs ? 1 : 0;
+            else if (Op == "!=")
+                Lhs = Lhs != Rhs ? 1 : 0;
+            else if (Op == "<")
+                Lhs = Lhs < Rhs ? 1 : 0;
+            else if (Op == ">")
+                Lhs = Lhs > Rhs ? 1 : 0;
+            else if (Op == "<=")
+                Lhs = Lhs <= Rhs ? 1 : 0;
+            else if (Op == ">=")
+                Lhs = Lhs >= Rhs ? 1 : 0;
+            else if (Op == "<<")
+                Lhs = static_cast<Int64>(static_cast<Uint64>(Lhs) << (Rhs & 63));
+            else if (Op == ">>")
+                Lhs = Lhs >> (Rhs & 63);
+            else if (Op == "+")
+                Lhs = static_cast<Int64>(static_cast<Uint64>(Lhs) + static_cast<Uint64>(Rhs));
+            else if (Op == "-")
+                Lhs = static_cast<Int64>(static_cast<Uint64>(Lhs) - static_cast<Uint64>(Rhs));
+            else if (Op == "*")
+                Lhs = static_cast<Int64>(static_cast<Uint64>(Lhs) * static_cast<Uint64>(Rhs));
+            else if (Rhs == 0)
+                m_Error = true;
+            else if (Op == "/")
+                Lhs = Lhs / Rhs;
+            else
+                Lhs = Lhs % Rhs;
+        }
+        return Lhs;
+    }
+
+    Int64 ParseUnary()
+    {
+        if (Accept("!"))
+            return ParseUnary() == 0 ? 1 : 0;
+        if (Accept("~"))
+            return ~ParseUnary();
+        if (Accept("-"))
+            return static_cast<Int64>(Uint64{0} - static_cast<Uint64>(ParseUnary()));
+        if (Accept("+"))
+            return ParseUnary();
+        return ParsePrimary();
+    }
+
+    Int64 ParsePrimary()
+    {
+        if (Accept("("))
+        {
+            const auto Value = ParseConditional();
+            if (!Accept(")"))
+                m_Error = true;
+            return Value;
+        }
+
+        const auto* pTok = Peek();
+        if (pTok == nullptr)
+        {
+            m_Error = true;
+            return 0;
+        }
+        ++m_Pos;
+
+        if (pTok->Type == Token::TokenType::Identifier)
+        {
+            // Identifiers that are not macros evaluate to zero
+            return 0;
+        }
+
+        if (pTok->Type == Token::TokenType::Number)
+        {
+            const auto* Str    = pTok->Text.c_str();
+            char*       NumEnd = nullptr;
+            const auto  Value  = static_cast<Int64>(strtoull(Str, &NumEnd, 0));
+            // Only integer suffixes are allowed
+            for (const auto* c = NumEnd; *c != '\0'; ++c)
+            {
+                if (*c != 'u' && *c != 'U' && *c != 'l' && *c != 'L')
+                    m_Error = true;
+            }
+            return Value;
+        }
+
+        m_Error = true;
+        return 0;
+    }
+
+    const TokenList& m_Tokens;
+
+    size_t m_Pos   = 0;
+    bool   m_Error = false;
+};
+
+bool ShaderPreprocessor::EvaluateCondition(const char* Start, const char* End)
+{
+    TokenList Tokens;
+    Tokenize(Start, End, Tokens);
+
+    // Replace the defined operators before the expansion
+    TokenList Condition;
+    for (size_t i = 0; i < Tokens.size(); ++i)
+    {
+        if (Tokens[i].Type != Token::TokenType::Identifier || Tokens[i].Text != "defined")
+        {
+            Condition.emplace_back(std::move(Tokens[i]));
+            continue;
+        }
+
+        const auto HasParen = i + 1 < Tokens.size() && Tokens[i + 1].IsPunctuator("(");
+        const auto NameIdx  = i + (HasParen ? 2 : 1);
+        if (NameIdx >= Tokens.size() || Tokens[NameIdx].Type != Token::TokenType::Identifier ||
+            (HasParen && (NameIdx + 1 >= Tokens.size() || !Tokens[NameIdx + 1].IsPunctuator(")"))))
+            Error("macro name expected after 'defined'");
+
+        Token Value;
+        Value.Type = Token::TokenType::Number;
+        Value.Text = FindMacro(Tokens[NameIdx].Text) != nullptr ? "1" : "0";
+        Condition.emplace_back(std::move(Value));
+
+        i = NameIdx + (HasParen ? 1 : 0);
+    }
+
+    TokenList Expanded;
+    ExpandMacros(std::move(Condition), Expanded);
+    if (Expanded.empty())
+        Error("#if with no expression");
+
+    Int64 Value = 0;
+    if (!ConditionEvaluator{Expanded}.Evaluate(Value))
+    {
+        std::string ExprText;
+        AppendTokens(Expanded, ExprText);
+        Error("invalid preprocessor expression '", ExprText, '\'');
+    }
+    return Value != 0;
+}
+
+} // namespace
+
+void PreprocessShaderSource(const ShaderCreateInfo&            ShaderCI,
+                            const ShaderMacro*                 ExtraMacros,
+                            std::string*                       pSource,
+                            std::vector<ShaderSourceFileInfo>* pFiles) noexcept(false)
+{
+    if (pSource != nullptr)
+        pSource->clear();
+    if (pFiles != nullptr)
+        pFiles->clear();
+
+    RefCntAutoPtr<IDataBlob> pFileData;
+
+    size_t      SourceLength = 0;
+    const auto* Source =
+        ReadShaderSourceFile(ShaderCI.Source, ShaderCI.pShaderSourceStreamFactory,
+                             ShaderCI.FilePath, pFileData, SourceLength);
+
+    const auto* FilePath = ShaderCI.Source == nullptr && ShaderCI.FilePath != nullptr ? ShaderCI.FilePath : "";
+    if (pFiles != nullptr)
+    {
+        ShaderSourceFileInfo FileInfo;
+        FileInfo.Path = FilePath;
+        FileInfo.Hash = ShaderBytecodeCache::KeyBuilder{}.Update(Source, SourceLength).Finalize();
+        pFiles->emplace_back(std::move(FileInfo));
+    }
+
+    ShaderPreprocessor Preprocessor{ShaderCI.pShaderSourceStreamFactory, pSource, pFiles};
+    if (ShaderCI.Desc.ShaderType != SHADER_TYPE_UNKNOWN)
+        Preprocessor.DefineMacros(GetShaderTypeMacros(ShaderCI.Desc.ShaderType));
+    Preprocessor.DefineMacros(ExtraMacros);
+    Preprocessor.DefineMacros(ShaderCI.Macros);
+    Preprocessor.ProcessFile(FilePath, Source, SourceLength);
+}
+
+} // namespace Diligent
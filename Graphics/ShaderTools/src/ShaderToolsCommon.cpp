@@ -25,6 +25,11 @@
  *  of the possibility of such damages.
  */
 
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
 #include "ShaderToolsCommon.hpp"
 #include "DebugUtilities.hpp"
 #include "DataBlobImpl.hpp"
@@ -154,4 +159,131 @@ void AppendShaderSourceCode(std::string& Source, const ShaderCreateInfo& ShaderC
     Source.append(SourceCode, SourceCodeLen);
 }
 
+
+namespace
+{
+
+// Finds the names of all files referenced by #include directives
+// that are not commented out.
+void FindIncludeDirectives(const char* Source, size_t SourceLength, std::vector<std::string>& Includes)
+{
+    const auto* const End = Source + SourceLength;
+
+    const auto* c           = Source;
+    bool        IsLineStart = true;
+    while (c < End)
+    {
+        if (*c == '/' && c + 1 < End && c[1] == '/')
+        {
+            // Single-line comment
+            while (c < End && *c != '\n')
+                ++c;
+            continue;
+        }
+
+        if (*c == '/' && c + 1 < End && c[1] == '*')
+        {
+            // Multi-line comment
+            c += 2;
+            while (c + 1 < End && !(c[0] == '*' && c[1] == '/'))
+                ++c;
+            c = c + 1 < End ? c + 2 : End;
+            continue;
+        }
+
+        if (*c == '\n')
+        {
+            IsLineStart = true;
+            ++c;
+            continue;
+        }
+
+        if (*c == ' ' || *c == '\t' || *c == '\r')
+        {
+            ++c;
+            continue;
+        }
+
+        if (*c == '#' && IsLineStart)
+        {
+            ++c;
+            while (c < End && (*c == ' ' || *c == '\t'))
+                ++c;
+
+            static constexpr char   IncludeStr[] = "include";
+            static constexpr size_t IncludeLen   = sizeof(IncludeStr) - 1;
+            if (static_cast<size_t>(End - c) > IncludeLen && strncmp(c, IncludeStr, IncludeLen) == 0)
+            {
+                c += IncludeLen;
+                while (c < End && (*c == ' ' || *c == '\t'))
+                    ++c;
+
+                if (c < End && (*c == '"' || *c == '<'))
+                {
+                    const auto  ClosingQuote = *c == '"' ? '"' : '>';
+                    const auto* NameStart    = ++c;
+                    while (c < End && *c != ClosingQuote && *c != '\n')
+                        ++c;
+                    if (c < End && *c == ClosingQuote)
+                        Includes.emplace_back(NameStart, c);
+                }
+            }
+        }
+
+        IsLineStart = false;
+        ++c;
+    }
+}
+
+} // namespace
+
+void ProcessShaderIncludes(const ShaderCreateInfo& ShaderCI, ShaderIncludeHandlerType IncludeHandler) noexcept(false)
+{
+    VERIFY_EXPR(IncludeHandler != nullptr);
+
+    std::vector<std::string> Includes;
+    {
+        RefCntAutoPtr<IDataBlob> pFileData;
+
+        size_t      SourceCodeLen = 0;
+        const auto* SourceCode =
+            ReadShaderSourceFile(ShaderCI.Source, ShaderCI.pShaderSourceStreamFactory,
+                                 ShaderCI.FilePath, pFileData, SourceCodeLen);
+        IncludeHandler(ShaderCI.Source == nullptr ? ShaderCI.FilePath : nullptr, SourceCode, SourceCodeLen);
+        FindIncludeDirectives(SourceCode, SourceCodeLen, Includes);
+    }
+
+    if (Includes.empty() || ShaderCI.pShaderSourceStreamFactory == nullptr)
+        return;
+
+    std::unordered_set<std::string> ProcessedFiles;
+    if (ShaderCI.Source == nullptr && ShaderCI.FilePath != nullptr)
+        ProcessedFiles.emplace(ShaderCI.FilePath);
+
+    // Process the files in the order in which they are referenced
+    std::reverse(Includes.begin(), Includes.end());
+    while (!Includes.empty())
+    {
+        auto FilePath = std::move(Includes.back());
+        Includes.pop_back();
+        if (!ProcessedFiles.emplace(FilePath).second)
+            continue;
+
+        RefCntAutoPtr<IFileStream> pSourceStream;
+        ShaderCI.pShaderSourceStreamFactory->CreateInputStream2(FilePath.c_str(), CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pSourceStream);
+        if (pSourceStream == nullptr)
+            continue;
+
+        RefCntAutoPtr<IDataBlob> pFileData{MakeNewRCObj<DataBlobImpl>{}(0)};
+        pSourceStream->ReadBlob(pFileData);
+        const auto* IncludeSource = reinterpret_cast<const char*>(pFileData->GetDataPtr());
+        const auto  IncludeLength = pFileData->GetSize();
+        IncludeHandler(FilePath.c_str(), IncludeSource, IncludeLength);
+
+        std::vector<std::string> NestedIncludes;
+        FindIncludeDirectives(IncludeSource, IncludeLength, NestedIncludes);
+        Includes.insert(Includes.end(), NestedIncludes.rbegin(), NestedIncludes.rend());
+    }
+}
+
 } // namespace Diligent
@@ -0,0 +1,62 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "RenderDevice.h"
+#include "PipelineState.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+// Common resources of the tests that bind shader resource variables of a single pipeline
+class ShaderResourceBindingTestBase
+{
+protected:
+    static constexpr Uint32 NumTextures = 4;
+
+    // Creates the pipeline from the common vertex shader, which uses cbConstants constant buffer,
+    // and the given pixel shader. Also creates the textures and the constant buffer.
+    static void InitResources(const char* TestName, const char* PSSource, const PipelineResourceLayoutDesc& ResourceLayout);
+    static void ReleaseResources();
+
+    static RefCntAutoPtr<IPipelineState> sm_pPSO;
+    static RefCntAutoPtr<IBuffer>        sm_pConstBuffer;
+
+    static std::array<RefCntAutoPtr<ITexture>, NumTextures> sm_pTextures;
+    static std::array<ITextureView*, NumTextures>           sm_pTextureSRVs;
+};
+
+} // namespace Testing
+
+} // namespace Diligent
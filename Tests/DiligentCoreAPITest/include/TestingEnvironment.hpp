@@ -103,6 +103,9 @@ public:
 
     static void SetErrorAllowance(int NumErrorsToAllow, const char* InfoMessage = nullptr);
 
+    // Logs the number of operations per second and records it as a test property
+    static void ReportThroughput(const char* Name, Uint32 NumOps, double ElapsedTime);
+
     void            SetDefaultCompiler(SHADER_COMPILER compiler);
     SHADER_COMPILER GetDefaultCompiler(SHADER_SOURCE_LANGUAGE lang) const;
 
@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* g_CSSource = R"(
+RWTexture2D<float4> g_tex2DUAV;
+
+[numthreads(16, 16, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    float4 Color = float4(0.0, 0.0, 0.0, 1.0);
+    for (int i = 0; i < ITERATIONS; ++i)
+        Color.rgb += sin(float3(DTid.xy, i) * 0.125);
+    g_tex2DUAV[DTid.xy] = Color;
+}
+)";
+
+constexpr Uint32 NumPipelines = 16;
+
+class AsyncPipelineStateTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        if (!pDevice->GetDeviceCaps().Features.ComputeShaders)
+            return;
+
+        for (Uint32 i = 0; i < NumPipelines; ++i)
+        {
+            const auto  Iterations = std::to_string(i + 1);
+            ShaderMacro Macros[]   = {{"ITERATIONS", Iterations.c_str()}, {}};
+
+            ShaderCreateInfo ShaderCI;
+            ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+            ShaderCI.ShaderCompiler  = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+            ShaderCI.EntryPoint      = "main";
+            ShaderCI.Desc.Name       = "Async pipeline state test CS";
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+            ShaderCI.Source          = g_CSSource;
+            ShaderCI.Macros          = Macros;
+
+            RefCntAutoPtr<IShader> pCS;
+            pDevice->CreateShader(ShaderCI, &pCS);
+            ASSERT_NE(pCS, nullptr);
+            sm_Shaders.emplace_back(std::move(pCS));
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_Shaders.clear();
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    // Creates the pipelines and returns the time spent in CreateComputePipelineState calls
+    static double CreatePipelines(PSO_CREATE_FLAGS                            Flags,
+                                  IPipelineState*                             pFallbackPSO,
+                                  std::vector<RefCntAutoPtr<IPipelineState>>& PSOs)
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+        PSOs.clear();
+        PSOs.resize(sm_Shaders.size());
+
+        Timer T;
+        for (size_t i = 0; i < sm_Shaders.size(); ++i)
+        {
+            ComputePipelineStateCreateInfo PSOCreateInfo;
+
+            const auto Name = std::string{"Async pipeline state test PSO "} + std::to_string(i);
+
+            auto& PSODesc = PSOCreateInfo.PSODesc;
+
+            PSODesc.Name                               = Name.c_str();
+            PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+
+            PSOCreateInfo.pCS               = sm_Shaders[i];
+            PSOCreateInfo.Flags             = Flags;
+            PSOCreateInfo.pAsyncFallbackPSO = pFallbackPSO;
+
+            pDevice->CreateComputePipelineState(PSOCreateInfo, &PSOs[i]);
+            EXPECT_NE(PSOs[i], nullptr);
+        }
+        return T.GetElapsedTime();
+    }
+
+    static std::vector<RefCntAutoPtr<IShader>> sm_Shaders;
+};
+
+std::vector<RefCntAutoPtr<IShader>> AsyncPipelineStateTest::sm_Shaders;
+
+TEST_F(AsyncPipelineStateTest, CreateAndWait)
+{
+    if (sm_Shaders.empty())
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    std::vector<RefCntAutoPtr<IPipelineState>> SyncPSOs;
+    const auto SyncTime = CreatePipelines(PSO_CREATE_FLAG_NONE, nullptr, SyncPSOs);
+    for (auto& pPSO : SyncPSOs)
+    {
+        ASSERT_NE(pPSO, nullptr);
+        EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+    }
+
+    std::vector<RefCntAutoPtr<IPipelineState>> AsyncPSOs;
+    const auto AsyncTime = CreatePipelines(PSO_CREATE_FLAG_ASYNCHRONOUS, nullptr, AsyncPSOs);
+
+    for (size_t i = 0; i < AsyncPSOs.size(); ++i)
+    {
+        auto& pPSO = AsyncPSOs[i];
+        ASSERT_NE(pPSO, nullptr);
+        EXPECT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+        EXPECT_TRUE(pPSO->IsCompatibleWith(SyncPSOs[i]));
+
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        pPSO->CreateShaderResourceBinding(&pSRB, true);
+        EXPECT_NE(pSRB, nullptr);
+        EXPECT_NE(pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_tex2DUAV"), nullptr);
+    }
+
+    LOG_INFO_MESSAGE("Time spent in CreateComputePipelineState for ", NumPipelines, " pipelines: synchronous: ",
+                     SyncTime * 1000.0, " ms, asynchronous: ", AsyncTime * 1000.0, " ms");
+    RecordProperty("SyncCreationTimeUs", std::to_string(static_cast<Int64>(SyncTime * 1e+6)));
+    RecordProperty("AsyncCreationTimeUs", std::to_string(static_cast<Int64>(AsyncTime * 1e+6)));
+}
+
+TEST_F(AsyncPipelineStateTest, SetPendingPipeline)
+{
+    if (sm_Shaders.empty())
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    std::vector<RefCntAutoPtr<IPipelineState>> FallbackPSOs;
+    CreatePipelines(PSO_CREATE_FLAG_NONE, nullptr, FallbackPSOs);
+    ASSERT_NE(FallbackPSOs[0], nullptr);
+
+    // Pending pipelines with a fallback are replaced by it, pending pipelines
+    // without a fallback are waited for. Either way the context must have a pipeline bound.
+    for (auto* pFallbackPSO : {static_cast<IPipelineState*>(FallbackPSOs[0]), static_cast<IPipelineState*>(nullptr)})
+    {
+        std::vector<RefCntAutoPtr<IPipelineState>> AsyncPSOs;
+        CreatePipelines(PSO_CREATE_FLAG_ASYNCHRONOUS, pFallbackPSO, AsyncPSOs);
+        for (auto& pPSO : AsyncPSOs)
+        {
+            ASSERT_NE(pPSO, nullptr);
+            pContext->SetPipelineState(pPSO);
+        }
+
+        for (auto& pPSO : AsyncPSOs)
+            EXPECT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+    }
+
+    // Pending pipelines may be released before they are ready
+    {
+        std::vector<RefCntAutoPtr<IPipelineState>> AsyncPSOs;
+        CreatePipelines(PSO_CREATE_FLAG_ASYNCHRONOUS, nullptr, AsyncPSOs);
+    }
+
+    pContext->Flush();
+}
+
+} // namespace
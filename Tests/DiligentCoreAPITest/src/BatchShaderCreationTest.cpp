@@ -0,0 +1,255 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_ShaderSource[] = R"(
+cbuffer Constants
+{
+    float4x4 g_WorldViewProj;
+    float4   g_Params[VARIANT + 1];
+};
+
+Texture2D    g_Texture;
+SamplerState g_Texture_sampler;
+
+struct PSInput
+{
+    float4 Pos : SV_POSITION;
+    float2 UV  : TEX_COORD;
+};
+
+void VSMain(in  uint    VertId : SV_VertexID,
+            out PSInput PSIn)
+{
+    float2 UV = float2(float(VertId & 1u), float(VertId >> 1u));
+    PSIn.Pos = mul(float4(UV * 2.0 - 1.0, 0.0, 1.0), g_WorldViewProj);
+    for (int i = 0; i <= VARIANT; ++i)
+        PSIn.Pos.xy += g_Params[i].xy * g_Params[i].zw;
+    PSIn.UV = UV;
+}
+
+float4 PSMain(in PSInput PSIn) : SV_Target
+{
+    float4 Color = float4(0.0, 0.0, 0.0, 0.0);
+    for (int i = 0; i <= VARIANT; ++i)
+        Color += g_Texture.Sample(g_Texture_sampler, PSIn.UV + g_Params[i].xy) * g_Params[i].w;
+    return Color;
+}
+)";
+
+// Checks that the shader created by CreateShaders() matches the shader created by CreateShader()
+void CompareShaders(IShader* pShader, IShader* pRefShader)
+{
+    ASSERT_NE(pShader, nullptr);
+    ASSERT_NE(pRefShader, nullptr);
+
+    EXPECT_EQ(pShader->GetDesc().ShaderType, pRefShader->GetDesc().ShaderType);
+    EXPECT_STREQ(pShader->GetDesc().Name, pRefShader->GetDesc().Name);
+
+    if (!TestingEnvironment::GetInstance()->GetDevice()->GetDeviceCaps().Features.ShaderResourceQueries)
+        return;
+
+    const auto NumResources = pRefShader->GetResourceCount();
+    ASSERT_EQ(pShader->GetResourceCount(), NumResources);
+    for (Uint32 r = 0; r < NumResources; ++r)
+    {
+        ShaderResourceDesc ResDesc, RefResDesc;
+        pShader->GetResourceDesc(r, ResDesc);
+        pRefShader->GetResourceDesc(r, RefResDesc);
+        EXPECT_STREQ(ResDesc.Name, RefResDesc.Name);
+        EXPECT_EQ(ResDesc.Type, RefResDesc.Type);
+        EXPECT_EQ(ResDesc.ArraySize, RefResDesc.ArraySize);
+    }
+}
+
+class BatchShaderCreationTest : public ::testing::Test
+{
+protected:
+    static constexpr Uint32 NumVariants = 32;
+
+    void SetUp() override
+    {
+        auto* pEnv = TestingEnvironment::GetInstance();
+
+        m_VariantStr.resize(NumVariants);
+        m_Macros.resize(NumVariants * 2 * 2);
+        m_ShaderCIs.resize(NumVariants * 2);
+        for (Uint32 i = 0; i < NumVariants; ++i)
+        {
+            m_VariantStr[i] = std::to_string(i);
+            for (Uint32 s = 0; s < 2; ++s)
+            {
+                auto* Macros = &m_Macros[(i * 2 + s) * 2];
+                Macros[0]    = {"VARIANT", m_VariantStr[i].c_str()};
+                Macros[1]    = {};
+
+                auto& ShaderCI                      = m_ShaderCIs[i * 2 + s];
+                ShaderCI.Source                     = g_ShaderSource;
+                ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+                ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+                ShaderCI.UseCombinedTextureSamplers = true;
+                ShaderCI.Macros                     = Macros;
+                ShaderCI.Desc.ShaderType            = s == 0 ? SHADER_TYPE_VERTEX : SHADER_TYPE_PIXEL;
+                ShaderCI.Desc.Name                  = s == 0 ? "Batch creation test VS" : "Batch creation test PS";
+                ShaderCI.EntryPoint                 = s == 0 ? "VSMain" : "PSMain";
+            }
+        }
+    }
+
+    std::vector<std::string>      m_VariantStr;
+    std::vector<ShaderMacro>      m_Macros;
+    std::vector<ShaderCreateInfo> m_ShaderCIs;
+};
+
+TEST_F(BatchShaderCreationTest, CreateShaders)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const auto NumShaders = static_cast<Uint32>(m_ShaderCIs.size());
+
+    Timer T;
+
+    std::vector<RefCntAutoPtr<IShader>> SeqShaders(NumShaders);
+    {
+        const auto StartTime = T.GetElapsedTime();
+        for (Uint32 i = 0; i < NumShaders; ++i)
+        {
+            pDevice->CreateShader(m_ShaderCIs[i], &SeqShaders[i]);
+            ASSERT_NE(SeqShaders[i], nullptr) << "Failed to create shader " << i;
+        }
+        const auto EndTime = T.GetElapsedTime();
+        LOG_INFO_MESSAGE("Sequentially created ", NumShaders, " shaders in ", (EndTime - StartTime) * 1000.0, " ms");
+    }
+
+    std::vector<IShader*> BatchShaders(NumShaders);
+    {
+        const auto StartTime = T.GetElapsedTime();
+        pDevice->CreateShaders(m_ShaderCIs.data(), NumShaders, BatchShaders.data());
+        const auto EndTime = T.GetElapsedTime();
+        LOG_INFO_MESSAGE("Batch-created ", NumShaders, " shaders in ", (EndTime - StartTime) * 1000.0, " ms",
+                         (pDevice->GetDeviceCaps().Features.MultithreadedResourceCreation ? " (multithreaded)" : " (single-threaded)"));
+    }
+
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        EXPECT_NE(BatchShaders[i], nullptr) << "Failed to create shader " << i;
+        if (BatchShaders[i] != nullptr)
+        {
+            CompareShaders(BatchShaders[i], SeqShaders[i]);
+            BatchShaders[i]->Release();
+        }
+    }
+}
+
+TEST_F(BatchShaderCreationTest, SingleShader)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<IShader> pRefShader;
+    pDevice->CreateShader(m_ShaderCIs[1], &pRefShader);
+    ASSERT_NE(pRefShader, nullptr);
+
+    IShader* pShader = nullptr;
+    pDevice->CreateShaders(&m_ShaderCIs[1], 1, &pShader);
+    EXPECT_NE(pShader, nullptr);
+    if (pShader != nullptr)
+    {
+        CompareShaders(pShader, pRefShader);
+        pShader->Release();
+    }
+
+    // Omitting the VARIANT macro makes the shader fail to compile
+    m_ShaderCIs[1].Macros = nullptr;
+
+    pEnv->SetErrorAllowance(3, "\n\nNo worries, testing broken shader...\n\n");
+    pShader = nullptr;
+    pDevice->CreateShaders(&m_ShaderCIs[1], 1, &pShader);
+    EXPECT_EQ(pShader, nullptr);
+    if (pShader != nullptr)
+        pShader->Release();
+    pEnv->SetErrorAllowance(0);
+}
+
+TEST_F(BatchShaderCreationTest, BrokenShader)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    // Omitting the VARIANT macro makes every other shader fail to compile
+    for (size_t i = 0; i < m_ShaderCIs.size(); i += 2)
+        m_ShaderCIs[i].Macros = nullptr;
+
+    const auto NumShaders = static_cast<Uint32>(m_ShaderCIs.size());
+
+    // Depending on the backend, every broken shader produces up to three error messages
+    pEnv->SetErrorAllowance(static_cast<int>(NumShaders / 2) * 3, "\n\nNo worries, testing broken shaders...\n\n");
+
+    std::vector<IShader*> Shaders(NumShaders);
+    pDevice->CreateShaders(m_ShaderCIs.data(), NumShaders, Shaders.data());
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            EXPECT_EQ(Shaders[i], nullptr);
+        }
+        else
+        {
+            // Shaders that follow the broken ones must be created correctly
+            RefCntAutoPtr<IShader> pRefShader;
+            pDevice->CreateShader(m_ShaderCIs[i], &pRefShader);
+            EXPECT_NE(Shaders[i], nullptr);
+            if (Shaders[i] != nullptr)
+                CompareShaders(Shaders[i], pRefShader);
+        }
+        if (Shaders[i] != nullptr)
+            Shaders[i]->Release();
+    }
+    pEnv->SetErrorAllowance(0);
+}
+
+} // namespace
@@ -0,0 +1,475 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "BasicMath.hpp"
+#include "MapHelper.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+bool IsBindlessTableSupported(IRenderDevice* pDevice)
+{
+    const auto& deviceCaps = pDevice->GetDeviceCaps();
+    return deviceCaps.Features.BindlessResources && (deviceCaps.IsVulkanDevice() || deviceCaps.IsNullDevice());
+}
+
+RefCntAutoPtr<ITexture> CreateTestTexture(IRenderDevice* pDevice, Uint32 Color)
+{
+    constexpr Uint32 TextureSize = 4;
+
+    std::array<Uint32, TextureSize * TextureSize> TexData;
+    TexData.fill(Color);
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Bindless resource table test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = TextureSize;
+    TexDesc.Height    = TextureSize;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Usage     = USAGE_IMMUTABLE;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    TextureSubResData SubresData{TexData.data(), TextureSize * sizeof(Uint32)};
+    TextureData       InitData{&SubresData, 1};
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+    return pTexture;
+}
+
+TEST(BindlessResourceTableTest, HandleAllocation)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+    if (!IsBindlessTableSupported(pDevice))
+        GTEST_SKIP() << "Bindless resource tables are not supported by this device";
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 NumTextures = 4;
+
+    BindlessResourceTableDesc TableDesc;
+    TableDesc.Name           = "Bindless resource table test";
+    TableDesc.NumTextureSRVs = NumTextures;
+    TableDesc.NumSamplers    = 1;
+
+    RefCntAutoPtr<IBindlessResourceTable> pTable;
+    pDevice->CreateBindlessResourceTable(TableDesc, &pTable);
+    ASSERT_NE(pTable, nullptr);
+
+    std::array<RefCntAutoPtr<ITexture>, NumTextures + 1> pTextures;
+    std::array<Uint32, NumTextures>                      Handles;
+    for (Uint32 i = 0; i < pTextures.size(); ++i)
+    {
+        pTextures[i] = CreateTestTexture(pDevice, 0xFF000000u | i);
+        ASSERT_NE(pTextures[i], nullptr);
+    }
+
+    for (Uint32 i = 0; i < NumTextures; ++i)
+    {
+        Handles[i] = pTable->AllocateHandle(pTextures[i]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        EXPECT_LT(Handles[i], NumTextures);
+        for (Uint32 j = 0; j < i; ++j)
+            EXPECT_NE(Handles[i], Handles[j]);
+    }
+
+    // Allocating the handle for the object that is already in the table returns the same handle
+    auto* pSRV0 = pTextures[0]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    EXPECT_EQ(pTable->AllocateHandle(pSRV0), Handles[0]);
+    EXPECT_EQ(pTable->GetHandle(pSRV0), Handles[0]);
+
+    // The array is full
+    pEnv->SetErrorAllowance(1, "\n\nNo worries, testing bindless resource table overflow...\n\n");
+    EXPECT_EQ(pTable->AllocateHandle(pTextures[NumTextures]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE)), INVALID_BINDLESS_HANDLE);
+    pEnv->SetErrorAllowance(0);
+
+    // Buffers can't be placed into the table
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Bindless resource table test buffer";
+        BuffDesc.uiSizeInBytes = 256;
+        BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        ASSERT_NE(pBuffer, nullptr);
+
+        pEnv->SetErrorAllowance(1, "\n\nNo worries, testing invalid bindless resource...\n\n");
+        EXPECT_EQ(pTable->AllocateHandle(pBuffer), INVALID_BINDLESS_HANDLE);
+        pEnv->SetErrorAllowance(0);
+    }
+
+    BindlessResourceTableStats Stats;
+    pTable->GetStats(Stats);
+    EXPECT_EQ(Stats.NumAllocatedHandles[BINDLESS_RESOURCE_TYPE_TEXTURE_SRV], NumTextures);
+    EXPECT_EQ(Stats.NumAllocatedHandles[BINDLESS_RESOURCE_TYPE_SAMPLER], 0u);
+
+    // The handle is released when the last reference is released
+    pTable->ReleaseHandle(pSRV0);
+    EXPECT_EQ(pTable->GetHandle(pSRV0), Handles[0]);
+    pTable->ReleaseHandle(pSRV0);
+    EXPECT_EQ(pTable->GetHandle(pSRV0), INVALID_BINDLESS_HANDLE);
+
+    pTable->GetStats(Stats);
+    EXPECT_EQ(Stats.NumAllocatedHandles[BINDLESS_RESOURCE_TYPE_TEXTURE_SRV], NumTextures - 1);
+
+    // The released handle may only be reused once the GPU is done with it
+    pContext->Flush();
+    pContext->FinishFrame();
+    pContext->WaitForIdle();
+    pDevice->ReleaseStaleResources();
+
+    pTable->GetStats(Stats);
+    EXPECT_EQ(Stats.NumPendingHandles[BINDLESS_RESOURCE_TYPE_TEXTURE_SRV], 0u);
+
+    EXPECT_EQ(pTable->AllocateHandle(pTextures[NumTextures]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE)), Handles[0]);
+}
+
+
+// The test compares the CPU cost of drawing many objects with different materials
+// when every material has its own SRB with the cost of drawing the same objects with
+// all material textures placed into the bindless resource table. In the latter case,
+// the material index is passed through the per-instance vertex attribute, so no
+// resources are committed between draws. Run in Null mode to measure the engine overhead:
+// --mode=null --gtest_filter=BindlessResourceTableTest*
+
+static const char* g_SRBVSSource = R"(
+struct VSInput
+{
+    float4 Pos : ATTRIB0;
+};
+
+void main(in  VSInput VSIn,
+          out float4  Pos : SV_Position)
+{
+    Pos = VSIn.Pos;
+}
+)";
+
+static const char* g_SRBPSSource = R"(
+Texture2D g_Texture;
+
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    return g_Texture.Load(int3(0, 0, 0));
+}
+)";
+
+static const char* g_BindlessVSSource = R"(
+struct VSInput
+{
+    float4 Pos    : ATTRIB0;
+    uint   TexInd : ATTRIB1;
+};
+
+void main(in  VSInput VSIn,
+          out float4  Pos    : SV_Position,
+          out uint    TexInd : TEX_IND)
+{
+    Pos    = VSIn.Pos;
+    TexInd = VSIn.TexInd;
+}
+)";
+
+static const char* g_BindlessPSSource = R"(
+Texture2D g_Textures[];
+
+float4 main(in float4 Pos : SV_Position,
+            in nointerpolation uint TexInd : TEX_IND) : SV_Target
+{
+    return g_Textures[TexInd].Load(int3(0, 0, 0));
+}
+)";
+
+class BindlessMaterialThroughputTest : public ::testing::Test
+{
+protected:
+    static constexpr Uint32 NumMaterials = 10000;
+    static constexpr Uint32 NumTextures  = 1024;
+
+    static void SetUpTestSuite()
+    {
+        auto* pEnv       = TestingEnvironment::GetInstance();
+        auto* pDevice    = pEnv->GetDevice();
+        auto* pContext   = pEnv->GetDeviceContext();
+        auto* pSwapChain = pEnv->GetSwapChain();
+        if (!IsBindlessTableSupported(pDevice))
+            return;
+
+        std::vector<StateTransitionDesc> Barriers;
+        for (Uint32 i = 0; i < NumTextures; ++i)
+        {
+            sm_pTextures[i] = CreateTestTexture(pDevice, 0xFF000000u | (i * 0x00010101u));
+            ASSERT_NE(sm_pTextures[i], nullptr);
+            Barriers.emplace_back(sm_pTextures[i], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, true);
+        }
+        // Resources in the bindless table are not transitioned by the engine
+        pContext->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+
+        BindlessResourceTableDesc TableDesc;
+        TableDesc.Name           = "Bindless material throughput test table";
+        TableDesc.NumTextureSRVs = NumTextures;
+        pDevice->CreateBindlessResourceTable(TableDesc, &sm_pTable);
+        ASSERT_NE(sm_pTable, nullptr);
+
+        std::vector<Uint32> TexHandles(NumTextures);
+        for (Uint32 i = 0; i < NumTextures; ++i)
+        {
+            TexHandles[i] = sm_pTable->AllocateHandle(sm_pTextures[i]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+            ASSERT_NE(TexHandles[i], INVALID_BINDLESS_HANDLE);
+        }
+
+        {
+            // clang-format off
+            const float4 Verts[] =
+            {
+                float4{-1.0f, -1.0f, 0.0f, 1.0f},
+                float4{ 0.0f, +1.0f, 0.0f, 1.0f},
+                float4{+1.0f, -1.0f, 0.0f, 1.0f}
+            };
+            // clang-format on
+
+            BufferDesc BuffDesc;
+            BuffDesc.Name          = "Bindless material throughput test vertex buffer";
+            BuffDesc.uiSizeInBytes = sizeof(Verts);
+            BuffDesc.Usage         = USAGE_IMMUTABLE;
+            BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+
+            BufferData InitData{Verts, sizeof(Verts)};
+            pDevice->CreateBuffer(BuffDesc, &InitData, &sm_pVertexBuffer);
+            ASSERT_NE(sm_pVertexBuffer, nullptr);
+        }
+
+        {
+            // Per-instance texture handle of every material
+            std::vector<Uint32> MaterialTexHandles(NumMaterials);
+            for (Uint32 m = 0; m < NumMaterials; ++m)
+                MaterialTexHandles[m] = TexHandles[m % NumTextures];
+
+            BufferDesc BuffDesc;
+            BuffDesc.Name          = "Bindless material throughput test material buffer";
+            BuffDesc.uiSizeInBytes = static_cast<Uint32>(MaterialTexHandles.size() * sizeof(Uint32));
+            BuffDesc.Usage         = USAGE_IMMUTABLE;
+            BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+
+            BufferData InitData{MaterialTexHandles.data(), BuffDesc.uiSizeInBytes};
+            pDevice->CreateBuffer(BuffDesc, &InitData, &sm_pMaterialBuffer);
+            ASSERT_NE(sm_pMaterialBuffer, nullptr);
+        }
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.EntryPoint     = "main";
+
+        auto CreateShader = [&](SHADER_TYPE ShaderType, const char* Name, const char* Source) {
+            ShaderCI.Desc.ShaderType = ShaderType;
+            ShaderCI.Desc.Name       = Name;
+            ShaderCI.Source          = Source;
+
+            RefCntAutoPtr<IShader> pShader;
+            pDevice->CreateShader(ShaderCI, &pShader);
+            return pShader;
+        };
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& PSODesc          = PSOCreateInfo.PSODesc;
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSODesc.PipelineType                          = PIPELINE_TYPE_GRAPHICS;
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = pSwapChain->GetDesc().ColorBufferFormat;
+        GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        {
+            auto pVS = CreateShader(SHADER_TYPE_VERTEX, "Bindless material throughput test SRB VS", g_SRBVSSource);
+            auto pPS = CreateShader(SHADER_TYPE_PIXEL, "Bindless material throughput test SRB PS", g_SRBPSSource);
+            ASSERT_NE(pVS, nullptr);
+            ASSERT_NE(pPS, nullptr);
+
+            LayoutElement Elems[] = {LayoutElement{0, 0, 4, VT_FLOAT32}};
+
+            GraphicsPipeline.InputLayout.LayoutElements = Elems;
+            GraphicsPipeline.InputLayout.NumElements    = _countof(Elems);
+
+            PSODesc.Name                               = "Bindless material throughput test SRB PSO";
+            PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+
+            PSOCreateInfo.pVS = pVS;
+            PSOCreateInfo.pPS = pPS;
+            pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &sm_pSRBPSO);
+            ASSERT_NE(sm_pSRBPSO, nullptr);
+        }
+
+        {
+            auto pVS = CreateShader(SHADER_TYPE_VERTEX, "Bindless material throughput test bindless VS", g_BindlessVSSource);
+            auto pPS = CreateShader(SHADER_TYPE_PIXEL, "Bindless material throughput test bindless PS", g_BindlessPSSource);
+            ASSERT_NE(pVS, nullptr);
+            ASSERT_NE(pPS, nullptr);
+
+            LayoutElement Elems[] =
+                {
+                    LayoutElement{0, 0, 4, VT_FLOAT32},
+                    LayoutElement{1, 1, 1, VT_UINT32, False, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE} //
+                };
+
+            GraphicsPipeline.InputLayout.LayoutElements = Elems;
+            GraphicsPipeline.InputLayout.NumElements    = _countof(Elems);
+
+            PSODesc.Name                 = "Bindless material throughput test bindless PSO";
+            PSOCreateInfo.pBindlessTable = sm_pTable;
+
+            PSOCreateInfo.pVS = pVS;
+            PSOCreateInfo.pPS = pPS;
+            pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &sm_pBindlessPSO);
+            ASSERT_NE(sm_pBindlessPSO, nullptr);
+
+            sm_pBindlessPSO->CreateShaderResourceBinding(&sm_pBindlessSRB, true);
+            ASSERT_NE(sm_pBindlessSRB, nullptr);
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pBindlessSRB.Release();
+        sm_pBindlessPSO.Release();
+        sm_pSRBPSO.Release();
+        sm_pMaterialBuffer.Release();
+        sm_pVertexBuffer.Release();
+        sm_pTable.Release();
+        for (auto& pTex : sm_pTextures)
+            pTex.Release();
+
+        auto* pEnv = TestingEnvironment::GetInstance();
+        pEnv->Reset();
+    }
+
+    void SetUp() override
+    {
+        if (!IsBindlessTableSupported(TestingEnvironment::GetInstance()->GetDevice()))
+            GTEST_SKIP() << "Bindless resource tables are not supported by this device";
+    }
+
+    static void PrepareContext()
+    {
+        auto* pEnv       = TestingEnvironment::GetInstance();
+        auto* pContext   = pEnv->GetDeviceContext();
+        auto* pSwapChain = pEnv->GetSwapChain();
+
+        ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        IBuffer* pVBs[] = {sm_pVertexBuffer, sm_pMaterialBuffer};
+        pContext->SetVertexBuffers(0, _countof(pVBs), pVBs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    }
+
+    static std::array<RefCntAutoPtr<ITexture>, NumTextures> sm_pTextures;
+
+    static RefCntAutoPtr<IBindlessResourceTable> sm_pTable;
+    static RefCntAutoPtr<IBuffer>                sm_pVertexBuffer;
+    static RefCntAutoPtr<IBuffer>                sm_pMaterialBuffer;
+    static RefCntAutoPtr<IPipelineState>         sm_pSRBPSO;
+    static RefCntAutoPtr<IPipelineState>         sm_pBindlessPSO;
+    static RefCntAutoPtr<IShaderResourceBinding> sm_pBindlessSRB;
+};
+
+std::array<RefCntAutoPtr<ITexture>, BindlessMaterialThroughputTest::NumTextures> BindlessMaterialThroughputTest::sm_pTextures;
+
+RefCntAutoPtr<IBindlessResourceTable> BindlessMaterialThroughputTest::sm_pTable;
+RefCntAutoPtr<IBuffer>                BindlessMaterialThroughputTest::sm_pVertexBuffer;
+RefCntAutoPtr<IBuffer>                BindlessMaterialThroughputTest::sm_pMaterialBuffer;
+RefCntAutoPtr<IPipelineState>         BindlessMaterialThroughputTest::sm_pSRBPSO;
+RefCntAutoPtr<IPipelineState>         BindlessMaterialThroughputTest::sm_pBindlessPSO;
+RefCntAutoPtr<IShaderResourceBinding> BindlessMaterialThroughputTest::sm_pBindlessSRB;
+
+TEST_F(BindlessMaterialThroughputTest, SRBPerMaterial)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    std::vector<RefCntAutoPtr<IShaderResourceBinding>> SRBs(NumMaterials);
+    for (Uint32 m = 0; m < NumMaterials; ++m)
+    {
+        sm_pSRBPSO->CreateShaderResourceBinding(&SRBs[m], true);
+        ASSERT_NE(SRBs[m], nullptr);
+        SRBs[m]->GetVariableByName(SHADER_TYPE_PIXEL, "g_Texture")->Set(sm_pTextures[m % NumTextures]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+    }
+
+    PrepareContext();
+    pContext->SetPipelineState(sm_pSRBPSO);
+
+    DrawAttribs DrawAttrs{3, DRAW_FLAG_VERIFY_ALL};
+
+    Timer T;
+    for (Uint32 m = 0; m < NumMaterials; ++m)
+    {
+        pContext->CommitShaderResources(SRBs[m], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        pContext->Draw(DrawAttrs);
+    }
+    pContext->Flush();
+    TestingEnvironment::ReportThroughput("SRBMaterialsPerSecond", NumMaterials, T.GetElapsedTime());
+
+    pContext->WaitForIdle();
+}
+
+TEST_F(BindlessMaterialThroughputTest, BindlessTable)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    PrepareContext();
+    pContext->SetPipelineState(sm_pBindlessPSO);
+    pContext->CommitShaderResources(sm_pBindlessSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    DrawAttribs DrawAttrs{3, DRAW_FLAG_VERIFY_ALL};
+
+    Timer T;
+    for (Uint32 m = 0; m < NumMaterials; ++m)
+    {
+        // The material is selected by the per-instance attribute
+        DrawAttrs.FirstInstanceLocation = m;
+        pContext->Draw(DrawAttrs);
+    }
+    pContext->Flush();
+    TestingEnvironment::ReportThroughput("BindlessMaterialsPerSecond", NumMaterials, T.GetElapsedTime());
+
+    pContext->WaitForIdle();
+}
+
+} // namespace
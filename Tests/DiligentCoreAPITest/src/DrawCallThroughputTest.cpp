@@ -0,0 +1,365 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <vector>
+#include <algorithm>
+
+#include "TestingEnvironment.hpp"
+#include "BasicMath.hpp"
+#include "MapHelper.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// These tests measure how many commands the engine can record per second and
+// do not verify the rendering results. They are primarily intended to be run
+// in Null mode (--mode=null --gtest_filter=DrawCallThroughput*) where the
+// numbers reflect the CPU overhead of the engine alone.
+
+static const char* g_VSSource = R"(
+cbuffer Constants
+{
+    float4 g_Offset;
+};
+
+struct VSInput
+{
+    float4 Pos : ATTRIB0;
+};
+
+void main(in  VSInput VSIn,
+          out float4  Pos : SV_Position)
+{
+    Pos = VSIn.Pos + g_Offset;
+}
+)";
+
+static const char* g_PSSource = R"(
+Texture2D g_Texture;
+
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    return g_Texture.Load(int3(0, 0, 0));
+}
+)";
+
+class DrawCallThroughputTest : public ::testing::Test
+{
+protected:
+    static constexpr Uint32 NumPSOs      = 2;
+    static constexpr Uint32 NumSRBs      = 16;
+    static constexpr Uint32 TextureSize  = 4;
+    static constexpr Uint32 NumTriangles = 1;
+
+    static void SetUpTestSuite()
+    {
+        auto* pEnv       = TestingEnvironment::GetInstance();
+        auto* pDevice    = pEnv->GetDevice();
+        auto* pSwapChain = pEnv->GetSwapChain();
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.EntryPoint     = "main";
+
+        RefCntAutoPtr<IShader> pVS;
+        {
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+            ShaderCI.Desc.Name       = "Draw call throughput test VS";
+            ShaderCI.Source          = g_VSSource;
+            pDevice->CreateShader(ShaderCI, &pVS);
+            ASSERT_NE(pVS, nullptr);
+        }
+
+        RefCntAutoPtr<IShader> pPS;
+        {
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+            ShaderCI.Desc.Name       = "Draw call throughput test PS";
+            ShaderCI.Source          = g_PSSource;
+            pDevice->CreateShader(ShaderCI, &pPS);
+            ASSERT_NE(pPS, nullptr);
+        }
+
+        {
+            BufferDesc BuffDesc;
+            BuffDesc.Name           = "Draw call throughput test constants";
+            BuffDesc.uiSizeInBytes  = sizeof(float4);
+            BuffDesc.Usage          = USAGE_DYNAMIC;
+            BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+            BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+            pDevice->CreateBuffer(BuffDesc, nullptr, &sm_pConstants);
+            ASSERT_NE(sm_pConstants, nullptr);
+        }
+
+        {
+            // clang-format off
+            const float4 Verts[] =
+            {
+                float4{-1.0f, -1.0f, 0.0f, 1.0f},
+                float4{ 0.0f, +1.0f, 0.0f, 1.0f},
+                float4{+1.0f, -1.0f, 0.0f, 1.0f}
+            };
+            // clang-format on
+
+            BufferDesc BuffDesc;
+            BuffDesc.Name          = "Draw call throughput test vertex buffer";
+            BuffDesc.uiSizeInBytes = sizeof(Verts);
+            BuffDesc.Usage         = USAGE_IMMUTABLE;
+            BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+
+            BufferData InitData{Verts, sizeof(Verts)};
+            pDevice->CreateBuffer(BuffDesc, &InitData, &sm_pVertexBuffer);
+            ASSERT_NE(sm_pVertexBuffer, nullptr);
+        }
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& PSODesc          = PSOCreateInfo.PSODesc;
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSODesc.PipelineType                          = PIPELINE_TYPE_GRAPHICS;
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = pSwapChain->GetDesc().ColorBufferFormat;
+        GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        LayoutElement Elems[] = {LayoutElement{0, 0, 4, VT_FLOAT32}};
+
+        GraphicsPipeline.InputLayout.LayoutElements = Elems;
+        GraphicsPipeline.InputLayout.NumElements    = _countof(Elems);
+
+        ShaderResourceVariableDesc Vars[] = {{SHADER_TYPE_PIXEL, "g_Texture", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE}};
+
+        PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+        PSODesc.ResourceLayout.Variables           = Vars;
+        PSODesc.ResourceLayout.NumVariables        = _countof(Vars);
+
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
+
+        for (Uint32 i = 0; i < NumPSOs; ++i)
+        {
+            // Make the pipelines differ so that switching between them is not a no-op
+            PSODesc.Name                                             = i == 0 ? "Draw call throughput test PSO 0" : "Draw call throughput test PSO 1";
+            GraphicsPipeline.BlendDesc.RenderTargets[0].BlendEnable = i != 0;
+            pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &sm_pPSOs[i]);
+            ASSERT_NE(sm_pPSOs[i], nullptr);
+            sm_pPSOs[i]->GetStaticVariableByName(SHADER_TYPE_VERTEX, "Constants")->Set(sm_pConstants);
+        }
+
+        std::array<Uint32, TextureSize * TextureSize> TexData;
+        for (Uint32 srb = 0; srb < NumSRBs; ++srb)
+        {
+            TexData.fill(0xFF000000u | (srb * 0x00101010u));
+
+            TextureDesc TexDesc;
+            TexDesc.Name      = "Draw call throughput test texture";
+            TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+            TexDesc.Width     = TextureSize;
+            TexDesc.Height    = TextureSize;
+            TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+            TexDesc.Usage     = USAGE_IMMUTABLE;
+            TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+            TextureSubResData SubresData{TexData.data(), TextureSize * sizeof(Uint32)};
+            TextureData       InitData{&SubresData, 1};
+
+            RefCntAutoPtr<ITexture> pTexture;
+            pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+            ASSERT_NE(pTexture, nullptr);
+
+            // SRBs are compatible between the pipelines, so it does not matter which one creates them
+            sm_pPSOs[0]->CreateShaderResourceBinding(&sm_pSRBs[srb], true);
+            ASSERT_NE(sm_pSRBs[srb], nullptr);
+            sm_pSRBs[srb]->GetVariableByName(SHADER_TYPE_PIXEL, "g_Texture")->Set(pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        for (auto& pSRB : sm_pSRBs)
+            pSRB.Release();
+        for (auto& pPSO : sm_pPSOs)
+            pPSO.Release();
+        sm_pVertexBuffer.Release();
+        sm_pConstants.Release();
+
+        auto* pEnv = TestingEnvironment::GetInstance();
+        pEnv->Reset();
+    }
+
+    static Uint32 GetNumIterations()
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+        // Real GPUs have to execute all the recorded commands, so keep the amount of work reasonable
+        return pDevice->GetDeviceCaps().IsNullDevice() ? 200000 : 20000;
+    }
+
+    static void PrepareContext()
+    {
+        auto* pEnv       = TestingEnvironment::GetInstance();
+        auto* pContext   = pEnv->GetDeviceContext();
+        auto* pSwapChain = pEnv->GetSwapChain();
+
+        ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        const float ClearColor[] = {0.f, 0.f, 0.f, 0.f};
+        pContext->ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        IBuffer* pVBs[] = {sm_pVertexBuffer};
+        pContext->SetVertexBuffers(0, 1, pVBs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+        {
+            MapHelper<float4> Constants{pContext, sm_pConstants, MAP_WRITE, MAP_FLAG_DISCARD};
+            *Constants = float4{0, 0, 0, 0};
+        }
+
+        // Transition all resources once so that the measured loops only verify the states
+        for (auto& pSRB : sm_pSRBs)
+            pContext->TransitionShaderResources(sm_pPSOs[0], pSRB);
+    }
+
+    static RefCntAutoPtr<IPipelineState>         sm_pPSOs[NumPSOs];
+    static RefCntAutoPtr<IShaderResourceBinding> sm_pSRBs[NumSRBs];
+    static RefCntAutoPtr<IBuffer>                sm_pVertexBuffer;
+    static RefCntAutoPtr<IBuffer>                sm_pConstants;
+};
+
+RefCntAutoPtr<IPipelineState>         DrawCallThroughputTest::sm_pPSOs[DrawCallThroughputTest::NumPSOs];
+RefCntAutoPtr<IShaderResourceBinding> DrawCallThroughputTest::sm_pSRBs[DrawCallThroughputTest::NumSRBs];
+RefCntAutoPtr<IBuffer>                DrawCallThroughputTest::sm_pVertexBuffer;
+RefCntAutoPtr<IBuffer>                DrawCallThroughputTest::sm_pConstants;
+
+TEST_F(DrawCallThroughputTest, Draws)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    PrepareContext();
+    pContext->SetPipelineState(sm_pPSOs[0]);
+    pContext->CommitShaderResources(sm_pSRBs[0], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    const auto NumDraws = GetNumIterations();
+
+    DrawAttribs DrawAttrs{3 * NumTriangles, DRAW_FLAG_VERIFY_ALL};
+
+    Timer T;
+    for (Uint32 i = 0; i < NumDraws; ++i)
+        pContext->Draw(DrawAttrs);
+    pContext->Flush();
+    TestingEnvironment::ReportThroughput("DrawsPerSecond", NumDraws, T.GetElapsedTime());
+
+    pContext->WaitForIdle();
+}
+
+TEST_F(DrawCallThroughputTest, MultiDraws)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    PrepareContext();
+    pContext->SetPipelineState(sm_pPSOs[0]);
+    pContext->CommitShaderResources(sm_pSRBs[0], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    const auto NumDraws = GetNumIterations();
+
+    // The draws are submitted in batches to compare the per-draw cost with individual Draw() calls
+    constexpr Uint32 BatchSize = 256;
+
+    MultiDrawItem Item;
+    Item.NumVertices = 3 * NumTriangles;
+
+    std::vector<MultiDrawItem> DrawItems(BatchSize, Item);
+
+    MultiDrawAttribs DrawAttrs{BatchSize, DrawItems.data(), DRAW_FLAG_VERIFY_ALL};
+
+    Timer T;
+    for (Uint32 i = 0; i < NumDraws; i += BatchSize)
+    {
+        DrawAttrs.DrawCount = std::min(BatchSize, NumDraws - i);
+        pContext->MultiDraw(DrawAttrs);
+    }
+    pContext->Flush();
+    TestingEnvironment::ReportThroughput("MultiDrawsPerSecond", NumDraws, T.GetElapsedTime());
+
+    pContext->WaitForIdle();
+}
+
+TEST_F(DrawCallThroughputTest, CommitShaderResources)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    PrepareContext();
+    pContext->SetPipelineState(sm_pPSOs[0]);
+
+    const auto NumCommits = GetNumIterations();
+
+    DrawAttribs DrawAttrs{3 * NumTriangles, DRAW_FLAG_VERIFY_ALL};
+
+    Timer T;
+    for (Uint32 i = 0; i < NumCommits; ++i)
+    {
+        pContext->CommitShaderResources(sm_pSRBs[i % NumSRBs], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        pContext->Draw(DrawAttrs);
+    }
+    pContext->Flush();
+    TestingEnvironment::ReportThroughput("CommitsPerSecond", NumCommits, T.GetElapsedTime());
+
+    pContext->WaitForIdle();
+}
+
+TEST_F(DrawCallThroughputTest, PSOSwitches)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    PrepareContext();
+
+    const auto NumSwitches = GetNumIterations();
+
+    DrawAttribs DrawAttrs{3 * NumTriangles, DRAW_FLAG_VERIFY_ALL};
+
+    Timer T;
+    for (Uint32 i = 0; i < NumSwitches; ++i)
+    {
+        pContext->SetPipelineState(sm_pPSOs[i % NumPSOs]);
+        pContext->CommitShaderResources(sm_pSRBs[0], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        pContext->Draw(DrawAttrs);
+    }
+    pContext->Flush();
+    TestingEnvironment::ReportThroughput("PSOSwitchesPerSecond", NumSwitches, T.GetElapsedTime());
+
+    pContext->WaitForIdle();
+}
+
+} // namespace
@@ -0,0 +1,300 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <cstring>
+
+#include "TestingEnvironment.hpp"
+#include "EngineFactoryOpenGL.h"
+#include "HLSL2GLSLConverter.h"
+#include "ObjectBase.hpp"
+#include "MemoryFileStream.hpp"
+#include "StringDataBlobImpl.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+struct ConvertedVS_PS
+{
+    std::string VS;
+    std::string PS;
+};
+
+ConvertedVS_PS ConvertVS_PS(IHLSL2GLSLConverter* pConverter, IShaderSourceInputStreamFactory* pShaderSourceFactory)
+{
+    ConvertedVS_PS Result;
+
+    RefCntAutoPtr<IHLSL2GLSLConversionStream> pStream;
+    pConverter->CreateStream("VS_PS.hlsl", pShaderSourceFactory, nullptr, 0, &pStream);
+    if (!pStream)
+        return Result;
+
+    RefCntAutoPtr<IDataBlob> pVS;
+    pStream->Convert("TestVS", SHADER_TYPE_VERTEX, true, "_sampler", true, &pVS);
+    if (pVS)
+        Result.VS = reinterpret_cast<const char*>(pVS->GetDataPtr());
+
+    RefCntAutoPtr<IDataBlob> pPS;
+    pStream->Convert("TestPS", SHADER_TYPE_PIXEL, true, "_sampler", true, &pPS);
+    if (pPS)
+        Result.PS = reinterpret_cast<const char*>(pPS->GetDataPtr());
+
+    return Result;
+}
+
+// Shader source stream factory that serves a single include file from memory
+class IncludeFileFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    IncludeFileFactory(IReferenceCounters* pRefCounters) :
+        TBase{pRefCounters}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, TBase)
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final
+    {
+        CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char* Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS /*Flags*/, IFileStream** ppStream) override final
+    {
+        *ppStream = nullptr;
+        if (strcmp(Name, "Header.fxh") != 0)
+            return;
+
+        RefCntAutoPtr<IDataBlob>   pData{MakeNewRCObj<StringDataBlobImpl>{}(Header)};
+        RefCntAutoPtr<IFileStream> pStream{MakeNewRCObj<MemoryFileStream>{}(pData)};
+        *ppStream = pStream.Detach();
+    }
+
+    std::string Header;
+};
+
+class HLSL2GLSLConversionStreamTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+        if (!pDevice->GetDeviceCaps().IsGLDevice())
+            return;
+
+        RefCntAutoPtr<IEngineFactoryOpenGL> pFactoryGL{pDevice->GetEngineFactory(), IID_EngineFactoryOpenGL};
+        if (pFactoryGL)
+            pFactoryGL->CreateHLSL2GLSLConverter(&pConverter);
+
+        pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/HLSL2GLSLConverter", &pShaderSourceFactory);
+    }
+
+    static void TearDownTestSuite()
+    {
+        pConverter.Release();
+        pShaderSourceFactory.Release();
+    }
+
+    void SetUp() override
+    {
+        if (!TestingEnvironment::GetInstance()->GetDevice()->GetDeviceCaps().IsGLDevice())
+        {
+            GTEST_SKIP() << "HLSL2GLSL converter is only available in OpenGL backend";
+        }
+        ASSERT_NE(pConverter, nullptr);
+        ASSERT_NE(pShaderSourceFactory, nullptr);
+    }
+
+    static RefCntAutoPtr<IHLSL2GLSLConverter>             pConverter;
+    static RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+};
+
+RefCntAutoPtr<IHLSL2GLSLConverter>             HLSL2GLSLConversionStreamTest::pConverter;
+RefCntAutoPtr<IShaderSourceInputStreamFactory> HLSL2GLSLConversionStreamTest::pShaderSourceFactory;
+
+TEST_F(HLSL2GLSLConversionStreamTest, ConcurrentStreams)
+{
+
+    // The first conversion populates the converter cache
+    const auto Reference = ConvertVS_PS(pConverter, pShaderSourceFactory);
+    ASSERT_FALSE(Reference.VS.empty());
+    ASSERT_FALSE(Reference.PS.empty());
+
+    // Streams created from the same source share tokens and converted shaders
+    const auto NumThreads = std::max(std::thread::hardware_concurrency(), 2u);
+
+    std::vector<ConvertedVS_PS> Results(NumThreads);
+    std::vector<std::thread>    Threads;
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        Threads.emplace_back(
+            [&, i]() //
+            {
+                Results[i] = ConvertVS_PS(pConverter, pShaderSourceFactory);
+            });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    for (const auto& Result : Results)
+    {
+        EXPECT_EQ(Result.VS, Reference.VS);
+        EXPECT_EQ(Result.PS, Reference.PS);
+    }
+}
+
+TEST_F(HLSL2GLSLConversionStreamTest, ModifiedIncludeFile)
+{
+    RefCntAutoPtr<IncludeFileFactory> pFactory{MakeNewRCObj<IncludeFileFactory>()()};
+
+    const std::string Source = R"(
+#include "Header.fxh"
+
+float4 TestPS() : SV_Target
+{
+    return GetColor();
+}
+)";
+
+    auto Convert = [&]() {
+        std::string GLSL;
+
+        RefCntAutoPtr<IHLSL2GLSLConversionStream> pStream;
+        pConverter->CreateStream("ModifiedIncludeFile.hlsl", pFactory, Source.c_str(), Source.length(), &pStream);
+        if (!pStream)
+            return GLSL;
+
+        RefCntAutoPtr<IDataBlob> pGLSL;
+        pStream->Convert("TestPS", SHADER_TYPE_PIXEL, false, "_sampler", true, &pGLSL);
+        if (pGLSL)
+            GLSL = reinterpret_cast<const char*>(pGLSL->GetDataPtr());
+        return GLSL;
+    };
+
+    pFactory->Header = "float4 GetColor() { return float4(0.125, 0.25, 0.5, 1.0); }\n";
+
+    const auto GLSL1 = Convert();
+    ASSERT_FALSE(GLSL1.empty());
+    EXPECT_NE(GLSL1.find("0.125"), std::string::npos);
+
+    // The converter must not return the shader converted from the original header
+    pFactory->Header = "float4 GetColor() { return float4(0.75, 0.25, 0.5, 1.0); }\n";
+
+    const auto GLSL2 = Convert();
+    ASSERT_FALSE(GLSL2.empty());
+    EXPECT_EQ(GLSL2.find("0.125"), std::string::npos);
+    EXPECT_NE(GLSL2.find("0.75"), std::string::npos);
+}
+
+TEST_F(HLSL2GLSLConversionStreamTest, ConvertMultiple)
+{
+    std::string Source;
+    {
+        RefCntAutoPtr<IFileStream> pFileStream;
+        pShaderSourceFactory->CreateInputStream("VS_PS.hlsl", &pFileStream);
+        ASSERT_NE(pFileStream, nullptr);
+        Source.resize(pFileStream->GetSize());
+        ASSERT_TRUE(pFileStream->Read(&Source[0], Source.size()));
+    }
+
+    // clang-format off
+    const HLSL2GLSLEntryPointInfo EntryPoints[] =
+    {
+        {"TestVS",  SHADER_TYPE_VERTEX},
+        {"TestPS",  SHADER_TYPE_PIXEL},
+        {"Missing", SHADER_TYPE_PIXEL},
+        {"TestVS",  SHADER_TYPE_VERTEX}
+    };
+    // clang-format on
+    constexpr Uint32 NumEntryPoints = _countof(EntryPoints);
+
+    // Converted shaders are cached by source, so the reference and batch conversions use different
+    // sources that only differ in the first line. The first line is skipped when the results are compared.
+    auto SkipFirstLine = [](const char* GLSL) {
+        const auto* NewLine = strchr(GLSL, '\n');
+        return std::string{NewLine != nullptr ? NewLine : GLSL};
+    };
+
+    for (Uint32 NumThreads : {1u, 4u})
+    {
+        const auto RefSource = "// Reference, " + std::to_string(NumThreads) + " thread(s)\n" + Source;
+
+        RefCntAutoPtr<IHLSL2GLSLConversionStream> pRefStream;
+        pConverter->CreateStream("VS_PS.hlsl", pShaderSourceFactory, RefSource.c_str(), RefSource.length(), &pRefStream);
+        ASSERT_NE(pRefStream, nullptr);
+
+        std::string Reference[NumEntryPoints];
+        for (Uint32 i = 0; i < NumEntryPoints; ++i)
+        {
+            if (i == 2)
+                continue;
+
+            RefCntAutoPtr<IDataBlob> pGLSL;
+            pRefStream->Convert(EntryPoints[i].EntryPoint, EntryPoints[i].ShaderType, false, "_sampler", true, &pGLSL);
+            ASSERT_NE(pGLSL, nullptr);
+            Reference[i] = SkipFirstLine(reinterpret_cast<const char*>(pGLSL->GetDataPtr()));
+        }
+
+        const auto BatchSource = "// Batch, " + std::to_string(NumThreads) + " thread(s)\n" + Source;
+
+        RefCntAutoPtr<IHLSL2GLSLConversionStream> pStream;
+        pConverter->CreateStream("VS_PS.hlsl", pShaderSourceFactory, BatchSource.c_str(), BatchSource.length(), &pStream);
+        ASSERT_NE(pStream, nullptr);
+
+        TestingEnvironment::SetErrorAllowance(2, "Expected errors: unable to find shader entry point \"Missing\"\n");
+
+        IDataBlob* pGLSLSources[NumEntryPoints] = {};
+        pStream->ConvertMultiple(EntryPoints, NumEntryPoints, false, "_sampler", true, NumThreads, pGLSLSources);
+
+        for (Uint32 i = 0; i < NumEntryPoints; ++i)
+        {
+            if (i == 2)
+            {
+                EXPECT_EQ(pGLSLSources[i], nullptr);
+                continue;
+            }
+
+            EXPECT_NE(pGLSLSources[i], nullptr);
+            if (pGLSLSources[i] != nullptr)
+            {
+                EXPECT_EQ(Reference[i], SkipFirstLine(reinterpret_cast<const char*>(pGLSLSources[i]->GetDataPtr())));
+                pGLSLSources[i]->Release();
+            }
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+
+#include "Null/TestingSwapChainNull.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+TestingSwapChainNull::TestingSwapChainNull(IReferenceCounters*  pRefCounters,
+                                           IRenderDevice*       pDevice,
+                                           IDeviceContext*      pContext,
+                                           const SwapChainDesc& SCDesc) :
+    TBase //
+    {
+        pRefCounters,
+        pDevice,
+        pContext,
+        SCDesc //
+    }
+{
+}
+
+void TestingSwapChainNull::TakeSnapshot()
+{
+    CopyTextureAttribs CopyInfo //
+        {
+            m_pRenderTarget,
+            RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+            m_pStagingTexture,
+            RESOURCE_STATE_TRANSITION_MODE_TRANSITION //
+        };
+    m_pContext->CopyTexture(CopyInfo);
+
+    MappedTextureSubresource MapData;
+    m_pContext->MapTextureSubresource(m_pStagingTexture, 0, 0, MAP_READ, MAP_FLAG_NONE, nullptr, MapData);
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(m_SwapChainDesc.ColorBufferFormat);
+    m_ReferenceDataPitch   = m_SwapChainDesc.Width * FmtAttribs.ComponentSize * FmtAttribs.NumComponents;
+    m_ReferenceData.resize(m_SwapChainDesc.Height * m_ReferenceDataPitch);
+    for (Uint32 row = 0; row < m_SwapChainDesc.Height; ++row)
+    {
+        memcpy(&m_ReferenceData[row * m_ReferenceDataPitch],
+               reinterpret_cast<const Uint8*>(MapData.pData) + row * MapData.Stride,
+               m_ReferenceDataPitch);
+    }
+
+    m_pContext->UnmapTextureSubresource(m_pStagingTexture, 0, 0);
+}
+
+void CreateTestingSwapChainNull(IRenderDevice*       pDevice,
+                                IDeviceContext*      pContext,
+                                const SwapChainDesc& SCDesc,
+                                ISwapChain**         ppSwapChain)
+{
+    try
+    {
+        TestingSwapChainNull* pTestingSC(MakeNewRCObj<TestingSwapChainNull>()(pDevice, pContext, SCDesc));
+        pTestingSC->QueryInterface(IID_SwapChain, reinterpret_cast<IObject**>(ppSwapChain));
+    }
+    catch (...)
+    {
+        *ppSwapChain = nullptr;
+    }
+}
+
+} // namespace Testing
+
+} // namespace Diligent
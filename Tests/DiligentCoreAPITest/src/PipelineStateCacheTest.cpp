@@ -0,0 +1,215 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* g_CSSource = R"(
+RWTexture2D<float4> g_tex2DUAV;
+
+[numthreads(16, 16, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    float4 Color = float4(0.0, 0.0, 0.0, 1.0);
+    for (int i = 0; i < ITERATIONS; ++i)
+        Color.rgb += sin(float3(DTid.xy, i) * 0.125);
+    g_tex2DUAV[DTid.xy] = Color;
+}
+)";
+
+constexpr Uint32 NumPipelines = 8;
+
+// Creates NumPipelines different compute pipelines and returns the pipeline state cache statistics
+PipelineStateCacheStats CreatePipelines(IPipelineStateCache* pCache)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    for (Uint32 i = 0; i < NumPipelines; ++i)
+    {
+        const auto  Iterations = std::to_string(i + 1);
+        ShaderMacro Macros[]   = {{"ITERATIONS", Iterations.c_str()}, {}};
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler  = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.EntryPoint      = "main";
+        ShaderCI.Desc.Name       = "Pipeline state cache test CS";
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+        ShaderCI.Source          = g_CSSource;
+        ShaderCI.Macros          = Macros;
+
+        RefCntAutoPtr<IShader> pCS;
+        pDevice->CreateShader(ShaderCI, &pCS);
+        EXPECT_NE(pCS, nullptr);
+        if (!pCS)
+            continue;
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+
+        auto& PSODesc = PSOCreateInfo.PSODesc;
+
+        PSODesc.Name                               = "Pipeline state cache test PSO";
+        PSODesc.PipelineType                       = PIPELINE_TYPE_COMPUTE;
+        PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+
+        PSOCreateInfo.pCS       = pCS;
+        PSOCreateInfo.pPSOCache = pCache;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+        EXPECT_NE(pPSO, nullptr);
+    }
+
+    PipelineStateCacheStats Stats;
+    pCache->GetStats(Stats);
+    return Stats;
+}
+
+TEST(PipelineStateCacheTest, WarmStart)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    PipelineStateCacheStats  ColdStats;
+    {
+        PipelineStateCacheCreateInfo CacheCI;
+        CacheCI.Desc.Name = "Cold pipeline state cache";
+
+        RefCntAutoPtr<IPipelineStateCache> pColdCache;
+        pDevice->CreatePipelineStateCache(CacheCI, &pColdCache);
+        if (!pColdCache)
+        {
+            GTEST_SKIP() << "Pipeline state caches are not supported by this device";
+        }
+
+        ColdStats = CreatePipelines(pColdCache);
+        EXPECT_EQ(ColdStats.InitialDataSize, 0u);
+        EXPECT_EQ(ColdStats.NumPipelinesCreated, NumPipelines);
+
+        pColdCache->GetData(&pCacheData);
+        ASSERT_NE(pCacheData, nullptr);
+        EXPECT_GT(pCacheData->GetSize(), size_t{0});
+    }
+
+    PipelineStateCacheCreateInfo CacheCI;
+    CacheCI.Desc.Name     = "Warm pipeline state cache";
+    CacheCI.pCacheData    = pCacheData->GetConstDataPtr();
+    CacheCI.CacheDataSize = static_cast<Uint32>(pCacheData->GetSize());
+
+    RefCntAutoPtr<IPipelineStateCache> pWarmCache;
+    pDevice->CreatePipelineStateCache(CacheCI, &pWarmCache);
+    ASSERT_NE(pWarmCache, nullptr);
+
+    const auto WarmStats = CreatePipelines(pWarmCache);
+    // Some drivers do not serialize the pipelines, in which case the initial data may be empty
+    EXPECT_LE(WarmStats.InitialDataSize, CacheCI.CacheDataSize);
+    EXPECT_EQ(WarmStats.NumPipelinesCreated, NumPipelines);
+
+    const auto TimeSaved = ColdStats.TotalCreationTime - WarmStats.TotalCreationTime;
+    LOG_INFO_MESSAGE("Pipeline creation time: cold start: ", ColdStats.TotalCreationTime * 1000.0, " ms, warm start: ",
+                     WarmStats.TotalCreationTime * 1000.0, " ms, saved: ", TimeSaved * 1000.0, " ms (", NumPipelines, " pipelines)");
+    ::testing::Test::RecordProperty("PipelineCreationTimeSavedUs", std::to_string(static_cast<Int64>(TimeSaved * 1e+6)));
+}
+
+TEST(PipelineStateCacheTest, RejectInvalidData)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    RefCntAutoPtr<IPipelineStateCache> pCache;
+    {
+        PipelineStateCacheCreateInfo CacheCI;
+        CacheCI.Desc.Name = "Pipeline state cache";
+        pDevice->CreatePipelineStateCache(CacheCI, &pCache);
+        if (!pCache)
+        {
+            GTEST_SKIP() << "Pipeline state caches are not supported by this device";
+        }
+    }
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    pCache->GetData(&pCacheData);
+    ASSERT_NE(pCacheData, nullptr);
+
+    std::vector<Uint8> Data{static_cast<const Uint8*>(pCacheData->GetConstDataPtr()),
+                            static_cast<const Uint8*>(pCacheData->GetConstDataPtr()) + pCacheData->GetSize()};
+
+    auto TestData = [&](const std::vector<Uint8>& TestData) {
+        PipelineStateCacheCreateInfo CacheCI;
+        CacheCI.Desc.Name     = "Pipeline state cache with invalid data";
+        CacheCI.pCacheData    = TestData.data();
+        CacheCI.CacheDataSize = static_cast<Uint32>(TestData.size());
+
+        RefCntAutoPtr<IPipelineStateCache> pInvalidCache;
+        pDevice->CreatePipelineStateCache(CacheCI, &pInvalidCache);
+        ASSERT_NE(pInvalidCache, nullptr);
+
+        PipelineStateCacheStats Stats;
+        pInvalidCache->GetStats(Stats);
+        EXPECT_EQ(Stats.InitialDataSize, 0u);
+    };
+
+    // Truncated header
+    TestData(std::vector<Uint8>{Data.begin(), Data.begin() + Data.size() / 4});
+
+    // Different device
+    {
+        auto BadData = Data;
+        BadData[8] ^= 0xFF; // Vendor ID in the engine header
+        TestData(BadData);
+    }
+
+    // Corrupted payload
+    if (Data.size() > 64)
+    {
+        auto BadData = Data;
+        BadData.back() ^= 0xFF;
+        TestData(BadData);
+    }
+}
+
+} // namespace
@@ -0,0 +1,262 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* g_VSSource = R"(
+float4 main() : SV_Position
+{
+    return float4(0.0, 0.0, 0.0, 1.0);
+}
+)";
+
+static const char* g_PSSource = R"(
+Texture2D<float4> g_Tex2D;
+SamplerState      g_Tex2D_sampler;
+
+float4 main() : SV_Target
+{
+    return g_Tex2D.Sample(g_Tex2D_sampler, float2(0.5, 0.5));
+}
+)";
+
+static const char* g_PSSource2 = R"(
+float4 main() : SV_Target
+{
+    return float4(1.0, 0.0, 0.0, 1.0);
+}
+)";
+
+class PipelineStateRegistryTest : public ::testing::Test
+{
+protected:
+    static void TearDownTestSuite()
+    {
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    // Every call creates a new shader object, so that the registry
+    // has to compare shaders by their byte code.
+    static RefCntAutoPtr<IShader> CreateShader(SHADER_TYPE ShaderType, const char* Source)
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.EntryPoint                 = "main";
+        ShaderCI.Desc.Name                  = "Pipeline state registry test shader";
+        ShaderCI.Desc.ShaderType            = ShaderType;
+        ShaderCI.Source                     = Source;
+
+        RefCntAutoPtr<IShader> pShader;
+        pDevice->CreateShader(ShaderCI, &pShader);
+        return pShader;
+    }
+
+    struct PSOAttribs
+    {
+        const char*                   Name              = "Pipeline state registry test PSO";
+        const char*                   PSSource          = g_PSSource;
+        SHADER_RESOURCE_VARIABLE_TYPE TexVarType        = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+        BLEND_FACTOR                  SrcBlend          = BLEND_FACTOR_ONE;
+        PSO_CREATE_FLAGS              Flags             = PSO_CREATE_FLAG_SHARED;
+        Uint32                        SRBPoolSize       = 0;
+        IPipelineState*               pAsyncFallbackPSO = nullptr;
+    };
+
+    static RefCntAutoPtr<IPipelineState> CreatePSO(const PSOAttribs& Attribs)
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& PSODesc          = PSOCreateInfo.PSODesc;
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSODesc.Name        = Attribs.Name;
+        PSODesc.SRBPoolSize = Attribs.SRBPoolSize;
+
+        GraphicsPipeline.NumRenderTargets                    = 1;
+        GraphicsPipeline.RTVFormats[0]                       = TEX_FORMAT_RGBA8_UNORM;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable        = False;
+        GraphicsPipeline.BlendDesc.RenderTargets[0].SrcBlend = Attribs.SrcBlend;
+
+        ShaderResourceVariableDesc Vars[] = {{SHADER_TYPE_PIXEL, "g_Tex2D", Attribs.TexVarType}};
+        PSODesc.ResourceLayout.Variables    = Vars;
+        PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+        auto pVS = CreateShader(SHADER_TYPE_VERTEX, g_VSSource);
+        auto pPS = CreateShader(SHADER_TYPE_PIXEL, Attribs.PSSource);
+        if (!pVS || !pPS)
+            return {};
+
+        PSOCreateInfo.pVS               = pVS;
+        PSOCreateInfo.pPS               = pPS;
+        PSOCreateInfo.Flags             = Attribs.Flags | PSO_CREATE_FLAG_IGNORE_MISSING_VARIABLES;
+        PSOCreateInfo.pAsyncFallbackPSO = Attribs.pAsyncFallbackPSO;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        return pPSO;
+    }
+};
+
+TEST_F(PipelineStateRegistryTest, ShareIdenticalPipelines)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    PipelineStateRegistryStats StartStats;
+    pDevice->GetPipelineStateRegistryStats(StartStats);
+
+    PSOAttribs Attribs;
+
+    auto pPSO = CreatePSO(Attribs);
+    ASSERT_NE(pPSO, nullptr);
+
+    // The name is not part of the key
+    Attribs.Name = "Pipeline state registry test PSO 2";
+    auto pPSO2   = CreatePSO(Attribs);
+    EXPECT_EQ(pPSO, pPSO2);
+
+    PipelineStateRegistryStats Stats;
+    pDevice->GetPipelineStateRegistryStats(Stats);
+    EXPECT_EQ(Stats.NumMisses - StartStats.NumMisses, 1u);
+    EXPECT_EQ(Stats.NumHits - StartStats.NumHits, 1u);
+
+    // Pipelines created without the flag are never shared
+    {
+        PSOAttribs NotSharedAttribs;
+        NotSharedAttribs.Flags = PSO_CREATE_FLAG_NONE;
+
+        auto pNotSharedPSO = CreatePSO(NotSharedAttribs);
+        ASSERT_NE(pNotSharedPSO, nullptr);
+        EXPECT_NE(pNotSharedPSO, pPSO);
+    }
+}
+
+TEST_F(PipelineStateRegistryTest, DistinguishDifferentPipelines)
+{
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    PSOAttribs Attribs;
+
+    auto pPSO = CreatePSO(Attribs);
+    ASSERT_NE(pPSO, nullptr);
+
+    {
+        PSOAttribs DiffShader;
+        DiffShader.PSSource = g_PSSource2;
+
+        auto pPSO2 = CreatePSO(DiffShader);
+        ASSERT_NE(pPSO2, nullptr);
+        EXPECT_NE(pPSO, pPSO2);
+    }
+
+    {
+        PSOAttribs DiffLayout;
+        DiffLayout.TexVarType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+
+        auto pPSO2 = CreatePSO(DiffLayout);
+        ASSERT_NE(pPSO2, nullptr);
+        EXPECT_NE(pPSO, pPSO2);
+    }
+
+    {
+        PSOAttribs DiffBlendState;
+        DiffBlendState.SrcBlend = BLEND_FACTOR_SRC_ALPHA;
+
+        auto pPSO2 = CreatePSO(DiffBlendState);
+        ASSERT_NE(pPSO2, nullptr);
+        EXPECT_NE(pPSO, pPSO2);
+    }
+
+    {
+        PSOAttribs DiffSRBPoolSize;
+        DiffSRBPoolSize.SRBPoolSize = 4;
+
+        auto pPSO2 = CreatePSO(DiffSRBPoolSize);
+        ASSERT_NE(pPSO2, nullptr);
+        EXPECT_NE(pPSO, pPSO2);
+        EXPECT_EQ(pPSO2->GetDesc().SRBPoolSize, 4u);
+    }
+
+    {
+        // Synchronous requests must not get a pipeline that may still be compiling
+        PSOAttribs Async;
+        Async.Flags = PSO_CREATE_FLAG_SHARED | PSO_CREATE_FLAG_ASYNCHRONOUS;
+
+        auto pPSO2 = CreatePSO(Async);
+        ASSERT_NE(pPSO2, nullptr);
+        EXPECT_NE(pPSO, pPSO2);
+
+        // Asynchronous pipelines with different fallback pipelines are not shared
+        Async.pAsyncFallbackPSO = pPSO;
+
+        auto pPSO3 = CreatePSO(Async);
+        ASSERT_NE(pPSO3, nullptr);
+        EXPECT_NE(pPSO2, pPSO3);
+    }
+}
+
+TEST_F(PipelineStateRegistryTest, ReleasedPipelines)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    PipelineStateRegistryStats StartStats;
+    pDevice->GetPipelineStateRegistryStats(StartStats);
+
+    // Released pipelines must not be returned by the registry
+    {
+        auto pPSO = CreatePSO(PSOAttribs{});
+        ASSERT_NE(pPSO, nullptr);
+    }
+
+    auto pPSO = CreatePSO(PSOAttribs{});
+    ASSERT_NE(pPSO, nullptr);
+
+    PipelineStateRegistryStats Stats;
+    pDevice->GetPipelineStateRegistryStats(Stats);
+    EXPECT_EQ(Stats.NumMisses - StartStats.NumMisses, 2u);
+    EXPECT_EQ(Stats.NumHits - StartStats.NumHits, 0u);
+}
+
+} // namespace
@@ -0,0 +1,259 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* g_VSSource = R"(
+float4 main() : SV_Position
+{
+    return float4(0.0, 0.0, 0.0, 1.0);
+}
+)";
+
+static const char* g_PSSource = R"(
+Texture2D<float4> g_Tex2D;
+SamplerState      g_Tex2D_sampler;
+
+float4 main() : SV_Target
+{
+    return g_Tex2D.Sample(g_Tex2D_sampler, float2(0.5, 0.5));
+}
+)";
+
+class RedundantStateFilterTest : public ::testing::Test
+{
+protected:
+    static void TearDownTestSuite()
+    {
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    static RefCntAutoPtr<IPipelineState> CreatePSO(SHADER_RESOURCE_VARIABLE_TYPE TexVarType, BLEND_FACTOR SrcBlend)
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.EntryPoint                 = "main";
+
+        RefCntAutoPtr<IShader> pVS;
+        {
+            ShaderCI.Desc.Name       = "Redundant state filter test VS";
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+            ShaderCI.Source          = g_VSSource;
+            pDevice->CreateShader(ShaderCI, &pVS);
+        }
+
+        RefCntAutoPtr<IShader> pPS;
+        {
+            ShaderCI.Desc.Name       = "Redundant state filter test PS";
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+            ShaderCI.Source          = g_PSSource;
+            pDevice->CreateShader(ShaderCI, &pPS);
+        }
+        if (!pVS || !pPS)
+            return {};
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& PSODesc          = PSOCreateInfo.PSODesc;
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSODesc.Name = "Redundant state filter test PSO";
+
+        GraphicsPipeline.NumRenderTargets                    = 1;
+        GraphicsPipeline.RTVFormats[0]                       = TEX_FORMAT_RGBA8_UNORM;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable        = False;
+        GraphicsPipeline.BlendDesc.RenderTargets[0].SrcBlend = SrcBlend;
+
+        ShaderResourceVariableDesc Vars[] = {{SHADER_TYPE_PIXEL, "g_Tex2D", TexVarType}};
+        PSODesc.ResourceLayout.Variables    = Vars;
+        PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        return pPSO;
+    }
+
+    static RefCntAutoPtr<IShaderResourceBinding> CreateSRB(IPipelineState* pPSO, ITexture* pTex)
+    {
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        pPSO->CreateShaderResourceBinding(&pSRB, true);
+        if (pSRB)
+            pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D")->Set(pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        return pSRB;
+    }
+};
+
+TEST_F(RedundantStateFilterTest, FilterRedundantStates)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    RedundantStateStats StartStats;
+    pContext->GetRedundantStateStats(StartStats);
+
+    Viewport VP{0, 0, 128, 64};
+    pContext->SetViewports(1, &VP, 128, 64);
+    pContext->SetViewports(1, &VP, 128, 64);
+    VP.Width = 32;
+    pContext->SetViewports(1, &VP, 128, 64);
+
+    Rect Scissor{0, 0, 16, 16};
+    pContext->SetScissorRects(1, &Scissor, 128, 64);
+    pContext->SetScissorRects(1, &Scissor, 128, 64);
+
+    pContext->SetStencilRef(15);
+    pContext->SetStencilRef(15);
+
+    const float BlendFactors[] = {0.25f, 0.5f, 0.75f, 1.f};
+    pContext->SetBlendFactors(BlendFactors);
+    pContext->SetBlendFactors(BlendFactors);
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name          = "Redundant state filter test vertex buffer";
+    BuffDesc.uiSizeInBytes = 256;
+    BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+    BuffDesc.Usage         = USAGE_DEFAULT;
+
+    RefCntAutoPtr<IBuffer> pVB;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pVB);
+    ASSERT_NE(pVB, nullptr);
+
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {16};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    // The buffer is already in vertex buffer state, so no transition is required
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_NONE);
+    // Different offset
+    Offsets[0] = 0;
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_NONE);
+    // Resetting slot 0 changes the state
+    pContext->SetVertexBuffers(1, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    RedundantStateStats Stats;
+    pContext->GetRedundantStateStats(Stats);
+    EXPECT_EQ(Stats.NumViewportsCalls - StartStats.NumViewportsCalls, 1u);
+    EXPECT_EQ(Stats.NumScissorRectsCalls - StartStats.NumScissorRectsCalls, 1u);
+    EXPECT_EQ(Stats.NumStencilRefCalls - StartStats.NumStencilRefCalls, 1u);
+    EXPECT_EQ(Stats.NumBlendFactorsCalls - StartStats.NumBlendFactorsCalls, 1u);
+    EXPECT_EQ(Stats.NumVertexBuffersCalls - StartStats.NumVertexBuffersCalls, 2u);
+
+    pContext->InvalidateState();
+}
+
+TEST_F(RedundantStateFilterTest, FilterRedundantCommits)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pTex = pEnv->CreateTexture("Redundant state filter test texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 64, 64);
+    ASSERT_NE(pTex, nullptr);
+
+    auto pPSO  = CreatePSO(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, BLEND_FACTOR_ONE);
+    auto pPSO2 = CreatePSO(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, BLEND_FACTOR_SRC_ALPHA);
+    auto pPSO3 = CreatePSO(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, BLEND_FACTOR_ONE);
+    ASSERT_TRUE(pPSO && pPSO2 && pPSO3);
+
+    auto pSRB  = CreateSRB(pPSO, pTex);
+    auto pSRB2 = CreateSRB(pPSO, pTex);
+    auto pSRB3 = CreateSRB(pPSO3, pTex);
+    ASSERT_TRUE(pSRB && pSRB2 && pSRB3);
+
+    // Make sure the texture is in shader resource state
+    pContext->SetPipelineState(pPSO);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    RedundantStateStats StartStats;
+    pContext->GetRedundantStateStats(StartStats);
+
+    Uint32 ExpectedFilteredCommits = 0;
+
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    ++ExpectedFilteredCommits;
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    ++ExpectedFilteredCommits;
+
+    // Transition mode always commits resources
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    // A different SRB
+    pContext->CommitShaderResources(pSRB2, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    pContext->CommitShaderResources(pSRB2, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    ++ExpectedFilteredCommits;
+
+    // Setting a variable of the committed SRB requires the resources to be committed again
+    pSRB2->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D")->Set(pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+    pContext->CommitShaderResources(pSRB2, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    pContext->CommitShaderResources(pSRB2, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    ++ExpectedFilteredCommits;
+
+    // Pipeline change invalidates the committed resources
+    pContext->SetPipelineState(pPSO2);
+    pContext->CommitShaderResources(pSRB2, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    pContext->SetPipelineState(pPSO);
+    pContext->CommitShaderResources(pSRB2, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    // SRBs with dynamic variables are always committed
+    pContext->SetPipelineState(pPSO3);
+    pContext->CommitShaderResources(pSRB3, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    pContext->CommitShaderResources(pSRB3, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    // OpenGL backend always re-commits resources
+    if (pDevice->GetDeviceCaps().IsGLDevice())
+        ExpectedFilteredCommits = 0;
+
+    RedundantStateStats Stats;
+    pContext->GetRedundantStateStats(Stats);
+    EXPECT_EQ(Stats.NumCommitShaderResourcesCalls - StartStats.NumCommitShaderResourcesCalls, ExpectedFilteredCommits);
+
+    pContext->InvalidateState();
+}
+
+} // namespace
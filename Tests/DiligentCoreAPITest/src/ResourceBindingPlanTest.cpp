@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+#include "ShaderResourceBindingTestBase.hpp"
+#include "ResourceBindingPlan.h"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* g_PSSource = R"(
+Texture2D<float4> g_Tex0;
+Texture2D<float4> g_TexArr[2];
+Texture2D<float4> g_TexDyn;
+
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    int3 Location = int3(0, 0, 0);
+    return g_Tex0.Load(Location) + g_TexArr[0].Load(Location) + g_TexArr[1].Load(Location) + g_TexDyn.Load(Location);
+}
+)";
+
+class ResourceBindingPlanTest : public ShaderResourceBindingTestBase, public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        ShaderResourceVariableDesc Vars[] = {{SHADER_TYPE_PIXEL, "g_TexDyn", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}};
+
+        PipelineResourceLayoutDesc ResourceLayout;
+        ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+        ResourceLayout.Variables           = Vars;
+        ResourceLayout.NumVariables        = _countof(Vars);
+
+        InitResources("Resource binding plan test", g_PSSource, ResourceLayout);
+    }
+
+    static void TearDownTestSuite()
+    {
+        ReleaseResources();
+    }
+
+    static RefCntAutoPtr<IResourceMapping> CreateResourceMapping(bool AddDynamic)
+    {
+        // clang-format off
+        ResourceMappingEntry Entries[] =
+        {
+            {"cbConstants", sm_pConstBuffer,    0},
+            {"g_Tex0",      sm_pTextureSRVs[0], 0},
+            {"g_TexArr",    sm_pTextureSRVs[1], 0},
+            {"g_TexArr",    sm_pTextureSRVs[2], 1},
+            {"g_TexDyn",    sm_pTextureSRVs[3], 0},
+            {}
+        };
+        // clang-format on
+        if (!AddDynamic)
+            Entries[4] = {};
+
+        ResourceMappingDesc ResMappingDesc{Entries};
+
+        RefCntAutoPtr<IResourceMapping> pResMapping;
+        TestingEnvironment::GetInstance()->GetDevice()->CreateResourceMapping(ResMappingDesc, &pResMapping);
+        return pResMapping;
+    }
+};
+
+TEST_F(ResourceBindingPlanTest, BindResources)
+{
+    ASSERT_NE(sm_pPSO, nullptr);
+
+    auto pResMapping = CreateResourceMapping(false);
+    ASSERT_NE(pResMapping, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB0, pSRB1;
+    sm_pPSO->CreateShaderResourceBinding(&pSRB0, true);
+    sm_pPSO->CreateShaderResourceBinding(&pSRB1, true);
+    ASSERT_NE(pSRB0, nullptr);
+    ASSERT_NE(pSRB1, nullptr);
+
+    RefCntAutoPtr<IResourceBindingPlan> pPlan;
+    pSRB0->CreateBindingPlan(SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, pResMapping, BIND_SHADER_RESOURCES_UPDATE_MUTABLE | BIND_SHADER_RESOURCES_UPDATE_DYNAMIC, &pPlan);
+    ASSERT_NE(pPlan, nullptr);
+    // cbConstants, g_Tex0, g_TexArr[0], g_TexArr[1], g_TexDyn
+    EXPECT_EQ(pPlan->GetNumBindings(), 5u);
+
+    pPlan->BindResources(pSRB0);
+    EXPECT_TRUE(pSRB0->GetVariableByName(SHADER_TYPE_VERTEX, "cbConstants")->IsBound(0));
+    EXPECT_TRUE(pSRB0->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex0")->IsBound(0));
+    EXPECT_TRUE(pSRB0->GetVariableByName(SHADER_TYPE_PIXEL, "g_TexArr")->IsBound(0));
+    EXPECT_TRUE(pSRB0->GetVariableByName(SHADER_TYPE_PIXEL, "g_TexArr")->IsBound(1));
+    EXPECT_FALSE(pSRB0->GetVariableByName(SHADER_TYPE_PIXEL, "g_TexDyn")->IsBound(0));
+
+    // Resources added to the mapping after the plan has been created are picked up by the plan
+    pResMapping->AddResource("g_TexDyn", sm_pTextureSRVs[3], false);
+    pPlan->BindResources(pSRB0);
+    EXPECT_TRUE(pSRB0->GetVariableByName(SHADER_TYPE_PIXEL, "g_TexDyn")->IsBound(0));
+
+    // The plan can be used with any SRB of the same pipeline
+    pPlan->BindResources(pSRB1);
+    EXPECT_TRUE(pSRB1->GetVariableByName(SHADER_TYPE_VERTEX, "cbConstants")->IsBound(0));
+    EXPECT_TRUE(pSRB1->GetVariableByName(SHADER_TYPE_PIXEL, "g_TexArr")->IsBound(1));
+    EXPECT_TRUE(pSRB1->GetVariableByName(SHADER_TYPE_PIXEL, "g_TexDyn")->IsBound(0));
+}
+
+TEST_F(ResourceBindingPlanTest, ShaderAndVariableTypeFilters)
+{
+    ASSERT_NE(sm_pPSO, nullptr);
+
+    auto pResMapping = CreateResourceMapping(true);
+    ASSERT_NE(pResMapping, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    sm_pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    RefCntAutoPtr<IResourceBindingPlan> pDynPlan;
+    pSRB->CreateBindingPlan(SHADER_TYPE_PIXEL, pResMapping, BIND_SHADER_RESOURCES_UPDATE_DYNAMIC, &pDynPlan);
+    ASSERT_NE(pDynPlan, nullptr);
+    EXPECT_EQ(pDynPlan->GetNumBindings(), 1u);
+
+    pDynPlan->BindResources(pSRB);
+    EXPECT_FALSE(pSRB->GetVariableByName(SHADER_TYPE_VERTEX, "cbConstants")->IsBound(0));
+    EXPECT_FALSE(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex0")->IsBound(0));
+    EXPECT_TRUE(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_TexDyn")->IsBound(0));
+
+    RefCntAutoPtr<IResourceBindingPlan> pVSPlan;
+    pSRB->CreateBindingPlan(SHADER_TYPE_VERTEX, pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL, &pVSPlan);
+    ASSERT_NE(pVSPlan, nullptr);
+    EXPECT_EQ(pVSPlan->GetNumBindings(), 1u);
+
+    pVSPlan->BindResources(pSRB);
+    EXPECT_TRUE(pSRB->GetVariableByName(SHADER_TYPE_VERTEX, "cbConstants")->IsBound(0));
+    EXPECT_FALSE(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex0")->IsBound(0));
+}
+
+TEST_F(ResourceBindingPlanTest, LargeMappingThroughput)
+{
+    ASSERT_NE(sm_pPSO, nullptr);
+
+    auto pResMapping = CreateResourceMapping(true);
+    ASSERT_NE(pResMapping, nullptr);
+
+    // Populate the mapping with resources that are not used by the pipeline
+    constexpr Uint32 NumExtraResources = 16384;
+    for (Uint32 i = 0; i < NumExtraResources; ++i)
+    {
+        auto Name = std::string{"g_UnusedTex"} + std::to_string(i);
+        pResMapping->AddResource(Name.c_str(), sm_pTextureSRVs[i % sm_pTextureSRVs.size()], false);
+    }
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    sm_pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    constexpr Uint32 BindFlags = BIND_SHADER_RESOURCES_UPDATE_MUTABLE | BIND_SHADER_RESOURCES_UPDATE_DYNAMIC;
+
+    RefCntAutoPtr<IResourceBindingPlan> pPlan;
+    pSRB->CreateBindingPlan(SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, pResMapping, BindFlags, &pPlan);
+    ASSERT_NE(pPlan, nullptr);
+
+    constexpr Uint32 NumIterations = 4096;
+
+    // Mutable variables are always rebound to the same objects
+    {
+        Timer T;
+        for (Uint32 i = 0; i < NumIterations; ++i)
+            pSRB->BindResources(SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, pResMapping, BindFlags);
+        TestingEnvironment::ReportThroughput("MappingBindsPerSecond", NumIterations, T.GetElapsedTime());
+    }
+
+    {
+        Timer T;
+        for (Uint32 i = 0; i < NumIterations; ++i)
+            pPlan->BindResources(pSRB);
+        TestingEnvironment::ReportThroughput("PlanBindsPerSecond", NumIterations, T.GetElapsedTime());
+    }
+
+    EXPECT_TRUE(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_TexArr")->IsBound(1));
+    EXPECT_TRUE(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_TexDyn")->IsBound(0));
+}
+
+} // namespace
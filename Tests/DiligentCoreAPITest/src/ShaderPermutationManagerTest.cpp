@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+
+#include "ShaderPermutationManager.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_ShaderSource[] = R"(
+// UNUSED_MACRO is only mentioned in a comment
+#if USE_RED
+#   define COLOR float4(1.0, 0.0, 0.0, 1.0)
+#else
+#   define COLOR float4(0.0, 1.0, 0.0, 1.0)
+#endif
+
+float4 main() : SV_Target
+{
+    return COLOR * SCALE;
+}
+)";
+
+class ShaderPermutationManagerTest : public ::testing::Test
+{
+protected:
+    static RefCntAutoPtr<IShader> CreateShader(ShaderPermutationManager& Manager, const ShaderMacro* Macros)
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Source          = g_ShaderSource;
+        ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler  = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.Desc.Name       = "Shader permutation manager test";
+        ShaderCI.Macros          = Macros;
+
+        RefCntAutoPtr<IShader> pShader;
+        Manager.CreateShader(pDevice, ShaderCI, &pShader);
+        return pShader;
+    }
+};
+
+TEST_F(ShaderPermutationManagerTest, Deduplication)
+{
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    ShaderPermutationManager Manager;
+
+    // clang-format off
+    const ShaderMacro Macros0[] = {{"USE_RED", "1"}, {"SCALE", "SCALE_VALUE"}, {"SCALE_VALUE", "0.5"}, {"UNUSED_MACRO", "0"}, {}};
+    // Different order
+    const ShaderMacro Macros1[] = {{"SCALE_VALUE", "0.5"}, {"SCALE", "SCALE_VALUE"}, {"USE_RED", "1"}, {}};
+    // Different values of macros that are not referenced
+    const ShaderMacro Macros2[] = {{"USE_RED", "1"}, {"UNUSED_MACRO", "1"}, {"SCALE", "SCALE_VALUE"}, {"SCALE_VALUE", "0.5"}, {"ANOTHER_UNUSED_MACRO", "2"}, {}};
+    // Different value of a macro referenced by the source
+    const ShaderMacro Macros3[] = {{"USE_RED", "0"}, {"SCALE", "SCALE_VALUE"}, {"SCALE_VALUE", "0.5"}, {}};
+    // Different value of a macro that is only referenced by the definition of another macro
+    const ShaderMacro Macros4[] = {{"USE_RED", "1"}, {"SCALE", "SCALE_VALUE"}, {"SCALE_VALUE", "0.25"}, {}};
+    // clang-format on
+
+    auto pShader0 = CreateShader(Manager, Macros0);
+    ASSERT_NE(pShader0, nullptr);
+    auto pShader1 = CreateShader(Manager, Macros1);
+    auto pShader2 = CreateShader(Manager, Macros2);
+    auto pShader3 = CreateShader(Manager, Macros3);
+    ASSERT_NE(pShader3, nullptr);
+    auto pShader4 = CreateShader(Manager, Macros4);
+    ASSERT_NE(pShader4, nullptr);
+
+    EXPECT_EQ(pShader1, pShader0);
+    EXPECT_EQ(pShader2, pShader0);
+    EXPECT_NE(pShader3, pShader0);
+    EXPECT_NE(pShader4, pShader0);
+    EXPECT_NE(pShader4, pShader3);
+
+    auto Stats = Manager.GetStatistics();
+    EXPECT_EQ(Stats.NumRequested, 5u);
+    EXPECT_EQ(Stats.NumUnique, 3u);
+    EXPECT_EQ(Stats.NumCompiled, 3u);
+    EXPECT_EQ(Stats.NumIgnoredMacros, 3u);
+
+    Manager.Clear();
+    Stats = Manager.GetStatistics();
+    EXPECT_EQ(Stats.NumRequested, 0u);
+    EXPECT_EQ(Stats.NumUnique, 0u);
+
+    // Shaders are compiled again after the manager has been cleared
+    auto pShader5 = CreateShader(Manager, Macros0);
+    ASSERT_NE(pShader5, nullptr);
+    EXPECT_NE(pShader5, pShader0);
+    EXPECT_EQ(Manager.GetStatistics().NumCompiled, 1u);
+}
+
+} // namespace
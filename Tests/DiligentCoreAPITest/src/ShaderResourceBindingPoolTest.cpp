@@ -0,0 +1,244 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* g_VSSource = R"(
+float4 main() : SV_Position
+{
+    return float4(0.0, 0.0, 0.0, 1.0);
+}
+)";
+
+static const char* g_PSSource = R"(
+Texture2D<float4> g_Tex2D;
+SamplerState      g_Tex2D_sampler;
+
+float4 main() : SV_Target
+{
+    return g_Tex2D.Sample(g_Tex2D_sampler, float2(0.5, 0.5));
+}
+)";
+
+class ShaderResourceBindingPoolTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv = TestingEnvironment::GetInstance();
+
+        sm_pPooledPSO    = CreatePSO(16);
+        sm_pNonPooledPSO = CreatePSO(0);
+        sm_pTexture      = pEnv->CreateTexture("SRB pool test texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 4, 4);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pPooledPSO.Release();
+        sm_pNonPooledPSO.Release();
+        sm_pTexture.Release();
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    static RefCntAutoPtr<IPipelineState> CreatePSO(Uint32 SRBPoolSize)
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.EntryPoint                 = "main";
+
+        RefCntAutoPtr<IShader> pVS;
+        {
+            ShaderCI.Desc.Name       = "SRB pool test VS";
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+            ShaderCI.Source          = g_VSSource;
+            pDevice->CreateShader(ShaderCI, &pVS);
+        }
+
+        RefCntAutoPtr<IShader> pPS;
+        {
+            ShaderCI.Desc.Name       = "SRB pool test PS";
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+            ShaderCI.Source          = g_PSSource;
+            pDevice->CreateShader(ShaderCI, &pPS);
+        }
+        if (!pVS || !pPS)
+            return {};
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& PSODesc          = PSOCreateInfo.PSODesc;
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSODesc.Name        = SRBPoolSize > 0 ? "SRB pool test PSO" : "SRB pool test PSO without pool";
+        PSODesc.SRBPoolSize = SRBPoolSize;
+
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        ShaderResourceVariableDesc Vars[] = {{SHADER_TYPE_PIXEL, "g_Tex2D", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE}};
+        PSODesc.ResourceLayout.Variables    = Vars;
+        PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        return pPSO;
+    }
+
+    static RefCntAutoPtr<IPipelineState> sm_pPooledPSO;
+    static RefCntAutoPtr<IPipelineState> sm_pNonPooledPSO;
+    static RefCntAutoPtr<ITexture>       sm_pTexture;
+};
+
+RefCntAutoPtr<IPipelineState> ShaderResourceBindingPoolTest::sm_pPooledPSO;
+RefCntAutoPtr<IPipelineState> ShaderResourceBindingPoolTest::sm_pNonPooledPSO;
+RefCntAutoPtr<ITexture>       ShaderResourceBindingPoolTest::sm_pTexture;
+
+TEST_F(ShaderResourceBindingPoolTest, RecycleReleasedSRB)
+{
+    ASSERT_NE(sm_pPooledPSO, nullptr);
+    auto* pSRV = sm_pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+    IShaderResourceBinding* pRawSRB = nullptr;
+    {
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        sm_pPooledPSO->CreateShaderResourceBinding(&pSRB, true);
+        ASSERT_NE(pSRB, nullptr);
+        pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D")->Set(pSRV);
+        pRawSRB = pSRB;
+    }
+
+    // Make sure the GPU is done with the released SRB
+    TestingEnvironment::GetInstance()->Reset();
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    sm_pPooledPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+    EXPECT_EQ(pSRB.RawPtr(), pRawSRB);
+    EXPECT_EQ(pSRB->GetPipelineState(), sm_pPooledPSO);
+
+    // Recycled SRB must not reference the resources bound before it was released
+    auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D");
+    ASSERT_NE(pVar, nullptr);
+    EXPECT_FALSE(pVar->IsBound(0));
+    pVar->Set(pSRV);
+    EXPECT_TRUE(pVar->IsBound(0));
+}
+
+TEST_F(ShaderResourceBindingPoolTest, DoNotRecycleWeaklyReferencedSRB)
+{
+    ASSERT_NE(sm_pPooledPSO, nullptr);
+
+    RefCntWeakPtr<IShaderResourceBinding> pWeakSRB;
+    {
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        sm_pPooledPSO->CreateShaderResourceBinding(&pSRB, true);
+        ASSERT_NE(pSRB, nullptr);
+        pWeakSRB = RefCntWeakPtr<IShaderResourceBinding>{pSRB};
+    }
+    EXPECT_FALSE(pWeakSRB.Lock());
+}
+
+TEST_F(ShaderResourceBindingPoolTest, Clone)
+{
+    ASSERT_NE(sm_pPooledPSO, nullptr);
+    auto* pSRV = sm_pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+    for (auto* pPSO : {sm_pPooledPSO.RawPtr(), sm_pNonPooledPSO.RawPtr()})
+    {
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        pPSO->CreateShaderResourceBinding(&pSRB, true);
+        ASSERT_NE(pSRB, nullptr);
+
+        RefCntAutoPtr<IShaderResourceBinding> pEmptyClone;
+        pSRB->Clone(&pEmptyClone);
+        ASSERT_NE(pEmptyClone, nullptr);
+        EXPECT_FALSE(pEmptyClone->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D")->IsBound(0));
+
+        pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D")->Set(pSRV);
+
+        RefCntAutoPtr<IShaderResourceBinding> pClone;
+        pSRB->Clone(&pClone);
+        ASSERT_NE(pClone, nullptr);
+        EXPECT_NE(pClone, pSRB);
+        EXPECT_EQ(pClone->GetPipelineState(), pPSO);
+        EXPECT_TRUE(pClone->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D")->IsBound(0));
+    }
+}
+
+TEST_F(ShaderResourceBindingPoolTest, TransientSRBThroughput)
+{
+    ASSERT_NE(sm_pPooledPSO, nullptr);
+    auto* pEnv = TestingEnvironment::GetInstance();
+    auto* pSRV = sm_pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+    constexpr Uint32 NumFrames      = 16;
+    constexpr Uint32 NumSRBPerFrame = 16;
+
+    auto RunFrames = [&](IPipelineState* pPSO) {
+        double ElapsedTime = 0;
+        for (Uint32 frame = 0; frame < NumFrames; ++frame)
+        {
+            Timer T;
+            {
+                std::vector<RefCntAutoPtr<IShaderResourceBinding>> SRBs(NumSRBPerFrame);
+                for (auto& pSRB : SRBs)
+                {
+                    pPSO->CreateShaderResourceBinding(&pSRB, true);
+                    pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D")->Set(pSRV);
+                }
+            }
+            ElapsedTime += T.GetElapsedTime();
+            pEnv->ReleaseResources();
+        }
+        return ElapsedTime;
+    };
+
+    TestingEnvironment::ReportThroughput("NonPooledSRBsPerSecond", NumFrames * NumSRBPerFrame, RunFrames(sm_pNonPooledPSO));
+    TestingEnvironment::ReportThroughput("PooledSRBsPerSecond", NumFrames * NumSRBPerFrame, RunFrames(sm_pPooledPSO));
+}
+
+} // namespace
@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderResourceBindingTestBase.hpp"
+
+#include <string>
+
+#include "TestingEnvironment.hpp"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+constexpr Uint32 ShaderResourceBindingTestBase::NumTextures;
+
+RefCntAutoPtr<IPipelineState>                                                   ShaderResourceBindingTestBase::sm_pPSO;
+RefCntAutoPtr<IBuffer>                                                          ShaderResourceBindingTestBase::sm_pConstBuffer;
+std::array<RefCntAutoPtr<ITexture>, ShaderResourceBindingTestBase::NumTextures> ShaderResourceBindingTestBase::sm_pTextures;
+std::array<ITextureView*, ShaderResourceBindingTestBase::NumTextures>           ShaderResourceBindingTestBase::sm_pTextureSRVs;
+
+static const char* g_VSSource = R"(
+cbuffer cbConstants
+{
+    float4 g_Offset;
+}
+
+float4 main() : SV_Position
+{
+    return g_Offset;
+}
+)";
+
+void ShaderResourceBindingTestBase::InitResources(const char* TestName, const char* PSSource, const PipelineResourceLayoutDesc& ResourceLayout)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    const std::string Name{TestName};
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.EntryPoint                 = "main";
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        const auto VSName        = Name + " VS";
+        ShaderCI.Desc.Name       = VSName.c_str();
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        ShaderCI.Source          = g_VSSource;
+        pDevice->CreateShader(ShaderCI, &pVS);
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        const auto PSName        = Name + " PS";
+        ShaderCI.Desc.Name       = PSName.c_str();
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.Source          = PSSource;
+        pDevice->CreateShader(ShaderCI, &pPS);
+    }
+    if (!pVS || !pPS)
+        return;
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+    auto& PSODesc          = PSOCreateInfo.PSODesc;
+    auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+    const auto PSOName = Name + " PSO";
+    PSODesc.Name       = PSOName.c_str();
+
+    GraphicsPipeline.NumRenderTargets             = 1;
+    GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+    GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+    PSODesc.ResourceLayout = ResourceLayout;
+
+    PSOCreateInfo.pVS = pVS;
+    PSOCreateInfo.pPS = pPS;
+
+    pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &sm_pPSO);
+    if (!sm_pPSO)
+        return;
+
+    for (size_t i = 0; i < sm_pTextures.size(); ++i)
+    {
+        const auto TexName = Name + " texture " + std::to_string(i);
+        sm_pTextures[i]    = pEnv->CreateTexture(TexName.c_str(), TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 4, 4);
+        sm_pTextureSRVs[i] = sm_pTextures[i]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    }
+
+    const auto BuffName = Name + " constant buffer";
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name          = BuffName.c_str();
+    BuffDesc.uiSizeInBytes = 16;
+    BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+    BuffDesc.Usage         = USAGE_DEFAULT;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &sm_pConstBuffer);
+}
+
+void ShaderResourceBindingTestBase::ReleaseResources()
+{
+    sm_pPSO.Release();
+    sm_pConstBuffer.Release();
+    for (auto& pTex : sm_pTextures)
+        pTex.Release();
+    sm_pTextureSRVs = {};
+    TestingEnvironment::GetInstance()->Reset();
+}
+
+} // namespace Testing
+
+} // namespace Diligent
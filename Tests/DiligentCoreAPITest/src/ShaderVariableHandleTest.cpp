@@ -0,0 +1,194 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+#include "ShaderResourceBindingTestBase.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* g_PSSource = R"(
+Texture2D<float4> g_Tex0;
+Texture2D<float4> g_Tex1;
+Texture2D<float4> g_TexDyn;
+Texture2D<float4> g_TexStatic;
+
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    int3 Location = int3(0, 0, 0);
+    return g_Tex0.Load(Location) + g_Tex1.Load(Location) + g_TexDyn.Load(Location) + g_TexStatic.Load(Location);
+}
+)";
+
+class ShaderVariableHandleTest : public ShaderResourceBindingTestBase, public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        // clang-format off
+        ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_VERTEX, "cbConstants", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {SHADER_TYPE_PIXEL,  "g_Tex0",      SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {SHADER_TYPE_PIXEL,  "g_Tex1",      SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {SHADER_TYPE_PIXEL,  "g_TexDyn",    SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
+        };
+        // clang-format on
+        PipelineResourceLayoutDesc ResourceLayout;
+        ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+        ResourceLayout.Variables           = Vars;
+        ResourceLayout.NumVariables        = _countof(Vars);
+
+        InitResources("Shader variable handle test", g_PSSource, ResourceLayout);
+        if (sm_pPSO)
+            sm_pPSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, "g_TexStatic")->Set(sm_pTextureSRVs[0]);
+    }
+
+    static void TearDownTestSuite()
+    {
+        ReleaseResources();
+    }
+};
+
+TEST_F(ShaderVariableHandleTest, GetVariableHandle)
+{
+    ASSERT_NE(sm_pPSO, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB0, pSRB1;
+    sm_pPSO->CreateShaderResourceBinding(&pSRB0, true);
+    sm_pPSO->CreateShaderResourceBinding(&pSRB1, true);
+    ASSERT_NE(pSRB0, nullptr);
+    ASSERT_NE(pSRB1, nullptr);
+
+    const auto hCB   = pSRB0->GetVariableHandle(SHADER_TYPE_VERTEX, "cbConstants");
+    const auto hTex0 = pSRB0->GetVariableHandle(SHADER_TYPE_PIXEL, "g_Tex0");
+    const auto hTex1 = pSRB0->GetVariableHandle(SHADER_TYPE_PIXEL, "g_Tex1");
+    const auto hDyn  = pSRB0->GetVariableHandle(SHADER_TYPE_PIXEL, "g_TexDyn");
+    EXPECT_NE(hCB, INVALID_SHADER_VARIABLE_HANDLE);
+    EXPECT_NE(hTex0, INVALID_SHADER_VARIABLE_HANDLE);
+    EXPECT_NE(hTex1, INVALID_SHADER_VARIABLE_HANDLE);
+    EXPECT_NE(hDyn, INVALID_SHADER_VARIABLE_HANDLE);
+    EXPECT_NE(hTex0, hTex1);
+    EXPECT_NE(hTex0, hDyn);
+    EXPECT_NE(hCB, hTex0);
+
+    // Handles identify variables in the pipeline layout and are the same for all SRBs
+    EXPECT_EQ(hCB, pSRB1->GetVariableHandle(SHADER_TYPE_VERTEX, "cbConstants"));
+    EXPECT_EQ(hTex0, pSRB1->GetVariableHandle(SHADER_TYPE_PIXEL, "g_Tex0"));
+    EXPECT_EQ(hDyn, pSRB1->GetVariableHandle(SHADER_TYPE_PIXEL, "g_TexDyn"));
+
+    // Static variables are not accessible through the SRB
+    EXPECT_EQ(pSRB0->GetVariableHandle(SHADER_TYPE_PIXEL, "g_TexStatic"), INVALID_SHADER_VARIABLE_HANDLE);
+    EXPECT_EQ(pSRB0->GetVariableHandle(SHADER_TYPE_PIXEL, "g_Missing"), INVALID_SHADER_VARIABLE_HANDLE);
+    EXPECT_EQ(pSRB0->GetVariableHandle(SHADER_TYPE_PIXEL, "cbConstants"), INVALID_SHADER_VARIABLE_HANDLE);
+}
+
+TEST_F(ShaderVariableHandleTest, SetVariables)
+{
+    ASSERT_NE(sm_pPSO, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    sm_pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    // clang-format off
+    const Uint32 Handles[] =
+    {
+        pSRB->GetVariableHandle(SHADER_TYPE_VERTEX, "cbConstants"),
+        pSRB->GetVariableHandle(SHADER_TYPE_PIXEL,  "g_Tex0"),
+        INVALID_SHADER_VARIABLE_HANDLE,
+        pSRB->GetVariableHandle(SHADER_TYPE_PIXEL,  "g_TexDyn")
+    };
+    IDeviceObject* const Objects[] =
+    {
+        sm_pConstBuffer,
+        sm_pTextureSRVs[0],
+        sm_pTextureSRVs[1],
+        sm_pTextureSRVs[2]
+    };
+    // clang-format on
+    pSRB->SetVariables(Handles, Objects, _countof(Handles));
+
+    EXPECT_TRUE(pSRB->GetVariableByName(SHADER_TYPE_VERTEX, "cbConstants")->IsBound(0));
+    EXPECT_TRUE(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex0")->IsBound(0));
+    EXPECT_FALSE(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex1")->IsBound(0));
+    EXPECT_TRUE(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_TexDyn")->IsBound(0));
+
+    // Dynamic variables can be rebound
+    const Uint32         DynHandle = Handles[3];
+    IDeviceObject* const pNewTex   = sm_pTextureSRVs[1];
+    pSRB->SetVariables(&DynHandle, &pNewTex, 1);
+    EXPECT_TRUE(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_TexDyn")->IsBound(0));
+}
+
+TEST_F(ShaderVariableHandleTest, SetVariablesThroughput)
+{
+    ASSERT_NE(sm_pPSO, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    sm_pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    const char* Names[] = {"g_Tex0", "g_Tex1", "g_TexDyn"};
+
+    // Mutable variables may only be rebound to the same objects
+    Uint32         Handles[_countof(Names)] = {};
+    IDeviceObject* Objects[_countof(Names)] = {};
+    for (size_t i = 0; i < _countof(Names); ++i)
+    {
+        Handles[i] = pSRB->GetVariableHandle(SHADER_TYPE_PIXEL, Names[i]);
+        Objects[i] = sm_pTextureSRVs[i];
+    }
+
+    constexpr Uint32 NumIterations = 4096;
+    constexpr Uint32 NumOps        = NumIterations * static_cast<Uint32>(_countof(Names));
+
+    {
+        Timer T;
+        for (Uint32 i = 0; i < NumIterations; ++i)
+        {
+            for (size_t v = 0; v < _countof(Names); ++v)
+                pSRB->GetVariableByName(SHADER_TYPE_PIXEL, Names[v])->Set(Objects[v]);
+        }
+        TestingEnvironment::ReportThroughput("NamedVariablesPerSecond", NumOps, T.GetElapsedTime());
+    }
+
+    {
+        Timer T;
+        for (Uint32 i = 0; i < NumIterations; ++i)
+            pSRB->SetVariables(Handles, Objects, _countof(Names));
+        TestingEnvironment::ReportThroughput("HandleVariablesPerSecond", NumOps, T.GetElapsedTime());
+    }
+}
+
+} // namespace
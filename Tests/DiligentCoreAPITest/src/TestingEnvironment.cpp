@@ -49,6 +49,10 @@
 #    include "EngineFactoryMtl.h"
 #endif
 
+#if NULL_SUPPORTED
+#    include "EngineFactoryNull.h"
+#endif
+
 namespace Diligent
 {
 
@@ -88,6 +92,13 @@ void TestingEnvironment::SetErrorAllowance(int NumErrorsToAllow, const char* Inf
     }
 }
 
+void TestingEnvironment::ReportThroughput(const char* Name, Uint32 NumOps, double ElapsedTime)
+{
+    const auto OpsPerSecond = ElapsedTime > 0 ? static_cast<double>(NumOps) / ElapsedTime : 0.0;
+    LOG_INFO_MESSAGE(Name, ": ", NumOps, " in ", ElapsedTime * 1000.0, " ms (", static_cast<Uint64>(OpsPerSecond), " per second)");
+    ::testing::Test::RecordProperty(Name, std::to_string(static_cast<Uint64>(OpsPerSecond)));
+}
+
 Uint32 TestingEnvironment::FindAdapater(const std::vector<GraphicsAdapterInfo>& Adapters,
                                         ADAPTER_TYPE                            AdapterType,
                                         Uint32                                  AdapterId)
@@ -343,6 +354,29 @@ TestingEnvironment::TestingEnvironment(const CreateInfo& CI, const SwapChainDesc
         break;
 #endif
 
+#if NULL_SUPPORTED
+        case RENDER_DEVICE_TYPE_NULL:
+        {
+#    if EXPLICITLY_LOAD_ENGINE_NULL_DLL
+            // Load the dll and import GetEngineFactoryNull() function
+            auto GetEngineFactoryNull = LoadGraphicsEngineNull();
+            if (GetEngineFactoryNull == nullptr)
+            {
+                LOG_ERROR_AND_THROW("Failed to load the engine");
+            }
+#    endif
+
+            EngineNullCreateInfo CreateInfo;
+            CreateInfo.DebugMessageCallback = MessageCallback;
+            CreateInfo.Features             = DeviceFeatures{DEVICE_FEATURE_STATE_OPTIONAL};
+            CreateInfo.NumDeferredContexts  = NumDeferredCtx;
+            ppContexts.resize(1 + NumDeferredCtx);
+            auto* pFactoryNull = GetEngineFactoryNull();
+            pFactoryNull->CreateDeviceAndContextsNull(CreateInfo, &m_pDevice, ppContexts.data());
+        }
+        break;
+#endif
+
         default:
             LOG_ERROR_AND_THROW("Unknown device type");
             break;
@@ -519,6 +553,19 @@ void TestingEnvironment::SetDefaultCompiler(SHADER_COMPILER compiler)
             }
             break;
 
+        case RENDER_DEVICE_TYPE_NULL:
+            switch (compiler)
+            {
+                case SHADER_COMPILER_DEFAULT:
+                    m_ShaderCompiler = compiler;
+                    break;
+
+                default:
+                    LOG_WARNING_MESSAGE(GetShaderCompilerTypeString(compiler), " is not supported by Null backend. Using default compiler");
+                    m_ShaderCompiler = SHADER_COMPILER_DEFAULT;
+            }
+            break;
+
         default:
             LOG_WARNING_MESSAGE("Unepxected device type");
             m_ShaderCompiler = SHADER_COMPILER_DEFAULT;
@@ -0,0 +1,485 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <string>
+
+#include "TestingEnvironment.hpp"
+#include "ShaderVk.h"
+#include "SPIRVShaderResources.hpp"
+#include "SPIRVReflection.hpp"
+#include "ShaderMacroHelper.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+void CompareResources(const SPIRVShaderResources& Ref, const SPIRVShaderResources& Loaded)
+{
+    EXPECT_TRUE(Ref.IsCompatibleWith(Loaded));
+    EXPECT_TRUE(Loaded.IsCompatibleWith(Ref));
+    EXPECT_EQ(Ref.GetShaderType(), Loaded.GetShaderType());
+    EXPECT_EQ(Ref.IsHLSLSource(), Loaded.IsHLSLSource());
+    EXPECT_STREQ(Ref.GetShaderName(), Loaded.GetShaderName());
+    EXPECT_EQ(Ref.IsUsingCombinedSamplers(), Loaded.IsUsingCombinedSamplers());
+    if (Ref.IsUsingCombinedSamplers() && Loaded.IsUsingCombinedSamplers())
+        EXPECT_STREQ(Ref.GetCombinedSamplerSuffix(), Loaded.GetCombinedSamplerSuffix());
+
+    // clang-format off
+    EXPECT_EQ(Ref.GetNumUBs(),          Loaded.GetNumUBs());
+    EXPECT_EQ(Ref.GetNumSBs(),          Loaded.GetNumSBs());
+    EXPECT_EQ(Ref.GetNumImgs(),         Loaded.GetNumImgs());
+    EXPECT_EQ(Ref.GetNumSmpldImgs(),    Loaded.GetNumSmpldImgs());
+    EXPECT_EQ(Ref.GetNumACs(),          Loaded.GetNumACs());
+    EXPECT_EQ(Ref.GetNumSepSmplrs(),    Loaded.GetNumSepSmplrs());
+    EXPECT_EQ(Ref.GetNumSepImgs(),      Loaded.GetNumSepImgs());
+    EXPECT_EQ(Ref.GetNumInptAtts(),     Loaded.GetNumInptAtts());
+    EXPECT_EQ(Ref.GetNumAccelStructs(), Loaded.GetNumAccelStructs());
+    // clang-format on
+    ASSERT_EQ(Ref.GetTotalResources(), Loaded.GetTotalResources());
+
+    for (Uint32 n = 0; n < Ref.GetTotalResources(); ++n)
+    {
+        const auto& RefRes    = Ref.GetResource(n);
+        const auto& LoadedRes = Loaded.GetResource(n);
+
+        EXPECT_STREQ(RefRes.Name, LoadedRes.Name);
+        EXPECT_EQ(RefRes.Type, LoadedRes.Type) << RefRes.Name;
+        EXPECT_EQ(RefRes.ArraySize, LoadedRes.ArraySize) << RefRes.Name;
+        EXPECT_EQ(RefRes.GetResourceDimension(), LoadedRes.GetResourceDimension()) << RefRes.Name;
+        EXPECT_EQ(RefRes.IsMultisample(), LoadedRes.IsMultisample()) << RefRes.Name;
+        EXPECT_EQ(RefRes.BindingDecorationOffset, LoadedRes.BindingDecorationOffset) << RefRes.Name;
+        EXPECT_EQ(RefRes.DescriptorSetDecorationOffset, LoadedRes.DescriptorSetDecorationOffset) << RefRes.Name;
+        EXPECT_EQ(RefRes.BufferStaticSize, LoadedRes.BufferStaticSize) << RefRes.Name;
+        EXPECT_EQ(RefRes.BufferStride, LoadedRes.BufferStride) << RefRes.Name;
+        if (RefRes.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateImage)
+            EXPECT_EQ(RefRes.GetAssignedSepSamplerInd(), LoadedRes.GetAssignedSepSamplerInd()) << RefRes.Name;
+        else if (RefRes.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler)
+            EXPECT_EQ(RefRes.GetAssignedSepImageInd(), LoadedRes.GetAssignedSepImageInd()) << RefRes.Name;
+    }
+
+    ASSERT_EQ(Ref.GetNumShaderStageInputs(), Loaded.GetNumShaderStageInputs());
+    for (Uint32 i = 0; i < Ref.GetNumShaderStageInputs(); ++i)
+    {
+        const auto& RefInput    = Ref.GetShaderStageInputAttribs(i);
+        const auto& LoadedInput = Loaded.GetShaderStageInputAttribs(i);
+        EXPECT_STREQ(RefInput.Semantic, LoadedInput.Semantic);
+        EXPECT_EQ(RefInput.LocationDecorationOffset, LoadedInput.LocationDecorationOffset) << RefInput.Semantic;
+    }
+}
+
+class SPIRVShaderResourcesTest : public ::testing::Test
+{
+protected:
+    struct TestShader
+    {
+        RefCntAutoPtr<IShaderVk> pShader;
+        const char*              CombinedSamplerSuffix = nullptr;
+    };
+
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+        if (!pDevice->GetDeviceCaps().IsVulkanDevice())
+            return;
+
+        ShaderMacroHelper Macros;
+        Macros.AddShaderMacro("STATIC_TEX_ARRAY_SIZE", 2);
+        Macros.AddShaderMacro("MUTABLE_TEX_ARRAY_SIZE", 4);
+        Macros.AddShaderMacro("DYNAMIC_TEX_ARRAY_SIZE", 3);
+        Macros.AddShaderMacro("STATIC_BUFF_ARRAY_SIZE", 4);
+        Macros.AddShaderMacro("MUTABLE_BUFF_ARRAY_SIZE", 3);
+        Macros.AddShaderMacro("DYNAMIC_BUFF_ARRAY_SIZE", 2);
+        Macros.AddShaderMacro("STATIC_SAM_ARRAY_SIZE", 2);
+        Macros.AddShaderMacro("MUTABLE_SAM_ARRAY_SIZE", 4);
+        Macros.AddShaderMacro("DYNAMIC_SAM_ARRAY_SIZE", 3);
+        Macros.AddShaderMacro("STATIC_CB_ARRAY_SIZE", 2);
+        Macros.AddShaderMacro("MUTABLE_CB_ARRAY_SIZE", 1);
+        Macros.AddShaderMacro("DYNAMIC_CB_ARRAY_SIZE", 1);
+        Macros.AddShaderMacro("ARRAYS_SUPPORTED", true);
+
+        struct ShaderInfo
+        {
+            const char*            Directory;
+            const char*            FilePath;
+            const char*            EntryPoint;
+            SHADER_TYPE            Type;
+            SHADER_SOURCE_LANGUAGE Language;
+            bool                   UseCombinedSamplers;
+        };
+        // clang-format off
+        static constexpr ShaderInfo Shaders[] =
+        {
+            {"shaders/ShaderResourceLayout", "Textures.hlsl",            "VSMain", SHADER_TYPE_VERTEX,  SHADER_SOURCE_LANGUAGE_HLSL, false},
+            {"shaders/ShaderResourceLayout", "Textures.hlsl",            "PSMain", SHADER_TYPE_PIXEL,   SHADER_SOURCE_LANGUAGE_HLSL, false},
+            {"shaders/ShaderResourceLayout", "ImmutableSamplers.hlsl",   "VSMain", SHADER_TYPE_VERTEX,  SHADER_SOURCE_LANGUAGE_HLSL, true },
+            {"shaders/ShaderResourceLayout", "ImmutableSamplers.hlsl",   "PSMain", SHADER_TYPE_PIXEL,   SHADER_SOURCE_LANGUAGE_HLSL, true },
+            {"shaders/ShaderResourceLayout", "Samplers.hlsl",            "PSMain", SHADER_TYPE_PIXEL,   SHADER_SOURCE_LANGUAGE_HLSL, false},
+            {"shaders/ShaderResourceLayout", "ConstantBuffers.hlsl",     "VSMain", SHADER_TYPE_VERTEX,  SHADER_SOURCE_LANGUAGE_HLSL, false},
+            {"shaders/ShaderResourceLayout", "FormattedBuffers.hlsl",    "PSMain", SHADER_TYPE_PIXEL,   SHADER_SOURCE_LANGUAGE_HLSL, false},
+            {"shaders/ShaderResourceLayout", "StructuredBuffers.glsl",   "main",   SHADER_TYPE_PIXEL,   SHADER_SOURCE_LANGUAGE_GLSL, false},
+            {"shaders/ShaderResourceLayout", "RWFormattedBuffers.hlsl",  "main",   SHADER_TYPE_COMPUTE, SHADER_SOURCE_LANGUAGE_HLSL, false},
+            {"shaders/ShaderResourceLayout", "RWStructuredBuffers.glsl", "main",   SHADER_TYPE_COMPUTE, SHADER_SOURCE_LANGUAGE_GLSL, false},
+            {"shaders/ShaderResourceLayout", "RWTextures.hlsl",          "main",   SHADER_TYPE_COMPUTE, SHADER_SOURCE_LANGUAGE_HLSL, false},
+            {"shaders",                      "ShaderResourceArrayTest.vsh", "main", SHADER_TYPE_VERTEX, SHADER_SOURCE_LANGUAGE_HLSL, true },
+            {"shaders",                      "ShaderResourceArrayTest.psh", "main", SHADER_TYPE_PIXEL,  SHADER_SOURCE_LANGUAGE_HLSL, true },
+        };
+        // clang-format on
+
+        for (const auto& Info : Shaders)
+        {
+            RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+            pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory(Info.Directory, &pShaderSourceFactory);
+
+            ShaderCreateInfo ShaderCI;
+            ShaderCI.pShaderSourceStreamFactory = pShaderSourceFactory;
+            ShaderCI.FilePath                   = Info.FilePath;
+            ShaderCI.EntryPoint                 = Info.EntryPoint;
+            ShaderCI.Desc.Name                  = Info.FilePath;
+            ShaderCI.Desc.ShaderType            = Info.Type;
+            ShaderCI.SourceLanguage             = Info.Language;
+            ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+            ShaderCI.UseCombinedTextureSamplers = Info.UseCombinedSamplers;
+            ShaderCI.Macros                     = Macros;
+
+            RefCntAutoPtr<IShader> pShader;
+            pDevice->CreateShader(ShaderCI, &pShader);
+            ASSERT_NE(pShader, nullptr) << Info.FilePath << " (" << Info.EntryPoint << ")";
+
+            TestShader Shader;
+            Shader.pShader = RefCntAutoPtr<IShaderVk>{pShader, IID_ShaderVk};
+            ASSERT_NE(Shader.pShader, nullptr);
+            Shader.CombinedSamplerSuffix = Info.UseCombinedSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr;
+            sm_Shaders.emplace_back(std::move(Shader));
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_Shaders.clear();
+        TestingEnvironment::GetInstance()->ReleaseResources();
+    }
+
+    void SetUp() override
+    {
+        if (!TestingEnvironment::GetInstance()->GetDevice()->GetDeviceCaps().IsVulkanDevice())
+            GTEST_SKIP() << "SPIRV shader resources are only used by Vulkan backend";
+    }
+
+    static std::vector<TestShader> sm_Shaders;
+};
+
+std::vector<SPIRVShaderResourcesTest::TestShader> SPIRVShaderResourcesTest::sm_Shaders;
+
+TEST_F(SPIRVShaderResourcesTest, ScanMatchesSPIRVCross)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    for (const auto& Shader : sm_Shaders)
+    {
+        const auto& Desc            = Shader.pShader->GetDesc();
+        const auto& SPIRV           = Shader.pShader->GetSPIRV();
+        const auto  LoadStageInputs = Desc.ShaderType == SHADER_TYPE_VERTEX;
+
+        // All test shaders must be handled by the scanner without falling back to SPIRV-Cross
+        std::string         ScannedEntryPoint;
+        SPIRVReflectionData Data;
+        EXPECT_TRUE(ScanSPIRVResources(SPIRV, Desc.ShaderType, ScannedEntryPoint, Data)) << Desc.Name;
+
+        std::string          RefEntryPoint;
+        SPIRVShaderResources RefResources{Allocator, nullptr, SPIRV, Desc, Shader.CombinedSamplerSuffix, LoadStageInputs, RefEntryPoint, true};
+
+        std::string          EntryPoint;
+        SPIRVShaderResources Resources{Allocator, nullptr, SPIRV, Desc, Shader.CombinedSamplerSuffix, LoadStageInputs, EntryPoint, false};
+        EXPECT_EQ(EntryPoint, RefEntryPoint);
+        EXPECT_EQ(ScannedEntryPoint, RefEntryPoint);
+        CompareResources(RefResources, Resources);
+    }
+}
+
+TEST_F(SPIRVShaderResourcesTest, ScanInvalidSPIRV)
+{
+    for (const auto& Shader : sm_Shaders)
+    {
+        const auto& Desc  = Shader.pShader->GetDesc();
+        const auto& SPIRV = Shader.pShader->GetSPIRV();
+
+        // Truncated header
+        for (size_t Size = 0; Size < 5; ++Size)
+        {
+            std::string         EntryPoint;
+            SPIRVReflectionData Data;
+            EXPECT_FALSE(ScanSPIRVResources(std::vector<uint32_t>{SPIRV.begin(), SPIRV.begin() + Size}, Desc.ShaderType, EntryPoint, Data));
+            EXPECT_TRUE(EntryPoint.empty());
+        }
+
+        // Invalid magic number
+        {
+            auto ModifiedSPIRV = SPIRV;
+            ModifiedSPIRV[0] ^= 1;
+            std::string         EntryPoint;
+            SPIRVReflectionData Data;
+            EXPECT_FALSE(ScanSPIRVResources(ModifiedSPIRV, Desc.ShaderType, EntryPoint, Data));
+        }
+
+        // No entry point of the requested type
+        {
+            std::string         EntryPoint;
+            SPIRVReflectionData Data;
+            EXPECT_FALSE(ScanSPIRVResources(SPIRV, Desc.ShaderType == SHADER_TYPE_CALLABLE ? SHADER_TYPE_MESH : SHADER_TYPE_CALLABLE, EntryPoint, Data));
+        }
+
+        // Corrupted words must never crash the scanner
+        for (size_t i = 5; i < SPIRV.size(); ++i)
+        {
+            auto ModifiedSPIRV = SPIRV;
+            ModifiedSPIRV[i]   = ~ModifiedSPIRV[i];
+            std::string         EntryPoint;
+            SPIRVReflectionData Data;
+            ScanSPIRVResources(ModifiedSPIRV, Desc.ShaderType, EntryPoint, Data);
+        }
+    }
+}
+
+TEST_F(SPIRVShaderResourcesTest, RoundTrip)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    for (const auto& Shader : sm_Shaders)
+    {
+        const auto& Desc             = Shader.pShader->GetDesc();
+        const auto& SPIRV            = Shader.pShader->GetSPIRV();
+        const auto  LoadStageInputs  = Desc.ShaderType == SHADER_TYPE_VERTEX;
+        std::string RefEntryPoint;
+        SPIRVShaderResources RefResources{Allocator, nullptr, SPIRV, Desc, Shader.CombinedSamplerSuffix, LoadStageInputs, RefEntryPoint};
+
+        std::vector<Uint8> Data;
+        RefResources.Serialize(SPIRV, RefEntryPoint, Data);
+        ASSERT_FALSE(Data.empty());
+        EXPECT_TRUE(SPIRVShaderResources::IsValidSerializedData(Data.data(), Data.size(), SPIRV, Desc, Shader.CombinedSamplerSuffix)) << Desc.Name;
+
+        std::string          EntryPoint;
+        SPIRVShaderResources Resources{Allocator, Data.data(), Data.size(), Desc, LoadStageInputs, EntryPoint};
+        EXPECT_EQ(EntryPoint, RefEntryPoint);
+        CompareResources(RefResources, Resources);
+
+        // Serialized data must be reproducible
+        std::vector<Uint8> Data2;
+        Resources.Serialize(SPIRV, EntryPoint, Data2);
+        EXPECT_EQ(Data, Data2) << Desc.Name;
+    }
+}
+
+TEST_F(SPIRVShaderResourcesTest, InvalidData)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    for (const auto& Shader : sm_Shaders)
+    {
+        const auto& Desc  = Shader.pShader->GetDesc();
+        const auto& SPIRV = Shader.pShader->GetSPIRV();
+
+        std::string          EntryPoint;
+        SPIRVShaderResources Resources{Allocator, nullptr, SPIRV, Desc, Shader.CombinedSamplerSuffix, false, EntryPoint};
+
+        std::vector<Uint8> Data;
+        Resources.Serialize(SPIRV, EntryPoint, Data);
+
+        // Truncated data
+        for (size_t Size = 0; Size < Data.size(); ++Size)
+            EXPECT_FALSE(SPIRVShaderResources::IsValidSerializedData(Data.data(), Size, SPIRV, Desc, Shader.CombinedSamplerSuffix));
+
+        // Different byte code
+        auto ModifiedSPIRV = SPIRV;
+        ModifiedSPIRV.back() ^= 1;
+        EXPECT_FALSE(SPIRVShaderResources::IsValidSerializedData(Data.data(), Data.size(), ModifiedSPIRV, Desc, Shader.CombinedSamplerSuffix));
+
+        // Different combined sampler suffix
+        EXPECT_FALSE(SPIRVShaderResources::IsValidSerializedData(Data.data(), Data.size(), SPIRV, Desc, Shader.CombinedSamplerSuffix != nullptr ? nullptr : "_sampler"));
+
+        // Different shader type
+        auto ModifiedDesc       = Desc;
+        ModifiedDesc.ShaderType = Desc.ShaderType == SHADER_TYPE_PIXEL ? SHADER_TYPE_VERTEX : SHADER_TYPE_PIXEL;
+        EXPECT_FALSE(SPIRVShaderResources::IsValidSerializedData(Data.data(), Data.size(), SPIRV, ModifiedDesc, Shader.CombinedSamplerSuffix));
+
+        // Different version
+        auto ModifiedData = Data;
+        ModifiedData[4] ^= 0xFF;
+        EXPECT_FALSE(SPIRVShaderResources::IsValidSerializedData(ModifiedData.data(), ModifiedData.size(), SPIRV, Desc, Shader.CombinedSamplerSuffix));
+    }
+}
+
+TEST_F(SPIRVShaderResourcesTest, ReflectionPerformance)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    std::vector<std::vector<Uint8>> SerializedData(sm_Shaders.size());
+    for (size_t i = 0; i < sm_Shaders.size(); ++i)
+    {
+        const auto&          Shader = sm_Shaders[i];
+        std::string          EntryPoint;
+        SPIRVShaderResources Resources{Allocator, nullptr, Shader.pShader->GetSPIRV(), Shader.pShader->GetDesc(), Shader.CombinedSamplerSuffix, true, EntryPoint};
+        Resources.Serialize(Shader.pShader->GetSPIRV(), EntryPoint, SerializedData[i]);
+    }
+
+    constexpr Uint32 NumIterations = 20;
+
+    Timer T;
+
+    auto Reflect = [&](bool UseSPIRVCross) {
+        const auto StartTime = T.GetElapsedTime();
+        for (Uint32 iter = 0; iter < NumIterations; ++iter)
+        {
+            for (const auto& Shader : sm_Shaders)
+            {
+                std::string          EntryPoint;
+                SPIRVShaderResources Resources{Allocator, nullptr, Shader.pShader->GetSPIRV(), Shader.pShader->GetDesc(), Shader.CombinedSamplerSuffix, true, EntryPoint, UseSPIRVCross};
+            }
+        }
+        return T.GetElapsedTime() - StartTime;
+    };
+    const auto CrossTime = Reflect(true);
+    const auto ScanTime  = Reflect(false);
+
+    const auto LoadStart = T.GetElapsedTime();
+    for (Uint32 iter = 0; iter < NumIterations; ++iter)
+    {
+        for (size_t i = 0; i < sm_Shaders.size(); ++i)
+        {
+            const auto& Shader = sm_Shaders[i];
+            const auto& Data   = SerializedData[i];
+            if (!SPIRVShaderResources::IsValidSerializedData(Data.data(), Data.size(), Shader.pShader->GetSPIRV(), Shader.pShader->GetDesc(), Shader.CombinedSamplerSuffix))
+            {
+                ADD_FAILURE() << "Serialized data of shader '" << Shader.pShader->GetDesc().Name << "' is invalid";
+                return;
+            }
+            std::string          EntryPoint;
+            SPIRVShaderResources Resources{Allocator, Data.data(), Data.size(), Shader.pShader->GetDesc(), true, EntryPoint};
+        }
+    }
+    const auto LoadTime = T.GetElapsedTime() - LoadStart;
+
+    const auto NumLoads = static_cast<double>(NumIterations * sm_Shaders.size());
+    LOG_INFO_MESSAGE("SPIRV shader resources of ", sm_Shaders.size(), " shaders, ", NumIterations, " iterations:\n",
+                     "  Reflect with SPIRV-Cross: ", CrossTime / NumLoads * 1e+6, " us per shader\n",
+                     "  Scan SPIRV:               ", ScanTime / NumLoads * 1e+6, " us per shader (", ScanTime > 0 ? CrossTime / ScanTime : 0.0, "x)\n",
+                     "  Load serialized data:     ", LoadTime / NumLoads * 1e+6, " us per shader (", LoadTime > 0 ? CrossTime / LoadTime : 0.0, "x, including validation)");
+}
+
+TEST_F(SPIRVShaderResourcesTest, StripDebugInfo)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/ShaderResourceLayout", &pShaderSourceFactory);
+
+    struct ShaderInfo
+    {
+        const char*            FilePath;
+        const char*            EntryPoint;
+        SHADER_TYPE            Type;
+        SHADER_SOURCE_LANGUAGE Language;
+    };
+    // clang-format off
+    static constexpr ShaderInfo Shaders[] =
+    {
+        {"Samplers.hlsl",          "PSMain", SHADER_TYPE_PIXEL,   SHADER_SOURCE_LANGUAGE_HLSL},
+        {"StructuredBuffers.glsl", "main",   SHADER_TYPE_PIXEL,   SHADER_SOURCE_LANGUAGE_GLSL},
+        {"RWTextures.hlsl",        "main",   SHADER_TYPE_COMPUTE, SHADER_SOURCE_LANGUAGE_HLSL},
+    };
+    // clang-format on
+
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("STATIC_SAM_ARRAY_SIZE", 2);
+    Macros.AddShaderMacro("MUTABLE_SAM_ARRAY_SIZE", 4);
+    Macros.AddShaderMacro("DYNAMIC_SAM_ARRAY_SIZE", 3);
+    Macros.AddShaderMacro("STATIC_BUFF_ARRAY_SIZE", 4);
+    Macros.AddShaderMacro("MUTABLE_BUFF_ARRAY_SIZE", 3);
+    Macros.AddShaderMacro("DYNAMIC_BUFF_ARRAY_SIZE", 2);
+    Macros.AddShaderMacro("STATIC_TEX_ARRAY_SIZE", 2);
+    Macros.AddShaderMacro("MUTABLE_TEX_ARRAY_SIZE", 4);
+    Macros.AddShaderMacro("DYNAMIC_TEX_ARRAY_SIZE", 3);
+
+    for (const auto& Info : Shaders)
+    {
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.pShaderSourceStreamFactory = pShaderSourceFactory;
+        ShaderCI.FilePath                   = Info.FilePath;
+        ShaderCI.EntryPoint                 = Info.EntryPoint;
+        ShaderCI.Desc.Name                  = Info.FilePath;
+        ShaderCI.Desc.ShaderType            = Info.Type;
+        ShaderCI.SourceLanguage             = Info.Language;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = false;
+        ShaderCI.Macros                     = Macros;
+
+        RefCntAutoPtr<IShader> pRefShader;
+        pDevice->CreateShader(ShaderCI, &pRefShader);
+        ASSERT_NE(pRefShader, nullptr) << Info.FilePath;
+
+        SPIRVOptimizationStats Stats;
+        ShaderCI.SPIRVOptimizationFlags  = SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO;
+        ShaderCI.pSPIRVOptimizationStats = &Stats;
+
+        RefCntAutoPtr<IShader> pShader;
+        pDevice->CreateShader(ShaderCI, &pShader);
+        ASSERT_NE(pShader, nullptr) << Info.FilePath;
+
+        RefCntAutoPtr<IShaderVk> pShaderVk{pShader, IID_ShaderVk};
+        ASSERT_NE(pShaderVk, nullptr);
+        EXPECT_EQ(Stats.FinalSize, pShaderVk->GetSPIRV().size() * sizeof(uint32_t)) << Info.FilePath;
+        EXPECT_LE(Stats.FinalSize, Stats.OriginalSize) << Info.FilePath;
+
+        // Resource names must survive stripping
+        ASSERT_EQ(pShader->GetResourceCount(), pRefShader->GetResourceCount()) << Info.FilePath;
+        for (Uint32 r = 0; r < pShader->GetResourceCount(); ++r)
+        {
+            ShaderResourceDesc RefResDesc, ResDesc;
+            pRefShader->GetResourceDesc(r, RefResDesc);
+            pShader->GetResourceDesc(r, ResDesc);
+            EXPECT_STREQ(ResDesc.Name, RefResDesc.Name) << Info.FilePath;
+            EXPECT_EQ(ResDesc.Type, RefResDesc.Type) << Info.FilePath;
+            EXPECT_EQ(ResDesc.ArraySize, RefResDesc.ArraySize) << Info.FilePath;
+        }
+
+        // All optimizations must produce a valid shader
+        ShaderCI.SPIRVOptimizationFlags = SPIRV_OPTIMIZATION_FLAG_PERFORMANCE | SPIRV_OPTIMIZATION_FLAG_SIZE |
+            SPIRV_OPTIMIZATION_FLAG_DEAD_CODE | SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO;
+        pShader.Release();
+        pDevice->CreateShader(ShaderCI, &pShader);
+        ASSERT_NE(pShader, nullptr) << Info.FilePath;
+        LOG_INFO_MESSAGE(Info.FilePath, ": ", Stats.OriginalSize, " -> ", Stats.OptimizedSize, " -> ", Stats.FinalSize,
+                         " bytes, optimization: ", Stats.OptimizationTimeMs, " ms, strip: ", Stats.StripTimeMs, " ms");
+    }
+}
+
+} // namespace
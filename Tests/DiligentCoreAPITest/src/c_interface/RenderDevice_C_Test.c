@@ -33,12 +33,13 @@ int TestObjectCInterface(struct IObject* pObject);
 
 int TestRenderDeviceCInterface_Misc(struct IRenderDevice* pRenderDevice)
 {
-    IObject*                  pUnknown = NULL;
-    ReferenceCounterValueType RefCnt1 = 0, RefCnt2 = 0;
-    DeviceCaps                deviceCaps;
-    TextureFormatInfo         TexFmtInfo;
-    TextureFormatInfoExt      TexFmtInfoExt;
-    IEngineFactory*           pFactory = NULL;
+    IObject*                   pUnknown = NULL;
+    ReferenceCounterValueType  RefCnt1 = 0, RefCnt2 = 0;
+    DeviceCaps                 deviceCaps;
+    TextureFormatInfo          TexFmtInfo;
+    TextureFormatInfoExt       TexFmtInfoExt;
+    IEngineFactory*            pFactory = NULL;
+    PipelineStateRegistryStats PSORegistryStats;
 
     int num_errors = TestObjectCInterface((struct IObject*)pRenderDevice);
 
@@ -69,6 +70,8 @@ int TestRenderDeviceCInterface_Misc(struct IRenderDevice* pRenderDevice)
     if (TexFmtInfoExt._TextureFormatInfo._TextureFormatAttribs.Format != TEX_FORMAT_RGBA8_UNORM)
         ++num_errors;
 
+    IRenderDevice_GetPipelineStateRegistryStats(pRenderDevice, &PSORegistryStats);
+
     IRenderDevice_IdleGPU(pRenderDevice);
     IRenderDevice_ReleaseStaleResources(pRenderDevice, false);
 
@@ -135,6 +138,13 @@ int TestRenderDeviceCInterface_CreateShader(struct IRenderDevice* pRenderDevice)
     else
         ++num_errors;
 
+    pShader = NULL;
+    IRenderDevice_CreateShaders(pRenderDevice, &ShaderCI, 1, &pShader);
+    if (pShader != NULL)
+        IObject_Release(pShader);
+    else
+        ++num_errors;
+
     return num_errors;
 }
 
@@ -26,6 +26,7 @@
  */
 
 #include "ShaderResourceBinding.h"
+#include "ResourceBindingPlan.h"
 
 int TestObjectCInterface(struct IObject* pObject);
 
@@ -34,9 +35,10 @@ int TestShaderResourceBindingCInterface(struct IShaderResourceBinding* pSRB)
     IObject*                  pUnknown = NULL;
     ReferenceCounterValueType RefCnt1 = 0, RefCnt2 = 0;
 
-    struct IPipelineState*   pPSO     = NULL;
-    IShaderResourceVariable* pVar     = NULL;
-    Uint32                   VarCount = 0;
+    struct IPipelineState*   pPSO      = NULL;
+    IShaderResourceVariable* pVar      = NULL;
+    Uint32                   VarCount  = 0;
+    Uint32                   VarHandle = 0;
 
     int num_errors = TestObjectCInterface((struct IObject*)pSRB);
 
@@ -71,6 +73,10 @@ int TestShaderResourceBindingCInterface(struct IShaderResourceBinding* pSRB)
     if (pVar == NULL)
         ++num_errors;
 
+    VarHandle = IShaderResourceBinding_GetVariableHandle(pSRB, SHADER_TYPE_VERTEX, "g_tex2D_Mut");
+    if (VarHandle == INVALID_SHADER_VARIABLE_HANDLE)
+        ++num_errors;
+
     IShaderResourceBinding_InitializeStaticResources(pSRB, pPSO);
 
     return num_errors;
@@ -78,6 +84,14 @@ int TestShaderResourceBindingCInterface(struct IShaderResourceBinding* pSRB)
 
 void TestShaderResourceBindingC_API(struct IShaderResourceBinding* pSRB)
 {
-    struct IResourceMapping* pResMapping = NULL;
+    struct IResourceMapping*     pResMapping = NULL;
+    struct IResourceBindingPlan* pPlan       = NULL;
     IShaderResourceBinding_BindResources(pSRB, SHADER_TYPE_VERTEX, pResMapping, BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED);
+    IShaderResourceBinding_SetVariables(pSRB, NULL, NULL, 0);
+    IShaderResourceBinding_CreateBindingPlan(pSRB, SHADER_TYPE_VERTEX, pResMapping, BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED, &pPlan);
+    if (pPlan != NULL)
+    {
+        IResourceBindingPlan_BindResources(pPlan, pSRB);
+        IObject_Release(pPlan);
+    }
 }
\ No newline at end of file
@@ -62,6 +62,10 @@ TestingEnvironment* CreateTestingEnvironmentVk(const TestingEnvironment::CreateI
 TestingEnvironment* CreateTestingEnvironmentMtl(const TestingEnvironment::CreateInfo& CI, const SwapChainDesc& SCDesc);
 #endif
 
+#if NULL_SUPPORTED
+TestingEnvironment* CreateTestingEnvironmentNull(const TestingEnvironment::CreateInfo& CI, const SwapChainDesc& SCDesc);
+#endif
+
 } // namespace Testing
 
 } // namespace Diligent
@@ -115,6 +119,10 @@ int main(int argc, char** argv)
         {
             TestEnvCI.deviceType = RENDER_DEVICE_TYPE_METAL;
         }
+        else if (strcmp(arg, "--mode=null") == 0)
+        {
+            TestEnvCI.deviceType = RENDER_DEVICE_TYPE_NULL;
+        }
         else if (AdapterArgName.compare(0, AdapterArgName.length(), arg, AdapterArgName.length()) == 0)
         {
             TestEnvCI.AdapterId = static_cast<Uint32>(atoi(arg + AdapterArgName.length()));
@@ -196,6 +204,13 @@ int main(int argc, char** argv)
                 break;
 #endif
 
+#if NULL_SUPPORTED
+            case RENDER_DEVICE_TYPE_NULL:
+                std::cout << "\n\n\n===================== Testing Diligent Core API in Null mode =====================\n\n";
+                pEnv = CreateTestingEnvironmentNull(TestEnvCI, SCDesc);
+                break;
+#endif
+
             default:
                 LOG_ERROR_AND_THROW("Unsupported device type");
         }
@@ -29,6 +29,7 @@
 
 #include <vector>
 #include <unordered_map>
+#include <cmath>
 
 #include "gtest/gtest.h"
 
@@ -86,4 +87,160 @@ TEST(Common_FastRand, FastRandInt)
     }
 }
 
+TEST(Common_FastRandStream, Reproducibility)
+{
+    constexpr size_t   Count = 1000;
+    std::vector<Uint32> Ref(Count);
+    FastRandStream{123, 4}.Fill(Ref.data(), Count);
+
+    // The sequence must not depend on how the values are requested
+    for (size_t ChunkSize : {1, 3, 7, 8, 9, 64, 1000})
+    {
+        FastRandStream      Rnd{123, 4};
+        std::vector<Uint32> Values(Count);
+        for (size_t i = 0; i < Count; i += ChunkSize)
+            Rnd.Fill(Values.data() + i, std::min(ChunkSize, Count - i));
+        EXPECT_EQ(Values, Ref) << "Chunk size: " << ChunkSize;
+    }
+
+    {
+        FastRandStream Rnd{123, 4};
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_EQ(Rnd(), Ref[i]);
+    }
+
+    {
+        FastRandStream     Rnd{123, 4};
+        std::vector<float> Floats(Count);
+        Rnd.Fill(Floats.data(), 5);
+        Rnd.Fill(Floats.data() + 5, Count - 5);
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_EQ(Floats[i], static_cast<float>(Ref[i] >> 8u) / 16777216.f);
+    }
+}
+
+TEST(Common_FastRandStream, IndependentStreams)
+{
+    constexpr size_t Count = 1024;
+
+    std::vector<std::vector<Uint32>> Streams;
+    for (Uint64 Seed : {0, 1})
+    {
+        for (Uint64 StreamIdx : {0, 1, 2, 1000000})
+        {
+            Streams.emplace_back(Count);
+            FastRandStream{Seed, StreamIdx}.Fill(Streams.back().data(), Count);
+        }
+    }
+
+    // All streams must be different and must not contain shifted copies of each other
+    std::unordered_map<Uint32, size_t> Values;
+    for (size_t s = 0; s < Streams.size(); ++s)
+    {
+        for (auto x : Streams[s])
+            ++Values[x];
+    }
+    // With 8K random 32-bit values, the probability of a collision is about 1e-2.
+    // Allow a few, but not many.
+    size_t NumRepeats = 0;
+    for (const auto& it : Values)
+        NumRepeats += it.second - 1;
+    EXPECT_LE(NumRepeats, size_t{3});
+
+    // Correlation between adjacent streams must be negligible
+    for (size_t s = 0; s + 1 < Streams.size(); ++s)
+    {
+        double Corr = 0;
+        for (size_t i = 0; i < Count; ++i)
+        {
+            const double a = static_cast<double>(Streams[s][i]) / 4294967296.0 - 0.5;
+            const double b = static_cast<double>(Streams[s + 1][i]) / 4294967296.0 - 0.5;
+            Corr += a * b;
+        }
+        // Variance of the uniform [-0.5, 0.5] distribution is 1/12
+        Corr /= static_cast<double>(Count) / 12.0;
+        EXPECT_LT(std::abs(Corr), 0.15) << "Streams " << s << " and " << s + 1;
+    }
+}
+
+TEST(Common_FastRandStream, Uniformity)
+{
+    constexpr size_t NumBuckets = 256;
+    constexpr size_t Count      = NumBuckets * 1024;
+
+    FastRandStream      Rnd{42};
+    std::vector<Uint32> Values(Count);
+    Rnd.Fill(Values.data(), Count);
+
+    // Chi-squared test for all four bytes of the generated values
+    for (Uint32 Shift : {0, 8, 16, 24})
+    {
+        std::vector<size_t> Buckets(NumBuckets);
+        for (auto x : Values)
+            ++Buckets[(x >> Shift) & 0xFF];
+
+        const double Expected = static_cast<double>(Count) / NumBuckets;
+        double       ChiSq    = 0;
+        for (auto n : Buckets)
+            ChiSq += (static_cast<double>(n) - Expected) * (static_cast<double>(n) - Expected) / Expected;
+
+        // 255 degrees of freedom: the critical value for p = 0.001 is 330.5
+        EXPECT_LT(ChiSq, 330.5) << "Byte " << Shift / 8;
+    }
+
+    // Bit balance
+    for (Uint32 Bit = 0; Bit < 32; ++Bit)
+    {
+        size_t NumOnes = 0;
+        for (auto x : Values)
+            NumOnes += (x >> Bit) & 1u;
+        // Standard deviation is sqrt(Count)/2 = 256
+        EXPECT_NEAR(static_cast<double>(NumOnes), Count / 2.0, 256.0 * 5) << "Bit " << Bit;
+    }
+}
+
+TEST(Common_FastRandStream, Floats)
+{
+    constexpr size_t Count = 100000;
+
+    FastRandStream     Rnd{7};
+    std::vector<float> Values(Count);
+    Rnd.Fill(Values.data(), Count, -2.f, 6.f);
+
+    double Mean = 0;
+    for (auto f : Values)
+    {
+        EXPECT_GE(f, -2.f);
+        EXPECT_LE(f, 6.f);
+        Mean += f;
+    }
+    Mean /= Count;
+
+    double Variance = 0;
+    for (auto f : Values)
+        Variance += (f - Mean) * (f - Mean);
+    Variance /= Count;
+
+    EXPECT_NEAR(Mean, 2.0, 0.05);
+    // Variance of the uniform distribution is (b - a)^2 / 12
+    EXPECT_NEAR(Variance, 64.0 / 12.0, 0.1);
+
+    std::vector<float3> Vectors(Count / 3);
+    FastRandStream{7}.Fill(Vectors.data(), Vectors.size(), -2.f, 6.f);
+    for (size_t i = 0; i < Vectors.size(); ++i)
+    {
+        EXPECT_EQ(Vectors[i].x, Values[i * 3 + 0]);
+        EXPECT_EQ(Vectors[i].y, Values[i * 3 + 1]);
+        EXPECT_EQ(Vectors[i].z, Values[i * 3 + 2]);
+    }
+
+    std::vector<float2> Vectors2(Count / 2);
+    FastRandStream{7}.Fill(Vectors2.data(), Vectors2.size(), -2.f, 6.f);
+    for (size_t i = 0; i < Vectors2.size(); ++i)
+    {
+        EXPECT_EQ(Vectors2[i].x, Values[i * 2 + 0]);
+        EXPECT_EQ(Vectors2[i].y, Values[i * 2 + 1]);
+    }
+}
+
 } // namespace
@@ -0,0 +1,287 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "FormatConversion.hpp"
+
+#include <vector>
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_FormatConversion, FloatToHalf)
+{
+    // clang-format off
+    EXPECT_EQ(FloatToHalf( 0.f),      0x0000);
+    EXPECT_EQ(FloatToHalf(-0.f),      0x8000);
+    EXPECT_EQ(FloatToHalf( 1.f),      0x3C00);
+    EXPECT_EQ(FloatToHalf(-2.f),      0xC000);
+    EXPECT_EQ(FloatToHalf( 0.5f),     0x3800);
+    EXPECT_EQ(FloatToHalf( 65504.f),  0x7BFF); // Max half
+    EXPECT_EQ(FloatToHalf( 65520.f),  0x7C00); // Rounds to infinity
+    EXPECT_EQ(FloatToHalf( 1e10f),    0x7C00);
+    EXPECT_EQ(FloatToHalf(-1e10f),    0xFC00);
+    EXPECT_EQ(FloatToHalf( 6.103515625e-05f), 0x0400); // Min normal
+    EXPECT_EQ(FloatToHalf( 5.960464477539063e-08f), 0x0001); // Min subnormal
+    EXPECT_EQ(FloatToHalf( 1e-10f),   0x0000);
+    EXPECT_EQ(FloatToHalf( std::numeric_limits<float>::infinity()),  0x7C00);
+    EXPECT_EQ(FloatToHalf(-std::numeric_limits<float>::infinity()),  0xFC00);
+    EXPECT_EQ(FloatToHalf( std::numeric_limits<float>::quiet_NaN()) & 0x7E00, 0x7E00);
+    // Ties to even
+    EXPECT_EQ(FloatToHalf( 1.f + 1.f / 2048.f),       0x3C00);
+    EXPECT_EQ(FloatToHalf( 1.f + 3.f / 2048.f),       0x3C02);
+    EXPECT_EQ(FloatToHalf( 1.f + 1.f / 2048.f + 1e-6f), 0x3C01);
+    // clang-format on
+}
+
+TEST(Common_FormatConversion, HalfToFloat)
+{
+    // Every finite half value must survive the round trip
+    for (Uint32 h = 0; h <= 0xFFFF; ++h)
+    {
+        const auto Half = static_cast<Uint16>(h);
+        if ((Half & 0x7C00) == 0x7C00)
+        {
+            const auto f = HalfToFloat(Half);
+            if ((Half & 0x3FF) != 0)
+                EXPECT_TRUE(std::isnan(f));
+            else
+                EXPECT_TRUE(std::isinf(f));
+            continue;
+        }
+        EXPECT_EQ(FloatToHalf(HalfToFloat(Half)), Half) << "Half: " << h;
+    }
+
+    EXPECT_EQ(HalfToFloat(0x3C00), 1.f);
+    EXPECT_EQ(HalfToFloat(0xC000), -2.f);
+    EXPECT_EQ(HalfToFloat(0x7BFF), 65504.f);
+    EXPECT_EQ(HalfToFloat(0x0001), 5.960464477539063e-08f);
+}
+
+TEST(Common_FormatConversion, ArrayHalfConversion)
+{
+    // Use an odd size to test the tail handling
+    std::vector<float> Src(1027);
+    FastRandFloat      Rnd{0, -70000.f, +70000.f};
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = (i % 3 == 0) ? Rnd() : Rnd() * 1e-8f;
+
+    std::vector<Uint16> Halfs(Src.size());
+    ConvertFloatToHalf(Src.data(), Halfs.data(), Src.size());
+    std::vector<float> Dst(Src.size());
+    ConvertHalfToFloat(Halfs.data(), Dst.data(), Halfs.size());
+    for (size_t i = 0; i < Src.size(); ++i)
+    {
+        EXPECT_EQ(Halfs[i], FloatToHalf(Src[i])) << Src[i];
+        EXPECT_EQ(Dst[i], HalfToFloat(Halfs[i]));
+    }
+}
+
+TEST(Common_FormatConversion, ArrayHalfConversionNaN)
+{
+    // NaNs with different payloads and signs must be converted the same way by the
+    // vectorized and the scalar paths
+    const Uint32 NaNBits[] = {0x7FC00000u, 0x7F800001u, 0x7FFFFFFFu, 0x7FA5A5A5u, 0xFFC00000u, 0xFF800123u};
+
+    std::vector<float> Src(19);
+    for (size_t i = 0; i < Src.size(); ++i)
+    {
+        if (i % 2 == 0)
+            memcpy(&Src[i], &NaNBits[(i / 2) % (sizeof(NaNBits) / sizeof(NaNBits[0]))], sizeof(float));
+        else
+            Src[i] = static_cast<float>(i);
+    }
+
+    std::vector<Uint16> Halfs(Src.size());
+    ConvertFloatToHalf(Src.data(), Halfs.data(), Src.size());
+    for (size_t i = 0; i < Src.size(); ++i)
+        EXPECT_EQ(Halfs[i], FloatToHalf(Src[i])) << "Element " << i;
+
+    EXPECT_EQ(Halfs[0], 0x7E00);
+    EXPECT_EQ(FloatToHalf(std::numeric_limits<float>::quiet_NaN()), 0x7E00);
+}
+
+TEST(Common_FormatConversion, NormalizedIntegers)
+{
+    EXPECT_EQ(FloatToUNorm<Uint8>(0.f), 0);
+    EXPECT_EQ(FloatToUNorm<Uint8>(1.f), 255);
+    EXPECT_EQ(FloatToUNorm<Uint8>(0.5f), 128);
+    EXPECT_EQ(FloatToUNorm<Uint8>(-1.f), 0);
+    EXPECT_EQ(FloatToUNorm<Uint8>(2.f), 255);
+    EXPECT_EQ(FloatToUNorm<Uint16>(1.f), 65535);
+    EXPECT_EQ(FloatToUNorm<Uint16>(std::numeric_limits<float>::quiet_NaN()), 0);
+
+    EXPECT_EQ(FloatToSNorm<Int8>(1.f), 127);
+    EXPECT_EQ(FloatToSNorm<Int8>(-1.f), -127);
+    EXPECT_EQ(FloatToSNorm<Int8>(-2.f), -127);
+    EXPECT_EQ(FloatToSNorm<Int8>(0.f), 0);
+    EXPECT_EQ(FloatToSNorm<Int16>(0.5f), 16384);
+    EXPECT_EQ(FloatToSNorm<Int16>(-0.5f), -16384);
+    EXPECT_EQ(FloatToSNorm<Int16>(std::numeric_limits<float>::quiet_NaN()), 0);
+
+    EXPECT_EQ(SNormToFloat(Int8{-128}), -1.f);
+    EXPECT_EQ(SNormToFloat(Int8{-127}), -1.f);
+    EXPECT_EQ(SNormToFloat(Int16{32767}), 1.f);
+    EXPECT_EQ(UNormToFloat(Uint8{255}), 1.f);
+
+    for (Uint32 u = 0; u <= 0xFF; ++u)
+    {
+        EXPECT_EQ(FloatToUNorm<Uint8>(UNormToFloat(static_cast<Uint8>(u))), u);
+        const auto s = static_cast<Int8>(u);
+        if (s != -128)
+            EXPECT_EQ(FloatToSNorm<Int8>(SNormToFloat(s)), s);
+    }
+    for (Uint32 u = 0; u <= 0xFFFF; ++u)
+    {
+        EXPECT_EQ(FloatToUNorm<Uint16>(UNormToFloat(static_cast<Uint16>(u))), u);
+        const auto s = static_cast<Int16>(u);
+        if (s != -32768)
+            EXPECT_EQ(FloatToSNorm<Int16>(SNormToFloat(s)), s);
+    }
+
+    std::vector<float> Src(259);
+    FastRandFloat      Rnd{0, -1.25f, +1.25f};
+    for (auto& f : Src)
+        f = Rnd();
+
+    std::vector<Uint8>  U8(Src.size());
+    std::vector<Uint16> U16(Src.size());
+    std::vector<Int8>   S8(Src.size());
+    std::vector<Int16>  S16(Src.size());
+    ConvertFloatToUNorm8(Src.data(), U8.data(), Src.size());
+    ConvertFloatToUNorm16(Src.data(), U16.data(), Src.size());
+    ConvertFloatToSNorm8(Src.data(), S8.data(), Src.size());
+    ConvertFloatToSNorm16(Src.data(), S16.data(), Src.size());
+
+    std::vector<float> FU8(Src.size()), FU16(Src.size()), FS8(Src.size()), FS16(Src.size());
+    ConvertUNorm8ToFloat(U8.data(), FU8.data(), Src.size());
+    ConvertUNorm16ToFloat(U16.data(), FU16.data(), Src.size());
+    ConvertSNorm8ToFloat(S8.data(), FS8.data(), Src.size());
+    ConvertSNorm16ToFloat(S16.data(), FS16.data(), Src.size());
+
+    for (size_t i = 0; i < Src.size(); ++i)
+    {
+        EXPECT_EQ(U8[i], FloatToUNorm<Uint8>(Src[i]));
+        EXPECT_EQ(U16[i], FloatToUNorm<Uint16>(Src[i]));
+        EXPECT_EQ(S8[i], FloatToSNorm<Int8>(Src[i]));
+        EXPECT_EQ(S16[i], FloatToSNorm<Int16>(Src[i]));
+
+        EXPECT_NEAR(FU8[i], clamp(Src[i], 0.f, 1.f), 0.5f / 255.f);
+        EXPECT_NEAR(FU16[i], clamp(Src[i], 0.f, 1.f), 0.5f / 65535.f);
+        EXPECT_NEAR(FS8[i], clamp(Src[i], -1.f, 1.f), 0.5f / 127.f);
+        EXPECT_NEAR(FS16[i], clamp(Src[i], -1.f, 1.f), 0.5f / 32767.f);
+    }
+}
+
+TEST(Common_FormatConversion, RGB10A2)
+{
+    EXPECT_EQ(PackRGB10A2(float4{1, 0, 0, 0}), 0x000003FFu);
+    EXPECT_EQ(PackRGB10A2(float4{0, 1, 0, 0}), 0x000FFC00u);
+    EXPECT_EQ(PackRGB10A2(float4{0, 0, 1, 0}), 0x3FF00000u);
+    EXPECT_EQ(PackRGB10A2(float4{0, 0, 0, 1}), 0xC0000000u);
+    EXPECT_EQ(PackRGB10A2(float4{2, -1, 0.5f, 0.5f}), 0x3FFu | (512u << 20u) | (2u << 30u));
+
+    for (Uint32 i = 0; i < 1024; ++i)
+    {
+        const Uint32 Packed = i | ((1023 - i) << 10u) | (((i * 7) & 0x3FF) << 20u) | ((i & 3u) << 30u);
+        EXPECT_EQ(PackRGB10A2(UnpackRGB10A2(Packed)), Packed);
+    }
+
+    std::vector<float4> Src(33);
+    FastRandFloat       Rnd{0, 0.f, 1.f};
+    for (auto& c : Src)
+        c = float4{Rnd(), Rnd(), Rnd(), Rnd()};
+    std::vector<Uint32> Packed(Src.size());
+    PackRGB10A2(Src.data(), Packed.data(), Src.size());
+    std::vector<float4> Dst(Src.size());
+    UnpackRGB10A2(Packed.data(), Dst.data(), Src.size());
+    for (size_t i = 0; i < Src.size(); ++i)
+    {
+        EXPECT_EQ(Packed[i], PackRGB10A2(Src[i]));
+        EXPECT_NEAR(Dst[i].r, Src[i].r, 0.5f / 1023.f);
+        EXPECT_NEAR(Dst[i].g, Src[i].g, 0.5f / 1023.f);
+        EXPECT_NEAR(Dst[i].b, Src[i].b, 0.5f / 1023.f);
+        EXPECT_NEAR(Dst[i].a, Src[i].a, 0.5f / 3.f);
+    }
+}
+
+TEST(Common_FormatConversion, OctahedralNormals)
+{
+    const float3 AxisNormals[] = {
+        float3{+1, 0, 0},
+        float3{-1, 0, 0},
+        float3{0, +1, 0},
+        float3{0, -1, 0},
+        float3{0, 0, +1},
+        float3{0, 0, -1},
+    };
+    for (const auto& N : AxisNormals)
+    {
+        const auto Decoded = DecodeOctahedralNormal(EncodeOctahedralNormal(N));
+        EXPECT_NEAR(Decoded.x, N.x, 1e-6f);
+        EXPECT_NEAR(Decoded.y, N.y, 1e-6f);
+        EXPECT_NEAR(Decoded.z, N.z, 1e-6f);
+    }
+
+    std::vector<float3> Src(1000);
+    FastRandFloat       Rnd{0, -1.f, 1.f};
+    for (auto& N : Src)
+    {
+        do
+        {
+            N = float3{Rnd(), Rnd(), Rnd()};
+        } while (length(N) < 1e-3f);
+        N = normalize(N);
+    }
+
+    std::vector<Uint32> Packed(Src.size());
+    PackOctahedralNormals(Src.data(), Packed.data(), Src.size());
+    std::vector<float3> Dst(Src.size());
+    UnpackOctahedralNormals(Packed.data(), Dst.data(), Src.size());
+    for (size_t i = 0; i < Src.size(); ++i)
+    {
+        EXPECT_EQ(Packed[i], PackOctahedralNormal(Src[i]));
+
+        const auto Oct = EncodeOctahedralNormal(Src[i]);
+        EXPECT_LE(std::abs(Oct.x), 1.f);
+        EXPECT_LE(std::abs(Oct.y), 1.f);
+
+        // Maximum angular error of 16-bit octahedral encoding is well below 0.01 degree (1.75e-4 radians)
+        EXPECT_LT(length(Dst[i] - Src[i]), 1.75e-4f);
+        EXPECT_NEAR(length(Dst[i]), 1.f, 1e-5f);
+    }
+}
+
+} // namespace
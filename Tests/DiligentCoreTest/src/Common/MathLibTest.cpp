@@ -29,6 +29,7 @@
 
 #include "BasicMath.hpp"
 #include "AdvancedMath.hpp"
+#include "FastRand.hpp"
 
 #include "gtest/gtest.h"
 
@@ -1543,6 +1544,62 @@ TEST(Common_AdvancedMath, TraceLineThroughGrid)
     TestLineTrace(float2{3, 1}, float2{1, 3}, {int2{3, 1}, int2{2, 1}, int2{2, 2}, int2{1, 2}, int2{1, 3}});
 }
 
+TEST(Common_AdvancedMath, TraceLinesThroughGrid)
+{
+    const int2 GridSize{16, 12};
+
+    std::vector<float2> Starts, Ends;
+    // Special cases
+    Starts.push_back(float2{0.5f, 0.5f});
+    Ends.push_back(float2{0.5f, 0.5f});
+    Starts.push_back(float2{-0.5f, 0.5f});
+    Ends.push_back(float2{-0.5f, 0.5f});
+    Starts.push_back(float2{1, 3});
+    Ends.push_back(float2{3, 1});
+    Starts.push_back(float2{20.f, 0.5f});
+    Ends.push_back(float2{8.f, 0.5f});
+    Starts.push_back(float2{-1.f, -1.f});
+    Ends.push_back(float2{-5.f, 20.f});
+
+    FastRandFloat Rnd{0, -4.f, 20.f};
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        Starts.push_back(float2{Rnd(), Rnd()});
+        Ends.push_back(float2{Rnd(), Rnd()});
+    }
+    const auto NumLines = static_cast<Uint32>(Starts.size());
+
+    for (int MaxCells : {0, 1, 3, INT_MAX})
+    {
+        std::vector<std::vector<int2>> RefTraces(NumLines);
+        for (Uint32 i = 0; i < NumLines; ++i)
+        {
+            auto& Trace = RefTraces[i];
+            TraceLineThroughGrid(Starts[i], Ends[i], GridSize,
+                                 [&](int2 Cell) //
+                                 {
+                                     Trace.push_back(Cell);
+                                     return static_cast<int>(Trace.size()) < MaxCells;
+                                 });
+        }
+
+        std::vector<std::vector<int2>> Traces(NumLines);
+        TraceLinesThroughGrid(Starts.data(), Ends.data(), NumLines, GridSize,
+                              [&](Uint32 LineIdx, int2 Cell) //
+                              {
+                                  EXPECT_LT(LineIdx, NumLines);
+                                  auto& Trace = Traces[LineIdx];
+                                  Trace.push_back(Cell);
+                                  return static_cast<int>(Trace.size()) < MaxCells;
+                              });
+
+        for (Uint32 i = 0; i < NumLines; ++i)
+        {
+            EXPECT_EQ(Traces[i], RefTraces[i]) << "Line " << i << ": (" << Starts[i].x << ", " << Starts[i].y << ") - (" << Ends[i].x << ", " << Ends[i].y << ")";
+        }
+    }
+}
+
 TEST(Common_BasicMath, FastFloor)
 {
     // float
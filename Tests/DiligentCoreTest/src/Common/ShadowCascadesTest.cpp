@@ -0,0 +1,192 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ShadowCascades.hpp"
+
+#include <vector>
+
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+float4x4 MakeCameraView(const float3& Pos, float Yaw, float Pitch)
+{
+    const auto Rotation = float4x4::RotationY(Yaw) * float4x4::RotationX(Pitch);
+    return float4x4::Translation(-Pos) * Rotation;
+}
+
+TEST(Common_ShadowCascades, ComputeCascadeSplits)
+{
+    float Splits[5];
+
+    ComputeCascadeSplits(1, 101, 4, 0, Splits);
+    EXPECT_FLOAT_EQ(Splits[0], 1);
+    EXPECT_FLOAT_EQ(Splits[1], 26);
+    EXPECT_FLOAT_EQ(Splits[2], 51);
+    EXPECT_FLOAT_EQ(Splits[3], 76);
+    EXPECT_FLOAT_EQ(Splits[4], 101);
+
+    ComputeCascadeSplits(1, 10000, 4, 1, Splits);
+    EXPECT_FLOAT_EQ(Splits[0], 1);
+    EXPECT_FLOAT_EQ(Splits[1], 10);
+    EXPECT_FLOAT_EQ(Splits[2], 100);
+    EXPECT_FLOAT_EQ(Splits[3], 1000);
+    EXPECT_FLOAT_EQ(Splits[4], 10000);
+
+    ComputeCascadeSplits(0.1f, 500, 4, 0.9f, Splits);
+    for (int i = 0; i < 4; ++i)
+        EXPECT_LT(Splits[i], Splits[i + 1]);
+}
+
+TEST(Common_ShadowCascades, ComputeShadowCascades)
+{
+    for (bool IsGL : {false, true})
+    {
+        ShadowCascadeAttribs Attribs;
+        Attribs.CameraView        = MakeCameraView(float3{10, 20, -30}, 0.3f, 0.2f);
+        Attribs.CameraProj        = float4x4::Projection(PI_F / 4.f, 1.5f, 1.f, 1000.f, IsGL);
+        Attribs.LightDir          = float3{0.3f, -1.f, 0.4f};
+        Attribs.NumCascades       = 4;
+        Attribs.MaxShadowDistance = 500;
+        Attribs.IsGL              = IsGL;
+
+        ShadowCascade Cascades[4];
+        ComputeShadowCascades(Attribs, Cascades);
+
+        EXPECT_NEAR(Cascades[0].NearZ, 1.f, 1e-3f);
+        EXPECT_NEAR(Cascades[3].FarZ, 500.f, 1e-2f);
+
+        const auto CameraViewToWorld = Attribs.CameraView.Inverse();
+        for (Uint32 i = 0; i < Attribs.NumCascades; ++i)
+        {
+            const auto& Cascade = Cascades[i];
+            if (i > 0)
+                EXPECT_EQ(Cascade.NearZ, Cascades[i - 1].FarZ);
+
+            // All corners of the camera frustum slice must be inside the cascade
+            for (float z : {Cascade.NearZ, Cascade.FarZ})
+            {
+                for (float sx : {-1.f, +1.f})
+                {
+                    for (float sy : {-1.f, +1.f})
+                    {
+                        const float3 ViewSpaceCorner{sx * z / Attribs.CameraProj._11, sy * z / Attribs.CameraProj._22, z};
+                        const auto   WorldCorner = ViewSpaceCorner * CameraViewToWorld;
+                        EXPECT_LE(length(WorldCorner - Cascade.Center), Cascade.Radius * 1.001f);
+
+                        const auto NDC = WorldCorner * Cascade.ViewProj;
+                        EXPECT_LE(std::abs(NDC.x), 1.001f);
+                        EXPECT_LE(std::abs(NDC.y), 1.001f);
+                        EXPECT_GE(NDC.z, IsGL ? -1.001f : -0.001f);
+                        EXPECT_LE(NDC.z, 1.001f);
+
+                        BoundBox PointBox{WorldCorner, WorldCorner};
+                        EXPECT_NE(GetBoxVisibility(Cascade.Frustum, PointBox), BoxVisibility::Invisible);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(Common_ShadowCascades, Stability)
+{
+    ShadowCascadeAttribs Attribs;
+    Attribs.CameraProj  = float4x4::Projection(PI_F / 4.f, 1.5f, 1.f, 200.f, false);
+    Attribs.LightDir    = float3{-0.2f, -1.f, 0.5f};
+    Attribs.NumCascades = 3;
+    Attribs.Resolution  = 1024;
+
+    ShadowCascade RefCascades[3];
+    Attribs.CameraView = MakeCameraView(float3{0, 5, 0}, 0, 0);
+    ComputeShadowCascades(Attribs, RefCascades);
+
+    ShadowCascade Cascades[3];
+    Attribs.CameraView = MakeCameraView(float3{1.234f, 5.678f, 9.1011f}, 1.1f, -0.3f);
+    ComputeShadowCascades(Attribs, Cascades);
+
+    for (Uint32 i = 0; i < Attribs.NumCascades; ++i)
+    {
+        // Cascade size must not depend on the camera position and orientation
+        EXPECT_NEAR(Cascades[i].Radius, RefCascades[i].Radius, RefCascades[i].Radius * 1e-5f);
+        EXPECT_NEAR(Cascades[i].TexelSize, RefCascades[i].TexelSize, RefCascades[i].TexelSize * 1e-5f);
+
+        // The projection must move by a whole number of texels.
+        // For the orthographic projection, _41 == -CenterX / Radius and _42 == -CenterY / Radius.
+        const float TexelSize = RefCascades[i].TexelSize;
+        const float ShiftX    = (RefCascades[i].Proj._41 - Cascades[i].Proj._41) * RefCascades[i].Radius / TexelSize;
+        const float ShiftY    = (RefCascades[i].Proj._42 - Cascades[i].Proj._42) * RefCascades[i].Radius / TexelSize;
+        EXPECT_NEAR(ShiftX, std::round(ShiftX), 1e-2f);
+        EXPECT_NEAR(ShiftY, std::round(ShiftY), 1e-2f);
+    }
+}
+
+TEST(Common_ShadowCascades, CullBoxesAgainstShadowCascades)
+{
+    ShadowCascadeAttribs Attribs;
+    Attribs.CameraView      = MakeCameraView(float3{0, 10, 0}, 0.5f, 0.1f);
+    Attribs.CameraProj      = float4x4::Projection(PI_F / 3.f, 1.f, 0.5f, 300.f, false);
+    Attribs.LightDir        = float3{0.5f, -1.f, 0.1f};
+    Attribs.NumCascades     = 4;
+    Attribs.CasterExtension = 50;
+
+    std::vector<ShadowCascade> Cascades(Attribs.NumCascades);
+    ComputeShadowCascades(Attribs, Cascades.data());
+
+    FastRandFloat         Rnd{0, -400, 400};
+    std::vector<BoundBox> Boxes(5000);
+    for (auto& Box : Boxes)
+    {
+        Box.Min = float3{Rnd(), Rnd() * 0.1f, Rnd()};
+        Box.Max = Box.Min + abs(float3{Rnd(), Rnd(), Rnd()}) * 0.05f;
+    }
+
+    for (auto PlaneFlags : {FRUSTUM_PLANE_FLAG_OPEN_NEAR, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM})
+    {
+        std::vector<std::vector<Uint32>> VisibleLists(Attribs.NumCascades);
+        CullBoxesAgainstShadowCascades(Cascades.data(), Attribs.NumCascades, Boxes.data(), static_cast<Uint32>(Boxes.size()), VisibleLists.data(), PlaneFlags);
+
+        for (Uint32 c = 0; c < Attribs.NumCascades; ++c)
+        {
+            std::vector<Uint32> RefList;
+            for (Uint32 b = 0; b < Boxes.size(); ++b)
+            {
+                if (GetBoxVisibility(Cascades[c].Frustum, Boxes[b], PlaneFlags) != BoxVisibility::Invisible)
+                    RefList.push_back(b);
+            }
+            EXPECT_FALSE(RefList.empty());
+            EXPECT_EQ(VisibleLists[c], RefList) << "Cascade " << c;
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,242 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "SpatialHashGrid.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class SpatialHashGridTest
+{
+public:
+    SpatialHashGridTest() :
+        Grid{10}
+    {}
+
+    BoundBox RandomBox()
+    {
+        BoundBox Box;
+        Box.Min = float3{Rnd(), Rnd(), Rnd()};
+        Box.Max = Box.Min + abs(float3{Rnd(), Rnd(), Rnd()}) * 0.05f;
+        return Box;
+    }
+
+    void Insert(size_t Count)
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            const auto Box = RandomBox();
+            const auto Id  = Grid.Insert(Box);
+            if (Id >= Boxes.size())
+                Boxes.resize(Id + 1);
+            Boxes[Id] = Box;
+            Alive.resize(Boxes.size());
+            EXPECT_FALSE(Alive[Id]);
+            Alive[Id] = true;
+        }
+    }
+
+    template <typename TRefTest, typename TQuery>
+    void CheckQuery(TRefTest RefTest, TQuery QueryFunc)
+    {
+        std::vector<SpatialHashGrid::ObjectId> Ref;
+        for (Uint32 i = 0; i < Boxes.size(); ++i)
+        {
+            if (Alive[i] && RefTest(Boxes[i]))
+                Ref.push_back(i);
+        }
+
+        std::vector<SpatialHashGrid::ObjectId> Objects;
+        QueryFunc(Objects);
+        std::sort(Objects.begin(), Objects.end());
+        EXPECT_EQ(Objects, Ref);
+    }
+
+    SpatialHashGrid       Grid;
+    FastRandFloat         Rnd{0, -100, 100};
+    std::vector<BoundBox> Boxes;
+    std::vector<bool>     Alive;
+};
+
+bool BoxesOverlap(const BoundBox& B0, const BoundBox& B1)
+{
+    // clang-format off
+    return B0.Min.x <= B1.Max.x && B0.Max.x >= B1.Min.x &&
+           B0.Min.y <= B1.Max.y && B0.Max.y >= B1.Min.y &&
+           B0.Min.z <= B1.Max.z && B0.Max.z >= B1.Min.z;
+    // clang-format on
+}
+
+TEST(Common_SpatialHashGrid, InsertMoveRemove)
+{
+    SpatialHashGridTest Test;
+    Test.Insert(2000);
+    EXPECT_EQ(Test.Grid.GetNumObjects(), 2000u);
+
+    // Move some objects slightly and some objects far away
+    for (Uint32 i = 0; i < 2000; i += 3)
+    {
+        auto Box = (i % 2 == 0) ? Test.RandomBox() : Test.Boxes[i];
+        if (i % 2 != 0)
+        {
+            Box.Min += float3{0.5f, 0, -0.5f};
+            Box.Max += float3{0.5f, 0, -0.5f};
+        }
+        Test.Grid.Move(i, Box);
+        Test.Boxes[i] = Box;
+    }
+
+    for (Uint32 i = 0; i < 2000; i += 7)
+    {
+        Test.Grid.Remove(i);
+        Test.Alive[i] = false;
+    }
+    EXPECT_EQ(Test.Grid.GetNumObjects(), 2000u - (2000u + 6u) / 7u);
+
+    // Removed ids must be reused
+    Test.Insert(100);
+    EXPECT_EQ(Test.Boxes.size(), 2000u);
+
+    for (Uint32 i = 0; i < Test.Boxes.size(); ++i)
+    {
+        if (Test.Alive[i])
+            EXPECT_EQ(Test.Grid.GetBox(i).Min, Test.Boxes[i].Min);
+    }
+
+    const BoundBox QueryBox{float3{-20, -30, -10}, float3{25, 5, 40}};
+    Test.CheckQuery(
+        [&](const BoundBox& Box) { return BoxesOverlap(Box, QueryBox); },
+        [&](std::vector<SpatialHashGrid::ObjectId>& Objects) { Test.Grid.QueryBox(QueryBox, Objects); });
+
+    // Remove everything
+    for (Uint32 i = 0; i < Test.Boxes.size(); ++i)
+    {
+        if (Test.Alive[i])
+            Test.Grid.Remove(i);
+    }
+    EXPECT_EQ(Test.Grid.GetNumObjects(), 0u);
+    EXPECT_EQ(Test.Grid.GetNumCells(), 0u);
+}
+
+TEST(Common_SpatialHashGrid, Queries)
+{
+    SpatialHashGridTest Test;
+    Test.Insert(5000);
+
+    const auto ViewProj = float4x4::Translation(-5, 10, 20) * float4x4::RotationY(0.7f) * float4x4::Projection(PI_F / 4, 1.5f, 1, 150, false);
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+
+    for (auto PlaneFlags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR})
+    {
+        Test.CheckQuery(
+            [&](const BoundBox& Box) { return GetBoxVisibility(Frustum, Box, PlaneFlags) != BoxVisibility::Invisible; },
+            [&](std::vector<SpatialHashGrid::ObjectId>& Objects) { Test.Grid.QueryFrustum(Frustum, Objects, PlaneFlags); });
+    }
+
+    const float3 Center{10, -20, 30};
+    const float  Radius = 35;
+    Test.CheckQuery(
+        [&](const BoundBox& Box) {
+            const float3 d = std::max(std::max(Box.Min - Center, Center - Box.Max), float3{0, 0, 0});
+            return dot(d, d) <= Radius * Radius;
+        },
+        [&](std::vector<SpatialHashGrid::ObjectId>& Objects) { Test.Grid.QuerySphere(Center, Radius, Objects); });
+
+    // Batched frustum queries must produce the same results as individual queries
+    ViewFrustum Frustums[3];
+    for (int f = 0; f < 3; ++f)
+    {
+        const auto FrustumViewProj = float4x4::RotationY(f * 2.f) * float4x4::OrthoOffCenter(-30, 30, -40, 40, -50, 50, false);
+        ExtractViewFrustumPlanesFromMatrix(FrustumViewProj, Frustums[f], false);
+    }
+    std::vector<SpatialHashGrid::ObjectId> Lists[3];
+    Test.Grid.QueryFrustums(Frustums, 3, Lists);
+    for (int f = 0; f < 3; ++f)
+    {
+        std::sort(Lists[f].begin(), Lists[f].end());
+        Test.CheckQuery(
+            [&](const BoundBox& Box) { return GetBoxVisibility(Frustums[f], Box) != BoxVisibility::Invisible; },
+            [&](std::vector<SpatialHashGrid::ObjectId>& Objects) { Objects = Lists[f]; });
+    }
+}
+
+TEST(Common_SpatialHashGrid, LocalQueries)
+{
+    SpatialHashGridTest Test;
+    Test.Insert(5000);
+
+    // Large objects that span many cells must be found by queries that only touch their edges
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        BoundBox Box;
+        Box.Min = float3{Test.Rnd(), Test.Rnd(), Test.Rnd()} * 0.5f;
+        Box.Max = Box.Min + float3{35, 20, 50};
+
+        const auto Id = Test.Grid.Insert(Box);
+        if (Id >= Test.Boxes.size())
+            Test.Boxes.resize(Id + 1);
+        Test.Boxes[Id] = Box;
+        Test.Alive.resize(Test.Boxes.size());
+        Test.Alive[Id] = true;
+    }
+
+    for (Uint32 q = 0; q < 200; ++q)
+    {
+        const float3   Center{Test.Rnd(), Test.Rnd(), Test.Rnd()};
+        const float    Size = std::abs(Test.Rnd()) * 0.1f;
+        const BoundBox QueryBox{Center - float3{Size, Size, Size}, Center + float3{Size, Size, Size}};
+        Test.CheckQuery(
+            [&](const BoundBox& Box) { return BoxesOverlap(Box, QueryBox); },
+            [&](std::vector<SpatialHashGrid::ObjectId>& Objects) { Test.Grid.QueryBox(QueryBox, Objects); });
+
+        Test.CheckQuery(
+            [&](const BoundBox& Box) {
+                const float3 d = std::max(std::max(Box.Min - Center, Center - Box.Max), float3{0, 0, 0});
+                return dot(d, d) <= Size * Size;
+            },
+            [&](std::vector<SpatialHashGrid::ObjectId>& Objects) { Test.Grid.QuerySphere(Center, Size, Objects); });
+    }
+
+    const auto ViewProj = float4x4::Translation(-Test.Rnd(), 0, 0) * float4x4::Projection(PI_F / 4, 1.f, 1, 20, false);
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+    Test.CheckQuery(
+        [&](const BoundBox& Box) { return GetBoxVisibility(Frustum, Box) != BoxVisibility::Invisible; },
+        [&](std::vector<SpatialHashGrid::ObjectId>& Objects) { Test.Grid.QueryFrustum(Frustum, Objects); });
+}
+
+} // namespace
@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+using namespace ThreadingTools;
+
+namespace
+{
+
+TEST(Common_ThreadPool, ExecuteTasks)
+{
+    constexpr int NumTasks = 1000;
+
+    std::atomic<int> Counter{0};
+    {
+        ThreadPool Pool{4};
+        EXPECT_EQ(Pool.GetNumThreads(), 4u);
+        for (int i = 0; i < NumTasks; ++i)
+        {
+            Pool.EnqueueTask([&Counter]() { Counter.fetch_add(1); });
+        }
+        // Destructor waits until all enqueued tasks are complete
+    }
+    EXPECT_EQ(Counter.load(), NumTasks);
+}
+
+TEST(Common_ThreadPool, NoThreads)
+{
+    ThreadPool Pool{0};
+    EXPECT_EQ(Pool.GetNumThreads(), 0u);
+
+    bool Executed = false;
+    Pool.EnqueueTask([&Executed]() { Executed = true; });
+    EXPECT_TRUE(Executed);
+}
+
+TEST(Common_ThreadPool, DestroyFromTask)
+{
+    auto pPool = std::make_shared<ThreadPool>(2);
+
+    std::atomic<bool> Done{false};
+    // The task holds the last reference to the pool, so the pool is destroyed
+    // by the worker thread once the task is released.
+    std::weak_ptr<ThreadPool> wpPool = pPool;
+    pPool->EnqueueTask([pPool, &Done]() { Done.store(true); });
+    pPool.reset();
+
+    while (!Done.load() || !wpPool.expired())
+        std::this_thread::yield();
+}
+
+} // namespace
@@ -28,6 +28,7 @@
 #include <array>
 
 #include "GraphicsAccessories.hpp"
+#include "FormatConversion.hpp"
 
 #include "gtest/gtest.h"
 
@@ -486,6 +487,32 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetTextureFormatAttribs)
     CheckComponentType(std::begin(CompressedFormats), std::end(CompressedFormats), COMPONENT_TYPE_COMPRESSED);
 }
 
+TEST(GraphicsAccessories_GraphicsAccessories, FormatConversionConsistency)
+{
+    // Check that packed values produced by the functions from FormatConversion.hpp
+    // match the component definitions of the corresponding texture formats.
+    auto CheckFormat = [](TEXTURE_FORMAT Format, size_t ComponentSize, Uint8 NumComponents, COMPONENT_TYPE ComponentType) //
+    {
+        const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+        EXPECT_EQ(FmtAttribs.ComponentSize, ComponentSize) << FmtAttribs.Name;
+        EXPECT_EQ(FmtAttribs.NumComponents, NumComponents) << FmtAttribs.Name;
+        EXPECT_EQ(FmtAttribs.ComponentType, ComponentType) << FmtAttribs.Name;
+    };
+
+    // clang-format off
+    CheckFormat(TEX_FORMAT_R16_FLOAT,     sizeof(FloatToHalf(0.f)),              1, COMPONENT_TYPE_FLOAT);
+    CheckFormat(TEX_FORMAT_RGBA16_FLOAT,  sizeof(FloatToHalf(0.f)),              4, COMPONENT_TYPE_FLOAT);
+    CheckFormat(TEX_FORMAT_RGBA8_UNORM,   sizeof(FloatToUNorm<Uint8>(0.f)),      4, COMPONENT_TYPE_UNORM);
+    CheckFormat(TEX_FORMAT_RGBA16_UNORM,  sizeof(FloatToUNorm<Uint16>(0.f)),     4, COMPONENT_TYPE_UNORM);
+    CheckFormat(TEX_FORMAT_RGBA8_SNORM,   sizeof(FloatToSNorm<Int8>(0.f)),       4, COMPONENT_TYPE_SNORM);
+    CheckFormat(TEX_FORMAT_RGBA16_SNORM,  sizeof(FloatToSNorm<Int16>(0.f)),      4, COMPONENT_TYPE_SNORM);
+    CheckFormat(TEX_FORMAT_RG16_SNORM,    sizeof(PackOctahedralNormal(float3{0, 0, 1})) / 2, 2, COMPONENT_TYPE_SNORM);
+    CheckFormat(TEX_FORMAT_RGB10A2_UNORM, sizeof(PackRGB10A2(float4{})),         1, COMPONENT_TYPE_COMPOUND);
+    // clang-format on
+
+    EXPECT_EQ(GetValueSize(VT_FLOAT16), sizeof(FloatToHalf(0.f)));
+}
+
 TEST(GraphicsAccessories_GraphicsAccessories, GetShaderTypeIndex)
 {
     static_assert(SHADER_TYPE_LAST == SHADER_TYPE_CALLABLE, "Please update the test below to handle the new shader type");
@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <list>
+#include <sstream>
+#include <vector>
+
+#include "TokenString.hpp"
+#include "TokenListAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(HLSL2GLSLConverter_TokenString, Reference)
+{
+    const char Text[] = "float4 Color";
+
+    auto Type = TokenString::MakeReference(Text, 6);
+    EXPECT_EQ(Type.data(), Text);
+    EXPECT_EQ(Type.length(), 6u);
+    EXPECT_EQ(Type, "float4");
+    EXPECT_NE(Type, "float");
+    EXPECT_EQ(Type.str(), String{"float4"});
+
+    // Copying a reference does not copy the text
+    auto TypeCopy = Type;
+    EXPECT_EQ(TypeCopy.data(), Text);
+
+    // The text is not null-terminated, so c_str() must make a copy
+    EXPECT_STREQ(TypeCopy.c_str(), "float4");
+    EXPECT_NE(TypeCopy.data(), Text);
+    EXPECT_EQ(Type.data(), Text);
+
+    // Null-terminated text is used as is
+    auto Name = TokenString::MakeReference(Text + 7, 5);
+    EXPECT_EQ(Name.c_str(), Text + 7);
+
+    std::stringstream ss;
+    ss << Type << ' ' << Name;
+    EXPECT_EQ(ss.str(), Text);
+}
+
+TEST(HLSL2GLSLConverter_TokenString, Modify)
+{
+    const char Text[] = "g_Buffer;";
+
+    auto Str = TokenString::MakeReference(Text, 8);
+    Str.append("_data");
+    EXPECT_STREQ(Str.c_str(), "g_Buffer_data");
+    EXPECT_STREQ(Text, "g_Buffer;");
+
+    Str.push_back('0');
+    EXPECT_EQ(Str, "g_Buffer_data0");
+    EXPECT_EQ(Str.back(), '0');
+    Str.pop_back();
+    EXPECT_EQ(Str, "g_Buffer_data");
+
+    // Copies of an owning string are independent
+    auto Copy = Str;
+    EXPECT_NE(Copy.data(), Str.data());
+    Copy = "uniform";
+    EXPECT_EQ(Copy, "uniform");
+    EXPECT_EQ(Str, "g_Buffer_data");
+
+    const auto& Self = Copy;
+    Copy             = Self;
+    EXPECT_EQ(Copy, "uniform");
+
+    auto Num = TokenString::MakeReference("0.5f", 4);
+    Num.pop_back();
+    EXPECT_STREQ(Num.c_str(), "0.5");
+
+    String Out{"#define "};
+    Out += Str;
+    EXPECT_EQ(Out, "#define g_Buffer_data");
+
+    Str.clear();
+    EXPECT_TRUE(Str.empty());
+    EXPECT_EQ(Str, "");
+    EXPECT_STREQ(Str.c_str(), "");
+}
+
+TEST(HLSL2GLSLConverter_TokenListAllocator, ReuseNodes)
+{
+    TokenNodePool Pool{DefaultRawMemoryAllocator::GetAllocator()};
+
+    using ListType = std::list<int, TokenListAllocator<int>>;
+    ListType List{TokenListAllocator<int>{&Pool}};
+    for (int i = 0; i < 1000; ++i)
+        List.push_back(i);
+
+    std::vector<const int*> Addresses;
+    for (auto it = List.begin(); it != List.end();)
+    {
+        Addresses.push_back(&*it);
+        it = List.erase(it);
+    }
+
+    // Released nodes must be reused
+    for (int i = 0; i < 1000; ++i)
+        List.push_back(i);
+    for (const auto& Val : List)
+        EXPECT_NE(std::find(Addresses.begin(), Addresses.end(), &Val), Addresses.end());
+
+    auto Copy = List;
+    EXPECT_EQ(Copy, List);
+    Copy.swap(List);
+    EXPECT_EQ(Copy, List);
+
+    ListType Empty;
+    Empty.swap(List);
+    EXPECT_TRUE(List.empty());
+    EXPECT_EQ(Empty.size(), 1000u);
+}
+
+} // namespace
@@ -0,0 +1,237 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "ShaderBytecodeCache.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+ShaderBytecodeCache::Key ComputeKey(const char* Str)
+{
+    return ShaderBytecodeCache::KeyBuilder{}.Update(Str).Finalize();
+}
+
+std::vector<Uint32> MakeBytecode(Uint32 Seed, size_t Size)
+{
+    std::vector<Uint32> Bytecode(Size);
+    for (size_t i = 0; i < Size; ++i)
+        Bytecode[i] = Seed * 0x9E3779B9u + static_cast<Uint32>(i);
+    return Bytecode;
+}
+
+TEST(ShaderTools_ShaderBytecodeCache, KeyBuilder)
+{
+    const std::string Data = "The quick brown fox jumps over the lazy dog";
+
+    const auto RefKey = ShaderBytecodeCache::KeyBuilder{}.Update(Data.data(), Data.size()).Finalize();
+    for (size_t Split = 0; Split <= Data.size(); ++Split)
+    {
+        ShaderBytecodeCache::KeyBuilder Builder;
+        Builder.Update(Data.data(), Split);
+        Builder.Update(Data.data() + Split, Data.size() - Split);
+        EXPECT_EQ(Builder.Finalize(), RefKey) << "Split: " << Split;
+    }
+
+    EXPECT_FALSE(ShaderBytecodeCache::KeyBuilder{}.Update(Data.data(), Data.size() - 1).Finalize() == RefKey);
+    EXPECT_FALSE(ShaderBytecodeCache::KeyBuilder{}.Update(Data.data() + 1, Data.size() - 1).Finalize() == RefKey);
+
+    // String lengths are hashed too
+    const auto Key1 = ShaderBytecodeCache::KeyBuilder{}.Update("ab").Update("c").Finalize();
+    const auto Key2 = ShaderBytecodeCache::KeyBuilder{}.Update("a").Update("bc").Finalize();
+    EXPECT_FALSE(Key1 == Key2);
+
+    const char* NullStr = nullptr;
+    EXPECT_FALSE(ComputeKey("") == ComputeKey(NullStr));
+    EXPECT_FALSE(ShaderBytecodeCache::KeyBuilder{}.Finalize() == ComputeKey(""));
+
+    EXPECT_FALSE(ShaderBytecodeCache::KeyBuilder{}.UpdateValue(Uint32{1}).Finalize() ==
+                 ShaderBytecodeCache::KeyBuilder{}.UpdateValue(Uint32{2}).Finalize());
+}
+
+TEST(ShaderTools_ShaderBytecodeCache, StoreLoad)
+{
+    const auto Bytecode1 = MakeBytecode(1, 100);
+    const auto Bytecode2 = MakeBytecode(2, 357);
+
+    const Uint8 AuxData[] = {1, 2, 3, 4, 5, 6, 7};
+
+    const auto Key1 = ComputeKey("Shader1");
+    const auto Key2 = ComputeKey("Shader2");
+    const auto Key3 = ComputeKey("Shader3");
+
+    {
+        ShaderBytecodeCache Cache{".", 1 << 20};
+        Cache.Clear();
+
+        std::vector<Uint32> Bytecode;
+        EXPECT_FALSE(Cache.Load(Key1, Bytecode));
+
+        Cache.Store(Key1, Bytecode1);
+        Cache.Store(Key2, Bytecode2, AuxData, sizeof(AuxData));
+
+        EXPECT_TRUE(Cache.Load(Key1, Bytecode));
+        EXPECT_EQ(Bytecode, Bytecode1);
+
+        std::vector<Uint8> LoadedAuxData;
+        EXPECT_TRUE(Cache.Load(Key2, Bytecode, &LoadedAuxData));
+        EXPECT_EQ(Bytecode, Bytecode2);
+        EXPECT_EQ(LoadedAuxData, std::vector<Uint8>(std::begin(AuxData), std::end(AuxData)));
+
+        EXPECT_FALSE(Cache.Load(Key3, Bytecode));
+
+        const auto Stats = Cache.GetStats();
+        EXPECT_EQ(Stats.NumHits, 2u);
+        EXPECT_EQ(Stats.NumMisses, 2u);
+        EXPECT_EQ(Stats.NumStores, 2u);
+        EXPECT_EQ(Stats.NumEvictions, 0u);
+        EXPECT_EQ(Stats.NumEntries, 2u);
+        EXPECT_GE(Stats.TotalSize, (Bytecode1.size() + Bytecode2.size()) * sizeof(Uint32) + sizeof(AuxData));
+    }
+
+    // The entries must persist across cache instances
+    {
+        ShaderBytecodeCache Cache{".", 1 << 20};
+
+        auto Stats = Cache.GetStats();
+        EXPECT_EQ(Stats.NumEntries, 2u);
+
+        std::vector<Uint32> Bytecode;
+        std::vector<Uint8>  LoadedAuxData;
+        EXPECT_TRUE(Cache.Load(Key2, Bytecode, &LoadedAuxData));
+        EXPECT_EQ(Bytecode, Bytecode2);
+        EXPECT_EQ(LoadedAuxData.size(), sizeof(AuxData));
+
+        EXPECT_TRUE(Cache.Load(Key1, Bytecode, &LoadedAuxData));
+        EXPECT_EQ(Bytecode, Bytecode1);
+        EXPECT_TRUE(LoadedAuxData.empty());
+
+        Stats = Cache.GetStats();
+        EXPECT_EQ(Stats.NumHits, 2u);
+        EXPECT_EQ(Stats.NumMisses, 0u);
+
+        Cache.Clear();
+        EXPECT_FALSE(Cache.Load(Key1, Bytecode));
+        EXPECT_EQ(Cache.GetStats().NumEntries, 0u);
+    }
+}
+
+TEST(ShaderTools_ShaderBytecodeCache, Eviction)
+{
+    constexpr size_t NumEntries   = 16;
+    constexpr size_t BytecodeSize = 1024;
+    constexpr Uint64 MaxSize      = BytecodeSize * sizeof(Uint32) * 8;
+
+    ShaderBytecodeCache Cache{".", MaxSize};
+    Cache.Clear();
+
+    std::vector<Uint32> Bytecode;
+    for (Uint32 i = 0; i < NumEntries; ++i)
+    {
+        const auto Key = ComputeKey(std::to_string(i).c_str());
+        Cache.Store(Key, MakeBytecode(i, BytecodeSize));
+
+        // Keep the first entry alive
+        EXPECT_TRUE(Cache.Load(ComputeKey("0"), Bytecode));
+        EXPECT_LE(Cache.GetStats().TotalSize, MaxSize);
+    }
+
+    const auto Stats = Cache.GetStats();
+    EXPECT_GT(Stats.NumEvictions, 0u);
+    EXPECT_EQ(Stats.NumEntries + Stats.NumEvictions, NumEntries);
+
+    // Recently used entries must be in the cache
+    EXPECT_TRUE(Cache.Load(ComputeKey("0"), Bytecode));
+    EXPECT_EQ(Bytecode, MakeBytecode(0, BytecodeSize));
+    EXPECT_TRUE(Cache.Load(ComputeKey(std::to_string(NumEntries - 1).c_str()), Bytecode));
+
+    // The least recently used ones must have been evicted
+    EXPECT_FALSE(Cache.Load(ComputeKey("1"), Bytecode));
+
+    Cache.Clear();
+}
+
+TEST(ShaderTools_ShaderBytecodeCache, CorruptedSizes)
+{
+    const auto Key = ComputeKey("Shader");
+
+    // Overwrites the byte code and auxiliary data sizes in the entry file header
+    auto CorruptEntry = [&Key](Uint64 BytecodeSize, Uint64 AuxDataSize) //
+    {
+        static constexpr char HexDigits[] = "0123456789abcdef";
+
+        std::string Path = "./";
+        for (auto Val : {Key.Hi, Key.Lo})
+        {
+            for (int Shift = 60; Shift >= 0; Shift -= 4)
+                Path.push_back(HexDigits[(Val >> Shift) & 0xF]);
+        }
+        Path.append(".bin");
+
+        auto* pFile = fopen(Path.c_str(), "r+b");
+        ASSERT_NE(pFile, nullptr);
+        // Magic, version and the key precede the sizes
+        fseek(pFile, 24, SEEK_SET);
+        fwrite(&BytecodeSize, sizeof(BytecodeSize), 1, pFile);
+        fwrite(&AuxDataSize, sizeof(AuxDataSize), 1, pFile);
+        fclose(pFile);
+    };
+
+    ShaderBytecodeCache Cache{".", 1 << 20};
+    Cache.Clear();
+
+    const auto RefBytecode = MakeBytecode(1, 100);
+    const auto EntrySize   = Uint64{RefBytecode.size() * sizeof(Uint32)};
+
+    std::vector<Uint32> Bytecode;
+
+    // The sum of the sizes wraps around to the file size
+    Cache.Store(Key, RefBytecode);
+    CorruptEntry(~Uint64{0} - 15, EntrySize + 16);
+    EXPECT_FALSE(Cache.Load(Key, Bytecode));
+    EXPECT_TRUE(Bytecode.empty());
+
+    // The entry is larger than the file
+    Cache.Store(Key, RefBytecode);
+    CorruptEntry(EntrySize * 2, 0);
+    EXPECT_FALSE(Cache.Load(Key, Bytecode));
+
+    // The corrupted entries are removed
+    Cache.Store(Key, RefBytecode);
+    EXPECT_TRUE(Cache.Load(Key, Bytecode));
+    EXPECT_EQ(Bytecode, RefBytecode);
+
+    Cache.Clear();
+}
+
+} // namespace
@@ -0,0 +1,228 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ShaderPreprocessor.hpp"
+#include "TestShaderSourceFactory.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+std::string Preprocess(const char* Source, const ShaderMacro* Macros = nullptr)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source = Source;
+    ShaderCI.Macros = Macros;
+
+    std::string Output;
+    PreprocessShaderSource(ShaderCI, nullptr, &Output, nullptr);
+    return Output;
+}
+
+TEST(ShaderTools_ShaderPreprocessor, Conditionals)
+{
+    const ShaderMacro Macros[] = {{"A", "1"}, {"B", "0"}, {"C", "A + 2"}, {}};
+
+    EXPECT_EQ(Preprocess("#if A\n"
+                         "a\n"
+                         "#elif B\n"
+                         "b\n"
+                         "#else\n"
+                         "c\n"
+                         "#endif\n",
+                         Macros),
+              "a\n");
+
+    EXPECT_EQ(Preprocess("#ifdef B\n"
+                         "b\n"
+                         "#endif\n"
+                         "#ifndef D\n"
+                         "d\n"
+                         "#endif\n"
+                         "#if defined(D) || !defined A\n"
+                         "x\n"
+                         "#elif C == 3 && (B ? 0 : 1) && (1 << 4) / 8 == 2 && UNDEFINED == 0\n"
+                         "c\n"
+                         "#endif\n",
+                         Macros),
+              "b\nd\nc\n");
+
+    // Nested inactive blocks are skipped, and their conditions are not evaluated
+    EXPECT_EQ(Preprocess("#if 0\n"
+                         "#  if 1 / 0\n"
+                         "x\n"
+                         "#  endif\n"
+                         "#elif 1\n"
+                         "y\n"
+                         "#elif 1 / 0\n"
+                         "#endif\n"),
+              "y\n");
+
+    EXPECT_THROW(Preprocess("#if 1\n"), std::runtime_error);
+    EXPECT_THROW(Preprocess("#endif\n"), std::runtime_error);
+    EXPECT_THROW(Preprocess("#if 1\n#else\n#else\n#endif\n"), std::runtime_error);
+    EXPECT_THROW(Preprocess("#if 1 +\n#endif\n"), std::runtime_error);
+    EXPECT_THROW(Preprocess("#error Unsupported\n"), std::runtime_error);
+}
+
+TEST(ShaderTools_ShaderPreprocessor, MacroExpansion)
+{
+    EXPECT_EQ(Preprocess("#define VALUE 1.5\n"
+                         "float x = VALUE; // VALUE\n"
+                         "/* VALUE */ float y = VALUE;\n"),
+              "float x = 1.5;\nfloat y = 1.5;\n");
+
+    EXPECT_EQ(Preprocess("#define ADD(a, b) ((a) + (b))\n"
+                         "#define MUL(a, b) a * b\n"
+                         "float x = ADD(MUL(1, 2),\n"
+                         "              ADD(3, 4));\n"
+                         "float ADD;\n"),
+              "float x = ((1 * 2) + (((3) + (4))));\n"
+              "float ADD;\n");
+
+    // Recursive macros are not expanded again
+    EXPECT_EQ(Preprocess("#define X X + Y\n"
+                         "#define Y X\n"
+                         "X\n"),
+              "X + X\n");
+
+    // Stringification, token pasting and variadic macros
+    EXPECT_EQ(Preprocess("#define STR(x) #x\n"
+                         "#define CAT(a, b) a##b\n"
+                         "#define CALL(f, ...) f(__VA_ARGS__)\n"
+                         "STR(a \"b\")\n"
+                         "CAT(g_, Texture) CAT(, x) CAT(1, 2)\n"
+                         "CALL(max, 1, 2) CALL(f)\n"),
+              "\"a \\\"b\\\"\"\n"
+              "g_Texture x 12\n"
+              "max(1, 2) f()\n");
+
+    // Function-like macro name that is not followed by the parenthesis
+    EXPECT_EQ(Preprocess("#define F(x) x\n"
+                         "#define G F\n"
+                         "G(1) F\n"),
+              "1 F\n");
+
+    // Macros are not expanded in string literals
+    EXPECT_EQ(Preprocess("#define A 1\n"
+                         "\"A\" A\n"),
+              "\"A\" 1\n");
+
+    // Line continuation
+    EXPECT_EQ(Preprocess("#define A 1 + \\\n"
+                         "  2\n"
+                         "#undef B\n"
+                         "A\n"),
+              "1 + 2\n");
+
+    EXPECT_THROW(Preprocess("#define F(a, b) a\nF(1)\n"), std::runtime_error);
+    EXPECT_THROW(Preprocess("#define F(a) a\nF(1\n"), std::runtime_error);
+    EXPECT_THROW(Preprocess("#define F(a) ##a\n"), std::runtime_error);
+}
+
+TEST(ShaderTools_ShaderPreprocessor, Directives)
+{
+    // Version, extension and pragma directives are passed to the compiler
+    EXPECT_EQ(Preprocess("#version 450\n"
+                         "#extension GL_EXT_samplerless_texture_functions : enable\n"
+                         "#pragma pack_matrix(row_major)\n"
+                         "#\n"
+                         "void main(){}\n"),
+              "#version 450\n"
+              "#extension GL_EXT_samplerless_texture_functions : enable\n"
+              "#pragma pack_matrix(row_major)\n"
+              "void main(){}\n");
+}
+
+TEST(ShaderTools_ShaderPreprocessor, Includes)
+{
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory{
+        MakeNewRCObj<TestShaderSourceFactory>{}(
+            std::unordered_map<std::string, std::string>{
+                {"Main.fx", "#include \"A.fxh\"\n"
+                            "#include \"A.fxh\"\n"
+                            "#if USE_B\n"
+                            "#   include <B.fxh>\n"
+                            "#endif\n"
+                            "// #include \"Missing.fxh\"\n"
+                            "#include \"C.fxh\"\n"
+                            "#include \"C.fxh\"\n"
+                            "float4 main() : SV_Target { return COLOR; }\n"},
+                {"A.fxh", "#pragma once\n"
+                          "#define COLOR float4(1.0, 0.0, 0.0, 1.0)\n"
+                          "#include \"C.fxh\"\n"},
+                {"B.fxh", "float b;\n"},
+                {"C.fxh", "float c;\n"},
+            })};
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.FilePath                   = "Main.fx";
+    ShaderCI.pShaderSourceStreamFactory = pFactory;
+
+    std::string                       Source;
+    std::vector<ShaderSourceFileInfo> Files;
+    PreprocessShaderSource(ShaderCI, nullptr, &Source, &Files);
+    EXPECT_EQ(Source,
+              "float c;\n"
+              "float c;\n"
+              "float c;\n"
+              "float4 main() : SV_Target { return float4(1.0, 0.0, 0.0, 1.0); }\n");
+
+    ASSERT_EQ(Files.size(), 3u);
+    EXPECT_EQ(Files[0].Path, "Main.fx");
+    EXPECT_EQ(Files[1].Path, "A.fxh");
+    EXPECT_EQ(Files[2].Path, "C.fxh");
+    EXPECT_EQ(Files[2].Hash, ShaderBytecodeCache::KeyBuilder{}.Update("float c;\n", 9).Finalize());
+
+    // Dependencies only
+    const ShaderMacro Macros[] = {{"USE_B", "1"}, {}};
+    ShaderCI.Macros            = Macros;
+    PreprocessShaderSource(ShaderCI, nullptr, nullptr, &Files);
+    ASSERT_EQ(Files.size(), 4u);
+    EXPECT_EQ(Files[2].Path, "C.fxh");
+    EXPECT_EQ(Files[3].Path, "B.fxh");
+
+    // Shader type and extra macros
+    ShaderCI.FilePath        = nullptr;
+    ShaderCI.Source          = "#if defined(PIXEL_SHADER) && VULKAN\n#include \"Missing.fxh\"\n#endif\n";
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+    PreprocessShaderSource(ShaderCI, nullptr, &Source, &Files);
+    EXPECT_TRUE(Source.empty());
+
+    const ShaderMacro ExtraMacros[] = {{"VULKAN", "1"}, {}};
+    EXPECT_THROW(PreprocessShaderSource(ShaderCI, ExtraMacros, &Source, &Files), std::runtime_error);
+}
+
+} // namespace
@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ShaderToolsCommon.hpp"
+#include "TestShaderSourceFactory.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(ShaderTools_ShaderToolsCommon, ProcessShaderIncludes)
+{
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory{
+        MakeNewRCObj<TestShaderSourceFactory>{}(
+            std::unordered_map<std::string, std::string>{
+                {"Main.fx", "#include \"A.fxh\"\n"
+                            "  #  include <B.fxh>\n"
+                            "// #include \"Commented1.fxh\"\n"
+                            "/* #include \"Commented2.fxh\"\n"
+                            "#include \"Commented3.fxh\" */\n"
+                            "int x; #include \"NotDirective.fxh\"\n"
+                            "#include \"Missing.fxh\"\n"
+                            "#include \"C.fxh\"\n"},
+                {"A.fxh", "#include \"B.fxh\"\n#include \"D.fxh\""},
+                {"B.fxh", "#include \"A.fxh\"\n"},
+                {"C.fxh", "#include \"D.fxh\"\n"},
+                {"D.fxh", "float4 f;"},
+                {"Commented1.fxh", ""},
+                {"Commented2.fxh", ""},
+                {"Commented3.fxh", ""},
+                {"NotDirective.fxh", ""},
+            })};
+
+    std::vector<std::string> Files;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.FilePath                   = "Main.fx";
+    ShaderCI.pShaderSourceStreamFactory = pFactory;
+    ProcessShaderIncludes(ShaderCI,
+                          [&](const char* FilePath, const char* Source, size_t /*SourceLength*/) //
+                          {
+                              ASSERT_NE(FilePath, nullptr);
+                              ASSERT_NE(Source, nullptr);
+                              Files.emplace_back(FilePath);
+                          });
+
+    const std::vector<std::string> RefFiles = {"Main.fx", "A.fxh", "B.fxh", "D.fxh", "C.fxh"};
+    EXPECT_EQ(Files, RefFiles);
+
+    // Source string
+    Files.clear();
+    ShaderCI.FilePath = nullptr;
+    ShaderCI.Source   = "#include \"C.fxh\"\n";
+    ProcessShaderIncludes(ShaderCI,
+                          [&](const char* FilePath, const char* Source, size_t SourceLength) //
+                          {
+                              if (FilePath == nullptr)
+                              {
+                                  EXPECT_EQ(std::string(Source, SourceLength), ShaderCI.Source);
+                                  Files.emplace_back("<source>");
+                              }
+                              else
+                              {
+                                  Files.emplace_back(FilePath);
+                              }
+                          });
+
+    const std::vector<std::string> RefFiles2 = {"<source>", "C.fxh", "D.fxh"};
+    EXPECT_EQ(Files, RefFiles2);
+}
+
+} // namespace
@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "Shader.h"
+#include "ObjectBase.hpp"
+#include "MemoryFileStream.hpp"
+#include "StringDataBlobImpl.hpp"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+// Shader source stream factory that serves files from memory
+class TestShaderSourceFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    TestShaderSourceFactory(IReferenceCounters* pRefCounters, std::unordered_map<std::string, std::string> Files) :
+        TBase{pRefCounters},
+        m_Files{std::move(Files)}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, TBase)
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final
+    {
+        CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char* Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS /*Flags*/, IFileStream** ppStream) override final
+    {
+        *ppStream = nullptr;
+
+        auto it = m_Files.find(Name);
+        if (it == m_Files.end())
+            return;
+
+        RefCntAutoPtr<IDataBlob> pData{MakeNewRCObj<StringDataBlobImpl>{}(it->second)};
+        RefCntAutoPtr<IFileStream> pStream{MakeNewRCObj<MemoryFileStream>{}(pData)};
+        *ppStream = pStream.Detach();
+    }
+
+private:
+    const std::unordered_map<std::string, std::string> m_Files;
+};
+
+} // namespace Testing
+
+} // namespace Diligent
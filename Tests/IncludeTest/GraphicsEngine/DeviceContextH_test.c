@@ -29,16 +29,27 @@
 
 void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
 {
-    struct IPipelineState*            pPSO                       = NULL;
-    struct DrawAttribs                drawAttribs                = {0};
-    struct DrawIndexedAttribs         drawIndexedAttribs         = {0};
-    struct DrawIndirectAttribs        drawIndirectAttribs        = {0};
-    struct DrawIndexedIndirectAttribs drawIndexedIndirectAttribs = {0};
-    struct IBuffer*                   pIndirectBuffer            = NULL;
+    struct IPipelineState*                 pPSO                            = NULL;
+    struct DrawAttribs                     drawAttribs                     = {0};
+    struct DrawIndexedAttribs              drawIndexedAttribs              = {0};
+    struct DrawIndirectAttribs             drawIndirectAttribs             = {0};
+    struct DrawIndexedIndirectAttribs      drawIndexedIndirectAttribs      = {0};
+    struct MultiDrawAttribs                multiDrawAttribs                = {0};
+    struct MultiDrawIndexedAttribs         multiDrawIndexedAttribs         = {0};
+    struct MultiDrawIndirectAttribs        multiDrawIndirectAttribs        = {0};
+    struct MultiDrawIndexedIndirectAttribs multiDrawIndexedIndirectAttribs = {0};
+    struct IBuffer*                        pIndirectBuffer                 = NULL;
+    struct IBuffer*                        pCountBuffer                    = NULL;
+    struct RedundantStateStats             redundantStateStats             = {0};
 
     IDeviceContext_SetPipelineState(pCtx, pPSO);
     IDeviceContext_Draw(pCtx, &drawAttribs);
     IDeviceContext_DrawIndexed(pCtx, &drawIndexedAttribs);
     IDeviceContext_DrawIndirect(pCtx, &drawIndirectAttribs, pIndirectBuffer);
     IDeviceContext_DrawIndexedIndirect(pCtx, &drawIndexedIndirectAttribs, pIndirectBuffer);
+    IDeviceContext_MultiDraw(pCtx, &multiDrawAttribs);
+    IDeviceContext_MultiDrawIndexed(pCtx, &multiDrawIndexedAttribs);
+    IDeviceContext_MultiDrawIndirect(pCtx, &multiDrawIndirectAttribs, pIndirectBuffer, pCountBuffer);
+    IDeviceContext_MultiDrawIndexedIndirect(pCtx, &multiDrawIndexedIndirectAttribs, pIndirectBuffer, pCountBuffer);
+    IDeviceContext_GetRedundantStateStats(pCtx, &redundantStateStats);
 }
@@ -47,4 +47,7 @@ void TestPipelineState_CInterface(IPipelineState* pPSO)
 
     bool Compatible = IPipelineState_IsCompatibleWith(pPSO, (IPipelineState*)NULL);
     (void)Compatible;
+
+    PIPELINE_STATE_STATUS Status = IPipelineState_GetStatus(pPSO, false);
+    (void)Status;
 }